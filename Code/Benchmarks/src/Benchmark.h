@@ -0,0 +1,64 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace maple::benchmark
+{
+	using Func = std::function<void()>;
+
+	//every benchmark of the executable in the order they were registered
+	inline auto getRegistry() -> std::vector<std::pair<std::string, Func>> &
+	{
+		static std::vector<std::pair<std::string, Func>> registry;
+		return registry;
+	}
+
+	struct Register
+	{
+		Register(const char *name, const Func &func)
+		{
+			getRegistry().emplace_back(name, func);
+		}
+	};
+
+	//fastest of the repeats in milliseconds, the first run warms the caches and is not counted
+	template <typename F>
+	inline auto measure(int32_t repeats, const F &func) -> double
+	{
+		using Clock = std::chrono::steady_clock;
+		func();
+		double best = 1e30;
+		for (int32_t i = 0; i < repeats; i++)
+		{
+			const auto start = Clock::now();
+			func();
+			best = std::min(best, std::chrono::duration<double, std::milli>(Clock::now() - start).count());
+		}
+		return best;
+	}
+
+	namespace detail
+	{
+		//written by doNotOptimize, a volatile global the optimizer can not prove unused
+		inline volatile const void *sink = nullptr;
+	}        // namespace detail
+
+	//keeps the optimizer from dropping a result
+	template <typename T>
+	inline auto doNotOptimize(const T &value) -> void
+	{
+		detail::sink = &value;
+	}
+}        // namespace maple::benchmark
+
+#define MAPLE_BENCHMARK(Name)                                                    \
+	static auto Name() -> void;                                                  \
+	static maple::benchmark::Register Name##Register(#Name, &Name);              \
+	static auto Name() -> void
@@ -0,0 +1,57 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+#include "Benchmark.h"
+
+#include "Math/Frustum.h"
+#include "Math/FrustumCulling.h"
+#include "Others/Console.h"
+
+#include <glm/gtc/matrix_transform.hpp>
+#include <random>
+
+namespace maple::benchmark
+{
+	MAPLE_BENCHMARK(FrustumCulling)
+	{
+		Frustum frustum;
+		frustum.from(glm::perspective(glm::radians(60.f), 16.f / 9.f, 0.1f, 500.f) * glm::lookAt(glm::vec3(0.f), glm::vec3(0.f, 0.f, -1.f), glm::vec3(0.f, 1.f, 0.f)));
+
+		for (uint32_t count : {10000u, 100000u, 1000000u})
+		{
+			//boxes scattered around the camera, about a fifth of them is visible
+			std::mt19937                          random(count);
+			std::uniform_real_distribution<float> position(-500.f, 500.f);
+			std::uniform_real_distribution<float> extent(0.1f, 4.f);
+
+			std::vector<BoundingBox> boxes(count);
+			CullingBatch             batch;
+			batch.reserve(count);
+			for (uint32_t i = 0; i < count; i++)
+			{
+				const glm::vec3 center(position(random), position(random) * 0.1f, position(random));
+				const glm::vec3 half(extent(random), extent(random), extent(random));
+				boxes[i] = BoundingBox(center - half, center + half);
+				batch.add(boxes[i], i);
+			}
+
+			std::vector<uint64_t> visibility;
+			uint32_t              visible   = 0;
+			uint32_t              reference = 0;
+
+			const auto simd = measure(10, [&]() {
+				visible = batch.cull(frustum, visibility);
+			});
+
+			const auto isInside = measure(10, [&]() {
+				reference = 0;
+				for (auto &box : boxes)
+					reference += frustum.isInside(box) ? 1 : 0;
+			});
+
+			const auto nanoseconds = [&](double milliseconds) { return count / (milliseconds * 1e6); };
+			LOGI("  {0} boxes : {1} {2:.3f} boxes/ns, Frustum::isInside {3:.3f} boxes/ns, {4} visible{5}",
+			     count, frustum_culling::getInstructionSet(), nanoseconds(simd), nanoseconds(isInside), visible, visible == reference ? "" : " (MISMATCH)");
+		}
+	}
+}        // namespace maple::benchmark
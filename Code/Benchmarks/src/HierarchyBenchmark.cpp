@@ -0,0 +1,86 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+#include "Benchmark.h"
+
+#include "Others/Console.h"
+#include "Scene/Component/Hierarchy.h"
+#include "Scene/Component/Transform.h"
+#include "Scene/System/HierarchyUpdate.h"
+#include "Thread/JobSystem.h"
+
+namespace maple::benchmark
+{
+	namespace
+	{
+		constexpr uint32_t EntityCount = 100000;
+
+		//EntityCount / depth roots, each with a chain of depth entities. the hooks are not connected, the cache is built on the first update
+		auto build(entt::registry &registry, uint32_t depth) -> std::vector<entt::entity>
+		{
+			std::vector<entt::entity> roots;
+			for (uint32_t i = 0; i < EntityCount / depth; i++)
+			{
+				entt::entity parent = entt::null;
+				for (uint32_t level = 0; level < depth; level++)
+				{
+					const auto entity    = registry.create();
+					auto &     hierarchy = registry.emplace<component::Hierarchy>(entity);
+					registry.emplace<component::Transform>(entity).setLocalPosition(glm::vec3(float(level), 0.f, 0.f));
+					if (parent == entt::null)
+					{
+						roots.emplace_back(entity);
+					}
+					else
+					{
+						hierarchy.parent                                 = parent;
+						registry.get<component::Hierarchy>(parent).first = entity;
+					}
+					parent = entity;
+				}
+			}
+			return roots;
+		}
+	}        // namespace
+
+	MAPLE_BENCHMARK(HierarchyUpdate)
+	{
+		JobSystem jobSystem;
+		for (uint32_t depth : {1u, 2u, 4u, 8u, 16u})
+		{
+			entt::registry registry;
+			const auto     roots = build(registry, depth);
+			hierarchy::updateHierarchy(registry);
+
+			//moving every root updates the whole hierarchy
+			auto moveRoots = [&]() {
+				for (auto root : roots)
+					registry.get<component::Transform>(root).setLocalPosition(glm::vec3(1.f));
+			};
+
+			const auto linear = measure(10, [&]() {
+				moveRoots();
+				hierarchy::updateHierarchy(registry);
+			});
+
+			const auto parallel = measure(10, [&]() {
+				moveRoots();
+				hierarchy::updateHierarchy(registry, nullptr, &jobSystem);
+			});
+
+			//the sub-tree walk physics and the loaders use, one root after the other
+			const auto subTrees = measure(10, [&]() {
+				moveRoots();
+				for (auto root : roots)
+					hierarchy::updateTransform(root, registry);
+			});
+
+			const auto clean = measure(10, [&]() {
+				hierarchy::updateHierarchy(registry);
+			});
+
+			LOGI("  {0} entities at depth {1} : linear {2:.2f} ms, parallel {3:.2f} ms, per sub-tree {4:.2f} ms, nothing dirty {5:.2f} ms",
+			     roots.size() * depth, depth, linear, parallel, subTrees, clean);
+		}
+	}
+}        // namespace maple::benchmark
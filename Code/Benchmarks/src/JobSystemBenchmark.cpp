@@ -0,0 +1,75 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+#include "Benchmark.h"
+#include "ThreadPool.h"
+
+#include "Others/Console.h"
+#include "Thread/JobSystem.h"
+#include "Thread/ParallelForEach.h"
+
+#include <atomic>
+
+namespace maple::benchmark
+{
+	namespace
+	{
+		constexpr uint32_t JobCount = 100000;
+		//the pool had 4 threads hard coded in Application
+		constexpr int32_t PoolThreads = 4;
+
+		inline auto work(uint32_t iterations, uint32_t seed) -> uint32_t
+		{
+			uint32_t value = seed;
+			for (uint32_t i = 0; i < iterations; i++)
+				value = value * 1664525u + 1013904223u;
+			return value;
+		}
+
+		auto compare(const char *name, uint32_t iterations) -> void
+		{
+			std::atomic<uint32_t> sink{0};
+
+			ThreadPool pool(PoolThreads);
+			const auto poolTime = measure(5, [&]() {
+				for (uint32_t i = 0; i < JobCount; i++)
+				{
+					pool.addTask([&, i]() -> void * {
+						sink.fetch_add(work(iterations, i), std::memory_order_relaxed);
+						return nullptr;
+					});
+				}
+				pool.waitAll();
+			});
+
+			JobSystem  jobSystem;
+			const auto jobTime = measure(5, [&]() {
+				for (uint32_t i = 0; i < JobCount; i++)
+				{
+					jobSystem.execute([&, i]() {
+						sink.fetch_add(work(iterations, i), std::memory_order_relaxed);
+					});
+				}
+				jobSystem.waitAll();
+			});
+
+			//one job per batch, the way the loaders and the culling split their work
+			const auto parallelForTime = measure(5, [&]() {
+				parallelFor(jobSystem, JobCount, [&](uint32_t i) {
+					sink.fetch_add(work(iterations, i), std::memory_order_relaxed);
+				});
+			});
+
+			doNotOptimize(sink);
+			LOGI("  {0} : ThreadPool({1}) {2:.0f} jobs/ms, JobSystem({3}) {4:.0f} jobs/ms, parallelFor {5:.0f} items/ms",
+			     name, PoolThreads, JobCount / poolTime, jobSystem.getWorkerCount(), JobCount / jobTime, JobCount / parallelForTime);
+		}
+	}        // namespace
+
+	MAPLE_BENCHMARK(JobThroughput)
+	{
+		compare("empty jobs", 0);
+		compare("jobs of 1k iterations", 1000);
+		compare("jobs of 10k iterations", 10000);
+	}
+}        // namespace maple::benchmark
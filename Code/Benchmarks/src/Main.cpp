@@ -0,0 +1,24 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+#include "Benchmark.h"
+#include "Others/Console.h"
+
+#include <cstring>
+#include <thread>
+
+//MapleBenchmarks [filter], runs the benchmarks whose name contains filter
+auto main(int32_t argc, char **argv) -> int32_t
+{
+	maple::Console::init();
+	LOGI("MapleBenchmarks : {0} hardware threads", std::thread::hardware_concurrency());
+
+	for (auto &benchmark : maple::benchmark::getRegistry())
+	{
+		if (argc > 1 && std::strstr(benchmark.first.c_str(), argv[1]) == nullptr)
+			continue;
+		LOGI("{0}", benchmark.first);
+		benchmark.second();
+	}
+	return 0;
+}
@@ -0,0 +1,50 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+#include "Benchmark.h"
+
+#include "Engine/Renderer/RenderQueue.h"
+#include "Others/Console.h"
+
+#include <algorithm>
+#include <random>
+
+namespace maple::benchmark
+{
+	MAPLE_BENCHMARK(SortKeys)
+	{
+		for (uint32_t count : {10000u, 100000u, 1000000u})
+		{
+			//a scene of a few pipelines, a few hundred materials and a few thousand meshes
+			std::mt19937                            random(count);
+			std::uniform_int_distribution<uint32_t> pipeline(0, 7);
+			std::uniform_int_distribution<uint32_t> material(0, 299);
+			std::uniform_int_distribution<uint32_t> mesh(0, 4999);
+			std::uniform_real_distribution<float>   depth(0.f, 1.f);
+
+			std::vector<render_queue::SortItem> items(count);
+			for (uint32_t i = 0; i < count; i++)
+			{
+				const auto pass = i % 10 == 0 ? render_queue::SortPass::Transparent : render_queue::SortPass::Opaque;
+				items[i]        = {render_queue::makeSortKey(pass, pipeline(random), material(random), mesh(random), depth(random)), i};
+			}
+
+			std::vector<render_queue::SortItem> sorted;
+			std::vector<render_queue::SortItem> scratch;
+			std::vector<render_queue::SortItem> reference;
+
+			const auto radix = measure(10, [&]() {
+				sorted = items;
+				render_queue::sort(sorted, scratch);
+			});
+
+			const auto stable = measure(10, [&]() {
+				reference = items;
+				std::stable_sort(reference.begin(), reference.end(), [](auto &a, auto &b) { return a.key < b.key; });
+			});
+
+			const bool same = std::equal(sorted.begin(), sorted.end(), reference.begin(), [](auto &a, auto &b) { return a.index == b.index; });
+			LOGI("  {0} commands : radix sort {1:.3f} ms, std::stable_sort {2:.3f} ms{3}", count, radix, stable, same ? "" : " (MISMATCH)");
+		}
+	}
+}        // namespace maple::benchmark
@@ -0,0 +1,117 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "ThreadPool.h"
+#include <climits>
+
+namespace maple::benchmark
+{
+	Thread::Thread(const std::string &name) :
+	    name(name)
+	{
+		thread = std::make_shared<std::thread>(&Thread::run, this);
+	}
+
+	Thread::~Thread()
+	{
+		if (thread->joinable())
+		{
+			wait();
+			mutex.lock();
+			close = true;
+			condition.notify_one();
+			mutex.unlock();
+			thread->join();
+		}
+	}
+
+	auto Thread::wait() -> void
+	{
+		std::unique_lock<std::mutex> lock(mutex);
+		condition.wait(lock, [this]() {
+			return jobs.empty();
+		});
+	}
+
+	auto Thread::getTaskSize() -> int32_t
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		return static_cast<int32_t>(jobs.size());
+	}
+
+	auto Thread::addTask(const std::function<void *()> &job) -> void
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		jobs.emplace_back(job);
+		condition.notify_one();
+	}
+
+	auto Thread::run() -> void
+	{
+		while (true)
+		{
+			std::function<void *()> job;
+			{
+				std::unique_lock<std::mutex> lock(mutex);
+				condition.wait(lock, [this] {
+					return !jobs.empty() || close;
+				});
+
+				if (close)
+				{
+					break;
+				}
+
+				job = jobs.front();
+			}
+
+			if (job)
+			{
+				job();
+			}
+			{
+				std::lock_guard<std::mutex> lock(mutex);
+				jobs.pop_front();
+				condition.notify_one();
+			}
+		}
+	}
+
+	ThreadPool::ThreadPool(int32_t count)
+	{
+		for (int32_t i = 0; i < count; i++)
+		{
+			threads.emplace_back(std::make_shared<Thread>("Thread:" + std::to_string(i)));
+		}
+	}
+
+	auto ThreadPool::waitAll() -> void
+	{
+		for (auto &i : threads)
+		{
+			i->wait();
+		}
+	}
+
+	auto ThreadPool::addTask(const std::function<void *()> &job) -> void
+	{
+		int32_t minLen   = INT32_MAX;
+		int32_t minIndex = -1;
+
+		for (int32_t i = 0; i < static_cast<int32_t>(threads.size()); ++i)
+		{
+			auto len = threads[i]->getTaskSize();
+			if (minLen > len)
+			{
+				minLen   = len;
+				minIndex = i;
+				if (minLen == 0)
+				{
+					break;
+				}
+			}
+		}
+		threads[minIndex]->addTask(job);
+	}
+}        // namespace maple::benchmark
@@ -0,0 +1,52 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <condition_variable>
+#include <functional>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace maple::benchmark
+{
+	/**
+	 * The ThreadPool the JobSystem replaced, kept as the baseline of the job benchmarks. Every thread owns a list
+	 * behind a mutex and addTask polls the size of each of them. The completions went through
+	 * Application::postOnMainThread, the benchmarks do not use them so they are left out.
+	 */
+	class Thread
+	{
+	  public:
+		Thread(const std::string &name);
+		~Thread();
+		auto wait() -> void;
+		auto getTaskSize() -> int32_t;
+		auto addTask(const std::function<void *()> &job) -> void;
+
+	  private:
+		auto                         run() -> void;
+		std::shared_ptr<std::thread> thread;
+		std::list<std::function<void *()>> jobs;
+		std::mutex                   mutex;
+		std::condition_variable      condition;
+		bool                         close = false;
+		std::string                  name;
+	};
+
+	class ThreadPool
+	{
+	  public:
+		ThreadPool(int32_t threadCount);
+		auto waitAll() -> void;
+		auto addTask(const std::function<void *()> &job) -> void;
+
+	  private:
+		std::vector<std::shared_ptr<Thread>> threads;
+	};
+}        // namespace maple::benchmark
@@ -13,6 +13,7 @@
 #include "ImGui/ImGuiHelpers.h"
 #include "RHI/Texture.h"
 #include "Loaders/Loader.h"
+#include "Loaders/TextureImporter.h"
 #include "Window/NativeWindow.h"
 #include "FileSystem/MeshResource.h"
 
@@ -262,10 +263,12 @@ namespace maple
 				{
 					if (ImGui::TreeNode(file->fileName.c_str()))
 					{
-						std::vector < std::shared_ptr<IResource> > out;
-						Loader::load(file->absolutePath, out);
+						//imported on the job system the first time the node is opened
+						auto handle = Application::getAssetsLoaderFactory()->loadAsync(file->absolutePath);
+						if (!handle->isDone())
+							ImGui::TextDisabled("Loading %d%%", int32_t(handle->getProgress() * 100));
 
-						for (auto& res : out)
+						for (auto& res : handle->getResources())
 						{
 							if(res->getResourceType() == FileType::Model)
 							{
@@ -486,6 +489,15 @@ namespace maple
 				File::create(currentDir->absolutePath + "/default.material");
 			}
 
+			if (ImGui::Selectable("Import textures to KTX2"))
+			{
+				if (TextureImporter::importFolder(currentDir->absolutePath) > 0)
+				{
+					currentDir->children.clear();
+					readDirectory(currentDir->absolutePath, currentDir);
+				}
+			}
+
 			ImGui::EndPopup();
 		}
 	}
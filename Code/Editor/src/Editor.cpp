@@ -38,6 +38,7 @@
 #include "Scene/Entity/Entity.h"
 #include "Scene/Scene.h"
 #include "Scene/SceneManager.h"
+#include "Scene/System/SceneBVHModule.h"
 
 #include "Physics/Collider.h"
 #include "Physics/PhysicsSystem.h"
@@ -63,8 +64,8 @@
 
 namespace maple
 {
-	Editor::Editor(AppDelegate *appDelegate) :
-	    Application(appDelegate)
+	Editor::Editor(AppDelegate *appDelegate, const ApplicationConfig &config) :
+	    Application(appDelegate, config)
 	{
 		editor = true;
 	}
@@ -757,7 +758,15 @@ namespace maple
 		}
 		else if (StringUtils::isModelFile(filePath) || loaderFactory->getSupportExtensions().count(ext) >= 1)
 		{
-			selectedNode = sceneManager->getCurrentScene()->addMesh(filePath).getHandle();
+			dialog.show("Importing " + StringUtils::getFileName(filePath));
+			sceneManager->getCurrentScene()->addMeshAsync(
+			    filePath, [this](Entity entity) {
+				    selectedNode = entity.getHandle();
+				    dialog.close();
+			    },
+			    [this](float progress) {
+				    dialog.setProgress(progress);
+			    });
 		}
 		else if (StringUtils::isAudioFile(filePath))
 		{
@@ -856,11 +865,13 @@ namespace maple
 
 		Group meshGroup(registry, entt::null);
 
-		for (auto entity : meshGroup)
-		{
+		//only the meshes whose bounds are crossed by the ray are tested
+		scene_bvh::getBVH(registry).tree.raycast(ray, closestDist, [&](uint32_t userData) {
+			const auto entity  = static_cast<entt::entity>(userData);
 			auto [mesh, trans] = meshGroup.convert(entity);
 			calculateClosest(mesh.mesh.get(), trans, entity);
-		}
+			return closestDist;
+		});
 
 		using SkinnedGroup = ecs::Registry ::Modify<component::SkinnedMeshRenderer>::Modify<component::Transform>::To<ecs::Group>;
 
@@ -1009,8 +1020,8 @@ namespace maple
 }        // namespace maple
 
 #if !defined(EDITOR_STATIC)
-maple::Application *createApplication()
+maple::Application *createApplication(const maple::ApplicationConfig &config)
 {
-	return new maple::Editor(new maple::DefaultDelegate());
+	return new maple::Editor(new maple::DefaultDelegate(), config);
 }
 #endif
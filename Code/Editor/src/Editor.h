@@ -25,7 +25,7 @@ namespace maple
 	{
 	  public:
 
-		Editor(AppDelegate *appDelegate);
+		Editor(AppDelegate *appDelegate, const ApplicationConfig &config = {});
 		auto init() -> void override;
 		auto onImGui() -> void override;
 		auto onUpdate(const Timestep &delta) -> void override;
@@ -44,6 +44,9 @@ namespace maple
 		TRIVIAL_COMPONENT(component::BloomData, false, "Bloom");
 
 		TRIVIAL_COMPONENT(global::component::DeltaTime, false, "Delta Time");
+		TRIVIAL_COMPONENT(global::component::RenderQueueStats, false, "Render Queue");
+		TRIVIAL_COMPONENT(component::GPUCullingData, false, "GPU Culling");
+		TRIVIAL_COMPONENT(component::FrameGraphData, false, "Frame Graph");
 		TRIVIAL_COMPONENT(physics::component::RigidBody, true, "RigidBody");
 		TRIVIAL_COMPONENT(physics::component::Collider, true, "Collider");
 		TRIVIAL_COMPONENT(vxgi_debug::global::component::DrawVoxelRender, false, "VXGI-Debug");
@@ -9,6 +9,8 @@
 #include "Engine/Mesh.h"
 #include "Engine/PathTracer/PathIntegrator.h"
 #include "Engine/Raytrace/RaytracedShadow.h"
+#include "Engine/Renderer/FrameGraph.h"
+#include "Engine/Renderer/GPUCulling.h"
 #include "Engine/Renderer/GridRenderer.h"
 #include "Engine/Renderer/PostProcessRenderer.h"
 #include "Engine/Renderer/ShadowRenderer.h"
@@ -59,6 +61,7 @@
 
 #include "CurveWindow.h"
 
+#include <algorithm>
 #include <glm/gtc/type_ptr.hpp>
 
 namespace MM
@@ -549,6 +552,56 @@ namespace MM
 		ImGui::Columns(1);
 	}
 
+	template <>
+	inline auto ComponentEditorWidget<global::component::RenderQueueStats>(entt::registry &reg, entt::registry::entity_type e) -> void
+	{
+		auto &stats = reg.get<global::component::RenderQueueStats>(e);
+		ImGui::Columns(2);
+		ImGui::Separator();
+
+		//issued / skipped
+		auto showCounters = [](const std::string &name, const global::component::BindCounters &counters) {
+			ImGuiHelper::showProperty(name + " Pipeline", std::to_string(counters.pipelineBinds) + " / " + std::to_string(counters.pipelineSkips));
+			ImGuiHelper::showProperty(name + " Descriptor", std::to_string(counters.descriptorBinds) + " / " + std::to_string(counters.descriptorSkips));
+			ImGuiHelper::showProperty(name + " Buffer", std::to_string(counters.bufferBinds) + " / " + std::to_string(counters.bufferSkips));
+			ImGuiHelper::showProperty(name + " Draws / Instances", std::to_string(counters.draws) + " / " + std::to_string(counters.instances));
+		};
+
+		showCounters("Deferred", stats.deferred);
+		showCounters("Shadow", stats.shadow);
+		ImGui::Columns(1);
+	}
+
+	template <>
+	inline auto ComponentEditorWidget<component::GPUCullingData>(entt::registry &reg, entt::registry::entity_type e) -> void
+	{
+		auto &culling = reg.get<component::GPUCullingData>(e);
+		ImGui::Columns(2);
+		ImGui::Separator();
+		ImGuiHelper::property("Enable", culling.enable);
+		ImGuiHelper::property("Validate", culling.validate);
+		ImGuiHelper::showProperty("Instances", std::to_string(culling.instances.size()));
+		ImGuiHelper::showProperty("Batches", std::to_string(culling.batches.size()));
+		ImGuiHelper::showProperty("Mismatches", std::to_string(culling.mismatches));
+		ImGui::Columns(1);
+	}
+
+	template <>
+	inline auto ComponentEditorWidget<component::FrameGraphData>(entt::registry &reg, entt::registry::entity_type e) -> void
+	{
+		auto &frameGraph = reg.get<component::FrameGraphData>(e);
+		auto &compiled   = frameGraph.compiled;
+		ImGui::Columns(2);
+		ImGui::Separator();
+		const auto culled = std::count(compiled.culled.begin(), compiled.culled.end(), true);
+		ImGuiHelper::showProperty("Passes / Culled", std::to_string(frameGraph.graph.getPasses().size()) + " / " + std::to_string(culled));
+		ImGuiHelper::showProperty("Barriers", std::to_string(compiled.barrierCount));
+		ImGuiHelper::showProperty("Transient MB", std::to_string(compiled.transientBytes >> 20));
+		ImGuiHelper::showProperty("Allocated MB", std::to_string(compiled.allocatedBytes >> 20));
+		ImGuiHelper::showProperty("Uninitialized Reads", std::to_string(compiled.uninitialized.size()));
+		ImGui::Columns(1);
+	}
+
 	template <>
 	inline auto ComponentEditorWidget<component::LPVGrid>(entt::registry &reg, entt::registry::entity_type e) -> void
 	{
@@ -11,6 +11,7 @@ namespace maple
 	{
 		this->name = name;
 		active = true;
+		progress = -1.f;
 	}
 
 	auto LoadingDialog::close() -> void
@@ -19,6 +20,11 @@ namespace maple
 		ImGui::CloseCurrentPopup();
 	}
 
+	auto LoadingDialog::setProgress(float progress) -> void
+	{
+		this->progress = progress;
+	}
+
  	auto LoadingDialog::onImGui() -> void
 	{
 		if (active) {
@@ -31,7 +37,7 @@ namespace maple
 				const ImU32 bg = ImGui::GetColorU32(ImGuiCol_Button);
 
 				ImGui::Spinner("##spinner", 15, 6, col);
-				ImGui::BufferingBar("##buffer_bar", 0.7f, ImVec2(400, 6), bg, col);
+				ImGui::BufferingBar("##buffer_bar", progress < 0 ? 0.7f : progress, ImVec2(400, 6), bg, col);
 
 			
 				ImGui::EndPopup();
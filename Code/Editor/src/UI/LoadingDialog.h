@@ -13,8 +13,11 @@ namespace maple
 		auto show(const std::string & name = "LoadingDialog")-> void;
 		auto close() -> void;
 		auto onImGui() -> void;
+		//[0, 1], the bar shows no progress until it is set
+		auto setProgress(float progress) -> void;
 	private:
 		bool active = false;
+		float progress = -1.f;
 		std::string name;
 	};
 };
@@ -103,15 +103,16 @@ namespace maple
 
 		inline auto drawCache() 
 		{
-			auto& cache = Application::getAssetsLoaderFactory()->getCache();
+			auto& registry = Application::getAssetsLoaderFactory()->getRegistry();
+			ImGui::Text("Resident : %.1f / %.1f MB", registry.getResidentBytes() / (1024.f * 1024.f), registry.getBudget() / (1024.f * 1024.f));
+			ImGui::Separator();
 			ImGui::Columns(2);
-			for (auto & res : cache)
-			{
-				ImGui::TextUnformatted(res.first.c_str());
+			registry.forEach([](const std::string& path, const AssetRegistry::Resources& resources) {
+				ImGui::TextUnformatted(path.c_str());
 				ImGui::NextColumn();
 				ImGui::PushItemWidth(-1);
 				
-				for (auto & r : res.second)
+				for (auto & r : resources)
 				{
 					if (r->getResourceType() == maple::FileType::Shader) 
 					{
@@ -127,13 +128,13 @@ namespace maple
 					{
 						auto texture = std::static_pointer_cast<Texture>(r);
 						ImGui::PushID(r.get());
-					
+				
 						ImGui::Text(fileTypeToStr(r->getResourceType()));
 
 						ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2(5, 5));
 						if (ImGui::IsItemHovered())
 						{
-							
+						
 							ImGui::BeginTooltip();
 							ImGuiHelper::image(texture.get(), { 50,50 });
 							ImGui::EndTooltip();
@@ -166,7 +167,7 @@ namespace maple
 				ImGui::PopItemWidth();
 				ImGui::Separator();
 				ImGui::NextColumn();
-			}
+			});
 			ImGui::Columns(1);
 			ImGui::Separator();
 		}
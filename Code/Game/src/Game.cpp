@@ -5,12 +5,12 @@
 #include "Application.h"
 #include "FileSystem/File.h"
 
-namespace Maple 
+namespace maple
 {
 	class Game : public Application
 	{
 	public:
-		Game(): Application(new DefaultDelegate()){}
+		Game(const ApplicationConfig &config): Application(new DefaultDelegate(), config){}
 		auto init() -> void override 
 		{
 			Application::init();
@@ -24,7 +24,7 @@ namespace Maple
 
 
 
-maple::Application* createApplication()
+maple::Application* createApplication(const maple::ApplicationConfig &config)
 {
-	return new maple::Game();
+	return new maple::Game(config);
 }
\ No newline at end of file
@@ -31,9 +31,8 @@ namespace maple
 			template <typename Archive>
 			auto save(Archive &archive) const -> void
 			{
-				std::string newPath = "";
 				archive(
-				    cereal::make_nvp("TexturePath", getTexturePath()), );
+				    cereal::make_nvp("TexturePath", getTexturePath()));
 			}
 
 			template <typename Archive>
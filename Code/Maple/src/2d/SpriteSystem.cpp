@@ -11,11 +11,12 @@ namespace maple
 {
 	namespace update
 	{
-		using Entity = ecs::Registry ::Modify<component::AnimatedSprite>::Modify<component::Transform>::To<ecs::Entity>;
+		//only the frames advance, without the transform in the query it runs alongside the transform updates
+		using Entity = ecs::Registry ::Modify<component::AnimatedSprite>::To<ecs::Entity>;
 
 		inline auto systemAnimatedSprite(Entity entity, const global::component::DeltaTime &dt, ecs::World world)
 		{
-			auto [anim, trans] = entity;
+			auto [anim] = entity;
 
 			anim.frameTimer += dt.dt;
 			if (anim.currentFrame < anim.animationFrames.size())
@@ -33,7 +34,7 @@ namespace maple
 			}
 		};
 
-		using SpriteEntity = ecs::Registry ::Modify<component::Sprite>::Modify<component::Transform>::To<ecs::Entity>;
+		using SpriteEntity = ecs::Registry ::Fetch<component::Sprite>::Fetch<component::Transform>::To<ecs::Entity>;
 
 		inline auto systemSprite(SpriteEntity entity, ecs::World world){
 
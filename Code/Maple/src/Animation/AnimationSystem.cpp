@@ -404,7 +404,8 @@ namespace maple
 
 		auto registerAnimationModule(std::shared_ptr<ExecutePoint> executePoint) -> void
 		{
-			executePoint->registerSystem<animation::system>();
+			//bones are found and driven through the world, not the query
+			executePoint->registerSystem<animation::system, access::Write<component::Transform>, access::Read<component::Hierarchy, component::BoneComponent>>();
 		}
 	}        // namespace animation
 };           // namespace maple
@@ -38,36 +38,79 @@
 
 #include "Loaders/Loader.h"
 
+#include "RHI/Pipeline.h"
 #include "RHI/Texture.h"
 #include "Scene/SystemBuilder.inl"
 
+#include <cstdlib>
 #include <imgui.h>
 
 //maple::Application* app;
 
 namespace maple
 {
-	Application::Application(AppDelegate *app)
+	auto ApplicationConfig::fromCommandLine(int32_t argc, char **argv) -> ApplicationConfig
 	{
+		ApplicationConfig config;
+		for (int32_t i = 1; i < argc; i++)
+		{
+			const std::string arg  = argv[i];
+			const bool        next = i + 1 < argc;
+			if (arg == "--headless")
+			{
+				config.headless = true;
+			}
+			else if (arg == "--frames" && next)
+			{
+				config.frameLimit = std::strtoull(argv[++i], nullptr, 10);
+			}
+			else if (arg == "--timestep" && next)
+			{
+				config.fixedTimestep = std::strtof(argv[++i], nullptr);
+			}
+			else
+			{
+				LOGW("Unknown command line argument {0}", arg);
+			}
+		}
+		return config;
+	}
+
+	Application::Application(AppDelegate *app, const ApplicationConfig &config) :
+	    config(config)
+	{
+#ifndef MAPLE_NULL
+		if (this->config.headless)
+		{
+			//the gpu backends need a surface to present to, only the frame limit and the timestep apply
+			LOGW("Headless mode needs the null renderer (MAPLE_NULL), a window is created instead");
+			this->config.headless = false;
+		}
+#endif        // MAPLE_NULL
+
 		appDelegate     = std::shared_ptr<AppDelegate>(app);
-		window          = NativeWindow::create(WindowInitData{1280, 720, false, "Maple-Engine"});
+		window          = NativeWindow::create(WindowInitData{config.width, config.height, false, "Maple-Engine", this->config.headless});
 		renderDevice    = RenderDevice::create();
 		graphicsContext = GraphicsContext::create();
 
 		sceneManager  = std::make_unique<SceneManager>();
-		threadPool    = std::make_unique<ThreadPool>(4);
+		jobSystem     = std::make_unique<JobSystem>();
 		texturePool   = std::make_unique<TexturePool>();
 		luaVm         = std::make_unique<LuaVirtualMachine>();
 		monoVm        = std::make_shared<MonoVirtualMachine>();
 		renderGraph   = std::make_shared<RenderGraph>();
 		loaderFactory = std::make_shared<AssetsLoaderFactory>();
+
+		textureStreamer = std::make_unique<TextureStreamer>(this->config.textureBudget);
 	}
 
 	auto Application::init() -> void
 	{
 		PROFILE_FUNCTION();
+		const auto begin = timer.current();
 		renderDoc.openLib();
 		executePoint = std::make_shared<ExecutePoint>();
+		executePoint->setJobSystem(jobSystem.get());
 		executePoint->addDependency<Camera, component::Transform>();
 		executePoint->addDependency<component::Light, component::Transform>();
 		executePoint->addDependency<component::MeshRenderer, component::Transform>();
@@ -92,6 +135,8 @@ namespace maple
 		window->init();
 		graphicsContext->init();
 		renderDevice->init();
+		//compiles last session's pipelines in the background while the renderer and the scene load
+		Pipeline::prewarm();
 
 		timer.start();
 		luaVm->init();
@@ -104,6 +149,9 @@ namespace maple
 		appDelegate->onInit();
 
 		registerSystem(executePoint);
+
+		//compare with a run after deleting the cache folder to see what the pipeline and reflection caches save
+		LOGI("Startup : {0} ms", timer.elapsed(begin, timer.current()) / 1000.f);
 	}
 
 	auto Application::start() -> int32_t
@@ -111,20 +159,29 @@ namespace maple
 		double lastFrameTime = 0;
 		init();
 
-		while (!window->isClose())
+		const auto begin = timer.current();
+
+		while (!window->isClose() && (config.frameLimit == 0 || totalFrames < config.frameLimit))
 		{
 			PROFILE_FRAMEMARKER();
 			Input::getInput()->resetPressed();
 			Timestep timestep = timer.stop() / 1000000.f;
+			if (config.fixedTimestep > 0.f)
+				timestep = config.fixedTimestep;
 			imGuiManager->newFrame(timestep);
+			Pipeline::newFrame();
 			{
 				sceneManager->apply();
 				executeAll();
+				jobSystem->flushMainThread();
 				onUpdate(timestep);
 				onRender();
 				frames++;
+				totalFrames++;
 			}
 			graphicsContext->clearUnused();
+			textureStreamer->update();
+			loaderFactory->getRegistry().update();
 			lastFrameTime += timestep;
 			if (lastFrameTime - secondTimer > 1.0f)        //tick later
 			{
@@ -135,8 +192,15 @@ namespace maple
 			}
 		}
 
+		if (config.headless)
+		{
+			const auto ms = timer.elapsed(begin, timer.current()) / 1000.f;
+			LOGI("Headless run : {0} frames in {1} ms, {2} ms per frame", totalFrames, ms, totalFrames > 0 ? ms / totalFrames : 0.f);
+		}
+
 		physics::exitPhysics(executePoint->getGlobalComponent<global::physics::component::PhysicsWorld>());
 		appDelegate->onDestory();
+		graphicsContext->saveCaches();
 		return 0;
 	}
 
@@ -9,6 +9,7 @@
 #include "Engine/Core.h"
 #include "Engine/Renderer/RenderGraph.h"
 #include "Engine/TexturePool.h"
+#include "Engine/TextureStreamer.h"
 #include "Engine/Timestep.h"
 #include "Event/EventDispatcher.h"
 #include "ImGui/ImGuiSystem.h"
@@ -19,7 +20,7 @@
 #include "Scene/Component/AppState.h"
 #include "Scene/SceneManager.h"
 #include "Scripts/Lua/LuaVirtualMachine.h"
-#include "Thread/ThreadPool.h"
+#include "Thread/JobSystem.h"
 #include "Window/NativeWindow.h"
 
 namespace maple
@@ -43,10 +44,27 @@ namespace maple
 		virtual auto onDestory() -> void override{};
 	};
 
+	struct MAPLE_EXPORT ApplicationConfig
+	{
+		uint32_t width  = 1280;
+		uint32_t height = 720;
+#ifdef MAPLE_NULL
+		bool headless = true;        //the null renderer has nothing to present
+#else
+		bool headless = false;
+#endif
+		uint64_t frameLimit    = 0;                           //quit after this many frames, 0 runs until the window is closed
+		float    fixedTimestep = 0.f;                         //in seconds, makes offscreen runs reproducible. 0 uses the measured frame time
+		uint64_t textureBudget = 512ull * 1024 * 1024;        //gpu memory of the streamed textures in bytes
+
+		//--headless, --frames N and --timestep SECONDS, unknown arguments are logged and skipped
+		static auto fromCommandLine(int32_t argc, char **argv) -> ApplicationConfig;
+	};
+
 	class MAPLE_EXPORT Application
 	{
 	  public:
-		Application(AppDelegate *appDelegate);
+		Application(AppDelegate *appDelegate, const ApplicationConfig &config = {});
 
 		auto start() -> int32_t;
 		auto setSceneActive(bool active) -> void;
@@ -87,6 +105,11 @@ namespace maple
 			return sceneActive;
 		}
 
+		inline auto &getConfig() const
+		{
+			return config;
+		}
+
 		inline auto &getEditorState() const
 		{
 			return state;
@@ -97,9 +120,9 @@ namespace maple
 			return get()->renderGraph;
 		}
 
-		inline static auto &getThreadPool()
+		inline static auto &getJobSystem()
 		{
-			return get()->threadPool;
+			return get()->jobSystem;
 		}
 
 		template <class T>
@@ -112,6 +135,11 @@ namespace maple
 		{
 			return get()->texturePool;
 		}
+		inline static auto &getTextureStreamer()
+		{
+			return get()->textureStreamer;
+		}
+
 		inline static auto &getLuaVirtualMachine()
 		{
 			return get()->luaVm;
@@ -164,7 +192,7 @@ namespace maple
 	  protected:
 		std::unique_ptr<NativeWindow>      window;
 		std::unique_ptr<SceneManager>      sceneManager;
-		std::unique_ptr<ThreadPool>        threadPool;
+		std::unique_ptr<JobSystem>         jobSystem;
 		std::unique_ptr<TexturePool>       texturePool;
 		std::unique_ptr<LuaVirtualMachine> luaVm;
 
@@ -176,12 +204,15 @@ namespace maple
 		std::shared_ptr<RenderGraph>         renderGraph;
 		std::shared_ptr<ExecutePoint>        executePoint;
 		std::shared_ptr<AssetsLoaderFactory> loaderFactory;
+		std::unique_ptr<TextureStreamer>     textureStreamer;        //released before the graphics context
 
+		ApplicationConfig                                                config;
 		RenderDocExt                                                     renderDoc;
 		EventDispatcher                                                  dispatcher;
 		Timer                                                            timer;
 		uint64_t                                                         updates     = 0;
 		uint64_t                                                         frames      = 0;
+		uint64_t                                                         totalFrames = 0;
 		float                                                            secondTimer = 0.0f;
 		bool                                                             sceneActive = true;
 		bool                                                             editor      = false;
@@ -7,6 +7,7 @@
 #include "Math/Ray.h"
 #include "Scene/Component/Component.h"
 #include "Scene/Component/Transform.h"
+#include <cereal/cereal.hpp>
 #include <glm/glm.hpp>
 
 namespace maple
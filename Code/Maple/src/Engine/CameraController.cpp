@@ -91,7 +91,7 @@ namespace maple
 			{
 				auto position = transform.getLocalPosition();
 				position += velocity * dt;
-				velocity = velocity * pow(dampeningFactor, dt);
+				velocity = velocity * std::pow(dampeningFactor, dt);
 				transform.setLocalPosition(position);
 			}
 		}
@@ -177,7 +177,7 @@ namespace maple
 				}
 				else
 				{
-					zoomVelocity = zoomVelocity * pow(zoomDampeningFactor, dt);
+					zoomVelocity = zoomVelocity * std::pow(zoomDampeningFactor, dt);
 				}
 				camera->setScale(scale);
 			}
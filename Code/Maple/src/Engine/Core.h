@@ -11,12 +11,19 @@
 #include <unordered_map>
 #include <vector>
 
+#ifdef _MSC_VER
+#	define MAPLE_DEBUG_BREAK() __debugbreak()
+#else
+#	include <csignal>
+#	define MAPLE_DEBUG_BREAK() std::raise(SIGTRAP)
+#endif
+
 #define MAPLE_ASSERT(condition, ...)                                                         \
 	{                                                                                        \
 		if (!(condition))                                                                    \
 		{                                                                                    \
 			LOGE("Assertion Failed : {0} . {1} : {2}", __VA_ARGS__, __FUNCTION__, __LINE__); \
-			__debugbreak();                                                                  \
+			MAPLE_DEBUG_BREAK();                                                             \
 		}                                                                                    \
 	}
 
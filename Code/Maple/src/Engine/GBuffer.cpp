@@ -5,6 +5,8 @@
 #include "GBuffer.h"
 #include "Others/Randomizer.h"
 
+#include <algorithm>
+
 namespace maple
 {
 	GBuffer::GBuffer(uint32_t width, uint32_t height, const CommandBuffer *commandBuffer) :
@@ -31,6 +33,32 @@ namespace maple
 		//buildTexture(commandBuffer);
 	}
 
+	auto GBuffer::getDesc(uint32_t index) const -> frame_graph::TextureDesc
+	{
+		if (index == VOLUMETRIC_LIGHT)
+			return {width / 2, height / 2, formats[index]};
+		return {width, height, formats[index]};
+	}
+
+	auto GBuffer::setAliases(const frame_graph::CompiledGraph &graph) -> void
+	{
+		physical.assign(graph.physical.begin(), graph.physical.begin() + GBufferTextures::LENGTH);
+		//the old textures are released through the deletion queue of the backend
+		if (depthBuffer != nullptr)
+		{
+			createTextures();
+			buildTextures();
+		}
+	}
+
+	auto GBuffer::isAliasOwner(uint32_t index) const -> bool
+	{
+		if (physical.empty())
+			return true;
+		return physical[index] != frame_graph::NoPhysical &&
+		       std::find(physical.begin(), physical.begin() + index, physical[index]) == physical.begin() + index;
+	}
+
 	auto GBuffer::resize(uint32_t width, uint32_t height, const CommandBuffer *commandBuffer) -> void
 	{
 		this->width  = width;
@@ -38,15 +66,41 @@ namespace maple
 		buildTexture(commandBuffer);
 	}
 
-	auto GBuffer::buildTexture(const CommandBuffer *commandBuffer) -> void
+	auto GBuffer::createTextures() -> void
 	{
-		if (depthBuffer == nullptr)
+		for (uint32_t i = 0; i < GBufferTextures::LENGTH; i++)
 		{
-			for (auto i = 0; i < GBufferTextures::LENGTH; i++)
+			if (physical.empty() || physical[i] == frame_graph::NoPhysical || isAliasOwner(i))
 			{
 				screenTextures[i] = Texture2D::create();
 				screenTextures[i]->setName(GBufferNames[i]);
 			}
+			else
+			{
+				const auto owner  = std::find(physical.begin(), physical.end(), physical[i]) - physical.begin();
+				screenTextures[i] = screenTextures[owner];
+				screenTextures[i]->setName(screenTextures[owner]->getName() + "/" + GBufferNames[i]);
+			}
+		}
+	}
+
+	auto GBuffer::buildTextures() -> void
+	{
+		for (int32_t i = COLOR; i < LENGTH; i++)
+		{
+			if (!isAliasOwner(i))
+				continue;
+
+			const auto desc = getDesc(i);
+			screenTextures[i]->buildTexture(desc.format, desc.width, desc.height, false, false, false);
+		}
+	}
+
+	auto GBuffer::buildTexture(const CommandBuffer *commandBuffer) -> void
+	{
+		if (depthBuffer == nullptr)
+		{
+			createTextures();
 			depthBuffer = TextureDepth::create(width, height, true, commandBuffer);
 			depthBuffer->setName("GBuffer-Depth");
 #if defined(__ANDROID__)
@@ -63,17 +117,7 @@ namespace maple
 			ssaoNoiseMap->setName("SSAO-NoiseMap");
 		}
 
-		for (int32_t i = COLOR; i < LENGTH; i++)
-		{
-			if (i == VOLUMETRIC_LIGHT)
-			{
-				screenTextures[i]->buildTexture(formats[i], width / 2.f, height / 2.f, false, false, false);
-			}
-			else
-			{
-				screenTextures[i]->buildTexture(formats[i], width, height, false, false, false);
-			}
-		}
+		buildTextures();
 		depthBuffer->resize(width, height, commandBuffer);
 	}
 }        // namespace maple
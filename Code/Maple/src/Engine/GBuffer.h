@@ -2,6 +2,7 @@
 // This file is part of the Maple Engine                              		//
 //////////////////////////////////////////////////////////////////////////////
 #pragma once
+#include "Engine/Renderer/FrameGraph.h"
 #include "RHI/Texture.h"
 #include <array>
 #include <glm/glm.hpp>
@@ -88,7 +89,27 @@ namespace maple
 			return ssaoNoiseMap;
 		}
 
+		//description of a buffer in the frame graph, resource i of the graph is GBufferTextures i
+		auto getDesc(uint32_t index) const -> frame_graph::TextureDesc;
+
+		/**
+		 * Buffers which share a physical texture of the compiled graph share one Texture2D, buffers which are not used by any
+		 * live pass are never built. Once built, the buffers are created again for the new graph.
+		 */
+		auto setAliases(const frame_graph::CompiledGraph &graph) -> void;
+
+		//false if no live pass uses the buffer, it is not built and must not be bound
+		inline auto isAllocated(uint32_t index) const
+		{
+			return physical.empty() || physical[index] != frame_graph::NoPhysical;
+		}
+
 	  private:
+		auto isAliasOwner(uint32_t index) const -> bool;
+		auto createTextures() -> void;
+		auto buildTextures() -> void;
+
+		std::vector<int32_t> physical;        //empty if every buffer owns its texture
 		std::array<std::shared_ptr<Texture2D>, GBufferTextures::LENGTH> screenTextures;
 		std::array<TextureFormat, GBufferTextures::LENGTH>              formats;
 		std::shared_ptr<TextureDepth>                                   depthBuffer;
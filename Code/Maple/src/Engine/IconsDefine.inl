@@ -18,6 +18,9 @@
 #include "Engine/Renderer/PostProcessRenderer.h"
 #include "Engine/Renderer/SkyboxRenderer.h"
 #include "Engine/Renderer/FinalPass.h"
+#include "Engine/Renderer/GPUCulling.h"
+#include "Engine/Renderer/FrameGraph.h"
+#include "Engine/Renderer/RenderQueue.h"
 #include "Engine/Renderer/ShadowRenderer.h"
 #include "Engine/LPVGI/ReflectiveShadowMap.h"
 #include "Engine/LPVGI/LightPropagationVolume.h"
@@ -75,6 +78,9 @@ COMP_ICON(component::MonoComponent,							ICON_MDI_LANGUAGE_CSHARP);
 COMP_ICON(component::BloomData,								ICON_MDI_BRIGHTNESS_AUTO);
 COMP_ICON(component::PathIntegrator,						ICON_MDI_RAY_START);
 COMP_ICON(global::component::DeltaTime,						ICON_MDI_TIMELAPSE);
+COMP_ICON(global::component::RenderQueueStats,				ICON_MDI_SORT);
+COMP_ICON(component::GPUCullingData,						ICON_MDI_FILTER);
+COMP_ICON(component::FrameGraphData,						ICON_MDI_SITEMAP);
 COMP_ICON(physics::component::RigidBody,					ICON_MDI_NATURE_PEOPLE);
 COMP_ICON(physics::component::Collider,						ICON_MDI_BOOMBOX);
 COMP_ICON(vxgi::component::Voxelization,					ICON_MDI_LIGHTHOUSE_ON);
@@ -26,10 +26,14 @@ namespace maple
 			{
 				std::shared_ptr<Shader>                     shader;
 				std::vector<std::shared_ptr<DescriptorSet>> descriptorSets;
+				UniformHandle                               minAABB;
+				UniformHandle                               cellSize;
 				IndirectLight()
 				{
 					shader = Shader::create("shaders/LPV/IndirectLight.shader");
 					descriptorSets.emplace_back(DescriptorSet::create({0, shader.get()}));
+					minAABB  = descriptorSets[0]->getUniformHandle(UniformId("UniformBufferObject", "minAABB"));
+					cellSize = descriptorSets[0]->getUniformHandle(UniformId("UniformBufferObject", "cellSize"));
 				}
 			};
 		};        // namespace component
@@ -45,8 +49,8 @@ namespace maple
 
 			auto commandBuffer = renderData.commandBuffer;
 
-			indirectLight.descriptorSets[0]->setUniform("UniformBufferObject", "minAABB", glm::value_ptr(aabb.box->min));
-			indirectLight.descriptorSets[0]->setUniform("UniformBufferObject", "cellSize", &lpv.cellSize);
+			indirectLight.descriptorSets[0]->setUniform(indirectLight.minAABB, glm::value_ptr(aabb.box->min));
+			indirectLight.descriptorSets[0]->setUniform(indirectLight.cellSize, &lpv.cellSize);
 			indirectLight.descriptorSets[0]->setTexture("uRAccumulatorLPV", lpv.lpvAccumulatorR);
 			indirectLight.descriptorSets[0]->setTexture("uGAccumulatorLPV", lpv.lpvAccumulatorG);
 			indirectLight.descriptorSets[0]->setTexture("uBAccumulatorLPV", lpv.lpvAccumulatorB);
@@ -81,8 +85,11 @@ namespace maple
 			executePoint->registerGlobalComponent<component::IndirectLight>();
 		}
 
-		auto registerLPVIndirectLight(ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint) -> void
+		auto registerLPVIndirectLight(ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint, frame_graph::FrameGraph::PassBuilder pass) -> void
 		{
+			pass.read(GBufferTextures::NORMALS)
+			    .read(GBufferTextures::POSITION)
+			    .write(GBufferTextures::INDIRECT_LIGHTING, ResourceState::Storage);
 			executePoint->registerWithinQueue<lpv_indirect_lighting::dispatch>(renderer);
 		}
 	}        // namespace lpv_indirect_lighting
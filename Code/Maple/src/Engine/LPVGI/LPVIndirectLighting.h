@@ -4,6 +4,7 @@
 #pragma once
 
 #include "Engine/Core.h"
+#include "Engine/Renderer/FrameGraph.h"
 #include "Engine/Renderer/Renderer.h"
 #include "Scene/System/ExecutePoint.h"
 
@@ -12,6 +13,6 @@ namespace maple
 	namespace lpv_indirect_lighting
 	{
 		auto MAPLE_EXPORT registerGlobalComponent(std::shared_ptr<ExecutePoint> executePoint) -> void;
-		auto              registerLPVIndirectLight(ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint) -> void;
+		auto              registerLPVIndirectLight(ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint, frame_graph::FrameGraph::PassBuilder pass) -> void;
 	};        // namespace lpv_indirect_lighting
 }        // namespace maple
\ No newline at end of file
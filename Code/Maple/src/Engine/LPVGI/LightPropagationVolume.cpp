@@ -65,10 +65,16 @@ namespace maple
 			std::shared_ptr<Shader>                     shader;
 			std::vector<std::shared_ptr<DescriptorSet>> descriptors;
 			BoundingBox                                 boundingBox;
+			UniformHandle                               gridSize;
+			UniformHandle                               minAABB;
+			UniformHandle                               cellSize;
 			InjectLightData()
 			{
 				shader = Shader::create("shaders/LPV/LightInjection.shader");
 				descriptors.emplace_back(DescriptorSet::create({0, shader.get()}));
+				gridSize = descriptors[0]->getUniformHandle(UniformId("UniformBufferObject", "gridSize"));
+				minAABB  = descriptors[0]->getUniformHandle(UniformId("UniformBufferObject", "minAABB"));
+				cellSize = descriptors[0]->getUniformHandle(UniformId("UniformBufferObject", "cellSize"));
 			}
 		};
 
@@ -76,10 +82,20 @@ namespace maple
 		{
 			std::shared_ptr<Shader>                     shader;
 			std::vector<std::shared_ptr<DescriptorSet>> descriptors;
+			UniformHandle                               lightViewMat;
+			UniformHandle                               minAABB;
+			UniformHandle                               cellSize;
+			UniformHandle                               lightDir;
+			UniformHandle                               rsmArea;
 			InjectGeometryVolume()
 			{
 				shader = Shader::create("shaders/LPV/GeometryInjection.shader");
 				descriptors.emplace_back(DescriptorSet::create({0, shader.get()}));
+				lightViewMat = descriptors[0]->getUniformHandle(UniformId("UniformBufferObject", "lightViewMat"));
+				minAABB      = descriptors[0]->getUniformHandle(UniformId("UniformBufferObject", "minAABB"));
+				cellSize     = descriptors[0]->getUniformHandle(UniformId("UniformBufferObject", "cellSize"));
+				lightDir     = descriptors[0]->getUniformHandle(UniformId("UniformBufferObject", "lightDir"));
+				rsmArea      = descriptors[0]->getUniformHandle(UniformId("UniformBufferObject", "rsmArea"));
 			}
 		};
 
@@ -87,6 +103,9 @@ namespace maple
 		{
 			std::shared_ptr<Shader>                     shader;
 			std::vector<std::shared_ptr<DescriptorSet>> descriptors;
+			UniformHandle                               gridDim;
+			UniformHandle                               occlusionAmplifier;
+			UniformHandle                               step;        //valid for every step, the sets share the shader
 			PropagationData()
 			{
 				shader = Shader::create("shaders/LPV/LightPropagation.shader");
@@ -94,6 +113,9 @@ namespace maple
 				{
 					descriptors.emplace_back(DescriptorSet::create({0, shader.get()}));
 				}
+				gridDim            = descriptors[0]->getUniformHandle(UniformId("UniformObject", "gridDim"));
+				occlusionAmplifier = descriptors[0]->getUniformHandle(UniformId("UniformObject", "occlusionAmplifier"));
+				step               = descriptors[0]->getUniformHandle(UniformId("UniformObject", "step"));
 			}
 		};
 
@@ -102,12 +124,18 @@ namespace maple
 			std::shared_ptr<Shader>                     shader;
 			std::vector<std::shared_ptr<DescriptorSet>> descriptors;
 			std::shared_ptr<Mesh>                       sphere;
+			UniformHandle                               projView;
+			UniformHandle                               minAABB;
+			UniformHandle                               cellSize;
 			DebugAABBData()
 			{
 				shader = Shader::create("shaders/LPV/AABBDebug.shader");
 				descriptors.emplace_back(DescriptorSet::create({0, shader.get()}));
 				descriptors.emplace_back(DescriptorSet::create({1, shader.get()}));
-				sphere = Mesh::createSphere();
+				projView = descriptors[0]->getUniformHandle(UniformId("UniformBufferObjectVert", "projView"));
+				minAABB  = descriptors[1]->getUniformHandle(UniformId("UniformBufferObjectFrag", "minAABB"));
+				cellSize = descriptors[1]->getUniformHandle(UniformId("UniformBufferObjectFrag", "cellSize"));
+				sphere   = Mesh::createSphere();
 			}
 		};
 
@@ -146,9 +174,9 @@ namespace maple
 					injectLight.boundingBox.min = scenAABB.box->min;
 					injectLight.boundingBox.max = scenAABB.box->max;
 
-					injectLight.descriptors[0]->setUniform("UniformBufferObject", "gridSize", &lpv.gridSize);
-					injectLight.descriptors[0]->setUniform("UniformBufferObject", "minAABB", glm::value_ptr(injectLight.boundingBox.min));
-					injectLight.descriptors[0]->setUniform("UniformBufferObject", "cellSize", &lpv.cellSize);
+					injectLight.descriptors[0]->setUniform(injectLight.gridSize, &lpv.gridSize);
+					injectLight.descriptors[0]->setUniform(injectLight.minAABB, glm::value_ptr(injectLight.boundingBox.min));
+					injectLight.descriptors[0]->setUniform(injectLight.cellSize, &lpv.cellSize);
 				}
 			}
 
@@ -206,11 +234,11 @@ namespace maple
 				auto [lpv, geometry, aabb, shadowData, rsm, rendererData] = entity;
 				if (lpv.lpvGridR == nullptr || !sceneChanged.dirty)
 					return;
-				geometry.descriptors[0]->setUniform("UniformBufferObject", "lightViewMat", glm::value_ptr(rsm.lightMatrix));
-				geometry.descriptors[0]->setUniform("UniformBufferObject", "minAABB", glm::value_ptr(aabb.box->min));
-				geometry.descriptors[0]->setUniform("UniformBufferObject", "cellSize", &lpv.cellSize);
-				geometry.descriptors[0]->setUniform("UniformBufferObject", "lightDir", glm::value_ptr(shadowData.lightDir));
-				geometry.descriptors[0]->setUniform("UniformBufferObject", "rsmArea", &rsm.lightArea);
+				geometry.descriptors[0]->setUniform(geometry.lightViewMat, glm::value_ptr(rsm.lightMatrix));
+				geometry.descriptors[0]->setUniform(geometry.minAABB, glm::value_ptr(aabb.box->min));
+				geometry.descriptors[0]->setUniform(geometry.cellSize, &lpv.cellSize);
+				geometry.descriptors[0]->setUniform(geometry.lightDir, glm::value_ptr(shadowData.lightDir));
+				geometry.descriptors[0]->setUniform(geometry.rsmArea, &rsm.lightArea);
 			}
 
 			inline auto render(Entity                                          entity,
@@ -264,8 +292,8 @@ namespace maple
 				auto [lpv, data, aabb, renderData] = entity;
 				if (lpv.lpvGridR == nullptr || !sceneChanged.dirty)
 					return;
-				data.descriptors[0]->setUniform("UniformObject", "gridDim", glm::value_ptr(aabb.box->size()));
-				data.descriptors[0]->setUniform("UniformObject", "occlusionAmplifier", &lpv.occlusionAmplifier);
+				data.descriptors[0]->setUniform(data.gridDim, glm::value_ptr(aabb.box->size()));
+				data.descriptors[0]->setUniform(data.occlusionAmplifier, &lpv.occlusionAmplifier);
 			}
 
 			inline auto render(Entity                                          entity,
@@ -302,7 +330,7 @@ namespace maple
 					data.descriptors[i - 1]->setTexture("LPVGridR_", lpv.lpvRs[i]);
 					data.descriptors[i - 1]->setTexture("LPVGridG_", lpv.lpvGs[i]);
 					data.descriptors[i - 1]->setTexture("LPVGridB_", lpv.lpvBs[i]);
-					data.descriptors[i - 1]->setUniform("UniformObject", "step", &i);
+					data.descriptors[i - 1]->setUniform(data.step, &i);
 					data.descriptors[i - 1]->update(rendererData.commandBuffer);
 				}
 
@@ -337,10 +365,10 @@ namespace maple
 				if (lpv.lpvGridR == nullptr || !lpv.debugAABB)
 					return;
 
-				data.descriptors[0]->setUniform("UniformBufferObjectVert", "projView", glm::value_ptr(cameraView.projView));
+				data.descriptors[0]->setUniform(data.projView, glm::value_ptr(cameraView.projView));
 
-				data.descriptors[1]->setUniform("UniformBufferObjectFrag", "minAABB", glm::value_ptr(aabb.box->min));
-				data.descriptors[1]->setUniform("UniformBufferObjectFrag", "cellSize", &lpv.cellSize);
+				data.descriptors[1]->setUniform(data.minAABB, glm::value_ptr(aabb.box->min));
+				data.descriptors[1]->setUniform(data.cellSize, &lpv.cellSize);
 			}
 
 			inline auto render(Entity entity, ecs::World world)
@@ -435,8 +463,9 @@ namespace maple
 			executePoint->registerWithinQueue<propagation_pass::render>(renderer);
 		}
 
-		auto registerLPVDebug(ExecuteQueue &begin, ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint) -> void
+		auto registerLPVDebug(ExecuteQueue &begin, ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint, frame_graph::FrameGraph::PassBuilder pass) -> void
 		{
+			pass.write(GBufferTextures::SCREEN).sideEffect();
 			executePoint->registerWithinQueue<aabb_debug::beginScene>(begin);
 			executePoint->registerWithinQueue<aabb_debug::render>(renderer);
 		}
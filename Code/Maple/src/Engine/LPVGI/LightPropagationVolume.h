@@ -4,6 +4,7 @@
 #pragma once
 
 #include "Engine/Core.h"
+#include "Engine/Renderer/FrameGraph.h"
 #include "Engine/Renderer/Renderer.h"
 #include "RHI/Texture.h"
 #include "Scene/System/ExecutePoint.h"
@@ -50,6 +51,6 @@ namespace maple
 	{
 		auto MAPLE_EXPORT registerGlobalComponent(std::shared_ptr<ExecutePoint> point) -> void;
 		auto              registerLPV(ExecuteQueue &begin, ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint) -> void;
-		auto              registerLPVDebug(ExecuteQueue &begin, ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint) -> void;
+		auto              registerLPVDebug(ExecuteQueue &begin, ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint, frame_graph::FrameGraph::PassBuilder pass) -> void;
 	};        // namespace light_propagation_volume
 };            // namespace maple
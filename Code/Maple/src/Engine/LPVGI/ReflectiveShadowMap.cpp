@@ -21,6 +21,7 @@
 #include "Scene/Component/Light.h"
 #include "Scene/Component/MeshRenderer.h"
 #include "Scene/Scene.h"
+#include "Scene/System/SceneBVHModule.h"
 
 #include "RHI/CommandBuffer.h"
 #include "RHI/DescriptorSet.h"
@@ -76,7 +77,7 @@ namespace maple
 
 					if (directionaLight)
 					{
-						rsm.descriptorSets[2]->setUniform("LightUBO", "light", &directionaLight->lightData);
+						rsm.descriptorSets[2]->setUniform(rsm.light, &directionaLight->lightData);
 						rsm.descriptorSets[2]->update(renderData.commandBuffer);
 
 						if (directionaLight)
@@ -98,26 +99,22 @@ namespace maple
 							rsm.lightArea   = distance * distance * 4;
 						}
 
-						for (auto meshEntity : meshQuery)
-						{
-							auto [mesh, trans] = meshQuery.convert(meshEntity);
+						scene_bvh::getBVH(world.getRegistry()).tree.query(rsm.frustum, [&](uint32_t userData) {
+							auto [mesh, trans] = meshQuery.convert(static_cast<entt::entity>(userData));
 
-							if (mesh.active && mesh.mesh)
+							//the flux is rendered with the float vertex layout
+							if (mesh.active && mesh.mesh && !mesh.mesh->isCompressed())
 							{
-								auto inside = rsm.frustum.isInside(mesh.mesh->getBoundingBox()->transform(trans.getWorldMatrix()));
-								if (inside)
+								auto &cmd     = rsm.commandQueue.emplace_back();
+								cmd.mesh      = mesh.mesh.get();
+								cmd.transform = trans.getWorldMatrix();
+
+								for (auto material : mesh.mesh->getMaterial())
 								{
-									auto &cmd     = rsm.commandQueue.emplace_back();
-									cmd.mesh      = mesh.mesh.get();
-									cmd.transform = trans.getWorldMatrix();
-
-									for (auto material : mesh.mesh->getMaterial())
-									{
-										material->setShader(rsm.shader, true);
-									}
+									material->setShader(rsm.shader, true);
 								}
 							}
-						}
+						});
 					}
 				}
 			}
@@ -129,7 +126,7 @@ namespace maple
 		{
 			auto [rsm, renderData, renderGraph] = entity;
 
-			rsm.descriptorSets[0]->setUniform("UniformBufferObject", "lightProjection", &rsm.projView);
+			rsm.descriptorSets[0]->setUniform(rsm.lightProjection, &rsm.projView);
 
 			auto commandBuffer = renderData.commandBuffer;
 
@@ -198,6 +195,8 @@ namespace maple
 				data.descriptorSets.resize(3);
 				data.descriptorSets[0] = DescriptorSet::create({0, data.shader.get()});
 				data.descriptorSets[2] = DescriptorSet::create({2, data.shader.get()});
+				data.lightProjection   = data.descriptorSets[0]->getUniformHandle(UniformId("UniformBufferObject", "lightProjection"));
+				data.light             = data.descriptorSets[2]->getUniformHandle(UniformId("LightUBO", "light"));
 				TextureParameters parameters;
 
 				parameters.format = TextureFormat::RGBA32;
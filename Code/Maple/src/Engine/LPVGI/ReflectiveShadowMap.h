@@ -6,6 +6,7 @@
 #include "Engine/Core.h"
 #include "Engine/Renderer/Renderer.h"
 #include "Math/Frustum.h"
+#include "RHI/DescriptorSet.h"
 #include "RHI/Shader.h"
 #include "Scene/System/ExecutePoint.h"
 
@@ -20,6 +21,8 @@ namespace maple
 			bool                                        enable = false;
 			std::shared_ptr<Shader>                     shader;
 			std::vector<std::shared_ptr<DescriptorSet>> descriptorSets;
+			UniformHandle                               lightProjection;        //resolved once when the descriptor sets are created
+			UniformHandle                               light;
 			std::shared_ptr<Texture2D>                  fluxTexture;
 			std::shared_ptr<Texture2D>                  worldTexture;
 			std::shared_ptr<Texture2D>                  normalTexture;
@@ -4,6 +4,7 @@
 #pragma once
 #include "Engine/Core.h"
 #include "FileSystem/IResource.h"
+#include <cereal/cereal.hpp>
 #include <functional>
 #include <glm/glm.hpp>
 #include <memory>
@@ -38,8 +39,8 @@ namespace maple
 		float     usingEmissiveMap  = 1.0f;
 		float     workflow          = PBR_WORKFLOW_SEPARATE_TEXTURES;
 
-		//padding in vulkan
-		float padding = 0.0f;
+		//padding in vulkan, DeferredColor.frag writes the streaming feedback of the material into this slot, 0 is none
+		float feedbackSlot = 0.0f;
 	};
 
 	struct MaterialAlbedoProperties
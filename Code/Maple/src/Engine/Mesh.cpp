@@ -9,16 +9,19 @@
 #include <ecs/World.h>
 
 #include "Application.h"
+#include "Loaders/ImportContext.h"
+#include "Loaders/MeshCache.h"
 #include "Mesh.h"
 #include "RHI/StorageBuffer.h"
 #include "Vertex.h"
 #define _USE_MATH_DEFINES
 #include "Math/BoundingBox.h"
+#include <atomic>
 #include <math.h>
 
 namespace maple
 {
-	static int32_t idGenerator = 0;
+	static std::atomic_int32_t idGenerator = 0;
 
 	Mesh::Mesh(const std::shared_ptr<VertexBuffer> &vertexBuffer, const std::shared_ptr<IndexBuffer> &indexBuffer) :
 	    vertexBuffer(vertexBuffer),
@@ -37,10 +40,10 @@ namespace maple
 		{
 			boundingBox->merge(vertex.pos);
 		}
-		vertexBuffer = VertexBuffer::create(vertices.data(), sizeof(Vertex) * vertices.size());
-		indexBuffer  = IndexBuffer::create(indices.data(), indices.size());
-		meshId       = idGenerator++;
-		subMeshIndex.emplace_back(indexBuffer->getCount());
+		createBuffers(indices.data(), indices.size(), vertices.data(), sizeof(Vertex));
+		meshId = idGenerator++;
+		subMeshIndex.emplace_back(indices.size());
+		MeshCache::record(this, vertices.data(), sizeof(Vertex), vertexCount, indices, false);
 	}
 
 	Mesh::Mesh(const std::vector<uint32_t> &indices, const std::vector<SkinnedVertex> &vertices)
@@ -51,10 +54,78 @@ namespace maple
 		{
 			boundingBox->merge(vertex.pos);
 		}
-		vertexBuffer = VertexBuffer::create(vertices.data(), sizeof(SkinnedVertex) * vertices.size());
-		indexBuffer  = IndexBuffer::create(indices.data(), indices.size());
-		meshId       = idGenerator++;
-		subMeshIndex.emplace_back(indexBuffer->getCount());
+		createBuffers(indices.data(), indices.size(), vertices.data(), sizeof(SkinnedVertex));
+		meshId = idGenerator++;
+		subMeshIndex.emplace_back(indices.size());
+		MeshCache::record(this, vertices.data(), sizeof(SkinnedVertex), vertexCount, indices, true);
+	}
+
+	Mesh::Mesh(const uint32_t *indices, uint32_t indexCount, const void *vertices, uint32_t vertexCount, uint32_t stride, const BoundingBox &boundingBox) :
+	    vertexCount(vertexCount)
+	{
+		this->boundingBox = std::make_shared<BoundingBox>(boundingBox);
+		createBuffers(indices, indexCount, vertices, stride);
+		meshId = idGenerator++;
+		subMeshIndex.emplace_back(indexCount);
+	}
+
+	auto Mesh::createBuffers(const uint32_t *indices, uint32_t indexCount, const void *vertices, uint32_t stride) -> void
+	{
+		const uint8_t *vertexData   = static_cast<const uint8_t *>(vertices);
+		const uint8_t *positionData = nullptr;
+		uint32_t       vertexSize   = vertexCount * stride;
+		uint32_t       positionSize = 0;
+
+		VertexCompression::Streams streams;
+		if (VertexCompression::isEnabled() && boundingBox != nullptr && boundingBox->isDefined())
+		{
+			if (stride == sizeof(SkinnedVertex))
+			{
+				streams      = VertexCompression::compress(static_cast<const SkinnedVertex *>(vertices), vertexCount, *boundingBox);
+				vertexLayout = VertexLayout::CompressedSkinned;
+			}
+			else
+			{
+				streams      = VertexCompression::compress(static_cast<const Vertex *>(vertices), vertexCount, *boundingBox);
+				vertexLayout = VertexLayout::Compressed;
+			}
+			quantization = streams.quantization;
+			vertexData   = streams.attributes.data();
+			vertexSize   = static_cast<uint32_t>(streams.attributes.size());
+			positionData = reinterpret_cast<const uint8_t *>(streams.positions.data());
+			positionSize = static_cast<uint32_t>(streams.positions.size() * sizeof(glm::u16vec4));
+		}
+
+		if (auto context = ImportContext::current())
+		{
+			//the import keeps the mesh alive until the flush, the data of the loader does not live that long
+			auto vertexCopy   = std::make_shared<std::vector<uint8_t>>(vertexData, vertexData + vertexSize);
+			auto positionCopy = std::make_shared<std::vector<uint8_t>>(positionData, positionData + positionSize);
+			auto indexData    = std::make_shared<std::vector<uint32_t>>(indices, indices + indexCount);
+			context->defer([this, vertexCopy, positionCopy, indexData]() {
+				vertexBuffer = VertexBuffer::create(vertexCopy->data(), vertexCopy->size());
+				indexBuffer  = IndexBuffer::create(indexData->data(), indexData->size());
+				if (!positionCopy->empty())
+					positionBuffer = VertexBuffer::create(positionCopy->data(), positionCopy->size());
+			});
+			return;
+		}
+		vertexBuffer = VertexBuffer::create(vertexData, vertexSize);
+		indexBuffer  = IndexBuffer::create(indices, indexCount);
+		if (positionSize != 0)
+			positionBuffer = VertexBuffer::create(positionData, positionSize);
+	}
+
+	auto Mesh::bindVertexStreams(const CommandBuffer *commandBuffer, Pipeline *pipeline, bool positionOnly) -> void
+	{
+		if (!isCompressed())
+		{
+			vertexBuffer->bind(commandBuffer, pipeline);
+			return;
+		}
+		positionBuffer->bind(commandBuffer, pipeline, 0);
+		if (!positionOnly)
+			vertexBuffer->bind(commandBuffer, pipeline, 1);
 	}
 
 	auto Mesh::setIndicies(uint32_t range) -> void
@@ -653,6 +724,7 @@ namespace maple
 
 	auto Mesh::getAccelerationStructure(BatchTask::Ptr task) -> AccelerationStructure::Ptr
 	{
+		MAPLE_ASSERT(!isCompressed(), "the acceleration structures are built from float positions, see ImportOptions::compressVertices");
 		if (bottomAs == nullptr)
 			bottomAs = AccelerationStructure::createBottomLevel(vertexBuffer, indexBuffer, vertexCount, task);
 		return bottomAs;
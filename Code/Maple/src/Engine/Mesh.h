@@ -5,6 +5,7 @@
 #pragma once
 #include "Engine/Core.h"
 #include "Engine/Vertex.h"
+#include "Engine/VertexCompression.h"
 #include "RHI/AccelerationStructure.h"
 #include "RHI/IndexBuffer.h"
 #include "RHI/Texture.h"
@@ -37,6 +38,8 @@ namespace maple
 		     const std::shared_ptr<IndexBuffer> & indexBuffer);
 		Mesh(const std::vector<uint32_t> &indices, const std::vector<Vertex> &vertices);
 		Mesh(const std::vector<uint32_t> &indices, const std::vector<SkinnedVertex> &vertices);
+		//streams of the mesh cache, the bounds are known
+		Mesh(const uint32_t *indices, uint32_t indexCount, const void *vertices, uint32_t vertexCount, uint32_t stride, const BoundingBox &boundingBox);
 
 		inline auto setMaterial(const std::shared_ptr<Material> &material)
 		{
@@ -86,6 +89,32 @@ namespace maple
 		{
 			return vertexBuffer;
 		}
+
+		//the quantized positions of a compressed mesh, the vertex buffer holds the other attributes then
+		inline auto &getPositionBuffer()
+		{
+			return positionBuffer;
+		}
+
+		inline auto isCompressed() const
+		{
+			return vertexLayout != VertexLayout::Reflected;
+		}
+
+		inline auto getVertexLayout() const
+		{
+			return vertexLayout;
+		}
+
+		//offset and scale of the quantized positions, pushed with the transform of a compressed mesh
+		inline auto &getQuantization() const
+		{
+			return quantization;
+		}
+
+		//the vertex buffer, or the streams of a compressed mesh at the bindings of BufferLayout::get.
+		//positionOnly leaves out the attribute stream for the VertexLayout::CompressedPosition pipelines
+		auto bindVertexStreams(const CommandBuffer *commandBuffer, Pipeline *pipeline, bool positionOnly = false) -> void;
 		inline auto &getMaterial()
 		{
 			return materials;
@@ -175,16 +204,23 @@ namespace maple
 		auto getAccelerationStructure(BatchTask::Ptr task) -> AccelerationStructure::Ptr;
 
 	  protected:
+		//deferred to the main thread when the mesh is created by an import on the job system.
+		//the vertices are compressed while a VertexCompression::Scope is alive on this thread
+		auto createBuffers(const uint32_t *indices, uint32_t indexCount, const void *vertices, uint32_t stride) -> void;
+
 		static auto generateTangent(const glm::vec3 &a, const glm::vec3 &b, const glm::vec3 &c, const glm::vec2 &ta, const glm::vec2 &tb, const glm::vec2 &tc) -> glm::vec3;
 		static auto generateBitTangent(const glm::vec3 &a, const glm::vec3 &b, const glm::vec3 &c, const glm::vec2 &ta, const glm::vec2 &tb, const glm::vec2 &tc) -> glm::vec3;
 
 		std::shared_ptr<IndexBuffer>           indexBuffer;
 		std::shared_ptr<VertexBuffer>          vertexBuffer;
+		std::shared_ptr<VertexBuffer>          positionBuffer;
 		std::shared_ptr<Texture>               texture;
 		std::shared_ptr<DescriptorSet>         descriptorSet;
 		std::vector<std::shared_ptr<Material>> materials;
 
-		std::shared_ptr<BoundingBox> boundingBox;
+		std::shared_ptr<BoundingBox>    boundingBox;
+		VertexLayout                    vertexLayout = VertexLayout::Reflected;
+		VertexCompression::Quantization quantization;
 
 		int32_t               meshId = 0;
 		uint32_t              size   = 0;
@@ -0,0 +1,326 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+#include "MeshOptimizer.h"
+#include "Engine/Profiler.h"
+#include "Others/Console.h"
+
+#include <algorithm>
+
+namespace maple
+{
+	namespace
+	{
+		constexpr uint32_t Invalid = ~0u;
+
+		//a vertex stays in the cache while less than CacheSize others are transformed after it
+		struct CacheModel
+		{
+			std::vector<uint32_t> timestamps;
+			uint32_t              time = MeshOptimizer::CacheSize + 1;
+
+			CacheModel(size_t vertexCount) :
+			    timestamps(vertexCount, 0)
+			{
+			}
+
+			inline auto getAge(uint32_t vertex) const
+			{
+				return time - timestamps[vertex];
+			}
+
+			//1 when the vertex had to be transformed
+			inline auto fetch(uint32_t vertex) -> uint32_t
+			{
+				if (getAge(vertex) <= MeshOptimizer::CacheSize)
+					return 0;
+				timestamps[vertex] = time++;
+				return 1;
+			}
+
+			inline auto fetch(const uint32_t *triangle)
+			{
+				return fetch(triangle[0]) + fetch(triangle[1]) + fetch(triangle[2]);
+			}
+
+			inline auto flush()
+			{
+				time += MeshOptimizer::CacheSize + 1;
+			}
+		};
+
+		template <typename T>
+		inline auto optimizeMesh(std::vector<uint32_t> &indices, std::vector<T> &vertices, const std::string &name) -> bool
+		{
+			PROFILE_FUNCTION();
+			const auto vertexCount = static_cast<uint32_t>(vertices.size());
+			if (indices.empty() || indices.size() % 3 != 0)
+				return false;
+			if (std::any_of(indices.begin(), indices.end(), [&](uint32_t index) { return index >= vertexCount; }))
+				return false;
+
+			const auto before = MeshOptimizer::analyzeVertexCache(indices, vertexCount);
+
+			MeshOptimizer::optimizeVertexCache(indices, vertexCount);
+
+			std::vector<glm::vec3> positions(vertexCount);
+			for (uint32_t i = 0; i < vertexCount; i++)
+				positions[i] = vertices[i].pos;
+			MeshOptimizer::optimizeOverdraw(indices, positions);
+
+			const auto remap   = MeshOptimizer::optimizeVertexFetch(indices, vertexCount);
+			const auto fetched = static_cast<uint32_t>(vertexCount - std::count(remap.begin(), remap.end(), Invalid));
+
+			std::vector<T> reordered(fetched);
+			for (uint32_t i = 0; i < vertexCount; i++)
+			{
+				if (remap[i] != Invalid)
+					reordered[remap[i]] = vertices[i];
+			}
+			vertices = std::move(reordered);
+
+			const auto after = MeshOptimizer::analyzeVertexCache(indices, fetched);
+			LOGI("MeshOptimizer : {0}, {1} triangles, ACMR {2:.3f} -> {3:.3f}, ATVR {4:.3f} -> {5:.3f}, {6} unused vertices dropped",
+			     name, indices.size() / 3, before.acmr, after.acmr, before.atvr, after.atvr, vertexCount - fetched);
+			return true;
+		}
+	}        // namespace
+
+	auto MeshOptimizer::optimize(std::vector<uint32_t> &indices, std::vector<Vertex> &vertices, const std::string &name) -> bool
+	{
+		return optimizeMesh(indices, vertices, name);
+	}
+
+	auto MeshOptimizer::optimize(std::vector<uint32_t> &indices, std::vector<SkinnedVertex> &vertices, const std::string &name) -> bool
+	{
+		return optimizeMesh(indices, vertices, name);
+	}
+
+	auto MeshOptimizer::analyzeVertexCache(const std::vector<uint32_t> &indices, uint32_t vertexCount) -> Statistics
+	{
+		CacheModel        cache(vertexCount);
+		std::vector<bool> referenced(vertexCount, false);
+		uint32_t          misses          = 0;
+		uint32_t          referencedCount = 0;
+		for (auto index : indices)
+		{
+			misses += cache.fetch(index);
+			if (!referenced[index])
+			{
+				referenced[index] = true;
+				referencedCount++;
+			}
+		}
+
+		Statistics statistics;
+		if (!indices.empty())
+		{
+			statistics.acmr = float(misses) / (indices.size() / 3);
+			statistics.atvr = float(misses) / referencedCount;
+		}
+		return statistics;
+	}
+
+	auto MeshOptimizer::optimizeVertexCache(std::vector<uint32_t> &indices, uint32_t vertexCount) -> void
+	{
+		PROFILE_FUNCTION();
+		const auto triangleCount = static_cast<uint32_t>(indices.size() / 3);
+
+		//triangles of every vertex, live is how many of them are not emitted yet
+		std::vector<uint32_t> live(vertexCount, 0);
+		for (auto index : indices)
+			live[index]++;
+
+		std::vector<uint32_t> offsets(vertexCount + 1, 0);
+		for (uint32_t i = 0; i < vertexCount; i++)
+			offsets[i + 1] = offsets[i] + live[i];
+
+		std::vector<uint32_t> adjacency(indices.size());
+		std::vector<uint32_t> fill(offsets.begin(), offsets.end() - 1);
+		for (uint32_t i = 0; i < indices.size(); i++)
+			adjacency[fill[indices[i]]++] = i / 3;
+
+		std::vector<bool>     emitted(triangleCount, false);
+		std::vector<uint32_t> deadEnd;
+		std::vector<uint32_t> candidates;
+		std::vector<uint32_t> output;
+		output.reserve(indices.size());
+
+		CacheModel cache(vertexCount);
+		uint32_t   cursor = 0;
+
+		//the vertices of the last fans first, in input order once they are used up
+		auto nextDeadEnd = [&]() -> uint32_t {
+			while (!deadEnd.empty())
+			{
+				const auto vertex = deadEnd.back();
+				deadEnd.pop_back();
+				if (live[vertex] > 0)
+					return vertex;
+			}
+			for (; cursor < vertexCount; cursor++)
+			{
+				if (live[cursor] > 0)
+					return cursor;
+			}
+			return Invalid;
+		};
+
+		auto fanning = nextDeadEnd();
+		while (fanning != Invalid)
+		{
+			candidates.clear();
+			for (auto i = offsets[fanning]; i < offsets[fanning + 1]; i++)
+			{
+				const auto triangle = adjacency[i];
+				if (emitted[triangle])
+					continue;
+				emitted[triangle] = true;
+				for (uint32_t j = 0; j < 3; j++)
+				{
+					const auto vertex = indices[triangle * 3 + j];
+					output.emplace_back(vertex);
+					deadEnd.emplace_back(vertex);
+					candidates.emplace_back(vertex);
+					live[vertex]--;
+					cache.fetch(vertex);
+				}
+			}
+
+			//the oldest candidate which is still in the cache once its own fan is emitted
+			auto    best         = Invalid;
+			int64_t bestPriority = -1;
+			for (auto vertex : candidates)
+			{
+				if (live[vertex] == 0)
+					continue;
+				int64_t priority = 0;
+				if (cache.getAge(vertex) + 2 * live[vertex] <= CacheSize)
+					priority = cache.getAge(vertex);
+				if (priority > bestPriority)
+				{
+					bestPriority = priority;
+					best         = vertex;
+				}
+			}
+			fanning = best != Invalid ? best : nextDeadEnd();
+		}
+		indices = std::move(output);
+	}
+
+	auto MeshOptimizer::optimizeOverdraw(std::vector<uint32_t> &indices, const std::vector<glm::vec3> &positions, float threshold) -> void
+	{
+		PROFILE_FUNCTION();
+		const auto triangleCount = static_cast<uint32_t>(indices.size() / 3);
+		if (triangleCount == 0)
+			return;
+
+		//a triangle missing the cache with all of its vertices starts a new patch of the mesh
+		CacheModel            cache(positions.size());
+		std::vector<uint32_t> patches;
+		for (uint32_t i = 0; i < triangleCount; i++)
+		{
+			if (cache.fetch(&indices[i * 3]) == 3 || i == 0)
+				patches.emplace_back(i);
+		}
+		patches.emplace_back(triangleCount);
+
+		//the patches are split further as long as the acmr of the pieces stays within the threshold of the patch
+		std::vector<uint32_t> clusters;
+		for (size_t i = 0; i + 1 < patches.size(); i++)
+		{
+			const auto begin = patches[i];
+			const auto end   = patches[i + 1];
+
+			cache.flush();
+			uint32_t misses = 0;
+			for (auto j = begin; j < end; j++)
+				misses += cache.fetch(&indices[j * 3]);
+			const float limit = threshold * misses / (end - begin);
+
+			cache.flush();
+			clusters.emplace_back(begin);
+			uint32_t clusterMisses = 0;
+			uint32_t clusterSize   = 0;
+			for (auto j = begin; j < end; j++)
+			{
+				clusterMisses += cache.fetch(&indices[j * 3]);
+				clusterSize++;
+				if (j + 1 < end && clusterMisses <= limit * clusterSize)
+				{
+					clusters.emplace_back(j + 1);
+					cache.flush();
+					clusterMisses = 0;
+					clusterSize   = 0;
+				}
+			}
+		}
+		clusters.emplace_back(triangleCount);
+
+		struct Cluster
+		{
+			uint32_t  begin;
+			uint32_t  end;
+			glm::vec3 centroid = glm::vec3(0.f);        //weighted by area
+			glm::vec3 normal   = glm::vec3(0.f);        //unnormalized, weighted by area as well
+			float     area     = 0.f;
+			float     key      = 0.f;
+		};
+
+		std::vector<Cluster> sorted;
+		sorted.reserve(clusters.size() - 1);
+		glm::vec3 meshCentroid(0.f);
+		float     meshArea = 0.f;
+		for (size_t i = 0; i + 1 < clusters.size(); i++)
+		{
+			auto &cluster = sorted.emplace_back(Cluster{clusters[i], clusters[i + 1]});
+			for (auto j = cluster.begin; j < cluster.end; j++)
+			{
+				const auto &p0     = positions[indices[j * 3 + 0]];
+				const auto &p1     = positions[indices[j * 3 + 1]];
+				const auto &p2     = positions[indices[j * 3 + 2]];
+				const auto  normal = glm::cross(p1 - p0, p2 - p0);
+				const auto  area   = glm::length(normal);
+				cluster.centroid += (p0 + p1 + p2) / 3.f * area;
+				cluster.normal += normal;
+				cluster.area += area;
+			}
+			meshCentroid += cluster.centroid;
+			meshArea += cluster.area;
+		}
+		if (meshArea <= 0.f)
+			return;
+		meshCentroid /= meshArea;
+
+		//the clusters facing away from the center are drawn first, they are the ones occluding the others
+		for (auto &cluster : sorted)
+		{
+			if (cluster.area <= 0.f)
+				continue;
+			const auto centroid = cluster.centroid / cluster.area;
+			const auto length   = glm::length(cluster.normal);
+			cluster.key         = length > 0.f ? glm::dot(centroid - meshCentroid, cluster.normal / length) : 0.f;
+		}
+		std::stable_sort(sorted.begin(), sorted.end(), [](const Cluster &a, const Cluster &b) { return a.key > b.key; });
+
+		std::vector<uint32_t> output;
+		output.reserve(indices.size());
+		for (auto &cluster : sorted)
+			output.insert(output.end(), indices.begin() + cluster.begin * 3, indices.begin() + cluster.end * 3);
+		indices = std::move(output);
+	}
+
+	auto MeshOptimizer::optimizeVertexFetch(std::vector<uint32_t> &indices, uint32_t vertexCount) -> std::vector<uint32_t>
+	{
+		PROFILE_FUNCTION();
+		std::vector<uint32_t> remap(vertexCount, Invalid);
+		uint32_t              next = 0;
+		for (auto &index : indices)
+		{
+			if (remap[index] == Invalid)
+				remap[index] = next++;
+			index = remap[index];
+		}
+		return remap;
+	}
+}        // namespace maple
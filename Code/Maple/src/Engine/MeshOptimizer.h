@@ -0,0 +1,48 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "Engine/Core.h"
+#include "Engine/Vertex.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace maple
+{
+	/**
+	 * Import time reordering of the indexed triangle lists the model loaders produce.
+	 * The triangles are put into an order which keeps their vertices in the post transform cache (Tipsify, Sander et al.),
+	 * the clusters of that order are sorted so that the ones facing outwards are drawn first to cut the overdraw, and
+	 * the vertices are stored in the order they are fetched with the unused ones dropped.
+	 * The loaders run it on the job system unless ImportOptions::optimizeMeshes is off, the mesh cache stores the reordered streams.
+	 */
+	class MAPLE_EXPORT MeshOptimizer final
+	{
+	  public:
+		//fifo post transform cache the optimizations and the statistics assume
+		static constexpr uint32_t CacheSize = 16;
+		//how much worse than the cache order a cluster may get, more and smaller clusters sort the overdraw better
+		static constexpr float OverdrawThreshold = 1.05f;
+
+		struct Statistics
+		{
+			float acmr = 0.f;        //transformed vertices per triangle, 3 at worst and about 0.5 at best
+			float atvr = 0.f;        //transformed vertices per referenced vertex, 1 at best
+		};
+
+		//reorders the triangles and the vertices in place and logs what the cache gains, false when it is no triangle list
+		static auto optimize(std::vector<uint32_t> &indices, std::vector<Vertex> &vertices, const std::string &name) -> bool;
+		static auto optimize(std::vector<uint32_t> &indices, std::vector<SkinnedVertex> &vertices, const std::string &name) -> bool;
+
+		static auto analyzeVertexCache(const std::vector<uint32_t> &indices, uint32_t vertexCount) -> Statistics;
+
+		static auto optimizeVertexCache(std::vector<uint32_t> &indices, uint32_t vertexCount) -> void;
+
+		//positions are indexed by the indices, which have to be in the cache order
+		static auto optimizeOverdraw(std::vector<uint32_t> &indices, const std::vector<glm::vec3> &positions, float threshold = OverdrawThreshold) -> void;
+
+		//new index of every vertex, ~0u for the unused ones. the indices are remapped
+		static auto optimizeVertexFetch(std::vector<uint32_t> &indices, uint32_t vertexCount) -> std::vector<uint32_t>;
+	};
+}        // namespace maple
@@ -46,6 +46,7 @@ namespace maple
 
 			DescriptorSet::Ptr writeDescriptorSet;        //Shadows Ray Trace Write
 			DescriptorSet::Ptr readDescriptorSet;         //Shadows Ray Trace Read
+			UniformHandle      light;                     //resolved once when the descriptor sets are created
 
 			bool firstFrame = false;
 
@@ -144,6 +145,7 @@ namespace maple
 			pipeline.shadowRaytraceShader = Shader::create("shaders/Shadow/ShadowRaytrace.shader");
 			pipeline.writeDescriptorSet   = DescriptorSet::create({0, pipeline.shadowRaytraceShader.get()});
 			pipeline.readDescriptorSet    = DescriptorSet::create({0, pipeline.shadowRaytraceShader.get()});
+			pipeline.light                = pipeline.writeDescriptorSet->getUniformHandle(UniformId("UniformBufferObject", "light"));
 		}
 	}        // namespace init
 
@@ -175,7 +177,7 @@ namespace maple
 					numLights++;
 				});
 			}
-			pipeline.writeDescriptorSet->setUniform("UniformBufferObject", "light", lights, sizeof(component::LightData), false);
+			pipeline.writeDescriptorSet->setUniform(pipeline.light, lights, sizeof(component::LightData), false);
 		}
 
 		inline auto render(Entity                                           entity,
@@ -260,8 +262,11 @@ namespace maple
 
 	namespace raytraced_shadow
 	{
-		auto registerRaytracedShadow(ExecuteQueue &update, ExecuteQueue &queue, std::shared_ptr<ExecutePoint> executePoint) -> void
+		auto registerRaytracedShadow(ExecuteQueue &update, ExecuteQueue &queue, std::shared_ptr<ExecutePoint> executePoint, frame_graph::FrameGraph::PassBuilder pass) -> void
 		{
+			//the shadow is accumulated over frames
+			pass.read(GBufferTextures::POSITION).read(GBufferTextures::NORMALS).sideEffect();
+
 			executePoint->onConstruct<raytraced_shadow::component::RaytracedShadow, init::initRaytracedShadow>();
 
 			executePoint->registerGlobalComponent<blue_noise::global::component::BlueNoise>([](auto &noise) {
@@ -2,6 +2,7 @@
 // This file is part of the Maple Engine                              		//
 //////////////////////////////////////////////////////////////////////////////
 #pragma once
+#include "Engine/Renderer/FrameGraph.h"
 #include "RHI/Texture.h"
 #include "RaytraceScale.h"
 #include "Scene/System/ExecutePoint.h"
@@ -19,6 +20,6 @@ namespace maple
 				uint32_t          height;
 			};
 		}        // namespace component
-		auto registerRaytracedShadow(ExecuteQueue &update, ExecuteQueue &queue, std::shared_ptr<ExecutePoint> executePoint) -> void;
+		auto registerRaytracedShadow(ExecuteQueue &update, ExecuteQueue &queue, std::shared_ptr<ExecutePoint> executePoint, frame_graph::FrameGraph::PassBuilder pass) -> void;
 	};        // namespace raytraced_shadow
 };            // namespace maple
@@ -121,8 +121,11 @@ namespace maple
 
 	namespace atmosphere_pass
 	{
-		auto registerAtmosphere(ExecuteQueue &begin, ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint) -> void
+		auto registerAtmosphere(ExecuteQueue &begin, ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint, frame_graph::FrameGraph::PassBuilder pass) -> void
 		{
+			//into the screen or the pseudo sky, see AtmosphereData::renderToScreen
+			pass.write(GBufferTextures::SCREEN).write(GBufferTextures::PSEUDO_SKY);
+
 			executePoint->registerGlobalComponent<component::AtmosphereData>();
 
 			executePoint->registerWithinQueue<begin_scene::system>(begin);
@@ -2,6 +2,7 @@
 // This file is part of the Maple Engine                              		//
 //////////////////////////////////////////////////////////////////////////////
 #pragma once
+#include "FrameGraph.h"
 #include "Renderer.h"
 #include "Scene/System/ExecutePoint.h"
 
@@ -9,6 +10,6 @@ namespace maple
 {
 	namespace atmosphere_pass
 	{
-		auto registerAtmosphere(ExecuteQueue &begin, ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint) -> void;
+		auto registerAtmosphere(ExecuteQueue &begin, ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint, frame_graph::FrameGraph::PassBuilder pass) -> void;
 	}
 }        // namespace maple
@@ -3,6 +3,7 @@
 //////////////////////////////////////////////////////////////////////////////
 
 #include "CloudRenderer.h"
+#include "RHI/GPUProfile.h"
 #include "RHI/Pipeline.h"
 #include "RHI/Shader.h"
 #include "RHI/Texture.h"
@@ -283,12 +284,16 @@ namespace maple
 				auto groupCountX = static_cast<uint32_t>(glm::ceil(render.gbuffer->getWidth() / (float) data.cloudShader->getLocalSizeX()));
 				auto groupCountY = static_cast<uint32_t>(glm::ceil(render.gbuffer->getHeight() / (float) data.cloudShader->getLocalSizeY()));
 				data.uniformObject.frames++;
+
+				//the clouds are composed by the next frame, so they are traced on the async compute queue
+				auto cmd = render.computeCommandBuffer;
+				GPUProfile("Compute Cloud", cmd);
 				data.descriptorSet->setUniformBufferData("UniformBufferObject", &data.uniformObject);
-				data.descriptorSet->update(render.commandBuffer);
-				data.pipeline->bind(render.commandBuffer);
-				Renderer::bindDescriptorSets(data.pipeline.get(), render.commandBuffer, 0, {data.descriptorSet});
-				Renderer::dispatch(render.commandBuffer, groupCountX, groupCountY, 1);
-				data.pipeline->end(render.commandBuffer);
+				data.descriptorSet->update(cmd);
+				data.pipeline->bind(cmd);
+				Renderer::bindDescriptorSets(data.pipeline.get(), cmd, 0, {data.descriptorSet});
+				Renderer::dispatch(cmd, groupCountX, groupCountY, 1);
+				data.pipeline->end(cmd);
 			}
 		}
 	}        // namespace compute_cloud
@@ -329,8 +334,11 @@ namespace maple
 
 	namespace cloud_renderer
 	{
-		auto registerCloudRenderer(ExecuteQueue &begin, ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint) -> void
+		auto registerCloudRenderer(ExecuteQueue &begin, ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint, frame_graph::FrameGraph::PassBuilder pass) -> void
 		{
+			//composes the clouds traced by the last frame
+			pass.write(GBufferTextures::SCREEN);
+
 			executePoint->registerGlobalComponent<Timer>();
 			executePoint->registerGlobalComponent<component::CloudRenderData>();
 			executePoint->registerGlobalComponent<component::WeatherPass>();
@@ -339,8 +347,10 @@ namespace maple
 			executePoint->registerWithinQueue<on_render::system>(renderer);
 		}
 
-		auto registerComputeCloud(ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint) -> void
+		auto registerComputeCloud(ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint, frame_graph::FrameGraph::PassBuilder pass) -> void
 		{
+			//the traced clouds are read by the next frame
+			pass.read(GBufferTextures::PSEUDO_SKY).sideEffect();
 			executePoint->registerWithinQueue<compute_cloud::system>(renderer);
 		}
 	}        // namespace cloud_renderer
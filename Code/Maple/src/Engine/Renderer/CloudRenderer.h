@@ -2,6 +2,7 @@
 // This file is part of the Maple Engine                              		//
 //////////////////////////////////////////////////////////////////////////////
 #pragma once
+#include "FrameGraph.h"
 #include "Renderer.h"
 #include "Scene/System/ExecutePoint.h"
 
@@ -9,7 +10,7 @@ namespace maple
 {
 	namespace cloud_renderer
 	{
-		auto registerCloudRenderer(ExecuteQueue &begin, ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint) -> void;
-		auto registerComputeCloud(ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint) -> void;
+		auto registerCloudRenderer(ExecuteQueue &begin, ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint, frame_graph::FrameGraph::PassBuilder pass) -> void;
+		auto registerComputeCloud(ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint, frame_graph::FrameGraph::PassBuilder pass) -> void;
 	}        // namespace cloud_renderer
 }        // namespace maple
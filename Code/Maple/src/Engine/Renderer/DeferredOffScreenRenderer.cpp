@@ -8,6 +8,7 @@
 #include "RHI/GPUProfile.h"
 #include "RHI/Pipeline.h"
 #include "RHI/Shader.h"
+#include "RHI/SwapChain.h"
 #include "RHI/Texture.h"
 
 #include "Engine/Camera.h"
@@ -17,15 +18,18 @@
 #include "Engine/PathTracer/PathIntegrator.h"
 #include "Engine/Profiler.h"
 
+#include "Scene/Component/BoundingBox.h"
 #include "Scene/Component/Component.h"
 #include "Scene/Component/Environment.h"
 #include "Scene/Component/Light.h"
 #include "Scene/Component/MeshRenderer.h"
 #include "Scene/Component/Transform.h"
 #include "Scene/Scene.h"
+#include "Scene/System/SceneBVHModule.h"
 
 #include "FileSystem/Skeleton.h"
 
+#include "GPUCulling.h"
 #include "PostProcessRenderer.h"
 #include "ShadowRenderer.h"
 
@@ -38,8 +42,10 @@
 #include "ImGui/ImGuiHelpers.h"
 #include "Others/Randomizer.h"
 #include "RendererData.h"
+#include <algorithm>
 #include <ecs/ecs.h>
 #include <glm/gtc/type_ptr.hpp>
+#include <mutex>
 
 namespace maple
 {
@@ -50,6 +56,9 @@ namespace maple
 			deferredColorShader     = Shader::create("shaders/DeferredColor.shader");
 			deferredColorAnimShader = Shader::create("shaders/DeferredColorAnim.shader");
 
+			deferredColorCompressedShader     = Shader::create("shaders/DeferredColorCompressed.shader");
+			deferredColorAnimCompressedShader = Shader::create("shaders/DeferredColorAnimCompressed.shader");
+
 			deferredLightShader = Shader::create("shaders/DeferredLight.shader");
 			stencilShader       = Shader::create("shaders/Outline.shader");
 			commandQueue.reserve(1000);
@@ -79,6 +88,10 @@ namespace maple
 			info.layoutIndex      = 2;
 			descriptorColorSet[2] = DescriptorSet::create(info);
 
+			descriptorIndirectSet.resize(3);
+			descriptorIndirectSet[0] = DescriptorSet::create({0, deferredColorShader.get()});
+			descriptorIndirectSet[2] = descriptorColorSet[2];
+
 			info.shader           = deferredLightShader.get();
 			info.layoutIndex      = 0;
 			descriptorLightSet[0] = DescriptorSet::create(info);
@@ -93,11 +106,54 @@ namespace maple
 			    {TextureFormat::RG16F, TextureFilter::Linear, TextureFilter::Linear, TextureWrap::ClampToEdge});
 
 			stencilDescriptorSet = DescriptorSet::create({0, stencilShader.get()});
+
+			auto resolveColor = [](const std::vector<std::shared_ptr<DescriptorSet>> &sets, ColorUniforms &uniforms) {
+				uniforms.projView    = sets[0]->getUniformHandle(UniformId("UniformBufferObject", "projView"));
+				uniforms.view        = sets[0]->getUniformHandle(UniformId("UniformBufferObject", "view"));
+				uniforms.projViewOld = sets[0]->getUniformHandle(UniformId("UniformBufferObject", "projViewOld"));
+				uniforms.depthView   = sets[2]->getUniformHandle(UniformId("UBO", "view"));
+				uniforms.nearPlane   = sets[2]->getUniformHandle(UniformId("UBO", "nearPlane"));
+				uniforms.farPlane    = sets[2]->getUniformHandle(UniformId("UBO", "farPlane"));
+			};
+			resolveColor(descriptorColorSet, colorUniforms);
+			resolveColor(descriptorAnimSet, animUniforms);
+			boneTransforms  = descriptorAnimSet[0]->getUniformHandle(UniformId("UniformBufferObject", "boneTransforms"));
+			stencilProjView = stencilDescriptorSet->getUniformHandle(UniformId("UniformBufferObject", "projView"));
+
+			auto &lightSet = *descriptorLightSet[0];
+			lightUniforms.lights           = lightSet.getUniformHandle(UniformId("UniformBufferLight", "lights"));
+			lightUniforms.shadowTransform  = lightSet.getUniformHandle(UniformId("UniformBufferLight", "shadowTransform"));
+			lightUniforms.viewMatrix       = lightSet.getUniformHandle(UniformId("UniformBufferLight", "viewMatrix"));
+			lightUniforms.lightView        = lightSet.getUniformHandle(UniformId("UniformBufferLight", "lightView"));
+			lightUniforms.biasMat          = lightSet.getUniformHandle(UniformId("UniformBufferLight", "biasMat"));
+			lightUniforms.cameraPosition   = lightSet.getUniformHandle(UniformId("UniformBufferLight", "cameraPosition"));
+			lightUniforms.splitDepths      = lightSet.getUniformHandle(UniformId("UniformBufferLight", "splitDepths"));
+			lightUniforms.shadowMapSize    = lightSet.getUniformHandle(UniformId("UniformBufferLight", "shadowMapSize"));
+			lightUniforms.initialBias      = lightSet.getUniformHandle(UniformId("UniformBufferLight", "initialBias"));
+			lightUniforms.lightCount       = lightSet.getUniformHandle(UniformId("UniformBufferLight", "lightCount"));
+			lightUniforms.shadowCount      = lightSet.getUniformHandle(UniformId("UniformBufferLight", "shadowCount"));
+			lightUniforms.mode             = lightSet.getUniformHandle(UniformId("UniformBufferLight", "mode"));
+			lightUniforms.shadowMethod     = lightSet.getUniformHandle(UniformId("UniformBufferLight", "shadowMethod"));
+			lightUniforms.enableLPV        = lightSet.getUniformHandle(UniformId("UniformBufferLight", "enableLPV"));
+			lightUniforms.enableShadow     = lightSet.getUniformHandle(UniformId("UniformBufferLight", "enableShadow"));
+			lightUniforms.cubeMapMipLevels = lightSet.getUniformHandle(UniformId("UniformBufferLight", "cubeMapMipLevels"));
+			lightUniforms.ssaoEnable       = lightSet.getUniformHandle(UniformId("UniformBufferLight", "ssaoEnable"));
 		}
 	}        // namespace component
 
 	namespace deferred_offscreen
 	{
+		//same as MAX_LIGHTS in DeferredLight.frag
+		constexpr uint32_t MaxLights = 32;
+
+		//DeferredLight.frag attenuates with radius / (dist^2 + 1), the range ends where the contribution drops below 1/256
+		inline auto getLightRange(const component::LightData &light)
+		{
+			const float intensity = std::pow(light.intensity, 1.4f) + 0.1f;
+			const float energy    = intensity * light.radius * glm::max(glm::max(light.color.r, light.color.g), light.color.b);
+			return std::sqrt(glm::max(energy * 256.f - 1.f, 0.f));
+		}
+
 		using Entity = ecs::Registry ::Modify<component::DeferredData>::Fetch<component::ShadowMapData>::Fetch<component::CameraView>::Fetch<component::RendererData>::Fetch<component::SSAOData>::OptinalFetch<component::LPVGrid>::OptinalFetch<vxgi::component::Voxelization>::To<ecs::Entity>;
 
 		using LightDefine = ecs::Registry ::Modify<component::Light>::Fetch<component::Transform>;
@@ -116,6 +172,43 @@ namespace maple
 
 		using PathTraceGroup = ecs::Registry::Fetch<component::PathIntegrator>::To<ecs::Group>;
 
+		//world matrix of the entity in the last frame, entities which were not drawn in the last frame have no motion
+		inline auto getPrevTransform(component::DeferredData &data, entt::entity entity, const glm::mat4 &transform) -> glm::mat4
+		{
+			const auto id = static_cast<size_t>(entt::to_integral(entity) & entt::entt_traits<entt::entity>::entity_mask);
+			if (id >= data.prevTransforms.size())
+			{
+				data.prevTransforms.resize(id + 1);
+				data.prevFrames.resize(id + 1, 0);
+			}
+
+			const auto prevTransform = data.prevFrames[id] != 0 && data.prevFrames[id] + 1 == data.frame ? data.prevTransforms[id] : transform;
+			data.prevTransforms[id]  = transform;
+			data.prevFrames[id]      = data.frame;
+			return prevTransform;
+		}
+
+		//pixels the bounding sphere of the mesh covers vertically, the TextureStreamer picks the mips from it until there is feedback
+		inline auto getProjectedSize(const component::CameraView &cameraView, const BoundingBox *box, const glm::mat4 &transform, float screenHeight)
+		{
+			if (box == nullptr || !box->isDefined())
+				return 0.f;
+
+			const auto scale     = std::max({glm::length(glm::vec3(transform[0])), glm::length(glm::vec3(transform[1])), glm::length(glm::vec3(transform[2]))});
+			const auto radius    = glm::length(box->size()) * 0.5f * scale;
+			const auto center    = cameraView.view * transform * glm::vec4(box->center(), 1.f);
+			const auto viewDepth = std::max(-center.z - radius, cameraView.nearPlane);
+			return radius * std::abs(cameraView.proj[1][1]) / viewDepth * screenHeight;
+		}
+
+		//the shader reading the vertex streams of the mesh
+		inline auto getColorShader(const component::DeferredData &data, const Mesh *mesh, bool skinned) -> const std::shared_ptr<Shader> &
+		{
+			if (mesh->isCompressed())
+				return skinned ? data.deferredColorAnimCompressedShader : data.deferredColorCompressedShader;
+			return skinned ? data.deferredColorAnimShader : data.deferredColorShader;
+		}
+
 		inline auto beginScene(Entity           entity,
 		                       Group            lightQuery,
 		                       EnvQuery         env,
@@ -123,10 +216,16 @@ namespace maple
 		                       SkinnedMeshQuery skinnedMeshQuery,
 		                       BoneMeshQuery    boneQuery,
 		                       PathTraceGroup   pathGroup,
+		                       const component::GPUCullingData &gpuCulling,
 		                       ecs::World       world)
 		{
 			auto [data, shadowData, cameraView, renderData, ssao] = entity;
 			data.commandQueue.clear();
+			data.sortedQueue.clear();
+			data.instanceGroups.clear();
+			data.instances.clear();
+			data.indirectDraws.clear();
+			data.frame++;
 			auto descriptorSet = data.descriptorColorSet[0];
 
 			if (cameraView.cameraTransform == nullptr)
@@ -139,29 +238,44 @@ namespace maple
 					return;
 			}
 
-			data.stencilDescriptorSet->setUniform("UniformBufferObject", "projView", &cameraView.projView);
+			data.stencilDescriptorSet->setUniform(data.stencilProjView, &cameraView.projView);
+
+			data.descriptorColorSet[0]->setUniform(data.colorUniforms.projView, &cameraView.projView);
+			data.descriptorColorSet[0]->setUniform(data.colorUniforms.view, &cameraView.view);
+			data.descriptorColorSet[0]->setUniform(data.colorUniforms.projViewOld, &cameraView.projViewOld);
 
-			data.descriptorColorSet[0]->setUniform("UniformBufferObject", "projView", &cameraView.projView);
-			data.descriptorColorSet[0]->setUniform("UniformBufferObject", "view", &cameraView.view);
-			data.descriptorColorSet[0]->setUniform("UniformBufferObject", "projViewOld", &cameraView.projViewOld);
+			data.descriptorIndirectSet[0]->setUniform(data.colorUniforms.projView, &cameraView.projView);
+			data.descriptorIndirectSet[0]->setUniform(data.colorUniforms.view, &cameraView.view);
+			data.descriptorIndirectSet[0]->setUniform(data.colorUniforms.projViewOld, &cameraView.projViewOld);
 
-			data.descriptorColorSet[2]->setUniform("UBO", "view", &cameraView.view);
-			data.descriptorColorSet[2]->setUniform("UBO", "nearPlane", &cameraView.nearPlane);
-			data.descriptorColorSet[2]->setUniform("UBO", "farPlane", &cameraView.farPlane);
+			data.descriptorColorSet[2]->setUniform(data.colorUniforms.depthView, &cameraView.view);
+			data.descriptorColorSet[2]->setUniform(data.colorUniforms.nearPlane, &cameraView.nearPlane);
+			data.descriptorColorSet[2]->setUniform(data.colorUniforms.farPlane, &cameraView.farPlane);
 
-			data.descriptorAnimSet[0]->setUniform("UniformBufferObject", "projView", &cameraView.projView);
-			data.descriptorAnimSet[0]->setUniform("UniformBufferObject", "view", &cameraView.view);
-			data.descriptorAnimSet[0]->setUniform("UniformBufferObject", "projViewOld", &cameraView.projViewOld);
+			data.descriptorAnimSet[0]->setUniform(data.animUniforms.projView, &cameraView.projView);
+			data.descriptorAnimSet[0]->setUniform(data.animUniforms.view, &cameraView.view);
+			data.descriptorAnimSet[0]->setUniform(data.animUniforms.projViewOld, &cameraView.projViewOld);
 
-			data.descriptorAnimSet[2]->setUniform("UBO", "view", &cameraView.view);
-			data.descriptorAnimSet[2]->setUniform("UBO", "nearPlane", &cameraView.nearPlane);
-			data.descriptorAnimSet[2]->setUniform("UBO", "farPlane", &cameraView.farPlane);
+			data.descriptorAnimSet[2]->setUniform(data.animUniforms.depthView, &cameraView.view);
+			data.descriptorAnimSet[2]->setUniform(data.animUniforms.nearPlane, &cameraView.nearPlane);
+			data.descriptorAnimSet[2]->setUniform(data.animUniforms.farPlane, &cameraView.farPlane);
+
+			auto      &streamer  = Application::getTextureStreamer();
+			const auto swapChain = Application::getGraphicsContext()->getSwapChain();
+			const auto feedback  = streamer->beginFrame(swapChain->getCurrentBufferIndex(), static_cast<uint32_t>(swapChain->getSwapChainBufferCount()));
+			data.descriptorColorSet[2]->setStorageBuffer("StreamingFeedback", feedback);
+			data.descriptorAnimSet[2]->setStorageBuffer("StreamingFeedback", feedback);
 
 			data.defaultMaterial->bind(renderData.commandBuffer);
 
+			data.pipelineIds.clear();
+			data.materialIds.clear();
+			data.meshIds.clear();
+			data.materialIds.insert(data.defaultMaterial.get());
+
 			component::Light *directionaLight = nullptr;
 
-			component::LightData lights[32] = {};
+			component::LightData lights[MaxLights] = {};
 			uint32_t             numLights  = 0;
 
 			{
@@ -172,9 +286,18 @@ namespace maple
 					light.lightData.position  = {transform.getWorldPosition(), 1.f};
 					light.lightData.direction = {glm::normalize(transform.getWorldOrientation() * maple::FORWARD), 1.f};
 
-					if (static_cast<component::LightType>(light.lightData.type) == component::LightType::DirectionalLight)
+					const auto type = static_cast<component::LightType>(light.lightData.type);
+					if (type == component::LightType::DirectionalLight)
 						directionaLight = &light;
 
+					//skip the local lights whose volume does not touch the view
+					if ((type == component::LightType::PointLight || type == component::LightType::SpotLight) &&
+					    !cameraView.frustum.isInside(transform.getWorldPosition(), getLightRange(light.lightData)))
+						return;
+
+					if (numLights >= MaxLights)
+						return;
+
 					lights[numLights] = light.lightData;
 					numLights++;
 				});
@@ -193,25 +316,25 @@ namespace maple
 			int32_t renderMode = 0;
 			auto    cameraPos  = glm::vec4{cameraView.cameraTransform->getWorldPosition(), 1.f};
 
-			data.descriptorLightSet[0]->setUniform("UniformBufferLight", "lights", lights, sizeof(component::LightData) * numLights, false);
-			data.descriptorLightSet[0]->setUniform("UniformBufferLight", "shadowTransform", shadowTransforms);
-			data.descriptorLightSet[0]->setUniform("UniformBufferLight", "viewMatrix", &cameraView.view);
-			data.descriptorLightSet[0]->setUniform("UniformBufferLight", "lightView", &lightView);
-			data.descriptorLightSet[0]->setUniform("UniformBufferLight", "biasMat", &BIAS_MATRIX);
-			data.descriptorLightSet[0]->setUniform("UniformBufferLight", "cameraPosition", &cameraPos);
-			data.descriptorLightSet[0]->setUniform("UniformBufferLight", "splitDepths", splitDepth);
-			data.descriptorLightSet[0]->setUniform("UniformBufferLight", "shadowMapSize", &shadowData.shadowMapSize);
-			data.descriptorLightSet[0]->setUniform("UniformBufferLight", "initialBias", &shadowData.initialBias);
-			data.descriptorLightSet[0]->setUniform("UniformBufferLight", "lightCount", &numLights);
-			data.descriptorLightSet[0]->setUniform("UniformBufferLight", "shadowCount", &numShadows);
-			data.descriptorLightSet[0]->setUniform("UniformBufferLight", "mode", &renderMode);
-			data.descriptorLightSet[0]->setUniform("UniformBufferLight", "shadowMethod", &shadowData.shadowMethod);
-			data.descriptorLightSet[0]->setUniform("UniformBufferLight", "enableLPV", &lpvEnable);
+			data.descriptorLightSet[0]->setUniform(data.lightUniforms.lights, lights, sizeof(component::LightData) * numLights, false);
+			data.descriptorLightSet[0]->setUniform(data.lightUniforms.shadowTransform, shadowTransforms);
+			data.descriptorLightSet[0]->setUniform(data.lightUniforms.viewMatrix, &cameraView.view);
+			data.descriptorLightSet[0]->setUniform(data.lightUniforms.lightView, &lightView);
+			data.descriptorLightSet[0]->setUniform(data.lightUniforms.biasMat, &BIAS_MATRIX);
+			data.descriptorLightSet[0]->setUniform(data.lightUniforms.cameraPosition, &cameraPos);
+			data.descriptorLightSet[0]->setUniform(data.lightUniforms.splitDepths, splitDepth);
+			data.descriptorLightSet[0]->setUniform(data.lightUniforms.shadowMapSize, &shadowData.shadowMapSize);
+			data.descriptorLightSet[0]->setUniform(data.lightUniforms.initialBias, &shadowData.initialBias);
+			data.descriptorLightSet[0]->setUniform(data.lightUniforms.lightCount, &numLights);
+			data.descriptorLightSet[0]->setUniform(data.lightUniforms.shadowCount, &numShadows);
+			data.descriptorLightSet[0]->setUniform(data.lightUniforms.mode, &renderMode);
+			data.descriptorLightSet[0]->setUniform(data.lightUniforms.shadowMethod, &shadowData.shadowMethod);
+			data.descriptorLightSet[0]->setUniform(data.lightUniforms.enableLPV, &lpvEnable);
 
 			if (directionaLight != nullptr)
 			{
 				int32_t enableShadow = directionaLight->castShadow ? 1 : 0;
-				data.descriptorLightSet[0]->setUniform("UniformBufferLight", "enableShadow", &enableShadow);
+				data.descriptorLightSet[0]->setUniform(data.lightUniforms.enableShadow, &enableShadow);
 			}
 
 			data.descriptorLightSet[0]->setTexture("uPreintegratedFG", data.preintegratedFG);
@@ -225,7 +348,7 @@ namespace maple
 				if (evnData.prefilteredEnvironment != nullptr)
 				{
 					int32_t cubeMapMipLevels = evnData.prefilteredEnvironment->getMipMapLevels() - 1;
-					data.descriptorLightSet[0]->setUniform("UniformBufferLight", "cubeMapMipLevels", &cubeMapMipLevels);
+					data.descriptorLightSet[0]->setUniform(data.lightUniforms.cubeMapMipLevels, &cubeMapMipLevels);
 				}
 			}
 			else
@@ -235,7 +358,7 @@ namespace maple
 			}
 
 			int32_t ssaoEnable = ssao.enable ? 1 : 0;
-			data.descriptorLightSet[0]->setUniform("UniformBufferLight", "ssaoEnable", &ssaoEnable);
+			data.descriptorLightSet[0]->setUniform(data.lightUniforms.ssaoEnable, &ssaoEnable);
 
 			PipelineInfo pipelineInfo{};
 			pipelineInfo.shader          = data.deferredColorShader;
@@ -244,156 +367,372 @@ namespace maple
 			pipelineInfo.clearTargets    = false;
 			pipelineInfo.swapChainTarget = false;
 			pipelineInfo.pipelineName    = "DeferredOffscreen";
+			pipelineInfo.colorTargets[0] = renderData.gbuffer->getBuffer(GBufferTextures::COLOR);
+			pipelineInfo.colorTargets[1] = renderData.gbuffer->getBuffer(GBufferTextures::POSITION);
+			pipelineInfo.colorTargets[2] = renderData.gbuffer->getBuffer(GBufferTextures::NORMALS);
+			pipelineInfo.colorTargets[3] = renderData.gbuffer->getBuffer(GBufferTextures::PBR);
+			pipelineInfo.colorTargets[4] = renderData.gbuffer->getBuffer(GBufferTextures::VIEW_POSITION);
+			pipelineInfo.colorTargets[5] = renderData.gbuffer->getBuffer(GBufferTextures::VIEW_NORMALS);
+			pipelineInfo.colorTargets[6] = renderData.gbuffer->getBuffer(GBufferTextures::VELOCITY);
+
+			//the meshes culled on the GPU only resolve their pipeline here, their draws are written by the culling pass
+			if (gpuCulling.enable)
+			{
+				for (uint32_t batch = 0; batch < gpuCulling.meshes.size(); batch++)
+				{
+					auto mesh     = gpuCulling.meshes[batch];
+					auto material = data.defaultMaterial.get();
+					for (auto &subMaterial : mesh->getMaterial())
+					{
+						material = subMaterial.get();
+						material->setShader(data.deferredColorShader);
+						if (data.materialIds.insert(material).second)
+						{
+							//no projected size per instance here, the feedback decides
+							streamer->request(material, 0.f);
+							material->bind(renderData.commandBuffer);
+						}
+					}
+
+					auto info     = pipelineInfo;
+					info.cullMode = material->isFlagOf(Material::RenderFlags::TwoSided) ? CullMode::None : CullMode::Back;
+					if (data.depthTest && material->isFlagOf(Material::RenderFlags::DepthTest))
+						info.depthTarget = renderData.gbuffer->getDepthBuffer();
+
+					auto fallback     = info;
+					fallback.cullMode = CullMode::Back;
+					if (auto pipeline = Pipeline::request(info, &fallback))
+						data.indirectDraws.push_back({pipeline.get(), batch});
+				}
+
+				std::sort(data.indirectDraws.begin(), data.indirectDraws.end(), [](const auto &left, const auto &right) {
+					return left.pipeline < right.pipeline;
+				});
+			}
 
 			std::unordered_map<entt::entity, std::shared_ptr<glm::mat4[]>> boneTransform;
 
-			auto forEachMesh = [&](const glm::mat4 &worldTransform, std::shared_ptr<Mesh> mesh, bool hasStencil, component::SkinnedMeshRenderer *skinnedMesh, maple::Entity parent) {
+			auto forEachMesh = [&](entt::entity entity, const glm::mat4 &worldTransform, std::shared_ptr<Mesh> mesh, bool hasStencil, component::SkinnedMeshRenderer *skinnedMesh, maple::Entity parent) {
 				if (!mesh->isActive())
 					return;
-				//culling
-				auto bb = mesh->getBoundingBox()->transform(worldTransform);
 
-				auto inside = cameraView.frustum.isInside(bb);
+				//visibility has been resolved by the culling batch
+				auto &cmd         = data.commandQueue.emplace_back();
+				cmd.mesh          = mesh.get();
+				cmd.transform     = worldTransform;
+				cmd.prevTransform = getPrevTransform(data, entity, worldTransform);
 
-				if (inside)
+				if (skinnedMesh)
 				{
-					auto &cmd     = data.commandQueue.emplace_back();
-					cmd.mesh      = mesh.get();
-					cmd.transform = worldTransform;
-
-					if (skinnedMesh)
+					if (boneTransform[parent.getHandle()] != nullptr)        //same parent
 					{
-						if (boneTransform[parent.getHandle()] != nullptr)        //same parent
-						{
-							cmd.boneTransforms = boneTransform[parent.getHandle()];
-						}
-						else
-						{
-							auto ptr = std::shared_ptr<glm::mat4[]>(new glm::mat4[100]);
+						cmd.boneTransforms = boneTransform[parent.getHandle()];
+					}
+					else
+					{
+						auto ptr = std::shared_ptr<glm::mat4[]>(new glm::mat4[100]);
 
-							for (auto boneEntity : boneQuery)
+						for (auto boneEntity : boneQuery)
+						{
+							auto ent           = boneQuery.convert(boneEntity);
+							auto [bone, trans] = ent;
+							auto mapleEntity   = ent.castTo<maple::Entity>();
+							if (mapleEntity.isParent(parent))
 							{
-								auto ent           = boneQuery.convert(boneEntity);
-								auto [bone, trans] = ent;
-								auto mapleEntity   = ent.castTo<maple::Entity>();
-								if (mapleEntity.isParent(parent))
-								{
-									ptr[bone.boneIndex] = trans.getWorldMatrix() * trans.getOffsetMatrix();
-								}
+								ptr[bone.boneIndex] = trans.getWorldMatrix() * trans.getOffsetMatrix();
 							}
-
-							cmd.boneTransforms                = ptr;
-							boneTransform[parent.getHandle()] = ptr;
 						}
-						skinnedMesh->boneTransforms = cmd.boneTransforms;
+
+						cmd.boneTransforms                = ptr;
+						boneTransform[parent.getHandle()] = ptr;
 					}
+					skinnedMesh->boneTransforms = cmd.boneTransforms;
+				}
 
-					cmd.material = data.defaultMaterial.get();
+				cmd.material = data.defaultMaterial.get();
 
-					for (auto material : mesh->getMaterial())
-					{
-						cmd.material = material.get();
-					}
+				for (auto material : mesh->getMaterial())
+				{
+					cmd.material = material.get();
+				}
 
-					cmd.material->setShader(skinnedMesh != nullptr ? data.deferredColorAnimShader : data.deferredColorShader);
-					cmd.material->bind(renderData.commandBuffer);
+				const auto &shader = getColorShader(data, mesh.get(), skinnedMesh != nullptr);
+				cmd.material->setShader(shader);
 
-					auto depthTest = data.depthTest;
+				streamer->request(cmd.material, getProjectedSize(cameraView, mesh->getBoundingBox().get(), worldTransform, static_cast<float>(renderData.gbuffer->getHeight())));
 
-					pipelineInfo.shader = skinnedMesh != nullptr ? data.deferredColorAnimShader : data.deferredColorShader;
+				//a material shared by many meshes is bound once per frame
+				const auto [materialId, firstUse] = data.materialIds.insert(cmd.material);
+				if (firstUse)
+					cmd.material->bind(renderData.commandBuffer);
 
-					pipelineInfo.colorTargets[0] = renderData.gbuffer->getBuffer(GBufferTextures::COLOR);
-					pipelineInfo.colorTargets[1] = renderData.gbuffer->getBuffer(GBufferTextures::POSITION);
-					pipelineInfo.colorTargets[2] = renderData.gbuffer->getBuffer(GBufferTextures::NORMALS);
-					pipelineInfo.colorTargets[3] = renderData.gbuffer->getBuffer(GBufferTextures::PBR);
-					pipelineInfo.colorTargets[4] = renderData.gbuffer->getBuffer(GBufferTextures::VIEW_POSITION);
-					pipelineInfo.colorTargets[5] = renderData.gbuffer->getBuffer(GBufferTextures::VIEW_NORMALS);
-					pipelineInfo.colorTargets[6] = renderData.gbuffer->getBuffer(GBufferTextures::VELOCITY);
+				auto depthTest = data.depthTest;
 
-					if (cmd.material != nullptr)
-					{
-						pipelineInfo.cullMode            = cmd.material->isFlagOf(Material::RenderFlags::TwoSided) ? CullMode::None : CullMode::Back;
-						pipelineInfo.transparencyEnabled = cmd.material->isFlagOf(Material::RenderFlags::AlphaBlend);
-					}
-					else
-					{
-						pipelineInfo.cullMode            = CullMode::Back;
-						pipelineInfo.transparencyEnabled = false;
-					}
+				pipelineInfo.shader       = shader;
+				pipelineInfo.vertexLayout = mesh->getVertexLayout();
 
-					if (cmd.material == nullptr || (depthTest && cmd.material->isFlagOf(Material::RenderFlags::DepthTest)))
-					{
-						pipelineInfo.depthTarget = renderData.gbuffer->getDepthBuffer();
-					}
+				if (cmd.material != nullptr)
+				{
+					pipelineInfo.cullMode            = cmd.material->isFlagOf(Material::RenderFlags::TwoSided) ? CullMode::None : CullMode::Back;
+					pipelineInfo.transparencyEnabled = cmd.material->isFlagOf(Material::RenderFlags::AlphaBlend);
+				}
+				else
+				{
+					pipelineInfo.cullMode            = CullMode::Back;
+					pipelineInfo.transparencyEnabled = false;
+				}
 
-					if (hasStencil)
-					{
-						pipelineInfo.shader                     = data.stencilShader;
-						pipelineInfo.stencilTest                = true;
-						pipelineInfo.stencilMask                = 0x00;
-						pipelineInfo.stencilFunc                = StencilType::Notequal;
-						pipelineInfo.stencilFail                = StencilType::Keep;
-						pipelineInfo.stencilDepthFail           = StencilType::Keep;
-						pipelineInfo.stencilDepthPass           = StencilType::Replace;
-						pipelineInfo.depthTest                  = true;
-						cmd.stencilPipelineInfo                 = pipelineInfo;
-						cmd.stencilPipelineInfo.colorTargets[0] = renderData.gbuffer->getBuffer(GBufferTextures::SCREEN);
-						cmd.stencilPipelineInfo.colorTargets[1] = nullptr;
-						cmd.stencilPipelineInfo.colorTargets[2] = nullptr;
-						cmd.stencilPipelineInfo.colorTargets[3] = nullptr;
-
-						pipelineInfo.shader           = skinnedMesh != nullptr ? data.deferredColorAnimShader : data.deferredColorShader;
-						pipelineInfo.stencilMask      = 0xFF;
-						pipelineInfo.stencilFunc      = StencilType::Always;
-						pipelineInfo.stencilFail      = StencilType::Keep;
-						pipelineInfo.stencilDepthFail = StencilType::Keep;
-						pipelineInfo.stencilDepthPass = StencilType::Replace;
-						pipelineInfo.depthTest        = true;
-					}
+				if (cmd.material == nullptr || (depthTest && cmd.material->isFlagOf(Material::RenderFlags::DepthTest)))
+				{
+					pipelineInfo.depthTarget = renderData.gbuffer->getDepthBuffer();
+				}
 
-					cmd.pipelineInfo = pipelineInfo;
+				if (hasStencil)
+				{
+					pipelineInfo.shader                     = data.stencilShader;
+					pipelineInfo.stencilTest                = true;
+					pipelineInfo.stencilMask                = 0x00;
+					pipelineInfo.stencilFunc                = StencilType::Notequal;
+					pipelineInfo.stencilFail                = StencilType::Keep;
+					pipelineInfo.stencilDepthFail           = StencilType::Keep;
+					pipelineInfo.stencilDepthPass           = StencilType::Replace;
+					pipelineInfo.depthTest                  = true;
+					cmd.stencilPipelineInfo                 = pipelineInfo;
+					cmd.stencilPipelineInfo.colorTargets[0] = renderData.gbuffer->getBuffer(GBufferTextures::SCREEN);
+					cmd.stencilPipelineInfo.colorTargets[1] = nullptr;
+					cmd.stencilPipelineInfo.colorTargets[2] = nullptr;
+					cmd.stencilPipelineInfo.colorTargets[3] = nullptr;
+
+					pipelineInfo.shader           = shader;
+					pipelineInfo.stencilMask      = 0xFF;
+					pipelineInfo.stencilFunc      = StencilType::Always;
+					pipelineInfo.stencilFail      = StencilType::Keep;
+					pipelineInfo.stencilDepthFail = StencilType::Keep;
+					pipelineInfo.stencilDepthPass = StencilType::Replace;
+					pipelineInfo.depthTest        = true;
 				}
-			};
 
-			for (auto entityHandle : meshQuery)
-			{
-				auto [mesh, trans] = meshQuery.convert(entityHandle);
+				//a permutation still compiling is drawn with the default state of the same shader and targets, or dropped for this frame
+				auto fallback                = pipelineInfo;
+				fallback.cullMode            = CullMode::Back;
+				fallback.transparencyEnabled = false;
+
+				auto pipeline = Pipeline::request(pipelineInfo, &fallback);
+				if (pipeline == nullptr)
 				{
-					const auto &worldTransform = trans.getWorldMatrix();
-					forEachMesh(
-					    worldTransform,
-					    mesh.mesh,
-					    meshQuery.hasComponent<component::StencilComponent>(entityHandle),
-					    nullptr, {});
+					data.commandQueue.pop_back();
+					return;
 				}
-			}
+
+				cmd.pipelineInfo = pipelineInfo;
+				cmd.pipeline     = pipeline.get();
+
+				const auto viewDepth = -(cameraView.view * worldTransform[3]).z;
+				const auto depth     = (viewDepth - cameraView.nearPlane) / (cameraView.farPlane - cameraView.nearPlane);
+
+				cmd.sortKey = render_queue::makeSortKey(pipelineInfo.transparencyEnabled ? render_queue::SortPass::Transparent : render_queue::SortPass::Opaque,
+				                                        data.pipelineIds.insert(cmd.pipeline).first,
+				                                        materialId,
+				                                        data.meshIds.insert(mesh.get()).first,
+				                                        depth);
+			};
+
+			auto &registry = world.getRegistry();
+			auto &bvh      = scene_bvh::getBVH(registry);
+
+			//static meshes come from the tree and skinned meshes are appended after them, then everything is culled in one batch
+			data.cullingBatch.clear();
+			bvh.tree.query(cameraView.frustum, [&](uint32_t userData) {
+				const auto entity = static_cast<entt::entity>(userData);
+				if (!gpu_culling::isGPUDriven(gpuCulling, entity))
+					data.cullingBatch.add(scene_bvh::getBounds(bvh, entity), userData);
+			});
+			const auto staticCount = data.cullingBatch.size();
 
 			for (auto entityHandle : skinnedMeshQuery)
 			{
-				auto entity        = skinnedMeshQuery.convert(entityHandle);
-				auto [mesh, trans] = entity;
-				auto mapleEntity   = entity.castTo<maple::Entity>();
+				auto [mesh, trans] = skinnedMeshQuery.convert(entityHandle);
+				if (mesh.mesh != nullptr)
+					data.cullingBatch.add(*mesh.mesh->getBoundingBox(), trans.getWorldMatrix(), entt::to_integral(entityHandle));
+			}
+
+			data.cullingBatch.cull(cameraView.frustum, data.visibility);
+			data.cullingBatch.forEachVisible(data.visibility, [&](uint32_t index) {
+				const auto entityHandle = static_cast<entt::entity>(data.cullingBatch.getUserData(index));
+				if (index < staticCount)
 				{
-					const auto &worldTransform = trans.getWorldMatrix();
+					auto [mesh, trans] = meshQuery.convert(entityHandle);
+					if (mesh.mesh != nullptr)
+					{
+						forEachMesh(
+						    entityHandle,
+						    trans.getWorldMatrix(),
+						    mesh.mesh,
+						    meshQuery.hasComponent<component::StencilComponent>(entityHandle),
+						    nullptr, {});
+					}
+				}
+				else
+				{
+					auto entity        = skinnedMeshQuery.convert(entityHandle);
+					auto [mesh, trans] = entity;
+					auto mapleEntity   = entity.castTo<maple::Entity>();
 					forEachMesh(
-					    worldTransform,
+					    entityHandle,
+					    trans.getWorldMatrix(),
 					    mesh.mesh,
 					    skinnedMeshQuery.hasComponent<component::StencilComponent>(entityHandle),
 					    &mesh,
 					    mapleEntity.getParent());
 				}
+			});
+
+			for (uint32_t i = 0; i < data.commandQueue.size(); i++)
+			{
+				data.sortedQueue.push_back({data.commandQueue[i].sortKey, i});
 			}
+			render_queue::sort(data.sortedQueue, data.sortScratch);
+
+			//the instance data follows the sorted order, so every run of equal commands is one instanced draw
+			data.instances.resize(data.sortedQueue.size());
+			for (uint32_t i = 0; i < data.sortedQueue.size(); i++)
+			{
+				const auto &cmd   = data.commandQueue[data.sortedQueue[i].index];
+				data.instances[i] = {cmd.transform, cmd.prevTransform};
+			}
+
+			render_queue::groupInstances(data.sortedQueue, data.instanceGroups, [&](uint32_t left, uint32_t right) {
+				const auto &a = data.commandQueue[left];
+				const auto &b = data.commandQueue[right];
+				//skinned meshes update their bones between the draws and are never instanced
+				return a.boneTransforms == nullptr && b.boneTransforms == nullptr &&
+				       a.pipeline == b.pipeline && a.material == b.material && a.mesh == b.mesh;
+			});
 		}
 
 		using RenderEntity = ecs::Registry ::Modify<component::DeferredData>::Fetch<component::ShadowMapData>::Fetch<component::CameraView>::Fetch<component::RendererData>::Fetch<component::SSAOData>::Modify<capture_graph::component::RenderGraph>::To<ecs::Entity>;
 
-		inline auto onRender(RenderEntity entity, PathTraceGroup pathGroup, ecs::World world)
+		//state bound on one command buffer, the sorted queue lets most draws reuse it
+		struct BindState
+		{
+			Mesh *         mesh     = nullptr;
+			DescriptorSet *material = nullptr;
+		};
+
+		inline auto unbindMesh(BindState &state)
+		{
+			if (state.mesh != nullptr)
+			{
+				state.mesh->getVertexBuffer()->unbind();
+				state.mesh->getIndexBuffer()->unbind();
+				state.mesh = nullptr;
+			}
+		}
+
+		inline auto bindMesh(const CommandBuffer *commandBuffer, Pipeline *pipeline, Mesh *mesh, BindState &state, global::component::BindCounters &counters)
 		{
+			if (state.mesh != mesh)
+			{
+				unbindMesh(state);
+				mesh->bindVertexStreams(commandBuffer, pipeline);
+				mesh->getIndexBuffer()->bind(commandBuffer);
+				state.mesh = mesh;
+				counters.bufferBinds++;
+			}
+			else
+			{
+				counters.bufferSkips++;
+			}
+		}
+
+		//descriptorSets[1] is replaced by the material of the sub mesh
+		inline auto bindMaterial(const CommandBuffer *                         commandBuffer,
+		                         Pipeline *                                   pipeline,
+		                         const std::shared_ptr<Material> &            material,
+		                         std::vector<std::shared_ptr<DescriptorSet>> &descriptorSets,
+		                         BindState &                                  state,
+		                         global::component::BindCounters &            counters)
+		{
+			descriptorSets[1] = material->getDescriptorSet(pipeline->getShader()->getName());
+			if (state.material != descriptorSets[1].get())
+			{
+				Renderer::bindDescriptorSets(pipeline, commandBuffer, 0, descriptorSets);
+				state.material = descriptorSets[1].get();
+				counters.descriptorBinds++;
+			}
+			else
+			{
+				counters.descriptorSkips++;
+			}
+		}
+
+		//draw instanceCount instances of every sub mesh
+		inline auto recordCommand(const CommandBuffer *                         commandBuffer,
+		                          Pipeline *                                   pipeline,
+		                          const RenderCommand &                        command,
+		                          uint32_t                                     instanceCount,
+		                          const std::shared_ptr<Material> &            defaultMaterial,
+		                          std::vector<std::shared_ptr<DescriptorSet>> &descriptorSets,
+		                          BindState &                                  state,
+		                          global::component::BindCounters &            counters)
+		{
+			auto &materials = command.mesh->getMaterial();
+			auto &indices   = command.mesh->getSubMeshIndex();
+			auto  start     = 0;
+
+			bindMesh(commandBuffer, pipeline, command.mesh, state, counters);
+
+			for (auto i = 0; i < indices.size(); i++)
+			{
+				auto material = indices.size() > materials.size() ? defaultMaterial : materials[i];
+				auto end      = indices[i];
+
+				bindMaterial(commandBuffer, pipeline, material, descriptorSets, state, counters);
+				Renderer::drawIndexedInstanced(commandBuffer, DrawType::Triangle, end - start, instanceCount, start);
+				counters.draws++;
+				counters.instances += instanceCount;
+
+				start = end;
+			}
+		}
+
+		//draw the instances of a batch which passed the GPU culling, the instance counts are read from the args of the camera view
+		inline auto recordIndirect(const CommandBuffer *                         commandBuffer,
+		                           Pipeline *                                   pipeline,
+		                           const component::GPUCullingData &            gpuCulling,
+		                           uint32_t                                     batch,
+		                           const std::shared_ptr<Material> &            defaultMaterial,
+		                           std::vector<std::shared_ptr<DescriptorSet>> &descriptorSets,
+		                           BindState &                                  state,
+		                           global::component::BindCounters &            counters)
+		{
+			auto  mesh         = gpuCulling.meshes[batch];
+			auto &materials    = mesh->getMaterial();
+			auto  commandCount = gpuCulling.batches[batch].commandCount;
+
+			bindMesh(commandBuffer, pipeline, mesh, state, counters);
+
+			for (uint32_t i = 0; i < commandCount; i++)
+			{
+				auto material = commandCount > materials.size() ? defaultMaterial : materials[i];
+				bindMaterial(commandBuffer, pipeline, material, descriptorSets, state, counters);
+				Renderer::drawIndexedIndirect(commandBuffer, gpuCulling.args.get(), gpu_culling::getArgsOffset(gpuCulling, 0, batch, i), 1, sizeof(gpu_culling::DrawIndexedIndirectCommand));
+				counters.draws++;
+			}
+		}
+
+		inline auto onRender(RenderEntity entity, PathTraceGroup pathGroup, global::component::RenderQueueStats &stats, const component::GPUCullingData &gpuCulling, ecs::World world)
+		{
+			stats.deferred = {};
+
 			if (!pathGroup.empty())
 				return;
 
 			auto [data, shadowData, cameraView, renderData, ssao, graph] = entity;
 
+			auto instanceBuffer = data.instanceBuffer.upload(data.instances.data(), static_cast<uint32_t>(sizeof(InstanceData) * data.instances.size()));
+			data.descriptorColorSet[0]->setStorageBuffer("InstanceBuffer", instanceBuffer);
+
 			data.descriptorColorSet[0]->update(renderData.commandBuffer);
 			data.descriptorColorSet[2]->update(renderData.commandBuffer);
 
@@ -402,95 +741,144 @@ namespace maple
 
 			data.stencilDescriptorSet->update(renderData.commandBuffer);
 
-			std::shared_ptr<Pipeline> pipeline;
+			const auto &queue  = data.commandQueue;
+			const auto &order  = data.sortedQueue;
+			const auto &groups = data.instanceGroups;
 
-			for (auto &command : data.commandQueue)
+			Pipeline * boundPipeline = nullptr;
+			std::mutex statsMutex;
+
+			//opaque batches culled on the GPU go first, so the sorted transparent commands are still drawn last
+			if (gpuCulling.ready && !data.indirectDraws.empty())
 			{
-				pipeline = Pipeline::get(command.pipelineInfo);
+				data.descriptorIndirectSet[0]->setStorageBuffer("InstanceBuffer", gpuCulling.visibleInstances);
+				data.descriptorIndirectSet[0]->update(renderData.commandBuffer);
 
-				if (renderData.commandBuffer)
-					renderData.commandBuffer->bindPipeline(pipeline.get());
-				else
-					pipeline->bind(renderData.commandBuffer);
+				const auto &draws = data.indirectDraws;
+				for (uint32_t i = 0; i < draws.size();)
+				{
+					auto     pipeline = draws[i].pipeline;
+					uint32_t end      = i + 1;
+					while (end < draws.size() && draws[end].pipeline == pipeline)
+						end++;
 
-				auto shader = command.boneTransforms != nullptr ?
-                                  data.deferredColorAnimShader :
-                                  data.deferredColorShader;
+					Renderer::recordParallel(renderData.commandBuffer, pipeline, end - i, [&, first = i](const CommandBuffer *commandBuffer, uint32_t begin, uint32_t last) {
+						auto pushConstants  = data.deferredColorShader->getPushConstants();
+						auto descriptorSets = data.descriptorIndirectSet;
 
-				auto &pushConstants = shader->getPushConstants()[0];
+						BindState                       state;
+						global::component::BindCounters counters;
+						counters.pipelineBinds = 1;
+						counters.pipelineSkips = last - begin - 1;
 
-				if (command.boneTransforms != nullptr)
-				{
-					data.descriptorAnimSet[0]->setUniform("UniformBufferObject", "boneTransforms", command.boneTransforms.get());
-					data.descriptorAnimSet[0]->update(renderData.commandBuffer);
-				}
+						for (auto index = first + begin; index < first + last; index++)
+						{
+							const auto batch = draws[index].batch;
+							pushConstants[0].setValue("instanceOffset", &gpuCulling.batches[batch].firstInstance);
+							data.deferredColorShader->bindPushConstants(commandBuffer, pipeline, pushConstants);
+							recordIndirect(commandBuffer, pipeline, gpuCulling, batch, data.defaultMaterial, descriptorSets, state, counters);
+						}
+						unbindMesh(state);
 
-				pushConstants.setValue("transform", &command.transform);
-				shader->bindPushConstants(renderData.commandBuffer, pipeline.get());
+						std::lock_guard<std::mutex> lock(statsMutex);
+						stats.deferred += counters;
+					});
+					i = end;
+				}
+			}
 
-				auto &materials = command.mesh->getMaterial();
-				auto &indices   = command.mesh->getSubMeshIndex();
-				auto  start     = 0;
-				command.mesh->getVertexBuffer()->bind(renderData.commandBuffer, pipeline.get());
-				command.mesh->getIndexBuffer()->bind(renderData.commandBuffer);
+			for (uint32_t i = 0; i < groups.size();)
+			{
+				auto &command  = queue[order[groups[i].first].index];
+				auto  pipeline = command.pipeline;
 
-				for (auto i = 0; i < indices.size(); i++)
+				//skinned meshes update the bone uniforms between the draws, so they are recorded inline
+				if (command.boneTransforms != nullptr)
 				{
-					auto material = indices.size() > materials.size() ? data.defaultMaterial : materials[i];
-					auto end      = indices[i];
+					i++;
 
-					if (command.boneTransforms != nullptr)
+					if (boundPipeline != pipeline)
 					{
-						//material->bind(renderData.commandBuffer);
-						data.descriptorAnimSet[1] = material->getDescriptorSet(pipeline->getShader()->getName());
-						Renderer::bindDescriptorSets(pipeline.get(), renderData.commandBuffer, 0, data.descriptorAnimSet);
+						if (renderData.commandBuffer)
+							renderData.commandBuffer->bindPipeline(pipeline);
+						else
+							pipeline->bind(renderData.commandBuffer);
+						boundPipeline = pipeline;
+						stats.deferred.pipelineBinds++;
 					}
 					else
 					{
-						//material->bind(renderData.commandBuffer);
-						data.descriptorColorSet[1] = material->getDescriptorSet(pipeline->getShader()->getName());
-						Renderer::bindDescriptorSets(pipeline.get(), renderData.commandBuffer, 0, data.descriptorColorSet);
+						stats.deferred.pipelineSkips++;
 					}
 
-					Renderer::drawIndexed(renderData.commandBuffer, DrawType::Triangle, end - start, start);
+					data.descriptorAnimSet[0]->setUniform(data.boneTransforms, command.boneTransforms.get());
+					data.descriptorAnimSet[0]->update(renderData.commandBuffer);
+
+					auto  shader        = pipeline->getShader();
+					auto &pushConstants = shader->getPushConstants();
+					pushConstants[0].setValue("transform", &command.transform);
+					Renderer::setQuantization(pushConstants[0], command.mesh);
+					shader->bindPushConstants(renderData.commandBuffer, pipeline, pushConstants);
 
-					start = end;
+					BindState state;
+					recordCommand(renderData.commandBuffer, pipeline, command, 1, data.defaultMaterial, data.descriptorAnimSet, state, stats.deferred);
+					unbindMesh(state);
+					continue;
 				}
-				command.mesh->getVertexBuffer()->unbind();
-				command.mesh->getIndexBuffer()->unbind();
 
-				/*if (command.stencilPipelineInfo.stencilTest)
-				{
-					auto stencilPipeline = Pipeline::get(command.stencilPipelineInfo);
+				//the following instance groups sharing the pipeline are recorded as one list
+				uint32_t end = i + 1;
+				while (end < groups.size() && queue[order[groups[end].first].index].boneTransforms == nullptr && queue[order[groups[end].first].index].pipeline == pipeline)
+					end++;
 
-					if (renderData.commandBuffer)
-						renderData.commandBuffer->bindPipeline(stencilPipeline.get());
-					else
-						stencilPipeline->bind(renderData.commandBuffer);
+				if (renderData.commandBuffer)
+					renderData.commandBuffer->unbindPipeline();
+				boundPipeline = nullptr;
 
-					auto& pushConstants = data.stencilShader->getPushConstants()[0];
-					pushConstants.setValue("transform", &command.transform);
-					data.stencilShader->bindPushConstants(renderData.commandBuffer, stencilPipeline.get());
+				Renderer::recordParallel(renderData.commandBuffer, pipeline, end - i, [&, first = i](const CommandBuffer *commandBuffer, uint32_t begin, uint32_t last) {
+					//every recording thread works on its own copy of the push constants and descriptor sets
+					auto shader         = pipeline->getShader();
+					auto pushConstants  = shader->getPushConstants();
+					auto descriptorSets = data.descriptorColorSet;
 
-					Renderer::bindDescriptorSets(stencilPipeline.get(), renderData.commandBuffer, 0, { data.stencilDescriptorSet });
-					Renderer::drawMesh(renderData.commandBuffer, stencilPipeline.get(), command.mesh);
+					BindState                       state;
+					global::component::BindCounters counters;
+					counters.pipelineBinds = 1;
+					counters.pipelineSkips = last - begin - 1;
 
-					if (renderData.commandBuffer)
-						renderData.commandBuffer->unbindPipeline();
-					else
-						stencilPipeline->end(renderData.commandBuffer);
-				}*/
+					for (auto index = first + begin; index < first + last; index++)
+					{
+						const auto &group   = groups[index];
+						const auto &command = queue[order[group.first].index];
+						pushConstants[0].setValue("instanceOffset", &group.first);
+						Renderer::setQuantization(pushConstants[0], command.mesh);
+						shader->bindPushConstants(commandBuffer, pipeline, pushConstants);
+						recordCommand(commandBuffer, pipeline, command, group.count, data.defaultMaterial, descriptorSets, state, counters);
+					}
+					unbindMesh(state);
+
+					std::lock_guard<std::mutex> lock(statsMutex);
+					stats.deferred += counters;
+				});
+				i = end;
 			}
 
 			if (renderData.commandBuffer)
 				renderData.commandBuffer->unbindPipeline();
-			else if (pipeline)
-				pipeline->end(renderData.commandBuffer);
+			else if (boundPipeline != nullptr)
+				boundPipeline->end(renderData.commandBuffer);
 		}
 
-		auto registerDeferredOffScreenRenderer(ExecuteQueue &begin, ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint) -> void
+		auto registerDeferredOffScreenRenderer(ExecuteQueue &begin, ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint, frame_graph::FrameGraph::PassBuilder pass) -> void
 		{
+			//the stencil outline of the selected meshes is drawn into the screen
+			for (auto target : {GBufferTextures::COLOR, GBufferTextures::POSITION, GBufferTextures::NORMALS, GBufferTextures::PBR,
+			                     GBufferTextures::VIEW_POSITION, GBufferTextures::VIEW_NORMALS, GBufferTextures::VELOCITY, GBufferTextures::SCREEN})
+				pass.write(target);
+
 			executePoint->registerGlobalComponent<component::DeferredData>();
+			executePoint->registerGlobalComponent<component::GPUCullingData>();
+			executePoint->registerGlobalComponent<global::component::RenderQueueStats>();
 			executePoint->registerWithinQueue<deferred_offscreen::beginScene>(begin);
 			executePoint->registerWithinQueue<deferred_offscreen::onRender>(renderer);
 		}
@@ -562,8 +950,16 @@ namespace maple
 			deferredLightPipeline->end(rendererData.commandBuffer);
 		}
 
-		auto registerDeferredLighting(ExecuteQueue &begin, ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint) -> void
+		auto registerDeferredLighting(ExecuteQueue &begin, ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint, frame_graph::FrameGraph::PassBuilder pass) -> void
 		{
+			pass.read(GBufferTextures::COLOR)
+			    .read(GBufferTextures::POSITION)
+			    .read(GBufferTextures::NORMALS)
+			    .read(GBufferTextures::PBR)
+			    .read(GBufferTextures::SSAO_BLUR)
+			    .read(GBufferTextures::INDIRECT_LIGHTING)
+			    .write(GBufferTextures::SCREEN);
+
 			executePoint->registerGlobalComponent<component::DeferredData>();
 			executePoint->registerWithinQueue<deferred_lighting::onRender>(renderer);
 		}
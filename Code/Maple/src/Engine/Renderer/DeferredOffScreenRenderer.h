@@ -3,10 +3,14 @@
 //////////////////////////////////////////////////////////////////////////////
 #pragma once
 
+#include "FrameGraph.h"
+#include "InstanceBuffer.h"
+#include "RenderQueue.h"
 #include "Renderer.h"
 
 #include "Engine/Material.h"
 #include "Engine/Mesh.h"
+#include "Math/FrustumCulling.h"
 #include "RHI/DescriptorSet.h"
 #include "RHI/Pipeline.h"
 #include "RHI/Shader.h"
@@ -21,20 +25,82 @@ namespace maple
 	{
 		struct DeferredData
 		{
+			//a batch of the GPU culling pass and the pipeline it is drawn with
+			struct IndirectDraw
+			{
+				Pipeline *pipeline;
+				uint32_t  batch;
+			};
+
 			std::vector<RenderCommand>                  commandQueue;
+			std::vector<render_queue::SortItem>         sortedQueue;
+			std::vector<render_queue::SortItem>         sortScratch;
+			render_queue::SortIds                       pipelineIds;
+			render_queue::SortIds                       materialIds;
+			render_queue::SortIds                       meshIds;
+			std::vector<render_queue::InstanceGroup>    instanceGroups;
+			std::vector<InstanceData>                   instances;        //one per entry of sortedQueue
+			InstanceBuffer                              instanceBuffer;
+			std::vector<glm::mat4>                      prevTransforms;        //indexed by entity, written with the frame in prevFrames
+			std::vector<uint64_t>                       prevFrames;
+			uint64_t                                    frame = 0;
+			std::vector<IndirectDraw>                   indirectDraws;        //sorted by pipeline
+			CullingBatch                                cullingBatch;
+			std::vector<uint64_t>                       visibility;
 			std::shared_ptr<Material>                   defaultMaterial;
 			std::vector<std::shared_ptr<DescriptorSet>> descriptorColorSet;
+			std::vector<std::shared_ptr<DescriptorSet>> descriptorIndirectSet;        //InstanceBuffer is the output of the GPU culling pass
 			std::vector<std::shared_ptr<DescriptorSet>> descriptorLightSet;
 			std::vector<std::shared_ptr<DescriptorSet>> descriptorAnimSet;
 
 			std::shared_ptr<Texture2D> preintegratedFG;
 			std::shared_ptr<Shader>    deferredColorShader;        //stage 0 get all color information
 			std::shared_ptr<Shader>    deferredColorAnimShader;
+			std::shared_ptr<Shader>    deferredColorCompressedShader;        //the same stage for the meshes with compressed vertex streams
+			std::shared_ptr<Shader>    deferredColorAnimCompressedShader;
 			std::shared_ptr<Shader>    deferredLightShader;        //stage 1 process lighting
 			std::shared_ptr<Shader>    stencilShader;
 
 			std::shared_ptr<DescriptorSet> stencilDescriptorSet;
 
+			//resolved once when the descriptor sets are created
+			struct ColorUniforms
+			{
+				UniformHandle projView;
+				UniformHandle view;
+				UniformHandle projViewOld;
+				UniformHandle depthView;        //the view in the UBO of the set 2
+				UniformHandle nearPlane;
+				UniformHandle farPlane;
+			};
+
+			struct LightUniforms
+			{
+				UniformHandle lights;
+				UniformHandle shadowTransform;
+				UniformHandle viewMatrix;
+				UniformHandle lightView;
+				UniformHandle biasMat;
+				UniformHandle cameraPosition;
+				UniformHandle splitDepths;
+				UniformHandle shadowMapSize;
+				UniformHandle initialBias;
+				UniformHandle lightCount;
+				UniformHandle shadowCount;
+				UniformHandle mode;
+				UniformHandle shadowMethod;
+				UniformHandle enableLPV;
+				UniformHandle enableShadow;
+				UniformHandle cubeMapMipLevels;
+				UniformHandle ssaoEnable;
+			};
+
+			ColorUniforms colorUniforms;        //the indirect set shares the layout of the color set
+			ColorUniforms animUniforms;
+			LightUniforms lightUniforms;
+			UniformHandle boneTransforms;
+			UniformHandle stencilProjView;
+
 			std::shared_ptr<Mesh> screenQuad;
 
 			bool depthTest = true;
@@ -45,11 +111,11 @@ namespace maple
 
 	namespace deferred_offscreen
 	{
-		auto registerDeferredOffScreenRenderer(ExecuteQueue &begin, ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint) -> void;
+		auto registerDeferredOffScreenRenderer(ExecuteQueue &begin, ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint, frame_graph::FrameGraph::PassBuilder pass) -> void;
 	};
 
 	namespace deferred_lighting
 	{
-		auto registerDeferredLighting(ExecuteQueue &begin, ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint) -> void;
+		auto registerDeferredLighting(ExecuteQueue &begin, ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint, frame_graph::FrameGraph::PassBuilder pass) -> void;
 	};
 }        // namespace maple
@@ -38,12 +38,12 @@ namespace maple
 			auto [finalData] = entity;
 			float gamma                         = 2.2;
 
-			finalData.finalDescriptorSet->setUniform("UniformBuffer", "gamma", &gamma);
-			finalData.finalDescriptorSet->setUniform("UniformBuffer", "toneMapIndex", &finalData.toneMapIndex);
-			finalData.finalDescriptorSet->setUniform("UniformBuffer", "exposure", &finalData.exposure);
+			finalData.finalDescriptorSet->setUniform(finalData.uniforms.gamma, &gamma);
+			finalData.finalDescriptorSet->setUniform(finalData.uniforms.toneMapIndex, &finalData.toneMapIndex);
+			finalData.finalDescriptorSet->setUniform(finalData.uniforms.exposure, &finalData.exposure);
 			auto ssaoEnable    = 0;
 			auto reflectEnable = 0;
-			auto cloudEnable   = false;        // envData->cloud ? 1 : 0;
+			int32_t cloudEnable = 0;        // envData->cloud ? 1 : 0;
 
 			int32_t bloomEnable = 0;
 
@@ -52,10 +52,10 @@ namespace maple
 				bloomEnable = entity.getComponent<component::BloomData>().enable;
 			}
 
-			finalData.finalDescriptorSet->setUniform("UniformBuffer", "bloomEnable", &bloomEnable);
-			finalData.finalDescriptorSet->setUniform("UniformBuffer", "ssaoEnable", &ssaoEnable);
-			finalData.finalDescriptorSet->setUniform("UniformBuffer", "reflectEnable", &reflectEnable);
-			finalData.finalDescriptorSet->setUniform("UniformBuffer", "cloudEnable", &cloudEnable);
+			finalData.finalDescriptorSet->setUniform(finalData.uniforms.bloomEnable, &bloomEnable);
+			finalData.finalDescriptorSet->setUniform(finalData.uniforms.ssaoEnable, &ssaoEnable);
+			finalData.finalDescriptorSet->setUniform(finalData.uniforms.reflectEnable, &reflectEnable);
+			finalData.finalDescriptorSet->setUniform(finalData.uniforms.cloudEnable, &cloudEnable);
 
 			finalData.finalDescriptorSet->setTexture("uScreenSampler", renderData.gbuffer->getBuffer(GBufferTextures::SCREEN));
 			
@@ -69,15 +69,11 @@ namespace maple
 				}
 			}
 
-			//if (reflectEnable)
-			{
-				finalData.finalDescriptorSet->setTexture("uReflectionSampler", renderData.gbuffer->getBuffer(GBufferTextures::SSR_SCREEN));
-			}
-
-			//if (bloomEnable)
-			{
-				finalData.finalDescriptorSet->setTexture("uBloomSampler", renderData.gbuffer->getBuffer(GBufferTextures::BLOOM_SCREEN));
-			}
+			//the screen stands in for the buffers of a turned off feature, the shader does not sample them
+			const auto reflection = renderData.gbuffer->isAllocated(GBufferTextures::SSR_SCREEN) ? GBufferTextures::SSR_SCREEN : GBufferTextures::SCREEN;
+			const auto bloom      = renderData.gbuffer->isAllocated(GBufferTextures::BLOOM_SCREEN) ? GBufferTextures::BLOOM_SCREEN : GBufferTextures::SCREEN;
+			finalData.finalDescriptorSet->setTexture("uReflectionSampler", renderData.gbuffer->getBuffer(reflection));
+			finalData.finalDescriptorSet->setTexture("uBloomSampler", renderData.gbuffer->getBuffer(bloom));
 
 			finalData.finalDescriptorSet->update(renderData.commandBuffer);
 
@@ -106,14 +102,28 @@ namespace maple
 
 	namespace final_screen_pass
 	{
-		auto registerFinalPass(ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint) -> void
+		auto registerFinalPass(ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint, frame_graph::FrameGraph::PassBuilder pass) -> void
 		{
+			pass.read(GBufferTextures::SCREEN)
+			    .read(GBufferTextures::SSR_SCREEN, ResourceState::ShaderRead, frame_feature::SSR)
+			    .read(GBufferTextures::BLOOM_SCREEN, ResourceState::ShaderRead, frame_feature::Bloom)
+			    .sideEffect();
+
 			executePoint->registerGlobalComponent<component::FinalPass>([](component::FinalPass &data) {
 				data.finalShader = Shader::create("shaders/ScreenPass.shader");
 				DescriptorInfo descriptorInfo{};
 				descriptorInfo.layoutIndex = 0;
 				descriptorInfo.shader      = data.finalShader.get();
 				data.finalDescriptorSet    = DescriptorSet::create(descriptorInfo);
+
+				auto &set                   = *data.finalDescriptorSet;
+				data.uniforms.gamma         = set.getUniformHandle(UniformId("UniformBuffer", "gamma"));
+				data.uniforms.toneMapIndex  = set.getUniformHandle(UniformId("UniformBuffer", "toneMapIndex"));
+				data.uniforms.exposure      = set.getUniformHandle(UniformId("UniformBuffer", "exposure"));
+				data.uniforms.bloomEnable   = set.getUniformHandle(UniformId("UniformBuffer", "bloomEnable"));
+				data.uniforms.ssaoEnable    = set.getUniformHandle(UniformId("UniformBuffer", "ssaoEnable"));
+				data.uniforms.reflectEnable = set.getUniformHandle(UniformId("UniformBuffer", "reflectEnable"));
+				data.uniforms.cloudEnable   = set.getUniformHandle(UniformId("UniformBuffer", "cloudEnable"));
 			});
 			executePoint->registerWithinQueue<final_screen_pass::system>(renderer);
 		}
@@ -2,13 +2,14 @@
 // This file is part of the Maple Engine                              		//
 //////////////////////////////////////////////////////////////////////////////
 #pragma once
+#include "FrameGraph.h"
+#include "RHI/DescriptorSet.h"
 #include "Scene/System/ExecutePoint.h"
 #include <memory>
 
 namespace maple
 {
 	class Shader;
-	class DescriptorSet;
 	class Texture;
 
 	namespace component
@@ -20,11 +21,23 @@ namespace maple
 			std::shared_ptr<Texture>       renderTarget;
 			float                          exposure     = 1.0;
 			int32_t                        toneMapIndex = 1;
+
+			//resolved once when the descriptor set is created
+			struct Uniforms
+			{
+				UniformHandle gamma;
+				UniformHandle toneMapIndex;
+				UniformHandle exposure;
+				UniformHandle bloomEnable;
+				UniformHandle ssaoEnable;
+				UniformHandle reflectEnable;
+				UniformHandle cloudEnable;
+			} uniforms;
 		};
 	}        // namespace component
 
 	namespace final_screen_pass
 	{
-		auto registerFinalPass(ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint) -> void;
+		auto registerFinalPass(ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint, frame_graph::FrameGraph::PassBuilder pass) -> void;
 	};
 }        // namespace maple
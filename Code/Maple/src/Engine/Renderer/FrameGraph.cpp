@@ -0,0 +1,332 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+#include "FrameGraph.h"
+
+#include <algorithm>
+
+namespace maple
+{
+	namespace frame_graph
+	{
+		namespace
+		{
+			inline auto getBytesPerPixel(TextureFormat format) -> uint32_t
+			{
+				switch (format)
+				{
+					case TextureFormat::R8:
+					case TextureFormat::STENCIL:
+						return 1;
+					case TextureFormat::RG8:
+					case TextureFormat::R16:
+						return 2;
+					case TextureFormat::R32I:
+					case TextureFormat::R32UI:
+					case TextureFormat::RG16F:
+					case TextureFormat::RGB8:
+					case TextureFormat::RGBA8:
+					case TextureFormat::RGB:
+					case TextureFormat::RGBA:
+					case TextureFormat::DEPTH:
+					case TextureFormat::DEPTH_STENCIL:
+						return 4;
+					case TextureFormat::RGB16:
+					case TextureFormat::RGBA16:
+						return 8;
+					case TextureFormat::RGB32:
+					case TextureFormat::RGBA32:
+						return 16;
+					default:
+						return 0;
+				}
+			}
+
+			struct Slot
+			{
+				TextureDesc desc;
+				PassId      lastUse;
+				bool        imported;
+			};
+		}        // namespace
+
+		auto FrameGraph::PassBuilder::read(ResourceId resource, ResourceState state, uint32_t features) -> PassBuilder &
+		{
+			graph.passes[pass].accesses.push_back({resource, state, false, features});
+			return *this;
+		}
+
+		auto FrameGraph::PassBuilder::write(ResourceId resource, ResourceState state) -> PassBuilder &
+		{
+			graph.passes[pass].accesses.push_back({resource, state, true});
+			return *this;
+		}
+
+		auto FrameGraph::PassBuilder::sideEffect() -> PassBuilder &
+		{
+			graph.passes[pass].sideEffect = true;
+			return *this;
+		}
+
+		auto FrameGraph::PassBuilder::require(uint32_t features) -> PassBuilder &
+		{
+			graph.passes[pass].features |= features;
+			return *this;
+		}
+
+		auto FrameGraph::createTexture(const std::string &name, const TextureDesc &desc) -> ResourceId
+		{
+			resources.push_back({name, desc, false, ResourceState::Undefined});
+			return static_cast<ResourceId>(resources.size() - 1);
+		}
+
+		auto FrameGraph::importTexture(const std::string &name, const TextureDesc &desc, ResourceState initial) -> ResourceId
+		{
+			resources.push_back({name, desc, true, initial});
+			return static_cast<ResourceId>(resources.size() - 1);
+		}
+
+		auto FrameGraph::addPass(const std::string &name) -> PassBuilder
+		{
+			auto &pass = passes.emplace_back();
+			pass.name  = name;
+			return PassBuilder(*this, static_cast<PassId>(passes.size() - 1));
+		}
+
+		auto FrameGraph::setDesc(ResourceId resource, const TextureDesc &desc) -> void
+		{
+			resources[resource].desc = desc;
+		}
+
+		auto FrameGraph::clear() -> void
+		{
+			resources.clear();
+			passes.clear();
+		}
+
+		auto FrameGraph::compile(bool aliasing, uint32_t features) const -> CompiledGraph
+		{
+			const auto passCount     = static_cast<uint32_t>(passes.size());
+			const auto resourceCount = static_cast<uint32_t>(resources.size());
+
+			//a pass which needs a feature that is off keeps no access and is culled below, a read which needs one is dropped
+			auto passes = this->passes;
+			for (auto &pass : passes)
+			{
+				if ((pass.features & features) != pass.features)
+				{
+					pass.accesses.clear();
+					pass.sideEffect = false;
+					continue;
+				}
+				pass.accesses.erase(std::remove_if(pass.accesses.begin(), pass.accesses.end(), [&](const Access &access) {
+					                    return (access.features & features) != access.features;
+				                    }),
+				                    pass.accesses.end());
+			}
+
+			CompiledGraph graph;
+			graph.culled.assign(passCount, false);
+			graph.barriers.resize(passCount);
+			graph.physical.assign(resourceCount, NoPhysical);
+			graph.firstUse.assign(resourceCount, 0);
+			graph.lastUse.assign(resourceCount, 0);
+
+			//a pass is kept while one of the resources it writes is read, resources are not versioned
+			//so a writer is kept while the resource has any reader.
+			std::vector<uint32_t>            passRefs(passCount, 0);
+			std::vector<uint32_t>            resourceRefs(resourceCount, 0);
+			std::vector<std::vector<PassId>> writers(resourceCount);
+
+			for (PassId pass = 0; pass < passCount; pass++)
+			{
+				for (auto &access : passes[pass].accesses)
+				{
+					if (access.write)
+					{
+						passRefs[pass]++;
+						writers[access.resource].emplace_back(pass);
+					}
+					else
+					{
+						resourceRefs[access.resource]++;
+					}
+				}
+			}
+
+			std::vector<ResourceId> unreferenced;
+
+			auto cullPass = [&](PassId pass) {
+				graph.culled[pass] = true;
+				for (auto &access : passes[pass].accesses)
+				{
+					if (!access.write && --resourceRefs[access.resource] == 0 && !resources[access.resource].imported)
+						unreferenced.emplace_back(access.resource);
+				}
+			};
+
+			for (PassId pass = 0; pass < passCount; pass++)
+			{
+				if (passRefs[pass] == 0 && !passes[pass].sideEffect)
+					cullPass(pass);
+			}
+
+			for (ResourceId resource = 0; resource < resourceCount; resource++)
+			{
+				if (resourceRefs[resource] == 0 && !resources[resource].imported)
+					unreferenced.emplace_back(resource);
+			}
+
+			while (!unreferenced.empty())
+			{
+				const auto resource = unreferenced.back();
+				unreferenced.pop_back();
+				for (auto pass : writers[resource])
+				{
+					if (!graph.culled[pass] && --passRefs[pass] == 0 && !passes[pass].sideEffect)
+						cullPass(pass);
+				}
+			}
+
+			//lifetimes, in pass indices
+			std::vector<bool> used(resourceCount, false);
+			std::vector<bool> written(resourceCount, false);
+
+			for (PassId pass = 0; pass < passCount; pass++)
+			{
+				if (graph.culled[pass])
+					continue;
+
+				//a pass declaring a read and a write of one resource runs sub passes which write it first, e.g. blur
+				for (auto &access : passes[pass].accesses)
+				{
+					if (access.write)
+						written[access.resource] = true;
+				}
+
+				for (auto &access : passes[pass].accesses)
+				{
+					const auto resource = access.resource;
+					if (!used[resource])
+					{
+						used[resource]           = true;
+						graph.firstUse[resource] = pass;
+					}
+					graph.lastUse[resource] = pass;
+
+					if (!access.write && !written[resource] && !resources[resource].imported &&
+					    std::find(graph.uninitialized.begin(), graph.uninitialized.end(), resource) == graph.uninitialized.end())
+					{
+						graph.uninitialized.emplace_back(resource);
+					}
+				}
+			}
+
+			//imported resources own their memory for the whole frame, transient resources share the memory of a
+			//resource with the same description whose last use is before their first use.
+			std::vector<Slot> slots;
+
+			for (ResourceId resource = 0; resource < resourceCount; resource++)
+			{
+				if (resources[resource].imported)
+				{
+					graph.firstUse[resource] = 0;
+					graph.lastUse[resource]  = passCount > 0 ? passCount - 1 : 0;
+					graph.physical[resource] = static_cast<int32_t>(slots.size());
+					slots.push_back({resources[resource].desc, graph.lastUse[resource], true});
+				}
+			}
+
+			std::vector<ResourceId> transients;
+			for (ResourceId resource = 0; resource < resourceCount; resource++)
+			{
+				if (used[resource] && !resources[resource].imported)
+					transients.emplace_back(resource);
+			}
+
+			std::stable_sort(transients.begin(), transients.end(), [&](ResourceId left, ResourceId right) {
+				return graph.firstUse[left] < graph.firstUse[right];
+			});
+
+			for (auto resource : transients)
+			{
+				const auto &desc = resources[resource].desc;
+				graph.transientBytes += getTextureSize(desc);
+
+				auto slot = std::find_if(slots.begin(), slots.end(), [&](const Slot &slot) {
+					return aliasing && !slot.imported && slot.desc == desc && slot.lastUse < graph.firstUse[resource];
+				});
+
+				if (slot == slots.end())
+				{
+					graph.physical[resource] = static_cast<int32_t>(slots.size());
+					slots.push_back({desc, graph.lastUse[resource], false});
+					graph.allocatedBytes += getTextureSize(desc);
+				}
+				else
+				{
+					graph.physical[resource] = static_cast<int32_t>(slot - slots.begin());
+					slot->lastUse            = graph.lastUse[resource];
+				}
+			}
+
+			for (auto &slot : slots)
+			{
+				graph.physicalDescs.emplace_back(slot.desc);
+			}
+
+			//one batch of transitions before every pass, the first use of an aliased allocation discards the old contents
+			std::vector<ResourceState> slotStates(slots.size(), ResourceState::Undefined);
+			std::vector<int64_t>       slotOwners(slots.size(), -1);
+
+			for (ResourceId resource = 0; resource < resourceCount; resource++)
+			{
+				if (resources[resource].imported)
+				{
+					slotStates[graph.physical[resource]] = resources[resource].initial;
+					slotOwners[graph.physical[resource]] = resource;
+				}
+			}
+
+			std::vector<std::pair<ResourceId, ResourceState>> states;
+			for (PassId pass = 0; pass < passCount; pass++)
+			{
+				if (graph.culled[pass])
+					continue;
+
+				//a resource accessed twice by one pass is used in the state of its write
+				states.clear();
+				for (auto &access : passes[pass].accesses)
+				{
+					auto iter = std::find_if(states.begin(), states.end(), [&](const auto &state) {
+						return state.first == access.resource;
+					});
+					if (iter == states.end())
+						states.emplace_back(access.resource, access.state);
+					else if (access.write)
+						iter->second = access.state;
+				}
+
+				for (auto &[resource, state] : states)
+				{
+					const auto slot   = graph.physical[resource];
+					const auto before = slotOwners[slot] == resource ? slotStates[slot] : ResourceState::Undefined;
+					if (before != state || slotOwners[slot] != resource)
+					{
+						graph.barriers[pass].push_back({resource, before, state});
+						graph.barrierCount++;
+					}
+					slotOwners[slot] = resource;
+					slotStates[slot] = state;
+				}
+			}
+
+			return graph;
+		}
+
+		auto getTextureSize(const TextureDesc &desc) -> uint64_t
+		{
+			return static_cast<uint64_t>(desc.width) * desc.height * getBytesPerPixel(desc.format);
+		}
+	}        // namespace frame_graph
+}        // namespace maple
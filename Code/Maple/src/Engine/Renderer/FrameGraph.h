@@ -0,0 +1,164 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "Engine/Core.h"
+#include "RHI/Definitions.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace maple
+{
+	namespace frame_graph
+	{
+		using ResourceId = uint32_t;
+		using PassId     = uint32_t;
+
+		constexpr int32_t  NoPhysical  = -1;
+		constexpr uint32_t AllFeatures = UINT32_MAX;
+
+		struct TextureDesc
+		{
+			uint32_t      width  = 0;
+			uint32_t      height = 0;
+			TextureFormat format = TextureFormat::RGBA8;
+
+			inline auto operator==(const TextureDesc &other) const
+			{
+				return width == other.width && height == other.height && format == other.format;
+			}
+		};
+
+		struct ResourceNode
+		{
+			std::string   name;
+			TextureDesc   desc;
+			bool          imported = false;        //lives across frames, never culled or aliased
+			ResourceState initial  = ResourceState::Undefined;
+		};
+
+		struct Access
+		{
+			ResourceId    resource;
+			ResourceState state;
+			bool          write;
+			uint32_t      features = 0;        //only accessed when these features are on
+		};
+
+		struct PassNode
+		{
+			std::string         name;
+			std::vector<Access> accesses;
+			bool                sideEffect = false;        //never culled, e.g. it presents or its results are read next frame
+			uint32_t            features   = 0;            //culled unless these features are on
+		};
+
+		struct Barrier
+		{
+			ResourceId    resource;
+			ResourceState before;        //Undefined when the memory is taken over from an aliased resource
+			ResourceState after;
+		};
+
+		struct CompiledGraph
+		{
+			std::vector<bool>                 culled;               //every pass
+			std::vector<std::vector<Barrier>> barriers;             //issued as one batch before every pass
+			std::vector<int32_t>              physical;             //every resource, NoPhysical if no live pass uses it
+			std::vector<TextureDesc>          physicalDescs;
+			std::vector<PassId>               firstUse;             //every resource
+			std::vector<PassId>               lastUse;
+			std::vector<ResourceId>           uninitialized;        //transient resources read before the first write
+
+			uint64_t transientBytes = 0;        //without aliasing
+			uint64_t allocatedBytes = 0;
+			uint32_t barrierCount   = 0;
+		};
+
+		/**
+		 * Passes are declared in execution order together with the textures they read and write.
+		 * compile() culls the passes whose results are never read, computes the lifetimes of the transient textures,
+		 * lets textures with the same description and disjoint lifetimes share one allocation and batches the
+		 * state transitions of every pass. It touches no GPU object.
+		 * Passes and reads can depend on features, bits the caller defines. compile() leaves out what needs a feature which is off.
+		 */
+		class MAPLE_EXPORT FrameGraph
+		{
+		  public:
+			class PassBuilder
+			{
+			  public:
+				PassBuilder(FrameGraph &graph, PassId pass) :
+				    graph(graph), pass(pass)
+				{}
+
+				auto read(ResourceId resource, ResourceState state = ResourceState::ShaderRead, uint32_t features = 0) -> PassBuilder &;
+				auto write(ResourceId resource, ResourceState state = ResourceState::ColorAttachment) -> PassBuilder &;
+				auto sideEffect() -> PassBuilder &;
+				auto require(uint32_t features) -> PassBuilder &;
+
+				inline auto getId() const
+				{
+					return pass;
+				}
+
+			  private:
+				FrameGraph &graph;
+				PassId      pass;
+			};
+
+			auto createTexture(const std::string &name, const TextureDesc &desc) -> ResourceId;
+			auto importTexture(const std::string &name, const TextureDesc &desc, ResourceState initial = ResourceState::ShaderRead) -> ResourceId;
+			auto addPass(const std::string &name) -> PassBuilder;
+
+			//change the description of a resource, e.g. on resize. Recompile afterwards
+			auto setDesc(ResourceId resource, const TextureDesc &desc) -> void;
+
+			//without aliasing every transient texture owns its allocation, the lifetimes and barriers are the same
+			auto compile(bool aliasing = true, uint32_t features = AllFeatures) const -> CompiledGraph;
+
+			auto clear() -> void;
+
+			inline auto &getResources() const
+			{
+				return resources;
+			}
+
+			inline auto &getPasses() const
+			{
+				return passes;
+			}
+
+		  private:
+			std::vector<ResourceNode> resources;
+			std::vector<PassNode>     passes;
+		};
+
+		//bytes of one texture, three channel formats are padded to four as the backends do
+		auto MAPLE_EXPORT getTextureSize(const TextureDesc &desc) -> uint64_t;
+	}        // namespace frame_graph
+
+	namespace frame_feature
+	{
+		//renderer features passes depend on, the graph is recompiled when one is turned on or off
+		enum Id : uint32_t
+		{
+			SSR   = 1 << 0,
+			Bloom = 1 << 1,
+			VXGI  = 1 << 2
+		};
+	}        // namespace frame_feature
+
+	namespace component
+	{
+		//passes and GBuffer textures of the renderer, declared by the systems registered for them
+		struct FrameGraphData
+		{
+			frame_graph::FrameGraph    graph;
+			frame_graph::CompiledGraph compiled;
+			uint32_t                   features = frame_graph::AllFeatures;        //the features compiled is for
+		};
+	}        // namespace component
+}        // namespace maple
@@ -0,0 +1,430 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+#include "GPUCulling.h"
+#include "InstanceBuffer.h"
+#include "Renderer.h"
+#include "RendererData.h"
+#include "ShadowRenderer.h"
+
+#include "RHI/DescriptorSet.h"
+#include "RHI/GraphicsContext.h"
+#include "RHI/Pipeline.h"
+#include "RHI/Shader.h"
+#include "RHI/StorageBuffer.h"
+#include "RHI/SwapChain.h"
+
+#include "Scene/Component/Component.h"
+#include "Scene/Component/MeshRenderer.h"
+#include "Scene/Component/Transform.h"
+#include "Scene/Entity/Entity.h"
+
+#include "Engine/CaptureGraph.h"
+#include "Engine/Material.h"
+#include "Engine/Mesh.h"
+#include "Engine/Profiler.h"
+#include "Math/Frustum.h"
+#include "Math/FrustumCulling.h"
+#include "Others/Console.h"
+
+#include "Application.h"
+
+#include <algorithm>
+#include <cstring>
+#include <ecs/ecs.h>
+
+namespace maple
+{
+	namespace gpu_culling
+	{
+		namespace
+		{
+			//same as UniformBufferObject in CullInstances.comp
+			struct CullUniforms
+			{
+				glm::vec4 planes[MaxViews * 6];
+				uint32_t  instanceCount;
+				uint32_t  viewCount;
+				uint32_t  commandCount;
+				uint32_t  padding;
+			};
+
+			inline auto entityId(entt::entity entity)
+			{
+				return static_cast<size_t>(entt::to_integral(entity) & entt::entt_traits<entt::entity>::entity_mask);
+			}
+
+			//the local box is moved to world space with the absolute matrix, the same as CullingBatch::add
+			inline auto setTransform(GPUInstance &instance, const BoundingBox &localBox, const glm::mat4 &transform)
+			{
+				const auto edge    = localBox.size() * 0.5f;
+				instance.transform = transform;
+				instance.center    = transform * glm::vec4(localBox.center(), 1.f);
+				instance.extent    = glm::vec4(glm::abs(glm::vec3(transform[0])) * edge.x + glm::abs(glm::vec3(transform[1])) * edge.y + glm::abs(glm::vec3(transform[2])) * edge.z, 0.f);
+			}
+
+			inline auto markDirty(component::GPUCullingData &data, uint32_t instance)
+			{
+				for (auto &frame : data.frames)
+				{
+					if (!frame.full)
+						frame.dirty.emplace_back(instance);
+				}
+			}
+
+			//transparent and outlined meshes need the sorted CPU path, as do the compressed ones for their quantization
+			inline auto isEligible(const component::MeshRenderer &mesh, bool hasStencil)
+			{
+				if (mesh.mesh == nullptr || !mesh.mesh->isActive() || hasStencil || mesh.mesh->isCompressed())
+					return false;
+
+				if (mesh.mesh->getBoundingBox() == nullptr || !mesh.mesh->getBoundingBox()->isDefined())
+					return false;
+
+				for (auto &material : mesh.mesh->getMaterial())
+				{
+					if (material != nullptr && material->isFlagOf(Material::RenderFlags::AlphaBlend))
+						return false;
+				}
+				return true;
+			}
+
+			inline auto createBuffer(uint32_t size, bool indirect, MemoryUsage usage)
+			{
+				return StorageBuffer::create(size, nullptr, BufferOptions{indirect, (uint32_t) usage, 0});
+			}
+
+			//the counts of the last use of this frame are complete once its command buffer is reused
+			inline auto validate(component::GPUCullingData &data, component::GPUCullingData::FrameResources &frame)
+			{
+				PROFILE_FUNCTION();
+				if (frame.reference.empty() || frame.args == nullptr)
+					return;
+
+				const auto *commands = static_cast<const DrawIndexedIndirectCommand *>(frame.args->map());
+				data.mismatches      = 0;
+				for (uint32_t i = 0; i < frame.reference.size(); i++)
+				{
+					if (commands[i].instanceCount != frame.reference[i])
+						data.mismatches++;
+				}
+				frame.args->unmap();
+				frame.reference.clear();
+
+				if (data.mismatches != 0)
+					LOGW("GPU culling : {0} indirect commands differ from the CPU reference", data.mismatches);
+			}
+
+			inline auto upload(component::GPUCullingData &data, component::GPUCullingData::FrameResources &frame)
+			{
+				PROFILE_FUNCTION();
+				const auto instanceCount = static_cast<uint32_t>(data.instances.size());
+				const auto batchCount    = static_cast<uint32_t>(data.batches.size());
+				const auto commandCount  = static_cast<uint32_t>(data.commands.size());
+
+				if (frame.instanceCapacity < instanceCount)
+				{
+					frame.instanceCapacity  = std::max(instanceCount, frame.instanceCapacity * 2);
+					frame.instances         = createBuffer(sizeof(GPUInstance) * frame.instanceCapacity, false, MemoryUsage::MEMORY_USAGE_CPU_TO_GPU);
+					frame.visibleInstances  = createBuffer(sizeof(InstanceData) * frame.instanceCapacity, false, MemoryUsage::MEMORY_USAGE_GPU_ONLY);
+					frame.visibleTransforms = createBuffer(sizeof(glm::mat4) * frame.instanceCapacity * SHADOWMAP_MAX, false, MemoryUsage::MEMORY_USAGE_GPU_ONLY);
+					frame.full              = true;
+				}
+
+				if (frame.batchCapacity < batchCount)
+				{
+					frame.batchCapacity = std::max(batchCount, frame.batchCapacity * 2);
+					frame.batches       = createBuffer(sizeof(Batch) * frame.batchCapacity, false, MemoryUsage::MEMORY_USAGE_CPU_TO_GPU);
+					frame.full          = true;
+				}
+
+				if (frame.commandCapacity < commandCount)
+				{
+					frame.commandCapacity = std::max(commandCount, frame.commandCapacity * 2);
+					frame.args            = createBuffer(sizeof(DrawIndexedIndirectCommand) * frame.commandCapacity, true, MemoryUsage::MEMORY_USAGE_CPU_TO_GPU);
+				}
+
+				if (frame.full)
+				{
+					frame.instances->setData(sizeof(GPUInstance) * instanceCount, data.instances.data());
+					frame.batches->setData(sizeof(Batch) * batchCount, data.batches.data());
+					frame.full = false;
+					frame.dirty.clear();
+				}
+				else if (!frame.dirty.empty())
+				{
+					auto *instances = static_cast<GPUInstance *>(frame.instances->map());
+					for (auto instance : frame.dirty)
+						instances[instance] = data.instances[instance];
+					frame.instances->unmap();
+					frame.dirty.clear();
+				}
+
+				//the culling pass only increments the instance counts
+				frame.args->setData(sizeof(DrawIndexedIndirectCommand) * commandCount, data.commands.data());
+			}
+		}        // namespace
+
+		auto cullReference(const component::GPUCullingData &data, const Frustum *views, uint32_t viewCount, std::vector<uint32_t> &instanceCounts) -> void
+		{
+			PROFILE_FUNCTION();
+			const auto count        = static_cast<uint32_t>(data.instances.size());
+			const auto commandCount = static_cast<uint32_t>(data.commands.size()) / MaxViews;
+
+			std::vector<float> centerX(count), centerY(count), centerZ(count);
+			std::vector<float> extentX(count), extentY(count), extentZ(count);
+			for (uint32_t i = 0; i < count; i++)
+			{
+				const auto &instance = data.instances[i];
+				centerX[i]           = instance.center.x;
+				centerY[i]           = instance.center.y;
+				centerZ[i]           = instance.center.z;
+				extentX[i]           = instance.extent.x;
+				extentY[i]           = instance.extent.y;
+				extentZ[i]           = instance.extent.z;
+			}
+
+			instanceCounts.assign(viewCount * commandCount, 0);
+			std::vector<uint64_t> visibility((count + 63) / 64);
+
+			for (uint32_t view = 0; view < viewCount; view++)
+			{
+				frustum_culling::cullScalar(views[view],
+				                            centerX.data(), centerY.data(), centerZ.data(),
+				                            extentX.data(), extentY.data(), extentZ.data(),
+				                            count, visibility.data());
+
+				for (uint32_t i = 0; i < count; i++)
+				{
+					if ((visibility[i >> 6] & (uint64_t(1) << (i & 63))) == 0)
+						continue;
+
+					const auto &instance = data.instances[i];
+					if (view > 0 && (instance.info.y & CastShadow) == 0)
+						continue;
+
+					const auto &batch = data.batches[instance.info.x];
+					for (uint32_t c = 0; c < batch.commandCount; c++)
+						instanceCounts[view * commandCount + batch.firstCommand + c]++;
+				}
+			}
+		}
+
+		namespace update_scene
+		{
+			using MeshQuery = ecs::Registry ::Fetch<component::MeshRenderer>::Fetch<component::Transform>::OptinalFetch<component::StencilComponent>::To<ecs::Group>;
+
+			inline auto rebuild(component::GPUCullingData &data, MeshQuery meshQuery)
+			{
+				PROFILE_FUNCTION();
+				std::vector<std::pair<Mesh *, entt::entity>> candidates;
+				for (auto entity : meshQuery)
+				{
+					auto [mesh, trans] = meshQuery.convert(entity);
+					if (isEligible(mesh, meshQuery.hasComponent<component::StencilComponent>(entity)))
+						candidates.emplace_back(mesh.mesh.get(), entity);
+				}
+
+				//instances of the same mesh are contiguous, so one batch draws all of them
+				std::sort(candidates.begin(), candidates.end(), [](const auto &left, const auto &right) {
+					return left.first < right.first;
+				});
+
+				data.instances.clear();
+				data.entities.clear();
+				data.moved.clear();
+				data.meshes.clear();
+				data.batches.clear();
+				data.commands.clear();
+				std::fill(data.slots.begin(), data.slots.end(), -1);
+
+				for (auto [meshPtr, entity] : candidates)
+				{
+					auto [mesh, trans] = meshQuery.convert(entity);
+
+					if (data.meshes.empty() || data.meshes.back() != meshPtr)
+					{
+						const auto &indices = meshPtr->getSubMeshIndex();
+						data.batches.push_back({static_cast<uint32_t>(data.commands.size()), static_cast<uint32_t>(indices.size()), static_cast<uint32_t>(data.instances.size()), 0});
+						data.meshes.emplace_back(meshPtr);
+
+						uint32_t start = 0;
+						for (auto end : indices)
+						{
+							data.commands.push_back({end - start, 0, start, 0, 0});
+							start = end;
+						}
+					}
+					data.batches.back().instanceCount++;
+
+					const auto id = entityId(entity);
+					if (id >= data.slots.size())
+						data.slots.resize(id + 1, -1);
+					data.slots[id] = static_cast<int32_t>(data.instances.size());
+
+					auto &instance = data.instances.emplace_back();
+					setTransform(instance, *meshPtr->getBoundingBox(), trans.getWorldMatrix());
+					instance.prevTransform = instance.transform;
+					instance.info          = {static_cast<uint32_t>(data.batches.size() - 1), mesh.castShadow && mesh.active ? CastShadow : 0, 0, 0};
+					data.entities.emplace_back(entity);
+				}
+
+				//every view has its own copy of the commands
+				const auto commandCount = data.commands.size();
+				for (uint32_t view = 1; view < MaxViews; view++)
+				{
+					data.commands.insert(data.commands.end(), data.commands.begin(), data.commands.begin() + commandCount);
+				}
+
+				for (auto &frame : data.frames)
+				{
+					frame.full = true;
+					frame.dirty.clear();
+					frame.reference.clear();
+				}
+				data.rebuild = false;
+			}
+
+			inline auto system(component::GPUCullingData &data, const global::component::SceneTransformChanged &changed, MeshQuery meshQuery, ecs::World world)
+			{
+				if (!data.enable)
+				{
+					data.rebuild = true;
+					return;
+				}
+
+				if (data.rebuild)
+				{
+					rebuild(data, meshQuery);
+					return;
+				}
+
+				//the instances moved in the last frame have no motion anymore
+				std::vector<uint32_t> moved;
+				std::swap(moved, data.moved);
+				for (auto instance : moved)
+				{
+					data.instances[instance].prevTransform = data.instances[instance].transform;
+					markDirty(data, instance);
+				}
+
+				auto &registry = world.getRegistry();
+				for (auto entity : changed.entities)
+				{
+					const auto id = entityId(entity);
+					if (id >= data.slots.size() || data.slots[id] < 0 || !registry.valid(entity))
+						continue;
+
+					const auto slot  = static_cast<uint32_t>(data.slots[id]);
+					auto &     trans = registry.get<component::Transform>(entity);
+					auto &     mesh  = registry.get<component::MeshRenderer>(entity);
+
+					auto &instance         = data.instances[slot];
+					instance.prevTransform = instance.transform;
+					setTransform(instance, *mesh.mesh->getBoundingBox(), trans.getWorldMatrix());
+					markDirty(data, slot);
+					data.moved.emplace_back(slot);
+				}
+			}
+		}        // namespace update_scene
+
+		namespace cull_instances
+		{
+			using Entity = ecs::Registry ::Modify<component::GPUCullingData>::Fetch<component::ShadowMapData>::Fetch<component::CameraView>::Fetch<component::RendererData>::Modify<capture_graph::component::RenderGraph>::To<ecs::Entity>;
+
+			inline auto system(Entity entity, ecs::World world)
+			{
+				auto [data, shadowData, cameraView, renderData, graph] = entity;
+				data.ready                                             = false;
+
+				if (!data.enable || data.instances.empty())
+					return;
+
+				auto       swapChain = Application::getGraphicsContext()->getSwapChain();
+				const auto frames    = swapChain->getSwapChainBufferCount();
+				if (data.frames.size() != frames)
+					data.frames.resize(frames);
+
+				auto &frame = data.frames[swapChain->getCurrentBufferIndex()];
+
+				if (data.validate)
+					validate(data, frame);
+
+				upload(data, frame);
+
+				Frustum views[MaxViews];
+				views[0]             = cameraView.frustum;
+				const auto viewCount = 1 + std::min<uint32_t>(shadowData.shadowMapNum, SHADOWMAP_MAX);
+				for (uint32_t i = 1; i < viewCount; i++)
+				{
+					views[i] = shadowData.cascadeFrustums[i - 1];
+				}
+
+				CullUniforms uniforms{};
+				for (uint32_t view = 0; view < viewCount; view++)
+				{
+					for (int32_t i = 0; i < 6; i++)
+					{
+						const auto &plane             = views[view].getPlane(i);
+						uniforms.planes[view * 6 + i] = glm::vec4(plane.getNormal(), plane.getDistance());
+					}
+				}
+				uniforms.instanceCount = static_cast<uint32_t>(data.instances.size());
+				uniforms.viewCount     = viewCount;
+				uniforms.commandCount  = static_cast<uint32_t>(data.commands.size()) / MaxViews;
+
+				data.descriptorSet->setUniformBufferData("UniformBufferObject", &uniforms);
+				data.descriptorSet->setStorageBuffer("Instances", frame.instances);
+				data.descriptorSet->setStorageBuffer("Batches", frame.batches);
+				data.descriptorSet->setStorageBuffer("DrawCommands", frame.args);
+				data.descriptorSet->setStorageBuffer("VisibleInstances", frame.visibleInstances);
+				data.descriptorSet->setStorageBuffer("VisibleTransforms", frame.visibleTransforms);
+				data.descriptorSet->update(renderData.commandBuffer);
+
+				PipelineInfo pipelineInfo;
+				pipelineInfo.shader       = data.cullShader;
+				pipelineInfo.pipelineName = "GPUCulling";
+
+				auto pipeline = Pipeline::get(pipelineInfo, {data.descriptorSet}, graph);
+				pipeline->bind(renderData.commandBuffer);
+				Renderer::bindDescriptorSets(pipeline.get(), renderData.commandBuffer, 0, {data.descriptorSet});
+				Renderer::dispatch(renderData.commandBuffer,
+				                   (uniforms.instanceCount + data.cullShader->getLocalSizeX() - 1) / data.cullShader->getLocalSizeX(),
+				                   viewCount, 1);
+				//the counts are read as draw arguments and by validate
+				Renderer::memoryBarrier(renderData.commandBuffer, MemoryBarrierFlags::Shader_Storage_Barrier | MemoryBarrierFlags::Indirect_Command_Barrier);
+				pipeline->end(renderData.commandBuffer);
+
+				if (data.validate)
+				{
+					cullReference(data, views, viewCount, frame.reference);
+				}
+
+				data.args              = frame.args;
+				data.visibleInstances  = frame.visibleInstances;
+				data.visibleTransforms = frame.visibleTransforms;
+				data.ready             = true;
+			}
+		}        // namespace cull_instances
+
+		inline auto onMeshChanged(component::MeshRenderer &mesh, Entity entity, ecs::World world) -> void
+		{
+			world.getComponent<component::GPUCullingData>().rebuild = true;
+		}
+
+		auto registerGPUCulling(ExecuteQueue &begin, ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint) -> void
+		{
+			executePoint->registerGlobalComponent<component::GPUCullingData>([](component::GPUCullingData &data) {
+				data.cullShader    = Shader::create("shaders/GPUCulling/CullInstances.shader");
+				data.descriptorSet = DescriptorSet::create({0, data.cullShader.get()});
+			});
+
+			executePoint->onConstruct<component::MeshRenderer, &onMeshChanged>();
+			executePoint->onUpdate<component::MeshRenderer, &onMeshChanged>();
+			executePoint->onDestory<component::MeshRenderer, &onMeshChanged>();
+
+			executePoint->registerWithinQueue<update_scene::system>(begin);
+			executePoint->registerWithinQueue<cull_instances::system>(renderer);
+		}
+	}        // namespace gpu_culling
+}        // namespace maple
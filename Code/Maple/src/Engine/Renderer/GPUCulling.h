@@ -0,0 +1,131 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "Engine/Core.h"
+#include "RHI/Definitions.h"
+#include "Scene/System/ExecutePoint.h"
+
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <memory>
+#include <vector>
+
+namespace maple
+{
+	class Frustum;
+	class StorageBuffer;
+
+	namespace gpu_culling
+	{
+		//view 0 is the camera, view 1 + i is the shadow cascade i. CullInstances.comp gets SHADOWMAP_MAX from the build
+		constexpr uint32_t MaxViews = 1 + SHADOWMAP_MAX;
+
+		enum InstanceFlags : uint32_t
+		{
+			CastShadow = 1
+		};
+
+		//same layouts as CullInstances.comp
+		struct GPUInstance
+		{
+			glm::mat4  transform;
+			glm::mat4  prevTransform;
+			glm::vec4  center;        //world space box
+			glm::vec4  extent;
+			glm::uvec4 info;        //x : batch, y : InstanceFlags
+		};
+
+		//all instances of one mesh, every sub mesh is one indirect command
+		struct Batch
+		{
+			uint32_t firstCommand;
+			uint32_t commandCount;
+			uint32_t firstInstance;
+			uint32_t instanceCount;
+		};
+
+		//VkDrawIndexedIndirectCommand
+		struct DrawIndexedIndirectCommand
+		{
+			uint32_t indexCount;
+			uint32_t instanceCount;
+			uint32_t firstIndex;
+			int32_t  vertexOffset;
+			uint32_t firstInstance;
+		};
+	}        // namespace gpu_culling
+
+	namespace component
+	{
+		/**
+		 * Static opaque meshes culled by a compute pass, the G-buffer and the shadow cascades draw them with indirect draws.
+		 * The instances live in persistent storage buffers which are only patched for the entities in SceneTransformChanged,
+		 * meshes with a stencil outline, transparent materials and skinned meshes stay on the CPU path.
+		 */
+		struct GPUCullingData
+		{
+			bool enable   = false;
+			bool validate = false;        //read the results back and compare them with gpu_culling::cullReference
+
+			uint32_t mismatches = 0;        //commands whose instance count differs from the reference, last validated frame
+
+			//persistent scene, rebuilt when a MeshRenderer is added, changed or removed
+			bool                                                 rebuild = true;
+			std::vector<gpu_culling::GPUInstance>                instances;        //sorted by batch
+			std::vector<entt::entity>                            entities;         //entity of every instance
+			std::vector<int32_t>                                 slots;            //instance of every entity id, -1 for the CPU path
+			std::vector<uint32_t>                                moved;            //instances whose prevTransform has to catch up next frame
+			std::vector<Mesh *>                                  meshes;           //mesh of every batch
+			std::vector<gpu_culling::Batch>                      batches;
+			std::vector<gpu_culling::DrawIndexedIndirectCommand> commands;        //MaxViews copies of the commands with zero instances
+
+			struct FrameResources
+			{
+				std::shared_ptr<StorageBuffer> instances;
+				std::shared_ptr<StorageBuffer> batches;
+				std::shared_ptr<StorageBuffer> args;
+				std::shared_ptr<StorageBuffer> visibleInstances;         //InstanceData of the camera view
+				std::shared_ptr<StorageBuffer> visibleTransforms;        //transforms of the cascades, instances.size() per cascade
+				uint32_t                       instanceCapacity = 0;
+				uint32_t                       batchCapacity    = 0;
+				uint32_t                       commandCapacity  = 0;
+				bool                           full             = true;        //rewrite all instances
+				std::vector<uint32_t>          dirty;                           //instances changed since this frame was written
+				std::vector<uint32_t>          reference;                       //cullReference of the args recorded with this frame
+			};
+
+			std::vector<FrameResources> frames;
+
+			//outputs of the current frame, valid when ready is set
+			bool                           ready = false;
+			std::shared_ptr<StorageBuffer> args;
+			std::shared_ptr<StorageBuffer> visibleInstances;
+			std::shared_ptr<StorageBuffer> visibleTransforms;
+
+			std::shared_ptr<Shader>        cullShader;
+			std::shared_ptr<DescriptorSet> descriptorSet;
+		};
+	}        // namespace component
+
+	namespace gpu_culling
+	{
+		inline auto isGPUDriven(const component::GPUCullingData &data, entt::entity entity)
+		{
+			const auto id = static_cast<size_t>(entt::to_integral(entity) & entt::entt_traits<entt::entity>::entity_mask);
+			return data.enable && id < data.slots.size() && data.slots[id] >= 0;
+		}
+
+		//byte offset of the indirect command of a sub mesh of a batch
+		inline auto getArgsOffset(const component::GPUCullingData &data, uint32_t view, uint32_t batch, uint32_t subMesh)
+		{
+			const auto commandCount = static_cast<uint32_t>(data.commands.size()) / MaxViews;
+			return (view * commandCount + data.batches[batch].firstCommand + subMesh) * static_cast<uint32_t>(sizeof(DrawIndexedIndirectCommand));
+		}
+
+		//CPU reference of CullInstances.comp, instanceCounts holds the instance count of every command of every view
+		auto MAPLE_EXPORT cullReference(const component::GPUCullingData &data, const Frustum *views, uint32_t viewCount, std::vector<uint32_t> &instanceCounts) -> void;
+
+		auto registerGPUCulling(ExecuteQueue &begin, ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint) -> void;
+	}        // namespace gpu_culling
+}        // namespace maple
@@ -25,6 +25,7 @@
 #define _USE_MATH_DEFINES
 #include <math.h>
 
+#include <algorithm>
 #include <ecs/ecs.h>
 
 namespace maple
@@ -84,6 +85,8 @@ namespace maple
 
 			std::vector<std::shared_ptr<DescriptorSet>> pointDescriptorSet;
 			std::vector<std::shared_ptr<DescriptorSet>> lineDescriptorSet;
+			UniformHandle                               pointProjView;
+			UniformHandle                               lineProjView;
 
 			LineVertex * lineBuffer  = nullptr;
 			PointVertex *pointBuffer = nullptr;
@@ -106,8 +109,9 @@ namespace maple
 					descriptorInfo.layoutIndex = 0;
 					descriptorInfo.shader      = pointShader.get();
 					pointDescriptorSet.emplace_back(DescriptorSet::create(descriptorInfo));
+					pointProjView = pointDescriptorSet[0]->getUniformHandle(UniformId("UniformBufferObject", "projView"));
 
-					pointVertexBuffers = VertexBuffer::create(BufferUsage::Dynamic);
+					pointVertexBuffers = VertexBuffer::create(BufferUsage::Stream);
 					pointVertexBuffers->resize(RendererPointBufferSize);
 
 					std::vector<uint32_t> indices;
@@ -131,8 +135,9 @@ namespace maple
 					descriptorLineInfo.layoutIndex = 0;
 					descriptorLineInfo.shader      = lineShader.get();
 					lineDescriptorSet.emplace_back(DescriptorSet::create(descriptorLineInfo));
+					lineProjView = lineDescriptorSet[0]->getUniformHandle(UniformId("UniformBufferObject", "projView"));
 
-					lineVertexBuffers = VertexBuffer::create(BufferUsage::Dynamic);
+					lineVertexBuffers = VertexBuffer::create(BufferUsage::Stream);
 					lineVertexBuffers->resize(RendererLineBufferSize);
 
 					std::vector<uint32_t> indices;
@@ -351,8 +356,8 @@ namespace maple
 		inline auto system(Entity entity, ecs::World world)
 		{
 			auto [render, geometry, cameraView] = entity;
-			geometry.lineDescriptorSet[0]->setUniform("UniformBufferObject", "projView", &cameraView.projView);
-			geometry.pointDescriptorSet[0]->setUniform("UniformBufferObject", "projView", &cameraView.projView);
+			geometry.lineDescriptorSet[0]->setUniform(geometry.lineProjView, &cameraView.projView);
+			geometry.pointDescriptorSet[0]->setUniform(geometry.pointProjView, &cameraView.projView);
 		}
 	}        // namespace on_begin_scene
 
@@ -382,7 +387,7 @@ namespace maple
 				auto pipeline = Pipeline::get(pipelineInfo, geometry.lineDescriptorSet, graph);
 
 				pipeline->bind(commandBuffer);
-				geometry.lineVertexBuffers->bind(commandBuffer, pipeline.get());
+				geometry.lineVertexBuffers->resize(std::min<uint32_t>(geometry.lines.size() * 2 * sizeof(LineVertex), RendererLineBufferSize));
 				geometry.lineBuffer = geometry.lineVertexBuffers->getPointer<LineVertex>();
 
 				for (auto &line : geometry.lines)
@@ -439,7 +444,7 @@ namespace maple
 				auto pipeline = Pipeline::get(pipelineInfo, geometry.pointDescriptorSet, graph);
 
 				pipeline->bind(commandBuffer);
-				geometry.pointVertexBuffers->bind(commandBuffer, pipeline.get());
+				geometry.pointVertexBuffers->resize(std::min<uint32_t>(geometry.points.size() * RendererPointSize, RendererPointBufferSize));
 				geometry.pointBuffer = geometry.pointVertexBuffers->getPointer<PointVertex>();
 
 				for (auto &pointInfo : geometry.points)
@@ -476,6 +481,7 @@ namespace maple
 
 				geometry.pointVertexBuffers->releasePointer();
 				geometry.pointIndexBuffer->setCount(geometry.pointIndexCount);
+				geometry.pointVertexBuffers->bind(commandBuffer, pipeline.get());
 				geometry.pointIndexBuffer->bind(commandBuffer);
 
 				Renderer::bindDescriptorSets(pipeline.get(), commandBuffer, 0, geometry.pointDescriptorSet);
@@ -497,8 +503,9 @@ namespace maple
 
 	namespace geometry_renderer
 	{
-		auto registerGeometryRenderer(ExecuteQueue &begin, ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint) -> void
+		auto registerGeometryRenderer(ExecuteQueue &begin, ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint, frame_graph::FrameGraph::PassBuilder pass) -> void
 		{
+			pass.write(GBufferTextures::SCREEN);
 			executePoint->registerGlobalComponent<component::GeometryRenderData>();
 			executePoint->registerWithinQueue<on_begin_scene::system>(begin);
 			executePoint->registerWithinQueue<on_render_lines::systemLines>(renderer);
@@ -7,6 +7,7 @@
 #include <memory>
 
 #include "Engine/Core.h"
+#include "FrameGraph.h"
 #include "Math/Frustum.h"
 #include "Scene/System/ExecutePoint.h"
 
@@ -21,7 +22,7 @@ namespace maple
 
 	namespace geometry_renderer
 	{
-		auto registerGeometryRenderer(ExecuteQueue &begin, ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint) -> void;
+		auto registerGeometryRenderer(ExecuteQueue &begin, ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint, frame_graph::FrameGraph::PassBuilder pass) -> void;
 	}
 
 	namespace GeometryRenderer
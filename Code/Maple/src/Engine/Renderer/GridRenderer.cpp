@@ -42,6 +42,8 @@ namespace maple
 			std::shared_ptr<Mesh>          quad;
 			std::shared_ptr<Shader>        gridShader;
 			std::shared_ptr<DescriptorSet> descriptorSet;
+			UniformHandle                  proj;
+			UniformHandle                  view;
 
 			struct UniformBufferObject
 			{
@@ -57,6 +59,8 @@ namespace maple
 				gridShader    = Shader::create("shaders/Grid.shader");
 				quad          = Mesh::createQuad();
 				descriptorSet = DescriptorSet::create({0, gridShader.get()});
+				proj          = descriptorSet->getUniformHandle(UniformId("UniformBufferObject", "proj"));
+				view          = descriptorSet->getUniformHandle(UniformId("UniformBufferObject", "view"));
 			}
 		};
 	}        // namespace component
@@ -70,8 +74,8 @@ namespace maple
 			auto [render, grid, camera] = entity;
 			if (camera.cameraTransform != nullptr)
 			{
-				grid.descriptorSet->setUniform("UniformBufferObject", "proj", glm::value_ptr(camera.proj));
-				grid.descriptorSet->setUniform("UniformBufferObject", "view", glm::value_ptr(camera.view));
+				grid.descriptorSet->setUniform(grid.proj, glm::value_ptr(camera.proj));
+				grid.descriptorSet->setUniform(grid.view, glm::value_ptr(camera.view));
 				grid.systemBuffer.cameraPos = glm::vec4(camera.cameraTransform->getWorldPosition(), 1.f);
 				grid.systemBuffer.near_     = camera.nearPlane;
 				grid.systemBuffer.far_      = camera.farPlane;
@@ -112,8 +116,9 @@ namespace maple
 
 	namespace grid_renderer
 	{
-		auto registerGridRenderer(ExecuteQueue &begin, ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint) -> void
+		auto registerGridRenderer(ExecuteQueue &begin, ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint, frame_graph::FrameGraph::PassBuilder pass) -> void
 		{
+			pass.write(GBufferTextures::SCREEN);
 			executePoint->registerGlobalComponent<component::GridData>();
 			executePoint->registerGlobalComponent<component::GridRender>();
 			executePoint->registerWithinQueue<on_begin::system>(begin);
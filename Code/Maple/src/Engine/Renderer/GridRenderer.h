@@ -2,6 +2,7 @@
 // This file is part of the Maple Engine                              		//
 //////////////////////////////////////////////////////////////////////////////
 #pragma once
+#include "FrameGraph.h"
 #include "Scene/System/ExecutePoint.h"
 #include <memory>
 
@@ -19,6 +20,6 @@ namespace maple
 
 	namespace grid_renderer
 	{
-		auto registerGridRenderer(ExecuteQueue &begin, ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint) -> void;
+		auto registerGridRenderer(ExecuteQueue &begin, ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint, frame_graph::FrameGraph::PassBuilder pass) -> void;
 	};
 };        // namespace maple
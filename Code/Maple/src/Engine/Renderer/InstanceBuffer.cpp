@@ -0,0 +1,49 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+#include "InstanceBuffer.h"
+#include "Engine/Profiler.h"
+#include "RHI/GraphicsContext.h"
+#include "RHI/StorageBuffer.h"
+#include "RHI/SwapChain.h"
+
+#include "Application.h"
+
+#include <algorithm>
+
+namespace maple
+{
+	namespace
+	{
+		constexpr uint32_t MinCapacity = 1024 * sizeof(InstanceData);
+	}        // namespace
+
+	auto InstanceBuffer::upload(const void *data, uint32_t size) -> std::shared_ptr<StorageBuffer>
+	{
+		PROFILE_FUNCTION();
+		auto swapChain = Application::getGraphicsContext()->getSwapChain();
+
+		const auto frames = static_cast<uint32_t>(swapChain->getSwapChainBufferCount());
+		if (buffers.size() != frames)
+		{
+			buffers.assign(frames, nullptr);
+			capacities.assign(frames, 0);
+		}
+
+		const auto frame = swapChain->getCurrentBufferIndex();
+		if (buffers[frame] == nullptr || capacities[frame] < size)
+		{
+			auto capacity = std::max(capacities[frame], MinCapacity);
+			while (capacity < size)
+				capacity *= 2;
+
+			buffers[frame]    = StorageBuffer::create(capacity, nullptr, BufferOptions{false, (int32_t) MemoryUsage::MEMORY_USAGE_CPU_TO_GPU, 0});
+			capacities[frame] = capacity;
+		}
+
+		if (size > 0)
+			buffers[frame]->setData(size, data);
+
+		return buffers[frame];
+	}
+};        // namespace maple
@@ -0,0 +1,37 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "Engine/Core.h"
+
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <memory>
+#include <vector>
+
+namespace maple
+{
+	class StorageBuffer;
+
+	//same layout as InstanceData in DeferredColor.vert
+	struct InstanceData
+	{
+		glm::mat4 transform;
+		glm::mat4 prevTransform;        //world matrix of the last frame, used for velocity
+	};
+
+	/**
+	 * Storage buffer for the per instance data of the instanced draws, written once per frame.
+	 * Every frame in flight owns one buffer so the data used by the GPU is never overwritten, buffers only grow.
+	 */
+	class MAPLE_EXPORT InstanceBuffer
+	{
+	  public:
+		//copy size bytes into the buffer of the current frame and return it, a buffer is returned even if size is zero
+		auto upload(const void *data, uint32_t size) -> std::shared_ptr<StorageBuffer>;
+
+	  private:
+		std::vector<std::shared_ptr<StorageBuffer>> buffers;
+		std::vector<uint32_t>                       capacities;
+	};
+};        // namespace maple
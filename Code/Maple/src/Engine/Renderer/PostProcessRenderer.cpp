@@ -70,8 +70,8 @@ namespace maple
 			descriptorSet->setTexture("uViewPositionSampler", renderData.gbuffer->getBuffer(GBufferTextures::VIEW_POSITION));
 			descriptorSet->setTexture("uViewNormalSampler", renderData.gbuffer->getBuffer(GBufferTextures::VIEW_NORMALS));
 			descriptorSet->setTexture("uSsaoNoise", renderData.gbuffer->getSSAONoise());
-			descriptorSet->setUniform("UBO", "ssaoRadius", &ssaoData.ssaoRadius);
-			descriptorSet->setUniform("UBO", "projection", &camera.proj);
+			descriptorSet->setUniform(ssaoData.radius, &ssaoData.ssaoRadius);
+			descriptorSet->setUniform(ssaoData.projection, &camera.proj);
 			descriptorSet->update(renderData.commandBuffer);
 
 			auto commandBuffer = renderData.commandBuffer;
@@ -251,9 +251,9 @@ namespace maple
 
 				auto commandBuffer = render.commandBuffer;
 
-				bloomData.bloomDescriptorSet->setUniform("UBO", "dir", &dir);
-				bloomData.bloomDescriptorSet->setUniform("UBO", "blurScale", &bloomData.blurScale);
-				bloomData.bloomDescriptorSet->setUniform("UBO", "blurStrength", &bloomData.blurStrength);
+				bloomData.bloomDescriptorSet->setUniform(bloomData.dir, &dir);
+				bloomData.bloomDescriptorSet->setUniform(bloomData.scale, &bloomData.blurScale);
+				bloomData.bloomDescriptorSet->setUniform(bloomData.strength, &bloomData.blurStrength);
 				bloomData.bloomDescriptorSet->update(commandBuffer);
 
 				PipelineInfo pipeInfo;
@@ -287,8 +287,12 @@ namespace maple
 
 	namespace post_process
 	{
-		auto registerSSAOPass(ExecuteQueue &begin, ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint) -> void
+		auto registerSSAOPass(ExecuteQueue &begin, ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint, frame_graph::FrameGraph::PassBuilder pass) -> void
 		{
+			pass.read(GBufferTextures::VIEW_POSITION)
+			    .read(GBufferTextures::VIEW_NORMALS)
+			    .write(GBufferTextures::SSAO_SCREEN);
+
 			executePoint->registerGlobalComponent<component::SSAOData>([](auto &ssao) {
 				ssao.ssaoShader     = Shader::create("shaders/SSAO.shader");
 				ssao.ssaoBlurShader = Shader::create("shaders/SSAOBlur.shader");
@@ -305,15 +309,30 @@ namespace maple
 				info.layoutIndex    = 0;
 				ssao.ssaoBlurSet[0] = DescriptorSet::create(info);
 
+				ssao.radius     = ssao.ssaoSet[0]->getUniformHandle(UniformId("UBO", "ssaoRadius"));
+				ssao.projection = ssao.ssaoSet[0]->getUniformHandle(UniformId("UBO", "projection"));
+
 				auto ssaoKernel2 = ssaoKernel();
 				ssao.ssaoSet[0]->setUniformBufferData("UBOSSAOKernel", ssaoKernel2.data());
 			});
 			executePoint->registerWithinQueue<ssao_pass::system>(renderer);
+		}
+
+		auto registerSSAOBlurPass(ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint, frame_graph::FrameGraph::PassBuilder pass) -> void
+		{
+			pass.read(GBufferTextures::SSAO_SCREEN).write(GBufferTextures::SSAO_BLUR);
 			executePoint->registerWithinQueue<ssao_blur_pass::system>(renderer);
 		}
 
-		auto registerSSR(ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint) -> void
+		auto registerSSR(ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint, frame_graph::FrameGraph::PassBuilder pass) -> void
 		{
+			pass.require(frame_feature::SSR)
+			    .read(GBufferTextures::VIEW_POSITION)
+			    .read(GBufferTextures::VIEW_NORMALS)
+			    .read(GBufferTextures::PBR)
+			    .read(GBufferTextures::SCREEN)
+			    .write(GBufferTextures::SSR_SCREEN);
+
 			executePoint->registerGlobalComponent<component::SSRData>([](auto &ssr) {
 				ssr.ssrShader        = Shader::create("shaders/SSR.shader");
 				ssr.ssrDescriptorSet = DescriptorSet::create({0, ssr.ssrShader.get()});
@@ -321,11 +340,22 @@ namespace maple
 			executePoint->registerWithinQueue<ssr_pass::system>(renderer);
 		}
 
-		auto registerBloom(ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint) -> void
+		auto registerBloom(ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint, frame_graph::FrameGraph::PassBuilder pass) -> void
 		{
+			//the blur reads what the bright pass and its first direction wrote
+			pass.require(frame_feature::Bloom)
+			    .read(GBufferTextures::SCREEN)
+			    .read(GBufferTextures::BLOOM_SCREEN)
+			    .read(GBufferTextures::BLOOM_BLUR)
+			    .write(GBufferTextures::BLOOM_SCREEN)
+			    .write(GBufferTextures::BLOOM_BLUR);
+
 			executePoint->registerGlobalComponent<component::BloomData>([](auto &bloom) {
 				bloom.bloomShader        = Shader::create("shaders/GaussBlur.shader");
 				bloom.bloomDescriptorSet = DescriptorSet::create({0, bloom.bloomShader.get()});
+				bloom.dir                = bloom.bloomDescriptorSet->getUniformHandle(UniformId("UBO", "dir"));
+				bloom.scale              = bloom.bloomDescriptorSet->getUniformHandle(UniformId("UBO", "blurScale"));
+				bloom.strength           = bloom.bloomDescriptorSet->getUniformHandle(UniformId("UBO", "blurStrength"));
 			});
 
 			executePoint->registerGlobalComponent<component::ComputeBloom>([](auto &bloom) {
@@ -2,13 +2,14 @@
 // This file is part of the Maple Engine                              		//
 //////////////////////////////////////////////////////////////////////////////
 #pragma once
+#include "FrameGraph.h"
+#include "RHI/DescriptorSet.h"
 #include "Scene/System/ExecutePoint.h"
 #include <memory>
 
 namespace maple
 {
 	class Shader;
-	class DescriptorSet;
 
 	namespace component
 	{
@@ -21,6 +22,10 @@ namespace maple
 			bool                                        enable     = false;
 			float                                       bias       = 0.025;
 			float                                       ssaoRadius = 0.25f;
+
+			//resolved once when the descriptor sets are created
+			UniformHandle radius;
+			UniformHandle projection;
 		};
 
 		struct SSRData
@@ -37,13 +42,20 @@ namespace maple
 			std::shared_ptr<Shader>        bloomShader;
 			float                          blurScale    = 0.003f;
 			float                          blurStrength = 1.5f;
+
+			//resolved once when the descriptor set is created
+			UniformHandle dir;
+			UniformHandle scale;
+			UniformHandle strength;
 		};
 	};        // namespace component
 
 	namespace post_process
 	{
-		auto registerSSAOPass(ExecuteQueue &begin, ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint) -> void;
-		auto registerSSR(ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint) -> void;
-		auto registerBloom(ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint) -> void;
+		auto registerSSAOPass(ExecuteQueue &begin, ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint, frame_graph::FrameGraph::PassBuilder pass) -> void;
+		//registered on its own so that the graph can transition the ssao texture between the two passes
+		auto registerSSAOBlurPass(ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint, frame_graph::FrameGraph::PassBuilder pass) -> void;
+		auto registerSSR(ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint, frame_graph::FrameGraph::PassBuilder pass) -> void;
+		auto registerBloom(ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint, frame_graph::FrameGraph::PassBuilder pass) -> void;
 	};        // namespace post_process
 }        // namespace maple
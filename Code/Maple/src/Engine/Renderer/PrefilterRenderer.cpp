@@ -100,6 +100,9 @@ namespace maple
 			prefilterSets.emplace_back(DescriptorSet::create({0, prefilterShader.get()}));
 		}
 
+		cubeMapProj    = cubeMapSet->getUniformHandle(UniformId("UniformBufferObject", "proj"));
+		constRoughness = prefilterSets[0]->getUniformHandle(UniformId("UniformBufferRoughness", "constRoughness"));
+
 		skyboxDepth = TextureDepth::create(SkyboxSize, SkyboxSize);
 		createPipeline();
 		updateUniform();
@@ -169,7 +172,7 @@ namespace maple
 	auto PrefilterRenderer::generateSkybox(const CommandBuffer *cmd, capture_graph::component::RenderGraph &graph) -> void
 	{
 		const auto proj = glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, 10.0f);
-		cubeMapSet->setUniform("UniformBufferObject", "proj", glm::value_ptr(proj));
+		cubeMapSet->setUniform(cubeMapProj, glm::value_ptr(proj));
 
 		if (equirectangularMap)
 		{
@@ -261,7 +264,7 @@ namespace maple
 		for (auto mip = 0; mip < maxMips; ++mip)
 		{
 			auto roughness = (float) mip / (float) (maxMips - 1);
-			prefilterSets[mip]->setUniform("UniformBufferRoughness", "constRoughness", &roughness);
+			prefilterSets[mip]->setUniform(constRoughness, &roughness);
 			prefilterSets[mip]->update(cmd);
 			for (auto faceId = 0; faceId < 6; faceId++)
 			{
@@ -288,7 +291,7 @@ namespace maple
 	{
 		auto proj = glm::perspective(glm::radians(90.0f), 1.0f, 0.1f, 10.0f);
 
-		cubeMapSet->setUniform("UniformBufferObject", "proj", glm::value_ptr(proj));
+		cubeMapSet->setUniform(cubeMapProj, glm::value_ptr(proj));
 
 		if (equirectangularMap)
 		{
@@ -3,6 +3,7 @@
 //////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "RHI/Definitions.h"
+#include "RHI/DescriptorSet.h"
 #include <cstdint>
 #include <glm/glm.hpp>
 #include <memory>
@@ -17,7 +18,6 @@ namespace maple
 	class TextureDepth;
 	class UniformBuffer;
 	class GBuffer;
-	class DescriptorSet;
 	class Shader;
 	class Scene;
 	class FrameBuffer;
@@ -71,6 +71,10 @@ namespace maple
 
 		std::shared_ptr<DescriptorSet> cubeMapSet;
 
+		//resolved once when the descriptor sets are created, the handle of a shader fits all of its sets
+		UniformHandle cubeMapProj;
+		UniformHandle constRoughness;
+
 		std::shared_ptr<DescriptorSet> currentSet;
 
 		std::shared_ptr<Texture2D>   skyboxCaptureColor;
@@ -42,6 +42,8 @@
 #include "DeferredOffScreenRenderer.h"
 
 #include "FinalPass.h"
+#include "FrameGraph.h"
+#include "GPUCulling.h"
 #include "GeometryRenderer.h"
 #include "GridRenderer.h"
 #include "PostProcessRenderer.h"
@@ -51,6 +53,7 @@
 #include "SkyboxRenderer.h"
 
 #include "ImGui/ImGuiHelpers.h"
+#include "Others/Console.h"
 #include "Others/Randomizer.h"
 
 #include <ecs/ecs.h>
@@ -84,10 +87,143 @@ namespace maple
 		}
 	}        // namespace on_begin_renderer
 
+	namespace frame_pass
+	{
+		//passes which use the GBuffer, in the order their systems are registered into the render queue
+		enum Id : uint32_t
+		{
+			Clear,
+			GBufferPass,
+			SSAO,
+			SSAOBlur,
+			IndirectLighting,
+			Lighting,
+			Sky,
+			Cloud,
+			Render2D,
+			SSR,
+			Overlay,
+			Bloom,
+			DebugVoxel,
+			Final,
+			RaytracedShadow,
+			ComputeCloud,
+			LPVIndirectLighting,
+			LPVDebug,
+			Length
+		};
+
+		constexpr const char *Names[] = {
+		    "Clear", "GBuffer", "SSAO", "SSAOBlur", "IndirectLighting", "Lighting", "Sky", "Cloud", "Render2D", "SSR",
+		    "Overlay", "Bloom", "DebugVoxel", "Final", "RaytracedShadow", "ComputeCloud", "LPVIndirectLighting", "LPVDebug"};
+
+		static_assert(sizeof(Names) / sizeof(Names[0]) == Length, "every pass needs a name");
+
+		inline auto createTextures(frame_graph::FrameGraph &graph, const GBuffer &gbuffer)
+		{
+			for (uint32_t i = 0; i < GBufferTextures::LENGTH; i++)
+			{
+				//the LPV writes the indirect lighting after the final pass, it is read by the next frame
+				if (i == GBufferTextures::INDIRECT_LIGHTING)
+					graph.importTexture(GBufferNames[i], gbuffer.getDesc(i));
+				else
+					graph.createTexture(GBufferNames[i], gbuffer.getDesc(i));
+			}
+		}
+
+		//the features the renderer runs with this frame
+		inline auto getFeatures(ExecutePoint &executePoint)
+		{
+			uint32_t features = 0;
+			if (executePoint.getGlobalComponent<component::SSRData>().enable)
+				features |= frame_feature::SSR;
+			if (executePoint.getGlobalComponent<component::BloomData>().enable)
+				features |= frame_feature::Bloom;
+			if (!executePoint.getRegistry().view<vxgi::component::Voxelization>().empty())
+				features |= frame_feature::VXGI;
+			return features;
+		}
+
+		inline auto compile(component::FrameGraphData &data)
+		{
+			data.compiled = data.graph.compile(true, data.features);
+
+			uint32_t culled = 0;
+			for (auto pass : data.compiled.culled)
+				culled += pass ? 1 : 0;
+
+			LOGI("FrameGraph : {0} passes, {1} culled, {2} barriers, transient textures {3} MB allocated in {4} MB",
+			     data.graph.getPasses().size(), culled, data.compiled.barrierCount,
+			     data.compiled.transientBytes / (1024 * 1024), data.compiled.allocatedBytes / (1024 * 1024));
+
+			for (auto resource : data.compiled.uninitialized)
+				LOGW("FrameGraph : {0} is read before it is written", data.graph.getResources()[resource].name);
+		}
+
+		inline auto isCulled(const component::FrameGraphData &data, Id pass)
+		{
+			return data.compiled.culled.size() == Length && data.compiled.culled[pass];
+		}
+
+		//issue the transitions of the pass as one batch before its systems run
+		template <Id pass>
+		inline auto transition(const component::FrameGraphData &data, const component::RendererData &renderer, ecs::World world)
+		{
+			if (renderer.gbuffer == nullptr || data.compiled.culled.size() != Length || data.compiled.culled[pass])
+				return;
+
+			const auto &barriers = data.compiled.barriers[pass];
+			if (barriers.empty())
+				return;
+
+			std::vector<TextureTransition> transitions;
+			transitions.reserve(barriers.size());
+			for (auto &barrier : barriers)
+			{
+				transitions.push_back({renderer.gbuffer->getBuffer(barrier.resource).get(), barrier.after});
+			}
+			Application::getRenderDevice()->transitionTextures(renderer.commandBuffer, transitions);
+		}
+
+		/**
+		 * Declares the pass in the graph and lets registerSystems register its systems into the render queue and declare
+		 * the textures they use on the pass. The systems are skipped while the compiled graph culls the pass.
+		 */
+		template <Id pass, typename Register>
+		inline auto registerPass(ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint, frame_graph::FrameGraph &graph, const Register &registerSystems)
+		{
+			executePoint->registerWithinQueue<transition<pass>>(renderer);
+
+			auto builder = graph.addPass(Names[pass]);
+			MAPLE_ASSERT(builder.getId() == pass, "passes have to be registered in the order of Id");
+
+			const auto first = renderer.jobs.size();
+			registerSystems(builder);
+
+			for (auto i = first; i < renderer.jobs.size(); i++)
+			{
+				renderer.jobs[i] = [job = std::move(renderer.jobs[i]), point = executePoint.get()](entt::registry &registry) {
+					auto data = registry.try_get<component::FrameGraphData>(point->getGlobalEntity());
+					if (data == nullptr || !isCulled(*data, pass))
+						job(registry);
+				};
+			}
+		}
+	}        // namespace frame_pass
+
 	auto RenderGraph::init(uint32_t width, uint32_t height) -> void
 	{
 		auto executePoint = Application::getExecutePoint();
 		gBuffer           = std::make_shared<GBuffer>(width, height);
+
+		//the passes are declared while their systems are registered below, the graph is compiled before any GBuffer texture is built
+		frameGraph = std::make_shared<component::FrameGraphData>();
+		frame_pass::createTextures(frameGraph->graph, *gBuffer);
+		executePoint->registerGlobalComponent<component::FrameGraphData>([frameGraph = frameGraph](component::FrameGraphData &data) {
+			data = *frameGraph;
+		});
+		auto &graph = frameGraph->graph;
+
 		executePoint->registerGlobalComponent<component::RendererData>([&, width, height](component::RendererData &data) {
 			data.screenQuad = Mesh::createQuad(true);
 			data.unitCube   = TextureCube::create(1);
@@ -102,39 +238,86 @@ namespace maple
 
 		executePoint->registerQueue(beginQ);
 		executePoint->registerQueue(renderQ);
-		executePoint->registerWithinQueue<on_begin_renderer::system>(renderQ);
+		frame_pass::registerPass<frame_pass::Clear>(renderQ, executePoint, graph, [&](auto pass) {
+			for (auto target : {GBufferTextures::COLOR, GBufferTextures::POSITION, GBufferTextures::NORMALS, GBufferTextures::PBR,
+			                    GBufferTextures::VIEW_POSITION, GBufferTextures::VIEW_NORMALS, GBufferTextures::VELOCITY, GBufferTextures::SCREEN})
+				pass.write(target);
+			executePoint->registerWithinQueue<on_begin_renderer::system>(renderQ);
+		});
 
 		raytracing::registerAccelerationStructureModule(beginQ,executePoint);
+#ifdef MAPLE_VULKAN
+		gpu_culling::registerGPUCulling(beginQ, renderQ, executePoint);
+#endif        // MAPLE_VULKAN
 
 		shadow_map::registerShadowMap(beginQ, renderQ, executePoint);
 		reflective_shadow_map::registerShadowMap(beginQ, renderQ, executePoint);
-		deferred_offscreen::registerDeferredOffScreenRenderer(beginQ, renderQ, executePoint);
-		post_process::registerSSAOPass(beginQ, renderQ, executePoint);
-		vxgi::registerVXGIIndirectLighting(renderQ, executePoint);
-		deferred_lighting::registerDeferredLighting(beginQ, renderQ, executePoint);
-		atmosphere_pass::registerAtmosphere(beginQ, renderQ, executePoint);
-		skybox_renderer::registerSkyboxRenderer(beginQ, renderQ, executePoint);
-		cloud_renderer::registerCloudRenderer(beginQ, renderQ, executePoint);
-		render2d::registerRenderer2D(beginQ, renderQ, executePoint);
-		post_process::registerSSR(renderQ, executePoint);
-		grid_renderer::registerGridRenderer(beginQ, renderQ, executePoint);
-		geometry_renderer::registerGeometryRenderer(beginQ, renderQ, executePoint);
-		post_process::registerBloom(renderQ, executePoint);
-		vxgi_debug::registerVXGIVisualization(beginQ, renderQ, executePoint);
+		frame_pass::registerPass<frame_pass::GBufferPass>(renderQ, executePoint, graph, [&](auto pass) {
+			deferred_offscreen::registerDeferredOffScreenRenderer(beginQ, renderQ, executePoint, pass);
+		});
+		frame_pass::registerPass<frame_pass::SSAO>(renderQ, executePoint, graph, [&](auto pass) {
+			post_process::registerSSAOPass(beginQ, renderQ, executePoint, pass);
+		});
+		frame_pass::registerPass<frame_pass::SSAOBlur>(renderQ, executePoint, graph, [&](auto pass) {
+			post_process::registerSSAOBlurPass(renderQ, executePoint, pass);
+		});
+		frame_pass::registerPass<frame_pass::IndirectLighting>(renderQ, executePoint, graph, [&](auto pass) {
+			vxgi::registerVXGIIndirectLighting(renderQ, executePoint, pass);
+		});
+		frame_pass::registerPass<frame_pass::Lighting>(renderQ, executePoint, graph, [&](auto pass) {
+			deferred_lighting::registerDeferredLighting(beginQ, renderQ, executePoint, pass);
+		});
+		frame_pass::registerPass<frame_pass::Sky>(renderQ, executePoint, graph, [&](auto pass) {
+			atmosphere_pass::registerAtmosphere(beginQ, renderQ, executePoint, pass);
+			skybox_renderer::registerSkyboxRenderer(beginQ, renderQ, executePoint, pass);
+		});
+		frame_pass::registerPass<frame_pass::Cloud>(renderQ, executePoint, graph, [&](auto pass) {
+			cloud_renderer::registerCloudRenderer(beginQ, renderQ, executePoint, pass);
+		});
+		frame_pass::registerPass<frame_pass::Render2D>(renderQ, executePoint, graph, [&](auto pass) {
+			render2d::registerRenderer2D(beginQ, renderQ, executePoint, pass);
+		});
+		frame_pass::registerPass<frame_pass::SSR>(renderQ, executePoint, graph, [&](auto pass) {
+			post_process::registerSSR(renderQ, executePoint, pass);
+		});
+		frame_pass::registerPass<frame_pass::Overlay>(renderQ, executePoint, graph, [&](auto pass) {
+			grid_renderer::registerGridRenderer(beginQ, renderQ, executePoint, pass);
+			geometry_renderer::registerGeometryRenderer(beginQ, renderQ, executePoint, pass);
+		});
+		frame_pass::registerPass<frame_pass::Bloom>(renderQ, executePoint, graph, [&](auto pass) {
+			post_process::registerBloom(renderQ, executePoint, pass);
+		});
+		frame_pass::registerPass<frame_pass::DebugVoxel>(renderQ, executePoint, graph, [&](auto pass) {
+			vxgi_debug::registerVXGIVisualization(beginQ, renderQ, executePoint, pass);
+		});
 		vxgi::registerVoxelizer(beginQ, renderQ, executePoint);
-		final_screen_pass::registerFinalPass(renderQ, executePoint);
+		frame_pass::registerPass<frame_pass::Final>(renderQ, executePoint, graph, [&](auto pass) {
+			final_screen_pass::registerFinalPass(renderQ, executePoint, pass);
+		});
 
 		//############################################################################
 		
-		raytraced_shadow::registerRaytracedShadow(beginQ, renderQ, executePoint);
+		frame_pass::registerPass<frame_pass::RaytracedShadow>(renderQ, executePoint, graph, [&](auto pass) {
+			raytraced_shadow::registerRaytracedShadow(beginQ, renderQ, executePoint, pass);
+		});
 	
-		cloud_renderer::registerComputeCloud(renderQ, executePoint);
+		//recorded into the async compute command buffer, nothing after Final may read what they write
+		frame_pass::registerPass<frame_pass::ComputeCloud>(renderQ, executePoint, graph, [&](auto pass) {
+			cloud_renderer::registerComputeCloud(renderQ, executePoint, pass);
+		});
 		vxgi::registerUpdateRadiace(renderQ, executePoint);
 		light_propagation_volume::registerLPV(beginQ, renderQ, executePoint);
-		lpv_indirect_lighting::registerLPVIndirectLight(renderQ, executePoint);
-		light_propagation_volume::registerLPVDebug(beginQ, renderQ, executePoint);
+		frame_pass::registerPass<frame_pass::LPVIndirectLighting>(renderQ, executePoint, graph, [&](auto pass) {
+			lpv_indirect_lighting::registerLPVIndirectLight(renderQ, executePoint, pass);
+		});
+		frame_pass::registerPass<frame_pass::LPVDebug>(renderQ, executePoint, graph, [&](auto pass) {
+			light_propagation_volume::registerLPVDebug(beginQ, renderQ, executePoint, pass);
+		});
 
 		path_integrator::registerPathIntegrator(beginQ, renderQ, executePoint);
+
+		frame_pass::compile(*frameGraph);
+		gBuffer->setAliases(frameGraph->compiled);
 	}
 
 	auto RenderGraph::beginScene(Scene *scene) -> void
@@ -179,7 +362,7 @@ namespace maple
 		auto        projView = proj * view;
 
 		auto descriptorSets = previewData->descriporSets;
-		descriptorSets[0]->setUniform("UniformBufferObject", "projView", &projView);
+		descriptorSets[0]->setUniform(UniformId("UniformBufferObject", "projView"), &projView);
 		descriptorSets[0]->update();
 
 		auto &registry = scene->getRegistry();
@@ -200,8 +383,8 @@ namespace maple
 
 		auto cameraPos = glm::vec4{camera.second->getWorldPosition(), 1.f};
 
-		descriptorSets[2]->setUniform("UniformBufferLight", "light", &directionaLight->lightData);
-		descriptorSets[2]->setUniform("UniformBufferLight", "cameraPosition", glm::value_ptr(cameraPos));
+		descriptorSets[2]->setUniform(UniformId("UniformBufferLight", "light"), &directionaLight->lightData);
+		descriptorSets[2]->setUniform(UniformId("UniformBufferLight", "cameraPosition"), glm::value_ptr(cameraPos));
 
 		auto meshGroup = registry.group<MeshRenderer>(entt::get<Transform>);
 
@@ -304,8 +487,21 @@ namespace maple
 		winSize.height           = screenBufferHeight;
 		winSize.width            = screenBufferWidth;
 		renderData.commandBuffer = Application::getGraphicsContext()->getSwapChain()->getCurrentCommandBuffer();
-		//renderData.commandBuffer = Application::getGraphicsContext()->getSwapChain()->getComputeCmdBuffer();
-		renderData.renderDevice = Application::getRenderDevice().get();
+		renderData.renderDevice  = Application::getRenderDevice().get();
+
+		//work without a consumer in this frame goes to the compute queue, its results are read by the next frame
+		auto computeCommandBuffer       = Application::getGraphicsContext()->getSwapChain()->getComputeCmdBuffer();
+		renderData.computeCommandBuffer = computeCommandBuffer != nullptr ? computeCommandBuffer : renderData.commandBuffer;
+
+		//turning a feature on or off changes which passes run and so which GBuffer textures can share memory
+		const auto features = frame_pass::getFeatures(*Application::getExecutePoint());
+		if (features != frameGraph->features)
+		{
+			frameGraph->features = features;
+			frame_pass::compile(*frameGraph);
+			gBuffer->setAliases(frameGraph->compiled);
+			Application::getExecutePoint()->getGlobalComponent<component::FrameGraphData>() = *frameGraph;
+		}
 	}
 
 	auto RenderGraph::onResize(uint32_t width, uint32_t height) -> void
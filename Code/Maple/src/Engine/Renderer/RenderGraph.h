@@ -20,6 +20,7 @@ namespace maple
 	namespace component
 	{
 		struct Light;
+		struct FrameGraphData;
 		class Transform;
 	};        // namespace component
 
@@ -68,7 +69,8 @@ namespace maple
 	  private:
 		bool previewFocused = false;
 
-		std::shared_ptr<GBuffer> gBuffer;
+		std::shared_ptr<GBuffer>                   gBuffer;
+		std::shared_ptr<component::FrameGraphData> frameGraph;
 
 		uint32_t screenBufferWidth  = 0;
 		uint32_t screenBufferHeight = 0;
@@ -0,0 +1,91 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+#include "RenderQueue.h"
+#include "Engine/Profiler.h"
+
+#include <algorithm>
+
+namespace maple
+{
+	namespace render_queue
+	{
+		namespace
+		{
+			//ids which do not fit wrap around, they only lose some grouping
+			inline auto field(uint64_t value, uint32_t bits) -> uint64_t
+			{
+				return value & ((uint64_t(1) << bits) - 1);
+			}
+
+			inline auto quantize(float depth) -> uint64_t
+			{
+				constexpr float MaxDepth = static_cast<float>((1u << DepthBits) - 1);
+				return static_cast<uint64_t>(std::clamp(depth, 0.f, 1.f) * MaxDepth);
+			}
+		}        // namespace
+
+		auto makeSortKey(SortPass pass, uint32_t pipeline, uint32_t material, uint32_t mesh, float depth) -> uint64_t
+		{
+			static_assert(PassBits + PipelineBits + MaterialBits + MeshBits + DepthBits == 64, "the sort key must use 64 bits");
+
+			const uint64_t state = (field(pipeline, PipelineBits) << (MaterialBits + MeshBits)) |
+			                       (field(material, MaterialBits) << MeshBits) |
+			                       field(mesh, MeshBits);
+			const uint64_t passBits = field(static_cast<uint64_t>(pass), PassBits) << (64 - PassBits);
+
+			if (pass == SortPass::Transparent)
+			{
+				const uint64_t farFirst = field(~quantize(depth), DepthBits);
+				return passBits | (farFirst << (PipelineBits + MaterialBits + MeshBits)) | state;
+			}
+			return passBits | (state << DepthBits) | quantize(depth);
+		}
+
+		auto sort(std::vector<SortItem> &items, std::vector<SortItem> &scratch) -> void
+		{
+			PROFILE_FUNCTION();
+			if (items.size() < 2)
+				return;
+
+			uint64_t allOnes = ~uint64_t(0);
+			uint64_t anyOnes = 0;
+			for (const auto &item : items)
+			{
+				allOnes &= item.key;
+				anyOnes |= item.key;
+			}
+			const uint64_t varying = allOnes ^ anyOnes;
+
+			scratch.resize(items.size());
+			auto *src = &items;
+			auto *dst = &scratch;
+
+			for (uint32_t shift = 0; shift < 64; shift += 8)
+			{
+				if (((varying >> shift) & 0xFF) == 0)
+					continue;
+
+				uint32_t offsets[256] = {};
+				for (const auto &item : *src)
+					offsets[(item.key >> shift) & 0xFF]++;
+
+				uint32_t sum = 0;
+				for (auto &offset : offsets)
+				{
+					const auto count = offset;
+					offset           = sum;
+					sum += count;
+				}
+
+				for (const auto &item : *src)
+					(*dst)[offsets[(item.key >> shift) & 0xFF]++] = item;
+
+				std::swap(src, dst);
+			}
+
+			if (src != &items)
+				items.swap(scratch);
+		}
+	}        // namespace render_queue
+};           // namespace maple
@@ -0,0 +1,123 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "Engine/Core.h"
+
+#include <cstdint>
+#include <unordered_map>
+#include <vector>
+
+namespace maple
+{
+	namespace global::component
+	{
+		struct BindCounters
+		{
+			uint32_t pipelineBinds   = 0;
+			uint32_t pipelineSkips   = 0;
+			uint32_t descriptorBinds = 0;
+			uint32_t descriptorSkips = 0;
+			uint32_t bufferBinds     = 0;
+			uint32_t bufferSkips     = 0;
+			uint32_t draws           = 0;
+			uint32_t instances       = 0;
+
+			inline auto operator+=(const BindCounters &other) -> BindCounters &
+			{
+				pipelineBinds += other.pipelineBinds;
+				pipelineSkips += other.pipelineSkips;
+				descriptorBinds += other.descriptorBinds;
+				descriptorSkips += other.descriptorSkips;
+				bufferBinds += other.bufferBinds;
+				bufferSkips += other.bufferSkips;
+				draws += other.draws;
+				instances += other.instances;
+				return *this;
+			}
+		};
+
+		//binds issued and skipped by the sorted render queues during the last frame
+		struct RenderQueueStats
+		{
+			BindCounters deferred;
+			BindCounters shadow;
+		};
+	}        // namespace global::component
+
+	namespace render_queue
+	{
+		enum class SortPass : uint8_t
+		{
+			Opaque,
+			Transparent
+		};
+
+		struct SortItem
+		{
+			uint64_t key;
+			uint32_t index;
+		};
+
+		//width of every field of the key, from the most significant bit
+		constexpr uint32_t PassBits     = 4;
+		constexpr uint32_t PipelineBits = 12;
+		constexpr uint32_t MaterialBits = 16;
+		constexpr uint32_t MeshBits     = 16;
+		constexpr uint32_t DepthBits    = 16;
+
+		/**
+		 * pass | pipeline | material | mesh | depth, opaque commands are sorted by state and then front to back.
+		 * transparent commands are sorted back to front first : pass | depth | pipeline | material | mesh.
+		 * depth is the view depth normalized to [0, 1].
+		 */
+		auto MAPLE_EXPORT makeSortKey(SortPass pass, uint32_t pipeline, uint32_t material, uint32_t mesh, float depth) -> uint64_t;
+
+		//stable LSD radix sort by key, the bytes which are the same for every key are skipped
+		auto MAPLE_EXPORT sort(std::vector<SortItem> &items, std::vector<SortItem> &scratch) -> void;
+
+		//consecutive entries [first, first + count) of a sorted order which are drawn by one instanced draw
+		struct InstanceGroup
+		{
+			uint32_t first;
+			uint32_t count;
+		};
+
+		/**
+		 * Split the sorted order into runs of commands with the same state, same(a, b) compares two commands.
+		 * The instance data is written in sorted order, so first is also the first instance of the group.
+		 */
+		template <typename Same>
+		inline auto groupInstances(const std::vector<SortItem> &order, std::vector<InstanceGroup> &groups, const Same &same) -> void
+		{
+			groups.clear();
+			for (uint32_t i = 0; i < order.size(); i++)
+			{
+				if (groups.empty() || !same(order[groups.back().first].index, order[i].index))
+					groups.push_back({i, 1});
+				else
+					groups.back().count++;
+			}
+		}
+
+		//small ids in order of first use, so pointers fit into the fields of the key
+		class MAPLE_EXPORT SortIds
+		{
+		  public:
+			inline auto clear()
+			{
+				ids.clear();
+			}
+
+			//return the id and true if the object is seen for the first time
+			inline auto insert(const void *object) -> std::pair<uint32_t, bool>
+			{
+				auto [iter, inserted] = ids.emplace(object, static_cast<uint32_t>(ids.size()));
+				return {iter->second, inserted};
+			}
+
+		  private:
+			std::unordered_map<const void *, uint32_t> ids;
+		};
+	}        // namespace render_queue
+};           // namespace maple
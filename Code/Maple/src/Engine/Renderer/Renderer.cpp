@@ -4,6 +4,13 @@
 #include "Renderer.h"
 #include "Application.h"
 #include "Engine/Mesh.h"
+#include "Engine/Profiler.h"
+#include "RHI/CommandBuffer.h"
+#include "RHI/GraphicsContext.h"
+#include "RHI/Pipeline.h"
+#include "RHI/Shader.h"
+#include "RHI/SwapChain.h"
+#include "Thread/ParallelForEach.h"
 
 namespace maple
 {
@@ -17,6 +24,16 @@ namespace maple
 		RenderDevice::drawIndexed(commandBuffer, type, count, start);
 	}
 
+	auto Renderer::drawIndexedInstanced(const CommandBuffer *commandBuffer, DrawType type, uint32_t count, uint32_t instanceCount, uint32_t start) -> void
+	{
+		RenderDevice::drawIndexedInstanced(commandBuffer, type, count, instanceCount, start);
+	}
+
+	auto Renderer::drawIndexedIndirect(const CommandBuffer *commandBuffer, StorageBuffer *args, uint32_t offset, uint32_t drawCount, uint32_t stride) -> void
+	{
+		RenderDevice::drawIndexedIndirect(commandBuffer, args, offset, drawCount, stride);
+	}
+
 	auto Renderer::drawArrays(const CommandBuffer *commandBuffer, DrawType type, uint32_t count, uint32_t start /*= 0*/) -> void
 	{
 		RenderDevice::drawArrays(commandBuffer, type, count, start);
@@ -34,10 +51,68 @@ namespace maple
 
 	auto Renderer::drawMesh(const CommandBuffer *cmdBuffer, Pipeline *pipeline, Mesh *mesh) -> void
 	{
-		mesh->getVertexBuffer()->bind(cmdBuffer, pipeline);
+		mesh->bindVertexStreams(cmdBuffer, pipeline);
 		mesh->getIndexBuffer()->bind(cmdBuffer);
 		RenderDevice::drawIndexed(cmdBuffer, DrawType::Triangle, mesh->getIndexBuffer()->getCount());
 		mesh->getVertexBuffer()->unbind();
 		mesh->getIndexBuffer()->unbind();
 	}
+
+	auto Renderer::setQuantization(PushConstant &pushConstant, const Mesh *mesh) -> void
+	{
+		if (mesh->isCompressed())
+		{
+			pushConstant.setValue("positionOffset", &mesh->getQuantization().offset);
+			pushConstant.setValue("positionScale", &mesh->getQuantization().scale);
+		}
+	}
+
+	namespace
+	{
+		//below this the cost of the secondary command buffers is higher than recording inline
+		constexpr uint32_t MinParallelDraws = 256;
+		constexpr uint32_t MinBatchDraws    = 64;
+	}        // namespace
+
+	auto Renderer::recordParallel(const CommandBuffer *cmdBuffer, Pipeline *pipeline, uint32_t count,
+	                              const std::function<void(const CommandBuffer *, uint32_t, uint32_t)> &func, uint32_t layer) -> void
+	{
+		PROFILE_FUNCTION();
+		auto &jobSystem = Application::getJobSystem();
+
+		FrameBuffer *framebuffer = nullptr;
+		if (cmdBuffer != nullptr && count >= MinParallelDraws && jobSystem != nullptr && jobSystem->getWorkerCount() > 1)
+			framebuffer = pipeline->bindSecondary(cmdBuffer, layer);
+
+		if (framebuffer == nullptr)
+		{
+			pipeline->bind(cmdBuffer, layer);
+			func(cmdBuffer, 0, count);
+			pipeline->end(cmdBuffer);
+			return;
+		}
+
+		auto swapChain = Application::getGraphicsContext()->getSwapChain();
+
+		//the calling thread is counted as worker 0
+		const uint32_t workers   = jobSystem->getWorkerCount();
+		const uint32_t batchSize = std::max(MinBatchDraws, (count + workers * 2 - 1) / (workers * 2));
+
+		std::vector<CommandBuffer *> secondaries((count + batchSize - 1) / batchSize);
+
+		parallelForRange(*jobSystem, count, batchSize, [&](uint32_t begin, uint32_t end) {
+			auto secondary = swapChain->getSecondaryCommandBuffer();
+			pipeline->beginSecondary(secondary, framebuffer);
+			func(secondary, begin, end);
+			secondary->endRecording();
+			secondaries[begin / batchSize] = secondary;
+		});
+
+		//executed in the order of the draw list, so the result is the same as recording inline
+		for (auto secondary : secondaries)
+		{
+			secondary->executeSecondary(cmdBuffer);
+		}
+		pipeline->end(cmdBuffer);
+	}
 };        // namespace maple
@@ -12,14 +12,29 @@
 
 namespace maple
 {
+	struct PushConstant;
+
 	class MAPLE_EXPORT Renderer
 	{
 	  public:
 		static auto bindDescriptorSets(Pipeline *pipeline, const CommandBuffer *cmdBuffer, uint32_t dynamicOffset, const std::vector<std::shared_ptr<DescriptorSet>> &descriptorSets) -> void;
 		static auto drawIndexed(const CommandBuffer *commandBuffer, DrawType type, uint32_t count, uint32_t start = 0) -> void;
+		static auto drawIndexedInstanced(const CommandBuffer *commandBuffer, DrawType type, uint32_t count, uint32_t instanceCount, uint32_t start = 0) -> void;
+		//drawCount VkDrawIndexedIndirectCommand read from args at offset, the counts may be written by a compute pass
+		static auto drawIndexedIndirect(const CommandBuffer *commandBuffer, StorageBuffer *args, uint32_t offset, uint32_t drawCount, uint32_t stride) -> void;
 		static auto drawArrays(const CommandBuffer *commandBuffer, DrawType type, uint32_t count, uint32_t start = 0) -> void;
 		static auto dispatch(const CommandBuffer *commandBuffer, uint32_t x, uint32_t y, uint32_t z) -> void;
 		static auto memoryBarrier(const CommandBuffer *commandBuffer, uint32_t flags) -> void;
 		static auto drawMesh(const CommandBuffer *cmdBuffer, Pipeline *pipeline, Mesh *mesh) -> void;
+		//positionOffset and positionScale of the shaders reading compressed vertex streams, nothing for the other meshes
+		static auto setQuantization(PushConstant &pushConstant, const Mesh *mesh) -> void;
+
+		/**
+		 * Record count draws inside the render pass of the pipeline, func(commandBuffer, begin, end) records the draws of [begin, end).
+		 * Long draw lists are split over the job system into secondary command buffers which are executed in order,
+		 * short ones or backends without secondary command buffers are recorded inline.
+		 */
+		static auto recordParallel(const CommandBuffer *cmdBuffer, Pipeline *pipeline, uint32_t count,
+		                           const std::function<void(const CommandBuffer *, uint32_t, uint32_t)> &func, uint32_t layer = 0) -> void;
 	};
 };        // namespace maple
@@ -27,6 +27,7 @@
 #include "RendererData.h"
 #include "Scene/Scene.h"
 
+#include <algorithm>
 #include <ecs/ecs.h>
 #include <imgui.h>
 
@@ -85,7 +86,7 @@ namespace maple
 
 				for (int32_t i = 0; i < config.maxBatchDrawCalls; i++)
 				{
-					vertexBuffers[i] = VertexBuffer::create(BufferUsage::Dynamic);
+					vertexBuffers[i] = VertexBuffer::create(BufferUsage::Stream);
 					vertexBuffers[i]->resize(config.bufferSize);
 				}
 
@@ -245,6 +246,9 @@ namespace maple
 				pipeInfo.blendMode       = BlendMode::SrcAlphaOneMinusSrcAlpha;
 				auto pipeline            = Pipeline::get(pipeInfo);
 
+				//stream buffers reserve their size from the frame allocator on every getPointer
+				const auto quadsSize = static_cast<uint32_t>(data.commands.size() * 4 * sizeof(Vertex2D));
+				data.vertexBuffers[data.batchDrawCallIndex]->resize(std::min(quadsSize, config.bufferSize));
 				data.vertexBuffers[data.batchDrawCallIndex]->bind(render.commandBuffer, pipeline.get());
 				data.buffer = data.vertexBuffers[data.batchDrawCallIndex]->getPointer<Vertex2D>();
 
@@ -296,8 +300,9 @@ namespace maple
 			}
 		}        // namespace on_render
 
-		auto registerRenderer2D(ExecuteQueue &begin, ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint) -> void
+		auto registerRenderer2D(ExecuteQueue &begin, ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint, frame_graph::FrameGraph::PassBuilder pass) -> void
 		{
+			pass.write(GBufferTextures::SCREEN);
 			executePoint->registerGlobalComponent<component::Renderer2DData>();
 			executePoint->registerWithinQueue<on_begin_scene::system>(begin);
 			executePoint->registerWithinQueue<on_render::system>(renderer);
@@ -2,6 +2,7 @@
 // This file is part of the Maple Engine                              		//
 //////////////////////////////////////////////////////////////////////////////
 #pragma once
+#include "FrameGraph.h"
 #include "Scene/System/ExecutePoint.h"
 #include <memory>
 
@@ -9,6 +10,6 @@ namespace maple
 {
 	namespace render2d
 	{
-		auto registerRenderer2D(ExecuteQueue &begin, ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint) -> void;
+		auto registerRenderer2D(ExecuteQueue &begin, ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint, frame_graph::FrameGraph::PassBuilder pass) -> void;
 	}
 };        // namespace maple
@@ -38,8 +38,9 @@ namespace maple
 
 		struct RendererData
 		{
-			CommandBuffer *              commandBuffer = nullptr;
-			GBuffer *                    gbuffer       = nullptr;
+			CommandBuffer *              commandBuffer        = nullptr;
+			CommandBuffer *              computeCommandBuffer = nullptr;        //async compute, commandBuffer when the device has no compute queue of its own
+			GBuffer *                    gbuffer              = nullptr;
 			std::shared_ptr<Mesh>        screenQuad;
 			std::shared_ptr<TextureCube> unitCube;        //1
 			RenderDevice *               renderDevice = nullptr;
@@ -53,7 +54,7 @@ namespace maple
 		};
 	}        // namespace component
 
-#ifdef MAPLE_OPENGL
+#if defined(MAPLE_OPENGL) || defined(MAPLE_NULL)
 	constexpr glm::mat4 BIAS_MATRIX = {
 	    0.5, 0.0, 0.0, 0.0,
 	    0.0, 0.5, 0.0, 0.0,
@@ -12,6 +12,7 @@
 #include "Scene/Component/Light.h"
 #include "Scene/Component/MeshRenderer.h"
 #include "Scene/Scene.h"
+#include "Scene/System/SceneBVHModule.h"
 
 #include "Engine/Camera.h"
 #include "Engine/CaptureGraph.h"
@@ -20,12 +21,15 @@
 #include "Engine/Mesh.h"
 #include "Engine/PathTracer/PathIntegrator.h"
 #include "Engine/Profiler.h"
+#include "Engine/Renderer/GPUCulling.h"
 #include "Engine/Renderer/GeometryRenderer.h"
 #include "Engine/Renderer/RendererData.h"
 
 #include "Engine/LPVGI/ReflectiveShadowMap.h"
 
+#include <algorithm>
 #include <ecs/ecs.h>
+#include <mutex>
 
 namespace maple
 {
@@ -115,8 +119,6 @@ namespace maple
 
 		using MeshQuery = ecs::Registry ::Modify<component::MeshRenderer>::Modify<component::Transform>::To<ecs::Group>;
 
-		using MeshEntity = ecs::Registry ::Modify<component::MeshRenderer>::Modify<component::Transform>::To<ecs::Entity>;
-
 		using BoneMeshQuery = ecs::Registry ::Modify<component::BoneComponent>::Modify<component::Transform>::To<ecs::Group>;
 
 		using SkinnedMeshQuery = ecs::Registry ::Modify<component::SkinnedMeshRenderer>::Modify<component::Transform>::To<ecs::Group>;
@@ -126,6 +128,7 @@ namespace maple
 		auto beginScene(Entity entity, LightQuery lightQuery, MeshQuery meshQuery, SkinnedMeshQuery skinnedQuery, BoneMeshQuery boneQuery,
 		                const global::component::SceneTransformChanged &sceneChanged,
 		                PathTraceGroup                                  pathGroup,
+		                const component::GPUCullingData &               gpuCulling,
 		                ecs::World                                      world)
 		{
 			auto [shadowData, cameraView] = entity;
@@ -143,7 +146,10 @@ namespace maple
 				for (uint32_t i = 0; i < shadowData.shadowMapNum; i++)
 				{
 					shadowData.cascadeCommandQueue[i].clear();
+					shadowData.cascadeOrder[i].clear();
+					shadowData.cascadeGroups[i].clear();
 				}
+				shadowData.instances.clear();
 
 				shadowData.animationQueue.clear();
 
@@ -166,7 +172,7 @@ namespace maple
 						if (entity.hasComponent<component::ReflectiveShadowData>())
 						{
 							auto &rsm = entity.getComponent<component::ReflectiveShadowData>();
-							rsm.descriptorSets[2]->setUniform("LightUBO", "light", &directionaLight->lightData);
+							rsm.descriptorSets[2]->setUniform(rsm.light, &directionaLight->lightData);
 						}
 
 						if (directionaLight)
@@ -178,23 +184,65 @@ namespace maple
 								shadowData.cascadeFrustums[i].from(shadowData.shadowProjView[i]);
 							}
 						}
+						auto &registry = world.getRegistry();
+						auto &bvh      = scene_bvh::getBVH(registry);
+
+						//gather the casters around all cascades once, then cull them in batches per cascade
+						BoundingBox cascadeBox;
+						for (uint32_t i = 0; i < shadowData.shadowMapNum; i++)
+						{
+							const auto vertices = shadowData.cascadeFrustums[i].getVertices();
+							for (uint32_t j = 0; j < Frustum::FRUSTUM_VERTICES; j++)
+							{
+								cascadeBox.merge(vertices[j]);
+							}
+						}
+
+						shadowData.casters.clear();
+						bvh.tree.query(cascadeBox, [&](uint32_t userData) {
+							const auto  entity = static_cast<entt::entity>(userData);
+							const auto &mesh   = registry.get<component::MeshRenderer>(entity);
+							if (mesh.castShadow && mesh.active && mesh.mesh != nullptr && !gpu_culling::isGPUDriven(gpuCulling, entity))
+								shadowData.casters.add(scene_bvh::getBounds(bvh, entity), userData);
+						});
+
 #pragma omp parallel for num_threads(4)
 						for (int32_t i = 0; i < shadowData.shadowMapNum; i++)
 						{
-							meshQuery.forEach([&, i](MeshEntity meshEntity) {
-								auto [mesh, trans] = meshEntity;
-								if (mesh.castShadow && mesh.active && mesh.mesh != nullptr)
-								{
-									auto bb     = mesh.mesh->getBoundingBox()->transform(trans.getWorldMatrix());
-									auto inside = shadowData.cascadeFrustums[i].isInside(bb);
-									if (inside)
-									{
-										auto &cmd     = shadowData.cascadeCommandQueue[i].emplace_back();
-										cmd.mesh      = mesh.mesh.get();
-										cmd.transform = trans.getWorldMatrix();
-									}
-								}
+							shadowData.casters.cull(shadowData.cascadeFrustums[i], shadowData.visibility[i]);
+							shadowData.casters.forEachVisible(shadowData.visibility[i], [&, i](uint32_t index) {
+								const auto entity  = static_cast<entt::entity>(shadowData.casters.getUserData(index));
+								auto [mesh, trans] = registry.get<component::MeshRenderer, component::Transform>(entity);
+
+								auto &cmd     = shadowData.cascadeCommandQueue[i].emplace_back();
+								cmd.mesh      = mesh.mesh.get();
+								cmd.transform = trans.getWorldMatrix();
+								//shadow draws only differ by mesh, its address is enough as key. the compressed meshes go last, they need another pipeline
+								cmd.sortKey = reinterpret_cast<uintptr_t>(cmd.mesh) | (uint64_t(cmd.mesh->isCompressed()) << 63);
 							});
+
+							const auto &queue = shadowData.cascadeCommandQueue[i];
+							auto &      order = shadowData.cascadeOrder[i];
+							order.clear();
+							for (uint32_t j = 0; j < queue.size(); j++)
+							{
+								order.push_back({queue[j].sortKey, j});
+							}
+							std::vector<render_queue::SortItem> scratch;
+							render_queue::sort(order, scratch);
+
+							render_queue::groupInstances(order, shadowData.cascadeGroups[i], [&](uint32_t left, uint32_t right) {
+								return queue[left].mesh == queue[right].mesh;
+							});
+						}
+
+						for (uint32_t i = 0; i < shadowData.shadowMapNum; i++)
+						{
+							shadowData.cascadeInstanceOffset[i] = static_cast<uint32_t>(shadowData.instances.size());
+							for (const auto &item : shadowData.cascadeOrder[i])
+							{
+								shadowData.instances.emplace_back(shadowData.cascadeCommandQueue[i][item.index].transform);
+							}
 						}
 
 						for (auto skinEntity : skinnedQuery)
@@ -215,8 +263,9 @@ namespace maple
 							}
 						}
 
-						shadowData.descriptorSet[0]->setUniform("UniformBufferObject", "projView", shadowData.shadowProjView);
-						shadowData.animDescriptorSet[0]->setUniform("UniformBufferObject", "projView", shadowData.shadowProjView);
+						shadowData.descriptorSet[0]->setUniform(shadowData.projView, shadowData.shadowProjView);
+						shadowData.indirectDescriptorSet[0]->setUniform(shadowData.projView, shadowData.shadowProjView);
+						shadowData.animDescriptorSet[0]->setUniform(shadowData.animProjView, shadowData.shadowProjView);
 					}
 				}
 			}
@@ -227,9 +276,12 @@ namespace maple
 		inline auto onRender(RenderEntity                                    entity,
 		                     PathTraceGroup                                  pathGroup,
 		                     const global::component::SceneTransformChanged &sceneChanged,
+		                     global::component::RenderQueueStats &           stats,
+		                     const component::GPUCullingData &               gpuCulling,
 		                     ecs::World                                      world)
 		{
 			auto [shadowData, rendererData, renderGraph] = entity;
+			stats.shadow                                 = {};
 
 			for (auto ent : pathGroup)
 			{
@@ -240,8 +292,18 @@ namespace maple
 
 			if (sceneChanged.dirty)
 			{
+				auto instanceBuffer = shadowData.instanceBuffer.upload(shadowData.instances.data(), static_cast<uint32_t>(sizeof(glm::mat4) * shadowData.instances.size()));
+				shadowData.descriptorSet[0]->setStorageBuffer("InstanceBuffer", instanceBuffer);
 				shadowData.descriptorSet[0]->update(rendererData.commandBuffer);
 
+				//the batches culled on the GPU are appended to the draws of every cascade
+				const auto indirectCount = gpuCulling.ready ? static_cast<uint32_t>(gpuCulling.batches.size()) : 0;
+				if (indirectCount > 0)
+				{
+					shadowData.indirectDescriptorSet[0]->setStorageBuffer("InstanceBuffer", gpuCulling.visibleTransforms);
+					shadowData.indirectDescriptorSet[0]->update(rendererData.commandBuffer);
+				}
+
 				PipelineInfo pipelineInfo;
 				pipelineInfo.shader = shadowData.shader;
 
@@ -256,26 +318,129 @@ namespace maple
 
 				auto pipeline = Pipeline::get(pipelineInfo, shadowData.descriptorSet, renderGraph);
 
+				//the compressed meshes are drawn after into the same layer, from their position stream
+				pipelineInfo.shader       = shadowData.compressedShader;
+				pipelineInfo.vertexLayout = VertexLayout::CompressedPosition;
+				pipelineInfo.clearTargets = false;
+
+				std::shared_ptr<Pipeline> compressedPipeline;
+
+				std::mutex statsMutex;
 				for (uint32_t i = 0; i < shadowData.shadowMapNum; ++i)
 				{
 					//GPUProfile("Shadow Layer Pass");
-					pipeline->bind(rendererData.commandBuffer, i);
-
-					for (auto &command : shadowData.cascadeCommandQueue[i])
+					const auto &queue  = shadowData.cascadeCommandQueue[i];
+					const auto &order  = shadowData.cascadeOrder[i];
+					const auto &groups = shadowData.cascadeGroups[i];
+
+					//the groups of the float meshes are sorted first
+					uint32_t split = 0;
+					while (split < groups.size() && !queue[order[groups[split].first].index].mesh->isCompressed())
+						split++;
+
+					//groups [firstGroup, firstGroup + groupCount) first, then the batches culled on the GPU
+					auto record = [&](Pipeline *pipeline, const std::shared_ptr<Shader> &shader, uint32_t firstGroup, uint32_t groupCount, uint32_t batchCount) {
+						Renderer::recordParallel(
+						    rendererData.commandBuffer, pipeline, groupCount + batchCount,
+						    [&](const CommandBuffer *commandBuffer, uint32_t begin, uint32_t end) {
+							    if (begin == end)
+								    return;
+
+							    //every recording thread works on its own copy of the push constants
+							    auto pushConstants = shader->getPushConstants();
+							    pushConstants[0].setValue("cascadeIndex", (void *) &i);
+
+							    global::component::BindCounters counters;
+							    counters.pipelineBinds   = 1;
+							    counters.pipelineSkips   = end - begin - 1;
+							    counters.descriptorSkips = end - begin;
+
+							    //the CPU groups come first, so the range switches to the indirect descriptor set at most once
+							    const std::vector<std::shared_ptr<DescriptorSet>> *boundSet = nullptr;
+							    auto bindSet = [&](const std::vector<std::shared_ptr<DescriptorSet>> &descriptorSet) {
+								    if (boundSet != &descriptorSet)
+								    {
+									    Renderer::bindDescriptorSets(pipeline, commandBuffer, 0, descriptorSet);
+									    boundSet = &descriptorSet;
+									    counters.descriptorBinds++;
+									    counters.descriptorSkips--;
+								    }
+							    };
+
+							    Mesh *boundMesh = nullptr;
+							    auto  bindMesh  = [&](Mesh *mesh) {
+								    if (boundMesh != mesh)
+								    {
+									    if (boundMesh != nullptr)
+									    {
+										    boundMesh->getVertexBuffer()->unbind();
+										    boundMesh->getIndexBuffer()->unbind();
+									    }
+									    boundMesh = mesh;
+									    boundMesh->bindVertexStreams(commandBuffer, pipeline, true);
+									    boundMesh->getIndexBuffer()->bind(commandBuffer);
+									    counters.bufferBinds++;
+								    }
+								    else
+								    {
+									    counters.bufferSkips++;
+								    }
+							    };
+
+							    for (auto index = begin; index < end; index++)
+							    {
+								    if (index >= groupCount)
+								    {
+									    const auto batch          = index - groupCount;
+									    const auto instanceOffset = i * static_cast<uint32_t>(gpuCulling.instances.size()) + gpuCulling.batches[batch].firstInstance;
+									    bindSet(shadowData.indirectDescriptorSet);
+									    pushConstants[0].setValue("instanceOffset", &instanceOffset);
+									    shader->bindPushConstants(commandBuffer, pipeline, pushConstants);
+									    bindMesh(gpuCulling.meshes[batch]);
+									    for (uint32_t subMesh = 0; subMesh < gpuCulling.batches[batch].commandCount; subMesh++)
+									    {
+										    Renderer::drawIndexedIndirect(commandBuffer, gpuCulling.args.get(), gpu_culling::getArgsOffset(gpuCulling, 1 + i, batch, subMesh), 1, sizeof(gpu_culling::DrawIndexedIndirectCommand));
+										    counters.draws++;
+									    }
+									    continue;
+								    }
+
+								    //the descriptor set of the float shader, the compressed one declares the same bindings
+								    bindSet(shadowData.descriptorSet);
+
+								    const auto &group          = groups[firstGroup + index];
+								    const auto  instanceOffset = shadowData.cascadeInstanceOffset[i] + group.first;
+								    const auto  mesh           = queue[order[group.first].index].mesh;
+								    pushConstants[0].setValue("instanceOffset", &instanceOffset);
+								    Renderer::setQuantization(pushConstants[0], mesh);
+								    shader->bindPushConstants(commandBuffer, pipeline, pushConstants);
+
+								    bindMesh(mesh);
+								    Renderer::drawIndexedInstanced(commandBuffer, DrawType::Triangle, boundMesh->getIndexBuffer()->getCount(), group.count);
+								    counters.draws++;
+								    counters.instances += group.count;
+							    }
+
+							    if (boundMesh != nullptr)
+							    {
+								    boundMesh->getVertexBuffer()->unbind();
+								    boundMesh->getIndexBuffer()->unbind();
+							    }
+
+							    std::lock_guard<std::mutex> lock(statsMutex);
+							    stats.shadow += counters;
+						    },
+						    i);
+					};
+
+					record(pipeline.get(), shadowData.shader, 0, split, indirectCount);
+
+					if (split < groups.size())
 					{
-						Mesh *      mesh          = command.mesh;
-						const auto &trans         = command.transform;
-						auto &      pushConstants = shadowData.shader->getPushConstants()[0];
-
-						pushConstants.setValue("transform", (void *) &trans);
-						pushConstants.setValue("cascadeIndex", (void *) &i);
-
-						shadowData.shader->bindPushConstants(rendererData.commandBuffer, pipeline.get());
-
-						Renderer::bindDescriptorSets(pipeline.get(), rendererData.commandBuffer, 0, shadowData.descriptorSet);
-						Renderer::drawMesh(rendererData.commandBuffer, pipeline.get(), mesh);
+						if (compressedPipeline == nullptr)
+							compressedPipeline = Pipeline::get(pipelineInfo, shadowData.descriptorSet, renderGraph);
+						record(compressedPipeline.get(), shadowData.compressedShader, split, static_cast<uint32_t>(groups.size()) - split, 0);
 					}
-					pipeline->end(rendererData.commandBuffer);
 				}
 			}
 		}
@@ -308,7 +473,16 @@ namespace maple
 
 				auto pipeline = Pipeline::get(pipelineInfo, shadowData.animDescriptorSet, renderGraph);
 
-				pipeline->bind(rendererData.commandBuffer);
+				//the compressed meshes read the bones from their attribute stream
+				std::shared_ptr<Pipeline> compressedPipeline;
+				if (std::any_of(shadowData.animationQueue.begin(), shadowData.animationQueue.end(), [](const auto &command) { return command.mesh->isCompressed(); }))
+				{
+					pipelineInfo.shader       = shadowData.animCompressedShader;
+					pipelineInfo.vertexLayout = VertexLayout::CompressedSkinned;
+					compressedPipeline        = Pipeline::get(pipelineInfo, shadowData.animDescriptorSet, renderGraph);
+				}
+
+				Pipeline *boundPipeline = nullptr;
 
 				for (auto &command : shadowData.animationQueue)
 				{
@@ -316,21 +490,33 @@ namespace maple
 
 					if (command.boneTransforms != nullptr)
 					{
-						shadowData.animDescriptorSet[0]->setUniform("UniformBufferObject", "boneTransforms", command.boneTransforms.get());
+						auto current = mesh->isCompressed() ? compressedPipeline.get() : pipeline.get();
+						if (boundPipeline != current)
+						{
+							if (boundPipeline != nullptr)
+								boundPipeline->end(rendererData.commandBuffer);
+							current->bind(rendererData.commandBuffer);
+							boundPipeline = current;
+						}
+
+						shadowData.animDescriptorSet[0]->setUniform(shadowData.boneTransforms, command.boneTransforms.get());
 						shadowData.animDescriptorSet[0]->update(rendererData.commandBuffer);
 
 						const auto &trans         = command.transform;
-						auto &      pushConstants = shadowData.animShader->getPushConstants()[0];
+						auto        shader        = current->getShader();
+						auto &      pushConstants = shader->getPushConstants()[0];
 
 						pushConstants.setValue("transform", (void *) &trans);
+						Renderer::setQuantization(pushConstants, mesh);
 
-						shadowData.animShader->bindPushConstants(rendererData.commandBuffer, pipeline.get());
+						shader->bindPushConstants(rendererData.commandBuffer, current);
 
-						Renderer::bindDescriptorSets(pipeline.get(), rendererData.commandBuffer, 0, shadowData.animDescriptorSet);
-						Renderer::drawMesh(rendererData.commandBuffer, pipeline.get(), mesh);
+						Renderer::bindDescriptorSets(current, rendererData.commandBuffer, 0, shadowData.animDescriptorSet);
+						Renderer::drawMesh(rendererData.commandBuffer, current, mesh);
 					}
 				}
-				pipeline->end(rendererData.commandBuffer);
+				if (boundPipeline != nullptr)
+					boundPipeline->end(rendererData.commandBuffer);
 			}
 		}
 	}        // namespace shadow_map_pass
@@ -339,18 +525,29 @@ namespace maple
 	{
 		auto registerShadowMap(ExecuteQueue &begin, ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint) -> void
 		{
+			executePoint->registerGlobalComponent<global::component::RenderQueueStats>();
+			executePoint->registerGlobalComponent<component::GPUCullingData>();
 			executePoint->registerGlobalComponent<component::ShadowMapData, component::RendererData>([](component::ShadowMapData &data,
 			                                                                                            component::RendererData & renderData) {
 				data.shadowTexture = TextureDepthArray::create(SHADOWMAP_SiZE_MAX, SHADOWMAP_SiZE_MAX, data.shadowMapNum, renderData.commandBuffer);
 				data.shader        = Shader::create("shaders/Shadow.shader");
 				data.animShader    = Shader::create("shaders/ShadowAnim.shader");
 
+				data.compressedShader     = Shader::create("shaders/ShadowCompressed.shader");
+				data.animCompressedShader = Shader::create("shaders/ShadowAnimCompressed.shader");
+
 				data.descriptorSet.resize(1);
 				data.animDescriptorSet.resize(1);
+				data.indirectDescriptorSet.resize(1);
 
-				data.descriptorSet[0]     = DescriptorSet::create({0, data.shader.get()});
+				data.descriptorSet[0]         = DescriptorSet::create({0, data.shader.get()});
+				data.indirectDescriptorSet[0] = DescriptorSet::create({0, data.shader.get()});
 				data.animDescriptorSet[0] = DescriptorSet::create({0, data.animShader.get()});
 
+				data.projView       = data.descriptorSet[0]->getUniformHandle(UniformId("UniformBufferObject", "projView"));
+				data.animProjView   = data.animDescriptorSet[0]->getUniformHandle(UniformId("UniformBufferObject", "projView"));
+				data.boneTransforms = data.animDescriptorSet[0]->getUniformHandle(UniformId("UniformBufferObject", "boneTransforms"));
+
 				data.animationQueue.reserve(50);
 
 				data.cascadeCommandQueue[0].reserve(500);
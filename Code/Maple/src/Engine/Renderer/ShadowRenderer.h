@@ -4,8 +4,12 @@
 #pragma once
 
 #include "Engine/Core.h"
+#include "Engine/Renderer/InstanceBuffer.h"
+#include "Engine/Renderer/RenderQueue.h"
 #include "Engine/Renderer/Renderer.h"
 #include "Math/Frustum.h"
+#include "Math/FrustumCulling.h"
+#include "RHI/DescriptorSet.h"
 #include "RHI/Shader.h"
 #include "Scene/System/ExecutePoint.h"
 
@@ -54,13 +58,29 @@ namespace maple
 
 			std::vector<std::shared_ptr<DescriptorSet>> descriptorSet;
 
+			std::vector<std::shared_ptr<DescriptorSet>> indirectDescriptorSet;        //InstanceBuffer is the output of the GPU culling pass
+
 			std::vector<std::shared_ptr<DescriptorSet>> animDescriptorSet;
 
-			std::vector<RenderCommand>         cascadeCommandQueue[SHADOWMAP_MAX];
-			std::vector<RenderCommand>         animationQueue;
-			std::shared_ptr<Shader>            shader;
-			std::shared_ptr<Shader>            animShader;
-			std::shared_ptr<TextureDepthArray> shadowTexture;
+			//resolved once when the descriptor sets are created, the indirect draws share the shader of descriptorSet
+			UniformHandle projView;
+			UniformHandle animProjView;
+			UniformHandle boneTransforms;
+
+			std::vector<RenderCommand>               cascadeCommandQueue[SHADOWMAP_MAX];
+			std::vector<render_queue::SortItem>      cascadeOrder[SHADOWMAP_MAX];         //cascade commands grouped by mesh, the compressed meshes last
+			std::vector<render_queue::InstanceGroup> cascadeGroups[SHADOWMAP_MAX];        //one instanced draw per mesh and cascade
+			uint32_t                                 cascadeInstanceOffset[SHADOWMAP_MAX] = {};
+			std::vector<glm::mat4>                   instances;        //transforms of all cascades in sorted order
+			InstanceBuffer                           instanceBuffer;
+			std::vector<RenderCommand>               animationQueue;
+			CullingBatch                             casters;        //shadow casters around every cascade
+			std::vector<uint64_t>                    visibility[SHADOWMAP_MAX];
+			std::shared_ptr<Shader>                  shader;
+			std::shared_ptr<Shader>                  animShader;
+			std::shared_ptr<Shader>                  compressedShader;        //reads the position stream alone
+			std::shared_ptr<Shader>                  animCompressedShader;
+			std::shared_ptr<TextureDepthArray>       shadowTexture;
 		};
 	}        // namespace component
 
@@ -116,7 +116,7 @@ namespace maple
 		{
 			auto [skyboxData, cameraView, graph] = entity;
 
-			GPUProfile("SkyBox Pass");
+			GPUProfile("SkyBox Pass", rendererData.commandBuffer);
 			if (skyboxData.pseudoSky)
 			{
 				skyboxData.pseudoSkydescriptorSet->update(rendererData.commandBuffer);
@@ -173,7 +173,7 @@ namespace maple
 					skyboxData.descriptorSet->setTexture("uCubeMap", skyboxData.irradianceMap);
 				}
 
-				skyboxData.descriptorSet->setUniform("UniformBufferObjectLod", "lodLevel", &skyboxData.cubeMapLevel);
+				skyboxData.descriptorSet->setUniform(skyboxData.lodLevel, &skyboxData.cubeMapLevel);
 				skyboxData.descriptorSet->update(rendererData.commandBuffer);
 
 				auto &constants = skyboxData.skyboxShader->getPushConstants();
@@ -189,14 +189,19 @@ namespace maple
 
 	namespace skybox_renderer
 	{
-		auto registerSkyboxRenderer(ExecuteQueue &begin, ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint) -> void
+		auto registerSkyboxRenderer(ExecuteQueue &begin, ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint, frame_graph::FrameGraph::PassBuilder pass) -> void
 		{
+			pass.read(GBufferTextures::POSITION)
+			    .write(GBufferTextures::PSEUDO_SKY)
+			    .write(GBufferTextures::SCREEN);
+
 			executePoint->registerGlobalComponent<component::SkyboxData>([](auto &skybox) {
 				skybox.pseudoSkyshader        = Shader::create("shaders/PseudoSky.shader");
 				skybox.pseudoSkydescriptorSet = DescriptorSet::create({0, skybox.pseudoSkyshader.get()});
 				skybox.screenMesh             = Mesh::createQuad(true);
 				skybox.skyboxShader           = Shader::create("shaders/Skybox.shader");
 				skybox.descriptorSet          = DescriptorSet::create({0, skybox.skyboxShader.get()});
+				skybox.lodLevel               = skybox.descriptorSet->getUniformHandle(UniformId("UniformBufferObjectLod", "lodLevel"));
 				skybox.skyboxMesh             = Mesh::createCube();
 
 				skybox.irradianceMap  = TextureCube::create(1);
@@ -4,6 +4,8 @@
 #pragma once
 
 #include "Engine/Core.h"
+#include "FrameGraph.h"
+#include "RHI/DescriptorSet.h"
 #include "Renderer.h"
 #include "Scene/System/ExecutePoint.h"
 #include <IconsMaterialDesignIcons.h>
@@ -45,6 +47,7 @@ namespace maple
 			std::shared_ptr<Shader>        skyboxShader;
 			std::shared_ptr<Pipeline>      pipeline;
 			std::shared_ptr<DescriptorSet> descriptorSet;
+			UniformHandle                  lodLevel;        //resolved once when the descriptor set is created
 			std::shared_ptr<Mesh>          skyboxMesh;
 
 			bool pseudoSky = false;
@@ -70,6 +73,6 @@ namespace maple
 
 	namespace skybox_renderer
 	{
-		auto registerSkyboxRenderer(ExecuteQueue &begin, ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint) -> void;
+		auto registerSkyboxRenderer(ExecuteQueue &begin, ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> executePoint, frame_graph::FrameGraph::PassBuilder pass) -> void;
 	};
 }        // namespace maple
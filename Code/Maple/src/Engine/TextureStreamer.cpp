@@ -0,0 +1,252 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+#include "TextureStreamer.h"
+#include "RHI/StorageBuffer.h"
+#include "RHI/Texture.h"
+
+#include "Engine/Material.h"
+#include "Engine/Profiler.h"
+#include "Others/Console.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+
+namespace maple
+{
+	namespace
+	{
+		//a slot not drawn with for this many frames is given to another material
+		constexpr uint64_t SlotRecycleFrames = 300;
+		//keeps one frame from stalling on the copies when a whole scene comes into view
+		constexpr uint64_t MaxStreamBytesPerFrame = 32 * 1024 * 1024;
+		constexpr uint32_t MaxBias                = 4;
+
+		inline auto residentBytes(const Texture2D &texture, uint32_t mip) -> uint64_t
+		{
+			uint64_t bytes = 0;
+			for (auto level = mip; level < texture.getMipMapLevels(); level++)
+				bytes += Texture::getLevelSize(texture.getFormat(), std::max(texture.getWidth() >> level, 1u), std::max(texture.getHeight() >> level, 1u));
+			return bytes;
+		}
+
+		//the feedback stores lod * 16 + 512 as an unsigned value, see writeStreamingFeedback in DeferredColor.frag
+		inline auto decodeLod(uint32_t value)
+		{
+			return value / 16.f - 32.f;
+		}
+	}        // namespace
+
+	TextureStreamer::TextureStreamer(uint64_t budget) :
+	    budget(budget)
+	{
+		slots.resize(MaxFeedbackSlots);
+		stats.budget = budget;
+	}
+
+	auto TextureStreamer::beginFrame(uint32_t frameIndex, uint32_t frameCount) -> std::shared_ptr<StorageBuffer>
+	{
+		PROFILE_FUNCTION();
+		if (feedback.size() != frameCount)
+			feedback.resize(frameCount);
+
+		auto &buffer = feedback[frameIndex];
+		if (buffer == nullptr)
+		{
+			//read back by the cpu, GPU_TO_CPU memory is cached but not coherent
+			buffer     = StorageBuffer::create(sizeof(uint32_t) * MaxFeedbackSlots, nullptr, BufferOptions{false, (uint32_t) MemoryUsage::MEMORY_USAGE_GPU_TO_CPU, 0});
+			auto *lods = buffer->map();
+			std::memset(lods, 0xFF, sizeof(uint32_t) * MaxFeedbackSlots);
+			buffer->flush();
+			buffer->unmap();
+			return buffer;
+		}
+
+		//the frame which wrote it completed before its slot was reused
+		auto *lods = static_cast<uint32_t *>(buffer->map());
+		buffer->invalidate();
+		for (uint32_t i = 1; i < MaxFeedbackSlots; i++)
+		{
+			if (lods[i] != UINT32_MAX && slots[i].owner != nullptr)
+			{
+				slots[i].lod      = decodeLod(lods[i]);
+				slots[i].feedback = true;
+			}
+		}
+		std::memset(lods, 0xFF, sizeof(uint32_t) * MaxFeedbackSlots);
+		buffer->flush();
+		buffer->unmap();
+		return buffer;
+	}
+
+	auto TextureStreamer::request(Material *material, float projectedSize) -> void
+	{
+		PROFILE_FUNCTION();
+		const auto &textures = material->getTextures();
+
+		uint32_t slot     = 0;
+		bool     acquired = false;
+		for (auto texture : {&textures.albedo, &textures.normal, &textures.metallic, &textures.roughness, &textures.ao, &textures.emissive})
+		{
+			if (*texture == nullptr || !(*texture)->isStreamed())
+				continue;
+
+			if (!acquired)
+			{
+				slot     = acquireSlot(material);
+				acquired = true;
+			}
+
+			auto &entry = entries[texture->get()];
+			if (entry.texture.expired())
+				entry.texture = *texture;
+			entry.lastUsed = frame;
+
+			const auto size   = static_cast<float>(std::max((*texture)->getWidth(), (*texture)->getHeight()));
+			const auto levels = (*texture)->getMipMapLevels();
+
+			auto lod = static_cast<float>(levels - 1);
+			if (slots[slot].feedback)
+				lod = slots[slot].lod + std::log2(size);
+			else if (projectedSize > 0)
+				lod = std::log2(size / projectedSize);
+
+			const auto mip = std::min(static_cast<uint32_t>(std::max(lod, 0.f)) + stats.bias, levels - 1);
+			entry.wanted   = std::min(entry.wanted, mip);
+		}
+	}
+
+	auto TextureStreamer::update() -> void
+	{
+		PROFILE_FUNCTION();
+		stats.streamedIn = 0;
+		stats.evicted    = 0;
+
+		std::vector<std::pair<Entry *, std::shared_ptr<Texture2D>>> live;
+		live.reserve(entries.size());
+
+		uint64_t resident = 0;
+		for (auto iter = entries.begin(); iter != entries.end();)
+		{
+			if (auto texture = iter->second.texture.lock())
+			{
+				resident += residentBytes(*texture, texture->getResidentMip());
+				live.emplace_back(&iter->second, std::move(texture));
+				iter++;
+			}
+			else
+			{
+				iter = entries.erase(iter);
+			}
+		}
+
+		//least recently used first, the requests of this frame last
+		std::sort(live.begin(), live.end(), [](const auto &left, const auto &right) {
+			return left.first->lastUsed < right.first->lastUsed;
+		});
+
+		auto setMip = [&](Texture2D &texture, uint32_t mip) {
+			const auto before = residentBytes(texture, texture.getResidentMip());
+			texture.setResidentMip(mip);
+			const auto after = residentBytes(texture, texture.getResidentMip());
+			resident         = resident - before + after;
+			return after > before ? after - before : 0;
+		};
+
+		//the textures which were not drawn this frame give up their high mips first
+		for (auto &[entry, texture] : live)
+		{
+			if (resident <= budget || entry->lastUsed == frame)
+				break;
+			if (texture->getResidentMip() + 1 < texture->getMipMapLevels())
+			{
+				setMip(*texture, texture->getMipMapLevels() - 1);
+				stats.evicted++;
+			}
+		}
+
+		//then the drawn ones drop the mips finer than they asked for
+		for (auto &[entry, texture] : live)
+		{
+			if (resident <= budget)
+				break;
+			if (entry->wanted != UINT32_MAX && entry->wanted > texture->getResidentMip())
+			{
+				setMip(*texture, entry->wanted);
+				stats.evicted++;
+			}
+		}
+
+		bool     pressure = resident > budget;
+		uint64_t streamed = 0;
+		for (auto it = live.rbegin(); it != live.rend(); it++)
+		{
+			auto &[entry, texture] = *it;
+			const auto wanted      = entry->wanted;
+			entry->wanted          = UINT32_MAX;
+
+			if (wanted == UINT32_MAX || wanted >= texture->getResidentMip())
+				continue;
+
+			const auto extra = residentBytes(*texture, wanted) - residentBytes(*texture, texture->getResidentMip());
+			if (resident + extra > budget)
+			{
+				pressure = true;
+				continue;
+			}
+
+			if (streamed + extra > MaxStreamBytesPerFrame && streamed > 0)
+				continue;
+
+			streamed += setMip(*texture, wanted);
+			stats.streamedIn++;
+		}
+
+		//requests which do not fit make every texture one mip coarser, until there is room again
+		if (pressure && stats.bias < MaxBias)
+		{
+			stats.bias++;
+			LOGW("Texture streaming : {0} MB resident exceeds the budget of {1} MB, mip bias is {2}", resident >> 20, budget >> 20, stats.bias);
+		}
+		else if (!pressure && stats.bias > 0 && resident < budget / 2)
+		{
+			stats.bias--;
+		}
+
+		stats.residentBytes = resident;
+		stats.budget        = budget;
+		stats.textures      = static_cast<uint32_t>(live.size());
+		frame++;
+	}
+
+	auto TextureStreamer::acquireSlot(Material *material) -> uint32_t
+	{
+		auto &properties = material->getProperties();
+		auto  slot       = static_cast<uint32_t>(properties.feedbackSlot);
+
+		if (slot == 0 || slot >= MaxFeedbackSlots || slots[slot].owner != material)
+		{
+			//round robin over the free slots and the ones not drawn with for a while
+			slot = 0;
+			for (uint32_t i = 0; i < MaxFeedbackSlots - 1 && slot == 0; i++)
+			{
+				const auto candidate = nextSlot;
+				nextSlot             = nextSlot + 1 < MaxFeedbackSlots ? nextSlot + 1 : 1;
+				if (slots[candidate].owner == nullptr || slots[candidate].lastUsed + SlotRecycleFrames < frame)
+					slot = candidate;
+			}
+
+			if (slot == 0)
+				return 0;
+
+			slots[slot]             = {};
+			slots[slot].owner       = material;
+			properties.feedbackSlot = static_cast<float>(slot);
+			material->updateUniformBuffer();
+		}
+
+		slots[slot].lastUsed = frame;
+		return slot;
+	}
+}        // namespace maple
@@ -0,0 +1,96 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "Engine/Core.h"
+#include <cstdint>
+#include <memory>
+#include <unordered_map>
+#include <vector>
+
+namespace maple
+{
+	class Material;
+	class Texture2D;
+	class StorageBuffer;
+
+	/**
+	 * Keeps the streamed textures (TextureLoadOptions::streamed) within a gpu memory budget.
+	 * The G-buffer pass requests every material it draws with the size of the mesh on screen, and DeferredColor.frag
+	 * writes the mip the material is sampled with into a feedback buffer which is read back once its frame slot is reused.
+	 * A texture gets the mip the feedback asked for, or the one of its projected size while there is no feedback yet.
+	 * When the budget is exceeded the high mips of the textures used least recently are evicted first.
+	 */
+	class MAPLE_EXPORT TextureStreamer final
+	{
+	  public:
+		static constexpr uint32_t MaxFeedbackSlots = 4096;        //StreamingFeedback in DeferredColor.frag, slot 0 writes nothing
+
+		struct Stats
+		{
+			uint64_t residentBytes = 0;
+			uint64_t budget        = 0;
+			uint32_t textures      = 0;
+			uint32_t streamedIn    = 0;        //mip changes of the last update
+			uint32_t evicted       = 0;
+			uint32_t bias          = 0;        //mips all requests are made coarser by while the budget is too small
+		};
+
+		TextureStreamer(uint64_t budget);
+		NO_COPYABLE(TextureStreamer);
+
+		//reads back the feedback of the frame slot and returns the buffer the G-buffer pass of this frame writes into
+		auto beginFrame(uint32_t frameIndex, uint32_t frameCount) -> std::shared_ptr<StorageBuffer>;
+
+		/**
+		 * projectedSize : pixels the mesh covers on screen, 0 lets the feedback decide alone.
+		 * assigns the feedback slot of the material, so it has to be called before the material is bound.
+		 */
+		auto request(Material *material, float projectedSize) -> void;
+
+		//streams in the requested mips and evicts to stay within the budget, once per frame
+		auto update() -> void;
+
+		inline auto setBudget(uint64_t bytes)
+		{
+			budget = bytes;
+		}
+
+		inline auto getBudget() const
+		{
+			return budget;
+		}
+
+		inline auto &getStats() const
+		{
+			return stats;
+		}
+
+	  private:
+		struct Entry
+		{
+			std::weak_ptr<Texture2D> texture;
+			uint64_t                 lastUsed = 0;
+			uint32_t                 wanted   = UINT32_MAX;        //finest mip requested this frame
+		};
+
+		struct Slot
+		{
+			const Material *owner    = nullptr;        //only compared, the material may be gone already
+			uint64_t        lastUsed = 0;
+			float           lod      = 0;        //mip of a single texel texture the material is sampled with
+			bool            feedback = false;
+		};
+
+		auto acquireSlot(Material *material) -> uint32_t;
+
+		uint64_t budget = 0;
+		uint64_t frame  = 1;
+
+		std::unordered_map<Texture2D *, Entry>      entries;
+		std::vector<Slot>                           slots;
+		uint32_t                                    nextSlot = 1;
+		std::vector<std::shared_ptr<StorageBuffer>> feedback;        //one per frame in flight
+		Stats                                       stats;
+	};
+}        // namespace maple
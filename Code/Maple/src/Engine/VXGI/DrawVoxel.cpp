@@ -24,6 +24,8 @@ namespace maple
 			{
 				std::shared_ptr<Shader>                     shader;
 				std::vector<std::shared_ptr<DescriptorSet>> descriptors;
+				UniformHandle                               colorChannels;
+				UniformHandle                               volumeDimension;
 				struct
 				{
 					glm::mat4 mvp;
@@ -69,8 +71,8 @@ namespace maple
 					pipline.descriptors[0]->setTexture("uVoxelBuffer",
 					                                   render.drawMipmap ? voxelBuffer.voxelTexMipmap[render.direction] : voxelBuffer.voxelVolume[render.id], render.drawMipmap ? render.mipLevel : -1);
 
-					pipline.descriptors[0]->setUniform("UniformBufferObjectVert", "colorChannels", &render.colorChannels);
-					pipline.descriptors[0]->setUniform("UniformBufferObjectVert", "volumeDimension", &vDimension);
+					pipline.descriptors[0]->setUniform(pipline.colorChannels, &render.colorChannels);
+					pipline.descriptors[0]->setUniform(pipline.volumeDimension, &vDimension);
 
 					pipline.descriptors[0]->update(rendererData.commandBuffer);
 					pipline.descriptors[1]->setUniformBufferData("UniformBufferObjectGemo", &pipline.ubo);
@@ -104,8 +106,9 @@ namespace maple
 			}
 		}        // namespace draw_voxel
 
-		auto registerVXGIVisualization(ExecuteQueue &begin, ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> point) -> void
+		auto registerVXGIVisualization(ExecuteQueue &begin, ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> point, frame_graph::FrameGraph::PassBuilder pass) -> void
 		{
+			pass.require(frame_feature::VXGI).write(GBufferTextures::SCREEN);
 			point->registerGlobalComponent<global::component::DrawVoxelRender>();
 			point->registerGlobalComponent<global::component::DrawVoxelPipeline>([](auto &pipline) {
 				pipline.shader = Shader::create("shaders/VXGI/DrawVoxels.shader");
@@ -113,6 +116,8 @@ namespace maple
 				    DescriptorSet::create({0, pipline.shader.get()}));
 				pipline.descriptors.emplace_back(
 				    DescriptorSet::create({1, pipline.shader.get()}));
+				pipline.colorChannels   = pipline.descriptors[0]->getUniformHandle(UniformId("UniformBufferObjectVert", "colorChannels"));
+				pipline.volumeDimension = pipline.descriptors[0]->getUniformHandle(UniformId("UniformBufferObjectVert", "volumeDimension"));
 			});
 			point->registerWithinQueue<draw_voxel::system>(renderer);
 		}
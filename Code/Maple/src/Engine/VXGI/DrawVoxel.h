@@ -3,6 +3,7 @@
 //////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "Engine/Core.h"
+#include "Engine/Renderer/FrameGraph.h"
 #include "VoxelBufferId.h"
 #include <glm/glm.hpp>
 #include <memory>
@@ -26,6 +27,6 @@ namespace maple
 				int32_t           direction     = 0;
 			};
 		}        // namespace global::component
-		auto registerVXGIVisualization(ExecuteQueue &begin, ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> point) -> void;
+		auto registerVXGIVisualization(ExecuteQueue &begin, ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> point, frame_graph::FrameGraph::PassBuilder pass) -> void;
 	}        // namespace vxgi_debug
 };           // namespace maple
\ No newline at end of file
@@ -18,6 +18,7 @@
 #include "Scene/Component/Transform.h"
 #include "Scene/System/ExecutePoint.h"
 
+#include "RHI/GPUProfile.h"
 #include "RHI/Pipeline.h"
 #include "RHI/Shader.h"
 #include "RHI/Texture.h"
@@ -47,6 +48,8 @@ namespace maple
 				{
 					std::shared_ptr<Shader>                     shader;
 					std::vector<std::shared_ptr<DescriptorSet>> descriptors;
+					UniformHandle                               lights;
+					UniformHandle                               lightCount;
 
 					struct UniformBufferVX
 					{
@@ -62,24 +65,44 @@ namespace maple
 				{
 					std::shared_ptr<Shader>                     shader;
 					std::vector<std::shared_ptr<DescriptorSet>> descriptors;
+					UniformHandle                               mipDimension;        //the same for every mip level, they share the shader
+					UniformHandle                               mipLevel;
 				};
 
 				struct VoxelMipmapBasePipline
 				{
 					std::shared_ptr<Shader>                     shader;
 					std::vector<std::shared_ptr<DescriptorSet>> descriptors;
+					UniformHandle                               mipDimension;
 				};
 
 				struct VoxelRadiancePropagationPipline
 				{
 					std::shared_ptr<Shader>                     shader;
 					std::vector<std::shared_ptr<DescriptorSet>> descriptors;
+					UniformHandle                               maxTracingDistance;
+					UniformHandle                               volumeDimension;
 				};
 
 				struct IndirectLightPipeline
 				{
 					std::shared_ptr<Shader>                     shader;
 					std::vector<std::shared_ptr<DescriptorSet>> descriptors;
+
+					struct Uniforms
+					{
+						UniformHandle cameraPosition;
+						UniformHandle volumeDimension;
+						UniformHandle voxelScale;
+						UniformHandle worldSize;
+						UniformHandle maxTracingDistance;
+						UniformHandle aoFalloff;
+						UniformHandle aoAlpha;
+						UniformHandle bounceStrength;
+						UniformHandle samplingFactor;
+						UniformHandle worldMinPoint;
+						UniformHandle worldMaxPoint;
+					} uniforms;
 				};
 			}        // namespace component
 		}            // namespace global
@@ -133,6 +156,15 @@ namespace maple
 					if (i != MaterialBinding)
 						buffer.descriptors[i] = DescriptorSet::create({i, buffer.voxelShader.get()});
 				}
+
+				auto &geometry                   = *buffer.descriptors[GeometryUniform];
+				buffer.uniforms.projView         = buffer.descriptors[VertexUniform]->getUniformHandle(UniformId("UniformBufferObjectVert", "projView"));
+				buffer.uniforms.viewProjections  = geometry.getUniformHandle(UniformId("UniformBufferGemo", "viewProjections"));
+				buffer.uniforms.viewProjectionsI = geometry.getUniformHandle(UniformId("UniformBufferGemo", "viewProjectionsI"));
+				buffer.uniforms.worldMinPoint    = geometry.getUniformHandle(UniformId("UniformBufferGemo", "worldMinPoint"));
+				buffer.uniforms.voxelScale       = geometry.getUniformHandle(UniformId("UniformBufferGemo", "voxelScale"));
+				buffer.uniforms.volumeDimension  = geometry.getUniformHandle(UniformId("UniformBufferGemo", "volumeDimension"));
+				buffer.uniforms.flagStaticVoxels = buffer.descriptors[FragmentUniform]->getUniformHandle(UniformId("UniformBufferObject", "flagStaticVoxels"));
 			}
 
 			using LightDefine = ecs::Registry ::Modify<maple::component::Light>;
@@ -159,8 +191,8 @@ namespace maple
 					numLights++;
 				});
 
-				injection.descriptors[0]->setUniform("UniformBufferLight", "lights", lights, sizeof(maple::component::LightData) * numLights, false);
-				injection.descriptors[0]->setUniform("UniformBufferLight", "lightCount", &numLights);
+				injection.descriptors[0]->setUniform(injection.lights, lights, sizeof(maple::component::LightData) * numLights, false);
+				injection.descriptors[0]->setUniform(injection.lightCount, &numLights);
 
 				injection.uniformData.traceShadowHit = voxel.traceShadowHit;
 
@@ -205,6 +237,10 @@ namespace maple
 						if (!mesh.active)
 							return;
 
+						//the voxelization reads the float vertex layout
+						if (mesh.mesh->isCompressed())
+							continue;
+
 						auto &cmd     = buffer.commandQueue.emplace_back();
 						cmd.mesh      = mesh.mesh.get();
 						cmd.transform = worldTransform;
@@ -261,7 +297,7 @@ namespace maple
 			    global::component::VoxelBuffer &             voxelBuffer,
 			    global::component::VoxelMipmapVolumePipline &volumePipline,
 			    maple::component::BoundingBoxComponent &     box,
-			    const maple::component::RendererData &renderData, bool updateDescriptor = true)
+			    const CommandBuffer *                        cmd, bool updateDescriptor = true)
 			{
 				auto mipmapDim = vxgi::component::Voxelization::voxelDimension / 4;        //64
 				//256
@@ -273,8 +309,8 @@ namespace maple
 
 					if (updateDescriptor)
 					{
-						volumePipline.descriptors[mipLvl]->setUniform("UniformBufferObject", "mipDimension", &volumeSize);
-						volumePipline.descriptors[mipLvl]->setUniform("UniformBufferObject", "mipLevel", &mipLvl);
+						volumePipline.descriptors[mipLvl]->setUniform(volumePipline.mipDimension, &volumeSize);
+						volumePipline.descriptors[mipLvl]->setUniform(volumePipline.mipLevel, &mipLvl);
 
 						volumePipline.descriptors[mipLvl]->setTexture("uVoxelMipmapIn",
 						                                              {voxelBuffer.voxelTexMipmap.begin(), voxelBuffer.voxelTexMipmap.end()});        //todo still bugs in vulkan
@@ -282,7 +318,7 @@ namespace maple
 						volumePipline.descriptors[mipLvl]->setTexture("uVoxelMipmapOut",
 						                                              {voxelBuffer.voxelTexMipmap.begin(), voxelBuffer.voxelTexMipmap.end()},
 						                                              mipLvl + 1);
-						volumePipline.descriptors[mipLvl]->update(renderData.commandBuffer);
+						volumePipline.descriptors[mipLvl]->update(cmd);
 					}
 
 					PipelineInfo pipelineInfo;
@@ -293,23 +329,23 @@ namespace maple
 					pipelineInfo.pipelineName = "VoxelMipmapVolumePipline-VXGI";
 
 					auto pipeline = Pipeline::get(pipelineInfo);
-					pipeline->bind(renderData.commandBuffer);
-					Renderer::bindDescriptorSets(pipeline.get(), renderData.commandBuffer, 0, {volumePipline.descriptors[mipLvl]});
+					pipeline->bind(cmd);
+					Renderer::bindDescriptorSets(pipeline.get(), cmd, 0, {volumePipline.descriptors[mipLvl]});
 					Renderer::dispatch(
-					    renderData.commandBuffer,
+					    cmd,
 					    pipelineInfo.groupCountX,
 					    pipelineInfo.groupCountY,
 					    pipelineInfo.groupCountZ);
 
-					Renderer::memoryBarrier(renderData.commandBuffer, MemoryBarrierFlags::Shader_Image_Access_Barrier);
+					Renderer::memoryBarrier(cmd, MemoryBarrierFlags::Shader_Image_Access_Barrier);
 
-					pipeline->end(renderData.commandBuffer);
+					pipeline->end(cmd);
 				}
 			}
 
 			inline auto generateMipmapMipmap(
 			    const std::shared_ptr<Texture3D> &         voxelRadiance,
-			    const maple::component::RendererData &     renderData,
+			    const CommandBuffer *                      cmd,
 			    global::component::VoxelBuffer &           buffer,
 			    global::component::VoxelMipmapBasePipline &pipline, bool updateDescriptor = true)
 			{
@@ -317,10 +353,10 @@ namespace maple
 
 				if (updateDescriptor)
 				{
-					pipline.descriptors[0]->setUniform("UniformBufferObject", "mipDimension", &halfDimension);
+					pipline.descriptors[0]->setUniform(pipline.mipDimension, &halfDimension);
 					pipline.descriptors[0]->setTexture("uVoxelBase", voxelRadiance);
 					pipline.descriptors[0]->setTexture("uVoxelMipmap", {buffer.voxelTexMipmap.begin(), buffer.voxelTexMipmap.end()});
-					pipline.descriptors[0]->update(renderData.commandBuffer);
+					pipline.descriptors[0]->update(cmd);
 				}
 
 				PipelineInfo pipelineInfo;
@@ -332,17 +368,17 @@ namespace maple
 				pipelineInfo.groupCountZ = halfDimension / pipline.shader->getLocalSizeZ();
 
 				auto pipeline = Pipeline::get(pipelineInfo);
-				pipeline->bind(renderData.commandBuffer);
-				Renderer::bindDescriptorSets(pipeline.get(), renderData.commandBuffer, 0, pipline.descriptors);
+				pipeline->bind(cmd);
+				Renderer::bindDescriptorSets(pipeline.get(), cmd, 0, pipline.descriptors);
 				Renderer::dispatch(
-				    renderData.commandBuffer,
+				    cmd,
 				    pipelineInfo.groupCountX,
 				    pipelineInfo.groupCountY,
 				    pipelineInfo.groupCountZ);
 
-				Renderer::memoryBarrier(renderData.commandBuffer, MemoryBarrierFlags::Shader_Image_Access_Barrier);
+				Renderer::memoryBarrier(cmd, MemoryBarrierFlags::Shader_Image_Access_Barrier);
 
-				pipeline->end(renderData.commandBuffer);
+				pipeline->end(cmd);
 			}
 
 			inline auto system(
@@ -364,9 +400,13 @@ namespace maple
 				if (!voxel.dirty && !hasUpdateRadiance)
 					return;
 
-				injection.descriptors[0]->update(renderData.commandBuffer);
+				//the radiance is sampled by the indirect lighting of the next frame, so it is computed on the async compute queue
+				auto cmd = renderData.computeCommandBuffer;
+				GPUProfile("VXGI Update Radiance", cmd);
+
+				injection.descriptors[0]->update(cmd);
 
-				buffer.voxelVolume[VoxelBufferId::Radiance]->clear(renderData.commandBuffer);
+				buffer.voxelVolume[VoxelBufferId::Radiance]->clear(cmd);
 
 				PipelineInfo pipelineInfo;
 				pipelineInfo.pipelineName = "VoxelRadianceInjectionPipline-VXGI";
@@ -377,32 +417,32 @@ namespace maple
 				pipelineInfo.groupCountZ = component::Voxelization::voxelDimension / injection.shader->getLocalSizeZ();
 
 				auto pipeline = Pipeline::get(pipelineInfo);
-				pipeline->bind(renderData.commandBuffer);
-				Renderer::bindDescriptorSets(pipeline.get(), renderData.commandBuffer, 0, injection.descriptors);
+				pipeline->bind(cmd);
+				Renderer::bindDescriptorSets(pipeline.get(), cmd, 0, injection.descriptors);
 				Renderer::dispatch(
-				    renderData.commandBuffer,
+				    cmd,
 				    pipelineInfo.groupCountX,
 				    pipelineInfo.groupCountY,
 				    pipelineInfo.groupCountZ);
 
-				Renderer::memoryBarrier(renderData.commandBuffer,
+				Renderer::memoryBarrier(cmd,
 				                        MemoryBarrierFlags::Texture_Fetch_Barrier | MemoryBarrierFlags::Shader_Storage_Barrier | MemoryBarrierFlags::Shader_Image_Access_Barrier);
 
-				pipeline->end(renderData.commandBuffer);
+				pipeline->end(cmd);
 
-				generateMipmapMipmap(buffer.voxelVolume[VoxelBufferId::Radiance], renderData, buffer, basePipeline);
-				generateMipmapVolume(buffer, volumePipline, box, renderData);
+				generateMipmapMipmap(buffer.voxelVolume[VoxelBufferId::Radiance], cmd, buffer, basePipeline);
+				generateMipmapVolume(buffer, volumePipline, box, cmd);
 
 				if (voxel.injectFirstBounce)
 				{
 					//propagation .............
-					propagation.descriptors[0]->setUniform("UniformBufferObject", "maxTracingDistanceGlobal", &voxel.maxTracingDistance);
-					propagation.descriptors[0]->setUniform("UniformBufferObject", "volumeDimension", &component::Voxelization::voxelDimension);
+					propagation.descriptors[0]->setUniform(propagation.maxTracingDistance, &voxel.maxTracingDistance);
+					propagation.descriptors[0]->setUniform(propagation.volumeDimension, &component::Voxelization::voxelDimension);
 					propagation.descriptors[0]->setTexture("uVoxelComposite", buffer.voxelVolume[VoxelBufferId::Radiance]);
 					propagation.descriptors[0]->setTexture("uVoxelAlbedo", buffer.voxelVolume[VoxelBufferId::Albedo]);
 					propagation.descriptors[0]->setTexture("uVoxelNormal", buffer.voxelVolume[VoxelBufferId::Normal]);
 					propagation.descriptors[0]->setTexture("uVoxelTexMipmap", {buffer.voxelTexMipmap.begin(), buffer.voxelTexMipmap.end()});
-					propagation.descriptors[0]->update(renderData.commandBuffer);
+					propagation.descriptors[0]->update(cmd);
 
 					PipelineInfo pipelineInfo;
 					pipelineInfo.shader       = propagation.shader;
@@ -412,21 +452,21 @@ namespace maple
 					pipelineInfo.pipelineName = "VoxelRadiancePropagationPipline-VXGI";
 
 					auto pipeline = Pipeline::get(pipelineInfo);
-					pipeline->bind(renderData.commandBuffer);
-					Renderer::bindDescriptorSets(pipeline.get(), renderData.commandBuffer, 0, propagation.descriptors);
+					pipeline->bind(cmd);
+					Renderer::bindDescriptorSets(pipeline.get(), cmd, 0, propagation.descriptors);
 					Renderer::dispatch(
-					    renderData.commandBuffer,
+					    cmd,
 					    pipelineInfo.groupCountX,
 					    pipelineInfo.groupCountY,
 					    pipelineInfo.groupCountZ);
 
-					Renderer::memoryBarrier(renderData.commandBuffer,
+					Renderer::memoryBarrier(cmd,
 					                        MemoryBarrierFlags::Texture_Fetch_Barrier | MemoryBarrierFlags::Shader_Storage_Barrier | MemoryBarrierFlags::Shader_Image_Access_Barrier);
 
-					pipeline->end(renderData.commandBuffer);
+					pipeline->end(cmd);
 
-					generateMipmapMipmap(buffer.voxelVolume[VoxelBufferId::Radiance], renderData, buffer, basePipeline, false);
-					generateMipmapVolume(buffer, volumePipline, box, renderData, false);
+					generateMipmapMipmap(buffer.voxelVolume[VoxelBufferId::Radiance], cmd, buffer, basePipeline, false);
+					generateMipmapVolume(buffer, volumePipline, box, cmd, false);
 				}
 
 				Application::getRenderDoc().endCapture();
@@ -469,7 +509,7 @@ namespace maple
 				}
 				//voxelize the whole scene now. this would be optimize in the future.
 				//voxelization the inner room is a good choice.
-				buffer.descriptors[DescriptorID::VertexUniform]->setUniform("UniformBufferObjectVert", "projView", &cameraView.projView);
+				buffer.descriptors[DescriptorID::VertexUniform]->setUniform(buffer.uniforms.projView, &cameraView.projView);
 				buffer.descriptors[DescriptorID::VertexUniform]->update(renderData.commandBuffer);
 
 				buffer.descriptors[DescriptorID::FragmentUniform]->setTexture("uVoxelAlbedo", buffer.voxelVolume[VoxelBufferId::Albedo]);
@@ -565,15 +605,15 @@ namespace maple
 						const float voxelScale = 1.f / voxelization.volumeGridSize;
 						const float dimension  = component::Voxelization::voxelDimension;
 
-						voxelBuffer.descriptors[DescriptorID::GeometryUniform]->setUniform("UniformBufferGemo", "viewProjections", &voxelBuffer.viewProj);
-						voxelBuffer.descriptors[DescriptorID::GeometryUniform]->setUniform("UniformBufferGemo", "viewProjectionsI", &voxelBuffer.viewProjInverse);
-						voxelBuffer.descriptors[DescriptorID::GeometryUniform]->setUniform("UniformBufferGemo", "worldMinPoint", &box.box->min);
-						voxelBuffer.descriptors[DescriptorID::GeometryUniform]->setUniform("UniformBufferGemo", "voxelScale", &voxelScale);
-						voxelBuffer.descriptors[DescriptorID::GeometryUniform]->setUniform("UniformBufferGemo", "volumeDimension", &dimension);
+						voxelBuffer.descriptors[DescriptorID::GeometryUniform]->setUniform(voxelBuffer.uniforms.viewProjections, &voxelBuffer.viewProj);
+						voxelBuffer.descriptors[DescriptorID::GeometryUniform]->setUniform(voxelBuffer.uniforms.viewProjectionsI, &voxelBuffer.viewProjInverse);
+						voxelBuffer.descriptors[DescriptorID::GeometryUniform]->setUniform(voxelBuffer.uniforms.worldMinPoint, &box.box->min);
+						voxelBuffer.descriptors[DescriptorID::GeometryUniform]->setUniform(voxelBuffer.uniforms.voxelScale, &voxelScale);
+						voxelBuffer.descriptors[DescriptorID::GeometryUniform]->setUniform(voxelBuffer.uniforms.volumeDimension, &dimension);
 						voxelBuffer.descriptors[DescriptorID::GeometryUniform]->update(rendererData.commandBuffer);
 
 						uint32_t flagVoxel = 1;
-						voxelBuffer.descriptors[DescriptorID::FragmentUniform]->setUniform("UniformBufferObject", "flagStaticVoxels", &flagVoxel);
+						voxelBuffer.descriptors[DescriptorID::FragmentUniform]->setUniform(voxelBuffer.uniforms.flagStaticVoxels, &flagVoxel);
 						voxelBuffer.descriptors[DescriptorID::FragmentUniform]->update(rendererData.commandBuffer);
 
 						voxelization.dirty = true;
@@ -595,17 +635,17 @@ namespace maple
 				auto [vxgi] = entity;
 
 				float scale = 1.f / vxgi.volumeGridSize;
-				pipeline.descriptors[0]->setUniform("UniformBufferVXGI", "cameraPosition", glm::value_ptr(glm::vec4(cameraView.cameraTransform->getWorldPosition(), 1.f)));
-				pipeline.descriptors[0]->setUniform("UniformBufferVXGI", "volumeDimension", &vxgi::component::Voxelization::voxelDimension);
-				pipeline.descriptors[0]->setUniform("UniformBufferVXGI", "voxelScale", &scale);
-				pipeline.descriptors[0]->setUniform("UniformBufferVXGI", "worldSize", &vxgi.volumeGridSize);
-				pipeline.descriptors[0]->setUniform("UniformBufferVXGI", "maxTracingDistanceGlobal", &vxgi.maxTracingDistance);
-				pipeline.descriptors[0]->setUniform("UniformBufferVXGI", "aoFalloff", &vxgi.aoFalloff);
-				pipeline.descriptors[0]->setUniform("UniformBufferVXGI", "aoAlpha", &vxgi.aoAlpha);
-				pipeline.descriptors[0]->setUniform("UniformBufferVXGI", "bounceStrength", &vxgi.bounceStrength);
-				pipeline.descriptors[0]->setUniform("UniformBufferVXGI", "samplingFactor", &vxgi.samplingFactor);
-				pipeline.descriptors[0]->setUniform("UniformBufferVXGI", "worldMinPoint", &vxgiBuffer.box.min);
-				pipeline.descriptors[0]->setUniform("UniformBufferVXGI", "worldMaxPoint", &vxgiBuffer.box.max);
+				pipeline.descriptors[0]->setUniform(pipeline.uniforms.cameraPosition, glm::value_ptr(glm::vec4(cameraView.cameraTransform->getWorldPosition(), 1.f)));
+				pipeline.descriptors[0]->setUniform(pipeline.uniforms.volumeDimension, &vxgi::component::Voxelization::voxelDimension);
+				pipeline.descriptors[0]->setUniform(pipeline.uniforms.voxelScale, &scale);
+				pipeline.descriptors[0]->setUniform(pipeline.uniforms.worldSize, &vxgi.volumeGridSize);
+				pipeline.descriptors[0]->setUniform(pipeline.uniforms.maxTracingDistance, &vxgi.maxTracingDistance);
+				pipeline.descriptors[0]->setUniform(pipeline.uniforms.aoFalloff, &vxgi.aoFalloff);
+				pipeline.descriptors[0]->setUniform(pipeline.uniforms.aoAlpha, &vxgi.aoAlpha);
+				pipeline.descriptors[0]->setUniform(pipeline.uniforms.bounceStrength, &vxgi.bounceStrength);
+				pipeline.descriptors[0]->setUniform(pipeline.uniforms.samplingFactor, &vxgi.samplingFactor);
+				pipeline.descriptors[0]->setUniform(pipeline.uniforms.worldMinPoint, &vxgiBuffer.box.min);
+				pipeline.descriptors[0]->setUniform(pipeline.uniforms.worldMaxPoint, &vxgiBuffer.box.max);
 			}
 		}        // namespace indirect_lighting_setup
 
@@ -674,6 +714,8 @@ namespace maple
 				injection.shader = Shader::create("shaders/VXGI/InjectRadiance.shader");
 				injection.descriptors.emplace_back(
 				    DescriptorSet::create({0, injection.shader.get()}));
+				injection.lights     = injection.descriptors[0]->getUniformHandle(UniformId("UniformBufferLight", "lights"));
+				injection.lightCount = injection.descriptors[0]->getUniformHandle(UniformId("UniformBufferLight", "lightCount"));
 			});
 
 			point->registerGlobalComponent<global::component::VoxelMipmapVolumePipline>([](auto &pipline) {
@@ -686,24 +728,42 @@ namespace maple
 					pipline.descriptors.emplace_back(
 					    DescriptorSet::create({0, pipline.shader.get()}));
 				}
+				pipline.mipDimension = pipline.descriptors[0]->getUniformHandle(UniformId("UniformBufferObject", "mipDimension"));
+				pipline.mipLevel     = pipline.descriptors[0]->getUniformHandle(UniformId("UniformBufferObject", "mipLevel"));
 			});
 
 			point->registerGlobalComponent<global::component::VoxelMipmapBasePipline>([](auto &pipline) {
 				pipline.shader = Shader::create("shaders/VXGI/AnisoMipmapBase.shader");
 				pipline.descriptors.emplace_back(
 				    DescriptorSet::create({0, pipline.shader.get()}));
+				pipline.mipDimension = pipline.descriptors[0]->getUniformHandle(UniformId("UniformBufferObject", "mipDimension"));
 			});
 
 			point->registerGlobalComponent<global::component::VoxelRadiancePropagationPipline>([](auto &pipline) {
 				pipline.shader = Shader::create("shaders/VXGI/PropagationRadiance.shader");
 				pipline.descriptors.emplace_back(
 				    DescriptorSet::create({0, pipline.shader.get()}));
+				pipline.maxTracingDistance = pipline.descriptors[0]->getUniformHandle(UniformId("UniformBufferObject", "maxTracingDistanceGlobal"));
+				pipline.volumeDimension    = pipline.descriptors[0]->getUniformHandle(UniformId("UniformBufferObject", "volumeDimension"));
 			});
 
 			point->registerGlobalComponent<global::component::IndirectLightPipeline>([](auto &pipeline) {
 				pipeline.shader = Shader::create("shaders/VXGI/IndirectLight.shader");
 				pipeline.descriptors.emplace_back(
 				    DescriptorSet::create({0, pipeline.shader.get()}));
+
+				auto &set                            = *pipeline.descriptors[0];
+				pipeline.uniforms.cameraPosition     = set.getUniformHandle(UniformId("UniformBufferVXGI", "cameraPosition"));
+				pipeline.uniforms.volumeDimension    = set.getUniformHandle(UniformId("UniformBufferVXGI", "volumeDimension"));
+				pipeline.uniforms.voxelScale         = set.getUniformHandle(UniformId("UniformBufferVXGI", "voxelScale"));
+				pipeline.uniforms.worldSize          = set.getUniformHandle(UniformId("UniformBufferVXGI", "worldSize"));
+				pipeline.uniforms.maxTracingDistance = set.getUniformHandle(UniformId("UniformBufferVXGI", "maxTracingDistanceGlobal"));
+				pipeline.uniforms.aoFalloff          = set.getUniformHandle(UniformId("UniformBufferVXGI", "aoFalloff"));
+				pipeline.uniforms.aoAlpha            = set.getUniformHandle(UniformId("UniformBufferVXGI", "aoAlpha"));
+				pipeline.uniforms.bounceStrength     = set.getUniformHandle(UniformId("UniformBufferVXGI", "bounceStrength"));
+				pipeline.uniforms.samplingFactor     = set.getUniformHandle(UniformId("UniformBufferVXGI", "samplingFactor"));
+				pipeline.uniforms.worldMinPoint      = set.getUniformHandle(UniformId("UniformBufferVXGI", "worldMinPoint"));
+				pipeline.uniforms.worldMaxPoint      = set.getUniformHandle(UniformId("UniformBufferVXGI", "worldMaxPoint"));
 			});
 		}
 
@@ -723,8 +783,14 @@ namespace maple
 			point->registerWithinQueue<update_radiance::system>(renderer);
 		}
 
-		auto registerVXGIIndirectLighting(ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> point) -> void
+		auto registerVXGIIndirectLighting(ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> point, frame_graph::FrameGraph::PassBuilder pass) -> void
 		{
+			pass.require(frame_feature::VXGI)
+			    .read(GBufferTextures::COLOR)
+			    .read(GBufferTextures::POSITION)
+			    .read(GBufferTextures::NORMALS)
+			    .read(GBufferTextures::PBR)
+			    .write(GBufferTextures::INDIRECT_LIGHTING);
 			point->registerWithinQueue<compute_indirect_light::system>(renderer);
 		}
 	}        // namespace vxgi
@@ -3,8 +3,10 @@
 //////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "Engine/Core.h"
+#include "Engine/Renderer/FrameGraph.h"
 #include "Math/BoundingBox.h"
 #include "RHI/Definitions.h"
+#include "RHI/DescriptorSet.h"
 #include "VoxelBufferId.h"
 #include <memory>
 
@@ -30,6 +32,18 @@ namespace maple
 				std::vector<std::shared_ptr<DescriptorSet>>                   descriptors;
 				std::vector<RenderCommand>                                    commandQueue;
 				std::shared_ptr<Texture2D>                                    colorBuffer;
+
+				//resolved once when the descriptor sets are created
+				struct Uniforms
+				{
+					UniformHandle projView;
+					UniformHandle viewProjections;
+					UniformHandle viewProjectionsI;
+					UniformHandle worldMinPoint;
+					UniformHandle voxelScale;
+					UniformHandle volumeDimension;
+					UniformHandle flagStaticVoxels;
+				} uniforms;
 			};
 		}        // namespace global::component
 
@@ -61,6 +75,6 @@ namespace maple
 		auto MAPLE_EXPORT registerGlobalComponent(std::shared_ptr<ExecutePoint> point) -> void;
 		auto              registerVoxelizer(ExecuteQueue &begin, ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> point) -> void;
 		auto              registerUpdateRadiace(ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> point) -> void;
-		auto              registerVXGIIndirectLighting(ExecuteQueue &begin, std::shared_ptr<ExecutePoint> point) -> void;
+		auto              registerVXGIIndirectLighting(ExecuteQueue &renderer, std::shared_ptr<ExecutePoint> point, frame_graph::FrameGraph::PassBuilder pass) -> void;
 	}        // namespace vxgi
 };           // namespace maple
\ No newline at end of file
@@ -9,6 +9,7 @@
 #include <array>
 #include <glm/glm.hpp>
 #include <glm/gtc/matrix_transform.hpp>
+#include <glm/gtc/type_precision.hpp>
 #include <glm/gtx/hash.hpp>
 namespace maple
 {
@@ -72,6 +73,27 @@ namespace maple
 		}
 	};
 
+	//attribute stream of a compressed Vertex, the position is in its own stream. see VertexCompression
+	struct CompressedVertex
+	{
+		glm::u8vec4  color;           //unorm8
+		glm::u16vec2 texCoord;        //half float
+		glm::i16vec2 normal;          //octahedral, snorm16
+		glm::i16vec2 tangent;         //octahedral, snorm16
+	};
+
+	struct CompressedSkinnedVertex
+	{
+		glm::u8vec4  color;
+		glm::u16vec2 texCoord;
+		glm::i16vec2 normal;
+		glm::i16vec2 tangent;
+		glm::u16vec4 boneIndices;
+		glm::u8vec4  boneWeights;        //unorm8, they sum up to 255
+	};
+
+	static_assert(sizeof(CompressedVertex) == 16 && sizeof(CompressedSkinnedVertex) == 28, "the size of the compressed vertices is part of BufferLayout::get");
+
 	struct Vertex2D
 	{
 		glm::vec3   vertex;
@@ -0,0 +1,172 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+#include "VertexCompression.h"
+#include "Engine/Profiler.h"
+#include "Math/BoundingBox.h"
+#include "Others/Console.h"
+
+#include <algorithm>
+#include <limits>
+#include <glm/gtc/packing.hpp>
+
+namespace maple
+{
+	namespace
+	{
+		thread_local VertexCompression::Scope *currentScope = nullptr;
+
+		inline auto quantize(const BoundingBox &boundingBox) -> VertexCompression::Quantization
+		{
+			VertexCompression::Quantization quantization;
+			const auto                      extent = boundingBox.max - boundingBox.min;
+			quantization.offset                    = glm::vec4(boundingBox.min, 0.f);
+			//flat meshes do not divide by zero along the axis they do not extend in
+			quantization.scale = glm::vec4(glm::max(extent, glm::vec3(std::numeric_limits<float>::epsilon())), 0.f);
+			return quantization;
+		}
+
+		inline auto packPosition(const glm::vec3 &pos, const VertexCompression::Quantization &quantization) -> glm::u16vec4
+		{
+			const auto normalized = glm::clamp((pos - glm::vec3(quantization.offset)) / glm::vec3(quantization.scale), 0.f, 1.f);
+			return glm::u16vec4(glm::round(normalized * 65535.f), 0);
+		}
+
+		template <typename T, typename C>
+		inline auto packAttributes(const T &vertex, C &compressed) -> void
+		{
+			compressed.color    = glm::u8vec4(glm::round(glm::clamp(vertex.color, 0.f, 1.f) * 255.f));
+			compressed.texCoord = glm::u16vec2(glm::packHalf1x16(vertex.texCoord.x), glm::packHalf1x16(vertex.texCoord.y));
+			compressed.normal   = VertexCompression::encodeOctahedral(vertex.normal);
+			compressed.tangent  = VertexCompression::encodeOctahedral(vertex.tangent);
+		}
+
+		//unorm8 weights summing up to 255, what rounding loses goes to the largest one
+		inline auto packWeights(const glm::vec4 &weights) -> glm::u8vec4
+		{
+			const auto sum = weights.x + weights.y + weights.z + weights.w;
+			if (sum <= 0.f)
+				return glm::u8vec4(255, 0, 0, 0);
+
+			const auto normalized = weights / sum;
+			glm::ivec4 packed     = glm::ivec4(glm::round(normalized * 255.f));
+			int32_t    largest    = 0;
+			for (int32_t i = 1; i < 4; i++)
+			{
+				if (packed[i] > packed[largest])
+					largest = i;
+			}
+			packed[largest] += 255 - (packed.x + packed.y + packed.z + packed.w);
+			return glm::u8vec4(glm::clamp(packed, 0, 255));
+		}
+	}        // namespace
+
+	VertexCompression::Scope::Scope(const std::string &name, bool enabled) :
+	    previous(currentScope),
+	    name(name),
+	    enabled(enabled)
+	{
+		if (enabled)
+			currentScope = this;
+	}
+
+	VertexCompression::Scope::~Scope()
+	{
+		if (!enabled)
+			return;
+
+		currentScope = previous;
+		if (vertexCount == 0)
+			return;
+
+		constexpr double KB = 1024.0;
+		LOGI("VertexCompression : {0}, {1} vertices, {2:.1f} KB -> {3:.1f} KB, depth passes fetch {4:.1f} KB instead of {5:.1f} KB",
+		     name, vertexCount, floatBytes / KB, compressedBytes / KB, depthBytes / KB, depthFloatBytes / KB);
+	}
+
+	auto VertexCompression::isEnabled() -> bool
+	{
+		return currentScope != nullptr;
+	}
+
+	auto VertexCompression::compress(const Vertex *vertices, uint32_t vertexCount, const BoundingBox &boundingBox) -> Streams
+	{
+		PROFILE_FUNCTION();
+		Streams streams;
+		streams.quantization = quantize(boundingBox);
+		streams.positions.resize(vertexCount);
+		streams.attributes.resize(vertexCount * sizeof(CompressedVertex));
+
+		auto attributes = reinterpret_cast<CompressedVertex *>(streams.attributes.data());
+		for (uint32_t i = 0; i < vertexCount; i++)
+		{
+			streams.positions[i] = packPosition(vertices[i].pos, streams.quantization);
+			packAttributes(vertices[i], attributes[i]);
+		}
+		account(vertexCount, sizeof(Vertex), sizeof(CompressedVertex), sizeof(glm::u16vec4));
+		return streams;
+	}
+
+	auto VertexCompression::compress(const SkinnedVertex *vertices, uint32_t vertexCount, const BoundingBox &boundingBox) -> Streams
+	{
+		PROFILE_FUNCTION();
+		Streams streams;
+		streams.quantization = quantize(boundingBox);
+		streams.positions.resize(vertexCount);
+		streams.attributes.resize(vertexCount * sizeof(CompressedSkinnedVertex));
+
+		auto attributes = reinterpret_cast<CompressedSkinnedVertex *>(streams.attributes.data());
+		for (uint32_t i = 0; i < vertexCount; i++)
+		{
+			auto &vertex         = vertices[i];
+			streams.positions[i] = packPosition(vertex.pos, streams.quantization);
+			packAttributes(vertex, attributes[i]);
+			attributes[i].boneIndices = glm::u16vec4(glm::clamp(vertex.boneIndices, 0.f, 65535.f));
+			attributes[i].boneWeights = packWeights(vertex.boneWeights);
+		}
+		//the skinned shadows read the bones from the attribute stream as well
+		account(vertexCount, sizeof(SkinnedVertex), sizeof(CompressedSkinnedVertex), sizeof(glm::u16vec4) + sizeof(CompressedSkinnedVertex));
+		return streams;
+	}
+
+	auto VertexCompression::account(uint32_t vertexCount, uint32_t stride, uint32_t compressedStride, uint32_t depthStride) -> void
+	{
+		if (auto scope = currentScope)
+		{
+			scope->vertexCount += vertexCount;
+			scope->floatBytes += uint64_t(vertexCount) * stride;
+			scope->compressedBytes += uint64_t(vertexCount) * (sizeof(glm::u16vec4) + compressedStride);
+			//the float vertices are interleaved, a depth pass fetches all of them
+			scope->depthFloatBytes += uint64_t(vertexCount) * stride;
+			scope->depthBytes += uint64_t(vertexCount) * depthStride;
+		}
+	}
+
+	auto VertexCompression::encodeOctahedral(const glm::vec3 &direction) -> glm::i16vec2
+	{
+		const auto length = glm::abs(direction.x) + glm::abs(direction.y) + glm::abs(direction.z);
+		if (length <= 0.f)
+			return glm::i16vec2(0, 0);
+
+		auto n    = direction / length;
+		auto octa = glm::vec2(n.x, n.y);
+		if (n.z < 0.f)
+		{
+			octa = (1.f - glm::abs(glm::vec2(n.y, n.x))) * glm::vec2(n.x >= 0.f ? 1.f : -1.f, n.y >= 0.f ? 1.f : -1.f);
+		}
+		return glm::i16vec2(glm::round(glm::clamp(octa, -1.f, 1.f) * 32767.f));
+	}
+
+	auto VertexCompression::decodeOctahedral(const glm::i16vec2 &encoded) -> glm::vec3
+	{
+		const auto e = glm::max(glm::vec2(encoded) / 32767.f, -1.f);
+		auto       v = glm::vec3(e.x, e.y, 1.f - glm::abs(e.x) - glm::abs(e.y));
+		if (v.z < 0.f)
+		{
+			const auto xy = (1.f - glm::abs(glm::vec2(v.y, v.x))) * glm::vec2(v.x >= 0.f ? 1.f : -1.f, v.y >= 0.f ? 1.f : -1.f);
+			v.x           = xy.x;
+			v.y           = xy.y;
+		}
+		return glm::normalize(v);
+	}
+}        // namespace maple
@@ -0,0 +1,74 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "Engine/Core.h"
+#include "Engine/Vertex.h"
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace maple
+{
+	class BoundingBox;
+
+	/**
+	 * Packs the vertices of a mesh into two streams. The positions go into their own stream as unorm16 relative to the
+	 * bounds of the mesh, so the depth only passes fetch 8 bytes per vertex. The other attributes are packed into
+	 * CompressedVertex/CompressedSkinnedVertex : unorm8 colors, half float uvs and octahedral normals and tangents.
+	 * The pipelines pick the streams by VertexLayout, see BufferLayout::get.
+	 */
+	class MAPLE_EXPORT VertexCompression final
+	{
+	  public:
+		//offset.xyz + position.xyz * scale.xyz is the position in the space of the mesh
+		struct Quantization
+		{
+			glm::vec4 offset = glm::vec4(0.f);
+			glm::vec4 scale  = glm::vec4(1.f);
+		};
+
+		struct Streams
+		{
+			std::vector<glm::u16vec4> positions;
+			std::vector<uint8_t>      attributes;
+			Quantization              quantization;
+		};
+
+		/**
+		 * the meshes created on this thread while it lives are compressed. what they take before and after is
+		 * logged when it ends. a scope which is not enabled does nothing
+		 */
+		class MAPLE_EXPORT Scope final
+		{
+		  public:
+			Scope(const std::string &name, bool enabled = true);
+			~Scope();
+			NO_COPYABLE(Scope);
+
+		  private:
+			friend class VertexCompression;
+			Scope *     previous = nullptr;
+			std::string name;
+			bool        enabled         = true;
+			uint64_t    vertexCount     = 0;
+			uint64_t    floatBytes      = 0;
+			uint64_t    compressedBytes = 0;
+			uint64_t    depthFloatBytes = 0;
+			uint64_t    depthBytes      = 0;
+		};
+
+		//whether a scope is alive on this thread
+		static auto isEnabled() -> bool;
+
+		static auto compress(const Vertex *vertices, uint32_t vertexCount, const BoundingBox &boundingBox) -> Streams;
+		static auto compress(const SkinnedVertex *vertices, uint32_t vertexCount, const BoundingBox &boundingBox) -> Streams;
+
+		static auto encodeOctahedral(const glm::vec3 &direction) -> glm::i16vec2;
+		static auto decodeOctahedral(const glm::i16vec2 &encoded) -> glm::vec3;
+
+	  private:
+		//bytes per vertex of the float layout, the attribute stream and what a depth pass fetches
+		static auto account(uint32_t vertexCount, uint32_t stride, uint32_t compressedStride, uint32_t depthStride) -> void;
+	};
+}        // namespace maple
@@ -2,6 +2,7 @@
 // This file is part of the Maple Engine                              		//
 //////////////////////////////////////////////////////////////////////////////
 #include "File.h"
+#include <algorithm>
 #include <cstdio>
 #include <cstring>
 #include <exception>
@@ -22,6 +23,129 @@ namespace maple
 	// 128 MB.
 	const size_t CHUNK_SIZE = 134217728;
 
+	namespace
+	{
+		//RFC 1321
+		class Md5
+		{
+		  public:
+			auto update(const uint8_t *data, uint64_t size) -> void
+			{
+				auto used = static_cast<uint32_t>(length & 63);
+				length += size;
+				while (size > 0)
+				{
+					const auto count = std::min<uint64_t>(64 - used, size);
+					std::memcpy(block + used, data, count);
+					used += static_cast<uint32_t>(count);
+					data += count;
+					size -= count;
+					if (used == 64)
+					{
+						transform();
+						used = 0;
+					}
+				}
+			}
+
+			auto finish() -> std::string
+			{
+				const uint64_t bits       = length * 8;
+				const uint8_t  padding[64] = {0x80};
+				const auto     used       = static_cast<uint32_t>(length & 63);
+				update(padding, used < 56 ? 56 - used : 120 - used);
+
+				uint8_t size[8];
+				for (int32_t i = 0; i < 8; i++)
+					size[i] = static_cast<uint8_t>(bits >> (i * 8));
+				update(size, 8);
+
+				static constexpr char hex[] = "0123456789abcdef";
+				std::string           digest;
+				for (auto value : state)
+				{
+					for (int32_t i = 0; i < 4; i++)
+					{
+						const auto byte = static_cast<uint8_t>(value >> (i * 8));
+						digest += hex[byte >> 4];
+						digest += hex[byte & 15];
+					}
+				}
+				return digest;
+			}
+
+		  private:
+			auto transform() -> void
+			{
+				static constexpr uint32_t shifts[64] = {
+				    7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22, 7, 12, 17, 22,
+				    5, 9, 14, 20, 5, 9, 14, 20, 5, 9, 14, 20, 5, 9, 14, 20,
+				    4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23, 4, 11, 16, 23,
+				    6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21, 6, 10, 15, 21};
+
+				static constexpr uint32_t constants[64] = {
+				    0xd76aa478, 0xe8c7b756, 0x242070db, 0xc1bdceee, 0xf57c0faf, 0x4787c62a, 0xa8304613, 0xfd469501,
+				    0x698098d8, 0x8b44f7af, 0xffff5bb1, 0x895cd7be, 0x6b901122, 0xfd987193, 0xa679438e, 0x49b40821,
+				    0xf61e2562, 0xc040b340, 0x265e5a51, 0xe9b6c7aa, 0xd62f105d, 0x02441453, 0xd8a1e681, 0xe7d3fbc8,
+				    0x21e1cde6, 0xc33707d6, 0xf4d50d87, 0x455a14ed, 0xa9e3e905, 0xfcefa3f8, 0x676f02d9, 0x8d2a4c8a,
+				    0xfffa3942, 0x8771f681, 0x6d9d6122, 0xfde5380c, 0xa4beea44, 0x4bdecfa9, 0xf6bb4b60, 0xbebfbc70,
+				    0x289b7ec6, 0xeaa127fa, 0xd4ef3085, 0x04881d05, 0xd9d4d039, 0xe6db99e5, 0x1fa27cf8, 0xc4ac5665,
+				    0xf4292244, 0x432aff97, 0xab9423a7, 0xfc93a039, 0x655b59c3, 0x8f0ccc92, 0xffeff47d, 0x85845dd1,
+				    0x6fa87e4f, 0xfe2ce6e0, 0xa3014314, 0x4e0811a1, 0xf7537e82, 0xbd3af235, 0x2ad7d2bb, 0xeb86d391};
+
+				uint32_t words[16];
+				for (int32_t i = 0; i < 16; i++)
+					words[i] = block[i * 4] | (block[i * 4 + 1] << 8) | (block[i * 4 + 2] << 16) | (uint32_t(block[i * 4 + 3]) << 24);
+
+				uint32_t a = state[0];
+				uint32_t b = state[1];
+				uint32_t c = state[2];
+				uint32_t d = state[3];
+
+				for (uint32_t i = 0; i < 64; i++)
+				{
+					uint32_t f;
+					uint32_t g;
+					if (i < 16)
+					{
+						f = (b & c) | (~b & d);
+						g = i;
+					}
+					else if (i < 32)
+					{
+						f = (d & b) | (~d & c);
+						g = (5 * i + 1) & 15;
+					}
+					else if (i < 48)
+					{
+						f = b ^ c ^ d;
+						g = (3 * i + 5) & 15;
+					}
+					else
+					{
+						f = c ^ (b | ~d);
+						g = (7 * i) & 15;
+					}
+
+					const uint32_t value = a + f + constants[i] + words[g];
+					a                    = d;
+					d                    = c;
+					c                    = b;
+					b += (value << shifts[i]) | (value >> (32 - shifts[i]));
+				}
+
+				state[0] += a;
+				state[1] += b;
+				state[2] += c;
+				state[3] += d;
+			}
+
+			uint32_t state[4] = {0x67452301, 0xefcdab89, 0x98badcfe, 0x10325476};
+			uint8_t  block[64];
+			uint64_t length = 0;
+		};
+	}        // namespace
+
 	File::~File()
 	{
 		if (filePtr != nullptr)
@@ -67,7 +191,18 @@ namespace maple
 
 	auto File::getMd5() -> std::string
 	{
-		return "";
+		//read through a handle of its own, the position of this one is left as it is
+		auto input = fopen(file.c_str(), "rb");
+		if (input == nullptr)
+			return "";
+
+		Md5                  md5;
+		std::vector<uint8_t> buffer(1024 * 1024);
+		size_t               count;
+		while ((count = fread(buffer.data(), 1, buffer.size(), input)) > 0)
+			md5.update(buffer.data(), count);
+		fclose(input);
+		return md5.finish();
 	}
 
 	auto File::exists() -> bool
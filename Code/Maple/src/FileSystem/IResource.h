@@ -113,6 +113,7 @@ namespace maple
 	    {"jpg", FileType::Texture},
 	    {"png", FileType::Texture},
 	    {"tga", FileType::Texture},
+	    {"ktx2", FileType::Texture},
 	    {"lua", FileType::Script},
 	    {"cs", FileType::C_SHARP},
 	    {"glsl", FileType::Text},
@@ -64,6 +64,12 @@ namespace maple
 			return mipmaps;
 		}
 
+		//mips stored in data one after another, more than one when they came prebuilt from a ktx2 file
+		inline auto getLevels() const noexcept
+		{
+			return levels;
+		}
+
 		inline auto setPixelFormat(TextureFormat pixelFormat)
 		{
 			this->pixelFormat = pixelFormat;
@@ -92,6 +98,10 @@ namespace maple
 		{
 			this->mipmaps = mipmaps;
 		}
+		inline auto setLevels(uint32_t levels)
+		{
+			this->levels = levels;
+		}
 		inline auto setFileName(std::string fileName)
 		{
 			this->fileName = fileName;
@@ -114,6 +124,7 @@ namespace maple
 		void *        data        = nullptr;
 		uint32_t      size        = 0;
 		uint32_t      channel     = 0;
+		uint32_t      levels      = 1;
 		bool          mipmaps     = false;
 		bool          HDR         = false;
 		std::string   fileName;
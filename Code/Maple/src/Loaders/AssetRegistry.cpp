@@ -0,0 +1,333 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+#include "AssetRegistry.h"
+
+#include "Engine/Mesh.h"
+#include "Engine/Profiler.h"
+#include "FileSystem/MeshResource.h"
+#include "Others/Console.h"
+#include "RHI/IndexBuffer.h"
+#include "RHI/Shader.h"
+#include "RHI/Texture.h"
+#include "RHI/VertexBuffer.h"
+
+#include <algorithm>
+#include <cctype>
+#include <mutex>
+
+namespace maple
+{
+	namespace
+	{
+		//files checked for changes per frame
+		constexpr size_t WatchBatch = 64;
+
+		inline auto hashPath(const std::string &path) -> uint64_t
+		{
+			uint64_t hash = 14695981039346656037ull;
+			for (auto c : path)
+			{
+				hash ^= static_cast<uint8_t>(c);
+				hash *= 1099511628211ull;
+			}
+			return hash;
+		}
+
+		inline auto getWriteTime(const std::string &path)
+		{
+			std::error_code error;
+			auto            time = std::filesystem::last_write_time(path, error);
+			return error ? std::filesystem::file_time_type::min() : time;
+		}
+
+		inline auto reloadInPlace(AssetRegistry::Resources &resources) -> bool
+		{
+			bool reloaded = false;
+			for (auto &resource : resources)
+			{
+				if (resource->getResourceType() == FileType::Shader)
+				{
+					std::static_pointer_cast<Shader>(resource)->reload();
+					reloaded = true;
+				}
+				else if (auto texture = std::dynamic_pointer_cast<Texture2D>(resource))
+				{
+					reloaded = texture->reload() || reloaded;
+				}
+			}
+			return reloaded;
+		}
+	}        // namespace
+
+	auto AssetId::normalize(const std::string &path) -> std::string
+	{
+		auto normal = path;
+		std::replace(normal.begin(), normal.end(), '\\', '/');
+		normal = std::filesystem::path(normal).lexically_normal().generic_string();
+#ifdef _WIN32
+		std::transform(normal.begin(), normal.end(), normal.begin(), [](char c) { return static_cast<char>(std::tolower(static_cast<uint8_t>(c))); });
+#endif
+		return normal;
+	}
+
+	auto AssetId::of(const std::string &path, FileType type) -> AssetId
+	{
+		auto normal = normalize(path);
+		auto hash   = hashPath(normal);
+		return {std::move(normal), hash, static_cast<uint64_t>(type)};
+	}
+
+	auto AssetRegistry::getMemorySize(const Resources &resources) -> uint64_t
+	{
+		uint64_t bytes = 0;
+		for (auto &resource : resources)
+		{
+			if (auto texture = std::dynamic_pointer_cast<Texture2D>(resource))
+			{
+				const auto mip  = texture->getResidentMip();
+				const auto size = Texture::getLevelSize(texture->getFormat(), std::max(texture->getWidth() >> mip, 1u), std::max(texture->getHeight() >> mip, 1u));
+				//a full chain adds about a third
+				bytes += texture->getMipMapLevels() > 1 ? size * 4 / 3 : size;
+			}
+			else if (resource->getResourceType() == FileType::Model)
+			{
+				for (auto &mesh : std::static_pointer_cast<MeshResource>(resource)->getMeshes())
+				{
+					if (auto &vertexBuffer = mesh.second->getVertexBuffer())
+						bytes += vertexBuffer->getSize();
+					if (auto &positionBuffer = mesh.second->getPositionBuffer())
+						bytes += positionBuffer->getSize();
+					if (auto &indexBuffer = mesh.second->getIndexBuffer())
+						bytes += indexBuffer->getSize();
+				}
+			}
+		}
+		return bytes;
+	}
+
+	auto AssetRegistry::find(const AssetId &id) -> Resources
+	{
+		{
+			std::shared_lock<std::shared_mutex> lock(mutex);
+			auto                                iter = entries.find(id);
+			if (iter == entries.end())
+				return {};
+			if (!iter->second.resident.empty())
+			{
+				iter->second.lastUse = ++clock;
+				return iter->second.resident;
+			}
+		}
+
+		//evicted, it is resident again when it is still alive somewhere
+		std::unique_lock<std::shared_mutex> lock(mutex);
+		auto                                iter = entries.find(id);
+		if (iter == entries.end())
+			return {};
+
+		auto &entry = iter->second;
+		if (entry.resident.empty())
+		{
+			Resources resources;
+			for (auto &weak : entry.weak)
+			{
+				if (auto resource = weak.lock())
+					resources.emplace_back(resource);
+			}
+			if (resources.size() != entry.weak.size())
+			{
+				entries.erase(iter);
+				return {};
+			}
+			entry.resident = std::move(resources);
+			entry.weak.clear();
+			residentBytes += entry.bytes;
+		}
+		entry.lastUse = ++clock;
+		return entry.resident;
+	}
+
+	auto AssetRegistry::contains(const AssetId &id) -> bool
+	{
+		return !find(id).empty();
+	}
+
+	auto AssetRegistry::add(const AssetId &id, const std::string &path, const Resources &resources, const Reloader &reloader) -> Resources
+	{
+		PROFILE_FUNCTION();
+		const auto bytes     = getMemorySize(resources);
+		const auto writeTime = getWriteTime(path);
+
+		std::unique_lock<std::shared_mutex> lock(mutex);
+		auto [iter, added] = entries.try_emplace(id);
+		auto &entry        = iter->second;
+		if (!added)
+		{
+			if (!entry.resident.empty())
+			{
+				entry.lastUse = ++clock;
+				return entry.resident;
+			}
+			entry.weak.clear();
+		}
+
+		entry.path      = path;
+		entry.resident  = resources;
+		entry.bytes     = bytes;
+		entry.lastUse   = ++clock;
+		entry.writeTime = writeTime;
+		entry.reloader  = reloader;
+		residentBytes += bytes;
+		return entry.resident;
+	}
+
+	auto AssetRegistry::remove(const AssetId &id) -> void
+	{
+		Resources released;
+		{
+			std::unique_lock<std::shared_mutex> lock(mutex);
+			if (auto iter = entries.find(id); iter != entries.end())
+			{
+				if (!iter->second.resident.empty())
+					residentBytes -= iter->second.bytes;
+				released = std::move(iter->second.resident);
+				entries.erase(iter);
+			}
+		}
+	}
+
+	auto AssetRegistry::update() -> void
+	{
+		PROFILE_FUNCTION();
+		evict();
+		watch();
+	}
+
+	auto AssetRegistry::forEach(const std::function<void(const std::string &, const Resources &)> &func) -> void
+	{
+		//called without the lock, func may create or reload assets
+		std::vector<std::pair<std::string, Resources>> resident;
+		{
+			std::shared_lock<std::shared_mutex> lock(mutex);
+			resident.reserve(entries.size());
+			for (auto &entry : entries)
+			{
+				if (!entry.second.resident.empty())
+					resident.emplace_back(entry.second.path, entry.second.resident);
+			}
+		}
+		for (auto &entry : resident)
+			func(entry.first, entry.second);
+	}
+
+	auto AssetRegistry::evict() -> void
+	{
+		PROFILE_FUNCTION();
+		//destroyed once the lock is released
+		std::vector<Resources> released;
+
+		std::unique_lock<std::shared_mutex> lock(mutex);
+
+		std::vector<std::pair<uint64_t, Entry *>> unused;
+		std::vector<std::pair<uint64_t, Entry *>> used;
+
+		for (auto iter = entries.begin(); iter != entries.end();)
+		{
+			auto &entry = iter->second;
+			if (entry.resident.empty())
+			{
+				//evicted before and released by everyone since
+				if (std::all_of(entry.weak.begin(), entry.weak.end(), [](auto &weak) { return weak.expired(); }))
+				{
+					iter = entries.erase(iter);
+					continue;
+				}
+			}
+			else if (entry.bytes > 0)
+			{
+				const bool shared = std::any_of(entry.resident.begin(), entry.resident.end(), [](auto &resource) { return resource.use_count() > 1; });
+				(shared ? used : unused).emplace_back(entry.lastUse.load(), &entry);
+			}
+			++iter;
+		}
+
+		if (residentBytes <= budget)
+			return;
+
+		//what nothing refers to frees its memory right away, the rest once the last user lets it go
+		std::sort(unused.begin(), unused.end(), [](auto &a, auto &b) { return a.first < b.first; });
+		std::sort(used.begin(), used.end(), [](auto &a, auto &b) { return a.first < b.first; });
+		unused.insert(unused.end(), used.begin(), used.end());
+
+		for (auto &candidate : unused)
+		{
+			if (residentBytes <= budget)
+				break;
+			auto &entry = *candidate.second;
+			entry.weak.assign(entry.resident.begin(), entry.resident.end());
+			released.emplace_back(std::move(entry.resident));
+			entry.resident.clear();
+			residentBytes -= entry.bytes;
+		}
+	}
+
+	auto AssetRegistry::watch() -> void
+	{
+		PROFILE_FUNCTION();
+		if (watchCursor >= watchList.size())
+		{
+			std::shared_lock<std::shared_mutex> lock(mutex);
+			watchList.clear();
+			watchCursor = 0;
+			for (auto &entry : entries)
+			{
+				if (!entry.second.resident.empty() && entry.second.writeTime != std::filesystem::file_time_type::min())
+					watchList.emplace_back(entry.first);
+			}
+		}
+
+		for (size_t i = 0; i < WatchBatch && watchCursor < watchList.size(); i++)
+		{
+			const auto id = watchList[watchCursor++];
+
+			std::string                     path;
+			std::filesystem::file_time_type writeTime;
+			Resources                       resources;
+			Reloader                        reloader;
+			{
+				std::shared_lock<std::shared_mutex> lock(mutex);
+				auto                                iter = entries.find(id);
+				if (iter == entries.end() || iter->second.resident.empty())
+					continue;
+				path      = iter->second.path;
+				writeTime = iter->second.writeTime;
+				resources = iter->second.resident;
+				reloader  = iter->second.reloader;
+			}
+
+			const auto time = getWriteTime(path);
+			if (time == writeTime || time == std::filesystem::file_time_type::min())
+				continue;
+
+			//the resources stay the same objects where the type can reload itself, the users see the new content
+			const bool reloaded = reloader ? reloader(path, resources) : reloadInPlace(resources);
+
+			std::unique_lock<std::shared_mutex> lock(mutex);
+			auto                                iter = entries.find(id);
+			if (iter == entries.end())
+				continue;
+			auto &entry     = iter->second;
+			entry.writeTime = time;
+			if (reloaded && !entry.resident.empty())
+			{
+				const auto bytes = getMemorySize(resources);
+				residentBytes += bytes;
+				residentBytes -= entry.bytes;
+				entry.bytes    = bytes;
+				entry.resident = std::move(resources);
+			}
+			LOGI("AssetRegistry : {0} changed, {1}", path, reloaded ? "reloaded" : "it can not be reloaded");
+		}
+	}
+}        // namespace maple
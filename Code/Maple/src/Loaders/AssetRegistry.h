@@ -0,0 +1,141 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "Engine/Core.h"
+#include "FileSystem/IResource.h"
+#include <atomic>
+#include <cstdint>
+#include <filesystem>
+#include <functional>
+#include <memory>
+#include <shared_mutex>
+#include <string>
+#include <typeinfo>
+#include <unordered_map>
+#include <vector>
+
+namespace maple
+{
+	//the normalized path and the type of the asset, two spellings of one file are one asset
+	struct MAPLE_EXPORT AssetId
+	{
+		std::string path;
+		uint64_t    hash = 0;        //of the path
+		uint64_t    type = 0;        //FileType of an import, hash of the c++ type for the resources made by emplace
+
+		//lexically normal with '/' separators, lowercase on windows where the file system ignores the case
+		static auto normalize(const std::string &path) -> std::string;
+
+		static auto of(const std::string &path, FileType type) -> AssetId;
+
+		template <typename T>
+		static auto of(const std::string &path) -> AssetId
+		{
+			auto id = of(path, FileType::Normal);
+			id.type = typeid(T).hash_code();
+			return id;
+		}
+
+		inline auto operator==(const AssetId &other) const
+		{
+			return hash == other.hash && type == other.type && path == other.path;
+		}
+	};
+
+	struct AssetIdHash
+	{
+		inline auto operator()(const AssetId &id) const -> size_t
+		{
+			return static_cast<size_t>(id.hash ^ (id.type * 0x9E3779B97F4A7C15ull));
+		}
+	};
+
+	/**
+	 * Every asset the loaders and the create functions share, looked up from any thread.
+	 * The registry keeps the assets resident while they fit into the budget. Past it, the ones used least recently
+	 * and referred to by nothing else are evicted, they stay weakly registered so an asset still in use somewhere is
+	 * found again instead of being loaded twice. The files of the resident assets are watched and reloaded in place.
+	 */
+	class MAPLE_EXPORT AssetRegistry final
+	{
+	  public:
+		using Resources = std::vector<std::shared_ptr<IResource>>;
+		//main thread, the file of the asset changed. true when the resources were updated in place or replaced
+		using Reloader = std::function<bool(const std::string &path, Resources &resources)>;
+
+		static constexpr uint64_t DefaultBudget = 1024ull * 1024 * 1024;
+
+		AssetRegistry() = default;
+		NO_COPYABLE(AssetRegistry);
+
+		//empty when the asset is not registered or was evicted and released
+		auto find(const AssetId &id) -> Resources;
+		auto contains(const AssetId &id) -> bool;
+
+		//returns what is registered when another thread was quicker, so every caller shares one copy.
+		//without reloader the textures and shaders reload themselves
+		auto add(const AssetId &id, const std::string &path, const Resources &resources, const Reloader &reloader = nullptr) -> Resources;
+		auto remove(const AssetId &id) -> void;
+
+		template <typename T, typename... Args>
+		auto emplace(const std::string &path, Args &&... args) -> std::shared_ptr<T>;
+
+		//main thread, once per frame. evicts down to the budget and reloads a few changed files
+		auto update() -> void;
+
+		auto forEach(const std::function<void(const std::string &, const Resources &)> &func) -> void;
+
+		inline auto setBudget(uint64_t bytes)
+		{
+			budget = bytes;
+		}
+
+		inline auto getBudget() const
+		{
+			return budget;
+		}
+
+		inline auto getResidentBytes() const
+		{
+			return residentBytes.load();
+		}
+
+		static auto getMemorySize(const Resources &resources) -> uint64_t;
+
+	  private:
+		struct Entry
+		{
+			std::string                          path;
+			Resources                            resident;
+			std::vector<std::weak_ptr<IResource>> weak;
+			uint64_t                             bytes = 0;
+			std::atomic<uint64_t>                lastUse{0};
+			std::filesystem::file_time_type      writeTime;
+			Reloader                             reloader;
+		};
+
+		auto evict() -> void;
+		auto watch() -> void;
+
+		std::shared_mutex                                  mutex;
+		std::unordered_map<AssetId, Entry, AssetIdHash>    entries;
+		std::atomic<uint64_t>                              clock         = 0;
+		std::atomic<uint64_t>                              residentBytes = 0;
+		uint64_t                                           budget        = DefaultBudget;
+		std::vector<AssetId>                               watchList;
+		size_t                                             watchCursor = 0;
+	};
+
+	template <typename T, typename... Args>
+	auto AssetRegistry::emplace(const std::string &path, Args &&... args) -> std::shared_ptr<T>
+	{
+		//the type is part of the id, what is found was created as a T
+		const auto id = AssetId::of<T>(path);
+		if (auto resources = find(id); !resources.empty())
+			return std::static_pointer_cast<T>(resources[0]);
+
+		std::shared_ptr<IResource> resource = std::make_shared<T>(std::forward<Args>(args)...);
+		return std::static_pointer_cast<T>(add(id, path, {resource})[0]);
+	}
+}        // namespace maple
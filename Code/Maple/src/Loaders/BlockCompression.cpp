@@ -0,0 +1,338 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+#include "BlockCompression.h"
+#include "Engine/Profiler.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <utility>
+
+namespace maple
+{
+	namespace BlockCompression
+	{
+		namespace
+		{
+			inline auto to565(const float *rgb) -> uint16_t
+			{
+				auto quantize = [](float value, int32_t max) {
+					return static_cast<uint16_t>(std::clamp(static_cast<int32_t>(value / 255.f * max + 0.5f), 0, max));
+				};
+				return (quantize(rgb[0], 31) << 11) | (quantize(rgb[1], 63) << 5) | quantize(rgb[2], 31);
+			}
+
+			inline auto from565(uint16_t color, uint8_t *rgb) -> void
+			{
+				const uint8_t r = (color >> 11) & 31;
+				const uint8_t g = (color >> 5) & 63;
+				const uint8_t b = color & 31;
+				rgb[0]          = (r << 3) | (r >> 2);
+				rgb[1]          = (g << 2) | (g >> 4);
+				rgb[2]          = (b << 3) | (b >> 2);
+			}
+
+			//the palette of a color block, BC3 always uses four colors while BC1 switches to three and transparent black when c0 <= c1
+			inline auto colorPalette(const uint8_t *in, uint8_t palette[4][4], bool fourColor) -> void
+			{
+				const uint16_t c0 = in[0] | (in[1] << 8);
+				const uint16_t c1 = in[2] | (in[3] << 8);
+				from565(c0, palette[0]);
+				from565(c1, palette[1]);
+				palette[0][3] = palette[1][3] = palette[2][3] = palette[3][3] = 255;
+
+				for (int32_t c = 0; c < 3; c++)
+				{
+					if (fourColor || c0 > c1)
+					{
+						palette[2][c] = static_cast<uint8_t>((2 * palette[0][c] + palette[1][c] + 1) / 3);
+						palette[3][c] = static_cast<uint8_t>((palette[0][c] + 2 * palette[1][c] + 1) / 3);
+					}
+					else
+					{
+						palette[2][c] = static_cast<uint8_t>((palette[0][c] + palette[1][c]) / 2);
+						palette[3][c] = 0;
+					}
+				}
+
+				if (!fourColor && c0 <= c1)
+					palette[3][3] = 0;
+			}
+
+			inline auto channelPalette(const uint8_t *in, uint8_t palette[8]) -> void
+			{
+				palette[0] = in[0];
+				palette[1] = in[1];
+				if (palette[0] > palette[1])
+				{
+					for (int32_t i = 1; i < 7; i++)
+						palette[i + 1] = static_cast<uint8_t>(((7 - i) * palette[0] + i * palette[1] + 3) / 7);
+				}
+				else
+				{
+					for (int32_t i = 1; i < 5; i++)
+						palette[i + 1] = static_cast<uint8_t>(((5 - i) * palette[0] + i * palette[1] + 2) / 5);
+					palette[6] = 0;
+					palette[7] = 255;
+				}
+			}
+
+			//endpoints along the principal axis of the colors, inset a little as the extremes are rarely hit exactly
+			auto encodeColor(const uint8_t *block, uint8_t *out) -> void
+			{
+				float mean[3] = {};
+				for (int32_t i = 0; i < 16; i++)
+					for (int32_t c = 0; c < 3; c++)
+						mean[c] += block[i * 4 + c] / 16.f;
+
+				float covariance[6] = {};
+				for (int32_t i = 0; i < 16; i++)
+				{
+					const float r = block[i * 4] - mean[0];
+					const float g = block[i * 4 + 1] - mean[1];
+					const float b = block[i * 4 + 2] - mean[2];
+					covariance[0] += r * r;
+					covariance[1] += r * g;
+					covariance[2] += r * b;
+					covariance[3] += g * g;
+					covariance[4] += g * b;
+					covariance[5] += b * b;
+				}
+
+				float axis[3] = {1.f, 1.f, 1.f};
+				for (int32_t iteration = 0; iteration < 8; iteration++)
+				{
+					const float x   = covariance[0] * axis[0] + covariance[1] * axis[1] + covariance[2] * axis[2];
+					const float y   = covariance[1] * axis[0] + covariance[3] * axis[1] + covariance[4] * axis[2];
+					const float z   = covariance[2] * axis[0] + covariance[4] * axis[1] + covariance[5] * axis[2];
+					const float max = std::max({std::abs(x), std::abs(y), std::abs(z)});
+					if (max < 1e-6f)
+						break;
+					axis[0] = x / max;
+					axis[1] = y / max;
+					axis[2] = z / max;
+				}
+
+				float minT = 0;
+				float maxT = 0;
+				for (int32_t i = 0; i < 16; i++)
+				{
+					const float t = (block[i * 4] - mean[0]) * axis[0] + (block[i * 4 + 1] - mean[1]) * axis[1] + (block[i * 4 + 2] - mean[2]) * axis[2];
+					minT          = std::min(minT, t);
+					maxT          = std::max(maxT, t);
+				}
+
+				const float length = axis[0] * axis[0] + axis[1] * axis[1] + axis[2] * axis[2];
+				const float inset  = (maxT - minT) / 16.f;
+				float       high[3];
+				float       low[3];
+				for (int32_t c = 0; c < 3; c++)
+				{
+					high[c] = mean[c] + axis[c] * (maxT - inset) / length;
+					low[c]  = mean[c] + axis[c] * (minT + inset) / length;
+				}
+
+				uint16_t c0 = to565(high);
+				uint16_t c1 = to565(low);
+				if (c0 < c1)
+					std::swap(c0, c1);
+
+				out[0] = c0 & 0xFF;
+				out[1] = c0 >> 8;
+				out[2] = c1 & 0xFF;
+				out[3] = c1 >> 8;
+
+				uint32_t indices = 0;
+				if (c0 != c1)
+				{
+					uint8_t palette[4][4];
+					colorPalette(out, palette, true);
+					for (int32_t i = 0; i < 16; i++)
+					{
+						uint32_t best     = 0;
+						int32_t  bestDist = INT32_MAX;
+						for (uint32_t p = 0; p < 4; p++)
+						{
+							int32_t dist = 0;
+							for (int32_t c = 0; c < 3; c++)
+							{
+								const int32_t d = block[i * 4 + c] - palette[p][c];
+								dist += d * d;
+							}
+							if (dist < bestDist)
+							{
+								bestDist = dist;
+								best     = p;
+							}
+						}
+						indices |= best << (i * 2);
+					}
+				}
+				std::memcpy(out + 4, &indices, sizeof(uint32_t));
+			}
+
+			auto encodeChannel(const uint8_t *block, int32_t channel, uint8_t *out) -> void
+			{
+				uint8_t min = 255;
+				uint8_t max = 0;
+				for (int32_t i = 0; i < 16; i++)
+				{
+					min = std::min(min, block[i * 4 + channel]);
+					max = std::max(max, block[i * 4 + channel]);
+				}
+
+				out[0] = max;
+				out[1] = min;
+
+				uint64_t indices = 0;
+				if (max != min)
+				{
+					uint8_t palette[8];
+					channelPalette(out, palette);
+					for (int32_t i = 0; i < 16; i++)
+					{
+						uint64_t best     = 0;
+						int32_t  bestDist = INT32_MAX;
+						for (uint64_t p = 0; p < 8; p++)
+						{
+							const int32_t dist = std::abs(block[i * 4 + channel] - palette[p]);
+							if (dist < bestDist)
+							{
+								bestDist = dist;
+								best     = p;
+							}
+						}
+						indices |= best << (i * 3);
+					}
+				}
+				for (int32_t i = 0; i < 6; i++)
+					out[2 + i] = static_cast<uint8_t>(indices >> (i * 8));
+			}
+
+			auto decodeColor(const uint8_t *in, uint8_t *block, bool fourColor) -> void
+			{
+				uint8_t palette[4][4];
+				colorPalette(in, palette, fourColor);
+
+				uint32_t indices;
+				std::memcpy(&indices, in + 4, sizeof(uint32_t));
+				for (int32_t i = 0; i < 16; i++)
+					std::memcpy(block + i * 4, palette[(indices >> (i * 2)) & 3], fourColor ? 3 : 4);
+			}
+
+			auto decodeChannel(const uint8_t *in, uint8_t *block, int32_t channel) -> void
+			{
+				uint8_t palette[8];
+				channelPalette(in, palette);
+
+				uint64_t indices = 0;
+				for (int32_t i = 0; i < 6; i++)
+					indices |= uint64_t(in[2 + i]) << (i * 8);
+				for (int32_t i = 0; i < 16; i++)
+					block[i * 4 + channel] = palette[(indices >> (i * 3)) & 7];
+			}
+		}        // namespace
+
+		auto canCompress(TextureFormat format) -> bool
+		{
+			return format == TextureFormat::BC1 || format == TextureFormat::BC3 || format == TextureFormat::BC4 || format == TextureFormat::BC5;
+		}
+
+		auto canDecompress(TextureFormat format) -> bool
+		{
+			return canCompress(format);
+		}
+
+		auto compress(TextureFormat format, const uint8_t *rgba, uint32_t width, uint32_t height, uint8_t *out) -> void
+		{
+			PROFILE_FUNCTION();
+			uint8_t block[64];
+			for (uint32_t by = 0; by < height; by += 4)
+			{
+				for (uint32_t bx = 0; bx < width; bx += 4)
+				{
+					//the pixels past the edge repeat the last row and column
+					for (uint32_t y = 0; y < 4; y++)
+					{
+						const auto row = std::min(by + y, height - 1);
+						for (uint32_t x = 0; x < 4; x++)
+							std::memcpy(block + (y * 4 + x) * 4, rgba + (uint64_t(row) * width + std::min(bx + x, width - 1)) * 4, 4);
+					}
+
+					switch (format)
+					{
+						case TextureFormat::BC1:
+							encodeColor(block, out);
+							out += 8;
+							break;
+						case TextureFormat::BC3:
+							encodeChannel(block, 3, out);
+							encodeColor(block, out + 8);
+							out += 16;
+							break;
+						case TextureFormat::BC4:
+							encodeChannel(block, 0, out);
+							out += 8;
+							break;
+						case TextureFormat::BC5:
+							encodeChannel(block, 0, out);
+							encodeChannel(block, 1, out + 8);
+							out += 16;
+							break;
+						default:
+							return;
+					}
+				}
+			}
+		}
+
+		auto decompress(TextureFormat format, const uint8_t *blocks, uint32_t width, uint32_t height, uint8_t *out) -> void
+		{
+			PROFILE_FUNCTION();
+			uint8_t block[64];
+			for (uint32_t by = 0; by < height; by += 4)
+			{
+				for (uint32_t bx = 0; bx < width; bx += 4)
+				{
+					//sampled like the gpu does, the channels a format does not store read as 0 and alpha as 1
+					for (int32_t i = 0; i < 16; i++)
+					{
+						block[i * 4]     = 0;
+						block[i * 4 + 1] = 0;
+						block[i * 4 + 2] = 0;
+						block[i * 4 + 3] = 255;
+					}
+
+					switch (format)
+					{
+						case TextureFormat::BC1:
+							decodeColor(blocks, block, false);
+							blocks += 8;
+							break;
+						case TextureFormat::BC3:
+							decodeChannel(blocks, block, 3);
+							decodeColor(blocks + 8, block, true);
+							blocks += 16;
+							break;
+						case TextureFormat::BC4:
+							decodeChannel(blocks, block, 0);
+							blocks += 8;
+							break;
+						case TextureFormat::BC5:
+							decodeChannel(blocks, block, 0);
+							decodeChannel(blocks + 8, block, 1);
+							blocks += 16;
+							break;
+						default:
+							return;
+					}
+
+					for (uint32_t y = 0; y < 4 && by + y < height; y++)
+						for (uint32_t x = 0; x < 4 && bx + x < width; x++)
+							std::memcpy(out + (uint64_t(by + y) * width + bx + x) * 4, block + (y * 4 + x) * 4, 4);
+				}
+			}
+		}
+	};        // namespace BlockCompression
+}        // namespace maple
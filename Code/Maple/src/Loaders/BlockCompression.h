@@ -0,0 +1,26 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "RHI/Definitions.h"
+#include <cstdint>
+
+namespace maple
+{
+	/**
+	 * Cpu side BC1/BC3/BC4/BC5 encoding for the TextureImporter and decoding for the devices which can not sample them.
+	 * The encoder fits the endpoints along the principal axis of every block, which is fast enough to import a scene
+	 * and close to what the offline compressors reach for BC1, BC7 and ASTC are only passed through.
+	 */
+	namespace BlockCompression
+	{
+		auto canCompress(TextureFormat format) -> bool;
+		auto canDecompress(TextureFormat format) -> bool;
+
+		//rgba8 pixels of one level to blocks, out holds Texture::getLevelSize(format, width, height) bytes
+		auto compress(TextureFormat format, const uint8_t *rgba, uint32_t width, uint32_t height, uint8_t *out) -> void;
+
+		//blocks of one level to rgba8 pixels, out holds width * height * 4 bytes
+		auto decompress(TextureFormat format, const uint8_t *blocks, uint32_t width, uint32_t height, uint8_t *out) -> void;
+	};        // namespace BlockCompression
+}        // namespace maple
@@ -6,15 +6,21 @@
 #include "FileSystem/Skeleton.h"
 
 #include "Animation/Animation.h"
+#include "Application.h"
 #include "Engine/Core.h"
 #include "Engine/Material.h"
+#include "Engine/MeshOptimizer.h"
 #include "FileSystem/File.h"
+#include "Loaders/ImageLoader.h"
+#include "Loaders/ImportContext.h"
 #include "Math/BoundingBox.h"
 #include "Math/MathUtils.h"
 #include "Others/Console.h"
 #include "Others/StringUtils.h"
 #include "Scene/Component/Transform.h"
+#include "Thread/ParallelForEach.h"
 
+#include <atomic>
 #include <mio/mmap.hpp>
 #include <ofbx.h>
 #include <vector>
@@ -168,22 +174,40 @@ namespace maple
 			return transform;
 		}
 
+		inline auto getTexturePath(const ofbx::Material *material, ofbx::Texture::TextureType type) -> std::string
+		{
+			const ofbx::Texture *ofbxTexture = material->getTexture(type);
+			if (ofbxTexture == nullptr)
+				return "";
+
+			ofbx::DataView filename = ofbxTexture->getRelativeFileName();
+			if (filename == "")
+				filename = ofbxTexture->getFileName();
+
+			char filePath[256];
+			filename.toString(filePath);
+			return filePath;
+		}
+
+		constexpr TextureLoadOptions TextureOptions = {false, true, true, false, true};
+
+		constexpr ofbx::Texture::TextureType TextureTypes[] = {
+		    ofbx::Texture::TextureType::DIFFUSE,
+		    ofbx::Texture::TextureType::NORMAL,
+		    ofbx::Texture::TextureType::SPECULAR,
+		    ofbx::Texture::TextureType::SHININESS,
+		    ofbx::Texture::TextureType::EMISSIVE,
+		    ofbx::Texture::TextureType::AMBIENT};
+
 		inline auto loadTexture(const ofbx::Material *material, ofbx::Texture::TextureType type) -> std::shared_ptr<Texture2D>
 		{
-			const ofbx::Texture *      ofbxTexture = material->getTexture(type);
+			const auto                 filePath = getTexturePath(material, type);
 			std::shared_ptr<Texture2D> texture2D;
-			if (ofbxTexture)
+			if (filePath != "")
 			{
-				ofbx::DataView filename = ofbxTexture->getRelativeFileName();
-				if (filename == "")
-					filename = ofbxTexture->getFileName();
-
-				char filePath[256];
-				filename.toString(filePath);
-
 				if (File::fileExists(filePath))
 				{
-					texture2D = Texture2D::create(filePath, filePath);
+					texture2D = Texture2D::create(filePath, filePath, {}, TextureOptions);
 				}
 				else
 				{
@@ -194,6 +218,26 @@ namespace maple
 			return texture2D;
 		}
 
+		//the textures of every material are decoded on the job system while the meshes are built
+		inline auto prefetchTextures(const ofbx::IScene *scene) -> std::shared_ptr<ImagePrefetch>
+		{
+			std::vector<std::string> filePaths;
+			for (int32_t i = 0; i < scene->getMeshCount(); ++i)
+			{
+				const auto fbxMesh = (const ofbx::Mesh *) scene->getMesh(i);
+				for (auto j = 0; j < fbxMesh->getMaterialCount(); j++)
+				{
+					for (auto type : TextureTypes)
+					{
+						auto filePath = getTexturePath(fbxMesh->getMaterial(j), type);
+						if (filePath != "" && File::fileExists(filePath))
+							filePaths.emplace_back(filePath);
+					}
+				}
+			}
+			return Texture2D::prefetch(filePaths, TextureOptions);
+		}
+
 		inline auto loadMaterial(const ofbx::Material *material, bool animated)
 		{
 			auto pbrMaterial = std::make_shared<Material>();
@@ -449,67 +493,57 @@ namespace maple
 			return skeleton;
 		}
 
-		inline auto loadMesh(const std::string &fileName, const ofbx::IScene *scene, std::vector<const ofbx::Object *> &sceneBone, std::shared_ptr<Skeleton> skeleton, std::vector<std::shared_ptr<IResource>> &outRes, Orientation orientation)
+		struct MeshGeometry
 		{
-			if (scene->getMeshCount() > 0)
-			{
-				auto meshes = std::make_shared<MeshResource>(fileName);
-				outRes.emplace_back(meshes);
-
-				for (int32_t i = 0; i < scene->getMeshCount(); ++i)
-				{
-					const auto fbxMesh     = (const ofbx::Mesh *) scene->getMesh(i);
-					const auto geom        = fbxMesh->getGeometry();
-					const auto numIndices  = geom->getIndexCount();
-					const auto vertexCount = geom->getVertexCount();
-					const auto vertices    = geom->getVertices();
-					const auto normals     = geom->getNormals();
-					const auto tangents    = geom->getTangents();
-					const auto colors      = geom->getColors();
-					const auto uvs         = geom->getUVs();
-					const auto materials   = geom->getMaterials();
-
-					for (auto i = 0; i < sceneBone.size(); i++)
-					{
-						auto &ske        = skeleton->getBone(i);
-						ske.offsetMatrix = glm::inverse(getOffsetMatrix(fbxMesh, sceneBone[i]));
-					}
-
-					std::vector<std::shared_ptr<Material>> pbrMaterials;
+			std::vector<Vertex>        vertices;
+			std::vector<SkinnedVertex> skinnedVertices;
+			std::vector<uint32_t>      indices;
+		};
 
-					std::vector<Vertex>        tempVertices;
-					std::vector<SkinnedVertex> skinnedVertices;
-
-					if (skeleton->hasBones())
-					{
-						skinnedVertices.resize(vertexCount);
-					}
-					else
-					{
-						tempVertices.resize(vertexCount);
-					}
-
-					std::vector<uint32_t> indicesArray;
+		//vertices, indices and weights of a mesh only read the scene and the skeleton
+		inline auto loadGeometry(const ofbx::Mesh *fbxMesh, Skeleton &skeleton, Orientation orientation, MeshGeometry &out) -> void
+		{
+			const auto geom        = fbxMesh->getGeometry();
+			const auto numIndices  = geom->getIndexCount();
+			const auto vertexCount = geom->getVertexCount();
+			const auto vertices    = geom->getVertices();
+			const auto normals     = geom->getNormals();
+			const auto tangents    = geom->getTangents();
+			const auto colors      = geom->getColors();
+			const auto uvs         = geom->getUVs();
+
+			auto &tempVertices    = out.vertices;
+			auto &skinnedVertices = out.skinnedVertices;
+			auto &indicesArray    = out.indices;
+
+			if (skeleton.hasBones())
+			{
+				skinnedVertices.resize(vertexCount);
+			}
+			else
+			{
+				tempVertices.resize(vertexCount);
+			}
 
-					indicesArray.resize(numIndices);
+			indicesArray.resize(numIndices);
 
-					auto boundingBox = std::make_shared<BoundingBox>();
+			auto boundingBox = std::make_shared<BoundingBox>();
 
-					const auto indices = geom->getFaceIndices();
+			const auto indices = geom->getFaceIndices();
 
-					ofbx::Vec3 *generatedTangents = nullptr;
-					if (!tangents && normals && uvs)
-					{
-						generatedTangents = new ofbx::Vec3[vertexCount];
-						computeTangents(generatedTangents, vertexCount, vertices, normals, uvs);
-					}
+			ofbx::Vec3 *generatedTangents = nullptr;
+			if (!tangents && normals && uvs)
+			{
+				generatedTangents = new ofbx::Vec3[vertexCount];
+				computeTangents(generatedTangents, vertexCount, vertices, normals, uvs);
+			}
 
-					auto transform = getTransform(fbxMesh, orientation);
-					bool skin      = skeleton->hasBones();
+			auto transform = getTransform(fbxMesh, orientation);
+			bool skin      = skeleton.hasBones();
 
-					for (int32_t i = 0; i < vertexCount; ++i)
-					{
-						const ofbx::Vec3 &cp = vertices[i];
+			for (int32_t i = 0; i < vertexCount; ++i)
+			{
+				const ofbx::Vec3 &cp = vertices[i];
 
 #define GEN_VERTEX(Vertices)                                                                                                                                 \
 	{                                                                                                                                                        \
@@ -534,36 +568,88 @@ namespace maple
 		fixOrientation(vertex.tangent, orientation);                                                                                                         \
 	}
 
-						if (skin)
-						{
-							GEN_VERTEX(skinnedVertices);
-						}
-						else
-						{
-							GEN_VERTEX(tempVertices);
-						}
-					}
+				if (skin)
+				{
+					GEN_VERTEX(skinnedVertices);
+				}
+				else
+				{
+					GEN_VERTEX(tempVertices);
+				}
+			}
 
-					for (int32_t i = 0; i < numIndices; i++)
-					{
-						int32_t index   = (i % 3 == 2) ? (-indices[i] - 1) : indices[i];
-						indicesArray[i] = index;
-					}
+			for (int32_t i = 0; i < numIndices; i++)
+			{
+				int32_t index   = (i % 3 == 2) ? (-indices[i] - 1) : indices[i];
+				indicesArray[i] = index;
+			}
 
-					if (geom->getSkin() != nullptr && skeleton->hasBones())
+			if (geom->getSkin() != nullptr && skeleton.hasBones())
+			{
+				loadWeight(geom->getSkin(), &skeleton, skinnedVertices);
+			}
+
+			if (generatedTangents)
+				delete[] generatedTangents;
+		}
+
+		inline auto loadMesh(const std::string &fileName, const ofbx::IScene *scene, std::vector<const ofbx::Object *> &sceneBone, std::shared_ptr<Skeleton> skeleton, std::vector<std::shared_ptr<IResource>> &outRes, Orientation orientation, const ImportOptions &options)
+		{
+			if (scene->getMeshCount() > 0)
+			{
+				auto meshes = std::make_shared<MeshResource>(fileName);
+				outRes.emplace_back(meshes);
+
+				auto prefetch = prefetchTextures(scene);
+
+				const auto                meshCount = static_cast<uint32_t>(scene->getMeshCount());
+				std::vector<MeshGeometry> geometries(meshCount);
+				std::atomic<uint32_t>     processed = 0;
+				auto                      context   = ImportContext::current();
+
+				parallelFor(
+				    *Application::getJobSystem(), meshCount, [&](uint32_t i) {
+					    const auto fbxMesh = (const ofbx::Mesh *) scene->getMesh(i);
+					    loadGeometry(fbxMesh, *skeleton, orientation, geometries[i]);
+					    //the sub meshes are ranges of the triangles in source order, meshes with several materials keep it
+					    if (options.optimizeMeshes && fbxMesh->getMaterialCount() <= 1)
+					    {
+						    auto &geometry = geometries[i];
+						    if (skeleton->hasBones())
+							    MeshOptimizer::optimize(geometry.indices, geometry.skinnedVertices, fbxMesh->name);
+						    else
+							    MeshOptimizer::optimize(geometry.indices, geometry.vertices, fbxMesh->name);
+					    }
+					    if (context != nullptr)
+						    context->setProgress(float(++processed) / meshCount);
+				    },
+				    1);
+
+				for (int32_t i = 0; i < scene->getMeshCount(); ++i)
+				{
+					const auto fbxMesh     = (const ofbx::Mesh *) scene->getMesh(i);
+					const auto geom        = fbxMesh->getGeometry();
+					const auto vertexCount = geom->getVertexCount();
+					const auto materials   = geom->getMaterials();
+
+					for (auto i = 0; i < sceneBone.size(); i++)
 					{
-						loadWeight(geom->getSkin(), skeleton.get(), skinnedVertices);
+						auto &ske        = skeleton->getBone(i);
+						ske.offsetMatrix = glm::inverse(getOffsetMatrix(fbxMesh, sceneBone[i]));
 					}
 
+					std::vector<std::shared_ptr<Material>> pbrMaterials;
+
 					std::shared_ptr<Mesh> mesh;
-					if (skin)
+					if (skeleton->hasBones())
 					{
-						mesh = std::make_shared<Mesh>(indicesArray, skinnedVertices);
+						mesh = std::make_shared<Mesh>(geometries[i].indices, geometries[i].skinnedVertices);
 					}
 					else
 					{
-						mesh = std::make_shared<Mesh>(indicesArray, tempVertices);
+						mesh = std::make_shared<Mesh>(geometries[i].indices, geometries[i].vertices);
 					}
+					geometries[i] = {};
 
 					for (auto i = 0; i < fbxMesh->getMaterialCount(); i++)
 					{
@@ -602,15 +688,12 @@ namespace maple
 
 					mesh->setName(name);
 					meshes->addMesh(name, mesh);
-
-					if (generatedTangents)
-						delete[] generatedTangents;
 				}
 			}
 		}
 	}        // namespace
 
-	auto FBXLoader::load(const std::string &fileName, const std::string &extension, std::vector<std::shared_ptr<IResource>> &outRes) const -> void
+	auto FBXLoader::load(const std::string &fileName, const std::string &extension, const ImportOptions &options, std::vector<std::shared_ptr<IResource>> &outRes) const -> void
 	{
 		mio::mmap_source mmap(fileName);
 		MAPLE_ASSERT(mmap.is_open(), "open fbx file failed");
@@ -639,6 +722,6 @@ namespace maple
 
 		auto skeleton = loadSkeleton(fileName, scene, sceneBone, outRes, orientation);
 		loadAnimation(fileName, scene, sceneBone, outRes, orientation);
-		loadMesh(fileName, scene, sceneBone, skeleton, outRes, orientation);
+		loadMesh(fileName, scene, sceneBone, skeleton, outRes, orientation, options);
 	}
 };        // namespace maple
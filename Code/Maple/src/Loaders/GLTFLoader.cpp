@@ -2,14 +2,20 @@
 // This file is part of the Maple Engine                              		//
 //////////////////////////////////////////////////////////////////////////////
 #include "GLTFLoader.h"
+#include "Application.h"
 #include "Engine/Material.h"
+#include "Engine/MeshOptimizer.h"
 #include "Engine/Profiler.h"
 
 #include "FileSystem/MeshResource.h"
+#include "Loaders/ImageLoader.h"
+#include "Loaders/ImportContext.h"
 #include "Others/Console.h"
 #include "Others/StringUtils.h"
 #include "Scene/Component/Transform.h"
+#include "Thread/ParallelForEach.h"
 
+#include <atomic>
 #include <glm/gtc/type_ptr.hpp>
 #include <glm/gtx/quaternion.hpp>
 
@@ -34,6 +40,39 @@ namespace maple
 		tinygltf::Sampler *sampler;
 	};
 
+	//tinygltf only hands the encoded images over, they are decoded together on the job system after parsing
+	static auto keepEncodedImage(tinygltf::Image *image, const int32_t imageIndex, std::string *, std::string *, int32_t, int32_t, const unsigned char *bytes, int32_t size, void *userData) -> bool
+	{
+		auto &encoded = *static_cast<std::vector<std::vector<uint8_t>> *>(userData);
+		if (imageIndex >= encoded.size())
+			encoded.resize(imageIndex + 1);
+		encoded[imageIndex].assign(bytes, bytes + size);
+		return true;
+	}
+
+	static auto decodeImages(tinygltf::Model &model, const std::vector<std::vector<uint8_t>> &encoded) -> void
+	{
+		PROFILE_FUNCTION();
+		std::vector<const std::vector<uint8_t> *> buffers;
+		for (size_t i = 0; i < model.images.size(); i++)
+			buffers.emplace_back(i < encoded.size() ? &encoded[i] : nullptr);
+
+		auto images = ImageLoader::decode(buffers, false);
+		for (size_t i = 0; i < model.images.size(); i++)
+		{
+			if (images[i] == nullptr)
+				continue;
+			auto &image      = model.images[i];
+			auto  pixels     = static_cast<const uint8_t *>(images[i]->getData());
+			image.width      = images[i]->getWidth();
+			image.height     = images[i]->getHeight();
+			image.component  = 4;
+			image.bits       = 8;
+			image.pixel_type = TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE;
+			image.image.assign(pixels, pixels + images[i]->getImageSize());
+		}
+	}
+
 	static std::unordered_map<int32_t, size_t> ComponentSize{
 	    {TINYGLTF_COMPONENT_TYPE_BYTE, sizeof(int8_t)},
 	    {TINYGLTF_COMPONENT_TYPE_UNSIGNED_BYTE, sizeof(uint8_t)},
@@ -117,13 +156,13 @@ namespace maple
 					imageAndSampler.sampler = &gltfModel.samplers.at(gltfTexture.sampler);
 				}
 
-				if (imageAndSampler.image)
+				if (imageAndSampler.image && !imageAndSampler.image->image.empty())
 				{
 					TextureParameters params;
 					if (gltfTexture.sampler != -1)
 						params = TextureParameters(getFilter(imageAndSampler.sampler->minFilter), getFilter(imageAndSampler.sampler->magFilter), getWrapMode(imageAndSampler.sampler->wrapS), getWrapMode(imageAndSampler.sampler->wrapT));
 
-					auto texture2D                     = Texture2D::create(imageAndSampler.image->width, imageAndSampler.image->height, imageAndSampler.image->image.data(), params, {false, false, true});
+					auto texture2D                     = Texture2D::create(imageAndSampler.image->width, imageAndSampler.image->height, imageAndSampler.image->image.data(), params, {false, false, true, false, true});
 					loadedTextures[gltfTexture.source] = texture2D;
 				}
 			}
@@ -251,143 +290,148 @@ namespace maple
 			return loadedMaterials;
 		}
 
-		inline auto loadMesh(tinygltf::Model &model, tinygltf::Mesh &mesh, std::vector<std::shared_ptr<Material>> &materials, component::Transform &parentTransform) -> std::vector<std::shared_ptr<Mesh>>
+		struct Primitive
 		{
-			std::vector<std::shared_ptr<Mesh>> meshes;
-
-			for (auto &primitive : mesh.primitives)
-			{
-				const auto &indicesAccessor = model.accessors[primitive.indices];
+			std::string                name;
+			int32_t                    material  = -1;
+			const tinygltf::Primitive *primitive = nullptr;
+			glm::mat4                  worldMatrix;
+			std::vector<uint32_t>      indices;
+			std::vector<Vertex>        vertices;
+		};
+
+		//the model is only read, the primitives are loaded in parallel
+		inline auto loadPrimitive(const tinygltf::Model &model, Primitive &out) -> void
+		{
+			const auto &primitive       = *out.primitive;
+			const auto &worldMatrix     = out.worldMatrix;
+			const auto &indicesAccessor = model.accessors[primitive.indices];
 
-				std::vector<uint32_t> indices;
-				std::vector<Vertex>   vertices;
+			auto &indices  = out.indices;
+			auto &vertices = out.vertices;
 
-				indices.resize(indicesAccessor.count);
-				vertices.resize(indicesAccessor.count);
+			indices.resize(indicesAccessor.count);
+			vertices.resize(indicesAccessor.count);
 
-				for (auto &attribute : primitive.attributes)
+			for (auto &attribute : primitive.attributes)
+			{
+				// Get accessor info
+				auto &accessor              = model.accessors.at(attribute.second);
+				auto &bufferView            = model.bufferViews.at(accessor.bufferView);
+				auto &buffer                = model.buffers.at(bufferView.buffer);
+				int   componentLength       = GLTF_COMPONENT_LENGTH_LOOKUP.at(accessor.type);
+				int   componentTypeByteSize = GLTF_COMPONENT_BYTE_SIZE_LOOKUP.at(accessor.componentType);
+
+				// Extra vertex data from buffer
+				size_t               bufferOffset = bufferView.byteOffset + accessor.byteOffset;
+				int                  bufferLength = static_cast<int>(accessor.count) * componentLength * componentTypeByteSize;
+				auto                 first        = buffer.data.begin() + bufferOffset;
+				auto                 last         = buffer.data.begin() + bufferOffset + bufferLength;
+				std::vector<uint8_t> data         = std::vector<uint8_t>(first, last);
+
+				if (attribute.first == "POSITION")
 				{
-					// Get accessor info
-					auto &accessor              = model.accessors.at(attribute.second);
-					auto &bufferView            = model.bufferViews.at(accessor.bufferView);
-					auto &buffer                = model.buffers.at(bufferView.buffer);
-					int   componentLength       = GLTF_COMPONENT_LENGTH_LOOKUP.at(accessor.type);
-					int   componentTypeByteSize = GLTF_COMPONENT_BYTE_SIZE_LOOKUP.at(accessor.componentType);
-
-					// Extra vertex data from buffer
-					size_t               bufferOffset = bufferView.byteOffset + accessor.byteOffset;
-					int                  bufferLength = static_cast<int>(accessor.count) * componentLength * componentTypeByteSize;
-					auto                 first        = buffer.data.begin() + bufferOffset;
-					auto                 last         = buffer.data.begin() + bufferOffset + bufferLength;
-					std::vector<uint8_t> data         = std::vector<uint8_t>(first, last);
-
-					if (attribute.first == "POSITION")
+					size_t positionCount = accessor.count;
+					auto   positions     = reinterpret_cast<glm::vec3 *>(data.data());
+					for (auto p = 0; p < positionCount; ++p)
 					{
-						size_t positionCount = accessor.count;
-						auto   positions     = reinterpret_cast<glm::vec3 *>(data.data());
-						for (auto p = 0; p < positionCount; ++p)
-						{
-							vertices[p].pos   = parentTransform.getWorldMatrix() * glm::vec4(positions[p], 1.0);
-							vertices[p].color = {1, 1, 1, 1};
-						}
+						vertices[p].pos   = worldMatrix * glm::vec4(positions[p], 1.0);
+						vertices[p].color = {1, 1, 1, 1};
 					}
+				}
 
-					else if (attribute.first == "NORMAL")
+				else if (attribute.first == "NORMAL")
+				{
+					size_t normalCount = accessor.count;
+					auto   normals     = reinterpret_cast<glm::vec3 *>(data.data());
+					for (auto p = 0; p < normalCount; ++p)
 					{
-						size_t normalCount = accessor.count;
-						auto   normals     = reinterpret_cast<glm::vec3 *>(data.data());
-						for (auto p = 0; p < normalCount; ++p)
-						{
-							vertices[p].normal = (parentTransform.getWorldMatrix() * glm::vec4(normals[p], 1.0));
-
-							glm::normalize(vertices[p].normal);
-						}
-					}
+						vertices[p].normal = (worldMatrix * glm::vec4(normals[p], 1.0));
 
-					else if (attribute.first == "TEXCOORD_0")
-					{
-						size_t uvCount = accessor.count;
-						auto   uvs     = reinterpret_cast<glm::vec2 *>(data.data());
-						for (auto p = 0; p < uvCount; ++p)
-						{
-							vertices[p].texCoord = uvs[p];
-						}
+						glm::normalize(vertices[p].normal);
 					}
+				}
 
-					else if (attribute.first == "COLOR_0")
+				else if (attribute.first == "TEXCOORD_0")
+				{
+					size_t uvCount = accessor.count;
+					auto   uvs     = reinterpret_cast<glm::vec2 *>(data.data());
+					for (auto p = 0; p < uvCount; ++p)
 					{
-						size_t uvCount = accessor.count;
-						auto   colors  = reinterpret_cast<glm::vec4 *>(data.data());
-						for (auto p = 0; p < uvCount; ++p)
-						{
-							vertices[p].color = colors[p];
-						}
+						vertices[p].texCoord = uvs[p];
 					}
+				}
 
-					else if (attribute.first == "TANGENT")
+				else if (attribute.first == "COLOR_0")
+				{
+					size_t uvCount = accessor.count;
+					auto   colors  = reinterpret_cast<glm::vec4 *>(data.data());
+					for (auto p = 0; p < uvCount; ++p)
 					{
-						size_t uvCount = accessor.count;
-						auto   uvs     = reinterpret_cast<glm::vec3 *>(data.data());
-						for (auto p = 0; p < uvCount; ++p)
-						{
-							vertices[p].tangent = parentTransform.getWorldMatrix() * glm::vec4(uvs[p], 1.0);
-						}
+						vertices[p].color = colors[p];
 					}
 				}
 
+				else if (attribute.first == "TANGENT")
 				{
-					// Get accessor info
-					auto indexAccessor   = model.accessors.at(primitive.indices);
-					auto indexBufferView = model.bufferViews.at(indexAccessor.bufferView);
-					auto indexBuffer     = model.buffers.at(indexBufferView.buffer);
-
-					int componentLength       = GLTF_COMPONENT_LENGTH_LOOKUP.at(indexAccessor.type);
-					int componentTypeByteSize = GLTF_COMPONENT_BYTE_SIZE_LOOKUP.at(indexAccessor.componentType);
-
-					// Extra index data
-					size_t               bufferOffset = indexBufferView.byteOffset + indexAccessor.byteOffset;
-					int                  bufferLength = static_cast<int>(indexAccessor.count) * componentLength * componentTypeByteSize;
-					auto                 first        = indexBuffer.data.begin() + bufferOffset;
-					auto                 last         = indexBuffer.data.begin() + bufferOffset + bufferLength;
-					std::vector<uint8_t> data         = std::vector<uint8_t>(first, last);
-
-					size_t indicesCount = indexAccessor.count;
-					if (componentTypeByteSize == 1)
+					size_t uvCount = accessor.count;
+					auto   uvs     = reinterpret_cast<glm::vec3 *>(data.data());
+					for (auto p = 0; p < uvCount; ++p)
 					{
-						uint8_t *in = reinterpret_cast<uint8_t *>(data.data());
-						for (auto iCount = 0; iCount < indicesCount; iCount++)
-						{
-							indices[iCount] = (uint32_t) in[iCount];
-						}
+						vertices[p].tangent = worldMatrix * glm::vec4(uvs[p], 1.0);
 					}
-					else if (componentTypeByteSize == 2)
+				}
+			}
+
+			{
+				// Get accessor info
+				auto &indexAccessor   = model.accessors.at(primitive.indices);
+				auto &indexBufferView = model.bufferViews.at(indexAccessor.bufferView);
+				auto &indexBuffer     = model.buffers.at(indexBufferView.buffer);
+
+				int componentLength       = GLTF_COMPONENT_LENGTH_LOOKUP.at(indexAccessor.type);
+				int componentTypeByteSize = GLTF_COMPONENT_BYTE_SIZE_LOOKUP.at(indexAccessor.componentType);
+
+				// Extra index data
+				size_t               bufferOffset = indexBufferView.byteOffset + indexAccessor.byteOffset;
+				int                  bufferLength = static_cast<int>(indexAccessor.count) * componentLength * componentTypeByteSize;
+				auto                 first        = indexBuffer.data.begin() + bufferOffset;
+				auto                 last         = indexBuffer.data.begin() + bufferOffset + bufferLength;
+				std::vector<uint8_t> data         = std::vector<uint8_t>(first, last);
+
+				size_t indicesCount = indexAccessor.count;
+				if (componentTypeByteSize == 1)
+				{
+					uint8_t *in = reinterpret_cast<uint8_t *>(data.data());
+					for (auto iCount = 0; iCount < indicesCount; iCount++)
 					{
-						uint16_t *in = reinterpret_cast<uint16_t *>(data.data());
-						for (auto iCount = 0; iCount < indicesCount; iCount++)
-						{
-							indices[iCount] = (uint32_t) in[iCount];
-						}
+						indices[iCount] = (uint32_t) in[iCount];
 					}
-					else if (componentTypeByteSize == 4)
+				}
+				else if (componentTypeByteSize == 2)
+				{
+					uint16_t *in = reinterpret_cast<uint16_t *>(data.data());
+					for (auto iCount = 0; iCount < indicesCount; iCount++)
 					{
-						auto in = reinterpret_cast<uint32_t *>(data.data());
-						for (auto iCount = 0; iCount < indicesCount; iCount++)
-						{
-							indices[iCount] = in[iCount];
-						}
+						indices[iCount] = (uint32_t) in[iCount];
 					}
-					else
+				}
+				else if (componentTypeByteSize == 4)
+				{
+					auto in = reinterpret_cast<uint32_t *>(data.data());
+					for (auto iCount = 0; iCount < indicesCount; iCount++)
 					{
-						LOGW("Unsupported indices data type - {0}", componentTypeByteSize);
+						indices[iCount] = in[iCount];
 					}
 				}
-				meshes.emplace_back(std::make_shared<Mesh>(indices, vertices));
+				else
+				{
+					LOGW("Unsupported indices data type - {0}", componentTypeByteSize);
+				}
 			}
-			return meshes;
 		}
 
-		inline auto loadNode(const std::string &parentName, int32_t nodeIndex, const glm::mat4 &parentTransform,
-		                     tinygltf::Model &model, std::vector<std::shared_ptr<Material>> &materials, std::unordered_map<std::string, std::shared_ptr<Mesh>> &out)
+		inline auto loadNode(const std::string &parentName, int32_t nodeIndex, const glm::mat4 &parentTransform, tinygltf::Model &model, std::vector<Primitive> &out) -> void
 		{
 			PROFILE_FUNCTION();
 			if (nodeIndex < 0)
@@ -456,10 +500,7 @@ namespace maple
 			if (node.mesh >= 0)
 			{
 				int32_t subIndex = 0;
-
-				auto meshes = loadMesh(model, model.meshes[node.mesh], materials, transform);
-
-				for (auto &mesh : meshes)
+				for (auto &meshPrimitive : model.meshes[node.mesh].primitives)
 				{
 					std::string subname = node.name;
 
@@ -468,13 +509,11 @@ namespace maple
 						subname = parentName + "_" + std::to_string(subIndex);
 					}
 
-					mesh->setName(subname);
-
-					int32_t materialIndex = model.meshes[node.mesh].primitives[subIndex].material;
-					if (materialIndex >= 0)
-						mesh->setMaterial(materials[materialIndex]);
-
-					out[subname] = mesh;
+					auto &primitive       = out.emplace_back();
+					primitive.name        = subname;
+					primitive.material    = meshPrimitive.material;
+					primitive.primitive   = &meshPrimitive;
+					primitive.worldMatrix = transform.getWorldMatrix();
 					subIndex++;
 				}
 			}
@@ -484,13 +523,13 @@ namespace maple
 				for (int32_t child : node.children)
 				{
 					auto name = parentName + "_child_" + std::to_string(child);
-					loadNode(name, child, transform.getLocalMatrix(), model, materials, out);
+					loadNode(name, child, transform.getLocalMatrix(), model, out);
 				}
 			}
 		}
 	}        // namespace
 
-	auto GLTFLoader::load(const std::string &obj, const std::string &extension, std::vector<std::shared_ptr<IResource>> &out) const -> void
+	auto GLTFLoader::load(const std::string &obj, const std::string &extension, const ImportOptions &options, std::vector<std::shared_ptr<IResource>> &out) const -> void
 	{
 		PROFILE_FUNCTION();
 		auto               name = StringUtils::getFileNameWithoutExtension(obj);
@@ -501,17 +540,18 @@ namespace maple
 
 		bool ret;
 
-		stbi_set_flip_vertically_on_load(0);
+		std::vector<std::vector<uint8_t>> encodedImages;
+		loader.SetImageLoader(keepEncodedImage, &encodedImages);
 
 		if (extension == "glb")        // assume binary glTF.
 		{
 			PROFILE_SCOPE(".glb binary loading");
-			ret = tinygltf::TinyGLTF().LoadBinaryFromFile(&model, &err, &warn, obj);
+			ret = loader.LoadBinaryFromFile(&model, &err, &warn, obj);
 		}
 		else        // assume ascii glTF.
 		{
 			PROFILE_SCOPE(".gltf loading");
-			ret = tinygltf::TinyGLTF().LoadASCIIFromFile(&model, &err, &warn, obj);
+			ret = loader.LoadASCIIFromFile(&model, &err, &warn, obj);
 		}
 
 		if (!err.empty())
@@ -532,14 +572,37 @@ namespace maple
 		{
 			PROFILE_SCOPE("Parse GLTF Model");
 
+			decodeImages(model, encodedImages);
 			auto loadedMaterials = loadMaterials(model);
 
+			std::vector<Primitive> primitives;
 			const tinygltf::Scene &gltfScene = model.scenes[std::max(0, model.defaultScene)];
 			for (size_t i = 0; i < gltfScene.nodes.size(); i++)
 			{
-				loadNode(name, gltfScene.nodes[i], glm::mat4(1.0f), model, loadedMaterials, meshRes->getMeshes());
+				loadNode(name, gltfScene.nodes[i], glm::mat4(1.0f), model, primitives);
+			}
+
+			std::atomic<uint32_t> processed = 0;
+			auto                  context   = ImportContext::current();
+			parallelFor(
+			    *Application::getJobSystem(), static_cast<uint32_t>(primitives.size()), [&](uint32_t i) {
+				    loadPrimitive(model, primitives[i]);
+				    if (options.optimizeMeshes)
+					    MeshOptimizer::optimize(primitives[i].indices, primitives[i].vertices, primitives[i].name);
+				    if (context != nullptr)
+					    context->setProgress(float(++processed) / primitives.size());
+			    },
+			    1);
+
+			auto &meshes = meshRes->getMeshes();
+			for (auto &primitive : primitives)
+			{
+				auto mesh = std::make_shared<Mesh>(primitive.indices, primitive.vertices);
+				mesh->setName(primitive.name);
+				if (primitive.material >= 0)
+					mesh->setMaterial(loadedMaterials[primitive.material]);
+				meshes[primitive.name] = mesh;
 			}
 		}
-		stbi_set_flip_vertically_on_load(1);
 	}
 };        // namespace maple
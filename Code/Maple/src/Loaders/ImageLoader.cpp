@@ -2,9 +2,16 @@
 // This file is part of the Maple Engine                              		//
 //////////////////////////////////////////////////////////////////////////////
 #include "ImageLoader.h"
-#include <ktx.h>
+#include "BlockCompression.h"
+#include "KTX2Loader.h"
+#include "TextureImporter.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
 #include <memory>
+#include <mutex>
 #include <stdexcept>
+#include <unordered_map>
 
 #define STBI_NO_PSD
 #define STBI_NO_PIC
@@ -14,10 +21,15 @@
 #define STB_IMAGE_IMPLEMENTATION
 #include "stb_image.h"
 
+#include "Application.h"
 #include "Engine/Profiler.h"
+#include "FileSystem/File.h"
 #include "Others/Console.h"
 #include "Others/StringUtils.h"
 #include "RHI/Definitions.h"
+#include "RHI/Texture.h"
+#include "Thread/JobSystem.h"
+#include "Thread/ParallelForEach.h"
 
 #ifdef MAPLE_VULKAN
 #	include "RHI/Vulkan/VulkanTexture.h"
@@ -29,48 +41,402 @@
 
 namespace maple
 {
-	auto ImageLoader::loadAsset(const std::string &name, bool mipmaps, bool flipY) -> std::unique_ptr<Image>
+	namespace
+	{
+		//stb_image only has a process wide flag for the flip, the rows are swapped here instead so decoding stays thread safe
+		inline auto flipRows(uint8_t *data, uint64_t rowSize, uint32_t height) -> void
+		{
+			std::vector<uint8_t> row(rowSize);
+			for (uint32_t y = 0; y < height / 2; y++)
+			{
+				auto top    = data + y * rowSize;
+				auto bottom = data + (height - 1 - y) * rowSize;
+				std::memcpy(row.data(), top, rowSize);
+				std::memcpy(top, bottom, rowSize);
+				std::memcpy(bottom, row.data(), rowSize);
+			}
+		}
+
+		auto decodeSource(const std::string &name, const uint8_t *bytes, uint64_t length, bool mipmaps, bool flipY, bool allowHDR = true) -> std::unique_ptr<Image>
+		{
+			LOGI("load image : {0}", name);
+			const auto size = static_cast<int32_t>(length);
+			const bool hdr  = allowHDR && stbi_is_hdr_from_memory(bytes, size);
+
+			int32_t       width    = 0;
+			int32_t       height   = 0;
+			int32_t       channels = 0;
+			TextureFormat format   = hdr ? TextureFormat::RGBA32 : TextureFormat::RGBA8;
+			uint8_t *     data     = hdr ?
+			                    (uint8_t *) stbi_loadf_from_memory(bytes, size, &width, &height, &channels, STBI_rgb_alpha) :
+			                    stbi_load_from_memory(bytes, size, &width, &height, &channels, STBI_rgb_alpha);
+
+			if (data == nullptr)
+			{
+				LOGE("{0} could not be decoded", name);
+				return nullptr;
+			}
+
+			const uint64_t rowSize = uint64_t(width) * 4 * (hdr ? sizeof(float) : sizeof(uint8_t));
+			if (flipY)
+				flipRows(data, rowSize, height);
+
+			return std::make_unique<Image>(format, width, height, data, static_cast<uint32_t>(rowSize * height), channels, mipmaps, hdr);
+		}
+
+		auto loadSource(const std::string &name, bool mipmaps, bool flipY, bool allowHDR = true) -> std::unique_ptr<Image>
+		{
+			auto bytes = File::read(name);
+			if (bytes == nullptr || bytes->empty())
+			{
+				LOGE("can not read image : {0}", name);
+				return nullptr;
+			}
+			return decodeSource(name, bytes->data(), bytes->size(), mipmaps, flipY, allowHDR);
+		}
+
+		//the levels of a ktx2 file as the caller wants them, nullptr when it can not be used
+		auto loadKTX2(const std::string &name, bool mipmaps, bool flipY, bool compressed, bool imported) -> std::unique_ptr<Image>
+		{
+			bool flipped = false;
+			auto image   = KTX2Loader::load(name, flipped);
+			if (image == nullptr)
+				return nullptr;
+
+			if (flipped != flipY)
+			{
+				//an import of the other orientation is ignored, the source is flipped while it is decoded
+				if (imported)
+					return nullptr;
+				LOGW("KTX2 : {0} is stored {1}, it is not flipped", name, flipped ? "bottom up" : "top down");
+			}
+
+			const auto format = image->getPixelFormat();
+			const auto width  = image->getWidth();
+			const auto height = image->getHeight();
+			auto       levels = compressed && mipmaps ? image->getLevels() : 1u;
+
+			if ((compressed && Texture::isFormatSupported(format)) || format == TextureFormat::RGBA8)
+			{
+				uint64_t size = 0;
+				for (uint32_t level = 0; level < levels; level++)
+					size += (Texture::getLevelSize(format, std::max(width >> level, 1u), std::max(height >> level, 1u)) + 3) & ~uint64_t(3);
+
+				image->setLevels(levels);
+				image->setSize(static_cast<uint32_t>(size));
+				image->setMipmaps(mipmaps);
+				return image;
+			}
+
+			if (Texture::isCompressedFormat(format) && !BlockCompression::canDecompress(format))
+			{
+				LOGE("KTX2 : {0} can not be sampled by this device and not be decoded on the cpu", name);
+				return nullptr;
+			}
+
+			//decoded to RGBA8, with the mip chain still saving the mip generation when the caller takes it
+			uint64_t size = 0;
+			for (uint32_t level = 0; level < levels; level++)
+				size += uint64_t(std::max(width >> level, 1u)) * std::max(height >> level, 1u) * 4;
+
+			auto     data   = static_cast<uint8_t *>(malloc(size));
+			auto     source = static_cast<const uint8_t *>(image->getData());
+			uint64_t offset = 0;
+			for (uint32_t level = 0; level < levels; level++)
+			{
+				const auto levelWidth  = std::max(width >> level, 1u);
+				const auto levelHeight = std::max(height >> level, 1u);
+				const auto pixels      = uint64_t(levelWidth) * levelHeight;
+				auto       out         = data + offset;
+
+				if (Texture::isCompressedFormat(format))
+				{
+					BlockCompression::decompress(format, source, levelWidth, levelHeight, out);
+				}
+				else
+				{
+					const auto stride = Texture::getStrideFromFormat(format);
+					for (uint64_t i = 0; i < pixels; i++)
+					{
+						out[i * 4]     = source[i * stride];
+						out[i * 4 + 1] = stride > 1 ? source[i * stride + 1] : 0;
+						out[i * 4 + 2] = 0;
+						out[i * 4 + 3] = 255;
+					}
+				}
+
+				source += (Texture::getLevelSize(format, levelWidth, levelHeight) + 3) & ~uint64_t(3);
+				offset += pixels * 4;
+			}
+
+			auto decoded = std::make_unique<Image>(TextureFormat::RGBA8, width, height, data, static_cast<uint32_t>(size), image->getChannel(), mipmaps);
+			decoded->setLevels(levels);
+			return decoded;
+		}
+
+		//the old loadAsset, source holds the bytes of name when they were read already
+		auto decodeFile(const std::string &name, const std::vector<uint8_t> *source, bool mipmaps, bool flipY, bool compressed) -> std::unique_ptr<Image>
+		{
+			if (KTX2Loader::isKTX2(name))
+			{
+				LOGI("load image : {0}", name);
+				if (auto image = loadKTX2(name, mipmaps, flipY, compressed, false))
+					return image;
+
+				//a source image with the same name is the last resort
+				for (auto extension : {".png", ".jpg", ".tga"})
+				{
+					const auto fallback = StringUtils::removeExtension(name) + extension;
+					if (File::fileExists(fallback))
+						return loadSource(fallback, mipmaps, flipY);
+				}
+				return nullptr;
+			}
+
+			if (compressed && TextureImporter::isImported(name))
+			{
+				LOGI("load image : {0}", TextureImporter::getImportedPath(name));
+				if (auto image = loadKTX2(TextureImporter::getImportedPath(name), mipmaps, flipY, compressed, true))
+					return image;
+			}
+
+			if (source != nullptr)
+				return decodeSource(name, source->data(), source->size(), mipmaps, flipY);
+			return loadSource(name, mipmaps, flipY);
+		}
+
+		inline auto hashBytes(const uint8_t *bytes, uint64_t size) -> uint64_t
+		{
+			uint64_t hash = 14695981039346656037ull;
+			for (uint64_t i = 0; i < size; i++)
+				hash = (hash ^ bytes[i]) * 1099511628211ull;
+			return hash;
+		}
+
+		inline auto copyImage(const Image &image) -> std::unique_ptr<Image>
+		{
+			auto data = malloc(image.getImageSize());
+			std::memcpy(data, image.getData(), image.getImageSize());
+			auto copy = std::make_unique<Image>(image.getPixelFormat(), image.getWidth(), image.getHeight(), data, image.getImageSize(), image.getChannel(), image.isGenerateMipmaps(), image.isHDR());
+			copy->setLevels(image.getLevels());
+			return copy;
+		}
+
+		inline auto makeKey(const std::string &name, bool mipmaps, bool flipY, bool compressed)
+		{
+			return name + (mipmaps ? "|m" : "|-") + (flipY ? "f" : "-") + (compressed ? "c" : "-");
+		}
+
+		struct DecodedImage
+		{
+			std::shared_ptr<JobCounter> counter;
+			std::unique_ptr<Image>      image;
+		};
+
+		struct DecodeCache
+		{
+			std::mutex                                    mutex;
+			std::unordered_map<std::string, DecodedImage> images;
+		};
+
+		inline auto getDecodeCache() -> DecodeCache &
+		{
+			static DecodeCache cache;
+			return cache;
+		}
+
+		struct PrefetchSource
+		{
+			std::string                           name;
+			std::string                           key;
+			std::unique_ptr<std::vector<uint8_t>> bytes;
+			std::string                           content;        //hash and size of the file that is decoded, empty when it can not be read
+			bool                                  decodeBytes = false;
+		};
+
+		//false when nothing was prefetched for the key, the image is nullptr when the decoding failed
+		auto takeDecoded(const std::string &key, std::unique_ptr<Image> &image) -> bool
+		{
+			auto &                      cache = getDecodeCache();
+			std::shared_ptr<JobCounter> counter;
+			{
+				std::lock_guard<std::mutex> locker(cache.mutex);
+				auto                        iter = cache.images.find(key);
+				if (iter == cache.images.end())
+					return false;
+				counter = iter->second.counter;
+			}
+
+			if (!counter->isDone())
+			{
+				PROFILE_SCOPE("Wait Image Decode");
+				Application::getJobSystem()->wait(counter);
+			}
+
+			std::lock_guard<std::mutex> locker(cache.mutex);
+			auto                        iter = cache.images.find(key);
+			if (iter == cache.images.end())
+				return false;
+			image = std::move(iter->second.image);
+			cache.images.erase(iter);
+			return true;
+		}
+	}        // namespace
+
+	ImagePrefetch::~ImagePrefetch()
+	{
+		//the jobs still running find their entry gone and drop the image
+		auto &                      cache = getDecodeCache();
+		std::lock_guard<std::mutex> locker(cache.mutex);
+		for (auto &key : keys)
+			cache.images.erase(key);
+	}
+
+	auto ImagePrefetch::wait() -> void
+	{
+		if (counter != nullptr)
+			Application::getJobSystem()->wait(counter);
+	}
+
+	auto ImageLoader::loadAsset(const std::string &name, bool mipmaps, bool flipY, bool compressed) -> std::unique_ptr<Image>
 	{
 		PROFILE_FUNCTION();
-		bool hdr = stbi_is_hdr(name.c_str());
-		LOGI("load image : {0}", name);
-
-		stbi_set_flip_vertically_on_load(flipY);
-
-		int32_t       width;
-		int32_t       height;
-		int32_t       channels;
-		TextureFormat format = hdr ? TextureFormat::RGBA32 : TextureFormat::RGBA8;
-		uint8_t *     data   = hdr ?
-		                    (uint8_t *) stbi_loadf(name.c_str(), &width, &height, &channels, STBI_rgb_alpha) :
-		                    stbi_load(name.c_str(), &width, &height, &channels, STBI_rgb_alpha);
-
-		uint32_t imageSize = width * height * 4 * (hdr ? sizeof(float) : sizeof(uint8_t));
-		assert(data);
-		return std::make_unique<Image>(format, width, height, data, imageSize, channels, mipmaps, hdr);
+		std::unique_ptr<Image> image;
+		if (takeDecoded(makeKey(name, mipmaps, flipY, compressed), image))
+			return image;
+		return decodeFile(name, nullptr, mipmaps, flipY, compressed);
 	}
 
-	auto ImageLoader::loadAsset(const std::string &name, Image *image) -> void
+	auto ImageLoader::prefetch(const std::vector<std::string> &names, bool mipmaps, bool flipY, bool compressed) -> std::shared_ptr<ImagePrefetch>
+	{
+		PROFILE_FUNCTION();
+		auto prefetch     = std::make_shared<ImagePrefetch>();
+		prefetch->counter = std::make_shared<JobCounter>();
+
+		auto sources = std::make_shared<std::vector<PrefetchSource>>();
+		{
+			auto &                      cache = getDecodeCache();
+			std::lock_guard<std::mutex> locker(cache.mutex);
+			for (auto &name : names)
+			{
+				auto key = makeKey(name, mipmaps, flipY, compressed);
+				//listed twice or already prefetched by someone else, loadAsset waits for that one
+				if (cache.images.count(key) != 0)
+					continue;
+				cache.images[key].counter = prefetch->counter;
+				prefetch->keys.emplace_back(key);
+				sources->push_back({name, key});
+			}
+		}
+
+		if (sources->empty())
+			return prefetch;
+
+		auto &jobSystem = *Application::getJobSystem();
+		auto  read      = std::make_shared<JobCounter>();
+		for (uint32_t i = 0; i < sources->size(); i++)
+		{
+			jobSystem.execute([sources, i, compressed]() {
+				PROFILE_SCOPE("Read Image");
+				auto &source = (*sources)[i];
+
+				//the imported ktx2 is what gets decoded when it is taken, so it is the one that is compared
+				const bool imported = compressed && !KTX2Loader::isKTX2(source.name) && TextureImporter::isImported(source.name);
+				source.bytes        = File::read(imported ? TextureImporter::getImportedPath(source.name) : source.name);
+				if (source.bytes == nullptr)
+					return;
+
+				source.decodeBytes = !imported && !KTX2Loader::isKTX2(source.name);
+				source.content     = std::to_string(hashBytes(source.bytes->data(), source.bytes->size())) + "|" + std::to_string(source.bytes->size()) + (imported ? "|i" : "");
+			},
+			                  read);
+		}
+
+		jobSystem.executeAfter(
+		    read, [sources, mipmaps, flipY, compressed, counter = prefetch->counter]() {
+			    std::unordered_map<std::string, std::vector<uint32_t>> groups;
+			    for (uint32_t i = 0; i < sources->size(); i++)
+			    {
+				    auto &source = (*sources)[i];
+				    groups[source.content.empty() ? source.key : source.content].emplace_back(i);
+			    }
+
+			    LOGI("decoding {0} images, {1} with identical contents are copied", sources->size(), sources->size() - groups.size());
+
+			    for (auto &group : groups)
+			    {
+				    Application::getJobSystem()->execute([sources, indices = group.second, mipmaps, flipY, compressed]() {
+					    PROFILE_SCOPE("Decode Image");
+					    auto &first = (*sources)[indices[0]];
+					    auto  image = decodeFile(first.name, first.decodeBytes ? first.bytes.get() : nullptr, mipmaps, flipY, compressed);
+					    first.bytes.reset();
+
+					    auto &                      cache = getDecodeCache();
+					    std::lock_guard<std::mutex> locker(cache.mutex);
+					    for (size_t i = indices.size(); i-- > 0;)
+					    {
+						    auto iter = cache.images.find((*sources)[indices[i]].key);
+						    if (iter != cache.images.end())
+							    iter->second.image = i == 0 || image == nullptr ? std::move(image) : copyImage(*image);
+					    }
+				    },
+				                                         counter);
+			    }
+		    },
+		    prefetch->counter);
+
+		return prefetch;
+	}
+
+	auto ImageLoader::decode(const std::vector<const std::vector<uint8_t> *> &encoded, bool flipY) -> std::vector<std::unique_ptr<Image>>
 	{
 		PROFILE_FUNCTION();
-		bool hdr = stbi_is_hdr(name.c_str());
+		std::vector<std::unique_ptr<Image>> images(encoded.size());
+		std::vector<std::string>            contents(encoded.size());
 
-		stbi_set_flip_vertically_on_load(1);
+		auto &jobSystem = *Application::getJobSystem();
+		parallelFor(jobSystem, static_cast<uint32_t>(encoded.size()), [&](uint32_t i) {
+			if (encoded[i] != nullptr && !encoded[i]->empty())
+				contents[i] = std::to_string(hashBytes(encoded[i]->data(), encoded[i]->size())) + "|" + std::to_string(encoded[i]->size());
+		});
 
-		int32_t       width;
-		int32_t       height;
-		int32_t       channels;
-		TextureFormat format    = TextureFormat::RGBA8;
-		uint8_t *     data      = stbi_load(name.c_str(), &width, &height, &channels, STBI_rgb_alpha);
-		uint32_t      imageSize = width * height * 4;
-		assert(data);
+		std::unordered_map<std::string, uint32_t> firsts;
+		std::vector<uint32_t>                     unique;
+		for (uint32_t i = 0; i < encoded.size(); i++)
+		{
+			if (!contents[i].empty() && firsts.emplace(contents[i], i).second)
+				unique.emplace_back(i);
+		}
+
+		parallelFor(jobSystem, static_cast<uint32_t>(unique.size()), [&](uint32_t i) {
+			const auto index = unique[i];
+			images[index]    = decodeSource("image " + std::to_string(index), encoded[index]->data(), encoded[index]->size(), false, flipY, false);
+		});
+
+		for (uint32_t i = 0; i < encoded.size(); i++)
+		{
+			if (contents[i].empty())
+				continue;
+			const auto first = firsts[contents[i]];
+			if (first != i && images[first] != nullptr)
+				images[i] = copyImage(*images[first]);
+		}
+		return images;
+	}
+
+	auto ImageLoader::loadAsset(const std::string &name, Image *image) -> void
+	{
+		PROFILE_FUNCTION();
+		auto decoded = loadSource(name, false, true, false);
+		assert(decoded);
 
 		image->setChannel(4);
-		image->setWidth(width);
-		image->setHeight(height);
-		image->setPixelFormat(format);
-		image->setData(data);
-		image->setSize(imageSize);
+		image->setWidth(decoded->getWidth());
+		image->setHeight(decoded->getHeight());
+		image->setPixelFormat(decoded->getPixelFormat());
+		image->setData(decoded->getData());
+		image->setSize(decoded->getImageSize());
+		decoded->setData(nullptr);
 	}
 
 }        // namespace maple
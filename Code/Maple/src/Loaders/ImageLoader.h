@@ -6,14 +6,56 @@
 #include "Loader.h"
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace maple
 {
-	class ImageLoader final
+	class JobCounter;
+
+	/**
+	 * Images decoded ahead on the job system by ImageLoader::prefetch. loadAsset with the same arguments takes
+	 * the pixels from here instead of decoding them, the ones nobody took are dropped with the last reference.
+	 */
+	class MAPLE_EXPORT ImagePrefetch final
 	{
 	  public:
-		static auto loadAsset(const std::string &name, bool mipmaps = true, bool flipY = true) -> std::unique_ptr<Image>;
+		ImagePrefetch() = default;
+		~ImagePrefetch();
+		NO_COPYABLE(ImagePrefetch);
+
+		auto wait() -> void;
+
+	  private:
+		friend class ImageLoader;
+		std::shared_ptr<JobCounter> counter;
+		std::vector<std::string>    keys;
+	};
+
+	/**
+	 * Decoding is thread safe, the vertical flip is done per call after stb_image decoded the rows
+	 * instead of through its process wide flag.
+	 */
+	class MAPLE_EXPORT ImageLoader final
+	{
+	  public:
+		/**
+		 * compressed : the image may come back block compressed with its mip chain (Image::getLevels), read from a .ktx2 file
+		 * or from the one the TextureImporter wrote next to the source. otherwise it is always a single RGBA8/RGBA32 level.
+		 */
+		static auto loadAsset(const std::string &name, bool mipmaps = true, bool flipY = true, bool compressed = false) -> std::unique_ptr<Image>;
 		static auto loadAsset(const std::string &name, Image *image) -> void;
+
+		/**
+		 * decodes the images on the job system. a path is decoded once however often it is listed or prefetched,
+		 * files with identical contents are decoded once and copied.
+		 */
+		static auto prefetch(const std::vector<std::string> &names, bool mipmaps = true, bool flipY = true, bool compressed = false) -> std::shared_ptr<ImagePrefetch>;
+
+		/**
+		 * decodes encoded images (png, jpg, ...) in memory to RGBA8 on the job system and waits for them.
+		 * identical buffers are decoded once, nullptr for the ones that are empty or can not be decoded.
+		 */
+		static auto decode(const std::vector<const std::vector<uint8_t> *> &encoded, bool flipY) -> std::vector<std::unique_ptr<Image>>;
 	};
 
 }        // namespace maple
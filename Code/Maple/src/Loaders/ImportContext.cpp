@@ -0,0 +1,229 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+#include "ImportContext.h"
+#include "ImageLoader.h"
+
+#include "Engine/Material.h"
+#include "Engine/Profiler.h"
+#include "FileSystem/MeshResource.h"
+#include "RHI/Texture.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+
+namespace maple
+{
+	namespace
+	{
+		thread_local ImportContext *currentContext = nullptr;
+
+		//what the loaders hold until the import is flushed, it never reaches the renderer
+		class StandInTexture2D final : public Texture2D
+		{
+		  public:
+			StandInTexture2D(const std::string &filePath, uint32_t width, uint32_t height, TextureParameters parameters, TextureLoadOptions loadOptions) :
+			    filePath(filePath),
+			    width(width),
+			    height(height),
+			    parameters(parameters),
+			    loadOptions(loadOptions)
+			{
+			}
+
+			auto bind(uint32_t slot) const -> void override{};
+			auto unbind(uint32_t slot) const -> void override{};
+			auto buildTexture(TextureFormat internalformat, uint32_t width, uint32_t height, bool srgb, bool depth, bool samplerShadow, bool mipmap, bool image, uint32_t accessFlag) -> void override{};
+			auto update(uint32_t x, uint32_t y, uint32_t w, uint32_t h, const void *buffer) -> void override{};
+			auto setData(const void *pixels) -> void override{};
+
+			inline auto getHandle() -> void * override
+			{
+				return nullptr;
+			}
+
+			inline auto getWidth() const -> uint32_t override
+			{
+				return width;
+			}
+
+			inline auto getHeight() const -> uint32_t override
+			{
+				return height;
+			}
+
+			inline auto getFilePath() const -> const std::string & override
+			{
+				return filePath;
+			}
+
+			inline auto getPath() const -> std::string override
+			{
+				return filePath;
+			}
+
+			inline auto getFormat() const -> TextureFormat override
+			{
+				return parameters.format;
+			}
+
+			inline auto getParameters() const -> TextureParameters override
+			{
+				return parameters;
+			}
+
+			inline auto getLoadOptions() const -> TextureLoadOptions override
+			{
+				return loadOptions;
+			}
+
+		  private:
+			std::string        filePath;
+			uint32_t           width;
+			uint32_t           height;
+			TextureParameters  parameters;
+			TextureLoadOptions loadOptions;
+		};
+	}        // namespace
+
+	ImportContext::Scope::Scope(ImportContext &context) :
+	    previous(currentContext)
+	{
+		currentContext = &context;
+	}
+
+	ImportContext::Scope::~Scope()
+	{
+		currentContext = previous;
+	}
+
+	auto ImportContext::current() -> ImportContext *
+	{
+		return currentContext;
+	}
+
+	auto ImportContext::defer(const std::function<void()> &create) -> void
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		tasks.emplace_back(create);
+	}
+
+	auto ImportContext::createTexture(const std::string &name, const std::string &filePath, TextureParameters parameters, TextureLoadOptions loadOptions) -> std::shared_ptr<Texture2D>
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		if (auto iter = files.find(filePath); iter != files.end())
+			return iter->second;
+
+		auto standIn = std::make_shared<StandInTexture2D>(filePath, 0, 0, parameters, loadOptions);
+		standIn->setName(name);
+		files.emplace(filePath, standIn);
+		tasks.emplace_back([this, key = standIn.get(), name, filePath, parameters, loadOptions]() {
+			textures[key] = Texture2D::create(name, filePath, parameters, loadOptions);
+		});
+		return standIn;
+	}
+
+	auto ImportContext::createTexture(uint32_t width, uint32_t height, const void *data, TextureParameters parameters, TextureLoadOptions loadOptions) -> std::shared_ptr<Texture2D>
+	{
+		//the loader frees its pixels before the flush
+		std::vector<uint8_t> pixels;
+		if (data != nullptr)
+		{
+			pixels.resize(uint64_t(width) * height * Texture::getStrideFromFormat(parameters.format));
+			std::memcpy(pixels.data(), data, pixels.size());
+		}
+
+		auto                        standIn = std::make_shared<StandInTexture2D>("", width, height, parameters, loadOptions);
+		std::lock_guard<std::mutex> lock(mutex);
+		tasks.emplace_back([this, key = standIn.get(), width, height, pixels = std::move(pixels), parameters, loadOptions]() mutable {
+			textures[key] = Texture2D::create(width, height, pixels.empty() ? nullptr : pixels.data(), parameters, loadOptions);
+		});
+		return standIn;
+	}
+
+	auto ImportContext::clear() -> void
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		tasks.clear();
+		files.clear();
+		prefetches.clear();
+		next = 0;
+	}
+
+	auto ImportContext::keep(const std::shared_ptr<ImagePrefetch> &prefetch) -> void
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		prefetches.emplace_back(prefetch);
+	}
+
+	auto ImportContext::setProgress(float progress) -> void
+	{
+		parsed = std::clamp(progress, 0.f, 1.f);
+	}
+
+	auto ImportContext::getProgress() -> float
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		const float created = tasks.empty() ? 0.f : float(next) / tasks.size();
+		return 0.5f * parsed + 0.5f * created;
+	}
+
+	auto ImportContext::flush(float budget) -> bool
+	{
+		PROFILE_FUNCTION();
+		using Clock      = std::chrono::steady_clock;
+		const auto start = Clock::now();
+
+		std::unique_lock<std::mutex> lock(mutex);
+		while (next < tasks.size())
+		{
+			//one task at least, so that the import moves on whatever the budget
+			auto task = std::move(tasks[next]);
+			lock.unlock();
+			task();
+			lock.lock();
+			next++;
+			if (std::chrono::duration<float, std::milli>(Clock::now() - start).count() >= budget)
+				break;
+		}
+
+		if (next < tasks.size())
+			return false;
+
+		prefetches.clear();
+		return true;
+	}
+
+	auto ImportContext::resolve(const std::vector<std::shared_ptr<IResource>> &resources) -> void
+	{
+		PROFILE_FUNCTION();
+		auto replace = [&](std::shared_ptr<Texture2D> &texture) {
+			if (auto iter = textures.find(texture.get()); texture != nullptr && iter != textures.end())
+				texture = iter->second;
+		};
+
+		for (auto &resource : resources)
+		{
+			if (resource->getResourceType() != FileType::Model)
+				continue;
+
+			for (auto &mesh : std::static_pointer_cast<MeshResource>(resource)->getMeshes())
+			{
+				for (auto &material : mesh.second->getMaterial())
+				{
+					if (material == nullptr)
+						continue;
+					auto pbrTextures = material->getTextures();
+					replace(pbrTextures.albedo);
+					replace(pbrTextures.normal);
+					replace(pbrTextures.metallic);
+					replace(pbrTextures.roughness);
+					replace(pbrTextures.ao);
+					replace(pbrTextures.emissive);
+					material->setTextures(pbrTextures);
+				}
+			}
+		}
+	}
+}        // namespace maple
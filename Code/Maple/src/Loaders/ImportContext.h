@@ -0,0 +1,80 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "Engine/Core.h"
+#include "FileSystem/IResource.h"
+#include "RHI/Definitions.h"
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace maple
+{
+	class Texture2D;
+	class ImagePrefetch;
+
+	/**
+	 * Gpu work of a model import running on the job system. While a context is current on a thread, the meshes and
+	 * textures created there only keep their data, the buffers and images are created by flush on the main thread
+	 * which owns the graphics context. The textures handed to the loaders are stand ins holding what they were
+	 * created with, resolve swaps them for the real ones in the materials once everything is flushed.
+	 */
+	class MAPLE_EXPORT ImportContext final
+	{
+	  public:
+		class MAPLE_EXPORT Scope final
+		{
+		  public:
+			Scope(ImportContext &context);
+			~Scope();
+			NO_COPYABLE(Scope);
+
+		  private:
+			ImportContext *previous = nullptr;
+		};
+
+		ImportContext() = default;
+		NO_COPYABLE(ImportContext);
+
+		//the context of the calling thread, nullptr when the gpu resources are created right away
+		static auto current() -> ImportContext *;
+
+		//the resources the closure writes to have to outlive the flush
+		auto defer(const std::function<void()> &create) -> void;
+
+		auto createTexture(const std::string &name, const std::string &filePath, TextureParameters parameters, TextureLoadOptions loadOptions) -> std::shared_ptr<Texture2D>;
+		auto createTexture(uint32_t width, uint32_t height, const void *data, TextureParameters parameters, TextureLoadOptions loadOptions) -> std::shared_ptr<Texture2D>;
+
+		//drops what was deferred, for the resources of an import which failed half way
+		auto clear() -> void;
+
+		//keeps the decoded images alive until the textures reading them are flushed
+		auto keep(const std::shared_ptr<ImagePrefetch> &prefetch) -> void;
+
+		//fraction of the geometry processed by the loader
+		auto setProgress(float progress) -> void;
+		//half loader, half gpu resources created
+		auto getProgress() -> float;
+
+		//main thread only. creates the deferred resources for about budget milliseconds, true once all of them are created
+		auto flush(float budget) -> bool;
+
+		//main thread only, after flush. the materials of the meshes refer to the created textures afterwards
+		auto resolve(const std::vector<std::shared_ptr<IResource>> &resources) -> void;
+
+	  private:
+		std::mutex                                                       mutex;
+		std::vector<std::function<void()>>                               tasks;
+		size_t                                                           next = 0;
+		std::unordered_map<std::string, std::shared_ptr<Texture2D>>      files;
+		std::unordered_map<const Texture2D *, std::shared_ptr<Texture2D>> textures;
+		std::vector<std::shared_ptr<ImagePrefetch>>                      prefetches;
+		std::atomic<float>                                               parsed = 0.f;
+	};
+}        // namespace maple
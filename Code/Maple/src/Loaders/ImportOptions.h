@@ -0,0 +1,17 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include <cstdint>
+
+namespace maple
+{
+	//how the model loaders process what they import, set on the AssetsLoaderFactory before the models are loaded
+	struct ImportOptions
+	{
+		//quantized position stream and packed attributes, see VertexCompression. vulkan only,
+		//the ray traced passes and the voxel/LPV GI read the float vertices and skip or reject compressed meshes
+		bool compressVertices = false;
+		bool optimizeMeshes   = true;        //reordered for the vertex cache, overdraw and vertex fetch, see MeshOptimizer
+	};
+}        // namespace maple
@@ -0,0 +1,481 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+#include "KTX2Loader.h"
+#include "Engine/Profiler.h"
+#include "FileSystem/File.h"
+#include "Others/Console.h"
+#include "Others/StringUtils.h"
+#include "RHI/Texture.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <vector>
+#include <zlib.h>
+
+namespace maple
+{
+	namespace
+	{
+		constexpr uint8_t Identifier[12] = {0xAB, 'K', 'T', 'X', ' ', '2', '0', 0xBB, '\r', '\n', 0x1A, '\n'};
+
+		enum SupercompressionScheme : uint32_t
+		{
+			SupercompressionNone    = 0,
+			SupercompressionBasisLZ = 1,
+			SupercompressionZstd    = 2,
+			SupercompressionZlib    = 3
+		};
+
+		//the VkFormat values ktx2 stores, the file format does not depend on the vulkan headers
+		enum VkFormatValue : uint32_t
+		{
+			FormatUndefined     = 0,
+			FormatR8Unorm       = 9,
+			FormatR8G8Unorm     = 16,
+			FormatR8G8B8A8Unorm = 37,
+			FormatR8G8B8A8Srgb  = 43,
+			FormatBC1RGBUnorm   = 131,
+			FormatBC1RGBSrgb    = 132,
+			FormatBC1RGBAUnorm  = 133,
+			FormatBC1RGBASrgb   = 134,
+			FormatBC3Unorm      = 137,
+			FormatBC3Srgb       = 138,
+			FormatBC4Unorm      = 139,
+			FormatBC5Unorm      = 141,
+			FormatBC7Unorm      = 145,
+			FormatBC7Srgb       = 146,
+			FormatASTC4x4Unorm  = 157,
+			FormatASTC4x4Srgb   = 158
+		};
+
+		//color models of the data format descriptor
+		enum ColorModel : uint8_t
+		{
+			ModelRGBSDA = 1,
+			ModelBC1A   = 128,
+			ModelBC3    = 130,
+			ModelBC4    = 131,
+			ModelBC5    = 132,
+			ModelBC7    = 134,
+			ModelASTC   = 162,
+			ModelETC1S  = 163,
+			ModelUASTC  = 166
+		};
+
+		struct Header
+		{
+			uint8_t  identifier[12];
+			uint32_t vkFormat;
+			uint32_t typeSize;
+			uint32_t pixelWidth;
+			uint32_t pixelHeight;
+			uint32_t pixelDepth;
+			uint32_t layerCount;
+			uint32_t faceCount;
+			uint32_t levelCount;
+			uint32_t supercompressionScheme;
+			uint32_t dfdByteOffset;
+			uint32_t dfdByteLength;
+			uint32_t kvdByteOffset;
+			uint32_t kvdByteLength;
+			uint64_t sgdByteOffset;
+			uint64_t sgdByteLength;
+		};
+		static_assert(sizeof(Header) == 80, "the ktx2 header is 80 bytes");
+
+		struct LevelIndex
+		{
+			uint64_t byteOffset;
+			uint64_t byteLength;
+			uint64_t uncompressedByteLength;
+		};
+
+		inline auto alignUp(uint64_t value, uint64_t alignment) -> uint64_t
+		{
+			return (value + alignment - 1) / alignment * alignment;
+		}
+
+		inline auto toTextureFormat(uint32_t vkFormat) -> TextureFormat
+		{
+			switch (vkFormat)
+			{
+				case FormatR8Unorm:
+					return TextureFormat::R8;
+				case FormatR8G8Unorm:
+					return TextureFormat::RG8;
+				case FormatR8G8B8A8Unorm:
+				case FormatR8G8B8A8Srgb:
+					return TextureFormat::RGBA8;
+				case FormatBC1RGBUnorm:
+				case FormatBC1RGBSrgb:
+				case FormatBC1RGBAUnorm:
+				case FormatBC1RGBASrgb:
+					return TextureFormat::BC1;
+				case FormatBC3Unorm:
+				case FormatBC3Srgb:
+					return TextureFormat::BC3;
+				case FormatBC4Unorm:
+					return TextureFormat::BC4;
+				case FormatBC5Unorm:
+					return TextureFormat::BC5;
+				case FormatBC7Unorm:
+				case FormatBC7Srgb:
+					return TextureFormat::BC7;
+				case FormatASTC4x4Unorm:
+				case FormatASTC4x4Srgb:
+					return TextureFormat::ASTC_4x4;
+				default:
+					return TextureFormat::NONE;
+			}
+		}
+
+		inline auto toVkFormat(TextureFormat format) -> uint32_t
+		{
+			switch (format)
+			{
+				case TextureFormat::R8:
+					return FormatR8Unorm;
+				case TextureFormat::RG8:
+					return FormatR8G8Unorm;
+				case TextureFormat::RGBA8:
+				case TextureFormat::RGBA:
+					return FormatR8G8B8A8Unorm;
+				case TextureFormat::BC1:
+					return FormatBC1RGBUnorm;
+				case TextureFormat::BC3:
+					return FormatBC3Unorm;
+				case TextureFormat::BC4:
+					return FormatBC4Unorm;
+				case TextureFormat::BC5:
+					return FormatBC5Unorm;
+				case TextureFormat::BC7:
+					return FormatBC7Unorm;
+				case TextureFormat::ASTC_4x4:
+					return FormatASTC4x4Unorm;
+				default:
+					return FormatUndefined;
+			}
+		}
+
+		//bytes of a level, 4 byte aligned like VulkanUploadManager::ImageUpload expects the levels
+		inline auto levelSize(TextureFormat format, uint32_t width, uint32_t height, uint32_t level) -> uint64_t
+		{
+			return alignUp(Texture::getLevelSize(format, std::max(width >> level, 1u), std::max(height >> level, 1u)), 4);
+		}
+
+		inline auto put32(std::vector<uint8_t> &out, uint32_t value) -> void
+		{
+			for (int32_t i = 0; i < 4; i++)
+				out.emplace_back(static_cast<uint8_t>(value >> (i * 8)));
+		}
+
+		//the basic data format descriptor, the engine samples everything as unorm so the transfer function is linear
+		auto writeDescriptor(TextureFormat format, std::vector<uint8_t> &out) -> void
+		{
+			struct Sample
+			{
+				uint32_t bitOffset;
+				uint32_t bitLength;
+				uint32_t channel;
+				uint32_t upper;
+			};
+
+			uint8_t             model     = ModelRGBSDA;
+			uint32_t            blockSize = Texture::getBlockSize(format);
+			std::vector<Sample> samples;
+			switch (format)
+			{
+				case TextureFormat::R8:
+					samples = {{0, 8, 0, 255}};
+					break;
+				case TextureFormat::RG8:
+					samples = {{0, 8, 0, 255}, {8, 8, 1, 255}};
+					break;
+				case TextureFormat::BC1:
+					model   = ModelBC1A;
+					samples = {{0, 64, 0, UINT32_MAX}};
+					break;
+				case TextureFormat::BC3:
+					model   = ModelBC3;
+					samples = {{0, 64, 15, UINT32_MAX}, {64, 64, 0, UINT32_MAX}};
+					break;
+				case TextureFormat::BC4:
+					model   = ModelBC4;
+					samples = {{0, 64, 0, UINT32_MAX}};
+					break;
+				case TextureFormat::BC5:
+					model   = ModelBC5;
+					samples = {{0, 64, 0, UINT32_MAX}, {64, 64, 1, UINT32_MAX}};
+					break;
+				case TextureFormat::BC7:
+					model   = ModelBC7;
+					samples = {{0, 128, 0, UINT32_MAX}};
+					break;
+				case TextureFormat::ASTC_4x4:
+					model   = ModelASTC;
+					samples = {{0, 128, 0, UINT32_MAX}};
+					break;
+				default:
+					samples = {{0, 8, 0, 255}, {8, 8, 1, 255}, {16, 8, 2, 255}, {24, 8, 15, 255}};
+					break;
+			}
+
+			const auto blockBytes = 24 + 16 * static_cast<uint32_t>(samples.size());
+			const auto dimension  = Texture::isCompressedFormat(format) ? 3u : 0u;
+			const auto bytesPlane = blockSize != 0 ? blockSize : Texture::getStrideFromFormat(format);
+
+			put32(out, blockBytes + 4);
+			put32(out, 0);                                          //khronos vendor, basic descriptor type
+			put32(out, 2 | (blockBytes << 16));                     //version 2
+			put32(out, model | (1 << 8) | (1 << 16));               //bt709 primaries, linear transfer, straight alpha
+			put32(out, dimension | (dimension << 8));               //texel block dimensions minus one
+			put32(out, bytesPlane);
+			put32(out, 0);
+			for (auto &sample : samples)
+			{
+				put32(out, sample.bitOffset | ((sample.bitLength - 1) << 16) | (sample.channel << 24));
+				put32(out, 0);
+				put32(out, 0);
+				put32(out, sample.upper);
+			}
+		}
+
+		auto writeKeyValue(const std::string &key, const std::string &value, std::vector<uint8_t> &out) -> void
+		{
+			put32(out, static_cast<uint32_t>(key.size() + value.size() + 2));
+			out.insert(out.end(), key.begin(), key.end());
+			out.emplace_back(0);
+			out.insert(out.end(), value.begin(), value.end());
+			out.emplace_back(0);
+			out.resize(alignUp(out.size(), 4));
+		}
+
+		//KTXorientation, "rd" when the first row is the top one
+		auto readOrientation(const uint8_t *data, uint32_t length) -> std::string
+		{
+			uint64_t offset = 0;
+			while (offset + 4 <= length)
+			{
+				uint32_t size;
+				std::memcpy(&size, data + offset, sizeof(uint32_t));
+				//size comes from the file, compare it without adding to it
+				if (size > length - offset - 4)
+					break;
+
+				const auto entry = reinterpret_cast<const char *>(data + offset + 4);
+				const auto key   = std::string(entry, strnlen(entry, size));
+				if (key == "KTXorientation" && key.size() + 1 < size)
+					return std::string(entry + key.size() + 1, strnlen(entry + key.size() + 1, size - key.size() - 1));
+
+				offset = alignUp(offset + 4 + size, 4);
+			}
+			return "rd";
+		}
+	}        // namespace
+
+	auto KTX2Loader::isKTX2(const std::string &name) -> bool
+	{
+		auto extension = StringUtils::getExtension(name);
+		std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c) -> unsigned char { return std::tolower(c); });
+		return extension == "ktx2";
+	}
+
+	auto KTX2Loader::load(const std::string &name, bool &flipped) -> std::unique_ptr<Image>
+	{
+		PROFILE_FUNCTION();
+		auto file = File::read(name);
+		if (file == nullptr || file->size() < sizeof(Header))
+		{
+			LOGE("KTX2 : can not read {0}", name);
+			return nullptr;
+		}
+
+		Header header;
+		std::memcpy(&header, file->data(), sizeof(Header));
+		if (std::memcmp(header.identifier, Identifier, sizeof(Identifier)) != 0)
+		{
+			LOGE("KTX2 : {0} is not a ktx2 file", name);
+			return nullptr;
+		}
+
+		const auto levels = std::max(header.levelCount, 1u);
+		if (header.pixelDepth > 1 || header.layerCount > 1 || header.faceCount != 1 || header.pixelWidth == 0 || header.pixelHeight == 0 ||
+		    sizeof(Header) + sizeof(LevelIndex) * uint64_t(levels) > file->size())
+		{
+			LOGE("KTX2 : {0} is not a 2D texture, arrays, cube maps and 3D textures are not supported", name);
+			return nullptr;
+		}
+
+		//a level past the 1x1 one would shift the size by 32 or more
+		if (levels > Texture::calculateMipMapCount(header.pixelWidth, header.pixelHeight))
+		{
+			LOGE("KTX2 : {0} has {1} levels, more than a {2}x{3} texture can have", name, levels, header.pixelWidth, header.pixelHeight);
+			return nullptr;
+		}
+
+		uint8_t model = 0;
+		if (header.dfdByteLength >= 16 && uint64_t(header.dfdByteOffset) + header.dfdByteLength <= file->size())
+			model = (*file)[header.dfdByteOffset + 12];
+
+		if (header.supercompressionScheme == SupercompressionBasisLZ || model == ModelETC1S || model == ModelUASTC)
+		{
+			LOGE("KTX2 : {0} is Basis Universal encoded, which needs a transcoder the engine is not built with. import it with TextureImporter instead", name);
+			return nullptr;
+		}
+
+		if (header.supercompressionScheme != SupercompressionNone && header.supercompressionScheme != SupercompressionZlib)
+		{
+			LOGE("KTX2 : supercompression scheme {0} of {1} is not supported", header.supercompressionScheme, name);
+			return nullptr;
+		}
+
+		const auto format = toTextureFormat(header.vkFormat);
+		if (format == TextureFormat::NONE)
+		{
+			LOGE("KTX2 : vkFormat {0} of {1} is not supported", header.vkFormat, name);
+			return nullptr;
+		}
+
+		std::vector<LevelIndex> index(levels);
+		std::memcpy(index.data(), file->data() + sizeof(Header), sizeof(LevelIndex) * levels);
+
+		uint64_t size = 0;
+		for (uint32_t level = 0; level < levels; level++)
+			size += levelSize(format, header.pixelWidth, header.pixelHeight, level);
+
+		//the file stores the smallest level first, the image the largest
+		auto data = static_cast<uint8_t *>(malloc(size));
+		if (data == nullptr)
+		{
+			LOGE("KTX2 : can not allocate {0} bytes for {1}", size, name);
+			return nullptr;
+		}
+
+		uint64_t offset = 0;
+		for (uint32_t level = 0; level < levels; level++)
+		{
+			const auto &entry    = index[level];
+			const auto  expected = Texture::getLevelSize(format, std::max(header.pixelWidth >> level, 1u), std::max(header.pixelHeight >> level, 1u));
+
+			//offset + length may wrap around
+			bool valid = entry.byteOffset <= file->size() && entry.byteLength <= file->size() - entry.byteOffset;
+			if (valid && header.supercompressionScheme == SupercompressionZlib)
+			{
+				uLongf length = static_cast<uLongf>(expected);
+				valid         = uncompress(data + offset, &length, file->data() + entry.byteOffset, static_cast<uLong>(entry.byteLength)) == Z_OK && length == expected;
+			}
+			else if (valid)
+			{
+				valid = entry.byteLength >= expected;
+				if (valid)
+					std::memcpy(data + offset, file->data() + entry.byteOffset, expected);
+			}
+
+			if (!valid)
+			{
+				LOGE("KTX2 : level {0} of {1} is corrupted", level, name);
+				free(data);
+				return nullptr;
+			}
+			offset += levelSize(format, header.pixelWidth, header.pixelHeight, level);
+		}
+
+		flipped = false;
+		if (header.kvdByteLength > 0 && uint64_t(header.kvdByteOffset) + header.kvdByteLength <= file->size())
+			flipped = readOrientation(file->data() + header.kvdByteOffset, header.kvdByteLength).find('u') != std::string::npos;
+
+		const auto channels = format == TextureFormat::R8 || format == TextureFormat::BC4 ? 1 : format == TextureFormat::RG8 || format == TextureFormat::BC5 ? 2 : 4;
+		auto       image    = std::make_unique<Image>(format, header.pixelWidth, header.pixelHeight, data, static_cast<uint32_t>(size), channels, levels > 1);
+		image->setLevels(levels);
+		image->setFileName(name);
+		return image;
+	}
+
+	auto KTX2Loader::save(const std::string &name, const Image &image, bool flipped, bool zlib) -> bool
+	{
+		PROFILE_FUNCTION();
+		const auto format   = image.getPixelFormat();
+		const auto vkFormat = toVkFormat(format);
+		if (vkFormat == FormatUndefined)
+		{
+			LOGE("KTX2 : {0} can not be written with the format {1}", name, static_cast<int32_t>(format));
+			return false;
+		}
+
+		const auto levels = std::max(image.getLevels(), 1u);
+		const auto width  = image.getWidth();
+		const auto height = image.getHeight();
+		const auto pixels = static_cast<const uint8_t *>(image.getData());
+
+		std::vector<uint8_t> descriptor;
+		writeDescriptor(format, descriptor);
+
+		std::vector<uint8_t> keyValues;
+		writeKeyValue("KTXorientation", flipped ? "ru" : "rd", keyValues);
+		writeKeyValue("KTXwriter", "Maple Engine TextureImporter", keyValues);
+
+		Header header{};
+		std::memcpy(header.identifier, Identifier, sizeof(Identifier));
+		header.vkFormat               = vkFormat;
+		header.typeSize               = 1;
+		header.pixelWidth             = width;
+		header.pixelHeight            = height;
+		header.faceCount              = 1;
+		header.levelCount             = levels;
+		header.supercompressionScheme = zlib ? SupercompressionZlib : SupercompressionNone;
+		header.dfdByteOffset          = static_cast<uint32_t>(sizeof(Header) + sizeof(LevelIndex) * levels);
+		header.dfdByteLength          = static_cast<uint32_t>(descriptor.size());
+		header.kvdByteOffset          = header.dfdByteOffset + header.dfdByteLength;
+		header.kvdByteLength          = static_cast<uint32_t>(keyValues.size());
+
+		std::vector<uint64_t> sources(levels);
+		for (uint32_t level = 1; level < levels; level++)
+			sources[level] = sources[level - 1] + levelSize(format, width, height, level - 1);
+
+		//the level data starts aligned to the block size and the smallest level comes first
+		const uint64_t          alignment = zlib ? 1 : std::max<uint64_t>(Texture::getBlockSize(format), 4);
+		std::vector<uint8_t>    payload;
+		std::vector<LevelIndex> index(levels);
+		uint64_t                start = header.kvdByteOffset + header.kvdByteLength;
+		for (int32_t level = static_cast<int32_t>(levels) - 1; level >= 0; level--)
+		{
+			const auto bytes = Texture::getLevelSize(format, std::max(width >> level, 1u), std::max(height >> level, 1u));
+			payload.resize(alignUp(start + payload.size(), alignment) - start);
+
+			auto &entry                  = index[level];
+			entry.byteOffset             = start + payload.size();
+			entry.uncompressedByteLength = bytes;
+
+			if (zlib)
+			{
+				uLongf length = compressBound(static_cast<uLong>(bytes));
+				payload.resize(payload.size() + length);
+				compress2(payload.data() + entry.byteOffset - start, &length, pixels + sources[level], static_cast<uLong>(bytes), Z_BEST_COMPRESSION);
+				payload.resize(entry.byteOffset - start + length);
+				entry.byteLength = length;
+			}
+			else
+			{
+				payload.insert(payload.end(), pixels + sources[level], pixels + sources[level] + bytes);
+				entry.byteLength = bytes;
+			}
+		}
+
+		std::ofstream out(name, std::ios::binary | std::ios::trunc);
+		if (!out)
+		{
+			LOGE("KTX2 : can not write {0}", name);
+			return false;
+		}
+
+		out.write(reinterpret_cast<const char *>(&header), sizeof(Header));
+		out.write(reinterpret_cast<const char *>(index.data()), sizeof(LevelIndex) * index.size());
+		out.write(reinterpret_cast<const char *>(descriptor.data()), descriptor.size());
+		out.write(reinterpret_cast<const char *>(keyValues.data()), keyValues.size());
+		out.write(reinterpret_cast<const char *>(payload.data()), payload.size());
+		return out.good();
+	}
+}        // namespace maple
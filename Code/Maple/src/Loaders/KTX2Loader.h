@@ -0,0 +1,28 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "FileSystem/Image.h"
+#include <memory>
+#include <string>
+
+namespace maple
+{
+	/**
+	 * Reads and writes KTX2 containers of 2D textures with their mip chain.
+	 * The levels are stored as they are uploaded (RGBA8, BC1/3/4/5/7 or ASTC 4x4), raw or zlib supercompressed.
+	 * The bundled libktx only knows KTX1 and there is no Basis Universal transcoder in the tree, so BasisLZ/UASTC
+	 * and zstd files are rejected with an error and the caller falls back to the source image.
+	 */
+	class KTX2Loader final
+	{
+	  public:
+		static auto isKTX2(const std::string &name) -> bool;
+
+		//the levels come back as stored, flipped is whether the first row of the file is the bottom one
+		static auto load(const std::string &name, bool &flipped) -> std::unique_ptr<Image>;
+
+		//image holds image.getLevels() mips one after another, zlib supercompresses every level
+		static auto save(const std::string &name, const Image &image, bool flipped, bool zlib = true) -> bool;
+	};
+}        // namespace maple
@@ -4,14 +4,81 @@
 #include "Loader.h"
 #include "FBXLoader.h"
 #include "GLTFLoader.h"
+#include "ImportContext.h"
+#include "MeshCache.h"
 #include "OBJLoader.h"
 
 #include "Application.h"
+#include "Engine/Profiler.h"
+#include "Engine/VertexCompression.h"
+#include "FileSystem/MeshResource.h"
 #include "Others/Console.h"
 #include "Others/StringUtils.h"
+#include "Thread/JobSystem.h"
+
+#include <exception>
 
 namespace maple
 {
+	namespace
+	{
+		//milliseconds of gpu resource creation per frame for each import
+		constexpr float UploadBudget = 4.f;
+
+		struct AsyncImport
+		{
+			std::string                             path;
+			std::string                             extension;
+			std::shared_ptr<AssetsLoader>           loader;
+			ImportOptions                           options;
+			ImportContext                           context;
+			std::atomic<bool>                       parsed = false;
+			std::vector<std::shared_ptr<IResource>> resources;
+			std::function<void()>                   report;
+			std::function<void()>                   finish;
+		};
+
+		//job system
+		inline auto parse(AsyncImport &import) -> void
+		{
+			PROFILE_FUNCTION();
+			ImportContext::Scope      scope(import.context);
+			VertexCompression::Scope compression(import.path, import.options.compressVertices);
+			try
+			{
+				if (!MeshCache::load(import.path, import.options, import.resources))
+				{
+					//the meshes of a cache which failed half way are gone
+					import.context.clear();
+					MeshCache::Recorder recorder;
+					import.loader->load(import.path, import.extension, import.options, import.resources);
+					MeshCache::save(import.path, import.options, import.resources, recorder);
+				}
+			}
+			catch (const std::exception &e)
+			{
+				LOGE("import of {0} failed : {1}", import.path, e.what());
+				import.resources.clear();
+				import.context.clear();
+			}
+			import.context.setProgress(1.f);
+			import.parsed = true;
+		}
+
+		//main thread, once per frame until it is done
+		inline auto upload(const std::shared_ptr<AsyncImport> &import) -> void
+		{
+			if (import->parsed && import->context.flush(UploadBudget))
+			{
+				import->context.resolve(import->resources);
+				import->finish();
+				return;
+			}
+			import->report();
+			Application::getJobSystem()->executeOnMainThread([import]() { upload(import); });
+		}
+	}        // namespace
+
 	AssetsLoaderFactory::AssetsLoaderFactory()
 	{
 		addModelLoader<GLTFLoader>();
@@ -29,18 +96,143 @@ namespace maple
 		}
 		else
 		{
-			if (auto iter = cache.find(obj); iter != cache.end())
+			const auto id = AssetId::of(obj, FileType::Model);
+			if (auto resources = registry.find(id); !resources.empty())
 			{
-				out.insert(out.end(), iter->second.begin(), iter->second.end());
+				out.insert(out.end(), resources.begin(), resources.end());
 			}
 			else
 			{
-				loader->second->load(obj, extension, out);
-				cache[obj] = {out.begin(), out.end()};
+				VertexCompression::Scope compression(obj, importOptions.compressVertices);
+				if (!MeshCache::load(obj, importOptions, resources))
+				{
+					//imported once, the cache is mapped the next time
+					MeshCache::Recorder recorder;
+					loader->second->load(obj, extension, importOptions, resources);
+					MeshCache::save(obj, importOptions, resources, recorder);
+				}
+				if (!resources.empty())
+					resources = registry.add(id, obj, resources, [this](const std::string &path, AssetRegistry::Resources &resources) { return reload(path, resources); });
+				out.insert(out.end(), resources.begin(), resources.end());
 			}
 		}
 	}
 
+	auto AssetsLoaderFactory::reload(const std::string &obj, AssetRegistry::Resources &resources) -> bool
+	{
+		PROFILE_FUNCTION();
+		auto extension = StringUtils::getExtension(obj);
+		auto loader    = loaders.find(extension);
+		if (loader == loaders.end())
+			return false;
+
+		AssetRegistry::Resources loaded;
+		VertexCompression::Scope compression(obj, importOptions.compressVertices);
+		if (!MeshCache::load(obj, importOptions, loaded))
+		{
+			MeshCache::Recorder recorder;
+			loader->second->load(obj, extension, importOptions, loaded);
+			MeshCache::save(obj, importOptions, loaded, recorder);
+		}
+		if (loaded.empty())
+			return false;
+
+		//the scene refers to the meshes, the skeleton and the animations are replaced
+		for (auto &resource : loaded)
+		{
+			if (resource->getResourceType() != FileType::Model)
+				continue;
+			for (auto &current : resources)
+			{
+				if (current->getResourceType() != FileType::Model)
+					continue;
+				auto &meshes = std::static_pointer_cast<MeshResource>(current)->getMeshes();
+				for (auto &mesh : std::static_pointer_cast<MeshResource>(resource)->getMeshes())
+				{
+					if (auto iter = meshes.find(mesh.first); iter != meshes.end())
+					{
+						*iter->second = std::move(*mesh.second);
+						mesh.second   = iter->second;
+					}
+				}
+			}
+		}
+		resources = std::move(loaded);
+		return true;
+	}
+
+	auto AssetsLoaderFactory::loadAsync(const std::string &obj, const LoadHandle::Complete &complete, const LoadHandle::Progress &progress) -> std::shared_ptr<LoadHandle>
+	{
+		PROFILE_FUNCTION();
+		const auto key = AssetId::normalize(obj);
+		if (auto iter = loading.find(key); iter != loading.end())
+		{
+			iter->second->completes.emplace_back(complete);
+			iter->second->progresses.emplace_back(progress);
+			return iter->second;
+		}
+
+		auto handle    = std::make_shared<LoadHandle>(obj);
+		auto extension = StringUtils::getExtension(obj);
+		auto loader    = loaders.find(extension);
+		auto resources = registry.find(AssetId::of(obj, FileType::Model));
+		if (loader == loaders.end() || !resources.empty())
+		{
+			if (!resources.empty())
+				handle->resources = std::move(resources);
+			else
+				LOGE("Unknown file extension {0}", extension);
+			handle->progress = 1.f;
+			handle->done     = true;
+			if (complete)
+				complete(*handle);
+			return handle;
+		}
+
+		handle->completes.emplace_back(complete);
+		handle->progresses.emplace_back(progress);
+		loading[key] = handle;
+
+		auto import       = std::make_shared<AsyncImport>();
+		import->path      = obj;
+		import->extension = extension;
+		import->loader    = loader->second;
+		import->options   = importOptions;
+		import->report    = [handle, context = &import->context]() {
+			handle->progress = context->getProgress();
+			for (auto &progress : handle->progresses)
+			{
+				if (progress)
+					progress(handle->progress);
+			}
+		};
+		import->finish = [this, key, handle, resources = &import->resources]() {
+			loading.erase(key);
+			//a load on the main thread may have been quicker, add hands out what it registered then
+			if (!resources->empty())
+				handle->resources = registry.add(AssetId::of(handle->path, FileType::Model), handle->path, *resources, [this](const std::string &path, AssetRegistry::Resources &resources) { return reload(path, resources); });
+			handle->progress = 1.f;
+			handle->done     = true;
+			for (auto &progress : handle->progresses)
+			{
+				if (progress)
+					progress(1.f);
+			}
+			for (auto &complete : handle->completes)
+			{
+				if (complete)
+					complete(*handle);
+			}
+			handle->completes.clear();
+			handle->progresses.clear();
+		};
+
+		//the main thread helps with the jobs of the frame while it waits, it must not pick up a whole parse there
+		Application::getJobSystem()->executeBackground([import]() { parse(*import); });
+		Application::getJobSystem()->executeOnMainThread([import]() { upload(import); });
+		return handle;
+	}
+
 	auto Loader::load(const std::string &obj, std::vector<std::shared_ptr<IResource>> &out) -> void
 	{
 		Application::getAssetsLoaderFactory()->load(obj, out);
@@ -2,13 +2,17 @@
 // This file is part of the Maple Engine                              		//
 //////////////////////////////////////////////////////////////////////////////
 #pragma once
+#include <atomic>
+#include <functional>
 #include <memory>
 #include <string>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
+#include "AssetRegistry.h"
 #include "Engine/Core.h"
+#include "ImportOptions.h"
 #include "Engine/Mesh.h"
 
 namespace maple
@@ -24,11 +28,55 @@ namespace maple
 	class MAPLE_EXPORT AssetsLoader
 	{
 	  public:
-		virtual auto load(const std::string &fileName, const std::string &extension, std::vector<std::shared_ptr<IResource>> &out) const -> void{};
+		virtual auto load(const std::string &fileName, const std::string &extension, const ImportOptions &options, std::vector<std::shared_ptr<IResource>> &out) const -> void{};
 
 	  private:
 	};
 
+	/**
+	 * an import running on the job system, the resources are there once it is done
+	 */
+	class MAPLE_EXPORT LoadHandle final
+	{
+	  public:
+		using Complete = std::function<void(const LoadHandle &)>;
+		using Progress = std::function<void(float)>;
+
+		LoadHandle(const std::string &path) :
+		    path(path)
+		{
+		}
+
+		inline auto &getPath() const
+		{
+			return path;
+		}
+
+		inline auto isDone() const
+		{
+			return done.load();
+		}
+
+		inline auto getProgress() const
+		{
+			return progress.load();
+		}
+
+		inline auto &getResources() const
+		{
+			return resources;
+		}
+
+	  private:
+		friend class AssetsLoaderFactory;
+		std::string                             path;
+		std::atomic<bool>                       done     = false;
+		std::atomic<float>                      progress = 0.f;
+		std::vector<std::shared_ptr<IResource>> resources;
+		std::vector<Complete>                   completes;
+		std::vector<Progress>                   progresses;
+	};
+
 	class MAPLE_EXPORT AssetsLoaderFactory
 	{
 	  public:
@@ -47,6 +95,13 @@ namespace maple
 
 		auto load(const std::string &obj, std::vector<std::shared_ptr<IResource>> &out) -> void;
 
+		/**
+		 * main thread only. parses and processes the model on the job system, the gpu resources are created on the
+		 * main thread a few milliseconds per frame. progress is called every frame until complete is called, both on
+		 * the main thread. a cached model completes right away, the import of a model already loading is shared.
+		 */
+		auto loadAsync(const std::string &obj, const LoadHandle::Complete &complete = nullptr, const LoadHandle::Progress &progress = nullptr) -> std::shared_ptr<LoadHandle>;
+
 		inline auto &getSupportExtensions() const
 		{
 			return supportExtensions;
@@ -55,27 +110,36 @@ namespace maple
 		template <typename T, typename... Args>
 		auto emplace(const std::string &obj, Args &&... args) -> std::shared_ptr<T>;
 
-		inline auto &getCache() const
+		inline auto &getRegistry()
 		{
-			return cache;
+			return registry;
+		}
+
+		//main thread only. the imports already running keep the options they started with
+		inline auto setImportOptions(const ImportOptions &options)
+		{
+			importOptions = options;
+		}
+
+		inline auto &getImportOptions() const
+		{
+			return importOptions;
 		}
 
 	  private:
-		std::unordered_map<std::string, std::shared_ptr<AssetsLoader>>           loaders;
-		std::unordered_set<std::string>                                          supportExtensions;
-		std::unordered_map<std::string, std::vector<std::shared_ptr<IResource>>> cache;
+		//re-imports a model whose file changed, the meshes found by name take the new content in place
+		auto reload(const std::string &obj, AssetRegistry::Resources &resources) -> bool;
+
+		std::unordered_map<std::string, std::shared_ptr<AssetsLoader>> loaders;
+		std::unordered_set<std::string>                                supportExtensions;
+		AssetRegistry                                                  registry;
+		std::unordered_map<std::string, std::shared_ptr<LoadHandle>>   loading;        //AssetId::normalize of the path
+		ImportOptions                                                  importOptions;
 	};
 
 	template <typename T, typename... Args>
 	auto AssetsLoaderFactory::emplace(const std::string &obj, Args &&... args) -> std::shared_ptr<T>
 	{
-		auto iter = cache.find(obj);
-		if (iter == cache.end())
-		{
-			auto ptr = std::make_shared<T>(std::forward<Args>(args)...);
-			cache[obj].emplace_back(ptr);
-			return std::static_pointer_cast<T>(ptr);
-		}
-		return std::static_pointer_cast<T>(iter->second[0]);
+		return registry.emplace<T>(obj, std::forward<Args>(args)...);
 	}
 };        // namespace maple
@@ -0,0 +1,683 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+#include "MeshCache.h"
+#include "ImageLoader.h"
+
+#include "Animation/Animation.h"
+#include "Engine/Material.h"
+#include "Engine/Mesh.h"
+#include "Engine/Profiler.h"
+#include "FileSystem/File.h"
+#include "FileSystem/MeshResource.h"
+#include "FileSystem/Skeleton.h"
+#include "Math/BoundingBox.h"
+#include "Others/Console.h"
+#include "RHI/Texture.h"
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <mio/mmap.hpp>
+#include <type_traits>
+#include <unordered_map>
+
+namespace maple
+{
+	namespace
+	{
+		constexpr char     Magic[4]  = {'M', 'M', 'S', 'H'};
+		constexpr uint32_t Version   = 3;        //3 : the import options the streams were made with
+		constexpr uint32_t Alignment = 16;
+
+		enum class ResourceTag : uint32_t
+		{
+			Meshes,
+			Skeleton,
+			Animation
+		};
+
+		struct Header
+		{
+			char     magic[4];
+			uint32_t version;
+			uint64_t sourceSize;
+			int64_t  sourceTime;
+			char     md5[32];
+			uint32_t materialCount;
+			uint32_t resourceCount;
+			uint32_t options;
+		};
+
+		enum OptionBits : uint32_t
+		{
+			OptimizeMeshes = 1 << 0
+		};
+
+		//what changes the streams. the compression is applied to the meshes created from the cache as well, it is not part of it
+		inline auto getOptionBits(const ImportOptions &options) -> uint32_t
+		{
+			return options.optimizeMeshes ? OptimizeMeshes : 0;
+		}
+
+		thread_local MeshCache::Recorder *currentRecorder = nullptr;
+
+		class Writer
+		{
+		  public:
+			template <typename T>
+			inline auto write(const T &value) -> void
+			{
+				static_assert(std::is_trivially_copyable<T>::value, "only plain data is written as it is");
+				write(&value, sizeof(T));
+			}
+
+			inline auto write(const std::string &value) -> void
+			{
+				write(static_cast<uint32_t>(value.size()));
+				write(value.data(), value.size());
+			}
+
+			inline auto write(const void *value, uint64_t size) -> void
+			{
+				auto bytes = static_cast<const uint8_t *>(value);
+				data.insert(data.end(), bytes, bytes + size);
+			}
+
+			//the streams start aligned, so the mapped file can be handed to the buffers as it is
+			inline auto align() -> void
+			{
+				data.resize((data.size() + Alignment - 1) / Alignment * Alignment, 0);
+			}
+
+			std::vector<uint8_t> data;
+		};
+
+		class Reader
+		{
+		  public:
+			Reader(const uint8_t *data, uint64_t size) :
+			    data(data),
+			    size(size)
+			{
+			}
+
+			template <typename T>
+			inline auto read() -> T
+			{
+				T value{};
+				if (auto bytes = take(sizeof(T)))
+					std::memcpy(&value, bytes, sizeof(T));
+				return value;
+			}
+
+			inline auto readString() -> std::string
+			{
+				const auto length = read<uint32_t>();
+				auto       bytes  = take(length);
+				return bytes != nullptr ? std::string(reinterpret_cast<const char *>(bytes), length) : "";
+			}
+
+			//a count of elements taking at least elementSize bytes each, 0 and failed when they can not fit into the rest of the file
+			inline auto readCount(uint64_t elementSize) -> uint32_t
+			{
+				const auto count = read<uint32_t>();
+				return fits(count, elementSize) ? count : 0;
+			}
+
+			//counts are untrusted, they are checked before anything is allocated for them
+			inline auto fits(uint64_t count, uint64_t elementSize) -> bool
+			{
+				if (failed || count * elementSize > size - offset)
+					failed = true;
+				return !failed;
+			}
+
+			//nullptr and failed once the file is too short
+			inline auto take(uint64_t count) -> const uint8_t *
+			{
+				if (failed || count > size - offset)
+				{
+					failed = true;
+					return nullptr;
+				}
+				auto bytes = data + offset;
+				offset += count;
+				return bytes;
+			}
+
+			inline auto align() -> void
+			{
+				offset = std::min(size, (offset + Alignment - 1) / Alignment * Alignment);
+			}
+
+			inline auto isFailed() const
+			{
+				return failed;
+			}
+
+		  private:
+			const uint8_t *data;
+			uint64_t       size;
+			uint64_t       offset = 0;
+			bool           failed = false;
+		};
+
+		inline auto getSourceTime(const std::string &source) -> int64_t
+		{
+			std::error_code error;
+			return static_cast<int64_t>(std::filesystem::last_write_time(source, error).time_since_epoch().count());
+		}
+
+		inline auto getTextures(const Material &material)
+		{
+			auto &textures = material.getTextures();
+			return std::array<std::shared_ptr<Texture2D>, 6>{textures.albedo, textures.normal, textures.metallic, textures.roughness, textures.ao, textures.emissive};
+		}
+
+		auto writeMaterial(Writer &writer, const Material &material) -> bool
+		{
+			//the feedback slot is assigned by the TextureStreamer at runtime
+			auto properties         = material.getProperties();
+			properties.feedbackSlot = 0.0f;
+			writer.write(properties);
+			writer.write(material.getRenderFlags());
+			for (auto &texture : getTextures(material))
+			{
+				//textures created from memory (embedded in a glTF) have nothing to refer to
+				if (texture != nullptr && texture->getFilePath() == "")
+					return false;
+
+				writer.write(texture != nullptr ? texture->getFilePath() : "");
+				writer.write(texture != nullptr ? texture->getParameters() : TextureParameters{});
+				writer.write(texture != nullptr ? texture->getLoadOptions() : TextureLoadOptions{});
+			}
+			return true;
+		}
+
+		auto readMaterials(Reader &reader, uint32_t count) -> std::vector<std::shared_ptr<Material>>
+		{
+			struct TextureRef
+			{
+				std::string        path;
+				TextureParameters  parameters;
+				TextureLoadOptions loadOptions;
+			};
+
+			std::vector<std::shared_ptr<Material>> materials;
+			if (!reader.fits(count, sizeof(MaterialProperties) + sizeof(int32_t) + 6 * (sizeof(uint32_t) + sizeof(TextureParameters) + sizeof(TextureLoadOptions))))
+				return materials;
+
+			std::vector<MaterialProperties>        properties(count);
+			std::vector<int32_t>                   flags(count);
+			std::vector<std::array<TextureRef, 6>> textures(count);
+			for (uint32_t i = 0; i < count; i++)
+			{
+				properties[i]              = reader.read<MaterialProperties>();
+				properties[i].feedbackSlot = 0.0f;
+				flags[i]                   = reader.read<int32_t>();
+				for (auto &texture : textures[i])
+				{
+					texture.path        = reader.readString();
+					texture.parameters  = reader.read<TextureParameters>();
+					texture.loadOptions = reader.read<TextureLoadOptions>();
+				}
+			}
+
+			if (reader.isFailed())
+				return materials;
+
+			//decoded on the job system before the textures are created one by one, grouped by the way they are read
+			std::vector<std::pair<TextureLoadOptions, std::vector<std::string>>> groups;
+			for (auto &refs : textures)
+			{
+				for (auto &texture : refs)
+				{
+					if (texture.path == "" || !File::fileExists(texture.path))
+						continue;
+					auto group = std::find_if(groups.begin(), groups.end(), [&](auto &group) {
+						return std::memcmp(&group.first, &texture.loadOptions, sizeof(TextureLoadOptions)) == 0;
+					});
+					if (group == groups.end())
+						group = groups.insert(groups.end(), std::make_pair(texture.loadOptions, std::vector<std::string>{}));
+					group->second.emplace_back(texture.path);
+				}
+			}
+
+			std::vector<std::shared_ptr<ImagePrefetch>> prefetches;
+			for (auto &group : groups)
+				prefetches.emplace_back(Texture2D::prefetch(group.second, group.first));
+
+			for (uint32_t i = 0; i < count; i++)
+			{
+				std::array<std::shared_ptr<Texture2D>, 6> created;
+				for (uint32_t j = 0; j < 6; j++)
+				{
+					auto &texture = textures[i][j];
+					if (texture.path != "" && File::fileExists(texture.path))
+						created[j] = Texture2D::create(texture.path, texture.path, texture.parameters, texture.loadOptions);
+				}
+
+				auto material = materials.emplace_back(std::make_shared<Material>());
+				material->setRenderFlags(flags[i]);
+				material->setTextures({created[0], created[1], created[2], created[3], created[4], created[5]});
+				material->setMaterialProperites(properties[i]);
+			}
+			return materials;
+		}
+
+		auto writeMesh(Writer &writer, const std::string &key, Mesh &mesh, const MeshCache::Streams &streams, std::unordered_map<Material *, int32_t> &materials) -> void
+		{
+			const auto vertexCount = static_cast<uint32_t>(streams.vertices.size() / streams.stride);
+			auto       bounds      = mesh.getBoundingBox() != nullptr ? *mesh.getBoundingBox() : BoundingBox{};
+
+			writer.write(key);
+			writer.write(mesh.getName());
+			writer.write(streams.stride);
+			writer.write(static_cast<uint32_t>(streams.skinned));
+			writer.write(vertexCount);
+			writer.write(static_cast<uint32_t>(streams.indices.size()));
+			writer.write(bounds.min);
+			writer.write(bounds.max);
+			writer.write(mesh.getSubMeshCount());
+			writer.write(static_cast<uint32_t>(mesh.getSubMeshIndex().size()));
+			writer.write(mesh.getSubMeshIndex().data(), mesh.getSubMeshIndex().size() * sizeof(uint32_t));
+
+			writer.write(static_cast<uint32_t>(mesh.getMaterial().size()));
+			for (auto &material : mesh.getMaterial())
+				writer.write(material != nullptr ? materials.at(material.get()) : -1);
+
+			writer.align();
+			writer.write(streams.vertices.data(), streams.vertices.size());
+			writer.align();
+			writer.write(streams.indices.data(), streams.indices.size() * sizeof(uint32_t));
+		}
+
+		auto readMesh(Reader &reader, MeshResource &resource, const std::vector<std::shared_ptr<Material>> &materials) -> void
+		{
+			const auto key          = reader.readString();
+			const auto name         = reader.readString();
+			const auto stride       = reader.read<uint32_t>();
+			const auto skinned      = reader.read<uint32_t>() != 0;
+			const auto vertexCount  = reader.read<uint32_t>();
+			const auto indexCount   = reader.read<uint32_t>();
+			const auto min          = reader.read<glm::vec3>();
+			const auto max          = reader.read<glm::vec3>();
+			const auto subMeshCount = reader.read<uint32_t>();
+
+			std::vector<uint32_t> subMeshIndex(reader.readCount(sizeof(uint32_t)));
+			if (auto bytes = reader.take(subMeshIndex.size() * sizeof(uint32_t)))
+				std::memcpy(subMeshIndex.data(), bytes, subMeshIndex.size() * sizeof(uint32_t));
+
+			std::vector<std::shared_ptr<Material>> meshMaterials(reader.readCount(sizeof(int32_t)));
+			for (auto &material : meshMaterials)
+			{
+				const auto index = reader.read<int32_t>();
+				if (index >= 0 && index < materials.size())
+					material = materials[index];
+			}
+
+			reader.align();
+			auto vertices = reader.take(uint64_t(vertexCount) * stride);
+			reader.align();
+			auto indices = reader.take(uint64_t(indexCount) * sizeof(uint32_t));
+			if (reader.isFailed() || stride != (skinned ? sizeof(SkinnedVertex) : sizeof(Vertex)))
+				return;
+
+			//straight from the mapping into the upload
+			auto mesh = std::make_shared<Mesh>(reinterpret_cast<const uint32_t *>(indices), indexCount, vertices, vertexCount, stride, BoundingBox(min, max));
+			mesh->setName(name);
+			mesh->setMaterial(meshMaterials);
+			mesh->setSubMeshIndex(subMeshIndex);
+			mesh->setSubMeshCount(subMeshCount);
+			resource.addMesh(key, mesh);
+		}
+
+		auto writeSkeleton(Writer &writer, Skeleton &skeleton) -> void
+		{
+			writer.write(skeleton.getPath());
+			writer.write(static_cast<uint32_t>(skeleton.isBuildOffset()));
+			writer.write(skeleton.getRoot());
+			writer.write(static_cast<uint32_t>(skeleton.getBones().size()));
+			for (auto &bone : skeleton.getBones())
+			{
+				writer.write(bone.parentIdx);
+				writer.write(bone.name);
+				writer.write(static_cast<uint32_t>(bone.children.size()));
+				writer.write(bone.children.data(), bone.children.size() * sizeof(int32_t));
+				writer.write(bone.offsetMatrix);
+				writer.write(bone.localTransform);
+			}
+		}
+
+		auto readSkeleton(Reader &reader) -> std::shared_ptr<Skeleton>
+		{
+			auto skeleton = std::make_shared<Skeleton>(reader.readString());
+			skeleton->setBuildOffset(reader.read<uint32_t>() != 0);
+			const auto root  = reader.read<int32_t>();
+			const auto count = reader.read<uint32_t>();
+			for (uint32_t i = 0; i < count && !reader.isFailed(); i++)
+			{
+				auto &bone = skeleton->createBone(reader.read<int32_t>());
+				bone.name  = reader.readString();
+				bone.children.resize(reader.readCount(sizeof(int32_t)));
+				if (auto bytes = reader.take(bone.children.size() * sizeof(int32_t)))
+					std::memcpy(bone.children.data(), bytes, bone.children.size() * sizeof(int32_t));
+				bone.offsetMatrix   = reader.read<glm::mat4>();
+				bone.localTransform = reader.read<glm::mat4>();
+			}
+			if (root >= 0)
+				skeleton->buildRoot();
+			return skeleton;
+		}
+
+		auto writeAnimation(Writer &writer, Animation &animation) -> void
+		{
+			writer.write(animation.getPath());
+			writer.write(static_cast<uint32_t>(animation.getClipCount()));
+			for (auto &clip : animation.getClips())
+			{
+				writer.write(clip->name);
+				writer.write(clip->length);
+				writer.write(clip->fps);
+				writer.write(clip->wrapMode);
+				writer.write(static_cast<uint32_t>(clip->curves.size()));
+				for (auto &curve : clip->curves)
+				{
+					writer.write(curve.path);
+					writer.write(curve.boneIndex);
+					writer.write(static_cast<uint32_t>(curve.properties.size()));
+					for (auto &property : curve.properties)
+					{
+						writer.write(property.type);
+						writer.write(property.name);
+						auto &keys = property.curve.getKeys();
+						writer.write(static_cast<uint32_t>(keys.size()));
+						writer.write(keys.data(), keys.size() * sizeof(keys[0]));
+					}
+				}
+			}
+		}
+
+		auto readAnimation(Reader &reader) -> std::shared_ptr<Animation>
+		{
+			auto       animation = std::make_shared<Animation>(reader.readString());
+			const auto clipCount = reader.read<uint32_t>();
+			for (uint32_t i = 0; i < clipCount && !reader.isFailed(); i++)
+			{
+				auto clip      = std::make_shared<AnimationClip>();
+				clip->name     = reader.readString();
+				clip->length   = reader.read<float>();
+				clip->fps      = reader.read<float>();
+				clip->wrapMode = reader.read<AnimationWrapMode>();
+
+				//path length, bone index and property count
+				clip->curves.resize(reader.readCount(3 * sizeof(uint32_t)));
+				for (auto &curve : clip->curves)
+				{
+					curve.path      = reader.readString();
+					curve.boneIndex = reader.read<int32_t>();
+					//type, name length and key count
+					curve.properties.resize(reader.readCount(sizeof(AnimationCurvePropertyType) + 2 * sizeof(uint32_t)));
+					for (auto &property : curve.properties)
+					{
+						property.type    = reader.read<AnimationCurvePropertyType>();
+						property.name    = reader.readString();
+						const auto count = reader.read<uint32_t>();
+						for (uint32_t k = 0; k < count && !reader.isFailed(); k++)
+						{
+							//time, value, inTangent, outTangent
+							const auto key = reader.read<glm::vec4>();
+							property.curve.addKey(key.x, key.y, key.z, key.w);
+						}
+					}
+				}
+				animation->addClip(clip);
+			}
+			return animation;
+		}
+
+		//the cache is still valid when only the time of the source changed, the new time is written back then
+		auto isUpToDate(const std::string &source, const std::string &path, const Header &header) -> bool
+		{
+			if (!File::fileExists(source))
+				return true;
+
+			std::error_code error;
+			const auto      size = std::filesystem::file_size(source, error);
+			const auto      time = getSourceTime(source);
+			if (size == header.sourceSize && time == header.sourceTime)
+				return true;
+
+			if (size != header.sourceSize)
+				return false;
+
+			File file(source);
+			if (file.getMd5() != std::string(header.md5, sizeof(header.md5)))
+				return false;
+
+			std::fstream stream(path, std::ios::in | std::ios::out | std::ios::binary);
+			stream.seekp(offsetof(Header, sourceTime));
+			stream.write(reinterpret_cast<const char *>(&time), sizeof(time));
+			return true;
+		}
+	}        // namespace
+
+	MeshCache::Recorder::Recorder() :
+	    previous(currentRecorder)
+	{
+		currentRecorder = this;
+	}
+
+	MeshCache::Recorder::~Recorder()
+	{
+		currentRecorder = previous;
+	}
+
+	auto MeshCache::Recorder::find(const Mesh *mesh) const -> const Streams *
+	{
+		auto iter = streams.find(mesh);
+		return iter != streams.end() ? &iter->second : nullptr;
+	}
+
+	auto MeshCache::getCachePath(const std::string &source) -> std::string
+	{
+		return source + ".mmesh";
+	}
+
+	auto MeshCache::record(const Mesh *mesh, const void *vertices, uint32_t stride, uint32_t vertexCount, const std::vector<uint32_t> &indices, bool skinned) -> void
+	{
+		if (currentRecorder == nullptr)
+			return;
+
+		auto &streams   = currentRecorder->streams[mesh];
+		auto  bytes     = static_cast<const uint8_t *>(vertices);
+		streams.stride  = stride;
+		streams.skinned = skinned;
+		streams.indices = indices;
+		streams.vertices.assign(bytes, bytes + uint64_t(vertexCount) * stride);
+	}
+
+	auto MeshCache::load(const std::string &source, const ImportOptions &options, std::vector<std::shared_ptr<IResource>> &out) -> bool
+	{
+		PROFILE_FUNCTION();
+		const auto path = getCachePath(source);
+		if (!File::fileExists(path))
+			return false;
+
+		Header header;
+		{
+			std::ifstream stream(path, std::ios::binary);
+			if (!stream.read(reinterpret_cast<char *>(&header), sizeof(Header)) || std::memcmp(header.magic, Magic, sizeof(Magic)) != 0 || header.version != Version)
+			{
+				LOGW("MeshCache : {0} is not a mesh cache of version {1}, {2} is imported again", path, Version, source);
+				return false;
+			}
+		}
+
+		if (header.options != getOptionBits(options))
+		{
+			LOGI("MeshCache : {0} was written with other import options, {1} is imported again", path, source);
+			return false;
+		}
+
+		if (!isUpToDate(source, path, header))
+		{
+			LOGI("MeshCache : {0} changed, it is imported again", source);
+			return false;
+		}
+
+		std::error_code  error;
+		mio::mmap_source mmap;
+		mmap.map(path, error);
+		if (error)
+		{
+			LOGW("MeshCache : can not map {0}, {1}", path, error.message());
+			return false;
+		}
+
+		Reader reader(reinterpret_cast<const uint8_t *>(mmap.data()), mmap.size());
+		reader.take(sizeof(Header));
+
+		auto materials = readMaterials(reader, header.materialCount);
+
+		std::vector<std::shared_ptr<IResource>> resources;
+		for (uint32_t i = 0; i < header.resourceCount && !reader.isFailed(); i++)
+		{
+			switch (reader.read<ResourceTag>())
+			{
+				case ResourceTag::Meshes:
+				{
+					auto       meshes = std::make_shared<MeshResource>(reader.readString());
+					const auto count  = reader.read<uint32_t>();
+					for (uint32_t j = 0; j < count && !reader.isFailed(); j++)
+						readMesh(reader, *meshes, materials);
+					resources.emplace_back(meshes);
+					break;
+				}
+				case ResourceTag::Skeleton:
+					resources.emplace_back(readSkeleton(reader));
+					break;
+				case ResourceTag::Animation:
+					resources.emplace_back(readAnimation(reader));
+					break;
+				default:
+					LOGW("MeshCache : unknown resource in {0}", path);
+					return false;
+			}
+		}
+
+		if (reader.isFailed())
+		{
+			LOGW("MeshCache : {0} is truncated, {1} is imported again", path, source);
+			return false;
+		}
+
+		out.insert(out.end(), resources.begin(), resources.end());
+		LOGI("MeshCache : {0} loaded from {1}", source, path);
+		return true;
+	}
+
+	auto MeshCache::save(const std::string &source, const ImportOptions &options, const std::vector<std::shared_ptr<IResource>> &resources, const Recorder &recorder) -> bool
+	{
+		PROFILE_FUNCTION();
+		std::unordered_map<Material *, int32_t> materialIndices;
+		std::vector<Material *>                 materials;
+
+		for (auto &resource : resources)
+		{
+			if (resource->getResourceType() != FileType::Model)
+				continue;
+			for (auto &mesh : std::static_pointer_cast<MeshResource>(resource)->getMeshes())
+			{
+				if (recorder.find(mesh.second.get()) == nullptr)
+				{
+					LOGW("MeshCache : the streams of {0} in {1} were not recorded, it is not cached", mesh.first, source);
+					return false;
+				}
+				for (auto &material : mesh.second->getMaterial())
+				{
+					if (material != nullptr && materialIndices.emplace(material.get(), static_cast<int32_t>(materials.size())).second)
+						materials.emplace_back(material.get());
+				}
+			}
+		}
+
+		std::error_code error;
+		Header          header{};
+		std::memcpy(header.magic, Magic, sizeof(Magic));
+		header.version       = Version;
+		header.sourceSize    = std::filesystem::file_size(source, error);
+		header.sourceTime    = getSourceTime(source);
+		header.materialCount = static_cast<uint32_t>(materials.size());
+		header.resourceCount = static_cast<uint32_t>(resources.size());
+		header.options       = getOptionBits(options);
+
+		File       file(source);
+		const auto md5 = file.getMd5();
+		std::memcpy(header.md5, md5.data(), std::min(md5.size(), sizeof(header.md5)));
+
+		Writer writer;
+		writer.write(header);
+
+		for (auto material : materials)
+		{
+			if (!writeMaterial(writer, *material))
+			{
+				LOGI("MeshCache : {0} has textures which are not files, it is not cached", source);
+				return false;
+			}
+		}
+
+		for (auto &resource : resources)
+		{
+			switch (resource->getResourceType())
+			{
+				case FileType::Model:
+				{
+					auto meshes = std::static_pointer_cast<MeshResource>(resource);
+					writer.write(ResourceTag::Meshes);
+					writer.write(meshes->getPath());
+					writer.write(static_cast<uint32_t>(meshes->getMeshes().size()));
+					for (auto &mesh : meshes->getMeshes())
+						writeMesh(writer, mesh.first, *mesh.second, *recorder.find(mesh.second.get()), materialIndices);
+					break;
+				}
+				case FileType::Skeleton:
+					writer.write(ResourceTag::Skeleton);
+					writeSkeleton(writer, *std::static_pointer_cast<Skeleton>(resource));
+					break;
+				case FileType::Animation:
+					writer.write(ResourceTag::Animation);
+					writeAnimation(writer, *std::static_pointer_cast<Animation>(resource));
+					break;
+				default:
+					LOGW("MeshCache : {0} produced a {1}, it is not cached", source, fileTypeToStr(resource->getResourceType()));
+					return false;
+			}
+		}
+
+		//written aside and moved over, a reader never maps a half written cache
+		const auto path = getCachePath(source);
+		{
+			std::ofstream stream(path + ".tmp", std::ios::binary | std::ios::trunc);
+			if (!stream.write(reinterpret_cast<const char *>(writer.data.data()), writer.data.size()))
+			{
+				LOGW("MeshCache : can not write {0}", path);
+				return false;
+			}
+		}
+		std::filesystem::rename(path + ".tmp", path, error);
+		if (error)
+		{
+			LOGW("MeshCache : can not write {0}, {1}", path, error.message());
+			return false;
+		}
+
+		LOGI("MeshCache : {0} -> {1}, {2} KB", source, path, writer.data.size() >> 10);
+		return true;
+	}
+}        // namespace maple
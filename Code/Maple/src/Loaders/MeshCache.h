@@ -0,0 +1,67 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "Engine/Core.h"
+#include "FileSystem/IResource.h"
+#include "ImportOptions.h"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace maple
+{
+	class Mesh;
+
+	/**
+	 * Engine native binary form of what the model loaders produce : meshes with their vertex/index streams, sub meshes,
+	 * bounds and material references, the skeleton and the animation clips. It is written next to the source
+	 * (model.fbx -> model.fbx.mmesh) the first time the source is imported and mapped into memory afterwards, the streams
+	 * are handed to the vertex/index buffers straight from the mapping.
+	 * The cache follows the source : size and modification time are checked first, the md5 of the source when they differ.
+ * It is made under the import options of the loader, a cache made under other options is not used.
+	 */
+	class MAPLE_EXPORT MeshCache final
+	{
+	  public:
+		struct Streams
+		{
+			std::vector<uint8_t>  vertices;
+			std::vector<uint32_t> indices;
+			uint32_t              stride  = 0;
+			bool                  skinned = false;
+		};
+
+		/**
+		 * the meshes created on this thread while it lives keep a copy of their streams, so that the resources of
+		 * an import can be saved. the gpu buffers can not be read back.
+		 */
+		class MAPLE_EXPORT Recorder final
+		{
+		  public:
+			Recorder();
+			~Recorder();
+			NO_COPYABLE(Recorder);
+
+			auto find(const Mesh *mesh) const -> const Streams *;
+
+		  private:
+			friend class MeshCache;
+			Recorder *                                previous = nullptr;
+			std::unordered_map<const Mesh *, Streams> streams;
+		};
+
+		static auto getCachePath(const std::string &source) -> std::string;
+
+		//false when there is no cache, it is out of date or broken, the source has to be imported then
+		static auto load(const std::string &source, const ImportOptions &options, std::vector<std::shared_ptr<IResource>> &out) -> bool;
+
+		//resources as they came from the loader, the meshes have to be recorded by recorder
+		static auto save(const std::string &source, const ImportOptions &options, const std::vector<std::shared_ptr<IResource>> &resources, const Recorder &recorder) -> bool;
+
+		//called by the mesh constructors, does nothing without a recorder on this thread
+		static auto record(const Mesh *mesh, const void *vertices, uint32_t stride, uint32_t vertexCount, const std::vector<uint32_t> &indices, bool skinned) -> void;
+	};
+}        // namespace maple
@@ -4,35 +4,28 @@
 #include "OBJLoader.h"
 
 #define TINYOBJLOADER_IMPLEMENTATION
+#include "Application.h"
 #include "Engine/Material.h"
+#include "Engine/MeshOptimizer.h"
 #include "Engine/Profiler.h"
 #include "FileSystem/MeshResource.h"
+#include "Loaders/ImageLoader.h"
+#include "Loaders/ImportContext.h"
 #include "Others/StringUtils.h"
 #include "RHI/Texture.h"
+#include "Thread/ParallelForEach.h"
+#include <atomic>
 #include <tiny_obj_loader.h>
 
 namespace maple
 {
-	std::vector<std::shared_ptr<Texture2D>> texturesCache;
-
-	std::shared_ptr<Texture2D> loadMaterialTextures(const std::string &typeName, std::vector<std::shared_ptr<Texture2D>> &texturesLoaded, const std::string &name, const std::string &directory, TextureParameters format)
+	//the textures shared between the materials are created once, by the registry or the import context
+	std::shared_ptr<Texture2D> loadMaterialTextures(const std::string &typeName, const std::string &name, const std::string &directory, TextureParameters format)
 	{
-		for (uint32_t j = 0; j < texturesLoaded.size(); j++)
-		{
-			if (std::strcmp(texturesLoaded[j]->getFilePath().c_str(), (directory + "/" + name).c_str()) == 0)
-			{
-				return texturesLoaded[j];
-			}
-		}
-
-		{
-			auto texture = Texture2D::create(typeName, directory + "/" + name, format, {false, false, true});
-			texturesLoaded.emplace_back(texture);
-			return texture;
-		}
+		return Texture2D::create(typeName, directory + "/" + name, format, {false, false, true, false, true});
 	}
 
-	auto OBJLoader::load(const std::string &fileName, const std::string &extension, std::vector<std::shared_ptr<IResource>> &out) const -> void
+	auto OBJLoader::load(const std::string &fileName, const std::string &extension, const ImportOptions &options, std::vector<std::shared_ptr<IResource>> &out) const -> void
 	{
 		PROFILE_FUNCTION();
 		std::string resolvedPath = fileName;
@@ -49,50 +42,87 @@ namespace maple
 			throw std::runtime_error(warn + err);
 		}
 
-		auto meshes = std::make_shared<MeshResource>(fileName);
-
-		for (const auto &shape : shapes)
+		//the textures are decoded on the job system while the vertices are built
+		std::vector<std::string> texturePaths;
+		for (auto &material : materials)
 		{
-			std::vector<Vertex>                  vertices;
-			std::vector<uint32_t>                indices;
-			std::unordered_map<Vertex, uint32_t> uniqueVertices{};
-
-			for (const auto &index : shape.mesh.indices)
+			for (auto texture : {&material.diffuse_texname, &material.normal_texname, &material.roughness_texname, &material.metallic_texname})
 			{
-				Vertex vertex{};
-
-				vertex.pos = {
-				    attrib.vertices[3 * index.vertex_index + 0],
-				    attrib.vertices[3 * index.vertex_index + 1],
-				    attrib.vertices[3 * index.vertex_index + 2]};
-
-				if (index.normal_index >= 0)
-					vertex.normal = {
-					    attrib.normals[3 * index.normal_index + 0],
-					    attrib.normals[3 * index.normal_index + 1],
-					    attrib.normals[3 * index.normal_index + 2]};
-
-				if (index.texcoord_index >= 0)
-					vertex.texCoord = {
-					    attrib.texcoords[2 * index.texcoord_index + 0],
-					    1.0f - attrib.texcoords[2 * index.texcoord_index + 1]};
-
-				vertex.color = {1.0f, 1.0f, 1.0f, 1.f};
-
-				if (uniqueVertices.count(vertex) == 0)
-				{
-					uniqueVertices[vertex] = static_cast<uint32_t>(vertices.size());
-					vertices.push_back(vertex);
-				}
-
-				indices.emplace_back(uniqueVertices[vertex]);
+				if (!texture->empty())
+					texturePaths.emplace_back(directory + "/" + *texture);
 			}
+		}
+		auto prefetch = Texture2D::prefetch(texturePaths, {false, false, true, false, true});
 
-			if (attrib.normals.empty())
-				Mesh::generateNormals(vertices, indices);
+		auto meshes = std::make_shared<MeshResource>(fileName);
 
-			Mesh::generateTangents(vertices, indices);
-			//Mesh::generateBitangents(vertices, indices);
+		struct ShapeGeometry
+		{
+			std::vector<Vertex>   vertices;
+			std::vector<uint32_t> indices;
+		};
+
+		//the shapes are independent, their vertices are deduplicated and their tangents generated in parallel
+		std::vector<ShapeGeometry> geometries(shapes.size());
+		std::atomic<uint32_t>      processed = 0;
+		auto                       context   = ImportContext::current();
+
+		parallelFor(
+		    *Application::getJobSystem(), static_cast<uint32_t>(shapes.size()), [&](uint32_t i) {
+			    auto &                               vertices = geometries[i].vertices;
+			    auto &                               indices  = geometries[i].indices;
+			    std::unordered_map<Vertex, uint32_t> uniqueVertices{};
+
+			    for (const auto &index : shapes[i].mesh.indices)
+			    {
+				    Vertex vertex{};
+
+				    vertex.pos = {
+				        attrib.vertices[3 * index.vertex_index + 0],
+				        attrib.vertices[3 * index.vertex_index + 1],
+				        attrib.vertices[3 * index.vertex_index + 2]};
+
+				    if (index.normal_index >= 0)
+					    vertex.normal = {
+					        attrib.normals[3 * index.normal_index + 0],
+					        attrib.normals[3 * index.normal_index + 1],
+					        attrib.normals[3 * index.normal_index + 2]};
+
+				    if (index.texcoord_index >= 0)
+					    vertex.texCoord = {
+					        attrib.texcoords[2 * index.texcoord_index + 0],
+					        1.0f - attrib.texcoords[2 * index.texcoord_index + 1]};
+
+				    vertex.color = {1.0f, 1.0f, 1.0f, 1.f};
+
+				    if (uniqueVertices.count(vertex) == 0)
+				    {
+					    uniqueVertices[vertex] = static_cast<uint32_t>(vertices.size());
+					    vertices.push_back(vertex);
+				    }
+
+				    indices.emplace_back(uniqueVertices[vertex]);
+			    }
+
+			    if (attrib.normals.empty())
+				    Mesh::generateNormals(vertices, indices);
+
+			    Mesh::generateTangents(vertices, indices);
+			    //Mesh::generateBitangents(vertices, indices);
+
+			    if (options.optimizeMeshes)
+				    MeshOptimizer::optimize(indices, vertices, shapes[i].name);
+
+			    if (context != nullptr)
+				    context->setProgress(float(++processed) / shapes.size());
+		    },
+		    1);
+
+		for (size_t i = 0; i < shapes.size(); i++)
+		{
+			const auto &shape    = shapes[i];
+			auto &      vertices = geometries[i].vertices;
+			auto &      indices  = geometries[i].indices;
 
 			auto pbrMaterial = std::make_shared<Material>();
 
@@ -105,7 +135,6 @@ namespace maple
 				if (mp->diffuse_texname.length() > 0)
 				{
 					std::shared_ptr<Texture2D> texture = loadMaterialTextures("Albedo",
-					                                                          texturesCache,
 					                                                          mp->diffuse_texname, directory, TextureParameters(TextureFilter::Linear, TextureFilter::Linear, mp->diffuse_texopt.clamp ? TextureWrap::ClampToEdge : TextureWrap::Repeat));
 					if (texture)
 						textures.albedo = texture;
@@ -114,14 +143,14 @@ namespace maple
 				if (mp->normal_texname.length() > 0)
 				{
 					std::shared_ptr<Texture2D> texture = loadMaterialTextures("Normal",
-					                                                          texturesCache, mp->normal_texname, directory, TextureParameters(TextureFilter::Linear, TextureFilter::Linear, mp->normal_texopt.clamp ? TextureWrap::ClampToEdge : TextureWrap::Repeat));
+					                                                          mp->normal_texname, directory, TextureParameters(TextureFilter::Linear, TextureFilter::Linear, mp->normal_texopt.clamp ? TextureWrap::ClampToEdge : TextureWrap::Repeat));
 					if (texture)
 						textures.normal = texture;
 				}
 
 				if (mp->roughness_texname.length() > 0)
 				{
-					std::shared_ptr<Texture2D> texture = loadMaterialTextures("Roughness", texturesCache, mp->roughness_texname.c_str(), directory,
+					std::shared_ptr<Texture2D> texture = loadMaterialTextures("Roughness", mp->roughness_texname.c_str(), directory,
 					                                                          TextureParameters(
 					                                                              TextureFilter::Linear,
 					                                                              TextureFilter::Linear, mp->roughness_texopt.clamp ? TextureWrap::ClampToEdge : TextureWrap::Repeat));
@@ -131,7 +160,7 @@ namespace maple
 
 				if (mp->metallic_texname.length() > 0)
 				{
-					std::shared_ptr<Texture2D> texture = loadMaterialTextures("Metallic", texturesCache, mp->metallic_texname, directory,
+					std::shared_ptr<Texture2D> texture = loadMaterialTextures("Metallic", mp->metallic_texname, directory,
 					                                                          TextureParameters(
 					                                                              TextureFilter::Linear,
 					                                                              TextureFilter::Linear, mp->metallic_texopt.clamp ? TextureWrap::ClampToEdge : TextureWrap::Repeat));
@@ -141,7 +170,7 @@ namespace maple
 
 				/*	if (mp->specular_highlight_texname.length() > 0)
 					{
-						std::shared_ptr<Texture2D> texture = loadMaterialTextures("Metallic", texturesCache, mp->specular_highlight_texname, directory, TextureParameters(TextureFilter::Nearest, TextureFilter::Nearest, mp->specular_texopt.clamp ? TextureWrap::ClampToEdge : TextureWrap::Repeat));
+						std::shared_ptr<Texture2D> texture = loadMaterialTextures("Metallic", mp->specular_highlight_texname, directory, TextureParameters(TextureFilter::Nearest, TextureFilter::Nearest, mp->specular_texopt.clamp ? TextureWrap::ClampToEdge : TextureWrap::Repeat));
 						if (texture)
 							textures.metallic = texture;
 					}*/
@@ -0,0 +1,153 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+#include "TextureImporter.h"
+#include "BlockCompression.h"
+#include "ImageLoader.h"
+#include "KTX2Loader.h"
+
+#include "Engine/Profiler.h"
+#include "FileSystem/File.h"
+#include "Others/Console.h"
+#include "Others/StringUtils.h"
+#include "RHI/Texture.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <vector>
+
+namespace maple
+{
+	namespace
+	{
+		inline auto isNormalMap(const std::string &source)
+		{
+			auto name = StringUtils::getFileNameWithoutExtension(source);
+			std::transform(name.begin(), name.end(), name.begin(), [](unsigned char c) -> unsigned char { return std::tolower(c); });
+			return name.find("normal") != std::string::npos || name.find("_nrm") != std::string::npos ||
+			       (name.size() > 2 && name.compare(name.size() - 2, 2, "_n") == 0);
+		}
+
+		inline auto hasAlpha(const uint8_t *rgba, uint64_t pixels)
+		{
+			for (uint64_t i = 0; i < pixels; i++)
+				if (rgba[i * 4 + 3] != 255)
+					return true;
+			return false;
+		}
+
+		inline auto toFormat(TextureImporter::Compression compression)
+		{
+			switch (compression)
+			{
+				case TextureImporter::Compression::BC1:
+					return TextureFormat::BC1;
+				case TextureImporter::Compression::BC3:
+					return TextureFormat::BC3;
+				case TextureImporter::Compression::BC4:
+					return TextureFormat::BC4;
+				case TextureImporter::Compression::BC5:
+					return TextureFormat::BC5;
+				default:
+					return TextureFormat::RGBA8;
+			}
+		}
+	}        // namespace
+
+	auto TextureImporter::getImportedPath(const std::string &source) -> std::string
+	{
+		return StringUtils::removeExtension(source) + ".ktx2";
+	}
+
+	auto TextureImporter::isImported(const std::string &source) -> bool
+	{
+		std::error_code error;
+		const auto      imported = getImportedPath(source);
+		if (imported == source || !std::filesystem::exists(imported, error))
+			return false;
+		return std::filesystem::last_write_time(imported, error) >= std::filesystem::last_write_time(source, error);
+	}
+
+	auto TextureImporter::import(const std::string &source, Compression compression, bool flipY) -> bool
+	{
+		PROFILE_FUNCTION();
+		if (KTX2Loader::isKTX2(source) || !File::fileExists(source))
+			return false;
+
+		auto image = ImageLoader::loadAsset(source, true, flipY);
+		if (image == nullptr || image->getData() == nullptr || image->isHDR())
+		{
+			LOGW("TextureImporter : {0} is skipped, only 8 bit images are imported", source);
+			return false;
+		}
+
+		const auto width  = image->getWidth();
+		const auto height = image->getHeight();
+		const auto pixels = static_cast<const uint8_t *>(image->getData());
+
+		if (compression == Compression::Auto)
+			compression = isNormalMap(source) ? Compression::BC5 : hasAlpha(pixels, uint64_t(width) * height) ? Compression::BC3 : Compression::BC1;
+
+		const auto format = toFormat(compression);
+		const auto levels = Texture::calculateMipMapCount(width, height);
+
+		std::vector<uint8_t>  chain;
+		std::vector<uint64_t> offsets;
+		Texture::buildMipChain(pixels, width, height, 4, levels, chain, offsets);
+
+		uint64_t size = chain.size();
+		if (format != TextureFormat::RGBA8)
+		{
+			size = 0;
+			for (uint32_t level = 0; level < levels; level++)
+				size += Texture::getLevelSize(format, std::max(width >> level, 1u), std::max(height >> level, 1u));
+		}
+
+		auto data = static_cast<uint8_t *>(malloc(size));
+		if (format == TextureFormat::RGBA8)
+		{
+			std::copy(chain.begin(), chain.end(), data);
+		}
+		else
+		{
+			auto out = data;
+			for (uint32_t level = 0; level < levels; level++)
+			{
+				const auto levelWidth  = std::max(width >> level, 1u);
+				const auto levelHeight = std::max(height >> level, 1u);
+				BlockCompression::compress(format, chain.data() + offsets[level], levelWidth, levelHeight, out);
+				out += Texture::getLevelSize(format, levelWidth, levelHeight);
+			}
+		}
+
+		Image compressed(format, width, height, data, static_cast<uint32_t>(size), image->getChannel(), true);
+		compressed.setLevels(levels);
+
+		const auto imported = getImportedPath(source);
+		if (!KTX2Loader::save(imported, compressed, flipY))
+			return false;
+
+		std::error_code error;
+		LOGI("TextureImporter : {0} -> {1}, {2} KB of texture memory instead of {3} KB, {4} KB on disk",
+		     source, imported, size >> 10, chain.size() >> 10, std::filesystem::file_size(imported, error) >> 10);
+		return true;
+	}
+
+	auto TextureImporter::importFolder(const std::string &folder) -> uint32_t
+	{
+		PROFILE_FUNCTION();
+		std::error_code error;
+		uint32_t        count = 0;
+		for (auto &entry : std::filesystem::recursive_directory_iterator(folder, error))
+		{
+			const auto path = entry.path().generic_string();
+			if (!entry.is_regular_file() || KTX2Loader::isKTX2(path) || !File::isKindOf(path, FileType::Texture) || isImported(path))
+				continue;
+			if (import(path))
+				count++;
+		}
+		LOGI("TextureImporter : {0} textures imported in {1}", count, folder);
+		return count;
+	}
+}        // namespace maple
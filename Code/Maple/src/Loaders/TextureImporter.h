@@ -0,0 +1,40 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "Engine/Core.h"
+#include <cstdint>
+#include <string>
+
+namespace maple
+{
+	/**
+	 * Offline import of the source images (png, jpg, tga) into mipmapped, block compressed KTX2 files next to them.
+	 * ImageLoader picks the imported file up instead of the source when it is not older, so the assets keep
+	 * referring to the source and the import can be redone at any time.
+	 */
+	class MAPLE_EXPORT TextureImporter final
+	{
+	  public:
+		enum class Compression
+		{
+			Auto,        //BC5 for normal maps, BC3 when there is alpha, BC1 otherwise
+			BC1,
+			BC3,
+			BC4,
+			BC5,
+			None        //RGBA8 with the mip chain
+		};
+
+		static auto getImportedPath(const std::string &source) -> std::string;
+
+		//the imported file exists and is at least as new as the source
+		static auto isImported(const std::string &source) -> bool;
+
+		//flipY has to match the way the texture is loaded, an import of the other orientation is ignored
+		static auto import(const std::string &source, Compression compression = Compression::Auto, bool flipY = true) -> bool;
+
+		//imports the textures below the folder which are not imported or out of date, returns how many were written
+		static auto importFolder(const std::string &folder) -> uint32_t;
+	};
+}        // namespace maple
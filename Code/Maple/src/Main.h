@@ -5,12 +5,12 @@
 #include "Application.h"
 #include "Others/Console.h"
 
-extern maple::Application *createApplication();
+extern maple::Application *createApplication(const maple::ApplicationConfig &config);
 
-auto main() -> int32_t
+auto main(int32_t argc, char **argv) -> int32_t
 {
 	maple::Console::init();
-	maple::Application::app = createApplication();
+	maple::Application::app = createApplication(maple::ApplicationConfig::fromCommandLine(argc, argv));
 	auto retCode            = maple::Application::app->start();
 	delete maple::Application::app;
 	return retCode;
@@ -0,0 +1,306 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+#include "DynamicBVH.h"
+#include "Others/Console.h"
+
+#include <algorithm>
+
+namespace maple
+{
+	namespace
+	{
+		inline auto surfaceArea(const BoundingBox &box)
+		{
+			const auto size = box.max - box.min;
+			return 2.f * (size.x * size.y + size.y * size.z + size.z * size.x);
+		}
+
+		inline auto combine(const BoundingBox &a, const BoundingBox &b)
+		{
+			return BoundingBox{glm::min(a.min, b.min), glm::max(a.max, b.max)};
+		}
+
+		inline auto contains(const BoundingBox &outer, const BoundingBox &inner)
+		{
+			return outer.min.x <= inner.min.x && outer.min.y <= inner.min.y && outer.min.z <= inner.min.z &&
+			       inner.max.x <= outer.max.x && inner.max.y <= outer.max.y && inner.max.z <= outer.max.z;
+		}
+	}        // namespace
+
+	auto DynamicBVH::createProxy(const BoundingBox &box, uint32_t userData) -> int32_t
+	{
+		const auto proxy = allocateNode();
+		auto &     node  = nodes[proxy];
+		node.box         = {box.min - glm::vec3(Margin), box.max + glm::vec3(Margin)};
+		node.userData    = userData;
+		node.height      = 0;
+		insertLeaf(proxy);
+		proxyCount++;
+		return proxy;
+	}
+
+	auto DynamicBVH::destroyProxy(int32_t proxy) -> void
+	{
+		MAPLE_ASSERT(proxy >= 0 && proxy < static_cast<int32_t>(nodes.size()) && nodes[proxy].isLeaf(), "invalid proxy");
+		removeLeaf(proxy);
+		freeNode(proxy);
+		proxyCount--;
+	}
+
+	auto DynamicBVH::moveProxy(int32_t proxy, const BoundingBox &box) -> bool
+	{
+		MAPLE_ASSERT(proxy >= 0 && proxy < static_cast<int32_t>(nodes.size()) && nodes[proxy].isLeaf(), "invalid proxy");
+		if (contains(nodes[proxy].box, box))
+			return false;
+
+		removeLeaf(proxy);
+		nodes[proxy].box = {box.min - glm::vec3(Margin), box.max + glm::vec3(Margin)};
+		insertLeaf(proxy);
+		return true;
+	}
+
+	auto DynamicBVH::clear() -> void
+	{
+		nodes.clear();
+		root       = NullNode;
+		freeList   = NullNode;
+		proxyCount = 0;
+	}
+
+	auto DynamicBVH::getHeight() const -> int32_t
+	{
+		return root == NullNode ? 0 : nodes[root].height;
+	}
+
+	auto DynamicBVH::allocateNode() -> int32_t
+	{
+		if (freeList == NullNode)
+		{
+			nodes.emplace_back();
+			return static_cast<int32_t>(nodes.size() - 1);
+		}
+		const auto index = freeList;
+		freeList         = nodes[index].parent;
+		nodes[index]     = Node{};
+		return index;
+	}
+
+	auto DynamicBVH::freeNode(int32_t index) -> void
+	{
+		nodes[index].parent = freeList;
+		nodes[index].left   = NullNode;
+		nodes[index].right  = NullNode;
+		nodes[index].height = -1;
+		freeList            = index;
+	}
+
+	auto DynamicBVH::insertLeaf(int32_t leaf) -> void
+	{
+		if (root == NullNode)
+		{
+			root               = leaf;
+			nodes[leaf].parent = NullNode;
+			return;
+		}
+
+		//find the best sibling by walking down the cheapest branch
+		const auto leafBox = nodes[leaf].box;
+		auto       index   = root;
+		while (!nodes[index].isLeaf())
+		{
+			const auto &node         = nodes[index];
+			const float area         = surfaceArea(node.box);
+			const float combinedArea = surfaceArea(combine(node.box, leafBox));
+
+			//cost of creating a new parent for this node and the new leaf
+			const float cost = 2.f * combinedArea;
+			//minimum cost of pushing the leaf further down the tree
+			const float inheritance = 2.f * (combinedArea - area);
+
+			auto descend = [&](int32_t child) {
+				const auto &childNode = nodes[child];
+				const float newArea   = surfaceArea(combine(leafBox, childNode.box));
+				return childNode.isLeaf() ? newArea + inheritance : newArea - surfaceArea(childNode.box) + inheritance;
+			};
+
+			const float costLeft  = descend(node.left);
+			const float costRight = descend(node.right);
+
+			if (cost < costLeft && cost < costRight)
+				break;
+
+			index = costLeft < costRight ? node.left : node.right;
+		}
+
+		const auto sibling   = index;
+		const auto oldParent = nodes[sibling].parent;
+		const auto newParent = allocateNode();
+
+		nodes[newParent].parent = oldParent;
+		nodes[newParent].box    = combine(leafBox, nodes[sibling].box);
+		nodes[newParent].height = nodes[sibling].height + 1;
+
+		if (oldParent != NullNode)
+		{
+			if (nodes[oldParent].left == sibling)
+				nodes[oldParent].left = newParent;
+			else
+				nodes[oldParent].right = newParent;
+		}
+		else
+		{
+			root = newParent;
+		}
+
+		nodes[newParent].left  = sibling;
+		nodes[newParent].right = leaf;
+		nodes[sibling].parent  = newParent;
+		nodes[leaf].parent     = newParent;
+
+		//walk back up the tree fixing heights and boxes
+		index = nodes[leaf].parent;
+		while (index != NullNode)
+		{
+			index       = balance(index);
+			auto &node  = nodes[index];
+			node.height = 1 + std::max(nodes[node.left].height, nodes[node.right].height);
+			node.box    = combine(nodes[node.left].box, nodes[node.right].box);
+			index       = node.parent;
+		}
+	}
+
+	auto DynamicBVH::removeLeaf(int32_t leaf) -> void
+	{
+		if (leaf == root)
+		{
+			root = NullNode;
+			return;
+		}
+
+		const auto parent      = nodes[leaf].parent;
+		const auto grandParent = nodes[parent].parent;
+		const auto sibling     = nodes[parent].left == leaf ? nodes[parent].right : nodes[parent].left;
+
+		if (grandParent != NullNode)
+		{
+			if (nodes[grandParent].left == parent)
+				nodes[grandParent].left = sibling;
+			else
+				nodes[grandParent].right = sibling;
+			nodes[sibling].parent = grandParent;
+			freeNode(parent);
+
+			auto index = grandParent;
+			while (index != NullNode)
+			{
+				index       = balance(index);
+				auto &node  = nodes[index];
+				node.height = 1 + std::max(nodes[node.left].height, nodes[node.right].height);
+				node.box    = combine(nodes[node.left].box, nodes[node.right].box);
+				index       = node.parent;
+			}
+		}
+		else
+		{
+			root                  = sibling;
+			nodes[sibling].parent = NullNode;
+			freeNode(parent);
+		}
+	}
+
+	//rotate the taller child up if the node is unbalanced, return the new root of the sub-tree
+	auto DynamicBVH::balance(int32_t iA) -> int32_t
+	{
+		auto &a = nodes[iA];
+		if (a.isLeaf() || a.height < 2)
+			return iA;
+
+		const auto iB = a.left;
+		const auto iC = a.right;
+		auto &     b  = nodes[iB];
+		auto &     c  = nodes[iC];
+
+		const auto diff = c.height - b.height;
+
+		auto replaceChild = [&](int32_t parent, int32_t from, int32_t to) {
+			if (parent == NullNode)
+				root = to;
+			else if (nodes[parent].left == from)
+				nodes[parent].left = to;
+			else
+				nodes[parent].right = to;
+		};
+
+		if (diff > 1)
+		{
+			const auto iF = c.left;
+			const auto iG = c.right;
+			auto &     f  = nodes[iF];
+			auto &     g  = nodes[iG];
+
+			c.left   = iA;
+			c.parent = a.parent;
+			a.parent = iC;
+			replaceChild(c.parent, iA, iC);
+
+			if (f.height > g.height)
+			{
+				c.right  = iF;
+				a.right  = iG;
+				g.parent = iA;
+				a.box    = combine(b.box, g.box);
+				c.box    = combine(a.box, f.box);
+				a.height = 1 + std::max(b.height, g.height);
+				c.height = 1 + std::max(a.height, f.height);
+			}
+			else
+			{
+				c.right  = iG;
+				a.right  = iF;
+				f.parent = iA;
+				a.box    = combine(b.box, f.box);
+				c.box    = combine(a.box, g.box);
+				a.height = 1 + std::max(b.height, f.height);
+				c.height = 1 + std::max(a.height, g.height);
+			}
+			return iC;
+		}
+
+		if (diff < -1)
+		{
+			const auto iD = b.left;
+			const auto iE = b.right;
+			auto &     d  = nodes[iD];
+			auto &     e  = nodes[iE];
+
+			b.left   = iA;
+			b.parent = a.parent;
+			a.parent = iB;
+			replaceChild(b.parent, iA, iB);
+
+			if (d.height > e.height)
+			{
+				b.right  = iD;
+				a.left   = iE;
+				e.parent = iA;
+				a.box    = combine(c.box, e.box);
+				b.box    = combine(a.box, d.box);
+				a.height = 1 + std::max(c.height, e.height);
+				b.height = 1 + std::max(a.height, d.height);
+			}
+			else
+			{
+				b.right  = iE;
+				a.left   = iD;
+				d.parent = iA;
+				a.box    = combine(c.box, d.box);
+				b.box    = combine(a.box, e.box);
+				a.height = 1 + std::max(c.height, d.height);
+				b.height = 1 + std::max(a.height, e.height);
+			}
+			return iB;
+		}
+		return iA;
+	}
+};        // namespace maple
@@ -0,0 +1,252 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "Engine/Core.h"
+#include "BoundingBox.h"
+#include "Frustum.h"
+#include "Ray.h"
+
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace maple
+{
+	/**
+	 * Dynamic bounding volume hierarchy over world space boxes.
+	 * Leaves store a fattened box so small movements do not touch the tree,
+	 * larger ones remove and reinsert the leaf with a surface area heuristic and AVL style rotations.
+	 * Queries only visit the branches overlapping the query volume.
+	 */
+	class MAPLE_EXPORT DynamicBVH
+	{
+	  public:
+		static constexpr int32_t NullNode   = -1;
+		static constexpr int32_t StackDepth = 256;
+		//extension of the leaf boxes in world units
+		static constexpr float Margin = 0.1f;
+
+		struct RayHit
+		{
+			uint32_t userData = UINT32_MAX;
+			float    distance = INFINITY;
+		};
+
+		DynamicBVH() = default;
+
+		auto createProxy(const BoundingBox &box, uint32_t userData) -> int32_t;
+		auto destroyProxy(int32_t proxy) -> void;
+
+		//return true if the leaf has been reinserted
+		auto moveProxy(int32_t proxy, const BoundingBox &box) -> bool;
+
+		auto clear() -> void;
+
+		auto getHeight() const -> int32_t;
+
+		inline auto getUserData(int32_t proxy) const
+		{
+			return nodes[proxy].userData;
+		}
+
+		inline auto &getFatBox(int32_t proxy) const
+		{
+			return nodes[proxy].box;
+		}
+
+		inline auto getProxyCount() const
+		{
+			return proxyCount;
+		}
+
+		inline auto getNodeCount() const
+		{
+			return static_cast<uint32_t>(nodes.size());
+		}
+
+		/**
+		 * func(userData) is called for every leaf touching the frustum.
+		 * a branch completely inside the frustum is emitted without testing its leaves.
+		 */
+		template <typename Func>
+		inline auto query(const Frustum &frustum, const Func &func) const -> void
+		{
+			int32_t stack[StackDepth];
+			int32_t count = 0;
+			if (root != NullNode)
+				stack[count++] = root;
+
+			while (count > 0)
+			{
+				const auto  index = stack[--count];
+				const auto &node  = nodes[index];
+
+				const auto result = frustum.intersect(node.box);
+				if (result == Frustum::Intersection::Outside)
+					continue;
+
+				if (node.isLeaf())
+					func(node.userData);
+				else if (result == Frustum::Intersection::Inside)
+					forEachLeaf(index, func);
+				else
+				{
+					stack[count++] = node.left;
+					stack[count++] = node.right;
+				}
+			}
+		}
+
+		//func(userData) for every leaf overlapping the box
+		template <typename Func>
+		inline auto query(const BoundingBox &box, const Func &func) const -> void
+		{
+			traverse([&](const BoundingBox &nodeBox) { return overlap(nodeBox, box); }, func);
+		}
+
+		//func(userData) for every leaf overlapping the sphere
+		template <typename Func>
+		inline auto query(const glm::vec3 &center, float radius, const Func &func) const -> void
+		{
+			traverse([&](const BoundingBox &nodeBox) {
+				const auto closest = glm::clamp(center, nodeBox.min, nodeBox.max);
+				const auto offset  = closest - center;
+				return glm::dot(offset, offset) <= radius * radius;
+			},
+			         func);
+		}
+
+		/**
+		 * find the closest leaf hit by the ray.
+		 * func(userData) returns the exact distance of the hit or INFINITY if the candidate is missed,
+		 * branches further than the closest hit found so far are skipped.
+		 */
+		template <typename Func>
+		inline auto raycast(const Ray &ray, float maxDistance, const Func &func) const -> RayHit
+		{
+			RayHit hit;
+			hit.distance = maxDistance;
+
+			const glm::vec3 invDir = 1.f / ray.direction;
+
+			int32_t stack[StackDepth];
+			int32_t count = 0;
+			if (root != NullNode)
+				stack[count++] = root;
+
+			while (count > 0)
+			{
+				const auto &node = nodes[stack[--count]];
+				if (intersect(ray.origin, invDir, node.box) > hit.distance)
+					continue;
+
+				if (node.isLeaf())
+				{
+					const float distance = func(node.userData);
+					if (distance < hit.distance)
+					{
+						hit.distance = distance;
+						hit.userData = node.userData;
+					}
+				}
+				else
+				{
+					stack[count++] = node.left;
+					stack[count++] = node.right;
+				}
+			}
+			return hit;
+		}
+
+		//slab test, INFINITY if missed
+		static inline auto intersect(const glm::vec3 &origin, const glm::vec3 &invDir, const BoundingBox &box) -> float
+		{
+			const glm::vec3 t0   = (box.min - origin) * invDir;
+			const glm::vec3 t1   = (box.max - origin) * invDir;
+			const glm::vec3 tMin = glm::min(t0, t1);
+			const glm::vec3 tMax = glm::max(t0, t1);
+
+			const float enter = glm::max(glm::max(tMin.x, tMin.y), glm::max(tMin.z, 0.f));
+			const float exit  = glm::min(glm::min(tMax.x, tMax.y), tMax.z);
+			return enter <= exit ? enter : INFINITY;
+		}
+
+		static inline auto overlap(const BoundingBox &a, const BoundingBox &b) -> bool
+		{
+			return a.min.x <= b.max.x && a.max.x >= b.min.x &&
+			       a.min.y <= b.max.y && a.max.y >= b.min.y &&
+			       a.min.z <= b.max.z && a.max.z >= b.min.z;
+		}
+
+	  private:
+		struct Node
+		{
+			BoundingBox box;
+			int32_t     parent   = NullNode;        //next free node when the node is not used
+			int32_t     left     = NullNode;
+			int32_t     right    = NullNode;
+			int32_t     height   = -1;              //0 for leaves, -1 for free nodes
+			uint32_t    userData = 0;
+
+			inline auto isLeaf() const
+			{
+				return left == NullNode;
+			}
+		};
+
+		template <typename Test, typename Func>
+		inline auto traverse(const Test &test, const Func &func) const -> void
+		{
+			int32_t stack[StackDepth];
+			int32_t count = 0;
+			if (root != NullNode)
+				stack[count++] = root;
+
+			while (count > 0)
+			{
+				const auto &node = nodes[stack[--count]];
+				if (!test(node.box))
+					continue;
+
+				if (node.isLeaf())
+					func(node.userData);
+				else
+				{
+					stack[count++] = node.left;
+					stack[count++] = node.right;
+				}
+			}
+		}
+
+		template <typename Func>
+		inline auto forEachLeaf(int32_t index, const Func &func) const -> void
+		{
+			int32_t stack[StackDepth];
+			int32_t count  = 0;
+			stack[count++] = index;
+			while (count > 0)
+			{
+				const auto &node = nodes[stack[--count]];
+				if (node.isLeaf())
+					func(node.userData);
+				else
+				{
+					stack[count++] = node.left;
+					stack[count++] = node.right;
+				}
+			}
+		}
+
+		auto allocateNode() -> int32_t;
+		auto freeNode(int32_t index) -> void;
+		auto insertLeaf(int32_t leaf) -> void;
+		auto removeLeaf(int32_t leaf) -> void;
+		auto balance(int32_t index) -> int32_t;
+
+		std::vector<Node> nodes;
+		int32_t           root       = NullNode;
+		int32_t           freeList   = NullNode;
+		uint32_t          proxyCount = 0;
+	};
+};        // namespace maple
@@ -117,4 +117,34 @@ namespace maple
 		return true;
 	}
 
+	auto Frustum::isInside(const glm::vec3 &center, float radius) const -> bool
+	{
+		for (int32_t i = 0; i < 6; i++)
+		{
+			if (planes[i].getDistance(center) < -radius)
+			{
+				return false;
+			}
+		}
+		return true;
+	}
+
+	auto Frustum::intersect(const BoundingBox &box) const -> Intersection
+	{
+		auto result = Intersection::Inside;
+		for (int32_t i = 0; i < 6; i++)
+		{
+			const auto &normal = planes[i].getNormal();
+
+			const glm::vec3 p = {normal.x >= 0 ? box.max.x : box.min.x, normal.y >= 0 ? box.max.y : box.min.y, normal.z >= 0 ? box.max.z : box.min.z};
+			if (planes[i].getDistance(p) < 0)
+				return Intersection::Outside;
+
+			const glm::vec3 n = {normal.x >= 0 ? box.min.x : box.max.x, normal.y >= 0 ? box.min.y : box.max.y, normal.z >= 0 ? box.min.z : box.max.z};
+			if (planes[i].getDistance(n) < 0)
+				result = Intersection::Intersect;
+		}
+		return result;
+	}
+
 };        // namespace maple
@@ -24,6 +24,13 @@ namespace maple
 			PlaneFar
 		};
 
+		enum class Intersection
+		{
+			Outside,
+			Intersect,
+			Inside
+		};
+
 		static constexpr uint32_t FRUSTUM_VERTICES = 8;
 
 		Frustum() noexcept = default;
@@ -33,6 +40,10 @@ namespace maple
 		auto isInside(const glm::vec3 &pos) const -> bool;
 		auto isInside(const BoundingBox &box) const -> bool;
 		auto isInside(const std::shared_ptr<BoundingBox> &box) const -> bool;
+		auto isInside(const glm::vec3 &center, float radius) const -> bool;
+
+		//Inside means the whole box is inside, used to accept whole branches of a hierarchy
+		auto intersect(const BoundingBox &box) const -> Intersection;
 
 		inline auto &getPlane(FrustumPlane id) const
 		{
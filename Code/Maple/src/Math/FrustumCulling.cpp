@@ -0,0 +1,245 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+#include "FrustumCulling.h"
+#include "Frustum.h"
+#include "Engine/Profiler.h"
+
+#include <algorithm>
+#include <cstring>
+
+#if defined(__AVX2__)
+#	define MAPLE_CULLING_AVX2
+#	include <immintrin.h>
+#elif defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#	define MAPLE_CULLING_SSE
+#	include <emmintrin.h>
+#endif
+
+#if defined(_MSC_VER)
+#	include <intrin.h>
+#endif
+
+namespace maple
+{
+	namespace
+	{
+		//plane with the absolute normal, distance(p-vertex) = dot(n, c) + d + dot(|n|, e)
+		struct CullPlane
+		{
+			float nx, ny, nz, d;
+			float ax, ay, az;
+		};
+
+		inline auto getPlanes(const Frustum &frustum, CullPlane *planes)
+		{
+			for (int32_t i = 0; i < 6; i++)
+			{
+				const auto &plane  = frustum.getPlane(i);
+				const auto  normal = plane.getNormal();
+				planes[i]          = {normal.x, normal.y, normal.z, plane.getDistance(), std::abs(normal.x), std::abs(normal.y), std::abs(normal.z)};
+			}
+		}
+
+		inline auto countBits(uint64_t bits) -> uint32_t
+		{
+			uint32_t count = 0;
+			for (; bits != 0; bits &= bits - 1)
+				count++;
+			return count;
+		}
+
+		inline auto cullRange(const CullPlane *planes,
+		                      const float *centerX, const float *centerY, const float *centerZ,
+		                      const float *extentX, const float *extentY, const float *extentZ,
+		                      uint32_t begin, uint32_t end, uint64_t *visibility) -> void
+		{
+			for (uint32_t i = begin; i < end; i++)
+			{
+				bool inside = true;
+				for (int32_t p = 0; p < 6 && inside; p++)
+				{
+					const auto &plane = planes[p];
+					const float dist  = plane.nx * centerX[i] + plane.ny * centerY[i] + plane.nz * centerZ[i] + plane.d +
+					                   plane.ax * extentX[i] + plane.ay * extentY[i] + plane.az * extentZ[i];
+					inside = dist >= 0.f;
+				}
+				if (inside)
+					visibility[i >> 6] |= uint64_t(1) << (i & 63);
+			}
+		}
+	}        // namespace
+
+	auto CullingBatch::reserve(uint32_t count) -> void
+	{
+		centerX.reserve(count);
+		centerY.reserve(count);
+		centerZ.reserve(count);
+		extentX.reserve(count);
+		extentY.reserve(count);
+		extentZ.reserve(count);
+		userData.reserve(count);
+	}
+
+	auto CullingBatch::add(const BoundingBox &worldBox, uint32_t data) -> void
+	{
+		const auto center = worldBox.center();
+		const auto extent = worldBox.size() * 0.5f;
+		centerX.emplace_back(center.x);
+		centerY.emplace_back(center.y);
+		centerZ.emplace_back(center.z);
+		extentX.emplace_back(extent.x);
+		extentY.emplace_back(extent.y);
+		extentZ.emplace_back(extent.z);
+		userData.emplace_back(data);
+	}
+
+	auto CullingBatch::add(const BoundingBox &localBox, const glm::mat4 &transform, uint32_t data) -> void
+	{
+		const auto center = glm::vec3(transform * glm::vec4(localBox.center(), 1.f));
+		const auto edge   = localBox.size() * 0.5f;
+		const auto extent = glm::abs(glm::vec3(transform[0])) * edge.x + glm::abs(glm::vec3(transform[1])) * edge.y + glm::abs(glm::vec3(transform[2])) * edge.z;
+		centerX.emplace_back(center.x);
+		centerY.emplace_back(center.y);
+		centerZ.emplace_back(center.z);
+		extentX.emplace_back(extent.x);
+		extentY.emplace_back(extent.y);
+		extentZ.emplace_back(extent.z);
+		userData.emplace_back(data);
+	}
+
+	auto CullingBatch::cull(const Frustum &frustum, std::vector<uint64_t> &visibility) const -> uint32_t
+	{
+		visibility.resize((size() + 63) / 64);
+		return frustum_culling::cull(frustum,
+		                             centerX.data(), centerY.data(), centerZ.data(),
+		                             extentX.data(), extentY.data(), extentZ.data(),
+		                             size(), visibility.data());
+	}
+
+	auto CullingBatch::countTrailingZero(uint64_t bits) -> uint32_t
+	{
+#if defined(_MSC_VER)
+		unsigned long index = 0;
+		_BitScanForward64(&index, bits);
+		return static_cast<uint32_t>(index);
+#else
+		return static_cast<uint32_t>(__builtin_ctzll(bits));
+#endif
+	}
+
+	namespace frustum_culling
+	{
+		auto cullScalar(const Frustum &frustum,
+		                const float *centerX, const float *centerY, const float *centerZ,
+		                const float *extentX, const float *extentY, const float *extentZ,
+		                uint32_t count, uint64_t *visibility) -> uint32_t
+		{
+			const uint32_t words = (count + 63) / 64;
+			std::memset(visibility, 0, words * sizeof(uint64_t));
+
+			CullPlane planes[6];
+			getPlanes(frustum, planes);
+			cullRange(planes, centerX, centerY, centerZ, extentX, extentY, extentZ, 0, count, visibility);
+
+			uint32_t visible = 0;
+			for (uint32_t i = 0; i < words; i++)
+				visible += countBits(visibility[i]);
+			return visible;
+		}
+
+		auto cull(const Frustum &frustum,
+		          const float *centerX, const float *centerY, const float *centerZ,
+		          const float *extentX, const float *extentY, const float *extentZ,
+		          uint32_t count, uint64_t *visibility) -> uint32_t
+		{
+			PROFILE_FUNCTION();
+#if defined(MAPLE_CULLING_AVX2) || defined(MAPLE_CULLING_SSE)
+			const uint32_t words = (count + 63) / 64;
+			std::memset(visibility, 0, words * sizeof(uint64_t));
+
+			CullPlane planes[6];
+			getPlanes(frustum, planes);
+
+#	if defined(MAPLE_CULLING_AVX2)
+			constexpr uint32_t Width = 8;
+			const uint32_t     simdCount = count & ~(Width - 1);
+			const __m256       zero      = _mm256_setzero_ps();
+
+			for (uint32_t i = 0; i < simdCount; i += Width)
+			{
+				const __m256 cx = _mm256_loadu_ps(centerX + i);
+				const __m256 cy = _mm256_loadu_ps(centerY + i);
+				const __m256 cz = _mm256_loadu_ps(centerZ + i);
+				const __m256 ex = _mm256_loadu_ps(extentX + i);
+				const __m256 ey = _mm256_loadu_ps(extentY + i);
+				const __m256 ez = _mm256_loadu_ps(extentZ + i);
+
+				__m256 inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+				for (const auto &plane : planes)
+				{
+					//mul and add, fma is an instruction set of its own and gives other results than the scalar path
+					__m256 dist = _mm256_set1_ps(plane.d);
+					dist        = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(plane.nx), cx), dist);
+					dist        = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(plane.ny), cy), dist);
+					dist        = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(plane.nz), cz), dist);
+					dist        = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(plane.ax), ex), dist);
+					dist        = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(plane.ay), ey), dist);
+					dist        = _mm256_add_ps(_mm256_mul_ps(_mm256_set1_ps(plane.az), ez), dist);
+					inside      = _mm256_and_ps(inside, _mm256_cmp_ps(dist, zero, _CMP_GE_OQ));
+				}
+				const auto bits = static_cast<uint64_t>(_mm256_movemask_ps(inside));
+				visibility[i >> 6] |= bits << (i & 63);
+			}
+#	else
+			constexpr uint32_t Width = 4;
+			const uint32_t     simdCount = count & ~(Width - 1);
+			const __m128       zero      = _mm_setzero_ps();
+
+			for (uint32_t i = 0; i < simdCount; i += Width)
+			{
+				const __m128 cx = _mm_loadu_ps(centerX + i);
+				const __m128 cy = _mm_loadu_ps(centerY + i);
+				const __m128 cz = _mm_loadu_ps(centerZ + i);
+				const __m128 ex = _mm_loadu_ps(extentX + i);
+				const __m128 ey = _mm_loadu_ps(extentY + i);
+				const __m128 ez = _mm_loadu_ps(extentZ + i);
+
+				__m128 inside = _mm_castsi128_ps(_mm_set1_epi32(-1));
+				for (const auto &plane : planes)
+				{
+					__m128 dist = _mm_add_ps(_mm_mul_ps(_mm_set1_ps(plane.nx), cx), _mm_set1_ps(plane.d));
+					dist        = _mm_add_ps(dist, _mm_mul_ps(_mm_set1_ps(plane.ny), cy));
+					dist        = _mm_add_ps(dist, _mm_mul_ps(_mm_set1_ps(plane.nz), cz));
+					dist        = _mm_add_ps(dist, _mm_mul_ps(_mm_set1_ps(plane.ax), ex));
+					dist        = _mm_add_ps(dist, _mm_mul_ps(_mm_set1_ps(plane.ay), ey));
+					dist        = _mm_add_ps(dist, _mm_mul_ps(_mm_set1_ps(plane.az), ez));
+					inside      = _mm_and_ps(inside, _mm_cmpge_ps(dist, zero));
+				}
+				const auto bits = static_cast<uint64_t>(_mm_movemask_ps(inside));
+				visibility[i >> 6] |= bits << (i & 63);
+			}
+#	endif
+			cullRange(planes, centerX, centerY, centerZ, extentX, extentY, extentZ, simdCount, count, visibility);
+
+			uint32_t visible = 0;
+			for (uint32_t i = 0; i < words; i++)
+				visible += countBits(visibility[i]);
+			return visible;
+#else
+			return cullScalar(frustum, centerX, centerY, centerZ, extentX, extentY, extentZ, count, visibility);
+#endif
+		}
+
+		auto getInstructionSet() -> const char *
+		{
+#if defined(MAPLE_CULLING_AVX2)
+			return "AVX2";
+#elif defined(MAPLE_CULLING_SSE)
+			return "SSE2";
+#else
+			return "Scalar";
+#endif
+		}
+	}        // namespace frustum_culling
+};           // namespace maple
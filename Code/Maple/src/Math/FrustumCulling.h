@@ -0,0 +1,99 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "Engine/Core.h"
+#include "BoundingBox.h"
+
+#include <cstdint>
+#include <glm/glm.hpp>
+#include <vector>
+
+namespace maple
+{
+	class Frustum;
+
+	/**
+	 * World space boxes stored as separated center/extent arrays so they can be culled 4/8 at a time.
+	 * Bit i of the visibility mask is set when box i touches the frustum, the result is the same as Frustum::isInside.
+	 */
+	class MAPLE_EXPORT CullingBatch
+	{
+	  public:
+		inline auto clear()
+		{
+			centerX.clear();
+			centerY.clear();
+			centerZ.clear();
+			extentX.clear();
+			extentY.clear();
+			extentZ.clear();
+			userData.clear();
+		}
+
+		auto reserve(uint32_t count) -> void;
+
+		auto add(const BoundingBox &worldBox, uint32_t data) -> void;
+
+		//the local box is moved to world space with the absolute matrix, without transforming the 8 corners
+		auto add(const BoundingBox &localBox, const glm::mat4 &transform, uint32_t data) -> void;
+
+		//return the amount of visible boxes, visibility is resized to (size() + 63) / 64
+		auto cull(const Frustum &frustum, std::vector<uint64_t> &visibility) const -> uint32_t;
+
+		inline auto size() const
+		{
+			return static_cast<uint32_t>(userData.size());
+		}
+
+		inline auto getUserData(uint32_t i) const
+		{
+			return userData[i];
+		}
+
+		//func(index) for every visible box
+		template <typename Func>
+		inline auto forEachVisible(const std::vector<uint64_t> &visibility, const Func &func) const -> void
+		{
+			for (uint32_t word = 0; word < visibility.size(); word++)
+			{
+				for (auto bits = visibility[word]; bits != 0; bits &= bits - 1)
+				{
+					func(word * 64 + countTrailingZero(bits));
+				}
+			}
+		}
+
+	  private:
+		static auto countTrailingZero(uint64_t bits) -> uint32_t;
+
+		std::vector<float>    centerX;
+		std::vector<float>    centerY;
+		std::vector<float>    centerZ;
+		std::vector<float>    extentX;
+		std::vector<float>    extentY;
+		std::vector<float>    extentZ;
+		std::vector<uint32_t> userData;
+	};
+
+	namespace frustum_culling
+	{
+		/**
+		 * Test count boxes against the six planes of the frustum and write one bit per box into visibility,
+		 * which must hold (count + 63) / 64 words. Uses AVX2 or SSE when the build enables them.
+		 */
+		auto MAPLE_EXPORT cull(const Frustum &frustum,
+		                       const float *centerX, const float *centerY, const float *centerZ,
+		                       const float *extentX, const float *extentY, const float *extentZ,
+		                       uint32_t count, uint64_t *visibility) -> uint32_t;
+
+		//scalar reference of cull
+		auto MAPLE_EXPORT cullScalar(const Frustum &frustum,
+		                             const float *centerX, const float *centerY, const float *centerZ,
+		                             const float *extentX, const float *extentY, const float *extentZ,
+		                             uint32_t count, uint64_t *visibility) -> uint32_t;
+
+		//name of the instruction set used by cull
+		auto MAPLE_EXPORT getInstructionSet() -> const char *;
+	}        // namespace frustum_culling
+};           // namespace maple
@@ -5,6 +5,8 @@
 
 #ifdef _WIN32
 #	include <windows.h>
+#else
+#	include <dlfcn.h>
 #endif
 
 #include "Engine/Core.h"
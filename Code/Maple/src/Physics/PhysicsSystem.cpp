@@ -242,8 +242,8 @@ namespace maple
 				world.dynamicsWorld->setGravity(btVector3(0, -9.8, 0));
 			});
 
-			executePoint->registerSystem<update::updateRigidbody>();
-			executePoint->registerSystem<update::updateWorld>();
+			executePoint->registerSystem<update::updateRigidbody, access::Read<maple::global::component::AppState>>();
+			executePoint->registerSystem<update::updateWorld, access::Write<component::RigidBody>>();
 
 			executePoint->registerGameStart<on_game_start::system>();
 			executePoint->registerGameEnded<on_game_ended::system>();
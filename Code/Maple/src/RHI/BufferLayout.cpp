@@ -4,6 +4,8 @@
 #include "BufferLayout.h"
 #include "GraphicsContext.h"
 
+#include <array>
+
 namespace maple
 {
 	BufferLayout::BufferLayout()
@@ -18,7 +20,71 @@ namespace maple
 
 	auto BufferLayout::push(const std::string &name, Format format, uint32_t s, uint32_t location, bool normalized) -> void
 	{
-		layouts[location] = {name, format, s, normalized};
+		layouts[location] = {name, format, s, normalized, location};
+	}
+
+	auto BufferLayout::append(const std::string &name, Format format, uint32_t location, bool normalized) -> void
+	{
+		layouts.push_back({name, format, size, normalized, location});
+		size += getFormatSize(format);
+	}
+
+	auto BufferLayout::get(VertexLayout layout) -> const std::vector<BufferLayout> &
+	{
+		static const std::array<std::vector<BufferLayout>, 4> streams = []() {
+			std::array<std::vector<BufferLayout>, 4> streams;
+
+			//binding 0, positions relative to the bounds of the mesh
+			BufferLayout position;
+			position.append("inPosition", Format::R16G16B16A16_UNORM, 0, true);
+
+			BufferLayout attributes;
+			attributes.append("inColor", Format::R8G8B8A8_UNORM, 1, true);
+			attributes.append("inTexCoord", Format::R16G16_FLOAT, 2);
+			attributes.append("inNormal", Format::R16G16_SNORM, 3, true);
+			attributes.append("inTangent", Format::R16G16_SNORM, 4, true);
+
+			auto skinned = attributes;
+			skinned.append("inBoneIndices", Format::R16G16B16A16_UINT, 5);
+			skinned.append("inBoneWeights", Format::R8G8B8A8_UNORM, 6, true);
+
+			streams[static_cast<int32_t>(VertexLayout::Compressed)]         = {position, attributes};
+			streams[static_cast<int32_t>(VertexLayout::CompressedSkinned)]  = {position, skinned};
+			streams[static_cast<int32_t>(VertexLayout::CompressedPosition)] = {position};
+			return streams;
+		}();
+		return streams[static_cast<int32_t>(layout)];
+	}
+
+	auto BufferLayout::getFormatSize(Format format) -> uint32_t
+	{
+		switch (format)
+		{
+			case Format::R8_UINT:
+				return 1;
+			case Format::R32_UINT:
+			case Format::R32_INT:
+			case Format::R32_FLOAT:
+			case Format::R16G16_SNORM:
+			case Format::R16G16_FLOAT:
+			case Format::R8G8B8A8_UNORM:
+				return 4;
+			case Format::R32G32_UINT:
+			case Format::R32G32_INT:
+			case Format::R32G32_FLOAT:
+			case Format::R16G16B16A16_UNORM:
+			case Format::R16G16B16A16_UINT:
+				return 8;
+			case Format::R32G32B32_UINT:
+			case Format::R32G32B32_INT:
+			case Format::R32G32B32_FLOAT:
+				return 12;
+			case Format::R32G32B32A32_UINT:
+			case Format::R32G32B32A32_INT:
+			case Format::R32G32B32A32_FLOAT:
+				return 16;
+		}
+		return 0;
 	}
 
 	auto BufferLayout::computeStride() -> void
@@ -4,6 +4,7 @@
 #pragma once
 
 #include "DescriptorSet.h"
+#include "Definitions.h"
 #include "Engine/Core.h"
 #include "Others/Console.h"
 #include <glm/glm.hpp>
@@ -17,6 +18,7 @@ namespace maple
 		Format      format;
 		uint32_t    offset     = 0;
 		bool        normalized = false;
+		uint32_t    location   = 0;
 	};
 
 	class MAPLE_EXPORT BufferLayout
@@ -52,8 +54,14 @@ namespace maple
 
 		auto computeStride() -> void;
 
+		//the streams of a vertex layout indexed by their binding, empty for VertexLayout::Reflected
+		static auto get(VertexLayout layout) -> const std::vector<BufferLayout> &;
+		static auto getFormatSize(Format format) -> uint32_t;
+
 	  private:
 		auto push(const std::string &name, Format format, uint32_t size, uint32_t location, bool normalized) -> void;
+		//packed after the previous element
+		auto append(const std::string &name, Format format, uint32_t location, bool normalized = false) -> void;
 	};
 
 	template <>
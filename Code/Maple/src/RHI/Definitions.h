@@ -16,6 +16,7 @@ namespace maple
 	class CommandBuffer;
 	class DescriptorSet;
 	class Pipeline;
+	class StorageBuffer;
 	struct VertexInputDescription;
 	struct DescriptorLayoutInfo;
 	struct DescriptorPoolInfo;
@@ -103,6 +104,12 @@ namespace maple
 		STENCIL,
 		DEPTH_STENCIL,
 		SCREEN,
+		BC1,        //block compressed 4x4, see Texture::isCompressedFormat
+		BC3,
+		BC4,
+		BC5,
+		BC7,
+		ASTC_4x4,
 		LENGTH
 	};
 
@@ -230,17 +237,19 @@ namespace maple
 		bool flipY;
 		bool generateMipMaps;
 		bool mutableFormat;        // used in vulkan.
+		bool streamed;             // only the low mips are resident until the TextureStreamer requests more, needs generateMipMaps
 
 		constexpr TextureLoadOptions() :
 		    TextureLoadOptions(false, true, false)
 		{
 		}
 
-		constexpr TextureLoadOptions(bool flipX, bool flipY, bool genMips = false, bool mutableFormat = false) :
+		constexpr TextureLoadOptions(bool flipX, bool flipY, bool genMips = false, bool mutableFormat = false, bool streamed = false) :
 		    flipX(flipX),
 		    flipY(flipY),
 		    generateMipMaps(genMips),
-		    mutableFormat(mutableFormat)
+		    mutableFormat(mutableFormat),
+		    streamed(streamed)
 		{
 		}
 	};
@@ -318,6 +327,15 @@ namespace maple
 		Wireframe
 	};
 
+	//how the vertex streams of a pipeline are laid out, see BufferLayout::get
+	enum class VertexLayout : int32_t
+	{
+		Reflected,                //one interleaved stream, as the vertex shader reads it
+		Compressed,               //quantized position stream and packed attribute stream of a Vertex
+		CompressedSkinned,        //as Compressed, of a SkinnedVertex
+		CompressedPosition        //the position stream alone, for the depth only passes
+	};
+
 	enum class DataType : int32_t
 	{
 		Float,
@@ -359,6 +377,8 @@ namespace maple
 		uint32_t groupCountZ = 1;
 		uint32_t maxRayRecursionDepth = 2;
 		std::string pipelineName;
+
+		VertexLayout vertexLayout = VertexLayout::Reflected;
 	};
 
 	struct RenderCommand
@@ -372,6 +392,10 @@ namespace maple
 		PipelineInfo stencilPipelineInfo;
 
 		glm::mat4 transform;
+		glm::mat4 prevTransform;        //world matrix of the last frame
+
+		Pipeline *pipeline = nullptr;        //resolved from pipelineInfo while the queue is collected
+		uint64_t  sortKey  = 0;
 	};
 
 	enum MemoryBarrierFlags : int32_t
@@ -380,7 +404,25 @@ namespace maple
 		Shader_Image_Access_Barrier = BIT(1),
 		Shader_Storage_Barrier      = BIT(2),
 		Texture_Fetch_Barrier       = BIT(3),
-		General                     = BIT(4)        // mainly for Vulkan
+		General                     = BIT(4),        // mainly for Vulkan
+		Indirect_Command_Barrier    = BIT(5)         // shader writes read as draw arguments or by the host
+	};
+
+	//how a pass uses a texture, the backend maps it to an image layout
+	enum class ResourceState : uint8_t
+	{
+		Undefined,
+		ShaderRead,
+		Storage,
+		ColorAttachment,
+		DepthAttachment,
+		DepthRead
+	};
+
+	struct TextureTransition
+	{
+		Texture *     texture;
+		ResourceState state;
 	};
 }        // namespace maple
 
@@ -403,7 +445,7 @@ namespace std
 		size_t operator()(const maple::TextureLoadOptions &param) const
 		{
 			size_t seed = 0;
-			maple::HashCode::hashCode(seed, param.flipX, param.flipY, param.generateMipMaps);
+			maple::HashCode::hashCode(seed, param.flipX, param.flipY, param.generateMipMaps, param.streamed);
 			return seed;
 		}
 	};
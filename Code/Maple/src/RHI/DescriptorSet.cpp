@@ -4,11 +4,38 @@
 //////////////////////////////////////////////////////////////////////////////
 
 #include "DescriptorSet.h"
+#include "Others/Console.h"
 
 namespace maple
 {
 	static bool updateValue = true;
 
+	auto DescriptorSet::setUniform(const UniformId &id, const void *data, bool dynamic) -> void
+	{
+		if (auto handle = getUniformHandle(id); handle.isValid())
+			setUniform(handle, data, dynamic);
+		else
+			LOGW("Uniform not found {0}.{1}", id.buffer, id.member);
+	}
+
+	auto DescriptorSet::setUniform(const UniformId &id, const void *data, uint32_t size, bool dynamic) -> void
+	{
+		if (auto handle = getUniformHandle(id); handle.isValid())
+			setUniform(handle, data, size, dynamic);
+		else
+			LOGW("Uniform not found {0}.{1}", id.buffer, id.member);
+	}
+
+	auto DescriptorSet::setUniform(const std::string &bufferName, const std::string &uniformName, const void *data, bool dynamic) -> void
+	{
+		setUniform(UniformId(bufferName, uniformName), data, dynamic);
+	}
+
+	auto DescriptorSet::setUniform(const std::string &bufferName, const std::string &uniformName, const void *data, uint32_t size, bool dynamic) -> void
+	{
+		setUniform(UniformId(bufferName, uniformName), data, size, dynamic);
+	}
+
 	auto DescriptorSet::canUpdate() -> bool
 	{
 		return updateValue;
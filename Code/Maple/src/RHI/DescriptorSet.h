@@ -3,8 +3,10 @@
 //////////////////////////////////////////////////////////////////////////////
 #pragma once
 
+#include <cstdint>
 #include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 namespace maple
@@ -49,7 +51,12 @@ namespace maple
 		R32G32B32A32_FLOAT,
 		R32G32B32_FLOAT,
 		R32G32_FLOAT,
-		R32_FLOAT
+		R32_FLOAT,
+		R16G16B16A16_UNORM,
+		R16G16B16A16_UINT,
+		R16G16_SNORM,
+		R16G16_FLOAT,
+		R8G8B8A8_UNORM
 	};
 
 	enum class ShaderDataType
@@ -140,6 +147,48 @@ namespace maple
 		std::vector<BufferMemberInfo> members;
 	};
 
+	/**
+	 * A member of a uniform buffer named by "buffer.member". The name is hashed with FNV-1a
+	 * by a constexpr constructor, so ids built from literals cost nothing at the call site.
+	 */
+	struct UniformId
+	{
+		constexpr UniformId(std::string_view buffer, std::string_view member) :
+		    buffer(buffer), member(member), hash(combine(combine(combine(14695981039346656037ull, buffer), "."), member))
+		{}
+
+		std::string_view buffer;
+		std::string_view member;
+		uint64_t         hash;
+
+		static constexpr auto combine(uint64_t hash, std::string_view str) -> uint64_t
+		{
+			for (auto c : str)
+			{
+				hash ^= static_cast<uint8_t>(c);
+				hash *= 1099511628211ull;
+			}
+			return hash;
+		}
+	};
+
+	/**
+	 * A resolved uniform, valid for every descriptor set created from the same shader and layout index.
+	 */
+	struct UniformHandle
+	{
+		static constexpr uint32_t Invalid = UINT32_MAX;
+
+		uint32_t buffer = Invalid;        //index of the uniform buffer in the descriptor set
+		uint32_t offset = 0;
+		uint32_t size   = 0;
+
+		inline auto isValid() const
+		{
+			return buffer != Invalid;
+		}
+	};
+
 	class DescriptorSet
 	{
 	  public:
@@ -161,14 +210,27 @@ namespace maple
 		virtual auto setStorageBuffer(const std::string &name, const std::vector<std::shared_ptr<StorageBuffer>> &buffer) -> void                             = 0;
 		virtual auto setStorageBuffer(const std::string &name, const std::vector<std::shared_ptr<VertexBuffer>> &buffer) -> void                              = 0;
 		virtual auto setStorageBuffer(const std::string &name, const std::vector<std::shared_ptr<IndexBuffer>> &buffer) -> void                               = 0;
-		virtual auto setUniform(const std::string &bufferName, const std::string &uniformName, const void *data, bool dynamic = false) -> void                = 0;
-		virtual auto setUniform(const std::string &bufferName, const std::string &uniformName, const void *data, uint32_t size, bool dynamic = false) -> void = 0;
 		virtual auto setUniformBufferData(const std::string &bufferName, const void *data) -> void                                                            = 0;
 		virtual auto getDescriptors() const -> const std::vector<Descriptor> &                                                                                = 0;
 		virtual auto setAccelerationStructure(const std::string &name, const std::shared_ptr<AccelerationStructure> &structure) -> void                       = 0;
 		virtual auto toIntID() const -> const uint64_t                                                                                                        = 0;
 		virtual auto setName(const std::string &name) -> void                                                                                                 = 0;
 
+		/**
+		 * Resolve a uniform once, e.g. on init, and write it through the handle afterwards.
+		 * A write is a copy into the local storage which may not be larger than the member, invalid handles are ignored.
+		 */
+		virtual auto getUniformHandle(const UniformId &id) const -> UniformHandle                                  = 0;
+		virtual auto setUniform(const UniformHandle &handle, const void *data, bool dynamic = false) -> void                = 0;
+		virtual auto setUniform(const UniformHandle &handle, const void *data, uint32_t size, bool dynamic = false) -> void = 0;
+
+		auto setUniform(const UniformId &id, const void *data, bool dynamic = false) -> void;
+		auto setUniform(const UniformId &id, const void *data, uint32_t size, bool dynamic = false) -> void;
+
+		//hashes the names on every call, prefer UniformId or UniformHandle
+		auto setUniform(const std::string &bufferName, const std::string &uniformName, const void *data, bool dynamic = false) -> void;
+		auto setUniform(const std::string &bufferName, const std::string &uniformName, const void *data, uint32_t size, bool dynamic = false) -> void;
+
 		static auto canUpdate() -> bool;
 		static auto toggleUpdate(bool update) -> void;
 	};
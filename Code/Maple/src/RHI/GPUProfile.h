@@ -4,13 +4,23 @@
 #pragma once
 #include "RHI/GraphicsContext.h"
 
-#if defined(RENDER_API_VULKAN)
-#	include "RHI/Vulkan/VKCommandBuffer.h"
-#	include "RHI/Vulkan/VKDevice.h"
-#endif
+#if defined(MAPLE_VULKAN) && defined(MAPLE_PROFILE) && defined(TRACY_ENABLE)
+#	include "RHI/Vulkan/VulkanCommandBuffer.h"
+#	include "RHI/Vulkan/VulkanDevice.h"
+
+namespace maple
+{
+	//zones of the async compute queue go to their own context, so the overlap with the graphics queue is visible in tracy
+	inline auto getGPUProfileContext(const CommandBuffer *cmd) -> tracy::VkCtx *
+	{
+		auto vkCmd = static_cast<const VulkanCommandBuffer *>(cmd);
+		if (vkCmd->getCommandBuffeType() == CommandBufferType::Compute && VulkanDevice::get()->getTracyComputeContext() != nullptr)
+			return VulkanDevice::get()->getTracyComputeContext();
+		return VulkanDevice::get()->getTracyContext();
+	}
+}        // namespace maple
 
-#if defined(PROFILE_GPU) && defined(RENDER_API_VULKAN) && defined(MAPLE_PROFILE) && defined(TRACY_ENABLE)
-#	define GPUProfile(name)
+#	define GPUProfile(name, cmd) TracyVkZone(maple::getGPUProfileContext(cmd), static_cast<const maple::VulkanCommandBuffer *>(cmd)->getCommandBuffer(), name)
 #else
-#	define GPUProfile(name)
+#	define GPUProfile(name, cmd)
 #endif
@@ -37,13 +37,37 @@
 #	include "RHI/OpenGL/GLStorageBuffer.h"
 #endif
 
+#ifdef MAPLE_NULL
+#	include "RHI/ImGui/NullImGuiRenderer.h"
+#	include "RHI/Null/NullCommandBuffer.h"
+#	include "RHI/Null/NullContext.h"
+#	include "RHI/Null/NullDescriptorSet.h"
+#	include "RHI/Null/NullFrameBuffer.h"
+#	include "RHI/Null/NullIndexBuffer.h"
+#	include "RHI/Null/NullPipeline.h"
+#	include "RHI/Null/NullRenderPass.h"
+#	include "RHI/Null/NullShader.h"
+#	include "RHI/Null/NullStorageBuffer.h"
+#	include "RHI/Null/NullSwapChain.h"
+#	include "RHI/Null/NullUniformBuffer.h"
+#	include "RHI/Null/NullVertexBuffer.h"
+#endif
+
 #include "Engine/CaptureGraph.h"
 #include "Loaders/Loader.h"
 
 #include "Application.h"
 
+#include <atomic>
+
 namespace maple
 {
+	namespace
+	{
+		//microseconds the draws of this frame waited for their pipelines, they may be recorded on any worker
+		std::atomic<int64_t> pipelineWaitSpent{0};
+	}        // namespace
+
 	auto GraphicsContext::create() -> std::shared_ptr<GraphicsContext>
 	{
 #ifdef MAPLE_VULKAN
@@ -52,6 +76,9 @@ namespace maple
 #ifdef MAPLE_OPENGL
 		return std::make_shared<GLContext>();
 #endif        // MAPLE_OPENGL
+#ifdef MAPLE_NULL
+		return std::make_shared<NullContext>();
+#endif        // MAPLE_NULL
 	}
 
 	auto GraphicsContext::clearUnused() -> void
@@ -88,6 +115,9 @@ namespace maple
 #endif
 #ifdef MAPLE_OPENGL
 		return std::make_shared<GLSwapChain>(width, height);
+#endif
+#ifdef MAPLE_NULL
+		return std::make_shared<NullSwapChain>(width, height);
 #endif
 	}
 
@@ -100,6 +130,10 @@ namespace maple
 #ifdef MAPLE_OPENGL
 		return Application::getAssetsLoaderFactory()->emplace<GLShader>(filePath, filePath);
 #endif
+
+#ifdef MAPLE_NULL
+		return Application::getAssetsLoaderFactory()->emplace<NullShader>(filePath, filePath, size);
+#endif
 	}
 
 	auto Shader::create(const std::vector<uint32_t> &vertData, const std::vector<uint32_t> &fragData) -> std::shared_ptr<Shader>
@@ -109,6 +143,9 @@ namespace maple
 #endif
 #ifdef MAPLE_OPENGL
 		return std::make_shared<GLShader>(vertData, fragData);
+#endif
+#ifdef MAPLE_NULL
+		return std::make_shared<NullShader>(vertData, fragData);
 #endif
 	}
 
@@ -140,6 +177,10 @@ namespace maple
 #ifdef MAPLE_OPENGL
 		std::shared_ptr<FrameBuffer> fb = std::make_shared<GLFrameBuffer>(desc);
 		return frameBufferCache.emplace(std::piecewise_construct, std::forward_as_tuple(hash), std::forward_as_tuple(fb, Application::getTimer().currentTimestamp())).first->second.asset;
+#endif
+#ifdef MAPLE_NULL
+		std::shared_ptr<FrameBuffer> fb = std::make_shared<NullFrameBuffer>(desc);
+		return frameBufferCache.emplace(std::piecewise_construct, std::forward_as_tuple(hash), std::forward_as_tuple(fb, Application::getTimer().currentTimestamp())).first->second.asset;
 #endif
 	}
 
@@ -150,6 +191,9 @@ namespace maple
 #endif
 #ifdef MAPLE_OPENGL
 		return std::make_shared<GLDescriptorSet>(desc);
+#endif
+#ifdef MAPLE_NULL
+		return std::make_shared<NullDescriptorSet>(desc);
 #endif
 	}
 
@@ -160,6 +204,9 @@ namespace maple
 #endif
 #ifdef MAPLE_OPENGL
 		return std::make_shared<GLCommandBuffer>();
+#endif
+#ifdef MAPLE_NULL
+		return std::make_shared<NullCommandBuffer>(cmdType);
 #endif
 	}
 
@@ -170,6 +217,9 @@ namespace maple
 #endif
 #ifdef MAPLE_OPENGL
 		return std::make_shared<GLImGuiRenderer>(width, height, clearScreen);
+#endif
+#ifdef MAPLE_NULL
+		return std::make_shared<NullImGuiRenderer>(width, height, clearScreen);
 #endif
 	}
 
@@ -180,6 +230,9 @@ namespace maple
 #endif
 #ifdef MAPLE_OPENGL
 		return std::make_shared<GLIndexBuffer>(data, count, bufferUsage);
+#endif
+#ifdef MAPLE_NULL
+		return std::make_shared<NullIndexBuffer>(data, count, bufferUsage);
 #endif
 	}
 	auto IndexBuffer::create(const uint32_t *data, uint32_t count, BufferUsage bufferUsage) -> std::shared_ptr<IndexBuffer>
@@ -189,6 +242,9 @@ namespace maple
 #endif
 #ifdef MAPLE_OPENGL
 		return std::make_shared<GLIndexBuffer>(data, count, bufferUsage);
+#endif
+#ifdef MAPLE_NULL
+		return std::make_shared<NullIndexBuffer>(data, count, bufferUsage);
 #endif
 	}
 
@@ -219,6 +275,7 @@ namespace maple
 		HashCode::hashCode(hash, desc.depthArrayTarget);
 		HashCode::hashCode(hash, desc.swapChainTarget);
 		HashCode::hashCode(hash, desc.groupCountX, desc.groupCountY, desc.groupCountZ);
+		HashCode::hashCode(hash, desc.vertexLayout);
 
 		if (desc.swapChainTarget)
 		{
@@ -249,6 +306,11 @@ namespace maple
 		return pipelineCache.emplace(std::piecewise_construct, std::forward_as_tuple(hash), std::forward_as_tuple(pipeline, Application::getTimer().currentTimestamp())).first->second.asset;
 #endif        // MAPLE_OPENGL
 
+#ifdef MAPLE_NULL
+		std::shared_ptr<Pipeline> pipeline = std::make_shared<NullPipeline>(desc);
+		return pipelineCache.emplace(std::piecewise_construct, std::forward_as_tuple(hash), std::forward_as_tuple(pipeline, Application::getTimer().currentTimestamp())).first->second.asset;
+#endif        // MAPLE_NULL
+
 #ifdef MAPLE_VULKAN
 		std::shared_ptr<Pipeline> pipeline;
 		if (desc.shader->isComputeShader())
@@ -261,12 +323,60 @@ namespace maple
 		}
 		else
 		{
-			pipeline = std::make_shared<VulkanPipeline>(desc);
+			pipeline = std::make_shared<VulkanPipeline>(desc, getCompileSettings().async);
 		}
 		return pipelineCache.emplace(std::piecewise_construct, std::forward_as_tuple(hash), std::forward_as_tuple(pipeline, Application::getTimer().currentTimestamp())).first->second.asset;
 #endif        // MAPLE_OPENGL
 	}
 
+	auto Pipeline::request(const PipelineInfo &desc, const PipelineInfo *fallback) -> std::shared_ptr<Pipeline>
+	{
+		auto pipeline = get(desc);
+		if (pipeline->isReady())
+			return pipeline;
+
+		auto &settings = getCompileSettings();
+		switch (settings.policy)
+		{
+			case PipelineMissPolicy::Wait:
+			{
+				//the budget is shared by every miss of the frame, once it is spent the misses are skipped
+				const auto left = settings.waitBudget * 1000.f - pipelineWaitSpent.load(std::memory_order_relaxed);
+				if (left <= 0.f)
+					return nullptr;
+
+				auto &timer = Application::getTimer();
+				auto  begin = timer.current();
+				auto  ready = pipeline->waitReady(left / 1000.f);
+				pipelineWaitSpent.fetch_add(timer.elapsed(begin, timer.current()), std::memory_order_relaxed);
+				return ready ? pipeline : nullptr;
+			}
+			case PipelineMissPolicy::Fallback:
+				//the fallback is waited for, it is expected to be compiled once and shared by many permutations
+				return fallback != nullptr ? get(*fallback) : nullptr;
+			default:
+				return nullptr;
+		}
+	}
+
+	auto Pipeline::newFrame() -> void
+	{
+		pipelineWaitSpent.store(0, std::memory_order_relaxed);
+	}
+
+	auto Pipeline::prewarm() -> void
+	{
+#ifdef MAPLE_VULKAN
+		VulkanPipeline::prewarm();
+#endif
+	}
+
+	auto Pipeline::getCompileSettings() -> PipelineCompileSettings &
+	{
+		static PipelineCompileSettings settings;
+		return settings;
+	}
+
 	auto Pipeline::get(const PipelineInfo &desc, const std::vector<std::shared_ptr<DescriptorSet>> &sets, capture_graph::component::RenderGraph &graph) -> std::shared_ptr<Pipeline>
 	{
 		auto pip = Pipeline::get(desc);
@@ -301,6 +411,9 @@ namespace maple
 #endif
 #ifdef MAPLE_OPENGL
 		return std::make_shared<GLRenderPass>(desc);
+#endif
+#ifdef MAPLE_NULL
+		return std::make_shared<NullRenderPass>(desc);
 #endif
 	}
 
@@ -311,6 +424,9 @@ namespace maple
 #endif
 #ifdef MAPLE_OPENGL
 		return std::make_shared<GLUniformBuffer>();
+#endif
+#ifdef MAPLE_NULL
+		return std::make_shared<NullUniformBuffer>();
 #endif
 	}
 
@@ -321,6 +437,9 @@ namespace maple
 #endif
 #ifdef MAPLE_OPENGL
 		auto buffer = std::make_shared<GLUniformBuffer>();
+#endif
+#ifdef MAPLE_NULL
+		auto buffer = std::make_shared<NullUniformBuffer>();
 #endif
 		buffer->setData(size, data);
 		return buffer;
@@ -333,6 +452,9 @@ namespace maple
 #endif
 #ifdef MAPLE_OPENGL
 		return std::make_shared<GLVertexBuffer>(usage);
+#endif
+#ifdef MAPLE_NULL
+		return std::make_shared<NullVertexBuffer>(usage);
 #endif
 	}
 
@@ -343,6 +465,9 @@ namespace maple
 #endif
 #ifdef MAPLE_OPENGL
 		return std::make_shared<GLVertexBuffer>(data, size);
+#endif
+#ifdef MAPLE_NULL
+		return std::make_shared<NullVertexBuffer>(data, size);
 #endif
 	}
 
@@ -353,6 +478,9 @@ namespace maple
 #endif
 #ifdef MAPLE_OPENGL
 		return std::make_shared<GLStorageBuffer>();
+#endif
+#ifdef MAPLE_NULL
+		return std::make_shared<NullStorageBuffer>(options);
 #endif
 	}
 
@@ -363,6 +491,9 @@ namespace maple
 #endif
 #ifdef MAPLE_OPENGL
 		return std::make_shared<GLStorageBuffer>(size, nullptr);
+#endif
+#ifdef MAPLE_NULL
+		return std::make_shared<NullStorageBuffer>(size, flags, options);
 #endif
 	}
 
@@ -373,6 +504,9 @@ namespace maple
 #endif
 #ifdef MAPLE_OPENGL
 		return std::make_shared<GLStorageBuffer>(size, data);
+#endif
+#ifdef MAPLE_NULL
+		return std::make_shared<NullStorageBuffer>(size, data, options);
 #endif
 	}
 }        // namespace maple
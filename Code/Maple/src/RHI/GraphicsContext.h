@@ -58,6 +58,9 @@ namespace maple
 		virtual auto getGPUMemoryUsed() -> float                          = 0;
 		virtual auto getTotalGPUMemory() -> float                         = 0;
 
+		//write the caches which speed up the next start, called once on shutdown
+		virtual auto saveCaches() -> void{};
+
 		inline auto getSwapChain() -> std::shared_ptr<SwapChain>
 		{
 			MAPLE_ASSERT(swapChain != nullptr, "SwapChain must be initialized");
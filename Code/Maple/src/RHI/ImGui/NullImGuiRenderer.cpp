@@ -0,0 +1,57 @@
+#include "NullImGuiRenderer.h"
+#include "RHI/Null/NullContext.h"
+#include "RHI/Texture.h"
+#include <imgui.h>
+
+namespace maple
+{
+	NullImGuiRenderer::NullImGuiRenderer(uint32_t width, uint32_t height, bool clearScreen) :
+	    width(width), height(height)
+	{
+	}
+
+	auto NullImGuiRenderer::init() -> void
+	{
+		rebuildFontTexture();
+	}
+
+	auto NullImGuiRenderer::newFrame(const Timestep &dt) -> void
+	{
+		ImGuiIO &io    = ImGui::GetIO();
+		io.DisplaySize = ImVec2(static_cast<float>(width), static_cast<float>(height));
+		io.DeltaTime   = dt.getMilliseconds();
+		ImGui::NewFrame();
+	}
+
+	auto NullImGuiRenderer::render(CommandBuffer *commandBuffer) -> void
+	{
+		auto drawData = ImGui::GetDrawData();
+		if (drawData == nullptr)
+			return;
+
+		for (int32_t i = 0; i < drawData->CmdListsCount; i++)
+		{
+			auto cmdList = drawData->CmdLists[i];
+			NullContext::count(NullCounter::DrawCalls, cmdList->CmdBuffer.Size);
+			NullContext::count(NullCounter::Indices, cmdList->IdxBuffer.Size);
+			NullContext::count(NullCounter::BytesUploaded, cmdList->VtxBuffer.Size * sizeof(ImDrawVert) + cmdList->IdxBuffer.Size * sizeof(ImDrawIdx));
+		}
+	}
+
+	auto NullImGuiRenderer::onResize(uint32_t width, uint32_t height) -> void
+	{
+		this->width  = width;
+		this->height = height;
+	}
+
+	auto NullImGuiRenderer::rebuildFontTexture() -> void
+	{
+		ImGuiIO &io     = ImGui::GetIO();
+		uint8_t *pixels = nullptr;
+		int32_t  width  = 0;
+		int32_t  height = 0;
+		io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+		fontTexture = Texture2D::create(width, height, pixels);
+		io.Fonts->TexID = (ImTextureID) fontTexture->getHandle();
+	}
+}        // namespace maple
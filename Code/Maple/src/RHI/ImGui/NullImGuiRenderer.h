@@ -0,0 +1,28 @@
+#pragma once
+
+#include "RHI/ImGuiRenderer.h"
+#include <memory>
+
+namespace maple
+{
+	class Texture2D;
+
+	//builds the ImGui frames like the other renderers, so the ui cost is part of the measured frame, but draws nothing
+	class NullImGuiRenderer : public ImGuiRenderer
+	{
+	  public:
+		NullImGuiRenderer(uint32_t width, uint32_t height, bool clearScreen);
+
+		auto init() -> void override;
+		auto newFrame(const Timestep &dt) -> void override;
+		auto render(CommandBuffer *commandBuffer) -> void override;
+		auto onResize(uint32_t width, uint32_t height) -> void override;
+		auto rebuildFontTexture() -> void override;
+
+	  private:
+		std::shared_ptr<Texture2D> fontTexture;
+
+		uint32_t width  = 0;
+		uint32_t height = 0;
+	};
+}        // namespace maple
@@ -0,0 +1,119 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "NullCommandBuffer.h"
+#include "Engine/Profiler.h"
+#include "NullContext.h"
+#include "RHI/Pipeline.h"
+
+namespace maple
+{
+	NullCommandBuffer::NullCommandBuffer(CommandBufferType cmdType) :
+	    cmdType(cmdType)
+	{
+	}
+
+	auto NullCommandBuffer::init(bool primary) -> bool
+	{
+		this->primary = primary;
+		return true;
+	}
+
+	auto NullCommandBuffer::beginRecording() -> void
+	{
+		PROFILE_FUNCTION();
+		NullContext::validate(primary, "beginRecording() called from a secondary command buffer");
+		NullContext::validate(!recording, "Command buffer begins recording twice");
+
+		recording        = true;
+		insideRenderPass = false;
+		indexedBound     = false;
+		currentPipeline  = nullptr;
+
+		for (auto &task : tasks)
+		{
+			task(this);
+		}
+		tasks.clear();
+	}
+
+	auto NullCommandBuffer::beginRecordingSecondary(RenderPass *renderPass, FrameBuffer *framebuffer) -> void
+	{
+		PROFILE_FUNCTION();
+		NullContext::validate(!primary, "beginRecordingSecondary() called from a primary command buffer");
+		NullContext::validate(renderPass != nullptr, "Secondary command buffer begins without a render pass");
+
+		//a secondary buffer continues the render pass of its primary buffer
+		recording        = true;
+		insideRenderPass = true;
+		indexedBound     = false;
+		currentPipeline  = nullptr;
+	}
+
+	auto NullCommandBuffer::endRecording() -> void
+	{
+		PROFILE_FUNCTION();
+		NullContext::validate(recording, "Command buffer ended before it started recording");
+
+		if (boundPipeline)
+			boundPipeline->end(this);
+		boundPipeline = nullptr;
+
+		if (primary)
+			NullContext::validate(!insideRenderPass, "Command buffer ended inside a render pass");
+
+		recording        = false;
+		insideRenderPass = false;
+		currentPipeline  = nullptr;
+	}
+
+	auto NullCommandBuffer::executeSecondary(const CommandBuffer *primaryCmdBuffer) -> void
+	{
+		PROFILE_FUNCTION();
+		NullContext::validate(!primary, "executeSecondary() called from a primary command buffer");
+		NullContext::validate(!recording, "Secondary command buffer executed while it is recording");
+
+		auto cmd = static_cast<const NullCommandBuffer *>(primaryCmdBuffer);
+		NullContext::validate(cmd != nullptr && cmd->isRecording(), "Secondary command buffer executed in a primary buffer which is not recording");
+		NullContext::validate(cmd != nullptr && cmd->isInsideRenderPass(), "Secondary command buffer executed outside of a render pass");
+	}
+
+	auto NullCommandBuffer::bindPipeline(Pipeline *pipeline) -> void
+	{
+		if (pipeline != boundPipeline)
+		{
+			if (boundPipeline)
+				boundPipeline->end(this);
+
+			pipeline->bind(this);
+			boundPipeline = pipeline;
+		}
+	}
+
+	auto NullCommandBuffer::unbindPipeline() -> void
+	{
+		if (boundPipeline)
+			boundPipeline->end(this);
+		boundPipeline = nullptr;
+	}
+
+	auto NullCommandBuffer::addTask(const std::function<void(const CommandBuffer *command)> &task) -> void
+	{
+		tasks.emplace_back(task);
+	}
+
+	auto NullCommandBuffer::beginRenderPass() const -> void
+	{
+		NullContext::validate(recording, "Render pass begins in a command buffer which is not recording");
+		NullContext::validate(!insideRenderPass, "Render pass begins inside another render pass");
+		NullContext::count(NullCounter::RenderPasses);
+		insideRenderPass = true;
+	}
+
+	auto NullCommandBuffer::endRenderPass() const -> void
+	{
+		NullContext::validate(insideRenderPass, "Render pass ends without being begun");
+		insideRenderPass = false;
+	}
+}        // namespace maple
@@ -0,0 +1,96 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "RHI/CommandBuffer.h"
+#include <vector>
+
+namespace maple
+{
+	/**
+	 * Records the state the commands depend on instead of commands. The RHI passes command buffers as const
+	 * while recording, so the recorded state is mutable.
+	 */
+	class NullCommandBuffer : public CommandBuffer
+	{
+	  public:
+		NullCommandBuffer(CommandBufferType cmdType = CommandBufferType::Graphics);
+		~NullCommandBuffer() = default;
+
+		auto init(bool primary) -> bool override;
+		auto unload() -> void override{};
+		auto beginRecording() -> void override;
+		auto beginRecordingSecondary(RenderPass *renderPass, FrameBuffer *framebuffer) -> void override;
+		auto endRecording() -> void override;
+		auto executeSecondary(const CommandBuffer *primaryCmdBuffer) -> void override;
+		auto updateViewport(uint32_t width, uint32_t height) const -> void override{};
+		auto bindPipeline(Pipeline *pipeline) -> void override;
+		auto unbindPipeline() -> void override;
+		auto addTask(const std::function<void(const CommandBuffer *command)> &task) -> void override;
+
+		inline auto isRecording() const -> bool override
+		{
+			return recording;
+		}
+
+		auto beginRenderPass() const -> void;
+		auto endRenderPass() const -> void;
+
+		inline auto isInsideRenderPass() const
+		{
+			return insideRenderPass;
+		}
+
+		inline auto setPipeline(Pipeline *pipeline) const
+		{
+			currentPipeline = pipeline;
+		}
+
+		//the pipeline the next draw or dispatch runs with
+		inline auto getPipeline() const
+		{
+			return currentPipeline;
+		}
+
+		inline auto setIndexCount(uint32_t count) const
+		{
+			indexCount   = count;
+			indexedBound = true;
+		}
+
+		inline auto getIndexCount() const
+		{
+			return indexCount;
+		}
+
+		inline auto isIndexBufferBound() const
+		{
+			return indexedBound;
+		}
+
+		inline auto isPrimary() const
+		{
+			return primary;
+		}
+
+		inline auto getCommandBufferType() const
+		{
+			return cmdType;
+		}
+
+	  private:
+		CommandBufferType cmdType;
+		Pipeline *        boundPipeline = nullptr;        //bound through bindPipeline, ended by endRecording
+		bool              primary       = true;
+		bool              recording     = false;
+
+		mutable Pipeline *currentPipeline  = nullptr;
+		mutable uint32_t  indexCount       = 0;
+		mutable bool      indexedBound     = false;
+		mutable bool      insideRenderPass = false;
+
+		std::vector<std::function<void(const CommandBuffer *)>> tasks;
+	};
+}        // namespace maple
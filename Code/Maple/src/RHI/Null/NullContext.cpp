@@ -0,0 +1,107 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "NullContext.h"
+#include "Application.h"
+#include "RHI/SwapChain.h"
+#include <imgui/imgui.h>
+
+namespace maple
+{
+	namespace
+	{
+		//errors are still counted after this, only the log is quiet
+		constexpr uint64_t MaxReportedErrors = 64;
+
+		std::atomic<uint64_t> reportedErrors{0};
+	}        // namespace
+
+	NullContext::NullContext()
+	{
+	}
+
+	NullContext::~NullContext()
+	{
+		if (frameCount == 0)
+			return;
+
+		LOGI("Null backend : {0} frames", frameCount);
+		for (uint32_t i = 0; i < total.size(); i++)
+		{
+			LOGI("{0} : {1} total, {2} per frame", getCounterName(static_cast<NullCounter>(i)), total[i], total[i] / frameCount);
+		}
+	}
+
+	auto NullContext::get() -> NullContext *
+	{
+		return static_cast<NullContext *>(Application::getGraphicsContext().get());
+	}
+
+	auto NullContext::init() -> void
+	{
+		auto &window = Application::getWindow();
+		swapChain    = SwapChain::create(window->getWidth(), window->getHeight());
+		swapChain->init(false, window.get());
+	}
+
+	auto NullContext::onImGui() -> void
+	{
+		for (uint32_t i = 0; i < lastFrame.size(); i++)
+		{
+			ImGui::Text("%s : %llu", getCounterName(static_cast<NullCounter>(i)), static_cast<unsigned long long>(lastFrame[i]));
+		}
+	}
+
+	auto NullContext::count(NullCounter counter, uint64_t value) -> void
+	{
+		get()->counters[static_cast<uint32_t>(counter)].fetch_add(value, std::memory_order_relaxed);
+	}
+
+	auto NullContext::reportError() -> bool
+	{
+		count(NullCounter::ValidationErrors);
+		return reportedErrors.fetch_add(1, std::memory_order_relaxed) < MaxReportedErrors;
+	}
+
+	auto NullContext::endFrame() -> void
+	{
+		for (uint32_t i = 0; i < counters.size(); i++)
+		{
+			lastFrame[i] = counters[i].exchange(0, std::memory_order_relaxed);
+			total[i] += lastFrame[i];
+		}
+		frameCount++;
+	}
+
+	auto NullContext::getCounterName(NullCounter counter) -> const char *
+	{
+		switch (counter)
+		{
+			case NullCounter::DrawCalls:
+				return "Draw calls";
+			case NullCounter::Indices:
+				return "Indices";
+			case NullCounter::Instances:
+				return "Instances";
+			case NullCounter::Dispatches:
+				return "Dispatches";
+			case NullCounter::PipelineBinds:
+				return "Pipeline binds";
+			case NullCounter::DescriptorBinds:
+				return "Descriptor set binds";
+			case NullCounter::DescriptorUpdates:
+				return "Descriptor set updates";
+			case NullCounter::RenderPasses:
+				return "Render passes";
+			case NullCounter::Barriers:
+				return "Barriers";
+			case NullCounter::BytesUploaded:
+				return "Bytes uploaded";
+			case NullCounter::ValidationErrors:
+				return "Validation errors";
+			default:
+				return "Unknown";
+		}
+	}
+}        // namespace maple
@@ -0,0 +1,107 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Others/Console.h"
+#include "RHI/GraphicsContext.h"
+
+#include <array>
+#include <atomic>
+
+namespace maple
+{
+	enum class NullCounter : uint32_t
+	{
+		DrawCalls,
+		Indices,        //vertices for the non indexed draws
+		Instances,
+		Dispatches,
+		PipelineBinds,
+		DescriptorBinds,
+		DescriptorUpdates,
+		RenderPasses,
+		Barriers,
+		BytesUploaded,
+		ValidationErrors,
+		Length
+	};
+
+	using NullFrameStats = std::array<uint64_t, static_cast<uint32_t>(NullCounter::Length)>;
+
+	/**
+	 * Graphics context of the headless backend. Nothing reaches a GPU, the command buffers, pipelines, buffers and
+	 * textures count what they record here and validate the order of the commands. The CPU side of a frame can be
+	 * benchmarked and regression tested on machines without a GPU or a display.
+	 */
+	class MAPLE_EXPORT NullContext : public GraphicsContext
+	{
+	  public:
+		NullContext();
+		~NullContext();
+
+		static auto get() -> NullContext *;
+
+		auto init() -> void override;
+		auto present() -> void override{};
+		auto waitIdle() const -> void override{};
+		auto onImGui() -> void override;
+
+		inline auto getGPUMemoryUsed() -> float override
+		{
+			return 0.f;
+		};
+
+		inline auto getTotalGPUMemory() -> float override
+		{
+			return 0.f;
+		};
+
+		inline auto getMinUniformBufferOffsetAlignment() const -> size_t override
+		{
+			return 256;
+		}
+
+		//thread safe, command buffers are recorded on the job system
+		static auto count(NullCounter counter, uint64_t value = 1) -> void;
+
+		//counts a failed check as a validation error and logs the first ones, returns the condition
+		template <typename... Args>
+		static auto validate(bool condition, const char *message, Args &&...args) -> bool
+		{
+			if (!condition && reportError())
+				LOGW(message, std::forward<Args>(args)...);
+			return condition;
+		}
+
+		//called by the render device once the frame is presented
+		auto endFrame() -> void;
+
+		static auto getCounterName(NullCounter counter) -> const char *;
+
+		inline auto &getLastFrame() const
+		{
+			return lastFrame;
+		}
+
+		inline auto &getTotal() const
+		{
+			return total;
+		}
+
+		inline auto getFrameCount() const
+		{
+			return frameCount;
+		}
+
+	  private:
+		static auto reportError() -> bool;
+
+		std::array<std::atomic<uint64_t>, static_cast<uint32_t>(NullCounter::Length)> counters = {};
+
+		NullFrameStats lastFrame  = {};
+		NullFrameStats total      = {};
+		uint64_t       frameCount = 0;
+	};
+}        // namespace maple
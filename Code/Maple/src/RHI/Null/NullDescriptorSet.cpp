@@ -0,0 +1,246 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "NullDescriptorSet.h"
+#include "NullContext.h"
+
+#include "Engine/Core.h"
+#include "Engine/Profiler.h"
+#include "Others/Console.h"
+#include "RHI/Shader.h"
+#include "RHI/Texture.h"
+#include "RHI/UniformBuffer.h"
+
+#include <algorithm>
+
+namespace maple
+{
+	NullDescriptorSet::NullDescriptorSet(const DescriptorInfo &descriptorDesc)
+	{
+		shader      = descriptorDesc.shader;
+		descriptors = shader->getDescriptorInfo(descriptorDesc.layoutIndex);
+		name        = shader->getName() + ":" + std::to_string(descriptorDesc.layoutIndex);
+
+		for (auto &descriptor : descriptors)
+		{
+			if (descriptor.type == DescriptorType::UniformBuffer)
+			{
+				auto buffer = UniformBuffer::create();
+				buffer->init(descriptor.size, nullptr);
+				descriptor.buffer = buffer;
+
+				Buffer localStorage;
+				localStorage.allocate(descriptor.size);
+				localStorage.initializeEmpty();
+
+				UniformBufferInfo info;
+				info.name          = descriptor.name;
+				info.uniformBuffer = buffer;
+				info.localStorage  = localStorage;
+				info.dirty         = false;
+				info.members       = descriptor.members;
+
+				const auto index = static_cast<uint32_t>(uniformBuffers.size());
+				for (auto &member : info.members)
+				{
+					if (!uniformHandles.emplace(UniformId(descriptor.name, member.name).hash, UniformHandle{index, member.offset, member.size}).second)
+						LOGW("Uniform {0}.{1} is declared twice or its name hash collides", descriptor.name, member.name);
+				}
+				uniformBuffers.emplace_back(std::move(info));
+			}
+		}
+	}
+
+	auto NullDescriptorSet::update(const CommandBuffer *cmd) -> void
+	{
+		PROFILE_FUNCTION();
+		NullContext::count(NullCounter::DescriptorUpdates);
+
+		for (auto &bufferInfo : uniformBuffers)
+		{
+			if (bufferInfo.dirty)
+			{
+				bufferInfo.uniformBuffer->setData(bufferInfo.localStorage.data);
+				bufferInfo.dirty = false;
+			}
+		}
+		updated = true;
+	}
+
+	auto NullDescriptorSet::validate() const -> void
+	{
+		NullContext::validate(updated, "Descriptor set {0} is bound before its first update", name);
+
+		for (auto &descriptor : descriptors)
+		{
+			switch (descriptor.type)
+			{
+				case DescriptorType::ImageSampler:
+				case DescriptorType::Image:
+				{
+					auto empty = std::find(descriptor.textures.begin(), descriptor.textures.end(), nullptr) != descriptor.textures.end();
+					NullContext::validate(!descriptor.textures.empty() && !empty, "Texture {0} of descriptor set {1} is not set", descriptor.name, name);
+					break;
+				}
+				case DescriptorType::Buffer:
+				case DescriptorType::AccelerationStructure:
+					NullContext::validate(boundBuffers.count(descriptor.name) > 0, "Buffer {0} of descriptor set {1} is not set", descriptor.name, name);
+					break;
+				default:
+					break;
+			}
+		}
+	}
+
+	auto NullDescriptorSet::setTexture(const std::string &name, const std::vector<std::shared_ptr<Texture>> &textures, int32_t mipLevel) -> void
+	{
+		PROFILE_FUNCTION();
+		for (auto &descriptor : descriptors)
+		{
+			if ((descriptor.type == DescriptorType::ImageSampler ||
+			     descriptor.type == DescriptorType::Image) &&
+			    descriptor.name == name)
+			{
+				descriptor.textures    = textures;
+				descriptor.mipmapLevel = mipLevel;
+				return;
+			}
+		}
+		LOGW("Texture not found {0}", name);
+	}
+
+	auto NullDescriptorSet::setTexture(const std::string &name, const std::shared_ptr<Texture> &texture, int32_t mipLevel) -> void
+	{
+		setTexture(name, std::vector<std::shared_ptr<Texture>>{texture}, mipLevel);
+	}
+
+	auto NullDescriptorSet::setBuffer(const std::string &name, const std::shared_ptr<UniformBuffer> &buffer) -> void
+	{
+		PROFILE_FUNCTION();
+		for (auto &descriptor : descriptors)
+		{
+			if (descriptor.type == DescriptorType::UniformBuffer && descriptor.name == name)
+			{
+				descriptor.buffer = buffer;
+				return;
+			}
+		}
+
+		LOGW("Buffer not found {0}", name);
+	}
+
+	auto NullDescriptorSet::getUniformHandle(const UniformId &id) const -> UniformHandle
+	{
+		if (auto iter = uniformHandles.find(id.hash); iter != uniformHandles.end())
+			return iter->second;
+		return {};
+	}
+
+	auto NullDescriptorSet::setUniform(const UniformHandle &handle, const void *data, bool dynamic) -> void
+	{
+		setUniform(handle, data, handle.size, dynamic);
+	}
+
+	auto NullDescriptorSet::setUniform(const UniformHandle &handle, const void *data, uint32_t size, bool dynamic) -> void
+	{
+		if (handle.buffer >= uniformBuffers.size())
+			return;
+
+		//a write larger than the member would overwrite the ones after it
+		auto &bufferInfo = uniformBuffers[handle.buffer];
+		if (!NullContext::validate(size <= handle.size && handle.offset + size <= bufferInfo.localStorage.getSize(),
+		                           "Uniform write out of range in {0}, offset {1} size {2} member size {3}", bufferInfo.name, handle.offset, size, handle.size))
+			return;
+
+		bufferInfo.localStorage.write(data, size, handle.offset);
+		bufferInfo.dirty = true;
+	}
+
+	auto NullDescriptorSet::setUniformBufferData(const std::string &bufferName, const void *data) -> void
+	{
+		PROFILE_FUNCTION();
+		for (auto &bufferInfo : uniformBuffers)
+		{
+			if (bufferInfo.name == bufferName)
+			{
+				bufferInfo.localStorage.write(data, bufferInfo.localStorage.getSize(), 0);
+				bufferInfo.dirty = true;
+				return;
+			}
+		}
+
+		LOGW("Uniform not found {0}.", bufferName);
+	}
+
+	auto NullDescriptorSet::getUnifromBuffer(const std::string &name) -> std::shared_ptr<UniformBuffer>
+	{
+		PROFILE_FUNCTION();
+		for (auto &descriptor : descriptors)
+		{
+			if (descriptor.type == DescriptorType::UniformBuffer && descriptor.name == name)
+			{
+				return descriptor.buffer;
+			}
+		}
+
+		LOGW("Buffer not found {0}", name);
+		return nullptr;
+	}
+
+	auto NullDescriptorSet::setBufferBound(const std::string &name) -> void
+	{
+		for (auto &descriptor : descriptors)
+		{
+			if ((descriptor.type == DescriptorType::Buffer || descriptor.type == DescriptorType::AccelerationStructure) && descriptor.name == name)
+			{
+				boundBuffers.emplace(name);
+				return;
+			}
+		}
+
+		LOGW("Buffer not found {0}", name);
+	}
+
+	auto NullDescriptorSet::setStorageBuffer(const std::string &name, std::shared_ptr<StorageBuffer> buffer) -> void
+	{
+		if (buffer != nullptr)
+			setBufferBound(name);
+	}
+
+	auto NullDescriptorSet::setStorageBuffer(const std::string &name, std::shared_ptr<VertexBuffer> buffer) -> void
+	{
+		if (buffer != nullptr)
+			setBufferBound(name);
+	}
+
+	auto NullDescriptorSet::setStorageBuffer(const std::string &name, std::shared_ptr<IndexBuffer> buffer) -> void
+	{
+		if (buffer != nullptr)
+			setBufferBound(name);
+	}
+
+	auto NullDescriptorSet::setStorageBuffer(const std::string &name, const std::vector<std::shared_ptr<StorageBuffer>> &buffer) -> void
+	{
+		if (!buffer.empty())
+			setBufferBound(name);
+	}
+
+	auto NullDescriptorSet::setStorageBuffer(const std::string &name, const std::vector<std::shared_ptr<VertexBuffer>> &buffer) -> void
+	{
+		if (!buffer.empty())
+			setBufferBound(name);
+	}
+
+	auto NullDescriptorSet::setStorageBuffer(const std::string &name, const std::vector<std::shared_ptr<IndexBuffer>> &buffer) -> void
+	{
+		if (!buffer.empty())
+			setBufferBound(name);
+	}
+
+	auto NullDescriptorSet::setAccelerationStructure(const std::string &name, const std::shared_ptr<AccelerationStructure> &structure) -> void
+	{
+		if (structure != nullptr)
+			setBufferBound(name);
+	}
+}        // namespace maple
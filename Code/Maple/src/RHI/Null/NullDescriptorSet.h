@@ -0,0 +1,95 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Engine/Buffer.h"
+#include "RHI/DescriptorSet.h"
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace maple
+{
+	class NullDescriptorSet : public DescriptorSet
+	{
+	  public:
+		NullDescriptorSet(const DescriptorInfo &descriptorDesc);
+
+		auto update(const CommandBuffer *cmd) -> void override;
+		auto setTexture(const std::string &name, const std::vector<std::shared_ptr<Texture>> &textures, int32_t mipLevel = -1) -> void override;
+		auto setTexture(const std::string &name, const std::shared_ptr<Texture> &textures, int32_t mipLevel = -1) -> void override;
+		auto setBuffer(const std::string &name, const std::shared_ptr<UniformBuffer> &buffer) -> void override;
+		using DescriptorSet::setUniform;
+		auto getUniformHandle(const UniformId &id) const -> UniformHandle override;
+		auto setUniform(const UniformHandle &handle, const void *data, bool dynamic) -> void override;
+		auto setUniform(const UniformHandle &handle, const void *data, uint32_t size, bool dynamic) -> void override;
+		auto setUniformBufferData(const std::string &bufferName, const void *data) -> void override;
+		auto getUnifromBuffer(const std::string &name) -> std::shared_ptr<UniformBuffer> override;
+
+		auto setStorageBuffer(const std::string &name, std::shared_ptr<StorageBuffer> buffer) -> void override;
+		auto setStorageBuffer(const std::string &name, std::shared_ptr<VertexBuffer> buffer) -> void override;
+		auto setStorageBuffer(const std::string &name, std::shared_ptr<IndexBuffer> buffer) -> void override;
+		auto setStorageBuffer(const std::string &name, const std::vector<std::shared_ptr<StorageBuffer>> &buffer) -> void override;
+		auto setStorageBuffer(const std::string &name, const std::vector<std::shared_ptr<VertexBuffer>> &buffer) -> void override;
+		auto setStorageBuffer(const std::string &name, const std::vector<std::shared_ptr<IndexBuffer>> &buffer) -> void override;
+		auto setAccelerationStructure(const std::string &name, const std::shared_ptr<AccelerationStructure> &structure) -> void override;
+
+		//checks what a bind of the set reads: the set was updated and every texture and buffer was provided
+		auto validate() const -> void;
+
+		inline auto setDynamicOffset(uint32_t offset) -> void override
+		{
+			dynamicOffset = offset;
+		}
+
+		inline auto getDynamicOffset() const -> uint32_t override
+		{
+			return dynamicOffset;
+		}
+
+		inline auto getDescriptors() const -> const std::vector<Descriptor> & override
+		{
+			return descriptors;
+		}
+
+		inline auto toIntID() const -> const uint64_t override
+		{
+			return reinterpret_cast<uint64_t>(this);
+		};
+
+		inline auto setName(const std::string &name) -> void override
+		{
+			this->name = name;
+		};
+
+		inline auto getShader() const
+		{
+			return shader;
+		}
+
+	  private:
+		auto setBufferBound(const std::string &name) -> void;
+
+		struct UniformBufferInfo
+		{
+			std::string                    name;
+			std::shared_ptr<UniformBuffer> uniformBuffer;
+			std::vector<BufferMemberInfo>  members;
+			Buffer                         localStorage;
+			bool                           dirty;
+		};
+
+		std::string             name;
+		uint32_t                dynamicOffset = 0;
+		Shader *                shader        = nullptr;
+		bool                    updated       = false;
+		std::vector<Descriptor> descriptors;
+
+		std::vector<UniformBufferInfo>              uniformBuffers;
+		std::unordered_map<uint64_t, UniformHandle> uniformHandles;        //UniformId::hash
+		std::unordered_set<std::string>             boundBuffers;          //storage buffers and acceleration structures
+	};
+}        // namespace maple
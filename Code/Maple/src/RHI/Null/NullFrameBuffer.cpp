@@ -0,0 +1,48 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "NullFrameBuffer.h"
+#include "NullContext.h"
+#include "RHI/Texture.h"
+
+namespace maple
+{
+	NullFrameBuffer::NullFrameBuffer(const FrameBufferInfo &info) :
+	    width(info.width),
+	    height(info.height),
+	    attachments(info.attachments)
+	{
+		for (auto &attachment : attachments)
+		{
+			NullContext::validate(attachment != nullptr, "Frame buffer created with an empty attachment");
+		}
+	}
+
+	auto NullFrameBuffer::addTextureAttachment(TextureFormat format, const std::shared_ptr<Texture> &texture) -> void
+	{
+		attachments.emplace_back(texture);
+	}
+
+	auto NullFrameBuffer::addCubeTextureAttachment(TextureFormat format, CubeFace face, const std::shared_ptr<TextureCube> &texture) -> void
+	{
+		attachments.emplace_back(texture);
+	}
+
+	auto NullFrameBuffer::addShadowAttachment(const std::shared_ptr<Texture> &texture) -> void
+	{
+		attachments.emplace_back(texture);
+	}
+
+	auto NullFrameBuffer::addTextureLayer(int32_t index, const std::shared_ptr<Texture> &texture) -> void
+	{
+		attachments.emplace_back(texture);
+	}
+
+	auto NullFrameBuffer::getColorAttachment(int32_t id) const -> std::shared_ptr<Texture>
+	{
+		if (id < 0 || id >= static_cast<int32_t>(attachments.size()))
+			return nullptr;
+		return attachments[id];
+	}
+}        // namespace maple
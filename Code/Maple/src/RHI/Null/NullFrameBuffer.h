@@ -0,0 +1,48 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "RHI/FrameBuffer.h"
+
+namespace maple
+{
+	class NullFrameBuffer : public FrameBuffer
+	{
+	  public:
+		NullFrameBuffer(const FrameBufferInfo &info);
+
+		auto bind(uint32_t width, uint32_t height) const -> void override{};
+		auto bind() const -> void override{};
+		auto unbind() const -> void override{};
+		auto clear() -> void override{};
+		auto addTextureAttachment(TextureFormat format, const std::shared_ptr<Texture> &texture) -> void override;
+		auto addCubeTextureAttachment(TextureFormat format, CubeFace face, const std::shared_ptr<TextureCube> &texture) -> void override;
+		auto addShadowAttachment(const std::shared_ptr<Texture> &texture) -> void override;
+		auto addTextureLayer(int32_t index, const std::shared_ptr<Texture> &texture) -> void override;
+		auto generateFramebuffer() -> void override{};
+		auto getColorAttachment(int32_t id = 0) const -> std::shared_ptr<Texture> override;
+
+		inline auto getWidth() const -> uint32_t override
+		{
+			return width;
+		}
+
+		inline auto getHeight() const -> uint32_t override
+		{
+			return height;
+		}
+
+		inline auto setClearColor(const glm::vec4 &color) -> void override
+		{
+			clearColor = color;
+		}
+
+	  private:
+		uint32_t                              width  = 0;
+		uint32_t                              height = 0;
+		glm::vec4                             clearColor{};
+		std::vector<std::shared_ptr<Texture>> attachments;
+	};
+}        // namespace maple
@@ -0,0 +1,60 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "NullIndexBuffer.h"
+#include "NullCommandBuffer.h"
+#include "NullContext.h"
+
+#include <cstring>
+
+namespace maple
+{
+	NullIndexBuffer::NullIndexBuffer(const uint16_t *data, uint32_t count, BufferUsage bufferUsage) :
+	    count(count),
+	    usage(bufferUsage)
+	{
+		init(data, count * sizeof(uint16_t));
+	}
+
+	NullIndexBuffer::NullIndexBuffer(const uint32_t *data, uint32_t count, BufferUsage bufferUsage) :
+	    count(count),
+	    usage(bufferUsage)
+	{
+		init(data, count * sizeof(uint32_t));
+	}
+
+	auto NullIndexBuffer::init(const void *data, uint32_t size) -> void
+	{
+		buffer.resize(size);
+		if (data != nullptr)
+		{
+			std::memcpy(buffer.data(), data, size);
+			NullContext::count(NullCounter::BytesUploaded, size);
+		}
+	}
+
+	auto NullIndexBuffer::bind(const CommandBuffer *commandBuffer) const -> void
+	{
+		auto cmd = static_cast<const NullCommandBuffer *>(commandBuffer);
+		if (NullContext::validate(cmd != nullptr && cmd->isRecording(), "Index buffer bound to a command buffer which is not recording"))
+		{
+			NullContext::validate(!mapped, "Index buffer is bound while it is mapped");
+			cmd->setIndexCount(count);
+		}
+	}
+
+	auto NullIndexBuffer::getPointerInternal() -> void *
+	{
+		NullContext::validate(!mapped, "Index buffer is mapped twice");
+		mapped = true;
+		return buffer.data();
+	}
+
+	auto NullIndexBuffer::releasePointer() -> void
+	{
+		if (mapped)
+			NullContext::count(NullCounter::BytesUploaded, buffer.size());
+		mapped = false;
+	}
+}        // namespace maple
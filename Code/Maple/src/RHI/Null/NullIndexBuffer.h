@@ -0,0 +1,48 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "RHI/IndexBuffer.h"
+#include <vector>
+
+namespace maple
+{
+	class NullIndexBuffer : public IndexBuffer
+	{
+	  public:
+		NullIndexBuffer(const uint16_t *data, uint32_t count, BufferUsage bufferUsage);
+		NullIndexBuffer(const uint32_t *data, uint32_t count, BufferUsage bufferUsage);
+
+		auto bind(const CommandBuffer *commandBuffer) const -> void override;
+		auto unbind() const -> void override{};
+		auto releasePointer() -> void override;
+
+		inline auto getCount() const -> uint32_t override
+		{
+			return count;
+		}
+
+		inline auto setCount(uint32_t indexCount) -> void override
+		{
+			count = indexCount;
+		};
+
+		inline auto getSize() const -> uint64_t override
+		{
+			return buffer.size();
+		}
+
+	  protected:
+		auto getPointerInternal() -> void * override;
+
+	  private:
+		auto init(const void *data, uint32_t size) -> void;
+
+		std::vector<uint8_t> buffer;
+		uint32_t             count  = 0;
+		BufferUsage          usage  = BufferUsage::Static;
+		bool                 mapped = false;
+	};
+}        // namespace maple
@@ -0,0 +1,197 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "NullPipeline.h"
+#include "Application.h"
+#include "Engine/Profiler.h"
+#include "NullCommandBuffer.h"
+#include "NullContext.h"
+#include "NullTexture.h"
+#include "RHI/FrameBuffer.h"
+#include "RHI/RenderPass.h"
+#include "RHI/Shader.h"
+#include "RHI/SwapChain.h"
+
+#include <cmath>
+
+namespace maple
+{
+	NullPipeline::NullPipeline(const PipelineInfo &pipelineDesc)
+	{
+		PROFILE_FUNCTION();
+		description = pipelineDesc;
+		shader      = description.shader;
+		graphics    = !shader->isComputeShader() && !shader->isRaytracingShader();
+
+		if (graphics)
+			createFrameBuffers();
+	}
+
+	auto NullPipeline::createFrameBuffers() -> void
+	{
+		PROFILE_FUNCTION();
+		std::vector<std::shared_ptr<Texture>> attachments;
+
+		if (description.swapChainTarget)
+		{
+			attachments.emplace_back(Application::getGraphicsContext()->getSwapChain()->getImage(0));
+		}
+		else
+		{
+			for (auto texture : description.colorTargets)
+			{
+				if (texture)
+				{
+					attachments.emplace_back(texture);
+				}
+			}
+		}
+
+		if (description.depthTarget)
+		{
+			attachments.emplace_back(description.depthTarget);
+		}
+
+		if (description.depthArrayTarget)
+		{
+			attachments.emplace_back(description.depthArrayTarget);
+		}
+
+		if (!NullContext::validate(!attachments.empty(), "Graphics pipeline {0} has no render target", shader->getName()))
+			return;
+
+		RenderPassInfo renderPassDesc;
+		renderPassDesc.attachments = attachments;
+		renderPassDesc.clear       = description.clearTargets;
+		renderPass                 = RenderPass::create(renderPassDesc);
+
+		FrameBufferInfo frameBufferDesc{};
+		frameBufferDesc.width       = getWidth();
+		frameBufferDesc.height      = getHeight();
+		frameBufferDesc.renderPass  = renderPass;
+		frameBufferDesc.attachments = attachments;
+
+		uint32_t count = 1;
+		if (description.swapChainTarget)
+		{
+			count = static_cast<uint32_t>(Application::getGraphicsContext()->getSwapChain()->getSwapChainBufferCount());
+		}
+		else if (description.depthArrayTarget)
+		{
+			count = static_cast<NullTextureDepthArray *>(description.depthArrayTarget.get())->getCount();
+		}
+
+		for (uint32_t i = 0; i < count; i++)
+		{
+			if (description.swapChainTarget)
+				frameBufferDesc.attachments[0] = Application::getGraphicsContext()->getSwapChain()->getImage(i);
+			frameBufferDesc.layer = i;
+			frameBuffers.emplace_back(FrameBuffer::create(frameBufferDesc));
+		}
+	}
+
+	auto NullPipeline::getFrameBuffer(uint32_t layer) -> FrameBuffer *
+	{
+		if (frameBuffers.empty())
+			return nullptr;
+
+		if (description.swapChainTarget)
+			return frameBuffers[Application::getGraphicsContext()->getSwapChain()->getCurrentImageIndex()].get();
+
+		if (description.depthArrayTarget && layer < frameBuffers.size())
+			return frameBuffers[layer].get();
+
+		return frameBuffers[0].get();
+	}
+
+	auto NullPipeline::bind(const CommandBuffer *commandBuffer, uint32_t layer, int32_t cubeFace, int32_t mipMapLevel) -> FrameBuffer *
+	{
+		PROFILE_FUNCTION();
+		auto cmd = static_cast<const NullCommandBuffer *>(commandBuffer);
+		if (!NullContext::validate(cmd != nullptr && cmd->isRecording(), "Pipeline {0} is bound to a command buffer which is not recording", shader->getName()))
+			return graphics ? getFrameBuffer(layer) : nullptr;
+
+		NullContext::validate(!graphics || cmd->getCommandBufferType() == CommandBufferType::Graphics,
+		                      "Graphics pipeline {0} is bound to a compute command buffer", shader->getName());
+
+		NullContext::count(NullCounter::PipelineBinds);
+		cmd->setPipeline(this);
+
+		if (!graphics || renderPass == nullptr)
+			return nullptr;
+
+		auto framebuffer = getFrameBuffer(layer);
+		auto mipScale    = std::pow(0.5, mipMapLevel);
+		renderPass->beginRenderPass(cmd, description.clearColor, framebuffer, SubPassContents::Inline, getWidth() * mipScale, getHeight() * mipScale, cubeFace, mipMapLevel);
+		return framebuffer;
+	}
+
+	auto NullPipeline::end(const CommandBuffer *commandBuffer) -> void
+	{
+		PROFILE_FUNCTION();
+		if (graphics && renderPass != nullptr)
+			renderPass->endRenderPass(commandBuffer);
+	}
+
+	auto NullPipeline::bindSecondary(const CommandBuffer *commandBuffer, uint32_t layer) -> FrameBuffer *
+	{
+		PROFILE_FUNCTION();
+		if (!graphics || renderPass == nullptr)
+			return nullptr;
+
+		auto framebuffer = getFrameBuffer(layer);
+		renderPass->beginRenderPass(commandBuffer, description.clearColor, framebuffer, SubPassContents::Secondary, getWidth(), getHeight());
+		return framebuffer;
+	}
+
+	auto NullPipeline::beginSecondary(CommandBuffer *secondary, FrameBuffer *framebuffer) -> void
+	{
+		PROFILE_FUNCTION();
+		secondary->beginRecordingSecondary(renderPass.get(), framebuffer);
+		NullContext::count(NullCounter::PipelineBinds);
+		static_cast<NullCommandBuffer *>(secondary)->setPipeline(this);
+	}
+
+	auto NullPipeline::traceRays(const CommandBuffer *commandBuffer, uint32_t width, uint32_t height, uint32_t depth) -> void
+	{
+		auto cmd = static_cast<const NullCommandBuffer *>(commandBuffer);
+		NullContext::validate(shader->isRaytracingShader(), "traceRays() called on pipeline {0} which is not a raytracing pipeline", shader->getName());
+		NullContext::validate(cmd != nullptr && cmd->getPipeline() == this, "traceRays() called without binding pipeline {0}", shader->getName());
+		NullContext::count(NullCounter::Dispatches);
+	}
+
+	auto NullPipeline::getWidth() -> uint32_t
+	{
+		if (description.swapChainTarget)
+			return Application::getGraphicsContext()->getSwapChain()->getCurrentImage()->getWidth();
+
+		if (description.colorTargets[0])
+			return description.colorTargets[0]->getWidth();
+
+		if (description.depthTarget)
+			return description.depthTarget->getWidth();
+
+		if (description.depthArrayTarget)
+			return description.depthArrayTarget->getWidth();
+
+		return 0;
+	}
+
+	auto NullPipeline::getHeight() -> uint32_t
+	{
+		if (description.swapChainTarget)
+			return Application::getGraphicsContext()->getSwapChain()->getCurrentImage()->getHeight();
+
+		if (description.colorTargets[0])
+			return description.colorTargets[0]->getHeight();
+
+		if (description.depthTarget)
+			return description.depthTarget->getHeight();
+
+		if (description.depthArrayTarget)
+			return description.depthArrayTarget->getHeight();
+
+		return 0;
+	}
+}        // namespace maple
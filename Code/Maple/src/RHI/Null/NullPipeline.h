@@ -0,0 +1,49 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "RHI/Pipeline.h"
+#include <vector>
+
+namespace maple
+{
+	class RenderPass;
+	class FrameBuffer;
+
+	//graphics, compute and raytracing pipelines of the null backend, only the render pass of a graphics pipeline is recorded
+	class NullPipeline : public Pipeline
+	{
+	  public:
+		NullPipeline(const PipelineInfo &pipelineDesc);
+
+		auto bind(const CommandBuffer *commandBuffer, uint32_t layer = 0, int32_t cubeFace = -1, int32_t mipMapLevel = 0) -> FrameBuffer * override;
+		auto end(const CommandBuffer *commandBuffer) -> void override;
+		auto bindSecondary(const CommandBuffer *commandBuffer, uint32_t layer = 0) -> FrameBuffer * override;
+		auto beginSecondary(CommandBuffer *secondary, FrameBuffer *framebuffer) -> void override;
+		auto traceRays(const CommandBuffer *commandBuffer, uint32_t width, uint32_t height, uint32_t depth) -> void override;
+		auto getWidth() -> uint32_t override;
+		auto getHeight() -> uint32_t override;
+
+		inline auto getShader() const -> std::shared_ptr<Shader> override
+		{
+			return shader;
+		}
+
+		inline auto isGraphics() const
+		{
+			return graphics;
+		}
+
+	  private:
+		auto createFrameBuffers() -> void;
+		auto getFrameBuffer(uint32_t layer) -> FrameBuffer *;
+
+		std::shared_ptr<Shader>                   shader;
+		std::shared_ptr<RenderPass>               renderPass;
+		std::vector<std::shared_ptr<FrameBuffer>> frameBuffers;
+
+		bool graphics = true;
+	};
+}        // namespace maple
@@ -0,0 +1,159 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "NullRenderDevice.h"
+#include "Application.h"
+#include "Engine/Profiler.h"
+#include "NullCommandBuffer.h"
+#include "NullContext.h"
+#include "NullDescriptorSet.h"
+#include "NullPipeline.h"
+#include "NullSwapChain.h"
+#include "RHI/Shader.h"
+
+namespace maple
+{
+	auto NullRenderDevice::begin() -> void
+	{
+		PROFILE_FUNCTION();
+		std::static_pointer_cast<NullSwapChain>(Application::getGraphicsContext()->getSwapChain())->begin();
+	}
+
+	auto NullRenderDevice::presentInternal() -> void
+	{
+		PROFILE_FUNCTION();
+		std::static_pointer_cast<NullSwapChain>(Application::getGraphicsContext()->getSwapChain())->end();
+		NullContext::get()->endFrame();
+	}
+
+	auto NullRenderDevice::onResize(uint32_t width, uint32_t height) -> void
+	{
+		PROFILE_FUNCTION();
+		if (width == 0 || height == 0)
+			return;
+		std::static_pointer_cast<NullSwapChain>(Application::getGraphicsContext()->getSwapChain())->onResize(width, height);
+	}
+
+	auto NullRenderDevice::validateDraw(const CommandBuffer *commandBuffer, const char *name) const -> bool
+	{
+		auto cmd = static_cast<const NullCommandBuffer *>(commandBuffer);
+		if (!NullContext::validate(cmd != nullptr && cmd->isRecording(), "{0}() recorded into a command buffer which is not recording", name))
+			return false;
+
+		auto pipeline = static_cast<NullPipeline *>(cmd->getPipeline());
+		if (!NullContext::validate(pipeline != nullptr, "{0}() without a bound pipeline", name))
+			return false;
+
+		if (!NullContext::validate(pipeline->isGraphics(), "{0}() with the non graphics pipeline {1}", name, pipeline->getShader()->getName()))
+			return false;
+
+		return NullContext::validate(cmd->isInsideRenderPass(), "{0}() outside of a render pass, pipeline {1}", name, pipeline->getShader()->getName());
+	}
+
+	auto NullRenderDevice::drawInternal(const CommandBuffer *commandBuffer, DrawType type, uint32_t count, DataType dataType, const void *indices) const -> void
+	{
+		if (validateDraw(commandBuffer, "draw"))
+		{
+			NullContext::count(NullCounter::DrawCalls);
+			NullContext::count(NullCounter::Instances);
+		}
+	}
+
+	auto NullRenderDevice::drawArraysInternal(const CommandBuffer *commandBuffer, DrawType type, uint32_t count, uint32_t start) const -> void
+	{
+		if (validateDraw(commandBuffer, "drawArrays"))
+		{
+			NullContext::count(NullCounter::DrawCalls);
+			NullContext::count(NullCounter::Instances);
+		}
+	}
+
+	auto NullRenderDevice::drawIndexedInternal(const CommandBuffer *commandBuffer, DrawType type, uint32_t count, uint32_t start) const -> void
+	{
+		drawIndexedInstancedInternal(commandBuffer, type, count, 1, start);
+	}
+
+	auto NullRenderDevice::drawIndexedInstancedInternal(const CommandBuffer *commandBuffer, DrawType type, uint32_t count, uint32_t instanceCount, uint32_t start) const -> void
+	{
+		if (!validateDraw(commandBuffer, "drawIndexed"))
+			return;
+
+		auto cmd = static_cast<const NullCommandBuffer *>(commandBuffer);
+		if (!NullContext::validate(cmd->isIndexBufferBound(), "drawIndexed() without a bound index buffer"))
+			return;
+
+		if (!NullContext::validate(uint64_t(start) + count <= cmd->getIndexCount(), "drawIndexed() reads indices [{0}, {1}) of a buffer with {2} indices", start, start + count, cmd->getIndexCount()))
+			return;
+
+		NullContext::count(NullCounter::DrawCalls);
+		NullContext::count(NullCounter::Indices, uint64_t(count) * instanceCount);
+		NullContext::count(NullCounter::Instances, instanceCount);
+	}
+
+	auto NullRenderDevice::drawIndexedIndirectInternal(const CommandBuffer *commandBuffer, StorageBuffer *args, uint32_t offset, uint32_t drawCount, uint32_t stride) const -> void
+	{
+		if (!validateDraw(commandBuffer, "drawIndexedIndirect"))
+			return;
+
+		if (!NullContext::validate(args != nullptr, "drawIndexedIndirect() without an argument buffer"))
+			return;
+
+		//the arguments live on the gpu side, only the number of draws is known here
+		NullContext::count(NullCounter::DrawCalls, drawCount);
+	}
+
+	auto NullRenderDevice::bindDescriptorSetsInternal(Pipeline *pipeline, const CommandBuffer *commandBuffer, uint32_t dynamicOffset, const std::vector<std::shared_ptr<DescriptorSet>> &descriptorSets) -> void
+	{
+		PROFILE_FUNCTION();
+		if (!NullContext::validate(pipeline != nullptr, "Descriptor sets bound without a pipeline"))
+			return;
+
+		for (auto &descriptorSet : descriptorSets)
+		{
+			if (descriptorSet)
+			{
+				std::static_pointer_cast<NullDescriptorSet>(descriptorSet)->validate();
+				NullContext::count(NullCounter::DescriptorBinds);
+			}
+		}
+	}
+
+	auto NullRenderDevice::dispatch(const CommandBuffer *commandBuffer, uint32_t x, uint32_t y, uint32_t z) -> void
+	{
+		auto cmd = static_cast<const NullCommandBuffer *>(commandBuffer);
+		if (!NullContext::validate(cmd != nullptr && cmd->isRecording(), "dispatch() recorded into a command buffer which is not recording"))
+			return;
+
+		auto pipeline = cmd->getPipeline();
+		if (!NullContext::validate(pipeline != nullptr && pipeline->getShader()->isComputeShader(), "dispatch() without a bound compute pipeline"))
+			return;
+
+		if (!NullContext::validate(!cmd->isInsideRenderPass(), "dispatch() inside of a render pass, pipeline {0}", pipeline->getShader()->getName()))
+			return;
+
+		NullContext::validate(x > 0 && y > 0 && z > 0, "dispatch() of an empty grid ({0}, {1}, {2})", x, y, z);
+		NullContext::count(NullCounter::Dispatches);
+	}
+
+	auto NullRenderDevice::memoryBarrier(const CommandBuffer *commandBuffer, uint32_t flag) -> void
+	{
+		NullContext::count(NullCounter::Barriers);
+	}
+
+	auto NullRenderDevice::clearRenderTarget(const std::shared_ptr<Texture> &texture, const CommandBuffer *commandBuffer, const glm::vec4 &clearColor) -> void
+	{
+		auto cmd = static_cast<const NullCommandBuffer *>(commandBuffer);
+		NullContext::validate(texture != nullptr, "clearRenderTarget() without a texture");
+		NullContext::validate(cmd == nullptr || !cmd->isInsideRenderPass(), "clearRenderTarget() inside of a render pass");
+	}
+
+	auto NullRenderDevice::transitionTextures(const CommandBuffer *commandBuffer, const std::vector<TextureTransition> &transitions) -> void
+	{
+		for (auto &transition : transitions)
+		{
+			if (transition.texture != nullptr && transition.state != ResourceState::Undefined)
+				NullContext::count(NullCounter::Barriers);
+		}
+	}
+}        // namespace maple
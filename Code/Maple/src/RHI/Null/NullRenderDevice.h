@@ -0,0 +1,42 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "RHI/RenderDevice.h"
+
+namespace maple
+{
+	/**
+	 * Validates and counts the commands instead of executing them, the draw state checks are the
+	 * ones the vulkan validation layers would report (no pipeline, draw outside of a render pass ...)
+	 */
+	class MAPLE_EXPORT NullRenderDevice : public RenderDevice
+	{
+	  public:
+		NullRenderDevice()  = default;
+		~NullRenderDevice() = default;
+
+		auto init() -> void override{};
+		auto begin() -> void override;
+		auto onResize(uint32_t width, uint32_t height) -> void override;
+		auto presentInternal() -> void override;
+
+		auto dispatch(const CommandBuffer *commandBuffer, uint32_t x, uint32_t y, uint32_t z) -> void override;
+		auto memoryBarrier(const CommandBuffer *commandBuffer, uint32_t flag) -> void override;
+
+		auto drawArraysInternal(const CommandBuffer *commandBuffer, DrawType type, uint32_t count, uint32_t start = 0) const -> void override;
+		auto drawIndexedInternal(const CommandBuffer *commandBuffer, DrawType type, uint32_t count, uint32_t start = 0) const -> void override;
+		auto drawIndexedInstancedInternal(const CommandBuffer *commandBuffer, DrawType type, uint32_t count, uint32_t instanceCount, uint32_t start = 0) const -> void override;
+		auto drawIndexedIndirectInternal(const CommandBuffer *commandBuffer, StorageBuffer *args, uint32_t offset, uint32_t drawCount, uint32_t stride) const -> void override;
+		auto drawInternal(const CommandBuffer *commandBuffer, DrawType type, uint32_t count, DataType dataType = DataType::UnsignedInt, const void *indices = nullptr) const -> void override;
+		auto bindDescriptorSetsInternal(Pipeline *pipeline, const CommandBuffer *commandBuffer, uint32_t dynamicOffset, const std::vector<std::shared_ptr<DescriptorSet>> &descriptorSets) -> void override;
+		auto clearRenderTarget(const std::shared_ptr<Texture> &texture, const CommandBuffer *commandBuffer, const glm::vec4 &clearColor) -> void override;
+		auto transitionTextures(const CommandBuffer *commandBuffer, const std::vector<TextureTransition> &transitions) -> void override;
+
+	  private:
+		//common checks of every draw, false if the draw has to be dropped
+		auto validateDraw(const CommandBuffer *commandBuffer, const char *name) const -> bool;
+	};
+}        // namespace maple
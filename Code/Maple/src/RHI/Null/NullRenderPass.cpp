@@ -0,0 +1,31 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "NullRenderPass.h"
+#include "NullCommandBuffer.h"
+#include "NullContext.h"
+#include "RHI/FrameBuffer.h"
+
+namespace maple
+{
+	NullRenderPass::NullRenderPass(const RenderPassInfo &info) :
+	    attachmentCount(static_cast<int32_t>(info.attachments.size()))
+	{
+	}
+
+	auto NullRenderPass::beginRenderPass(const CommandBuffer *commandBuffer, const glm::vec4 &clearColor, FrameBuffer *frame, SubPassContents contents, uint32_t width, uint32_t height, int32_t cubeFace, int32_t mipMapLevel) const -> void
+	{
+		NullContext::validate(frame != nullptr, "Render pass begins without a frame buffer");
+		NullContext::validate(width > 0 && height > 0, "Render pass begins with an empty render area");
+
+		if (NullContext::validate(commandBuffer != nullptr, "Render pass begins without a command buffer"))
+			static_cast<const NullCommandBuffer *>(commandBuffer)->beginRenderPass();
+	}
+
+	auto NullRenderPass::endRenderPass(const CommandBuffer *commandBuffer) -> void
+	{
+		if (NullContext::validate(commandBuffer != nullptr, "Render pass ends without a command buffer"))
+			static_cast<const NullCommandBuffer *>(commandBuffer)->endRenderPass();
+	}
+}        // namespace maple
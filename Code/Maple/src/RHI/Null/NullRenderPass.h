@@ -0,0 +1,26 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include "RHI/RenderPass.h"
+
+namespace maple
+{
+	class NullRenderPass : public RenderPass
+	{
+	  public:
+		NullRenderPass(const RenderPassInfo &info);
+
+		auto beginRenderPass(const CommandBuffer *commandBuffer, const glm::vec4 &clearColor, FrameBuffer *frame, SubPassContents contents, uint32_t width, uint32_t height, int32_t cubeFace = -1, int32_t mipMapLevel = 0) const -> void override;
+		auto endRenderPass(const CommandBuffer *commandBuffer) -> void override;
+
+		inline auto getAttachmentCount() const -> int32_t override
+		{
+			return attachmentCount;
+		}
+
+	  private:
+		int32_t attachmentCount = 0;
+	};
+}        // namespace maple
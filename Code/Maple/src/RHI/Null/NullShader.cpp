@@ -0,0 +1,245 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+#include "NullShader.h"
+#include "Engine/Profiler.h"
+#include "FileSystem/File.h"
+#include "NullCommandBuffer.h"
+#include "NullContext.h"
+#include "Others/StringUtils.h"
+#include "RHI/Definitions.h"
+
+#include <algorithm>
+#include <cstring>
+#include <spirv_cross.hpp>
+
+namespace maple
+{
+	namespace
+	{
+		//the acceleration structures and buffers have no size in the reflection, same as VK_WHOLE_SIZE
+		constexpr uint64_t WholeSize = ~0ULL;
+
+		inline auto findDescriptor(std::vector<Descriptor> &descriptors, DescriptorType type, uint32_t binding, const std::string &name)
+		{
+			return std::find_if(descriptors.begin(), descriptors.end(), [&](const Descriptor &info) {
+				return info.type == type && info.binding == binding && info.name == name;
+			});
+		}
+	}        // namespace
+
+	NullShader::NullShader(const std::string &path, const VariableArraySize &size) :
+	    filePath(path), arraySize(size)
+	{
+		name       = StringUtils::getFileName(filePath);
+		auto bytes = File::read(filePath);
+		source     = {bytes->begin(), bytes->end()};
+		if (!source.empty())
+		{
+			init();
+		}
+	}
+
+	NullShader::NullShader(const std::vector<uint32_t> &vertData, const std::vector<uint32_t> &fragData)
+	{
+		reflectShader(vertData, ShaderType::Vertex);
+		reflectShader(fragData, ShaderType::Fragment);
+	}
+
+	auto NullShader::bindPushConstants(const CommandBuffer *commandBuffer, Pipeline *pipeline) -> void
+	{
+		bindPushConstants(commandBuffer, pipeline, pushConstants);
+	}
+
+	auto NullShader::bindPushConstants(const CommandBuffer *commandBuffer, Pipeline *pipeline, const std::vector<PushConstant> &constants) -> void
+	{
+		NullContext::validate(commandBuffer != nullptr && commandBuffer->isRecording(), "Push constants of {0} written to a command buffer which is not recording", name);
+		NullContext::validate(pipeline != nullptr, "Push constants of {0} written without a pipeline", name);
+	}
+
+	auto NullShader::init() -> void
+	{
+		PROFILE_FUNCTION();
+		std::vector<std::string> lines;
+		StringUtils::split(source, "\n", lines);
+		std::unordered_multimap<ShaderType, std::string> sources;
+		parseSource(lines, sources);
+
+		for (auto &source : sources)
+		{
+			switch (source.first)
+			{
+				case ShaderType::RayAnyHit:
+				case ShaderType::RayMiss:
+				case ShaderType::RayCloseHit:
+				case ShaderType::RayGen:
+				case ShaderType::RayIntersect:
+					raytracingShader = true;
+					break;
+			}
+
+			if (source.second == "null")
+				continue;
+
+			auto buffer = File::read(source.second);
+			if (!NullContext::validate(buffer != nullptr && !buffer->empty(), "SPIR-V {0} of shader {1} could not be read", source.second, name))
+				continue;
+
+			std::vector<uint32_t> code(buffer->size() / sizeof(uint32_t));
+			std::memcpy(code.data(), buffer->data(), code.size() * sizeof(uint32_t));
+			reflectShader(code, source.first);
+		}
+	}
+
+	auto NullShader::reflectShader(const std::vector<uint32_t> &spvCode, ShaderType shaderType) -> void
+	{
+		spirv_cross::Compiler        comp(spvCode.data(), spvCode.size());
+		spirv_cross::ShaderResources resources = comp.get_shader_resources();
+
+		if (shaderType == ShaderType::Compute)
+		{
+			computeShader = true;
+			localSizeX    = comp.get_execution_mode_argument(spv::ExecutionMode::ExecutionModeLocalSize, 0);
+			localSizeY    = comp.get_execution_mode_argument(spv::ExecutionMode::ExecutionModeLocalSize, 1);
+			localSizeZ    = comp.get_execution_mode_argument(spv::ExecutionMode::ExecutionModeLocalSize, 2);
+		}
+
+		for (auto &resource : resources.storage_images)
+		{
+			auto &   glslType = comp.get_type(resource.base_type_id);
+			uint32_t set      = comp.get_decoration(resource.id, spv::DecorationDescriptorSet);
+			uint32_t binding  = comp.get_decoration(resource.id, spv::DecorationBinding);
+
+			if (glslType.basetype == spirv_cross::SPIRType::Image &&
+			    findDescriptor(descriptorInfos[set], DescriptorType::Image, binding, resource.name) == descriptorInfos[set].end())
+			{
+				auto &descriptor      = descriptorInfos[set].emplace_back();
+				descriptor.offset     = 0;
+				descriptor.size       = 0;
+				descriptor.binding    = binding;
+				descriptor.name       = resource.name;
+				descriptor.shaderType = shaderType;
+				descriptor.type       = DescriptorType::Image;
+				descriptor.accessFlag = spv::AccessQualifierReadWrite;
+				descriptor.format     = spirvTypeToTextureType(glslType.image.format);
+			}
+		}
+
+		for (auto &u : resources.uniform_buffers)
+		{
+			uint32_t set     = comp.get_decoration(u.id, spv::DecorationDescriptorSet);
+			uint32_t binding = comp.get_decoration(u.id, spv::DecorationBinding);
+
+			//the stages of a program share their uniform blocks
+			if (findDescriptor(descriptorInfos[set], DescriptorType::UniformBuffer, binding, u.name) != descriptorInfos[set].end())
+				continue;
+
+			auto &bufferType  = comp.get_type(u.base_type_id);
+			auto  memberCount = (int32_t) bufferType.member_types.size();
+
+			auto &descriptor      = descriptorInfos[set].emplace_back();
+			descriptor.binding    = binding;
+			descriptor.size       = (uint32_t) comp.get_declared_struct_size(bufferType);
+			descriptor.name       = u.name;
+			descriptor.offset     = 0;
+			descriptor.shaderType = shaderType;
+			descriptor.type       = DescriptorType::UniformBuffer;
+			descriptor.buffer     = nullptr;
+
+			for (int32_t i = 0; i < memberCount; i++)
+			{
+				auto &member    = descriptor.members.emplace_back();
+				member.name     = comp.get_member_name(bufferType.self, i);
+				member.offset   = comp.type_struct_member_offset(bufferType, i);
+				member.size     = (uint32_t) comp.get_declared_struct_member_size(bufferType, i);
+				member.type     = spirvTypeToDataType(comp.get_type(bufferType.member_types[i]), member.size);
+				member.fullName = u.name + "." + member.name;
+			}
+		}
+
+		for (auto &u : resources.push_constant_buffers)
+		{
+			auto &bufferType = comp.get_type(u.base_type_id);
+			auto  bufferSize = (uint32_t) comp.get_declared_struct_size(bufferType);
+
+			auto iter = std::find_if(pushConstants.begin(), pushConstants.end(), [&](const PushConstant &consts) {
+				return consts.name == u.name && bufferSize == consts.size;
+			});
+
+			if (iter != pushConstants.end())
+			{
+				iter->shaderStages.emplace(shaderType);
+				continue;
+			}
+
+			auto &push = pushConstants.emplace_back();
+			push.name  = u.name;
+			push.size  = bufferSize;
+			push.data.resize(bufferSize);
+			push.shaderStages.emplace(shaderType);
+
+			for (int32_t i = 0; i < (int32_t) bufferType.member_types.size(); i++)
+			{
+				auto &member    = push.members.emplace_back();
+				member.name     = comp.get_member_name(bufferType.self, i);
+				member.offset   = comp.type_struct_member_offset(bufferType, i);
+				member.size     = (uint32_t) comp.get_declared_struct_member_size(bufferType, i);
+				member.type     = spirvTypeToDataType(comp.get_type(bufferType.member_types[i]), member.size);
+				member.fullName = u.name + "." + member.name;
+			}
+		}
+
+		for (auto &u : resources.sampled_images)
+		{
+			uint32_t set     = comp.get_decoration(u.id, spv::DecorationDescriptorSet);
+			uint32_t binding = comp.get_decoration(u.id, spv::DecorationBinding);
+
+			if (findDescriptor(descriptorInfos[set], DescriptorType::ImageSampler, binding, u.name) == descriptorInfos[set].end())
+			{
+				auto &descriptor      = descriptorInfos[set].emplace_back();
+				descriptor.binding    = binding;
+				descriptor.name       = u.name;
+				descriptor.offset     = 0;
+				descriptor.size       = 0;
+				descriptor.shaderType = shaderType;
+				descriptor.format     = TextureFormat::NONE;
+			}
+		}
+
+		for (auto &u : resources.storage_buffers)
+		{
+			uint32_t set     = comp.get_decoration(u.id, spv::DecorationDescriptorSet);
+			uint32_t binding = comp.get_decoration(u.id, spv::DecorationBinding);
+
+			if (findDescriptor(descriptorInfos[set], DescriptorType::Buffer, binding, u.name) == descriptorInfos[set].end())
+			{
+				auto &descriptor      = descriptorInfos[set].emplace_back();
+				descriptor.binding    = binding;
+				descriptor.name       = u.name;
+				descriptor.offset     = 0;
+				descriptor.shaderType = shaderType;
+				descriptor.type       = DescriptorType::Buffer;
+				descriptor.buffer     = nullptr;
+				descriptor.size       = WholeSize;
+			}
+		}
+
+		for (auto &u : resources.acceleration_structures)
+		{
+			uint32_t set     = comp.get_decoration(u.id, spv::DecorationDescriptorSet);
+			uint32_t binding = comp.get_decoration(u.id, spv::DecorationBinding);
+
+			if (findDescriptor(descriptorInfos[set], DescriptorType::AccelerationStructure, binding, u.name) == descriptorInfos[set].end())
+			{
+				auto &descriptor      = descriptorInfos[set].emplace_back();
+				descriptor.binding    = binding;
+				descriptor.name       = u.name;
+				descriptor.offset     = 0;
+				descriptor.shaderType = shaderType;
+				descriptor.type       = DescriptorType::AccelerationStructure;
+				descriptor.buffer     = nullptr;
+				descriptor.size       = WholeSize;
+			}
+		}
+	}
+};        // namespace maple
@@ -0,0 +1,92 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include "Engine/Core.h"
+#include "Others/Console.h"
+#include "RHI/DescriptorSet.h"
+#include "RHI/Shader.h"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace maple
+{
+	//loads the same SPIR-V as the vulkan backend and reflects it into the same descriptor layouts, without creating modules
+	class MAPLE_EXPORT NullShader : public Shader
+	{
+	  public:
+		NullShader(const std::string &path, const VariableArraySize &size);
+		NullShader(const std::vector<uint32_t> &vertData, const std::vector<uint32_t> &fragData);
+		NO_COPYABLE(NullShader);
+
+		auto bindPushConstants(const CommandBuffer *commandBuffer, Pipeline *pipeline) -> void override;
+		auto bindPushConstants(const CommandBuffer *commandBuffer, Pipeline *pipeline, const std::vector<PushConstant> &constants) -> void override;
+
+		auto bind() const -> void override{};
+		auto unbind() const -> void override{};
+
+		inline auto getName() const -> const std::string & override
+		{
+			return name;
+		}
+
+		inline auto getFilePath() const -> const std::string & override
+		{
+			return filePath;
+		}
+
+		inline auto getPath() const -> std::string override
+		{
+			return filePath;
+		}
+
+		inline auto getHandle() const -> void * override
+		{
+			return nullptr;
+		}
+
+		inline auto getPushConstants() -> std::vector<PushConstant> & override
+		{
+			return pushConstants;
+		};
+
+		inline auto getPushConstant(uint32_t index) -> PushConstant * override
+		{
+			if (index < pushConstants.size())
+			{
+				return &pushConstants[index];
+			}
+			return nullptr;
+		}
+
+		inline auto getDescriptorInfo(uint32_t index) -> const std::vector<Descriptor> override
+		{
+			if (auto iter = descriptorInfos.find(index); iter != descriptorInfos.end())
+			{
+				return iter->second;
+			}
+
+			LOGW("DescriptorDesc not found. Index = {0}", index);
+			return std::vector<Descriptor>{};
+		}
+
+		inline auto getDescriptorSetCount() const
+		{
+			return static_cast<uint32_t>(descriptorInfos.size());
+		}
+
+	  private:
+		auto init() -> void;
+		auto reflectShader(const std::vector<uint32_t> &spvCode, ShaderType type) -> void;
+
+		std::string name;
+		std::string filePath;
+		std::string source;
+
+		std::vector<PushConstant>                             pushConstants;
+		std::unordered_map<uint32_t, std::vector<Descriptor>> descriptorInfos;
+		VariableArraySize                                     arraySize;
+	};
+};        // namespace maple
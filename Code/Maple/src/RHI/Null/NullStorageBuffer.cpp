@@ -0,0 +1,60 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "NullStorageBuffer.h"
+#include "Engine/Profiler.h"
+#include "NullContext.h"
+
+#include <cstring>
+
+namespace maple
+{
+	NullStorageBuffer::NullStorageBuffer(const BufferOptions &options) :
+	    options(options)
+	{
+	}
+
+	NullStorageBuffer::NullStorageBuffer(uint32_t size, uint32_t flags, const BufferOptions &options) :
+	    options(options)
+	{
+		buffer.assign(size, 0);
+	}
+
+	NullStorageBuffer::NullStorageBuffer(uint32_t size, const void *data, const BufferOptions &options) :
+	    options(options)
+	{
+		setData(size, data);
+	}
+
+	auto NullStorageBuffer::setData(uint32_t size, const void *data) -> void
+	{
+		PROFILE_FUNCTION();
+		buffer.resize(size);
+		if (data != nullptr)
+		{
+			std::memcpy(buffer.data(), data, size);
+			NullContext::count(NullCounter::BytesUploaded, size);
+		}
+	}
+
+	auto NullStorageBuffer::mapMemory(const std::function<void(void *)> &call) -> void
+	{
+		call(map());
+		unmap();
+	}
+
+	auto NullStorageBuffer::unmap() -> void
+	{
+		if (mapped)
+			NullContext::count(NullCounter::BytesUploaded, buffer.size());
+		mapped = false;
+	}
+
+	auto NullStorageBuffer::map() -> void *
+	{
+		NullContext::validate(!mapped, "Storage buffer is mapped twice");
+		mapped = true;
+		return buffer.data();
+	}
+}        // namespace maple
@@ -0,0 +1,50 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "RHI/StorageBuffer.h"
+#include <vector>
+
+namespace maple
+{
+	class NullStorageBuffer : public StorageBuffer
+	{
+	  public:
+		NullStorageBuffer(const BufferOptions &options);
+		NullStorageBuffer(uint32_t size, uint32_t flags, const BufferOptions &options);
+		NullStorageBuffer(uint32_t size, const void *data, const BufferOptions &options);
+
+		auto setData(uint32_t size, const void *data) -> void override;
+		auto mapMemory(const std::function<void(void *)> &call) -> void override;
+		auto unmap() -> void override;
+		auto map() -> void * override;
+
+		auto getDeviceAddress() const -> uint64_t override
+		{
+			return 0;
+		}
+
+		auto invalidate() -> void override
+		{}
+
+		auto flush() -> void override
+		{}
+
+		inline auto isIndirect() const
+		{
+			return options.indirect;
+		}
+
+		inline auto getSize() const
+		{
+			return static_cast<uint32_t>(buffer.size());
+		}
+
+	  private:
+		BufferOptions        options;
+		std::vector<uint8_t> buffer;
+		bool                 mapped = false;
+	};
+}        // namespace maple
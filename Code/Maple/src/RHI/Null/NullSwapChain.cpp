@@ -0,0 +1,102 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "NullSwapChain.h"
+#include "Engine/Profiler.h"
+#include "NullCommandBuffer.h"
+#include "NullTexture.h"
+
+namespace maple
+{
+	namespace
+	{
+		//matches the frames in flight of the vulkan swap chain, so per frame resources rotate the same way
+		constexpr uint32_t SwapChainBufferCount = 3;
+	}        // namespace
+
+	NullSwapChain::NullSwapChain(uint32_t width, uint32_t height) :
+	    width(width), height(height)
+	{
+	}
+
+	NullSwapChain::~NullSwapChain() = default;
+
+	auto NullSwapChain::init(bool vsync) -> bool
+	{
+		PROFILE_FUNCTION();
+		frames.resize(SwapChainBufferCount);
+		for (auto &frame : frames)
+		{
+			frame.commandBuffer = std::make_shared<NullCommandBuffer>();
+			frame.commandBuffer->init(true);
+		}
+
+		computeCommandBuffer = std::make_shared<NullCommandBuffer>(CommandBufferType::Compute);
+		computeCommandBuffer->init(true);
+
+		onResize(width, height);
+		return true;
+	}
+
+	auto NullSwapChain::getCurrentImage() -> std::shared_ptr<Texture>
+	{
+		return swapChainBuffers[currentBuffer];
+	}
+
+	auto NullSwapChain::getImage(uint32_t index) -> std::shared_ptr<Texture>
+	{
+		return swapChainBuffers[index];
+	}
+
+	auto NullSwapChain::getCurrentCommandBuffer() -> CommandBuffer *
+	{
+		return frames[currentBuffer].commandBuffer.get();
+	}
+
+	auto NullSwapChain::getComputeCmdBuffer() -> CommandBuffer *
+	{
+		return computeCommandBuffer.get();
+	}
+
+	auto NullSwapChain::getSecondaryCommandBuffer() -> CommandBuffer *
+	{
+		std::lock_guard<std::mutex> lock(secondaryMutex);
+		auto &                      frame = frames[currentBuffer];
+		if (frame.usedSecondaries == frame.secondaries.size())
+		{
+			auto commandBuffer = std::make_shared<NullCommandBuffer>();
+			commandBuffer->init(false);
+			frame.secondaries.emplace_back(commandBuffer);
+		}
+		return frame.secondaries[frame.usedSecondaries++].get();
+	}
+
+	auto NullSwapChain::begin() -> void
+	{
+		PROFILE_FUNCTION();
+		currentBuffer                         = (currentBuffer + 1) % SwapChainBufferCount;
+		frames[currentBuffer].usedSecondaries = 0;
+		frames[currentBuffer].commandBuffer->beginRecording();
+		//recorded every frame like the async compute buffer of the vulkan swap chain
+		computeCommandBuffer->beginRecording();
+	}
+
+	auto NullSwapChain::end() -> void
+	{
+		PROFILE_FUNCTION();
+		computeCommandBuffer->endRecording();
+		frames[currentBuffer].commandBuffer->endRecording();
+	}
+
+	auto NullSwapChain::onResize(uint32_t width, uint32_t height) -> void
+	{
+		this->width  = width;
+		this->height = height;
+		swapChainBuffers.clear();
+		for (uint32_t i = 0; i < SwapChainBufferCount; i++)
+		{
+			swapChainBuffers.emplace_back(std::make_shared<NullTexture2D>(width, height, nullptr));
+		}
+	}
+}        // namespace maple
@@ -0,0 +1,80 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include "RHI/SwapChain.h"
+
+#include <mutex>
+#include <vector>
+
+namespace maple
+{
+	class NullCommandBuffer;
+	class NullTexture2D;
+
+	class NullSwapChain : public SwapChain
+	{
+	  public:
+		NullSwapChain(uint32_t width, uint32_t height);
+		~NullSwapChain();
+
+		auto init(bool vsync) -> bool override;
+		auto getCurrentImage() -> std::shared_ptr<Texture> override;
+		auto getImage(uint32_t index) -> std::shared_ptr<Texture> override;
+		auto getCurrentCommandBuffer() -> CommandBuffer * override;
+		auto getComputeCmdBuffer() -> CommandBuffer * override;
+		auto getSecondaryCommandBuffer() -> CommandBuffer * override;
+
+		auto begin() -> void;
+		auto end() -> void;
+		auto onResize(uint32_t width, uint32_t height) -> void;
+
+		inline auto init(bool vsync, NativeWindow *window) -> bool override
+		{
+			return init(vsync);
+		}
+
+		inline auto getCurrentBufferIndex() const -> uint32_t override
+		{
+			return currentBuffer;
+		}
+
+		inline auto getCurrentImageIndex() const -> uint32_t override
+		{
+			return currentBuffer;
+		}
+
+		inline auto getSwapChainBufferCount() const -> size_t override
+		{
+			return swapChainBuffers.size();
+		}
+
+		inline auto getWidth() const -> uint32_t
+		{
+			return width;
+		}
+
+		inline auto getHeight() const -> uint32_t
+		{
+			return height;
+		}
+
+	  private:
+		struct FrameData
+		{
+			std::shared_ptr<NullCommandBuffer>              commandBuffer;
+			std::vector<std::shared_ptr<NullCommandBuffer>> secondaries;
+			uint32_t                                        usedSecondaries = 0;
+		};
+
+		std::vector<std::shared_ptr<NullTexture2D>> swapChainBuffers;
+		std::vector<FrameData>                      frames;
+		std::shared_ptr<NullCommandBuffer>          computeCommandBuffer;
+		std::mutex                                  secondaryMutex;
+
+		uint32_t currentBuffer = 0;
+		uint32_t width         = 0;
+		uint32_t height        = 0;
+	};
+}        // namespace maple
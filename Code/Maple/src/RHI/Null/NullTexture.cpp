@@ -0,0 +1,212 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "NullTexture.h"
+#include "Engine/Profiler.h"
+#include "FileSystem/Image.h"
+#include "Loaders/ImageLoader.h"
+#include "NullContext.h"
+
+#include <algorithm>
+
+namespace maple
+{
+	namespace
+	{
+		inline auto countUpload(TextureFormat format, uint64_t texels)
+		{
+			auto stride = Texture::getStrideFromFormat(format);
+			NullContext::count(NullCounter::BytesUploaded, texels * (stride == 0 ? 4 : stride));
+		}
+	}        // namespace
+
+	NullTexture2D::NullTexture2D()
+	{
+		format = parameters.format;
+	}
+
+	NullTexture2D::NullTexture2D(uint32_t width, uint32_t height, const void *data, TextureParameters parameters, TextureLoadOptions loadOptions) :
+	    width(width),
+	    height(height),
+	    parameters(parameters),
+	    loadOptions(loadOptions)
+	{
+		format = parameters.format;
+		if (data != nullptr)
+			setData(data);
+	}
+
+	NullTexture2D::NullTexture2D(const std::string &initName, const std::string &fileName, TextureParameters parameters, TextureLoadOptions loadOptions) :
+	    fileName(fileName),
+	    parameters(parameters),
+	    loadOptions(loadOptions)
+	{
+		PROFILE_FUNCTION();
+		name = initName;
+
+		//decoded like the other backends, the image loading is a part of the frame worth measuring
+		auto pixels = ImageLoader::loadAsset(fileName, loadOptions.generateMipMaps, loadOptions.flipY, true);
+		if (NullContext::validate(pixels != nullptr, "Texture {0} could not be loaded", fileName))
+		{
+			format    = pixels->getPixelFormat();
+			width     = pixels->getWidth();
+			height    = pixels->getHeight();
+			mipLevels = pixels->getLevels() > 1 || isCompressedFormat(format) ? pixels->getLevels() : loadOptions.generateMipMaps ? calculateMipMapCount(width, height) : 1;
+			NullContext::count(NullCounter::BytesUploaded, pixels->getImageSize());
+		}
+		this->parameters.format = format;
+	}
+
+	auto NullTexture2D::reload() -> bool
+	{
+		PROFILE_FUNCTION();
+		if (fileName.empty())
+			return false;
+
+		auto pixels = ImageLoader::loadAsset(fileName, loadOptions.generateMipMaps, loadOptions.flipY, true);
+		if (!NullContext::validate(pixels != nullptr, "Texture {0} could not be reloaded", fileName))
+			return false;
+
+		format                  = pixels->getPixelFormat();
+		width                   = pixels->getWidth();
+		height                  = pixels->getHeight();
+		mipLevels               = pixels->getLevels() > 1 || isCompressedFormat(format) ? pixels->getLevels() : loadOptions.generateMipMaps ? calculateMipMapCount(width, height) : 1;
+		this->parameters.format = format;
+		NullContext::count(NullCounter::BytesUploaded, pixels->getImageSize());
+		generation++;
+		return true;
+	}
+
+	auto NullTexture2D::buildTexture(TextureFormat internalformat, uint32_t width, uint32_t height, bool srgb, bool depth, bool samplerShadow, bool mipmap, bool image, uint32_t accessFlag) -> void
+	{
+		this->format            = internalformat;
+		this->width             = width;
+		this->height            = height;
+		this->parameters.format = internalformat;
+		this->mipLevels         = mipmap ? calculateMipMapCount(width, height) : 1;
+	}
+
+	auto NullTexture2D::update(uint32_t x, uint32_t y, uint32_t w, uint32_t h, const void *buffer) -> void
+	{
+		NullContext::validate(x + w <= width && y + h <= height, "Update of texture {0} is out of bounds", name);
+		countUpload(format, uint64_t(w) * h);
+	}
+
+	auto NullTexture2D::setData(const void *pixels) -> void
+	{
+		countUpload(format, uint64_t(width) * height);
+	}
+
+	NullTexture3D::NullTexture3D(uint32_t width, uint32_t height, uint32_t depth, TextureParameters parameters, TextureLoadOptions loadOptions) :
+	    width(width),
+	    height(height),
+	    depth(depth),
+	    parameters(parameters)
+	{
+	}
+
+	auto NullTexture3D::buildTexture3D(TextureFormat format, uint32_t width, uint32_t height, uint32_t depth) -> void
+	{
+		this->width             = width;
+		this->height            = height;
+		this->depth             = depth;
+		this->parameters.format = format;
+	}
+
+	NullTextureCube::NullTextureCube(uint32_t size) :
+	    size(size)
+	{
+	}
+
+	NullTextureCube::NullTextureCube(uint32_t size, TextureFormat format, int32_t numMips) :
+	    size(size),
+	    numMips(numMips),
+	    format(format)
+	{
+	}
+
+	NullTextureCube::NullTextureCube(const std::string &filePath) :
+	    filePath(filePath)
+	{
+		size = load({filePath});
+	}
+
+	NullTextureCube::NullTextureCube(const std::array<std::string, 6> &files) :
+	    filePath(files[0])
+	{
+		size = load({files.begin(), files.end()});
+	}
+
+	NullTextureCube::NullTextureCube(const std::vector<std::string> &files, uint32_t mips, const TextureParameters &params, const TextureLoadOptions &loadOptions, const InputFormat &inputFormat) :
+	    numMips(mips),
+	    format(params.format)
+	{
+		if (!files.empty())
+			filePath = files[0];
+
+		//the faces are laid out 3 wide in a vertical cross and 4 wide in a horizontal one
+		size = load({files.begin(), files.begin() + std::min<size_t>(files.size(), mips)});
+		size /= inputFormat == InputFormat::VERTICAL_CROSS ? 3 : 4;
+	}
+
+	auto NullTextureCube::load(const std::vector<std::string> &files) -> uint32_t
+	{
+		PROFILE_FUNCTION();
+		uint32_t width = 0;
+		for (auto &file : files)
+		{
+			auto pixels = ImageLoader::loadAsset(file, false, false);
+			if (NullContext::validate(pixels != nullptr, "Cube map face {0} could not be loaded", file))
+			{
+				if (width == 0)
+					width = pixels->getWidth();
+				NullContext::count(NullCounter::BytesUploaded, pixels->getImageSize());
+			}
+		}
+		return width;
+	}
+
+	NullTextureDepth::NullTextureDepth(uint32_t width, uint32_t height, bool stencil) :
+	    stencil(stencil),
+	    width(width),
+	    height(height)
+	{
+	}
+
+	auto NullTextureDepth::resize(uint32_t width, uint32_t height, const CommandBuffer *commandBuffer) -> void
+	{
+		this->width  = width;
+		this->height = height;
+	}
+
+	NullTextureDepthArray::NullTextureDepthArray(uint32_t width, uint32_t height, uint32_t count) :
+	    width(width),
+	    height(height),
+	    count(count)
+	{
+	}
+
+	auto NullTextureDepthArray::resize(uint32_t width, uint32_t height, uint32_t count, const CommandBuffer *commandBuffer) -> void
+	{
+		this->width  = width;
+		this->height = height;
+		this->count  = count;
+	}
+
+	NullTexture2DArray::NullTexture2DArray(uint32_t width, uint32_t height, uint32_t count, TextureFormat format, TextureParameters parameters) :
+	    width(width),
+	    height(height),
+	    count(count),
+	    format(format),
+	    parameters(parameters)
+	{
+	}
+
+	auto NullTexture2DArray::resize(uint32_t width, uint32_t height, uint32_t count, const CommandBuffer *commandBuffer) -> void
+	{
+		this->width  = width;
+		this->height = height;
+		this->count  = count;
+	}
+}        // namespace maple
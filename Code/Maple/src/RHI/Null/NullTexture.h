@@ -0,0 +1,350 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include "RHI/Texture.h"
+#include <array>
+
+namespace maple
+{
+	//textures of the null backend only keep their description, the handle is the texture itself so it stays unique
+	class NullTexture2D : public Texture2D
+	{
+	  public:
+		NullTexture2D(uint32_t width, uint32_t height, const void *data, TextureParameters parameters = TextureParameters(), TextureLoadOptions loadOptions = TextureLoadOptions());
+		NullTexture2D(const std::string &name, const std::string &fileName, TextureParameters parameters = TextureParameters(), TextureLoadOptions loadOptions = TextureLoadOptions());
+		NullTexture2D();
+
+		auto bind(uint32_t slot) const -> void override{};
+		auto unbind(uint32_t slot) const -> void override{};
+		auto buildTexture(TextureFormat internalformat, uint32_t width, uint32_t height, bool srgb, bool depth, bool samplerShadow, bool mipmap, bool image, uint32_t accessFlag) -> void override;
+		auto update(uint32_t x, uint32_t y, uint32_t w, uint32_t h, const void *buffer) -> void override;
+		auto setData(const void *pixels) -> void override;
+		auto reload() -> bool override;
+
+		inline auto getHandle() -> void * override
+		{
+			return this;
+		}
+
+		inline auto getWidth() const -> uint32_t override
+		{
+			return width;
+		}
+
+		inline auto getHeight() const -> uint32_t override
+		{
+			return height;
+		}
+
+		inline auto getFilePath() const -> const std::string & override
+		{
+			return fileName;
+		}
+
+		inline auto getParameters() const -> TextureParameters override
+		{
+			return parameters;
+		}
+
+		inline auto getLoadOptions() const -> TextureLoadOptions override
+		{
+			return loadOptions;
+		}
+
+		inline auto getFormat() const -> TextureFormat override
+		{
+			return format;
+		}
+
+		inline auto getPath() const -> std::string override
+		{
+			return fileName;
+		}
+
+		inline auto getMipMapLevels() const -> uint32_t override
+		{
+			return mipLevels;
+		}
+
+		auto toIntID() const -> const uint64_t override
+		{
+			return reinterpret_cast<uint64_t>(this);
+		};
+
+	  private:
+		uint32_t           width     = 0;
+		uint32_t           height    = 0;
+		uint32_t           mipLevels = 1;
+		std::string        fileName;
+		TextureFormat      format = TextureFormat::RGBA8;
+		TextureParameters  parameters;
+		TextureLoadOptions loadOptions;
+	};
+
+	class NullTexture3D : public Texture3D
+	{
+	  public:
+		NullTexture3D(uint32_t width, uint32_t height, uint32_t depth, TextureParameters parameters, TextureLoadOptions loadOptions);
+
+		auto bind(uint32_t slot = 0) const -> void override{};
+		auto unbind(uint32_t slot = 0) const -> void override{};
+		auto generateMipmaps(const CommandBuffer *cmd) -> void override{};
+		auto buildTexture3D(TextureFormat format, uint32_t width, uint32_t height, uint32_t depth) -> void override;
+
+		inline auto getFilePath() const -> const std::string & override
+		{
+			return name;
+		};
+
+		inline auto getHandle() -> void * override
+		{
+			return this;
+		}
+
+		inline auto getWidth() const -> uint32_t override
+		{
+			return width;
+		}
+
+		inline auto getHeight() const -> uint32_t override
+		{
+			return height;
+		}
+
+		inline auto getDepth() const -> uint32_t
+		{
+			return depth;
+		}
+
+		inline auto getFormat() const -> TextureFormat override
+		{
+			return parameters.format;
+		}
+
+		auto toIntID() const -> const uint64_t override
+		{
+			return reinterpret_cast<uint64_t>(this);
+		};
+
+	  private:
+		uint32_t          width  = 0;
+		uint32_t          height = 0;
+		uint32_t          depth  = 0;
+		TextureParameters parameters;
+	};
+
+	class NullTextureCube : public TextureCube
+	{
+	  public:
+		NullTextureCube(uint32_t size);
+		NullTextureCube(uint32_t size, TextureFormat format, int32_t numMips);
+		NullTextureCube(const std::string &filePath);
+		NullTextureCube(const std::array<std::string, 6> &files);
+		NullTextureCube(const std::vector<std::string> &files, uint32_t mips, const TextureParameters &params, const TextureLoadOptions &loadOptions, const InputFormat &format);
+
+		auto bind(uint32_t slot = 0) const -> void override{};
+		auto unbind(uint32_t slot = 0) const -> void override{};
+		auto update(const CommandBuffer *commandBuffer, FrameBuffer *framebuffer, int32_t cubeIndex, int32_t mipmapLevel = 0) -> void override{};
+		auto generateMipmap(const CommandBuffer *commandBuffer) -> void override{};
+
+		inline auto getHandle() -> void * override
+		{
+			return this;
+		}
+
+		inline auto getMipMapLevels() const -> uint32_t override
+		{
+			return numMips;
+		}
+
+		inline auto getSize() const -> uint32_t override
+		{
+			return size;
+		}
+
+		inline auto getFilePath() const -> const std::string & override
+		{
+			return filePath;
+		}
+
+		inline auto getWidth() const -> uint32_t override
+		{
+			return size;
+		}
+
+		inline auto getHeight() const -> uint32_t override
+		{
+			return size;
+		}
+
+		inline auto getFormat() const -> TextureFormat override
+		{
+			return format;
+		}
+
+		auto toIntID() const -> const uint64_t override
+		{
+			return reinterpret_cast<uint64_t>(this);
+		};
+
+	  private:
+		//decodes the faces like the other backends do and counts them as uploaded, returns the width of the first image
+		auto load(const std::vector<std::string> &files) -> uint32_t;
+
+		uint32_t      size    = 0;
+		uint32_t      numMips = 1;
+		std::string   filePath;
+		TextureFormat format = TextureFormat::RGBA8;
+	};
+
+	class NullTextureDepth : public TextureDepth
+	{
+	  public:
+		NullTextureDepth(uint32_t width, uint32_t height, bool stencil = false);
+
+		auto bind(uint32_t slot = 0) const -> void override{};
+		auto unbind(uint32_t slot = 0) const -> void override{};
+		auto resize(uint32_t width, uint32_t height, const CommandBuffer *commandBuffer) -> void override;
+
+		inline auto getHandle() -> void * override
+		{
+			return this;
+		}
+
+		inline auto getFilePath() const -> const std::string & override
+		{
+			return name;
+		}
+
+		inline auto getWidth() const -> uint32_t override
+		{
+			return width;
+		}
+
+		inline auto getHeight() const -> uint32_t override
+		{
+			return height;
+		}
+
+		inline auto getFormat() const -> TextureFormat override
+		{
+			return stencil ? TextureFormat::DEPTH_STENCIL : TextureFormat::DEPTH;
+		}
+
+		auto toIntID() const -> const uint64_t override
+		{
+			return reinterpret_cast<uint64_t>(this);
+		};
+
+	  private:
+		bool     stencil = false;
+		uint32_t width   = 0;
+		uint32_t height  = 0;
+	};
+
+	class NullTextureDepthArray : public TextureDepthArray
+	{
+	  public:
+		NullTextureDepthArray(uint32_t width, uint32_t height, uint32_t count);
+
+		auto bind(uint32_t slot = 0) const -> void override{};
+		auto unbind(uint32_t slot = 0) const -> void override{};
+		auto init(const CommandBuffer *commandBuffer = nullptr) -> void override{};
+		auto resize(uint32_t width, uint32_t height, uint32_t count, const CommandBuffer *commandBuffer = nullptr) -> void override;
+
+		inline auto getHandle() -> void * override
+		{
+			return this;
+		}
+
+		inline auto getFilePath() const -> const std::string & override
+		{
+			return name;
+		}
+
+		inline auto getWidth() const -> uint32_t override
+		{
+			return width;
+		}
+
+		inline auto getHeight() const -> uint32_t override
+		{
+			return height;
+		}
+
+		inline auto getFormat() const -> TextureFormat override
+		{
+			return TextureFormat::DEPTH;
+		}
+
+		inline auto getCount() const -> uint32_t
+		{
+			return count;
+		}
+
+		auto toIntID() const -> const uint64_t override
+		{
+			return reinterpret_cast<uint64_t>(this);
+		};
+
+	  private:
+		uint32_t width  = 0;
+		uint32_t height = 0;
+		uint32_t count  = 0;
+	};
+
+	class NullTexture2DArray : public Texture2DArray
+	{
+	  public:
+		NullTexture2DArray(uint32_t width, uint32_t height, uint32_t count, TextureFormat format, TextureParameters parameters);
+
+		auto bind(uint32_t slot = 0) const -> void override{};
+		auto unbind(uint32_t slot = 0) const -> void override{};
+		auto init(const CommandBuffer *commandBuffer = nullptr) -> void override{};
+		auto resize(uint32_t width, uint32_t height, uint32_t count, const CommandBuffer *commandBuffer = nullptr) -> void override;
+
+		inline auto getHandle() -> void * override
+		{
+			return this;
+		}
+
+		inline auto getFilePath() const -> const std::string & override
+		{
+			return name;
+		}
+
+		inline auto getWidth() const -> uint32_t override
+		{
+			return width;
+		}
+
+		inline auto getHeight() const -> uint32_t override
+		{
+			return height;
+		}
+
+		inline auto getFormat() const -> TextureFormat override
+		{
+			return format;
+		}
+
+		inline auto getCount() const -> uint32_t
+		{
+			return count;
+		}
+
+		auto toIntID() const -> const uint64_t override
+		{
+			return reinterpret_cast<uint64_t>(this);
+		};
+
+	  private:
+		uint32_t          width  = 0;
+		uint32_t          height = 0;
+		uint32_t          count  = 0;
+		TextureFormat     format = TextureFormat::RGBA8;
+		TextureParameters parameters;
+	};
+}        // namespace maple
@@ -0,0 +1,32 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "NullUniformBuffer.h"
+#include "NullContext.h"
+
+#include <cstring>
+
+namespace maple
+{
+	auto NullUniformBuffer::init(uint32_t size, const void *data) -> void
+	{
+		buffer.assign(size, 0);
+		if (data != nullptr)
+			setData(size, data);
+	}
+
+	auto NullUniformBuffer::setData(uint32_t size, const void *data) -> void
+	{
+		if (size > buffer.size())
+			buffer.resize(size);
+
+		std::memcpy(buffer.data(), data, size);
+		NullContext::count(NullCounter::BytesUploaded, size);
+	}
+
+	auto NullUniformBuffer::setDynamicData(uint32_t size, uint32_t typeSize, const void *data) -> void
+	{
+		setData(size, data);
+	}
+}        // namespace maple
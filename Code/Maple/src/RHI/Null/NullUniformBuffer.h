@@ -0,0 +1,38 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include "RHI/UniformBuffer.h"
+#include <vector>
+
+namespace maple
+{
+	class NullUniformBuffer : public UniformBuffer
+	{
+	  public:
+		NullUniformBuffer() = default;
+
+		auto init(uint32_t size, const void *data) -> void override;
+		auto setData(uint32_t size, const void *data) -> void override;
+		auto setDynamicData(uint32_t size, uint32_t typeSize, const void *data) -> void override;
+
+		inline auto setData(const void *data) -> void override
+		{
+			setData(static_cast<uint32_t>(buffer.size()), data);
+		}
+
+		inline auto getBuffer() const -> uint8_t * override
+		{
+			return const_cast<uint8_t *>(buffer.data());
+		};
+
+		inline auto getSize() const
+		{
+			return static_cast<uint32_t>(buffer.size());
+		}
+
+	  private:
+		std::vector<uint8_t> buffer;
+	};
+}        // namespace maple
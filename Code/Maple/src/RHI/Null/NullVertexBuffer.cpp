@@ -0,0 +1,69 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "NullVertexBuffer.h"
+#include "Engine/Profiler.h"
+#include "NullContext.h"
+#include "RHI/CommandBuffer.h"
+
+#include <cstring>
+
+namespace maple
+{
+	NullVertexBuffer::NullVertexBuffer(BufferUsage usage) :
+	    usage(usage)
+	{
+	}
+
+	NullVertexBuffer::NullVertexBuffer(const void *data, uint32_t size) :
+	    usage(BufferUsage::Static)
+	{
+		setData(size, data);
+	}
+
+	auto NullVertexBuffer::resize(uint32_t size) -> void
+	{
+		buffer.resize(size);
+	}
+
+	auto NullVertexBuffer::setData(uint32_t size, const void *data) -> void
+	{
+		PROFILE_FUNCTION();
+		buffer.resize(size);
+		if (data != nullptr)
+			std::memcpy(buffer.data(), data, size);
+		NullContext::count(NullCounter::BytesUploaded, size);
+	}
+
+	auto NullVertexBuffer::setDataSub(uint32_t size, const void *data, uint32_t offset) -> void
+	{
+		PROFILE_FUNCTION();
+		if (!NullContext::validate(offset + size <= buffer.size(), "Vertex buffer write of {0} bytes at {1} overflows {2} bytes", size, offset, buffer.size()))
+			return;
+
+		std::memcpy(buffer.data() + offset, data, size);
+		NullContext::count(NullCounter::BytesUploaded, size);
+	}
+
+	auto NullVertexBuffer::getPointerInternal() -> void *
+	{
+		NullContext::validate(!mapped, "Vertex buffer is mapped twice");
+		mapped = true;
+		return buffer.data();
+	}
+
+	auto NullVertexBuffer::releasePointer() -> void
+	{
+		//a mapped buffer is flushed as a whole
+		if (mapped)
+			NullContext::count(NullCounter::BytesUploaded, buffer.size());
+		mapped = false;
+	}
+
+	auto NullVertexBuffer::bind(const CommandBuffer *commandBuffer, Pipeline *pipeline, uint32_t binding) -> void
+	{
+		NullContext::validate(commandBuffer != nullptr && commandBuffer->isRecording(), "Vertex buffer bound to a command buffer which is not recording");
+		NullContext::validate(!mapped, "Vertex buffer is bound while it is mapped");
+	}
+}        // namespace maple
@@ -0,0 +1,38 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "RHI/VertexBuffer.h"
+#include <vector>
+
+namespace maple
+{
+	class NullVertexBuffer : public VertexBuffer
+	{
+	  public:
+		explicit NullVertexBuffer(BufferUsage usage);
+		explicit NullVertexBuffer(const void *data, uint32_t size);
+
+		auto resize(uint32_t size) -> void override;
+		auto setData(uint32_t size, const void *data) -> void override;
+		auto setDataSub(uint32_t size, const void *data, uint32_t offset) -> void override;
+		auto releasePointer() -> void override;
+		auto bind(const CommandBuffer *commandBuffer, Pipeline *pipeline, uint32_t binding = 0) -> void override;
+		auto unbind() -> void override{};
+
+		auto getSize() -> uint64_t override
+		{
+			return buffer.size();
+		}
+
+	  protected:
+		auto getPointerInternal() -> void * override;
+
+	  private:
+		BufferUsage          usage;
+		std::vector<uint8_t> buffer;
+		bool                 mapped = false;
+	};
+}        // namespace maple
@@ -33,11 +33,19 @@ namespace maple
 				localStorage.initializeEmpty();
 
 				UniformBufferInfo info;
+				info.name          = descriptor.name;
 				info.uniformBuffer = buffer;
 				info.localStorage  = localStorage;
 				info.dirty         = false;
 				info.members       = descriptor.members;
-				uniformBuffers.emplace(descriptor.name, info);
+
+				const auto index = static_cast<uint32_t>(uniformBuffers.size());
+				for (auto &member : info.members)
+				{
+					if (!uniformHandles.emplace(UniformId(descriptor.name, member.name).hash, UniformHandle{index, member.offset, member.size}).second)
+						LOGW("Uniform {0}.{1} is declared twice or its name hash collides", descriptor.name, member.name);
+				}
+				uniformBuffers.emplace_back(std::move(info));
 			}
 			else if (descriptor.type == DescriptorType::Buffer)
 			{
@@ -51,10 +59,10 @@ namespace maple
 
 		for (auto &bufferInfo : uniformBuffers)
 		{
-			if (bufferInfo.second.dirty)
+			if (bufferInfo.dirty)
 			{
-				bufferInfo.second.uniformBuffer->setData(bufferInfo.second.localStorage.data);
-				bufferInfo.second.dirty = false;
+				bufferInfo.uniformBuffer->setData(bufferInfo.localStorage.data);
+				bufferInfo.dirty = false;
 			}
 		}
 	}
@@ -96,48 +104,38 @@ namespace maple
 		LOGW("Buffer not found {0}", name);
 	}
 
-	auto GLDescriptorSet::setUniform(const std::string &bufferName, const std::string &uniformName, const void *data, bool dynamic) -> void
+	auto GLDescriptorSet::getUniformHandle(const UniformId &id) const -> UniformHandle
 	{
-		PROFILE_FUNCTION();
-
-		if (auto iter = uniformBuffers.find(bufferName); iter != uniformBuffers.end())
-		{
-			for (auto &member : iter->second.members)
-			{
-				if (member.name == uniformName)
-				{
-					iter->second.localStorage.write(data, member.size, member.offset);
-					iter->second.dirty = true;
-					return;
-				}
-			}
-		}
+		if (auto iter = uniformHandles.find(id.hash); iter != uniformHandles.end())
+			return iter->second;
+		return {};
+	}
 
-		LOGW("Uniform not found {0}.{1}", bufferName, uniformName);
+	auto GLDescriptorSet::setUniform(const UniformHandle &handle, const void *data, bool dynamic) -> void
+	{
+		setUniform(handle, data, handle.size, dynamic);
 	}
 
-	auto GLDescriptorSet::setUniform(const std::string &bufferName, const std::string &uniformName, const void *data, uint32_t size, bool dynamic) -> void
+	auto GLDescriptorSet::setUniform(const UniformHandle &handle, const void *data, uint32_t size, bool dynamic) -> void
 	{
-		PROFILE_FUNCTION();
+		if (handle.buffer >= uniformBuffers.size())
+			return;
 
-		if (auto iter = uniformBuffers.find(bufferName); iter != uniformBuffers.end())
+		//a write larger than the member would overwrite the ones after it
+		auto &bufferInfo = uniformBuffers[handle.buffer];
+		if (size > handle.size || handle.offset + size > bufferInfo.localStorage.getSize())
 		{
-			for (auto &member : iter->second.members)
-			{
-				if (member.name == uniformName)
-				{
-					iter->second.localStorage.write(data, size, member.offset);
-					iter->second.dirty = true;
-					return;
-				}
-			}
+			LOGW("Uniform write out of range in {0}, offset {1} size {2} member size {3}", bufferInfo.name, handle.offset, size, handle.size);
+			return;
 		}
-		LOGW("Uniform not found {0}.{1}", bufferName, uniformName);
-	}
 
+		bufferInfo.localStorage.write(data, size, handle.offset);
+		bufferInfo.dirty = true;
+	}
 
 	auto GLDescriptorSet::setStorageBuffer(const std::string &name, std::shared_ptr<StorageBuffer> buffer) -> void
 	{
+		storageBuffers[name] = std::static_pointer_cast<GLStorageBuffer>(buffer);
 	}
 
 	auto GLDescriptorSet::setStorageBuffer(const std::string &name, std::shared_ptr<VertexBuffer> buffer) -> void
@@ -164,11 +162,14 @@ namespace maple
 	{
 		PROFILE_FUNCTION();
 
-		if (auto iter = uniformBuffers.find(bufferName); iter != uniformBuffers.end())
+		for (auto &bufferInfo : uniformBuffers)
 		{
-			iter->second.localStorage.write(data, iter->second.localStorage.getSize(), 0);
-			iter->second.dirty = true;
-			return;
+			if (bufferInfo.name == bufferName)
+			{
+				bufferInfo.localStorage.write(data, bufferInfo.localStorage.getSize(), 0);
+				bufferInfo.dirty = true;
+				return;
+			}
 		}
 
 		LOGW("Uniform not found {0}.", bufferName);
@@ -295,7 +296,10 @@ namespace maple
 			}
 			else if (descriptor.type == DescriptorType::Buffer)
 			{
-				
+				if (auto iter = storageBuffers.find(descriptor.name); iter != storageBuffers.end() && iter->second)
+				{
+					iter->second->bind(descriptor.binding);
+				}
 			}
 			else
 			{
@@ -7,12 +7,14 @@
 #include "Engine/Buffer.h"
 #include "RHI/DescriptorSet.h"
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 namespace maple
 {
 	class GLShader;
 	class StorageBuffer;
+	class GLStorageBuffer;
 
 	class GLDescriptorSet : public DescriptorSet
 	{
@@ -25,8 +27,10 @@ namespace maple
 		auto setTexture(const std::string &name, const std::vector<std::shared_ptr<Texture>> &textures, int32_t mipLevel = -1) -> void override;
 		auto setTexture(const std::string &name, const std::shared_ptr<Texture> &textures, int32_t mipLevel = -1) -> void override;
 		auto setBuffer(const std::string &name, const std::shared_ptr<UniformBuffer> &buffer) -> void override;
-		auto setUniform(const std::string &bufferName, const std::string &uniformName, const void *data, bool dynamic) -> void override;
-		auto setUniform(const std::string &bufferName, const std::string &uniformName, const void *data, uint32_t size, bool dynamic) -> void override;
+		using DescriptorSet::setUniform;
+		auto getUniformHandle(const UniformId &id) const -> UniformHandle override;
+		auto setUniform(const UniformHandle &handle, const void *data, bool dynamic) -> void override;
+		auto setUniform(const UniformHandle &handle, const void *data, uint32_t size, bool dynamic) -> void override;
 		auto setUniformBufferData(const std::string &bufferName, const void *data) -> void override;
 		auto getUnifromBuffer(const std::string &name) -> std::shared_ptr<UniformBuffer> override;
 		auto bind(uint32_t offset = 0) -> void;
@@ -69,12 +73,15 @@ namespace maple
 
 		struct UniformBufferInfo
 		{
+			std::string                    name;
 			std::shared_ptr<UniformBuffer> uniformBuffer;
 			std::vector<BufferMemberInfo>  members;
 			Buffer                         localStorage;
 			bool                           dirty;
 		};
 
-		std::unordered_map<std::string, UniformBufferInfo> uniformBuffers;
+		std::vector<UniformBufferInfo>                                    uniformBuffers;
+		std::unordered_map<uint64_t, UniformHandle>                       uniformHandles;        //UniformId::hash
+		std::unordered_map<std::string, std::shared_ptr<GLStorageBuffer>> storageBuffers;
 	};
 }        // namespace maple
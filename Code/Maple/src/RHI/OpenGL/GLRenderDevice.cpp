@@ -349,6 +349,12 @@ namespace maple
 		GLCall(glDrawElements(drawTypeToGL(type), count, dataTypeToGL(DataType::UnsignedInt), (void *) (sizeof(uint32_t) * start)));
 	}
 
+	auto GLRenderDevice::drawIndexedInstancedInternal(const CommandBuffer *commandBuffer, const DrawType type, uint32_t count, uint32_t instanceCount, uint32_t start) const -> void
+	{
+		PROFILE_FUNCTION();
+		GLCall(glDrawElementsInstanced(drawTypeToGL(type), count, dataTypeToGL(DataType::UnsignedInt), (void *) (sizeof(uint32_t) * start), instanceCount));
+	}
+
 	auto GLRenderDevice::drawArraysInternal(const CommandBuffer *commandBuffer, DrawType type, uint32_t count, uint32_t start /*= 0*/) const -> void
 	{
 		PROFILE_FUNCTION();
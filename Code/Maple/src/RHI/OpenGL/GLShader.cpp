@@ -230,14 +230,18 @@ namespace maple
 	}
 
 	auto GLShader::bindPushConstants(const CommandBuffer *cmdBuffer, Pipeline *pipeline) -> void
+	{
+		bindPushConstants(cmdBuffer, pipeline, pushConstants);
+	}
+
+	auto GLShader::bindPushConstants(const CommandBuffer *cmdBuffer, Pipeline *pipeline, const std::vector<PushConstant> &constants) -> void
 	{
 		PROFILE_FUNCTION();
-		int index = 0;
-		for (auto &constants : pushConstants)
+		for (auto &constant : constants)
 		{
-			for (auto &member : constants.members)
+			for (auto &member : constant.members)
 			{
-				setUniform(member.type, constants.data.data(), member.size, member.offset, member.fullName);
+				setUniform(member.type, constant.data.data(), member.size, member.offset, member.fullName);
 			}
 		}
 	}
@@ -513,6 +517,22 @@ namespace maple
 			}
 		}
 
+		for (auto &resource : resources.storage_buffers)
+		{
+			uint32_t set     = glsl->get_decoration(resource.id, spv::DecorationDescriptorSet);
+			uint32_t binding = glsl->get_decoration(resource.id, spv::DecorationBinding);
+
+			auto &descriptorInfo = descriptorInfos[set];
+			auto &descriptor     = descriptorInfo.emplace_back();
+
+			descriptor.offset     = 0;
+			descriptor.size       = 0;
+			descriptor.binding    = binding;
+			descriptor.name       = resource.name;
+			descriptor.shaderType = type;
+			descriptor.type       = DescriptorType::Buffer;
+		}
+
 		for (auto &u : resources.push_constant_buffers)
 		{
 			auto &pushConstantType = glsl->get_type(u.type_id);
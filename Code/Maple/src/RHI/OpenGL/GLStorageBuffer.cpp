@@ -80,6 +80,6 @@ namespace maple
 	{
 		PROFILE_SCOPE("glMapBuffer");
 		GLCall(glBindBuffer(GL_SHADER_STORAGE_BUFFER, handle));
-		return glMapBuffer(GL_SHADER_STORAGE_BUFFER, GL_WRITE_ONLY);
+		return glMapBuffer(GL_SHADER_STORAGE_BUFFER, GL_READ_WRITE);
 	}
 }        // namespace maple
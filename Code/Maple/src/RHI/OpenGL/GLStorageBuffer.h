@@ -26,6 +26,11 @@ namespace maple
 		{
 			return 0;
 		}
+		//glMapBuffer without GL_MAP_FLUSH_EXPLICIT_BIT is coherent once the buffer is unmapped
+		auto invalidate() -> void override
+		{}
+		auto flush() -> void override
+		{}
 	  private:
 		uint32_t handle{};
 		uint32_t size = 0;
@@ -214,6 +214,27 @@ namespace maple
 		GLCall(glDeleteTextures(1, &handle));
 	}
 
+	auto GLTexture2D::reload() -> bool
+	{
+		PROFILE_FUNCTION();
+		if (fileName.empty())
+			return false;
+
+		auto pixels = ImageLoader::loadAsset(fileName, loadOptions.generateMipMaps, loadOptions.flipY);
+		if (pixels == nullptr)
+			return false;
+
+		GLCall(glDeleteTextures(1, &handle));
+		format            = pixels->getPixelFormat();
+		width             = pixels->getWidth();
+		height            = pixels->getHeight();
+		isHDR             = pixels->isHDR();
+		parameters.format = format;
+		load(pixels->getData());
+		generation++;
+		return true;
+	}
+
 	auto GLTexture2D::load(const void *data) -> void
 	{
 		PROFILE_FUNCTION();
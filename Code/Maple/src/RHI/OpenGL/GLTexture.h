@@ -21,6 +21,7 @@ namespace maple
 		auto buildTexture(TextureFormat internalformat, uint32_t width, uint32_t height, bool srgb, bool depth, bool samplerShadow, bool mipmap, bool image, uint32_t accessFlag) -> void override;
 		auto bindImageTexture(uint32_t unit, bool read = false, bool write = false, uint32_t level = 0, uint32_t layer = 0, TextureFormat format = TextureFormat::NONE) -> void override;
 		auto update(uint32_t x, uint32_t y, uint32_t w, uint32_t h, const void *buffer) -> void override;
+		auto reload() -> bool override;
 
 		auto setData(const void *pixels) -> void;
 
@@ -44,6 +45,16 @@ namespace maple
 			return fileName;
 		}
 
+		inline auto getParameters() const -> TextureParameters override
+		{
+			return parameters;
+		}
+
+		inline auto getLoadOptions() const -> TextureLoadOptions override
+		{
+			return loadOptions;
+		}
+
 		inline auto getType() const -> TextureType override
 		{
 			return TextureType::Color;
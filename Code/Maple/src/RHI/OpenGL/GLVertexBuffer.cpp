@@ -100,7 +100,7 @@ namespace maple
 		}
 	}
 
-	auto GLVertexBuffer::bind(const CommandBuffer *commandBuffer, Pipeline *pipeline) -> void
+	auto GLVertexBuffer::bind(const CommandBuffer *commandBuffer, Pipeline *pipeline, uint32_t binding) -> void
 	{
 		PROFILE_FUNCTION();
 		GLCall(glBindBuffer(GL_ARRAY_BUFFER, handle));
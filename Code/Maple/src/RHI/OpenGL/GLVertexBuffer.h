@@ -19,7 +19,7 @@ namespace maple
 		auto setData(uint32_t size, const void *data) -> void override;
 		auto setDataSub(uint32_t size, const void *data, uint32_t offset) -> void override;
 		auto releasePointer() -> void override;
-		auto bind(const CommandBuffer *commandBuffer, Pipeline *pipeline) -> void override;
+		auto bind(const CommandBuffer *commandBuffer, Pipeline *pipeline, uint32_t binding = 0) -> void override;
 		auto unbind() -> void override;
 		auto getSize() -> uint64_t override
 		{
@@ -22,6 +22,21 @@ namespace maple
 
 	class DescriptorSet;
 
+	//what Pipeline::request does with a draw whose pipeline is still compiling
+	enum class PipelineMissPolicy : uint8_t
+	{
+		Wait,            //wait while the waitBudget of the frame lasts, then skip the draw
+		Skip,            //skip the draw until the pipeline is ready
+		Fallback         //draw with the fallback pipeline given by the caller
+	};
+
+	struct PipelineCompileSettings
+	{
+		bool               async      = true;        //compile graphics pipelines on the job system
+		PipelineMissPolicy policy     = PipelineMissPolicy::Wait;
+		float              waitBudget = 2.f;        //ms, for all the draws of one frame together
+	};
+
 	class MAPLE_EXPORT Pipeline
 	{
 	  public:
@@ -30,8 +45,34 @@ namespace maple
 		static auto get(const PipelineInfo &pipelineDesc) -> std::shared_ptr<Pipeline>;
 		static auto get(const PipelineInfo &pipelineDesc, const std::vector<std::shared_ptr<DescriptorSet>> &sets, capture_graph::component::RenderGraph &) -> std::shared_ptr<Pipeline>;
 
+		/**
+		 * Resolve the pipeline of a single draw following PipelineCompileSettings::policy.
+		 * nullptr means the draw has to be skipped this frame. Pipelines returned by get are
+		 * waited for when they are bound, so only draws which can be dropped should use request.
+		 */
+		static auto request(const PipelineInfo &pipelineDesc, const PipelineInfo *fallback = nullptr) -> std::shared_ptr<Pipeline>;
+
+		//compile the pipelines recorded by the last session in the background
+		static auto prewarm() -> void;
+
+		//main thread, once per frame before anything is recorded. restarts the wait budget
+		static auto newFrame() -> void;
+
+		static auto getCompileSettings() -> PipelineCompileSettings &;
+
 		virtual ~Pipeline() = default;
 
+		virtual auto isReady() const -> bool
+		{
+			return true;
+		}
+
+		//budget in ms, negative waits until the pipeline is compiled. returns isReady()
+		virtual auto waitReady(float budget = -1.f) -> bool
+		{
+			return true;
+		}
+
 		virtual auto getWidth() -> uint32_t                                                                                                        = 0;
 		virtual auto getHeight() -> uint32_t                                                                                                       = 0;
 		virtual auto getShader() const -> std::shared_ptr<Shader>                                                                                  = 0;
@@ -39,6 +80,15 @@ namespace maple
 		virtual auto end(const CommandBuffer *commandBuffer) -> void                                                                               = 0;
 		virtual auto clearRenderTargets(const CommandBuffer *commandBuffer) -> void{};
 
+		//begin the render pass whose draws are recorded in secondary command buffers, nullptr if the backend only records inline
+		virtual auto bindSecondary(const CommandBuffer *commandBuffer, uint32_t layer = 0) -> FrameBuffer *
+		{
+			return nullptr;
+		}
+
+		//start a secondary command buffer which continues the render pass began by bindSecondary
+		virtual auto beginSecondary(CommandBuffer *secondary, FrameBuffer *framebuffer) -> void{};
+
 		virtual auto traceRays(const CommandBuffer *commandBuffer, uint32_t width, uint32_t height, uint32_t depth) -> void{};
 
 	  protected:
@@ -11,6 +11,10 @@
 #	include "RHI/OpenGL/GLRenderDevice.h"
 #endif
 
+#ifdef MAPLE_NULL
+#	include "RHI/Null/NullRenderDevice.h"
+#endif
+
 #include "RHI/FrameBuffer.h"
 #include "RHI/RenderPass.h"
 
@@ -46,6 +50,16 @@ namespace maple
 		Application::getRenderDevice()->drawIndexedInternal(commandBuffer, type, count, start);
 	}
 
+	auto RenderDevice::drawIndexedInstanced(const CommandBuffer *commandBuffer, DrawType type, uint32_t count, uint32_t instanceCount, uint32_t start) -> void
+	{
+		Application::getRenderDevice()->drawIndexedInstancedInternal(commandBuffer, type, count, instanceCount, start);
+	}
+
+	auto RenderDevice::drawIndexedIndirect(const CommandBuffer *commandBuffer, StorageBuffer *args, uint32_t offset, uint32_t drawCount, uint32_t stride) -> void
+	{
+		Application::getRenderDevice()->drawIndexedIndirectInternal(commandBuffer, args, offset, drawCount, stride);
+	}
+
 	auto RenderDevice::drawArrays(const CommandBuffer *commandBuffer, DrawType type, uint32_t count, uint32_t start /*= 0*/) -> void
 	{
 		Application::getRenderDevice()->drawArraysInternal(commandBuffer, type, count, start);
@@ -85,5 +99,9 @@ namespace maple
 #ifdef MAPLE_OPENGL
 		return std::make_shared<GLRenderDevice>();
 #endif
+
+#ifdef MAPLE_NULL
+		return std::make_shared<NullRenderDevice>();
+#endif
 	}
 }        // namespace maple
@@ -38,9 +38,13 @@ namespace maple
 
 		virtual auto drawArraysInternal(const CommandBuffer *commandBuffer, DrawType type, uint32_t count, uint32_t start = 0) const -> void{};
 		virtual auto drawIndexedInternal(const CommandBuffer *commandBuffer, DrawType type, uint32_t count, uint32_t start = 0) const -> void{};
+		virtual auto drawIndexedInstancedInternal(const CommandBuffer *commandBuffer, DrawType type, uint32_t count, uint32_t instanceCount, uint32_t start = 0) const -> void{};
+		virtual auto drawIndexedIndirectInternal(const CommandBuffer *commandBuffer, StorageBuffer *args, uint32_t offset, uint32_t drawCount, uint32_t stride) const -> void{};
 		virtual auto drawInternal(const CommandBuffer *commandBuffer, DrawType type, uint32_t count, DataType dataType = DataType::UnsignedInt, const void *indices = nullptr) const -> void{};
 		virtual auto bindDescriptorSetsInternal(Pipeline *pipeline, const CommandBuffer *commandBuffer, uint32_t dynamicOffset, const std::vector<std::shared_ptr<DescriptorSet>> &descriptorSets) -> void{};
 		virtual auto clearRenderTarget(const std::shared_ptr<Texture> &texture, const CommandBuffer *commandBuffer, const glm::vec4 &clearColor = {0.3f, 0.3f, 0.3f, 1.0f}) -> void{};
+		//move the textures into the layouts of their states with as few barriers as possible
+		virtual auto transitionTextures(const CommandBuffer *commandBuffer, const std::vector<TextureTransition> &transitions) -> void{};
 		virtual auto clearInternal(uint32_t bufferMask) -> void{};
 
 		static auto clear(uint32_t bufferMask) -> void;
@@ -49,6 +53,8 @@ namespace maple
 		static auto bindDescriptorSets(Pipeline *pipeline, const CommandBuffer *commandBuffer, uint32_t dynamicOffset, const std::vector<std::shared_ptr<DescriptorSet>> &descriptorSets) -> void;
 		static auto draw(const CommandBuffer *commandBuffer, DrawType type, uint32_t count, DataType datayType = DataType::UnsignedInt, const void *indices = nullptr) -> void;
 		static auto drawIndexed(const CommandBuffer *commandBuffer, DrawType type, uint32_t count, uint32_t start = 0) -> void;
+		static auto drawIndexedInstanced(const CommandBuffer *commandBuffer, DrawType type, uint32_t count, uint32_t instanceCount, uint32_t start = 0) -> void;
+		static auto drawIndexedIndirect(const CommandBuffer *commandBuffer, StorageBuffer *args, uint32_t offset, uint32_t drawCount, uint32_t stride) -> void;
 		static auto drawArrays(const CommandBuffer *commandBuffer, DrawType type, uint32_t count, uint32_t start = 0) -> void;
 		static auto setStencilOp(StencilType fail, StencilType zfail, StencilType zpass) -> void;
 		static auto setStencilFunction(StencilType type, uint32_t ref, uint32_t mask) -> void;
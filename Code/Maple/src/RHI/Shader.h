@@ -5,12 +5,9 @@
 #include "DescriptorSet.h"
 #include "Engine/Core.h"
 #include "FileSystem/IResource.h"
+#include <spirv.hpp>
 #include <unordered_set>
 
-namespace spv
-{
-	enum ImageFormat;
-};
 namespace spirv_cross
 {
 	struct SPIRType;
@@ -113,6 +110,10 @@ namespace maple
 		virtual auto getHandle() const -> void *                                                       = 0;
 		virtual auto getPushConstants() -> std::vector<PushConstant> &                                 = 0;
 		virtual auto bindPushConstants(const CommandBuffer *commandBuffer, Pipeline *pipeline) -> void = 0;
+
+		//bind a copy of the push constants, so draws can be recorded on several threads
+		virtual auto bindPushConstants(const CommandBuffer *commandBuffer, Pipeline *pipeline, const std::vector<PushConstant> &constants) -> void = 0;
+
 		virtual auto getPushConstant(uint32_t index) -> PushConstant *
 		{
 			return nullptr;
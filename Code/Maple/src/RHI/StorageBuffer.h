@@ -51,5 +51,10 @@ namespace maple
 		virtual auto unmap() -> void                                            = 0;
 		virtual auto map() -> void *                                            = 0;
 		virtual auto getDeviceAddress() const -> uint64_t                       = 0;
+
+		//mapped memory which is not host coherent, e.g. MEMORY_USAGE_GPU_TO_CPU, has to be invalidated before
+		//reading what the gpu wrote and flushed after writing to it
+		virtual auto invalidate() -> void = 0;
+		virtual auto flush() -> void      = 0;
 	};
 }        // namespace maple
@@ -34,5 +34,11 @@ namespace maple
 		{
 			return nullptr;
 		};
+
+		//a new secondary command buffer from the pool of the calling thread, valid until this frame is recorded again
+		virtual auto getSecondaryCommandBuffer() -> CommandBuffer *
+		{
+			return nullptr;
+		}
 	};
 }        // namespace maple
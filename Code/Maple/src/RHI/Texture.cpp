@@ -2,6 +2,7 @@
 // This file is part of the Maple Engine                              		//
 //////////////////////////////////////////////////////////////////////////////
 #include "Texture.h"
+#include "Engine/Profiler.h"
 #include "Others/Console.h"
 
 #ifdef MAPLE_OPENGL
@@ -9,17 +10,27 @@
 #endif        // MAPLE_OPENGL
 
 #ifdef MAPLE_VULKAN
+#	include "RHI/Vulkan/VulkanDevice.h"
 #	include "RHI/Vulkan/VulkanTexture.h"
 #endif        // MAPLE_OPENGL
 
+#ifdef MAPLE_NULL
+#	include "RHI/Null/NullTexture.h"
+#endif        // MAPLE_NULL
+
 #include "Application.h"
+#include "Loaders/ImageLoader.h"
+#include "Loaders/ImportContext.h"
 #include "Loaders/Loader.h"
 
+#include <algorithm>
+#include <cstring>
+
 namespace maple
 {
 	auto Texture::memoryBarrier(const CommandBuffer *cmd, uint32_t flags) -> void
 	{
-#ifdef MAPLE_OPENGL
+#if defined(MAPLE_OPENGL) || defined(MAPLE_NULL)
 		Renderer::memoryBarrier(cmd, flags);
 #endif
 	}
@@ -77,6 +88,91 @@ namespace maple
 		return levels;
 	}
 
+	//box filtered, every level starts 4 byte aligned as VulkanUploadManager expects
+	auto Texture::buildMipChain(const uint8_t *pixels, uint32_t width, uint32_t height, uint32_t texelSize, uint32_t levels, std::vector<uint8_t> &data, std::vector<uint64_t> &offsets) -> void
+	{
+		PROFILE_FUNCTION();
+		offsets.resize(levels);
+		uint64_t size = 0;
+		for (uint32_t level = 0; level < levels; level++)
+		{
+			offsets[level] = size;
+			size += uint64_t(std::max(width >> level, 1u)) * std::max(height >> level, 1u) * texelSize;
+			size = (size + 3) & ~uint64_t(3);
+		}
+
+		data.resize(size);
+		std::memcpy(data.data(), pixels, uint64_t(width) * height * texelSize);
+
+		for (uint32_t level = 1; level < levels; level++)
+		{
+			const auto srcWidth  = std::max(width >> (level - 1), 1u);
+			const auto srcHeight = std::max(height >> (level - 1), 1u);
+			const auto dstWidth  = std::max(width >> level, 1u);
+			const auto dstHeight = std::max(height >> level, 1u);
+			const auto src       = data.data() + offsets[level - 1];
+			auto       dst       = data.data() + offsets[level];
+
+			for (uint32_t y = 0; y < dstHeight; y++)
+			{
+				const auto row0 = std::min(y * 2, srcHeight - 1) * srcWidth;
+				const auto row1 = std::min(y * 2 + 1, srcHeight - 1) * srcWidth;
+				for (uint32_t x = 0; x < dstWidth; x++)
+				{
+					const auto x0 = std::min(x * 2, srcWidth - 1);
+					const auto x1 = std::min(x * 2 + 1, srcWidth - 1);
+					for (uint32_t c = 0; c < texelSize; c++)
+					{
+						const uint32_t sum = src[(row0 + x0) * texelSize + c] + src[(row0 + x1) * texelSize + c] +
+						                     src[(row1 + x0) * texelSize + c] + src[(row1 + x1) * texelSize + c];
+						*dst++ = static_cast<uint8_t>((sum + 2) / 4);
+					}
+				}
+			}
+		}
+	}
+
+	auto Texture::getBlockSize(TextureFormat format) -> uint32_t
+	{
+		switch (format)
+		{
+			case TextureFormat::BC1:
+			case TextureFormat::BC4:
+				return 8;
+			case TextureFormat::BC3:
+			case TextureFormat::BC5:
+			case TextureFormat::BC7:
+			case TextureFormat::ASTC_4x4:
+				return 16;
+			default:
+				return 0;
+		}
+	}
+
+	auto Texture::getLevelSize(TextureFormat format, uint32_t width, uint32_t height) -> uint64_t
+	{
+		if (isCompressedFormat(format))
+			return uint64_t((width + 3) / 4) * ((height + 3) / 4) * getBlockSize(format);
+		return uint64_t(width) * height * getStrideFromFormat(format);
+	}
+
+	auto Texture::isFormatSupported(TextureFormat format) -> bool
+	{
+		if (!isCompressedFormat(format))
+			return true;
+#ifdef MAPLE_VULKAN
+		if (format == TextureFormat::ASTC_4x4)
+			return VulkanDevice::get()->isTextureCompressionASTCSupported();
+		return VulkanDevice::get()->isTextureCompressionBCSupported();
+#endif        // MAPLE_VULKAN
+#ifdef MAPLE_NULL
+		return true;
+#endif        // MAPLE_NULL
+#ifdef MAPLE_OPENGL
+		return false;
+#endif        // MAPLE_OPENGL
+	}
+
 	//###################################################
 
 	auto Texture2D::create() -> std::shared_ptr<Texture2D>
@@ -84,6 +180,9 @@ namespace maple
 #ifdef MAPLE_OPENGL
 		return std::make_shared<GLTexture2D>();
 #endif        // MAPLE_OPENGL
+#ifdef MAPLE_NULL
+		return std::make_shared<NullTexture2D>();
+#endif        // MAPLE_NULL
 #ifdef MAPLE_VULKAN
 		return std::make_shared<VulkanTexture2D>();
 #endif        // MAPLE_OPENGL
@@ -91,9 +190,14 @@ namespace maple
 
 	auto Texture2D::create(uint32_t width, uint32_t height, void *data, TextureParameters parameters, TextureLoadOptions loadOptions) -> std::shared_ptr<Texture2D>
 	{
+		if (auto context = ImportContext::current())
+			return context->createTexture(width, height, data, parameters, loadOptions);
 #ifdef MAPLE_OPENGL
 		return std::make_shared<GLTexture2D>(width, height, data, parameters, loadOptions);
 #endif        // MAPLE_OPENGL
+#ifdef MAPLE_NULL
+		return std::make_shared<NullTexture2D>(width, height, data, parameters, loadOptions);
+#endif        // MAPLE_NULL
 #ifdef MAPLE_VULKAN
 		return std::make_shared<VulkanTexture2D>(width, height, data, parameters, loadOptions);
 #endif        // MAPLE_OPENGL
@@ -101,14 +205,61 @@ namespace maple
 
 	auto Texture2D::create(const std::string &name, const std::string &filePath, TextureParameters parameters, TextureLoadOptions loadOptions) -> std::shared_ptr<Texture2D>
 	{
+		if (auto context = ImportContext::current())
+			return context->createTexture(name, filePath, parameters, loadOptions);
 #ifdef MAPLE_OPENGL
 		return Application::getAssetsLoaderFactory()->emplace<GLTexture2D>(filePath, name, filePath, parameters, loadOptions);
 #endif        // MAPLE_OPENGL
+#ifdef MAPLE_NULL
+		return Application::getAssetsLoaderFactory()->emplace<NullTexture2D>(filePath, name, filePath, parameters, loadOptions);
+#endif        // MAPLE_NULL
 #ifdef MAPLE_VULKAN
 		return Application::getAssetsLoaderFactory()->emplace<VulkanTexture2D>(filePath, name, filePath, parameters, loadOptions);
 #endif        // MAPLE_VULKAN
 	}
 
+	auto Texture2D::prefetch(const std::vector<std::string> &filePaths, TextureLoadOptions loadOptions) -> std::shared_ptr<ImagePrefetch>
+	{
+		//the textures already created are taken from the registry, their images are not read again.
+		//an import off the main thread leaves it to the flush, the textures are created there
+		auto                     context = ImportContext::current();
+		std::vector<std::string> files;
+		if (context != nullptr)
+		{
+			files = filePaths;
+		}
+		else
+		{
+			auto &registry = Application::getAssetsLoaderFactory()->getRegistry();
+			for (auto &filePath : filePaths)
+			{
+#ifdef MAPLE_OPENGL
+				const auto id = AssetId::of<GLTexture2D>(filePath);
+#endif        // MAPLE_OPENGL
+#ifdef MAPLE_NULL
+				const auto id = AssetId::of<NullTexture2D>(filePath);
+#endif        // MAPLE_NULL
+#ifdef MAPLE_VULKAN
+				const auto id = AssetId::of<VulkanTexture2D>(filePath);
+#endif        // MAPLE_VULKAN
+				if (!registry.contains(id))
+					files.emplace_back(filePath);
+			}
+		}
+#ifdef MAPLE_OPENGL
+		auto prefetch = ImageLoader::prefetch(files, loadOptions.generateMipMaps, loadOptions.flipY, false);
+#endif        // MAPLE_OPENGL
+#ifdef MAPLE_NULL
+		auto prefetch = ImageLoader::prefetch(files, loadOptions.generateMipMaps, loadOptions.flipY, true);
+#endif        // MAPLE_NULL
+#ifdef MAPLE_VULKAN
+		auto prefetch = ImageLoader::prefetch(files, loadOptions.generateMipMaps, true, true);
+#endif        // MAPLE_VULKAN
+		if (context != nullptr)
+			context->keep(prefetch);
+		return prefetch;
+	}
+
 	auto Texture2D::getDefaultTexture() -> std::shared_ptr<Texture2D>
 	{
 		static std::shared_ptr<Texture2D> defaultTexture = create("default", "textures/default.png");
@@ -121,6 +272,9 @@ namespace maple
 #ifdef MAPLE_OPENGL
 		return std::make_shared<GLTextureDepth>(width, height, stencil);
 #endif        // MAPLE_OPENGL
+#ifdef MAPLE_NULL
+		return std::make_shared<NullTextureDepth>(width, height, stencil);
+#endif        // MAPLE_NULL
 #ifdef MAPLE_VULKAN
 		return std::make_shared<VulkanTextureDepth>(width, height, stencil, commandBuffer);
 #endif        // MAPLE_VULKAN
@@ -131,6 +285,9 @@ namespace maple
 #ifdef MAPLE_OPENGL
 		return std::make_shared<GLTextureCube>(size);
 #endif        // MAPLE_OPENGL
+#ifdef MAPLE_NULL
+		return std::make_shared<NullTextureCube>(size);
+#endif        // MAPLE_NULL
 #ifdef MAPLE_VULKAN
 		return std::make_shared<VulkanTextureCube>(size);
 #endif        // MAPLE_VULKAN
@@ -141,6 +298,9 @@ namespace maple
 #ifdef MAPLE_OPENGL
 		return std::make_shared<GLTextureCube>(size, format, numMips);
 #endif        // MAPLE_OPENGL
+#ifdef MAPLE_NULL
+		return std::make_shared<NullTextureCube>(size, format, numMips);
+#endif        // MAPLE_NULL
 #ifdef MAPLE_VULKAN
 		return std::make_shared<VulkanTextureCube>(size, format, numMips);
 #endif        // MAPLE_VULKAN
@@ -151,6 +311,9 @@ namespace maple
 #ifdef MAPLE_OPENGL
 		return std::make_shared<GLTextureCube>(filePath);
 #endif        // MAPLE_OPENGL
+#ifdef MAPLE_NULL
+		return std::make_shared<NullTextureCube>(filePath);
+#endif        // MAPLE_NULL
 #ifdef MAPLE_VULKAN
 		return std::make_shared<VulkanTextureCube>(filePath);
 #endif        // MAPLE_VULKAN
@@ -161,6 +324,9 @@ namespace maple
 #ifdef MAPLE_OPENGL
 		return std::make_shared<GLTextureCube>(files);
 #endif        // MAPLE_OPENGL
+#ifdef MAPLE_NULL
+		return std::make_shared<NullTextureCube>(files);
+#endif        // MAPLE_NULL
 #ifdef MAPLE_VULKAN
 		return std::make_shared<VulkanTextureCube>(files);
 #endif        // MAPLE_VULKAN
@@ -171,6 +337,9 @@ namespace maple
 #ifdef MAPLE_OPENGL
 		return std::make_shared<GLTextureCube>(files, mips, params, loadOptions, format);
 #endif        // MAPLE_OPENGL
+#ifdef MAPLE_NULL
+		return std::make_shared<NullTextureCube>(files, mips, params, loadOptions, format);
+#endif        // MAPLE_NULL
 #ifdef MAPLE_VULKAN
 		return std::make_shared<VulkanTextureCube>(files, mips, params, loadOptions, format);
 #endif        // MAPLE_VULKAN
@@ -182,6 +351,9 @@ namespace maple
 #ifdef MAPLE_OPENGL
 		return std::make_shared<GLTextureDepthArray>(width, height, count);
 #endif        // MAPLE_OPENGL
+#ifdef MAPLE_NULL
+		return std::make_shared<NullTextureDepthArray>(width, height, count);
+#endif        // MAPLE_NULL
 #ifdef MAPLE_VULKAN
 		return std::make_shared<VulkanTextureDepthArray>(width, height, count, commandBuffer);
 #endif        // MAPLE_VULKAN
@@ -192,6 +364,9 @@ namespace maple
 #ifdef MAPLE_OPENGL
 		return std::make_shared<GLTexture3D>(width, height, depth, parameters, loadOptions);
 #endif        // MAPLE_OPENGL
+#ifdef MAPLE_NULL
+		return std::make_shared<NullTexture3D>(width, height, depth, parameters, loadOptions);
+#endif        // MAPLE_NULL
 #ifdef MAPLE_VULKAN
 		return std::make_shared<VulkanTexture3D>(width, height, depth, parameters, loadOptions);
 #endif        // MAPLE_VULKAN
@@ -203,6 +378,9 @@ namespace maple
 		//return std::make_shared<GLTexture2DArray>(width, height, count, format, parameters);
 		return nullptr;
 #endif        // MAPLE_OPENGL
+#ifdef MAPLE_NULL
+		return std::make_shared<NullTexture2DArray>(width, height, count, format, parameters);
+#endif        // MAPLE_NULL
 #ifdef MAPLE_VULKAN
 		return std::make_shared<VulkanTexture2DArray>(width, height, count, format, parameters, commandBuffer);
 #endif        // MAPLE_VULKAN
@@ -5,9 +5,12 @@
 #include "Definitions.h"
 #include "FileSystem/IResource.h"
 #include <string>
+#include <vector>
 
 namespace maple
 {
+	class ImagePrefetch;
+
 	class MAPLE_EXPORT Texture : public IResource
 	{
 	  public:
@@ -40,6 +43,12 @@ namespace maple
 			return updated = update;
 		}
 
+		//bumped whenever the gpu image behind the texture is replaced, the descriptor sets holding it are written again
+		inline auto getGeneration() const
+		{
+			return generation;
+		}
+
 		virtual auto getSize() const -> uint32_t
 		{
 			return 0;
@@ -69,6 +78,11 @@ namespace maple
 			return format == TextureFormat::STENCIL;
 		}
 
+		inline static auto isCompressedFormat(TextureFormat format)
+		{
+			return format >= TextureFormat::BC1 && format <= TextureFormat::ASTC_4x4;
+		}
+
 		virtual auto setName(const std::string &name) -> void
 		{
 			this->name = name;
@@ -103,12 +117,19 @@ namespace maple
 		static auto getStrideFromFormat(TextureFormat format) -> uint8_t;
 		static auto bitsToTextureFormat(uint32_t bits) -> TextureFormat;
 		static auto calculateMipMapCount(uint32_t width, uint32_t height) -> uint32_t;
+		static auto buildMipChain(const uint8_t *pixels, uint32_t width, uint32_t height, uint32_t texelSize, uint32_t levels, std::vector<uint8_t> &data, std::vector<uint64_t> &offsets) -> void;
+		//bytes of a 4x4 block of the compressed formats, 0 for the others
+		static auto getBlockSize(TextureFormat format) -> uint32_t;
+		static auto getLevelSize(TextureFormat format, uint32_t width, uint32_t height) -> uint64_t;
+		//whether the current device can sample the format, the compressed ones are decoded on the cpu otherwise
+		static auto isFormatSupported(TextureFormat format) -> bool;
 
 	  protected:
 		uint16_t    flags = 0;
 		std::string name;
-		uint32_t    id = 0;
-		bool        updated = true;
+		uint32_t    id         = 0;
+		uint32_t    generation = 0;
+		bool        updated    = true;
 	};
 
 	class MAPLE_EXPORT Texture2D : public Texture
@@ -123,10 +144,44 @@ namespace maple
 		static auto  create() -> std::shared_ptr<Texture2D>;
 		static auto  create(uint32_t width, uint32_t height, void *data, TextureParameters parameters = TextureParameters(), TextureLoadOptions loadOptions = TextureLoadOptions()) -> std::shared_ptr<Texture2D>;
 		static auto  create(const std::string &name, const std::string &filePath, TextureParameters parameters = TextureParameters(), TextureLoadOptions loadOptions = TextureLoadOptions()) -> std::shared_ptr<Texture2D>;
+		//decodes the files on the job system the way create with the same loadOptions reads them, keep the result alive until they are created
+		static auto  prefetch(const std::vector<std::string> &filePaths, TextureLoadOptions loadOptions = TextureLoadOptions()) -> std::shared_ptr<ImagePrefetch>;
 		virtual auto update(uint32_t x, uint32_t y, uint32_t w, uint32_t h, const void *buffer) -> void = 0;
 
 		virtual auto buildTexture(TextureFormat internalformat, uint32_t width, uint32_t height, bool srgb = false, bool depth = false, bool samplerShadow = false, bool mipmap = false, bool image = false, uint32_t accessFlag = 0) -> void = 0;
 
+		//streamed textures only keep the mips from getResidentMip() on in gpu memory, the TextureStreamer moves it
+		virtual auto isStreamed() const -> bool
+		{
+			return false;
+		}
+
+		virtual auto getResidentMip() const -> uint32_t
+		{
+			return 0;
+		}
+
+		virtual auto setResidentMip(uint32_t mip) -> void
+		{
+		}
+
+		//reads the file again into the same texture, false when it was not created from a file
+		virtual auto reload() -> bool
+		{
+			return false;
+		}
+
+		//what the texture was created with, the mesh cache recreates the textures of a material from them
+		virtual auto getParameters() const -> TextureParameters
+		{
+			return {};
+		}
+
+		virtual auto getLoadOptions() const -> TextureLoadOptions
+		{
+			return {};
+		}
+
 		inline auto getType() const -> TextureType override
 		{
 			return TextureType::Color;
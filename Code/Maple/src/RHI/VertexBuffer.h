@@ -14,14 +14,15 @@ namespace maple
 	class MAPLE_EXPORT VertexBuffer
 	{
 	  public:
-		using Ptr                                                                         = std::shared_ptr<VertexBuffer>;
-		virtual ~VertexBuffer()                                                           = default;
-		virtual auto resize(uint32_t size) -> void                                        = 0;
-		virtual auto setData(uint32_t size, const void *data) -> void                     = 0;
-		virtual auto setDataSub(uint32_t size, const void *data, uint32_t offset) -> void = 0;
-		virtual auto releasePointer() -> void                                             = 0;
-		virtual auto bind(const CommandBuffer *commandBuffer, Pipeline *pipeline) -> void = 0;
-		virtual auto unbind() -> void                                                     = 0;
+		using Ptr                                                                                               = std::shared_ptr<VertexBuffer>;
+		virtual ~VertexBuffer()                                                                                 = default;
+		virtual auto resize(uint32_t size) -> void                                                              = 0;
+		virtual auto setData(uint32_t size, const void *data) -> void                                           = 0;
+		virtual auto setDataSub(uint32_t size, const void *data, uint32_t offset) -> void                       = 0;
+		virtual auto releasePointer() -> void                                                                   = 0;
+		//binding is the stream of a split vertex layout, see BufferLayout::get
+		virtual auto bind(const CommandBuffer *commandBuffer, Pipeline *pipeline, uint32_t binding = 0) -> void = 0;
+		virtual auto unbind() -> void                                                                           = 0;
 		virtual auto getSize() -> uint64_t
 		{
 			return 0;
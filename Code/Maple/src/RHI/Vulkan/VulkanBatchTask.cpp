@@ -3,6 +3,8 @@
 //////////////////////////////////////////////////////////////////////////////
 #include "VulkanBatchTask.h"
 #include "RHI/Vulkan/Raytracing/VulkanAccelerationStructure.h"
+#include "VulkanContext.h"
+#include "VulkanUploadManager.h"
 #include <cmath>
 
 namespace maple
@@ -10,12 +12,14 @@ namespace maple
 #ifdef MAPLE_VULKAN
 	auto VulkanBatchTask::execute() -> void
 	{
-		auto cmd = VulkanHelper::beginSingleTimeCommands();
+		if (requests.empty())
+			return;
 
+		//built with the upload batch ahead of the frame, which builds the top level from them.
+		//the scratch buffer goes through the deletion queue, so it lives until that frame completed
 		std::shared_ptr<VulkanBuffer> scratchBuffer;
 
-		if (requests.size() > 0)
-		{
+		VulkanContext::getUploadManager()->record([&](VkCommandBuffer cmd) {
 			VkMemoryBarrier memoryBarrier;
 			memoryBarrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
 			memoryBarrier.pNext         = nullptr;
@@ -50,9 +54,7 @@ namespace maple
 
 				vkCmdPipelineBarrier(cmd, VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR, VK_PIPELINE_STAGE_ACCELERATION_STRUCTURE_BUILD_BIT_KHR, 0, 1, &memoryBarrier, 0, 0, 0, 0);
 			}
-		}
-
-		VulkanHelper::endSingleTimeCommands(cmd);
+		});
 	}
 
 	auto VulkanBatchTask::buildBlas(VulkanAccelerationStructure *                               accelerationStructure,
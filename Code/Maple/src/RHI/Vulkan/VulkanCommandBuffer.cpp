@@ -127,7 +127,14 @@ namespace maple
 
 		boundPipeline = nullptr;
 #ifdef MAPLE_PROFILE
-		TracyVkCollect(VulkanDevice::get()->getTracyContext(), commandBuffer);
+		//secondary buffers are recorded inside a render pass on the worker threads
+		if (primary)
+		{
+			if (cmdBufferType == CommandBufferType::Compute && VulkanDevice::get()->getTracyComputeContext() != nullptr)
+				TracyVkCollect(VulkanDevice::get()->getTracyComputeContext(), commandBuffer);
+			else
+				TracyVkCollect(VulkanDevice::get()->getTracyContext(), commandBuffer);
+		}
 #endif        // MAPLE_PROFILE
 
 		VK_CHECK_RESULT(vkEndCommandBuffer(commandBuffer));
@@ -198,15 +205,25 @@ namespace maple
 	auto VulkanCommandBuffer::executeInternal(const std::vector<VkPipelineStageFlags> &flags,
 	                                          const std::vector<VkSemaphore> &         waitSemaphores,
 	                                          const std::vector<VkSemaphore> &         signalSemaphores,
-	                                          bool                                     waitFence) -> void
+	                                          bool                                     waitFence,
+	                                          const std::vector<uint64_t> &            waitValues,
+	                                          const std::vector<uint64_t> &            signalValues) -> void
 	{
 		PROFILE_FUNCTION();
 		MAPLE_ASSERT(primary, "Used Execute on secondary command buffer!");
 		MAPLE_ASSERT(state == CommandBufferState::Ended, "CommandBuffer executed before ended recording");
 
+		//the values of binary semaphores in the lists are ignored
+		VkTimelineSemaphoreSubmitInfo timelineInfo = {};
+		timelineInfo.sType                         = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO;
+		timelineInfo.waitSemaphoreValueCount       = static_cast<uint32_t>(waitValues.size());
+		timelineInfo.pWaitSemaphoreValues          = waitValues.data();
+		timelineInfo.signalSemaphoreValueCount     = static_cast<uint32_t>(signalValues.size());
+		timelineInfo.pSignalSemaphoreValues        = signalValues.data();
+
 		VkSubmitInfo submitInfo       = {};
 		submitInfo.sType              = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-		submitInfo.pNext              = VK_NULL_HANDLE;
+		submitInfo.pNext              = waitValues.empty() && signalValues.empty() ? VK_NULL_HANDLE : &timelineInfo;
 		submitInfo.waitSemaphoreCount = waitSemaphores.size();
 		submitInfo.pWaitSemaphores    = waitSemaphores.data();
 		submitInfo.pWaitDstStageMask  = flags.data();
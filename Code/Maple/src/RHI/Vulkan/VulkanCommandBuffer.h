@@ -54,7 +54,9 @@ namespace maple
 		    const std::vector<VkPipelineStageFlags> &flags,
 		    const std::vector<VkSemaphore> &         waitSemaphores,
 		    const std::vector<VkSemaphore> &         signalSemaphores,
-		    bool                                     waitFence) -> void;
+		    bool                                     waitFence,
+		    const std::vector<uint64_t> &            waitValues   = {},
+		    const std::vector<uint64_t> &            signalValues = {}) -> void;
 
 		inline auto getCommandBuffer() const
 		{
@@ -4,9 +4,12 @@
 #include "VulkanContext.h"
 #include "Vk.h"
 #include "VulkanDevice.h"
+#include "VulkanFrameAllocator.h"
 #include "VulkanHelper.h"
+#include "VulkanPipeline.h"
 #include "VulkanRenderDevice.h"
 #include "VulkanSwapChain.h"
+#include "VulkanUploadManager.h"
 
 #ifdef _WIN32
 #	include <vulkan/vulkan_win32.h>
@@ -18,6 +21,8 @@
 #include "Engine/Profiler.h"
 #include "Others/Console.h"
 
+#include <imgui/imgui.h>
+
 #define VK_LAYER_LUNARG_STANDARD_VALIDATION_NAME "VK_LAYER_LUNARG_standard_validation"
 #define VK_LAYER_LUNARG_ASSISTENT_LAYER_NAME "VK_LAYER_LUNARG_assistant_layer"
 #define VK_LAYER_LUNARG_VALIDATION_NAME "VK_LAYER_KHRONOS_validation"
@@ -29,6 +34,9 @@ namespace maple
 	{
 		VkDebugReportCallbackEXT reportCallback = {};
 
+		constexpr uint32_t FrameAllocatorCapacity = 8 * 1024 * 1024;        //per frame in flight, grows on demand
+		constexpr uint64_t UploadRingCapacity     = 64 * 1024 * 1024;
+
 		inline auto getRequiredLayers()
 		{
 			std::vector<const char *> layers;
@@ -190,11 +198,20 @@ namespace maple
 
 	VulkanContext::~VulkanContext()
 	{
+		//submits what is still pending and waits for it, before the resources it may reference are deleted
+		uploadManager.reset();
+
 		for (int32_t i = 0; i < 3; i++)
 		{
 			getDeletionQueue(i).flush();
 		}
 
+		if (frameAllocator)
+		{
+			vkDeviceWaitIdle(*VulkanDevice::get());
+			frameAllocator.reset();
+		}
+
 		if (reportCallback)
 		{
 			PFN_vkDestroyDebugReportCallbackEXT destoryCallback = (PFN_vkDestroyDebugReportCallbackEXT) vkGetInstanceProcAddr(vkInstance, "vkDestroyDebugReportCallbackEXT");
@@ -237,9 +254,14 @@ namespace maple
 		VulkanDevice::get()->init();
 		setupDebug();
 
+		//the swap chain images are already transitioned through it
+		uploadManager = std::make_unique<VulkanUploadManager>(UploadRingCapacity);
+
 		auto &window = Application::getWindow();
 		swapChain    = SwapChain::create(window->getWidth(), window->getHeight());
 		swapChain->init(false, window.get());
+
+		frameAllocator = std::make_unique<VulkanFrameAllocator>(swapChain->getSwapChainBufferCount(), FrameAllocatorCapacity);
 	}
 
 	auto VulkanContext::present() -> void
@@ -253,6 +275,14 @@ namespace maple
 
 	auto VulkanContext::onImGui() -> void
 	{
+		if (uploadManager)
+		{
+			auto stats = uploadManager->getStats();
+			ImGui::Text("Uploads : %.2f MB in %u batches this frame", stats.frameBytes / (1024.f * 1024.f), stats.frameBatches);
+			ImGui::Text("Upload bandwidth : %.2f MB/s", stats.bandwidth);
+			ImGui::Text("Upload latency : %.2f ms, max %.2f ms", stats.latency, stats.maxLatency);
+			ImGui::Text("Staging ring : %.2f / %.2f MB, peak %.2f MB", stats.ringUsage / (1024.f * 1024.f), uploadManager->getCapacity() / (1024.f * 1024.f), stats.peakRingUsage / (1024.f * 1024.f));
+		}
 	}
 
 	auto VulkanContext::waitIdle() const -> void
@@ -260,6 +290,12 @@ namespace maple
 		vkDeviceWaitIdle(*VulkanDevice::get());
 	}
 
+	auto VulkanContext::saveCaches() -> void
+	{
+		VulkanPipeline::saveRecords();
+		VulkanDevice::get()->savePipelineCache();
+	}
+
 	auto VulkanContext::createInstance() -> void
 	{
 		PROFILE_FUNCTION();
@@ -321,4 +357,14 @@ namespace maple
 		return get()->deletionQueue[index];
 	}
 
+	auto VulkanContext::getFrameAllocator() -> VulkanFrameAllocator *
+	{
+		return get()->frameAllocator.get();
+	}
+
+	auto VulkanContext::getUploadManager() -> VulkanUploadManager *
+	{
+		return get()->uploadManager.get();
+	}
+
 }        // namespace maple
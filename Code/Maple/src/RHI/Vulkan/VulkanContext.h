@@ -12,6 +12,8 @@
 namespace maple
 {
 	class UniformBuffer;
+	class VulkanFrameAllocator;
+	class VulkanUploadManager;
 
 	class MAPLE_EXPORT VulkanContext : public GraphicsContext
 	{
@@ -25,6 +27,7 @@ namespace maple
 		auto getMinUniformBufferOffsetAlignment() const -> size_t override;
 		auto waitIdle() const -> void override;
 		auto onImGui() -> void override;
+		auto saveCaches() -> void override;
 
 		inline auto getGPUMemoryUsed() -> float override
 		{
@@ -74,6 +77,12 @@ namespace maple
 		static auto getDeletionQueue() -> CommandQueue &;
 		static auto getDeletionQueue(uint32_t index) -> CommandQueue &;
 
+		//transient uniforms and vertices, recycled per frame in flight
+		static auto getFrameAllocator() -> VulkanFrameAllocator *;
+
+		//staged texture uploads and other one time work, submitted with the next frame
+		static auto getUploadManager() -> VulkanUploadManager *;
+
 	  private:
 		auto setupDebug() -> void;
 
@@ -82,6 +91,9 @@ namespace maple
 		//bind to triple buffer
 		CommandQueue deletionQueue[3];
 
+		std::unique_ptr<VulkanFrameAllocator> frameAllocator;
+		std::unique_ptr<VulkanUploadManager>  uploadManager;
+
 		std::vector<const char *>          instanceLayerNames;
 		std::vector<const char *>          instanceExtensionNames;
 		std::vector<VkLayerProperties>     instanceLayers;
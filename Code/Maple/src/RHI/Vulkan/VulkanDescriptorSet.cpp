@@ -7,6 +7,7 @@
 #include "RHI/Vulkan/Raytracing/VulkanAccelerationStructure.h"
 #include "VulkanBuffer.h"
 #include "VulkanCommandBuffer.h"
+#include "VulkanContext.h"
 #include "VulkanDescriptorPool.h"
 #include "VulkanDevice.h"
 #include "VulkanHelper.h"
@@ -15,12 +16,15 @@
 #include "VulkanRenderDevice.h"
 #include "VulkanShader.h"
 #include "VulkanStorageBuffer.h"
+#include "VulkanSwapChain.h"
 #include "VulkanTexture.h"
 #include "VulkanUniformBuffer.h"
 #include "VulkanVertexBuffer.h"
 
 #include "Application.h"
 
+#include <algorithm>
+
 namespace maple
 {
 	namespace
@@ -87,7 +91,10 @@ namespace maple
 			descriptorSetAllocateInfo.descriptorPool = static_cast<const VulkanDescriptorPool *>(info.pool)->getHandle();
 		}
 
-		descriptorSetAllocateInfo.pSetLayouts        = static_cast<VulkanShader *>(info.shader)->getDescriptorLayout(info.layoutIndex);
+		descriptorPool                               = descriptorSetAllocateInfo.descriptorPool;
+		descriptorLayout                             = *static_cast<VulkanShader *>(info.shader)->getDescriptorLayout(info.layoutIndex);
+		variableCount                                = info.variableCount;
+		descriptorSetAllocateInfo.pSetLayouts        = &descriptorLayout;
 		descriptorSetAllocateInfo.descriptorSetCount = info.count;
 		descriptorSetAllocateInfo.pNext              = nullptr;
 
@@ -103,34 +110,35 @@ namespace maple
 
 		shader      = info.shader;
 		descriptors = shader->getDescriptorInfo(info.layoutIndex);
-		uniformBuffers.resize(framesInFlight);
 
 		for (auto &descriptor : descriptors)
 		{
 			if (descriptor.type == DescriptorType::UniformBuffer)
 			{
-				for (uint32_t frame = 0; frame < framesInFlight; frame++)
-				{
-					auto buffer = UniformBuffer::create();
-					buffer->init(descriptor.size, nullptr);
-					uniformBuffers[frame][descriptor.name] = buffer;
-				}
-
 				Buffer localStorage;
 				localStorage.allocate(descriptor.size);
 				localStorage.initializeEmpty();
 
 				UniformBufferInfo info;
-				info.localStorage  = localStorage;
-				info.hasUpdated[0] = false;
-				info.hasUpdated[1] = false;
-				info.hasUpdated[2] = false;
-
-				info.members                        = descriptor.members;
-				uniformBuffersData[descriptor.name] = info;
+				info.name         = descriptor.name;
+				info.binding      = descriptor.binding;
+				info.localStorage = localStorage;
+				info.members      = descriptor.members;
+				uniformBuffersData.emplace_back(std::move(info));
 			}
-			else if (descriptor.type == DescriptorType::Buffer)
+		}
+
+		//dynamic offsets are consumed in binding order
+		std::sort(uniformBuffersData.begin(), uniformBuffersData.end(), [](const auto &left, const auto &right) {
+			return left.binding < right.binding;
+		});
+
+		for (uint32_t index = 0; index < uniformBuffersData.size(); index++)
+		{
+			for (auto &member : uniformBuffersData[index].members)
 			{
+				if (!uniformHandles.emplace(UniformId(uniformBuffersData[index].name, member.name).hash, UniformHandle{index, member.offset, member.size}).second)
+					LOGW("Uniform {0}.{1} is declared twice or its name hash collides", uniformBuffersData[index].name, member.name);
 			}
 		}
 
@@ -147,33 +155,143 @@ namespace maple
 	VulkanDescriptorSet::~VulkanDescriptorSet()
 	{
 		PROFILE_FUNCTION();
+		//the command buffers of the last frames may still use the sets swapped out in them
+		std::vector<VkDescriptorSet> sets;
+		for (auto &replaced : replacedSets)
+			sets.insert(sets.end(), replaced.begin(), replaced.end());
+
+		if (!sets.empty())
+		{
+			VulkanContext::getDeletionQueue().emplace([pool = descriptorPool, sets = std::move(sets)] {
+				vkFreeDescriptorSets(*VulkanDevice::get(), pool, static_cast<uint32_t>(sets.size()), sets.data());
+			});
+		}
 	}
 
 	auto VulkanDescriptorSet::update(const CommandBuffer *commandBuffer) -> void
 	{
 		PROFILE_FUNCTION();
 
-		dynamic = false;
+		const auto vkCmd = static_cast<const VulkanCommandBuffer *>(commandBuffer);
 
-		int32_t descriptorWritesCount = 0;
+		std::lock_guard<std::mutex> lock(uniformMutex);
+		auto                        swapChain = std::static_pointer_cast<VulkanSwapChain>(Application::getGraphicsContext()->getSwapChain());
+		currentFrame                          = swapChain->getCurrentBufferIndex();
+		uploadUniforms();
 
-		const auto vkCmd = static_cast<const VulkanCommandBuffer *>(commandBuffer);
+		//generations only grow, so their sum changes when any of the images was replaced, e.g. by the TextureStreamer
+		uint64_t generation = 0;
+		{
+			//the layouts of all images are changed by one barrier
+			VulkanHelper::BarrierBatch batch(vkCmd);
+			for (auto &imageInfo : descriptors)
+			{
+				if (imageInfo.type == DescriptorType::ImageSampler || imageInfo.type == DescriptorType::Image)
+				{
+					if (!imageInfo.textures.empty())
+					{
+						for (uint32_t i = 0; i < imageInfo.textures.size(); i++)
+						{
+							if (imageInfo.textures[i])
+							{
+								generation += imageInfo.textures[i]->getGeneration();
+								swapChain->trackOwnership(imageInfo.textures[i].get(), vkCmd);
+								transitionImageLayout(
+								    commandBuffer, imageInfo.textures[i].get(),
+								    imageInfo.type == DescriptorType::ImageSampler,
+								    imageInfo.mipmapLevel);
+							}
+						}
+					}
+				}
+			}
+		}
+
+		if (textureGeneration[currentFrame] != generation)
+		{
+			textureGeneration[currentFrame] = generation;
+			descriptorDirty[currentFrame]   = true;
+		}
+
+		if (descriptorDirty[currentFrame])
+			writeDescriptors();
+		uniformFrame = VulkanContext::getFrameAllocator()->getFrameCounter();
+	}
+
+	auto VulkanDescriptorSet::uploadUniforms() -> void
+	{
+		PROFILE_FUNCTION();
+		if (uniformBuffersData.empty())
+			return;
 
-		currentFrame = Application::getGraphicsContext()->getSwapChain()->getCurrentBufferIndex();
+		auto       allocator = VulkanContext::getFrameAllocator();
+		const auto counter   = allocator->getFrameCounter();
 
+		//the fence of the frame has signaled since they were replaced
+		if (!replacedSets[currentFrame].empty() && replacedFrame[currentFrame] != counter)
+		{
+			vkFreeDescriptorSets(*VulkanDevice::get(), descriptorPool, static_cast<uint32_t>(replacedSets[currentFrame].size()), replacedSets[currentFrame].data());
+			replacedSets[currentFrame].clear();
+		}
+
+		bool replace = false;
+
+		//every update of a block takes a new slice, so draws recorded earlier in the frame keep their values
 		for (auto &bufferInfo : uniformBuffersData)
 		{
-			if (bufferInfo.second.hasUpdated[currentFrame])
+			if (bufferInfo.dirty || bufferInfo.frame != counter)
 			{
-				if (bufferInfo.second.dynamic)
-					uniformBuffers[currentFrame][bufferInfo.first]->setDynamicData(bufferInfo.second.localStorage.size, 0, bufferInfo.second.localStorage.data);
-				else
-					uniformBuffers[currentFrame][bufferInfo.first]->setData(bufferInfo.second.localStorage.data);
+				const auto size       = static_cast<uint32_t>(bufferInfo.localStorage.getSize());
+				bufferInfo.allocation = allocator->allocate(size);
+				bufferInfo.frame      = counter;
+				bufferInfo.dirty      = false;
+				memcpy(bufferInfo.allocation.mapped, bufferInfo.localStorage.data, size);
+			}
 
-				bufferInfo.second.hasUpdated[currentFrame] = false;
+			if (bufferInfo.descriptorBuffer[currentFrame] != bufferInfo.allocation.buffer)
+			{
+				descriptorDirty[currentFrame] = true;
+				//the allocator grew after the set was written in this frame, it may already be bound in a command buffer
+				replace |= writtenFrame[currentFrame] == counter;
 			}
 		}
-		//currentFrame = Application::getGraphicsContext()->getSwapChain()->getCurrentBufferIndex();
+
+		if (replace)
+			replaceDescriptorSet();
+	}
+
+	auto VulkanDescriptorSet::replaceDescriptorSet() -> void
+	{
+		PROFILE_FUNCTION();
+		VkDescriptorSetVariableDescriptorCountAllocateInfo variableInfo{};
+		variableInfo.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_VARIABLE_DESCRIPTOR_COUNT_ALLOCATE_INFO;
+		variableInfo.descriptorSetCount = 1;
+		variableInfo.pDescriptorCounts  = &variableCount;
+
+		VkDescriptorSetAllocateInfo allocateInfo{};
+		allocateInfo.sType              = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+		allocateInfo.pNext              = variableCount > 0 ? &variableInfo : nullptr;
+		allocateInfo.descriptorPool     = descriptorPool;
+		allocateInfo.descriptorSetCount = 1;
+		allocateInfo.pSetLayouts        = &descriptorLayout;
+
+		VkDescriptorSet newSet = VK_NULL_HANDLE;
+		VK_CHECK_RESULT(vkAllocateDescriptorSets(*VulkanDevice::get(), &allocateInfo, &newSet));
+
+		replacedSets[currentFrame].emplace_back(descriptorSet[currentFrame]);
+		replacedFrame[currentFrame]   = VulkanContext::getFrameAllocator()->getFrameCounter();
+		descriptorSet[currentFrame]   = newSet;
+		descriptorDirty[currentFrame] = true;
+	}
+
+	auto VulkanDescriptorSet::writeDescriptors() -> void
+	{
+		PROFILE_FUNCTION();
+		descriptorDirty[currentFrame] = false;
+		writtenFrame[currentFrame]    = VulkanContext::getFrameAllocator()->getFrameCounter();
+		int32_t descriptorWritesCount = 0;
+		int32_t imageIndex            = 0;
+		int32_t index                 = 0;
 
 		for (auto &imageInfo : descriptors)
 		{
@@ -181,147 +299,155 @@ namespace maple
 			{
 				if (!imageInfo.textures.empty())
 				{
+					auto validCount = 0;
 					for (uint32_t i = 0; i < imageInfo.textures.size(); i++)
 					{
 						if (imageInfo.textures[i])
 						{
+/*
 							transitionImageLayout(
 							    commandBuffer, imageInfo.textures[i].get(),
 							    imageInfo.type == DescriptorType::ImageSampler,
-							    imageInfo.mipmapLevel);
-						}
-					}
-				}
-			}
-		}
-
-		if (descriptorDirty[currentFrame])
-		{
-			descriptorDirty[currentFrame] = false;
-			int32_t imageIndex            = 0;
-			int32_t index                 = 0;
+							    imageInfo.mipmapLevel);*/
 
-			for (auto &imageInfo : descriptors)
-			{
-				if (imageInfo.type == DescriptorType::ImageSampler || imageInfo.type == DescriptorType::Image)
-				{
-					if (!imageInfo.textures.empty())
-					{
-						auto validCount = 0;
-						for (uint32_t i = 0; i < imageInfo.textures.size(); i++)
-						{
-							if (imageInfo.textures[i])
-							{
-/*
-								transitionImageLayout(
-								    commandBuffer, imageInfo.textures[i].get(),
-								    imageInfo.type == DescriptorType::ImageSampler,
-								    imageInfo.mipmapLevel);*/
-
-								const auto &des = *static_cast<VkDescriptorImageInfo *>(imageInfo.textures[i]->getDescriptorInfo(imageInfo.mipmapLevel, imageInfo.format));
-
-								imageInfoPool[i + imageIndex] = des;
-								validCount++;
-							}
-						}
+							const auto &des = *static_cast<VkDescriptorImageInfo *>(imageInfo.textures[i]->getDescriptorInfo(imageInfo.mipmapLevel, imageInfo.format));
 
-						if (validCount > 0)
-						{
-							VkWriteDescriptorSet writeDescriptorSet{};
-							writeDescriptorSet.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-							writeDescriptorSet.dstSet          = descriptorSet[currentFrame];
-							writeDescriptorSet.descriptorType  = VkConverter::descriptorTypeToVK(imageInfo.type);
-							writeDescriptorSet.dstBinding      = imageInfo.binding;
-							writeDescriptorSet.pImageInfo      = &imageInfoPool[imageIndex];
-							writeDescriptorSet.descriptorCount = validCount;
-
-							MAPLE_ASSERT(writeDescriptorSet.descriptorCount != 0, "writeDescriptorSet.descriptorCount should be greater than zero");
-
-							writeDescriptorSetPool[descriptorWritesCount] = writeDescriptorSet;
-							imageIndex += validCount;
-							descriptorWritesCount++;
+							imageInfoPool[i + imageIndex] = des;
+							validCount++;
 						}
 					}
-				}
-				else if (imageInfo.type == DescriptorType::UniformBuffer)
-				{
-					auto buffer = std::static_pointer_cast<VulkanUniformBuffer>(uniformBuffers[currentFrame][imageInfo.name]);
-
-					bufferInfoPool[index].buffer = buffer->getVkBuffer();
-					bufferInfoPool[index].offset = imageInfo.offset;
-					bufferInfoPool[index].range  = imageInfo.size;
-
-					VkWriteDescriptorSet writeDescriptorSet{};
-					writeDescriptorSet.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-					writeDescriptorSet.dstSet          = descriptorSet[currentFrame];
-					writeDescriptorSet.descriptorType  = VkConverter::descriptorTypeToVK(imageInfo.type);
-					writeDescriptorSet.dstBinding      = imageInfo.binding;
-					writeDescriptorSet.pBufferInfo     = &bufferInfoPool[index];
-					writeDescriptorSet.descriptorCount = 1;
-
-					writeDescriptorSetPool[descriptorWritesCount] = writeDescriptorSet;
-					index++;
-					descriptorWritesCount++;
-				}
-				else if (imageInfo.type == DescriptorType::Buffer)
-				{
-					auto &buffers = ssbos[imageInfo.name];
 
-					int32_t i = 0;
-
-					for (auto &ssbo : buffers)
+					if (validCount > 0)
 					{
-						bufferInfoPool[index + i].buffer = ssbo;
-						bufferInfoPool[index + i].offset = imageInfo.offset;
-						bufferInfoPool[index + i].range  = imageInfo.size;
-						i++;
+						VkWriteDescriptorSet writeDescriptorSet{};
+						writeDescriptorSet.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+						writeDescriptorSet.dstSet          = descriptorSet[currentFrame];
+						writeDescriptorSet.descriptorType  = VkConverter::descriptorTypeToVK(imageInfo.type);
+						writeDescriptorSet.dstBinding      = imageInfo.binding;
+						writeDescriptorSet.pImageInfo      = &imageInfoPool[imageIndex];
+						writeDescriptorSet.descriptorCount = validCount;
+
+						MAPLE_ASSERT(writeDescriptorSet.descriptorCount != 0, "writeDescriptorSet.descriptorCount should be greater than zero");
+
+						writeDescriptorSetPool[descriptorWritesCount] = writeDescriptorSet;
+						imageIndex += validCount;
+						descriptorWritesCount++;
 					}
-
-					VkWriteDescriptorSet writeDescriptorSet{};
-					writeDescriptorSet.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-					writeDescriptorSet.dstSet          = descriptorSet[currentFrame];
-					writeDescriptorSet.descriptorType  = VkConverter::descriptorTypeToVK(imageInfo.type);
-					writeDescriptorSet.dstBinding      = imageInfo.binding;
-					writeDescriptorSet.pBufferInfo     = &bufferInfoPool[index];
-					writeDescriptorSet.descriptorCount = i;
-
-					writeDescriptorSetPool[descriptorWritesCount] = writeDescriptorSet;
-					index += i;
-					descriptorWritesCount++;
 				}
-				else if (imageInfo.type == DescriptorType::AccelerationStructure)
+			}
+			else if (imageInfo.type == DescriptorType::UniformBuffer)
+			{
+				auto bufferInfo = std::find_if(uniformBuffersData.begin(), uniformBuffersData.end(), [&](const auto &info) {
+					return info.binding == imageInfo.binding;
+				});
+
+				if (bufferInfo == uniformBuffersData.end())
+					continue;
+
+				//the slice of the current update is selected by the dynamic offset
+				bufferInfo->descriptorBuffer[currentFrame] = bufferInfo->allocation.buffer;
+				bufferInfoPool[index].buffer               = bufferInfo->allocation.buffer;
+				bufferInfoPool[index].offset               = 0;
+				bufferInfoPool[index].range                = imageInfo.size;
+
+				VkWriteDescriptorSet writeDescriptorSet{};
+				writeDescriptorSet.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+				writeDescriptorSet.dstSet          = descriptorSet[currentFrame];
+				writeDescriptorSet.descriptorType  = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC;
+				writeDescriptorSet.dstBinding      = imageInfo.binding;
+				writeDescriptorSet.pBufferInfo     = &bufferInfoPool[index];
+				writeDescriptorSet.descriptorCount = 1;
+
+				writeDescriptorSetPool[descriptorWritesCount] = writeDescriptorSet;
+				index++;
+				descriptorWritesCount++;
+			}
+			else if (imageInfo.type == DescriptorType::Buffer)
+			{
+				auto &buffers = ssbos[imageInfo.name];
+
+				int32_t i = 0;
+
+				for (auto &ssbo : buffers)
 				{
-					auto acc = std::static_pointer_cast<VulkanAccelerationStructure>(accelerationStructures[imageInfo.name]);
-
-					VkWriteDescriptorSetAccelerationStructureKHR descriptorAs{};
-					descriptorAs.sType                      = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET_ACCELERATION_STRUCTURE_KHR;
-					descriptorAs.pNext                      = nullptr;
-					descriptorAs.accelerationStructureCount = 1;
-					descriptorAs.pAccelerationStructures    = &acc->getAccelerationStructure();
-
-					VkWriteDescriptorSet writeDescriptorSet{};
-					writeDescriptorSet.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
-					writeDescriptorSet.dstSet          = descriptorSet[currentFrame];
-					writeDescriptorSet.descriptorType  = VkConverter::descriptorTypeToVK(imageInfo.type);
-					writeDescriptorSet.dstBinding      = imageInfo.binding;
-					writeDescriptorSet.descriptorCount = 1;
-					writeDescriptorSet.pNext           = &descriptorAs;
-
-					writeDescriptorSetPool[descriptorWritesCount] = writeDescriptorSet;
-					descriptorWritesCount++;
+					bufferInfoPool[index + i].buffer = ssbo;
+					bufferInfoPool[index + i].offset = imageInfo.offset;
+					bufferInfoPool[index + i].range  = imageInfo.size;
+					i++;
 				}
-			}
 
-			if (descriptorWritesCount > 0)
-				vkUpdateDescriptorSets(*VulkanDevice::get(), descriptorWritesCount, writeDescriptorSetPool.data(), 0, nullptr);
+				VkWriteDescriptorSet writeDescriptorSet{};
+				writeDescriptorSet.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+				writeDescriptorSet.dstSet          = descriptorSet[currentFrame];
+				writeDescriptorSet.descriptorType  = VkConverter::descriptorTypeToVK(imageInfo.type);
+				writeDescriptorSet.dstBinding      = imageInfo.binding;
+				writeDescriptorSet.pBufferInfo     = &bufferInfoPool[index];
+				writeDescriptorSet.descriptorCount = i;
+
+				writeDescriptorSetPool[descriptorWritesCount] = writeDescriptorSet;
+				index += i;
+				descriptorWritesCount++;
+			}
+			else if (imageInfo.type == DescriptorType::AccelerationStructure)
+			{
+				auto acc = std::static_pointer_cast<VulkanAccelerationStructure>(accelerationStructures[imageInfo.name]);
+
+				VkWriteDescriptorSetAccelerationStructureKHR descriptorAs{};
+				descriptorAs.sType                      = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET_ACCELERATION_STRUCTURE_KHR;
+				descriptorAs.pNext                      = nullptr;
+				descriptorAs.accelerationStructureCount = 1;
+				descriptorAs.pAccelerationStructures    = &acc->getAccelerationStructure();
+
+				VkWriteDescriptorSet writeDescriptorSet{};
+				writeDescriptorSet.sType           = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+				writeDescriptorSet.dstSet          = descriptorSet[currentFrame];
+				writeDescriptorSet.descriptorType  = VkConverter::descriptorTypeToVK(imageInfo.type);
+				writeDescriptorSet.dstBinding      = imageInfo.binding;
+				writeDescriptorSet.descriptorCount = 1;
+				writeDescriptorSet.pNext           = &descriptorAs;
+
+				writeDescriptorSetPool[descriptorWritesCount] = writeDescriptorSet;
+				descriptorWritesCount++;
+			}
 		}
+
+		if (descriptorWritesCount > 0)
+			vkUpdateDescriptorSets(*VulkanDevice::get(), descriptorWritesCount, writeDescriptorSetPool.data(), 0, nullptr);
 	}
 
 	auto VulkanDescriptorSet::getDescriptorSet() -> VkDescriptorSet
 	{
+		std::lock_guard<std::mutex> lock(uniformMutex);
 		return descriptorSet[currentFrame];
 	}
 
+	auto VulkanDescriptorSet::getDynamicOffsets(uint32_t *offsets) -> uint32_t
+	{
+		if (uniformBuffersData.empty())
+			return 0;
+
+		//sets which are bound without update() in this frame still point into a recycled region.
+		//uniformFrame is published last, a thread which sees it reads offsets and a set which are written
+		const auto counter = VulkanContext::getFrameAllocator()->getFrameCounter();
+		if (uniformFrame != counter)
+		{
+			std::lock_guard<std::mutex> lock(uniformMutex);
+			if (uniformFrame != counter)
+			{
+				currentFrame = Application::getGraphicsContext()->getSwapChain()->getCurrentBufferIndex();
+				uploadUniforms();
+				if (descriptorDirty[currentFrame])
+					writeDescriptors();
+				uniformFrame = counter;
+			}
+		}
+
+		uint32_t count = 0;
+		for (auto &bufferInfo : uniformBuffersData)
+			offsets[count++] = bufferInfo.allocation.offset;
+		return count;
+	}
+
 	auto VulkanDescriptorSet::setTexture(const std::string &name, const std::vector<std::shared_ptr<Texture>> &textures, int32_t mipLevel) -> void
 	{
 		bool set = false;
@@ -371,66 +497,62 @@ namespace maple
 		return nullptr;
 	}
 
-	auto VulkanDescriptorSet::setUniform(const std::string &bufferName, const std::string &uniformName, const void *data, bool dynamic) -> void
+	auto VulkanDescriptorSet::getUniformHandle(const UniformId &id) const -> UniformHandle
 	{
-		PROFILE_FUNCTION();
-		if (auto iter = uniformBuffersData.find(bufferName); iter != uniformBuffersData.end())
-		{
-			for (auto &member : iter->second.members)
-			{
-				if (member.name == uniformName)
-				{
-					iter->second.localStorage.write(data, member.size, member.offset);
-					iter->second.hasUpdated[0] = true;
-					iter->second.hasUpdated[1] = true;
-					iter->second.hasUpdated[2] = true;
-					iter->second.dynamic       = dynamic;
-					return;
-				}
-			}
-		}
-		LOGW("Uniform not found {0}.{1}", bufferName, uniformName);
+		if (auto iter = uniformHandles.find(id.hash); iter != uniformHandles.end())
+			return iter->second;
+		return {};
 	}
 
-	auto VulkanDescriptorSet::setUniform(const std::string &bufferName, const std::string &uniformName, const void *data, uint32_t size, bool dynamic) -> void
+	auto VulkanDescriptorSet::setUniform(const UniformHandle &handle, const void *data, bool dynamic) -> void
 	{
-		PROFILE_FUNCTION();
-		if (auto iter = uniformBuffersData.find(bufferName); iter != uniformBuffersData.end())
+		setUniform(handle, data, handle.size, dynamic);
+	}
+
+	auto VulkanDescriptorSet::setUniform(const UniformHandle &handle, const void *data, uint32_t size, bool dynamic) -> void
+	{
+		if (handle.buffer >= uniformBuffersData.size())
+			return;
+
+		//a write larger than the member would overwrite the ones after it
+		auto &bufferInfo = uniformBuffersData[handle.buffer];
+		if (size > handle.size || handle.offset + size > bufferInfo.localStorage.getSize())
 		{
-			for (auto &member : iter->second.members)
-			{
-				if (member.name == uniformName)
-				{
-					iter->second.localStorage.write(data, size, member.offset);
-					iter->second.hasUpdated[0] = true;
-					iter->second.hasUpdated[1] = true;
-					iter->second.hasUpdated[2] = true;
-					iter->second.dynamic       = dynamic;
-					return;
-				}
-			}
+			LOGW("Uniform write out of range in {0}, offset {1} size {2} member size {3}", bufferInfo.name, handle.offset, size, handle.size);
+			return;
 		}
-		LOGW("Uniform not found {0}.{1}", bufferName, uniformName);
+
+		bufferInfo.localStorage.write(data, size, handle.offset);
+		bufferInfo.dirty = true;
 	}
 
 	auto VulkanDescriptorSet::setUniformBufferData(const std::string &bufferName, const void *data) -> void
 	{
 		PROFILE_FUNCTION();
-		if (auto iter = uniformBuffersData.find(bufferName); iter != uniformBuffersData.end())
+		for (auto &bufferInfo : uniformBuffersData)
 		{
-			iter->second.localStorage.write(data, iter->second.localStorage.getSize(), 0);
-			iter->second.hasUpdated[0] = true;
-			iter->second.hasUpdated[1] = true;
-			iter->second.hasUpdated[2] = true;
-			return;
+			if (bufferInfo.name == bufferName)
+			{
+				bufferInfo.localStorage.write(data, bufferInfo.localStorage.getSize(), 0);
+				bufferInfo.dirty = true;
+				return;
+			}
 		}
-		LOGW("Uniform not found {0}.{1}", bufferName);
+		LOGW("Uniform not found {0}", bufferName);
 	}
 
 	auto VulkanDescriptorSet::setStorageBuffer(const std::string &name, std::shared_ptr<StorageBuffer> buffer) -> void
 	{
-		auto vkBuffer = std::static_pointer_cast<VulkanStorageBuffer>(buffer);
-		ssbos[name]   = {vkBuffer->getHandle()};
+		auto  vkBuffer = std::static_pointer_cast<VulkanStorageBuffer>(buffer);
+		auto &handles  = ssbos[name];
+		//buffers replaced every frame, e.g. per frame instance data, have to be written again
+		if (handles.size() != 1 || handles[0] != vkBuffer->getHandle())
+		{
+			handles            = {vkBuffer->getHandle()};
+			descriptorDirty[0] = true;
+			descriptorDirty[1] = true;
+			descriptorDirty[2] = true;
+		}
 	}
 
 	auto VulkanDescriptorSet::setStorageBuffer(const std::string &name, std::shared_ptr<VertexBuffer> buffer) -> void
@@ -5,8 +5,12 @@
 #include "Engine/Buffer.h"
 #include "Engine/Core.h"
 #include "RHI/DescriptorSet.h"
+#include "VulkanFrameAllocator.h"
 #include "VulkanHelper.h"
 
+#include <atomic>
+#include <mutex>
+
 namespace maple
 {
 	constexpr int32_t MAX_BUFFER_INFOS      = 1024;
@@ -33,19 +37,19 @@ namespace maple
 			return dynamicOffset;
 		}
 
-		inline auto isDynamic() const
-		{
-			return dynamic;
-		}
-
 		auto getDescriptorSet() -> VkDescriptorSet;
 
+		//offsets of the uniform blocks in binding order, uploads them again when their frame was recycled
+		auto getDynamicOffsets(uint32_t *offsets) -> uint32_t;
+
 		auto setTexture(const std::string &name, const std::vector<std::shared_ptr<Texture>> &textures, int32_t mipLevel = -1) -> void override;
 		auto setTexture(const std::string &name, const std::shared_ptr<Texture> &textures, int32_t mipLevel = -1) -> void override;
 		auto setBuffer(const std::string &name, const std::shared_ptr<UniformBuffer> &buffer) -> void override;
 		auto getUnifromBuffer(const std::string &name) -> std::shared_ptr<UniformBuffer> override;
-		auto setUniform(const std::string &bufferName, const std::string &uniformName, const void *data, bool dynamic) -> void override;
-		auto setUniform(const std::string &bufferName, const std::string &uniformName, const void *data, uint32_t size, bool dynamic) -> void override;
+		using DescriptorSet::setUniform;
+		auto getUniformHandle(const UniformId &id) const -> UniformHandle override;
+		auto setUniform(const UniformHandle &handle, const void *data, bool dynamic) -> void override;
+		auto setUniform(const UniformHandle &handle, const void *data, uint32_t size, bool dynamic) -> void override;
 		auto setUniformBufferData(const std::string &bufferName, const void *data) -> void override;
 
 		auto setStorageBuffer(const std::string &name, std::shared_ptr<StorageBuffer> buffer) -> void override;
@@ -70,10 +74,23 @@ namespace maple
 		};
 
 	  private:
-		uint32_t dynamicOffset      = 0;
-		Shader * shader             = nullptr;
-		bool     dynamic            = false;
-		bool     descriptorDirty[3] = {};
+		auto uploadUniforms() -> void;
+		auto writeDescriptors() -> void;
+		auto replaceDescriptorSet() -> void;
+
+		uint32_t dynamicOffset        = 0;
+		Shader * shader               = nullptr;
+		bool     descriptorDirty[3]   = {};
+		uint64_t textureGeneration[3] = {};        //sum of the texture generations the descriptors of each frame were written with
+		uint64_t writtenFrame[3]      = {};        //frame counter the descriptors of each frame were last written in
+
+		//sets swapped out in the middle of a frame, the command buffers of that frame may still use them
+		std::vector<VkDescriptorSet> replacedSets[3];
+		uint64_t                     replacedFrame[3] = {};
+
+		VkDescriptorPool      descriptorPool   = VK_NULL_HANDLE;
+		VkDescriptorSetLayout descriptorLayout = VK_NULL_HANDLE;
+		uint32_t              variableCount    = 0;
 
 		std::vector<Descriptor> descriptors;
 
@@ -85,20 +102,25 @@ namespace maple
 
 		struct UniformBufferInfo
 		{
-			std::vector<BufferMemberInfo> members;
-			Buffer                        localStorage;
-			bool                          dynamic        = false;
-			bool                          hasUpdated[10] = {};
+			std::string                      name;
+			uint32_t                         binding = 0;
+			std::vector<BufferMemberInfo>    members;
+			Buffer                           localStorage;
+			VulkanFrameAllocator::Allocation allocation;
+			uint64_t                         frame               = 0;        //frame counter of the allocation
+			bool                             dirty               = true;
+			VkBuffer                         descriptorBuffer[3] = {};       //buffer the descriptor of each frame points to
 		};
 
-		std::vector<VkDescriptorSet>                                                 descriptorSet;
-		std::vector<std::unordered_map<std::string, std::shared_ptr<UniformBuffer>>> uniformBuffers;
-		std::unordered_map<std::string, std::vector<VkBuffer>>                       ssbos;
-		std::unordered_map<std::string, std::shared_ptr<AccelerationStructure>>      accelerationStructures;
-		std::unordered_map<std::string, UniformBufferInfo>                           uniformBuffersData;
-
-		uint32_t currentFrame = 0;
-
+		std::vector<VkDescriptorSet>                                            descriptorSet;
+		std::unordered_map<std::string, std::vector<VkBuffer>>                  ssbos;
+		std::unordered_map<std::string, std::shared_ptr<AccelerationStructure>> accelerationStructures;
+		std::vector<UniformBufferInfo>                                          uniformBuffersData;        //sorted by binding
+		std::unordered_map<uint64_t, UniformHandle>                             uniformHandles;            //UniformId::hash
 
+		//update() and the first bind of a frame write the set under the mutex, the bind of another recording thread may read it
+		std::mutex            uniformMutex;
+		std::atomic<uint64_t> uniformFrame{0};        //frame counter the uniform blocks and the set were last written in
+		std::atomic<uint32_t> currentFrame{0};
 	};
 };        // namespace maple
@@ -6,9 +6,13 @@
 #include "VulkanCommandPool.h"
 #include "VulkanContext.h"
 #include "VulkanHelper.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
 #include <stdexcept>
 
 #include "Application.h"
+#include "FileSystem/File.h"
 
 namespace maple
 {
@@ -33,6 +37,47 @@ namespace maple
 			}
 		}
 
+		constexpr char     PipelineCacheFolder[] = "cache/";
+		constexpr char     PipelineCacheFile[]   = "cache/pipeline.cache";
+		constexpr uint32_t PipelineCacheMagic    = 0x4843504d;        //MPCH
+		constexpr uint32_t PipelineCacheVersion  = 1;
+
+		//written in front of the blob of vkGetPipelineCacheData, which does not carry the driver version
+		struct PipelineCacheHeader
+		{
+			uint32_t magic;
+			uint32_t version;
+			uint32_t vendorID;
+			uint32_t deviceID;
+			uint32_t driverVersion;
+			uint8_t  uuid[VK_UUID_SIZE];
+			uint64_t dataSize;
+		};
+
+		inline auto isPipelineCacheValid(const std::vector<uint8_t> &buffer, const VkPhysicalDeviceProperties &properties) -> bool
+		{
+			if (buffer.size() < sizeof(PipelineCacheHeader) + sizeof(VkPipelineCacheHeaderVersionOne))
+				return false;
+
+			PipelineCacheHeader header;
+			memcpy(&header, buffer.data(), sizeof(PipelineCacheHeader));
+
+			if (header.magic != PipelineCacheMagic || header.version != PipelineCacheVersion ||
+			    header.vendorID != properties.vendorID || header.deviceID != properties.deviceID ||
+			    header.driverVersion != properties.driverVersion ||
+			    memcmp(header.uuid, properties.pipelineCacheUUID, VK_UUID_SIZE) != 0 ||
+			    header.dataSize != buffer.size() - sizeof(PipelineCacheHeader))
+				return false;
+
+			//the header of the driver itself
+			VkPipelineCacheHeaderVersionOne driverHeader;
+			memcpy(&driverHeader, buffer.data() + sizeof(PipelineCacheHeader), sizeof(VkPipelineCacheHeaderVersionOne));
+			return driverHeader.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE &&
+			       driverHeader.vendorID == properties.vendorID &&
+			       driverHeader.deviceID == properties.deviceID &&
+			       memcmp(driverHeader.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+		}
+
 		inline auto lookupQueueFamilyIndices(int32_t flags, std::vector<VkQueueFamilyProperties> &queueFamilyProperties) -> QueueFamilyIndices
 		{
 			QueueFamilyIndices indices;
@@ -57,7 +102,7 @@ namespace maple
 					auto &queueFamilyProperty = queueFamilyProperties[i];
 					if ((queueFamilyProperty.queueFlags & VK_QUEUE_TRANSFER_BIT) && ((queueFamilyProperty.queueFlags & VK_QUEUE_GRAPHICS_BIT) == 0) && ((queueFamilyProperty.queueFlags & VK_QUEUE_COMPUTE_BIT) == 0))
 					{
-						indices.presentFamily = i;
+						indices.transferFamily = i;
 						break;
 					}
 				}
@@ -65,12 +110,6 @@ namespace maple
 
 			for (uint32_t i = 0; i < queueFamilyProperties.size(); i++)
 			{
-				if ((flags & VK_QUEUE_TRANSFER_BIT) && !indices.presentFamily.has_value())
-				{
-					if (queueFamilyProperties[i].queueFlags & VK_QUEUE_TRANSFER_BIT)
-						indices.presentFamily = i;
-				}
-
 				if ((flags & VK_QUEUE_COMPUTE_BIT) && !indices.computeFamily.has_value())
 				{
 					if (queueFamilyProperties[i].queueFlags & VK_QUEUE_COMPUTE_BIT)
@@ -84,6 +123,10 @@ namespace maple
 				}
 			}
 
+			//without a transfer only family the uploads share the graphics queue, which can always transfer
+			if ((flags & VK_QUEUE_TRANSFER_BIT) && !indices.transferFamily.has_value())
+				indices.transferFamily = indices.graphicsFamily;
+
 			return indices;
 		}
 	}        // namespace
@@ -147,7 +190,7 @@ namespace maple
 
 		static const float defaultQueuePriority(0.0f);
 
-		int32_t requestedQueueTypes = VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT;        // | VK_QUEUE_COMPUTE_BIT | VK_QUEUE_TRANSFER_BIT;
+		int32_t requestedQueueTypes = VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT | VK_QUEUE_TRANSFER_BIT;
 		indices                     = lookupQueueFamilyIndices(requestedQueueTypes, queueFamilyProperties);
 
 		// Graphics queue
@@ -179,12 +222,12 @@ namespace maple
 		// transfer queue
 		if (requestedQueueTypes & VK_QUEUE_TRANSFER_BIT)
 		{
-			if ((indices.presentFamily != indices.graphicsFamily) && (indices.presentFamily != indices.computeFamily))
+			if ((indices.transferFamily != indices.graphicsFamily) && (indices.transferFamily != indices.computeFamily))
 			{
-				// If compute family index differs, we need an additional queue create info for the compute queue
+				// If transfer family index differs, we need an additional queue create info for the transfer queue
 				VkDeviceQueueCreateInfo queueInfo{};
 				queueInfo.sType            = VK_STRUCTURE_TYPE_DEVICE_QUEUE_CREATE_INFO;
-				queueInfo.queueFamilyIndex = indices.presentFamily.value();
+				queueInfo.queueFamilyIndex = indices.transferFamily.value();
 				queueInfo.queueCount       = 1;
 				queueInfo.pQueuePriorities = &defaultQueuePriority;
 				queueCreateInfos.emplace_back(queueInfo);
@@ -239,6 +282,8 @@ namespace maple
 		vkDestroyPipelineCache(device, pipelineCache, VK_NULL_HANDLE);
 
 #if defined(MAPLE_PROFILE) && defined(TRACY_ENABLE)
+		if (tracyComputeContext != nullptr)
+			TracyVkDestroy(tracyComputeContext);
 		TracyVkDestroy(tracyContext);
 #endif
 		if (device != nullptr)
@@ -264,6 +309,17 @@ namespace maple
 		tracyContext = TracyVkContext(*physicalDevice, device, graphicsQueue, tracyBuffer);
 		vkQueueWaitIdle(graphicsQueue);
 		vkFreeCommandBuffers(device, *commandPool, 1, &tracyBuffer);
+
+		if (asyncComputeSupport)
+		{
+			//the timestamps of the two queues are calibrated separately so their zones line up in one timeline
+			VulkanCommandPool computePool(physicalDevice->indices.computeFamily.value(), VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT);
+			allocInfo.commandPool = computePool;
+			vkAllocateCommandBuffers(device, &allocInfo, &tracyBuffer);
+			tracyComputeContext = TracyVkContext(*physicalDevice, device, computeQueue, tracyBuffer);
+			vkQueueWaitIdle(computeQueue);
+			vkFreeCommandBuffers(device, computePool, 1, &tracyBuffer);
+		}
 #endif
 	}
 
@@ -362,6 +418,16 @@ namespace maple
 		vkGetDeviceQueue(device, physicalDevice->indices.graphicsFamily.value(), 0, &graphicsQueue);
 		vkGetDeviceQueue(device, physicalDevice->indices.graphicsFamily.value(), 0, &presentQueue);
 		vkGetDeviceQueue(device, physicalDevice->indices.computeFamily.value(), 0, &computeQueue);
+		vkGetDeviceQueue(device, physicalDevice->indices.transferFamily.value(), 0, &transferQueue);
+
+		//features12 is queried above and enabled as a whole, so timeline semaphores are on whenever they are supported
+		asyncComputeSupport = features12.timelineSemaphore == VK_TRUE && physicalDevice->indices.computeFamily != physicalDevice->indices.graphicsFamily;
+		LOGI("Async compute : {0}", asyncComputeSupport ? "dedicated compute queue" : "disabled, compute runs on the graphics queue");
+		LOGI("Uploads : {0}", isDedicatedTransfer() ? "dedicated transfer queue" : "graphics queue");
+
+		textureCompressionBC   = physicalDeviceFeatures2.features.textureCompressionBC == VK_TRUE;
+		textureCompressionASTC = physicalDeviceFeatures2.features.textureCompressionASTC_LDR == VK_TRUE;
+		LOGI("Texture compression : BC {0}, ASTC {1}", textureCompressionBC, textureCompressionASTC);
 
 #ifdef USE_VMA_ALLOCATOR
 		VmaAllocatorCreateInfo allocatorInfo = {};
@@ -421,10 +487,82 @@ namespace maple
 
 	auto VulkanDevice::createPipelineCache() -> void
 	{
+		const auto begin = Application::getTimer().current();
+
+		//a cache from another device or driver is dropped, the driver would ignore or reject it anyway
+		auto buffer = File::read(PipelineCacheFile);
+		if (buffer != nullptr && !isPipelineCacheValid(*buffer, physicalDevice->getProperties()))
+		{
+			LOGW("{0} was written by another device or driver, it is discarded", PipelineCacheFile);
+			buffer = nullptr;
+		}
+
 		VkPipelineCacheCreateInfo pipelineCacheCI{};
 		pipelineCacheCI.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
 		pipelineCacheCI.pNext = NULL;
-		vkCreatePipelineCache(device, &pipelineCacheCI, VK_NULL_HANDLE, &pipelineCache);
+		if (buffer != nullptr)
+		{
+			pipelineCacheCI.initialDataSize = buffer->size() - sizeof(PipelineCacheHeader);
+			pipelineCacheCI.pInitialData    = buffer->data() + sizeof(PipelineCacheHeader);
+		}
+
+		if (vkCreatePipelineCache(device, &pipelineCacheCI, VK_NULL_HANDLE, &pipelineCache) != VK_SUCCESS && buffer != nullptr)
+		{
+			LOGW("Failed to create the pipeline cache from {0}, starting with an empty one", PipelineCacheFile);
+			pipelineCacheCI.initialDataSize = 0;
+			pipelineCacheCI.pInitialData    = nullptr;
+			vkCreatePipelineCache(device, &pipelineCacheCI, VK_NULL_HANDLE, &pipelineCache);
+			buffer = nullptr;
+		}
+
+		LOGI("Pipeline cache : {0} KB loaded in {1} ms", buffer != nullptr ? pipelineCacheCI.initialDataSize / 1024 : 0,
+		     Application::getTimer().elapsed(begin, Application::getTimer().current()) / 1000.f);
+	}
+
+	auto VulkanDevice::savePipelineCache() -> void
+	{
+		if (device == nullptr || pipelineCache == VK_NULL_HANDLE)
+			return;
+
+		//the cache still grows while pipelines are compiled in jobs, VK_INCOMPLETE means it outgrew the size
+		//queried before, which is then asked for again
+		size_t               size   = 0;
+		VkResult             result = VK_INCOMPLETE;
+		std::vector<uint8_t> buffer;
+		for (uint32_t i = 0; i < 4 && result == VK_INCOMPLETE; i++)
+		{
+			if (vkGetPipelineCacheData(device, pipelineCache, &size, nullptr) != VK_SUCCESS || size == 0)
+				return;
+			buffer.resize(sizeof(PipelineCacheHeader) + size);
+			result = vkGetPipelineCacheData(device, pipelineCache, &size, buffer.data() + sizeof(PipelineCacheHeader));
+		}
+
+		if (result != VK_SUCCESS)
+		{
+			LOGW("Pipeline cache : failed to read the cache data, {0} is not written", PipelineCacheFile);
+			return;
+		}
+
+		auto &properties = physicalDevice->getProperties();
+
+		PipelineCacheHeader header;
+		header.magic         = PipelineCacheMagic;
+		header.version       = PipelineCacheVersion;
+		header.vendorID      = properties.vendorID;
+		header.deviceID      = properties.deviceID;
+		header.driverVersion = properties.driverVersion;
+		header.dataSize      = size;
+		memcpy(header.uuid, properties.pipelineCacheUUID, VK_UUID_SIZE);
+		memcpy(buffer.data(), &header, sizeof(PipelineCacheHeader));
+
+		std::error_code error;
+		std::filesystem::create_directories(PipelineCacheFolder, error);
+
+		std::ofstream stream(PipelineCacheFile, std::ios::binary | std::ios::trunc);
+		if (!stream.write(reinterpret_cast<const char *>(buffer.data()), sizeof(PipelineCacheHeader) + size))
+			LOGW("Failed to write {0}", PipelineCacheFile);
+		else
+			LOGI("Pipeline cache : {0} KB saved", size / 1024);
 	}
 
 	std::shared_ptr<VulkanDevice> VulkanDevice::instance;
@@ -434,5 +572,10 @@ namespace maple
 	{
 		return tracyContext;
 	}
+
+	auto VulkanDevice::getTracyComputeContext() -> tracy::VkCtx *
+	{
+		return tracyComputeContext;
+	}
 #endif
 };        // namespace maple
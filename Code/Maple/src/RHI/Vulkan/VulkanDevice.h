@@ -89,6 +89,9 @@ namespace maple
 		auto init() -> bool;
 		auto createPipelineCache() -> void;
 
+		//stored under cache/ on shutdown, createPipelineCache reloads it when the device and driver match
+		auto savePipelineCache() -> void;
+
 		inline const auto getPhysicalDevice() const
 		{
 			return physicalDevice;
@@ -111,6 +114,34 @@ namespace maple
 			return computeQueue;
 		}
 
+		inline auto getTransferQueue()
+		{
+			return transferQueue;
+		}
+
+		//uploads run on their own queue family and hand the resources over to the graphics queue
+		inline auto isDedicatedTransfer() const
+		{
+			return physicalDevice->getQueueFamilyIndices().transferFamily != physicalDevice->getQueueFamilyIndices().graphicsFamily;
+		}
+
+		//async compute needs its own queue family and timeline semaphores to order it against the graphics queue
+		inline auto isAsyncComputeSupported() const
+		{
+			return asyncComputeSupport;
+		}
+
+		//the features are queried and enabled as a whole, these tell which block compressed formats can be sampled
+		inline auto isTextureCompressionBCSupported() const
+		{
+			return textureCompressionBC;
+		}
+
+		inline auto isTextureCompressionASTCSupported() const
+		{
+			return textureCompressionASTC;
+		}
+
 		inline auto getCommandPool()
 		{
 			return commandPool;
@@ -143,6 +174,8 @@ namespace maple
 
 #if defined(MAPLE_PROFILE) && defined(TRACY_ENABLE)
 		auto getTracyContext() -> tracy::VkCtx *;
+		//the timestamps of the compute queue are collected on their own, nullptr without async compute
+		auto getTracyComputeContext() -> tracy::VkCtx *;
 #endif
 
 	  private:
@@ -156,18 +189,23 @@ namespace maple
 		VkQueue  graphicsQueue;
 		VkQueue  presentQueue;
 		VkQueue  computeQueue;
+		VkQueue  transferQueue;
 
 		VkPhysicalDeviceFeatures enabledFeatures;
-		VkPipelineCache          pipelineCache;
+		VkPipelineCache          pipelineCache = VK_NULL_HANDLE;
 
 #if defined(MAPLE_PROFILE) && defined(TRACY_ENABLE)
-		tracy::VkCtx *tracyContext;
+		tracy::VkCtx *tracyContext        = nullptr;
+		tracy::VkCtx *tracyComputeContext = nullptr;
 #endif
 
 #ifdef USE_VMA_ALLOCATOR
 		VmaAllocator allocator{};
 #endif
 
-		bool enableDebugMarkers = false;
+		bool enableDebugMarkers     = false;
+		bool asyncComputeSupport    = false;
+		bool textureCompressionBC   = false;
+		bool textureCompressionASTC = false;
 	};
 };        // namespace maple
@@ -0,0 +1,169 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+#include "VulkanFrameAllocator.h"
+#include "Engine/Profiler.h"
+#include "Others/Console.h"
+#include "VulkanDevice.h"
+#include "VulkanHelper.h"
+
+#include <algorithm>
+
+namespace maple
+{
+	namespace
+	{
+		constexpr VkBufferUsageFlags FrameBufferUsage = VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+		                                                VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT;
+
+		inline auto alignUp(uint32_t value, uint32_t alignment) -> uint32_t
+		{
+			return (value + alignment - 1) / alignment * alignment;
+		}
+
+		inline auto withHeadroom(uint32_t size) -> uint32_t
+		{
+			return size + size / 4;
+		}
+	}        // namespace
+
+	VulkanFrameAllocator::VulkanFrameAllocator(uint32_t frames, uint32_t frameCapacity) :
+	    frames(frames), frameCapacity(frameCapacity)
+	{
+		auto &limits = VulkanDevice::get()->getPhysicalDevice()->getProperties().limits;
+		minAlignment = std::max<uint32_t>(minAlignment, static_cast<uint32_t>(limits.minUniformBufferOffsetAlignment));
+		minAlignment = std::max<uint32_t>(minAlignment, static_cast<uint32_t>(limits.minStorageBufferOffsetAlignment));
+		block        = createBlock(uint64_t(frames) * frameCapacity);
+	}
+
+	VulkanFrameAllocator::~VulkanFrameAllocator()
+	{
+		for (auto &old : retired)
+			destroyBlock(old);
+		destroyBlock(block);
+	}
+
+	auto VulkanFrameAllocator::allocate(uint32_t size, uint32_t alignment) -> Allocation
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+
+		alignment   = std::max(alignment, minAlignment);
+		auto offset = alignUp(head, alignment);
+
+		demand += offset - head + size;
+
+		if (offset + size > frameCapacity)
+		{
+			//the offsets already handed out this frame keep pointing into the old block,
+			//the descriptor sets bound before are replaced instead of rewritten, see VulkanDescriptorSet::uploadUniforms
+			LOGW("Frame allocator is full in the middle of a frame");
+			grow(withHeadroom(demand));
+			offset = 0;
+		}
+
+		head      = offset + size;
+		peakUsage = std::max(peakUsage, head);
+
+		const auto base = frame * frameCapacity + offset;
+		return {block.buffer, base, block.mapped + base};
+	}
+
+	auto VulkanFrameAllocator::beginFrame(uint32_t frameIndex) -> void
+	{
+		PROFILE_FUNCTION();
+		std::lock_guard<std::mutex> lock(mutex);
+
+		//nothing of the new frame is bound yet, so the sets pointing to the old block can still be rewritten
+		if (withHeadroom(demand) > frameCapacity)
+			grow(withHeadroom(demand));
+
+		frame  = frameIndex;
+		head   = 0;
+		demand = 0;
+		frameCounter++;
+
+		//every frame which could read a retired block has completed
+		for (auto iter = retired.begin(); iter != retired.end();)
+		{
+			if (frameCounter > iter->retiredFrame + frames)
+			{
+				destroyBlock(*iter);
+				iter = retired.erase(iter);
+			}
+			else
+			{
+				iter++;
+			}
+		}
+	}
+
+	auto VulkanFrameAllocator::grow(uint32_t size) -> void
+	{
+		auto capacity = frameCapacity * 2;
+		while (capacity < size)
+			capacity *= 2;
+
+		LOGW("Frame allocator grows from {0} KB to {1} KB per frame", frameCapacity / 1024, capacity / 1024);
+
+		block.retiredFrame = frameCounter;
+		retired.emplace_back(block);
+		block         = createBlock(uint64_t(frames) * capacity);
+		frameCapacity = capacity;
+	}
+
+	auto VulkanFrameAllocator::createBlock(uint64_t size) -> Block
+	{
+		PROFILE_FUNCTION();
+		Block newBlock;
+
+		VkBufferCreateInfo bufferInfo = {};
+		bufferInfo.sType              = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+		bufferInfo.size               = size;
+		bufferInfo.usage              = FrameBufferUsage;
+		bufferInfo.sharingMode        = VK_SHARING_MODE_EXCLUSIVE;
+
+#ifdef USE_VMA_ALLOCATOR
+		VmaAllocationCreateInfo vmaCreateInfo = {};
+		vmaCreateInfo.flags                   = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+		vmaCreateInfo.usage                   = VMA_MEMORY_USAGE_CPU_TO_GPU;
+		vmaCreateInfo.requiredFlags           = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+
+		VmaAllocationInfo allocationInfo{};
+		VK_CHECK_RESULT(vmaCreateBuffer(VulkanDevice::get()->getAllocator(), &bufferInfo, &vmaCreateInfo, &newBlock.buffer, &newBlock.allocation, &allocationInfo));
+		newBlock.mapped = static_cast<uint8_t *>(allocationInfo.pMappedData);
+#else
+		VK_CHECK_RESULT(vkCreateBuffer(*VulkanDevice::get(), &bufferInfo, nullptr, &newBlock.buffer));
+
+		VkMemoryRequirements memRequirements;
+		vkGetBufferMemoryRequirements(*VulkanDevice::get(), newBlock.buffer, &memRequirements);
+
+		VkMemoryAllocateInfo allocInfo = {};
+		allocInfo.sType                = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+		allocInfo.allocationSize       = memRequirements.size;
+		allocInfo.memoryTypeIndex      = VulkanHelper::findMemoryType(memRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+		VK_CHECK_RESULT(vkAllocateMemory(*VulkanDevice::get(), &allocInfo, nullptr, &newBlock.memory));
+		VK_CHECK_RESULT(vkBindBufferMemory(*VulkanDevice::get(), newBlock.buffer, newBlock.memory, 0));
+
+		void *mapped = nullptr;
+		VK_CHECK_RESULT(vkMapMemory(*VulkanDevice::get(), newBlock.memory, 0, VK_WHOLE_SIZE, 0, &mapped));
+		newBlock.mapped = static_cast<uint8_t *>(mapped);
+#endif
+		VulkanHelper::setObjectName("FrameAllocator", (uint64_t) newBlock.buffer, VK_OBJECT_TYPE_BUFFER);
+		return newBlock;
+	}
+
+	auto VulkanFrameAllocator::destroyBlock(Block &old) -> void
+	{
+		if (old.buffer == VK_NULL_HANDLE)
+			return;
+#ifdef USE_VMA_ALLOCATOR
+		vmaDestroyBuffer(VulkanDevice::get()->getAllocator(), old.buffer, old.allocation);
+#else
+		vkUnmapMemory(*VulkanDevice::get(), old.memory);
+		vkDestroyBuffer(*VulkanDevice::get(), old.buffer, nullptr);
+		vkFreeMemory(*VulkanDevice::get(), old.memory, nullptr);
+#endif
+		old = {};
+	}
+}        // namespace maple
@@ -0,0 +1,87 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "Engine/Core.h"
+#include "Vk.h"
+
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace maple
+{
+	/**
+	 * Linear allocator over one persistently mapped buffer, split into one region per frame in flight.
+	 * Uniform blocks, per draw data and transient vertices are bump allocated from the region of the current frame
+	 * and bound with offsets. A region is recycled by beginFrame once the fence of its frame has signaled.
+	 * The buffer is grown by beginFrame from what the last frame asked for, so the descriptors pointing to it are
+	 * rewritten before the frame binds them. Growing in the middle of a frame is the fallback for a sudden spike.
+	 */
+	class VulkanFrameAllocator
+	{
+	  public:
+		struct Allocation
+		{
+			VkBuffer buffer = VK_NULL_HANDLE;
+			uint32_t offset = 0;        //from the start of the buffer
+			uint8_t *mapped = nullptr;
+		};
+
+		VulkanFrameAllocator(uint32_t frames, uint32_t frameCapacity);
+		~VulkanFrameAllocator();
+		NO_COPYABLE(VulkanFrameAllocator);
+
+		//thread safe. grows the buffer when the region of the frame is full, the old buffer lives until its frames completed
+		auto allocate(uint32_t size, uint32_t alignment = 0) -> Allocation;
+
+		//reserves a quarter on top of the demand of the last frame before anything of the new frame is allocated
+		auto beginFrame(uint32_t frame) -> void;
+
+		//increases with every beginFrame, allocations made in an older frame may have been recycled
+		inline auto getFrameCounter() const
+		{
+			return frameCounter;
+		}
+
+		inline auto getFrameCapacity() const
+		{
+			return frameCapacity;
+		}
+
+		inline auto getPeakUsage() const
+		{
+			return peakUsage;
+		}
+
+	  private:
+		struct Block
+		{
+			VkBuffer buffer = VK_NULL_HANDLE;
+			uint8_t *mapped = nullptr;
+#ifdef USE_VMA_ALLOCATOR
+			VmaAllocation allocation = nullptr;
+#else
+			VkDeviceMemory memory = VK_NULL_HANDLE;
+#endif
+			uint64_t retiredFrame = 0;
+		};
+
+		auto createBlock(uint64_t size) -> Block;
+		auto destroyBlock(Block &block) -> void;
+		auto grow(uint32_t size) -> void;
+
+		std::mutex         mutex;
+		Block              block;
+		std::vector<Block> retired;
+
+		uint32_t frames        = 0;
+		uint32_t frameCapacity = 0;
+		uint32_t frame         = 0;
+		uint32_t head          = 0;        //offset inside the region of the frame
+		uint32_t demand        = 0;        //bytes asked for in the frame, including the ones before a growth
+		uint32_t peakUsage     = 0;
+		uint32_t minAlignment  = 16;
+		uint64_t frameCounter  = 0;
+	};
+}        // namespace maple
@@ -11,6 +11,7 @@
 #include "VulkanDescriptorSet.h"
 #include "VulkanDevice.h"
 #include "VulkanSwapChain.h"
+#include "VulkanUploadManager.h"
 
 #include <string>
 
@@ -711,7 +712,9 @@ namespace maple
 
 		bool singleTimeCommand = false;
 
-		if (!commandBuffer)
+		auto uploads = VulkanContext::getUploadManager();
+
+		if (!commandBuffer && uploads == nullptr)
 		{
 			commandBuffer     = beginSingleTimeCommands();
 			singleTimeCommand = true;
@@ -741,6 +744,11 @@ namespace maple
 		{
 			imageMemoryBarrier.srcQueueFamilyIndex = VulkanDevice::get()->getPhysicalDevice()->getQueueFamilyIndices().computeFamily.value();
 			imageMemoryBarrier.dstQueueFamilyIndex = VulkanDevice::get()->getPhysicalDevice()->getQueueFamilyIndices().computeFamily.value();
+
+			//attachment accesses do not exist on a compute queue
+			constexpr VkAccessFlags computeAccess = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT;
+			imageMemoryBarrier.srcAccessMask &= computeAccess;
+			imageMemoryBarrier.dstAccessMask &= computeAccess;
 		}
 		else
 		{
@@ -748,6 +756,18 @@ namespace maple
 			imageMemoryBarrier.dstQueueFamilyIndex = VulkanDevice::get()->getPhysicalDevice()->getQueueFamilyIndices().graphicsFamily.value();
 		}
 
+		if (!singleTimeCommand && BarrierBatch::add(cmd, imageMemoryBarrier))
+			return;
+
+		//without a command buffer the transition is recorded into the upload batch, which runs before the next frame
+		if (!commandBuffer)
+		{
+			uploads->record([&](VkCommandBuffer uploadCmd) {
+				vkCmdPipelineBarrier(uploadCmd, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, 0, 0, nullptr, 0, nullptr, 1, &imageMemoryBarrier);
+			});
+			return;
+		}
+
 		vkCmdPipelineBarrier(
 		    commandBuffer,
 		    VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
@@ -761,6 +781,61 @@ namespace maple
 			endSingleTimeCommands(commandBuffer);
 	}
 
+	namespace
+	{
+		thread_local VulkanHelper::BarrierBatch *currentBatch = nullptr;
+
+		inline auto isSameRange(const VkImageSubresourceRange &left, const VkImageSubresourceRange &right)
+		{
+			return left.aspectMask == right.aspectMask && left.baseMipLevel == right.baseMipLevel && left.levelCount == right.levelCount &&
+			       left.baseArrayLayer == right.baseArrayLayer && left.layerCount == right.layerCount;
+		}
+	}        // namespace
+
+	VulkanHelper::BarrierBatch::BarrierBatch(const VulkanCommandBuffer *cmd) :
+	    commandBuffer(cmd), previous(currentBatch)
+	{
+		currentBatch = this;
+	}
+
+	VulkanHelper::BarrierBatch::~BarrierBatch()
+	{
+		currentBatch = previous;
+		if (!barriers.empty())
+		{
+			vkCmdPipelineBarrier(
+			    commandBuffer->getCommandBuffer(),
+			    VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+			    VK_PIPELINE_STAGE_ALL_COMMANDS_BIT,
+			    0,
+			    0, nullptr,
+			    0, nullptr,
+			    static_cast<uint32_t>(barriers.size()), barriers.data());
+		}
+	}
+
+	auto VulkanHelper::BarrierBatch::add(const VulkanCommandBuffer *cmd, const VkImageMemoryBarrier &barrier) -> bool
+	{
+		auto batch = currentBatch;
+		if (batch == nullptr || cmd == nullptr || batch->commandBuffer != cmd)
+			return false;
+
+		//transitions of the same subresource inside one barrier are not ordered, chain them into one
+		for (auto iter = batch->barriers.begin(); iter != batch->barriers.end(); iter++)
+		{
+			if (iter->image == barrier.image && isSameRange(iter->subresourceRange, barrier.subresourceRange))
+			{
+				iter->newLayout     = barrier.newLayout;
+				iter->dstAccessMask = barrier.dstAccessMask;
+				if (iter->oldLayout == iter->newLayout)
+					batch->barriers.erase(iter);
+				return true;
+			}
+		}
+		batch->barriers.emplace_back(barrier);
+		return true;
+	}
+
 	auto VulkanHelper::beginSingleTimeCommands() -> VkCommandBuffer
 	{
 		VkCommandBufferAllocateInfo allocInfo{};
@@ -795,14 +870,39 @@ namespace maple
 		submitInfo.signalSemaphoreCount = 0;
 		submitInfo.waitSemaphoreCount   = 0;
 
-		VK_CHECK_RESULT(vkQueueSubmit(VulkanDevice::get()->getGraphicsQueue(), 1, &submitInfo, VK_NULL_HANDLE));
-		VK_CHECK_RESULT(vkQueueWaitIdle(VulkanDevice::get()->getGraphicsQueue()));
+		//the pending uploads come first in submission order, the commands may read them
+		if (auto uploads = VulkanContext::getUploadManager())
+			uploads->flush();
+
+		//only this submit is waited for, the frames in flight on the queue keep running
+		VkFenceCreateInfo fenceInfo{};
+		fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+		VkFence fence   = VK_NULL_HANDLE;
+		VK_CHECK_RESULT(vkCreateFence(*VulkanDevice::get(), &fenceInfo, nullptr, &fence));
 
+		VK_CHECK_RESULT(vkQueueSubmit(VulkanDevice::get()->getGraphicsQueue(), 1, &submitInfo, fence));
+		VK_CHECK_RESULT(vkWaitForFences(*VulkanDevice::get(), 1, &fence, VK_TRUE, UINT64_MAX));
+
+		vkDestroyFence(*VulkanDevice::get(), fence, nullptr);
 		vkFreeCommandBuffers(*VulkanDevice::get(), *VulkanDevice::get()->getCommandPool(), 1, &commandBuffer);
 	}
 
 	auto VulkanHelper::copyBufferToImage(VkBuffer buffer, VkImage image, uint32_t width, uint32_t height, uint32_t depth, int32_t offsetX, int32_t offsetY, int32_t offsetZ) -> void
 	{
+		//the staging buffer has to outlive the next frame, buffers released through the deletion queue do
+		if (auto uploads = VulkanContext::getUploadManager())
+		{
+			uploads->record([&](VkCommandBuffer commandBuffer) {
+				VkBufferImageCopy region{};
+				region.imageSubresource.aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+				region.imageSubresource.layerCount = 1;
+				region.imageOffset                 = {offsetX, offsetY, offsetZ};
+				region.imageExtent                 = {width, height, depth};
+				vkCmdCopyBufferToImage(commandBuffer, buffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+			});
+			return;
+		}
+
 		VkCommandBuffer commandBuffer = beginSingleTimeCommands();
 
 		VkBufferImageCopy region;
@@ -1042,6 +1142,18 @@ namespace maple
 						return VK_FORMAT_R32G32B32_SFLOAT;
 					case TextureFormat::RGBA32:
 						return VK_FORMAT_R32G32B32A32_SFLOAT;
+					case TextureFormat::BC1:
+						return VK_FORMAT_BC1_RGBA_SRGB_BLOCK;
+					case TextureFormat::BC3:
+						return VK_FORMAT_BC3_SRGB_BLOCK;
+					case TextureFormat::BC4:
+						return VK_FORMAT_BC4_UNORM_BLOCK;
+					case TextureFormat::BC5:
+						return VK_FORMAT_BC5_UNORM_BLOCK;
+					case TextureFormat::BC7:
+						return VK_FORMAT_BC7_SRGB_BLOCK;
+					case TextureFormat::ASTC_4x4:
+						return VK_FORMAT_ASTC_4x4_SRGB_BLOCK;
 					default:
 						MAPLE_ASSERT(ignoreAssert, "[Texture] Unsupported image bit-depth!");
 						return VK_FORMAT_UNDEFINED;
@@ -1079,6 +1191,18 @@ namespace maple
 						return VK_FORMAT_R32_SINT;
 					case TextureFormat::RG16F:
 						return VK_FORMAT_R16G16_SFLOAT;
+					case TextureFormat::BC1:
+						return VK_FORMAT_BC1_RGBA_UNORM_BLOCK;
+					case TextureFormat::BC3:
+						return VK_FORMAT_BC3_UNORM_BLOCK;
+					case TextureFormat::BC4:
+						return VK_FORMAT_BC4_UNORM_BLOCK;
+					case TextureFormat::BC5:
+						return VK_FORMAT_BC5_UNORM_BLOCK;
+					case TextureFormat::BC7:
+						return VK_FORMAT_BC7_UNORM_BLOCK;
+					case TextureFormat::ASTC_4x4:
+						return VK_FORMAT_ASTC_4x4_UNORM_BLOCK;
 					default:
 						MAPLE_ASSERT(ignoreAssert, "[Texture] Unsupported image bit-depth!");
 						return VK_FORMAT_UNDEFINED;
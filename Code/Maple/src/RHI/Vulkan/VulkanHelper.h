@@ -43,6 +43,7 @@ namespace maple
 		std::optional<uint32_t> graphicsFamily;
 		std::optional<uint32_t> presentFamily;
 		std::optional<uint32_t> computeFamily;
+		std::optional<uint32_t> transferFamily;        //a transfer only family when there is one, used for uploads
 		auto                    isComplete()
 		{
 			return graphicsFamily.has_value() && presentFamily.has_value() && computeFamily.has_value();
@@ -238,6 +239,25 @@ namespace maple
 		                           uint32_t mipLevels = 1, uint32_t layerCount = 1, const VulkanCommandBuffer *cmd = nullptr,
 		                           bool depth = true, uint32_t baseArrayLayer = 0, uint32_t baseMipLevel = 0) -> void;
 
+		/**
+		 * While a batch is alive, transitionImageLayout only collects the barriers recorded into its command buffer on this thread,
+		 * they are issued by one vkCmdPipelineBarrier when the batch is destroyed. No other command may be recorded in between.
+		 */
+		class BarrierBatch
+		{
+		  public:
+			BarrierBatch(const VulkanCommandBuffer *cmd);
+			~BarrierBatch();
+
+			//return false if the barrier has to be recorded immediately
+			static auto add(const VulkanCommandBuffer *cmd, const VkImageMemoryBarrier &barrier) -> bool;
+
+		  private:
+			const VulkanCommandBuffer *       commandBuffer;
+			BarrierBatch *                    previous;
+			std::vector<VkImageMemoryBarrier> barriers;
+		};
+
 		auto copyBufferToImage(VkBuffer buffer, VkImage image, uint32_t width, uint32_t height, uint32_t depth = 1, int32_t offsetX = 0, int32_t offsetY = 0, int32_t offsetZ = 0) -> void;
 		auto createTextureSampler(VkFilter magFilter = VK_FILTER_LINEAR, VkFilter minFilter = VK_FILTER_LINEAR, float minLod = 0.0f, float maxLod = 1.0f, bool anisotropyEnable = false, float maxAnisotropy = 1.0f, VkSamplerAddressMode modeU = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE, VkSamplerAddressMode modeV = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE, VkSamplerAddressMode modeW = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE) -> VkSampler;
 		auto beginSingleTimeCommands() -> VkCommandBuffer;
@@ -13,9 +13,16 @@
 #include "VulkanTexture.h"
 
 #include "Engine/Vertex.h"
+#include "FileSystem/File.h"
 #include "Others/Console.h"
+#include "Thread/JobSystem.h"
 
+#include <filesystem>
+#include <fstream>
 #include <memory>
+#include <mutex>
+#include <set>
+#include <sstream>
 
 #include "Application.h"
 
@@ -101,20 +108,81 @@ namespace maple
 			ms.minSampleShading      = 0.0;
 		}
 
-		inline auto createVertexLayout(VkVertexInputBindingDescription &vertexBindingDescription, VkPipelineVertexInputStateCreateInfo &vi, std::shared_ptr<VulkanShader> vkShader) -> void
+		inline auto formatToVk(Format format) -> VkFormat
 		{
-			vertexBindingDescription.binding   = 0;
-			vertexBindingDescription.inputRate = VK_VERTEX_INPUT_RATE_VERTEX;
-			vertexBindingDescription.stride    = vkShader->getVertexInputStride();
+			switch (format)
+			{
+				case Format::R32G32B32A32_UINT:
+					return VK_FORMAT_R32G32B32A32_UINT;
+				case Format::R32G32B32_UINT:
+					return VK_FORMAT_R32G32B32_UINT;
+				case Format::R32G32_UINT:
+					return VK_FORMAT_R32G32_UINT;
+				case Format::R32_UINT:
+					return VK_FORMAT_R32_UINT;
+				case Format::R8_UINT:
+					return VK_FORMAT_R8_UINT;
+				case Format::R32G32B32A32_INT:
+					return VK_FORMAT_R32G32B32A32_SINT;
+				case Format::R32G32B32_INT:
+					return VK_FORMAT_R32G32B32_SINT;
+				case Format::R32G32_INT:
+					return VK_FORMAT_R32G32_SINT;
+				case Format::R32_INT:
+					return VK_FORMAT_R32_SINT;
+				case Format::R32G32B32A32_FLOAT:
+					return VK_FORMAT_R32G32B32A32_SFLOAT;
+				case Format::R32G32B32_FLOAT:
+					return VK_FORMAT_R32G32B32_SFLOAT;
+				case Format::R32G32_FLOAT:
+					return VK_FORMAT_R32G32_SFLOAT;
+				case Format::R32_FLOAT:
+					return VK_FORMAT_R32_SFLOAT;
+				case Format::R16G16B16A16_UNORM:
+					return VK_FORMAT_R16G16B16A16_UNORM;
+				case Format::R16G16B16A16_UINT:
+					return VK_FORMAT_R16G16B16A16_UINT;
+				case Format::R16G16_SNORM:
+					return VK_FORMAT_R16G16_SNORM;
+				case Format::R16G16_FLOAT:
+					return VK_FORMAT_R16G16_SFLOAT;
+				case Format::R8G8B8A8_UNORM:
+					return VK_FORMAT_R8G8B8A8_UNORM;
+			}
+			return VK_FORMAT_UNDEFINED;
+		}
 
-			auto &vertexInputAttributeDescription = vkShader->getVertexInputAttributeDescription();
+		struct VertexInput
+		{
+			std::vector<VkVertexInputBindingDescription>   bindings;
+			std::vector<VkVertexInputAttributeDescription> attributes;
+		};
+
+		inline auto createVertexLayout(VertexInput &input, VkPipelineVertexInputStateCreateInfo &vi, const PipelineInfo &info, const VulkanShader *vkShader) -> void
+		{
+			if (info.vertexLayout == VertexLayout::Reflected)
+			{
+				input.bindings.push_back({0, vkShader->getVertexInputStride(), VK_VERTEX_INPUT_RATE_VERTEX});
+				input.attributes = vkShader->getVertexInputAttributeDescription();
+			}
+			else
+			{
+				//one binding per stream, the shader reads the attributes it declares
+				auto &streams = BufferLayout::get(info.vertexLayout);
+				for (uint32_t binding = 0; binding < streams.size(); binding++)
+				{
+					input.bindings.push_back({binding, streams[binding].getStride(), VK_VERTEX_INPUT_RATE_VERTEX});
+					for (auto &element : streams[binding].getLayout())
+						input.attributes.push_back({element.location, binding, formatToVk(element.format), element.offset});
+				}
+			}
 
 			vi.sType                           = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
 			vi.pNext                           = NULL;
-			vi.vertexBindingDescriptionCount   = 1;
-			vi.pVertexBindingDescriptions      = &vertexBindingDescription;
-			vi.vertexAttributeDescriptionCount = uint32_t(vertexInputAttributeDescription.size());
-			vi.pVertexAttributeDescriptions    = vertexInputAttributeDescription.data();
+			vi.vertexBindingDescriptionCount   = uint32_t(input.bindings.size());
+			vi.pVertexBindingDescriptions      = input.bindings.data();
+			vi.vertexAttributeDescriptionCount = uint32_t(input.attributes.size());
+			vi.pVertexAttributeDescriptions    = input.attributes.data();
 		}
 
 		inline auto createRasterization(VkPipelineInputAssemblyStateCreateInfo &inputAssemblyCI, VkPipelineRasterizationStateCreateInfo &rs, const PipelineInfo &info) -> void
@@ -143,9 +211,9 @@ namespace maple
 			rs.pNext                   = NULL;
 		}
 
-		inline auto createColorBlend(VkPipelineColorBlendStateCreateInfo &cb, std::vector<VkPipelineColorBlendAttachmentState> &blendAttachState, const PipelineInfo &info, std::shared_ptr<VulkanRenderPass> renderPass) -> void
+		inline auto createColorBlend(VkPipelineColorBlendStateCreateInfo &cb, std::vector<VkPipelineColorBlendAttachmentState> &blendAttachState, const PipelineInfo &info, uint32_t colorAttachmentCount) -> void
 		{
-			blendAttachState.resize(renderPass->getColorAttachmentCount());
+			blendAttachState.resize(colorAttachmentCount);
 			cb.sType = VK_STRUCTURE_TYPE_PIPELINE_COLOR_BLEND_STATE_CREATE_INFO;
 			cb.pNext = NULL;
 			cb.flags = 0;
@@ -215,22 +283,226 @@ namespace maple
 			dynamicState.emplace_back(VK_DYNAMIC_STATE_SCISSOR);
 		}
 
+		//only reads the info, the shader and the render pass, so it can run on any thread
+		inline auto createGraphicsPipeline(const PipelineInfo &info, const VulkanShader *vkShader, VkRenderPass renderPass, uint32_t colorAttachmentCount) -> VkPipeline
+		{
+			// Pipeline
+			std::vector<VkDynamicState>      dynamicStateDescriptors;
+			VkPipelineDynamicStateCreateInfo dynamicStateCI{};
+			dynamicStateCI.sType          = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
+			dynamicStateCI.pNext          = NULL;
+			dynamicStateCI.pDynamicStates = dynamicStateDescriptors.data();
+
+			// Vertex layout
+			VertexInput                          vertexInput;
+			VkPipelineVertexInputStateCreateInfo vi{};
+			createVertexLayout(vertexInput, vi, info, vkShader);
+
+			VkPipelineInputAssemblyStateCreateInfo inputAssemblyCI{};
+			VkPipelineRasterizationStateCreateInfo rs{};
+			createRasterization(inputAssemblyCI, rs, info);
+
+			VkPipelineColorBlendStateCreateInfo              cb{};
+			std::vector<VkPipelineColorBlendAttachmentState> blendAttachState;
+			createColorBlend(cb, blendAttachState, info, colorAttachmentCount);
+
+			VkPipelineViewportStateCreateInfo vp{};
+			createViewport(vp, dynamicStateDescriptors);
+
+			if (info.depthBiasEnabled)
+				dynamicStateDescriptors.emplace_back(VK_DYNAMIC_STATE_DEPTH_BIAS);
+
+			VkPipelineDepthStencilStateCreateInfo ds{};
+			createDepthStencil(ds, info);
+			VkPipelineMultisampleStateCreateInfo ms{};
+			createMultisample(ms);
+
+			dynamicStateCI.dynamicStateCount = uint32_t(dynamicStateDescriptors.size());
+			dynamicStateCI.pDynamicStates    = dynamicStateDescriptors.data();
+
+			VkGraphicsPipelineCreateInfo graphicsPipelineCreateInfo{};
+			graphicsPipelineCreateInfo.sType               = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
+			graphicsPipelineCreateInfo.pNext               = NULL;
+			graphicsPipelineCreateInfo.layout              = vkShader->getPipelineLayout();
+			graphicsPipelineCreateInfo.basePipelineHandle  = VK_NULL_HANDLE;
+			graphicsPipelineCreateInfo.basePipelineIndex   = -1;
+			graphicsPipelineCreateInfo.pVertexInputState   = &vi;
+			graphicsPipelineCreateInfo.pInputAssemblyState = &inputAssemblyCI;
+			graphicsPipelineCreateInfo.pRasterizationState = &rs;
+			graphicsPipelineCreateInfo.pColorBlendState    = &cb;
+			graphicsPipelineCreateInfo.pTessellationState  = VK_NULL_HANDLE;
+			graphicsPipelineCreateInfo.pMultisampleState   = &ms;
+			graphicsPipelineCreateInfo.pDynamicState       = &dynamicStateCI;
+			graphicsPipelineCreateInfo.pViewportState      = &vp;
+			graphicsPipelineCreateInfo.pDepthStencilState  = &ds;
+			graphicsPipelineCreateInfo.pStages             = vkShader->getShaderStages().data();
+			graphicsPipelineCreateInfo.stageCount          = vkShader->getShaderStages().size();
+			graphicsPipelineCreateInfo.renderPass          = renderPass;
+			graphicsPipelineCreateInfo.subpass             = 0;
+
+			VkPipeline pipeline = VK_NULL_HANDLE;
+			VK_CHECK_RESULT(vkCreateGraphicsPipelines(*VulkanDevice::get(), VulkanDevice::get()->getPipelineCache(), 1, &graphicsPipelineCreateInfo, VK_NULL_HANDLE, &pipeline));
+			return pipeline;
+		}
+
+		constexpr char PipelineRecordFile[] = "cache/pipelines.list";
+
+		//one line per graphics pipeline created in this session, see makeRecord
+		std::mutex            recordMutex;
+		std::set<std::string> records;
+
+		std::shared_ptr<JobCounter> prewarmCounter;
+
+		inline auto getAttachmentFormat(const std::shared_ptr<Texture> &texture) -> VkFormat
+		{
+			switch (texture->getType())
+			{
+				case TextureType::Color:
+					return static_cast<VulkanTexture2D *>(texture.get())->getVkFormat();
+				case TextureType::Depth:
+					return static_cast<VulkanTextureDepth *>(texture.get())->getVkFormat();
+				case TextureType::DepthArray:
+					return VulkanHelper::getDepthFormat();
+				default:
+					return VK_FORMAT_UNDEFINED;
+			}
+		}
+
+		/**
+		 * shader path, the fixed function states and the attachment formats, which is all a compatible pipeline needs.
+		 * The textures themselves do not exist before the renderer is initialized, so they are not recorded.
+		 */
+		inline auto makeRecord(const PipelineInfo &info) -> std::string
+		{
+			std::vector<VkFormat> colorFormats;
+			VkFormat              depthFormat = VK_FORMAT_UNDEFINED;
+
+			if (info.swapChainTarget)
+				colorFormats.emplace_back(getAttachmentFormat(Application::getGraphicsContext()->getSwapChain()->getImage(0)));
+			else
+			{
+				for (auto &texture : info.colorTargets)
+				{
+					if (texture != nullptr && texture->getType() == TextureType::Color)
+						colorFormats.emplace_back(getAttachmentFormat(texture));
+				}
+			}
+
+			if (info.depthTarget)
+				depthFormat = getAttachmentFormat(info.depthTarget);
+			if (info.depthArrayTarget)
+				depthFormat = getAttachmentFormat(info.depthArrayTarget);
+
+			std::stringstream stream;
+			stream << info.shader->getFilePath() << '\t'
+			       << int32_t(info.cullMode) << ' ' << int32_t(info.polygonMode) << ' ' << int32_t(info.drawType) << ' ' << int32_t(info.blendMode) << ' '
+			       << info.transparencyEnabled << ' ' << info.depthBiasEnabled << ' ' << info.depthTest << ' ' << info.stencilTest << ' ' << info.stencilMask << ' '
+			       << int32_t(info.stencilFunc) << ' ' << int32_t(info.stencilFail) << ' ' << int32_t(info.stencilDepthFail) << ' ' << int32_t(info.stencilDepthPass) << ' '
+			       << depthFormat << ' ' << colorFormats.size();
+			for (auto format : colorFormats)
+				stream << ' ' << format;
+			stream << ' ' << int32_t(info.vertexLayout);
+			return stream.str();
+		}
+
+		//the inverse of makeRecord, returns false for a malformed line
+		inline auto parseRecord(const std::string &line, std::string &shader, PipelineInfo &info, std::vector<VkFormat> &colorFormats, VkFormat &depthFormat) -> bool
+		{
+			std::stringstream stream(line);
+			if (!std::getline(stream, shader, '\t') || shader.empty())
+				return false;
+
+			int32_t cullMode, polygonMode, drawType, blendMode, stencilFunc, stencilFail, stencilDepthFail, stencilDepthPass, depth;
+			size_t  colorCount = 0;
+			stream >> cullMode >> polygonMode >> drawType >> blendMode >> info.transparencyEnabled >> info.depthBiasEnabled >> info.depthTest >> info.stencilTest >> info.stencilMask >> stencilFunc >> stencilFail >> stencilDepthFail >> stencilDepthPass >> depth >> colorCount;
+			if (!stream || colorCount > MAX_RENDER_TARGETS)
+				return false;
+
+			info.cullMode         = static_cast<CullMode>(cullMode);
+			info.polygonMode      = static_cast<PolygonMode>(polygonMode);
+			info.drawType         = static_cast<DrawType>(drawType);
+			info.blendMode        = static_cast<BlendMode>(blendMode);
+			info.stencilFunc      = static_cast<StencilType>(stencilFunc);
+			info.stencilFail      = static_cast<StencilType>(stencilFail);
+			info.stencilDepthFail = static_cast<StencilType>(stencilDepthFail);
+			info.stencilDepthPass = static_cast<StencilType>(stencilDepthPass);
+			depthFormat           = static_cast<VkFormat>(depth);
+
+			for (size_t i = 0; i < colorCount; i++)
+			{
+				int32_t format;
+				stream >> format;
+				colorFormats.emplace_back(static_cast<VkFormat>(format));
+			}
+			if (stream.fail())
+				return false;
+
+			//lines recorded before the vertex layouts were added end here
+			int32_t vertexLayout = 0;
+			if (stream >> vertexLayout)
+				info.vertexLayout = static_cast<VertexLayout>(vertexLayout);
+			return true;
+		}
+
+		//compatible with the render pass of VulkanRenderPass for the same formats, which is all a pipeline depends on
+		inline auto createCompatibleRenderPass(const std::vector<VkFormat> &colorFormats, VkFormat depthFormat) -> VkRenderPass
+		{
+			std::vector<VkAttachmentDescription> attachments;
+			std::vector<VkAttachmentReference>   colorReferences;
+			VkAttachmentReference                depthReference{};
+
+			auto addAttachment = [&](VkFormat format, VkImageLayout layout) {
+				auto &attachment          = attachments.emplace_back();
+				attachment.format         = format;
+				attachment.samples        = VK_SAMPLE_COUNT_1_BIT;
+				attachment.loadOp         = VK_ATTACHMENT_LOAD_OP_LOAD;
+				attachment.storeOp        = VK_ATTACHMENT_STORE_OP_STORE;
+				attachment.stencilLoadOp  = VK_ATTACHMENT_LOAD_OP_LOAD;
+				attachment.stencilStoreOp = VK_ATTACHMENT_STORE_OP_DONT_CARE;
+				attachment.initialLayout  = layout;
+				attachment.finalLayout    = layout;
+				return VkAttachmentReference{static_cast<uint32_t>(attachments.size() - 1), layout};
+			};
+
+			for (auto format : colorFormats)
+				colorReferences.emplace_back(addAttachment(format, VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL));
+
+			if (depthFormat != VK_FORMAT_UNDEFINED)
+				depthReference = addAttachment(depthFormat, VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL);
+
+			VkSubpassDescription subpass{};
+			subpass.pipelineBindPoint       = VK_PIPELINE_BIND_POINT_GRAPHICS;
+			subpass.colorAttachmentCount    = static_cast<uint32_t>(colorReferences.size());
+			subpass.pColorAttachments       = colorReferences.data();
+			subpass.pDepthStencilAttachment = depthFormat != VK_FORMAT_UNDEFINED ? &depthReference : nullptr;
+
+			VkRenderPassCreateInfo renderPassCreateInfo = VulkanHelper::renderPassCreateInfo();
+			renderPassCreateInfo.attachmentCount        = uint32_t(attachments.size());
+			renderPassCreateInfo.pAttachments           = attachments.data();
+			renderPassCreateInfo.subpassCount           = 1;
+			renderPassCreateInfo.pSubpasses             = &subpass;
+
+			VkRenderPass renderPass = VK_NULL_HANDLE;
+			VK_CHECK_RESULT(vkCreateRenderPass(*VulkanDevice::get(), &renderPassCreateInfo, VK_NULL_HANDLE, &renderPass));
+			return renderPass;
+		}
 	}        // namespace
 
-	VulkanPipeline::VulkanPipeline(const PipelineInfo &info)
+	VulkanPipeline::VulkanPipeline(const PipelineInfo &info, bool async)
 	{
-		init(info);
+		init(info, async);
 	}
 
 	VulkanPipeline::~VulkanPipeline()
 	{
 		PROFILE_FUNCTION();
+		waitReady();
 		auto &deletionQueue = VulkanContext::getDeletionQueue();
 		auto  pipeline      = this->pipeline;
 		deletionQueue.emplace([pipeline] { vkDestroyPipeline(*VulkanDevice::get(), pipeline, VK_NULL_HANDLE); });
 	}
 
-	auto VulkanPipeline::init(const PipelineInfo &info) -> bool
+	auto VulkanPipeline::init(const PipelineInfo &info, bool async) -> bool
 	{
 		PROFILE_FUNCTION();
 		shader         = info.shader;
@@ -239,35 +511,12 @@ namespace maple
 		description    = info;
 		pipelineLayout = vkShader->getPipelineLayout();
 
-
+		//the attachments are transitioned and the render pass is created on this thread, only the compilation is deferred
 		transitionAttachments();
 		createFrameBuffers();
-		// Pipeline
-		std::vector<VkDynamicState>      dynamicStateDescriptors;
-		VkPipelineDynamicStateCreateInfo dynamicStateCI{};
-		dynamicStateCI.sType          = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
-		dynamicStateCI.pNext          = NULL;
-		dynamicStateCI.pDynamicStates = dynamicStateDescriptors.data();
-
-		// Vertex layout
-		VkVertexInputBindingDescription      vertexBindingDescription{};
-		VkPipelineVertexInputStateCreateInfo vi{};
-		createVertexLayout(vertexBindingDescription, vi, vkShader);
-
-		VkPipelineInputAssemblyStateCreateInfo inputAssemblyCI{};
-		VkPipelineRasterizationStateCreateInfo rs{};
-		createRasterization(inputAssemblyCI, rs, info);
-
-		VkPipelineColorBlendStateCreateInfo              cb{};
-		std::vector<VkPipelineColorBlendAttachmentState> blendAttachState;
-		createColorBlend(cb, blendAttachState, info, std::static_pointer_cast<VulkanRenderPass>(renderPass));
-
-		VkPipelineViewportStateCreateInfo vp{};
-		createViewport(vp, dynamicStateDescriptors);
 
 		if (info.depthBiasEnabled)
 		{
-			dynamicStateDescriptors.emplace_back(VK_DYNAMIC_STATE_DEPTH_BIAS);
 			depthBiasConstant = 1.25f;
 			depthBiasSlope    = 1.75f;
 			depthBiasEnabled  = true;
@@ -277,41 +526,118 @@ namespace maple
 			depthBiasEnabled = false;
 		}
 
-		VkPipelineDepthStencilStateCreateInfo ds{};
-		createDepthStencil(ds, info);
-		VkPipelineMultisampleStateCreateInfo ms{};
-		createMultisample(ms);
-
-		dynamicStateCI.dynamicStateCount = uint32_t(dynamicStateDescriptors.size());
-		dynamicStateCI.pDynamicStates    = dynamicStateDescriptors.data();
-
-		VkGraphicsPipelineCreateInfo graphicsPipelineCreateInfo{};
-		graphicsPipelineCreateInfo.sType               = VK_STRUCTURE_TYPE_GRAPHICS_PIPELINE_CREATE_INFO;
-		graphicsPipelineCreateInfo.pNext               = NULL;
-		graphicsPipelineCreateInfo.layout              = pipelineLayout;
-		graphicsPipelineCreateInfo.basePipelineHandle  = VK_NULL_HANDLE;
-		graphicsPipelineCreateInfo.basePipelineIndex   = -1;
-		graphicsPipelineCreateInfo.pVertexInputState   = &vi;
-		graphicsPipelineCreateInfo.pInputAssemblyState = &inputAssemblyCI;
-		graphicsPipelineCreateInfo.pRasterizationState = &rs;
-		graphicsPipelineCreateInfo.pColorBlendState    = &cb;
-		graphicsPipelineCreateInfo.pTessellationState  = VK_NULL_HANDLE;
-		graphicsPipelineCreateInfo.pMultisampleState   = &ms;
-		graphicsPipelineCreateInfo.pDynamicState       = &dynamicStateCI;
-		graphicsPipelineCreateInfo.pViewportState      = &vp;
-		graphicsPipelineCreateInfo.pDepthStencilState  = &ds;
-		graphicsPipelineCreateInfo.pStages             = vkShader->getShaderStages().data();
-		graphicsPipelineCreateInfo.stageCount          = vkShader->getShaderStages().size();
-		graphicsPipelineCreateInfo.renderPass          = *std::static_pointer_cast<VulkanRenderPass>(renderPass);
-		graphicsPipelineCreateInfo.subpass             = 0;
-
-		VK_CHECK_RESULT(vkCreateGraphicsPipelines(*VulkanDevice::get(), VulkanDevice::get()->getPipelineCache(), 1, &graphicsPipelineCreateInfo, VK_NULL_HANDLE, &pipeline));
-
-		VulkanHelper::setObjectName(info.pipelineName, (uint64_t) pipeline, VK_OBJECT_TYPE_PIPELINE);
+		//shaders with variable sized arrays are created with their sizes, which are not recorded
+		if (vkShader->getArraySize().empty())
+		{
+			std::lock_guard<std::mutex> lock(recordMutex);
+			records.emplace(makeRecord(info));
+		}
 
+		auto jobSystem = Application::getJobSystem().get();
+		if (async && jobSystem->getWorkerCount() > 1)
+		{
+			compileCounter = std::make_shared<JobCounter>();
+			jobSystem->execute([this]() { compile(); }, compileCounter);
+		}
+		else
+		{
+			compile();
+		}
 		return true;
 	}
 
+	auto VulkanPipeline::compile() -> void
+	{
+		PROFILE_FUNCTION();
+		auto vulkanRenderPass = std::static_pointer_cast<VulkanRenderPass>(renderPass);
+		pipeline              = createGraphicsPipeline(description, static_cast<VulkanShader *>(shader.get()), *vulkanRenderPass, vulkanRenderPass->getColorAttachmentCount());
+		VulkanHelper::setObjectName(description.pipelineName, (uint64_t) pipeline, VK_OBJECT_TYPE_PIPELINE);
+	}
+
+	auto VulkanPipeline::isReady() const -> bool
+	{
+		return compileCounter == nullptr || compileCounter->isDone();
+	}
+
+	auto VulkanPipeline::waitReady(float budget) -> bool
+	{
+		if (isReady())
+			return true;
+
+		if (budget < 0)
+		{
+			Application::getJobSystem()->wait(compileCounter);
+			return true;
+		}
+		//the waiting thread helps with the compile jobs, this one may not have been started yet
+		return Application::getJobSystem()->wait(compileCounter, budget);
+	}
+
+	auto VulkanPipeline::prewarm() -> void
+	{
+		std::ifstream stream(PipelineRecordFile);
+		if (!stream)
+			return;
+
+		auto jobSystem = Application::getJobSystem().get();
+		prewarmCounter = std::make_shared<JobCounter>();
+
+		uint32_t    count = 0;
+		std::string line;
+		while (std::getline(stream, line))
+		{
+			std::string           path;
+			PipelineInfo          info;
+			std::vector<VkFormat> colorFormats;
+			VkFormat              depthFormat = VK_FORMAT_UNDEFINED;
+			if (!parseRecord(line, path, info, colorFormats, depthFormat))
+				continue;
+
+			//the shaders are loaded in the jobs as well, they are shared with the renderer through the assets registry.
+			//the pipelines only fill the driver cache, the real ones are created against the same cache later
+			jobSystem->execute([line, path, info, colorFormats, depthFormat]() mutable {
+				if (!File::fileExists(path))
+					return;
+
+				info.shader = Shader::create(path);
+				if (info.shader == nullptr || info.shader->isComputeShader() || info.shader->isRaytracingShader())
+					return;
+
+				{
+					std::lock_guard<std::mutex> lock(recordMutex);
+					records.emplace(line);
+				}
+
+				auto renderPass = createCompatibleRenderPass(colorFormats, depthFormat);
+				auto pipeline   = createGraphicsPipeline(info, static_cast<VulkanShader *>(info.shader.get()), renderPass, static_cast<uint32_t>(colorFormats.size()));
+				vkDestroyPipeline(*VulkanDevice::get(), pipeline, VK_NULL_HANDLE);
+				vkDestroyRenderPass(*VulkanDevice::get(), renderPass, VK_NULL_HANDLE);
+			},
+			                   prewarmCounter);
+			count++;
+		}
+
+		LOGI("Prewarming {0} pipelines recorded in {1}", count, PipelineRecordFile);
+	}
+
+	auto VulkanPipeline::saveRecords() -> void
+	{
+		//the prewarm jobs still write into the driver cache
+		if (prewarmCounter != nullptr)
+			Application::getJobSystem()->wait(prewarmCounter);
+
+		std::lock_guard<std::mutex> lock(recordMutex);
+		if (records.empty())
+			return;
+
+		std::error_code error;
+		std::filesystem::create_directories(std::filesystem::path(PipelineRecordFile).parent_path(), error);
+
+		std::ofstream stream(PipelineRecordFile, std::ios::trunc);
+		for (auto &record : records)
+			stream << record << '\n';
+	}
+
 	auto VulkanPipeline::getWidth() -> uint32_t
 	{
 		if (description.swapChainTarget)
@@ -355,33 +681,44 @@ namespace maple
 	auto VulkanPipeline::bind(const CommandBuffer *cmdBuffer, uint32_t layer, int32_t cubeFace, int32_t mipMapLevel) -> FrameBuffer *
 	{
 		PROFILE_FUNCTION();
-		FrameBuffer *framebuffer = nullptr;
 		transitionAttachments();
 
 		if (depthBiasEnabled)
 			vkCmdSetDepthBias(static_cast<const VulkanCommandBuffer *>(cmdBuffer)->getCommandBuffer(), depthBiasConstant, 0.0f, depthBiasSlope);
 
-		if (description.swapChainTarget)
-		{
-			framebuffer = framebuffers[VulkanContext::get()->getSwapChain()->getCurrentImageIndex()].get();
-		}
-		else if (description.depthArrayTarget)
-		{
-			framebuffer = framebuffers[layer].get();
-		}
-		else
-		{
-			framebuffer = framebuffers[0].get();
-		}
-
-		auto mipScale = std::pow(0.5, mipMapLevel);
+		auto framebuffer = getFrameBuffer(layer);
+		auto mipScale    = std::pow(0.5, mipMapLevel);
 
 		renderPass->beginRenderPass(cmdBuffer, description.clearColor, framebuffer, SubPassContents::Inline, getWidth() * mipScale, getHeight() * mipScale, cubeFace, mipMapLevel);
 
+		waitReady();
 		vkCmdBindPipeline(static_cast<const VulkanCommandBuffer *>(cmdBuffer)->getCommandBuffer(), VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
 		return framebuffer;
 	}
 
+	auto VulkanPipeline::bindSecondary(const CommandBuffer *cmdBuffer, uint32_t layer) -> FrameBuffer *
+	{
+		PROFILE_FUNCTION();
+		transitionAttachments();
+		auto framebuffer = getFrameBuffer(layer);
+		renderPass->beginRenderPass(cmdBuffer, description.clearColor, framebuffer, SubPassContents::Secondary, getWidth(), getHeight());
+		return framebuffer;
+	}
+
+	auto VulkanPipeline::beginSecondary(CommandBuffer *secondary, FrameBuffer *framebuffer) -> void
+	{
+		PROFILE_FUNCTION();
+		secondary->beginRecordingSecondary(renderPass.get(), framebuffer);
+		//dynamic states are not inherited from the primary command buffer
+		secondary->updateViewport(getWidth(), getHeight());
+
+		if (depthBiasEnabled)
+			vkCmdSetDepthBias(static_cast<const VulkanCommandBuffer *>(secondary)->getCommandBuffer(), depthBiasConstant, 0.0f, depthBiasSlope);
+
+		waitReady();
+		vkCmdBindPipeline(static_cast<const VulkanCommandBuffer *>(secondary)->getCommandBuffer(), VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+	}
+
 	auto VulkanPipeline::end(const CommandBuffer *commandBuffer) -> void
 	{
 		PROFILE_FUNCTION();
@@ -417,6 +754,17 @@ namespace maple
 			}
 		}
 	}
+	auto VulkanPipeline::getFrameBuffer(uint32_t layer) -> FrameBuffer *
+	{
+		if (description.swapChainTarget)
+			return framebuffers[VulkanContext::get()->getSwapChain()->getCurrentImageIndex()].get();
+
+		if (description.depthArrayTarget)
+			return framebuffers[layer].get();
+
+		return framebuffers[0].get();
+	}
+
 	auto VulkanPipeline::transitionAttachments() -> void
 	{
 		PROFILE_FUNCTION();
@@ -427,6 +775,8 @@ namespace maple
 			commandBuffer = nullptr;
 		}*/
 
+		VulkanHelper::BarrierBatch batch(commandBuffer);
+
 		if (description.swapChainTarget)
 		{
 			for (uint32_t i = 0; i < Application::getGraphicsContext()->getSwapChain()->getSwapChainBufferCount(); i++)
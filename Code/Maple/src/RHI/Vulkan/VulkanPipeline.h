@@ -11,16 +11,26 @@
 
 namespace maple
 {
+	class JobCounter;
+
 	class VulkanPipeline : public Pipeline
 	{
 	  public:
 		constexpr static uint32_t MAX_DESCRIPTOR_SET = 1500;
 		VulkanPipeline()                             = default;
-		VulkanPipeline(const PipelineInfo &info);
+		VulkanPipeline(const PipelineInfo &info, bool async = false);
 		virtual ~VulkanPipeline();
 		NO_COPYABLE(VulkanPipeline);
 
-		auto init(const PipelineInfo &info) -> bool;
+		//with async the pipeline is compiled on the job system, bind() waits for it
+		auto init(const PipelineInfo &info, bool async = false) -> bool;
+
+		auto isReady() const -> bool override;
+		auto waitReady(float budget = -1.f) -> bool override;
+
+		//compiles the pipelines recorded by saveRecords into the driver pipeline cache on the job system
+		static auto prewarm() -> void;
+		static auto saveRecords() -> void;
 
 		auto getWidth() -> uint32_t override;
 		auto getHeight() -> uint32_t override;
@@ -28,6 +38,8 @@ namespace maple
 		auto bind(const CommandBuffer *commandBuffer, uint32_t layer = 0, int32_t cubeFace = -1, int32_t mipMapLevel = 0) -> FrameBuffer * override;
 		auto end(const CommandBuffer *commandBuffer) -> void override;
 		auto clearRenderTargets(const CommandBuffer *commandBuffer) -> void override;
+		auto bindSecondary(const CommandBuffer *commandBuffer, uint32_t layer = 0) -> FrameBuffer * override;
+		auto beginSecondary(CommandBuffer *secondary, FrameBuffer *framebuffer) -> void override;
 
 		inline auto getShader() const -> std::shared_ptr<Shader> override
 		{
@@ -47,11 +59,14 @@ namespace maple
 	  protected:
 		std::shared_ptr<Shader> shader;
 		VkPipelineLayout        pipelineLayout;
-		VkPipeline              pipeline;
+		VkPipeline              pipeline = VK_NULL_HANDLE;
 
 	  private:
 		auto                                      transitionAttachments() -> void;
+		auto                                      getFrameBuffer(uint32_t layer) -> FrameBuffer *;
 		auto                                      createFrameBuffers() -> void;
+		auto                                      compile() -> void;
+		std::shared_ptr<JobCounter>               compileCounter;
 		std::shared_ptr<RenderPass>               renderPass;
 		std::vector<std::shared_ptr<FrameBuffer>> framebuffers;
 		bool                                      computePipline = false;
@@ -6,6 +6,7 @@
 #include "VulkanContext.h"
 #include "VulkanDevice.h"
 #include "VulkanPipeline.h"
+#include "VulkanStorageBuffer.h"
 #include "VulkanSwapChain.h"
 #include "VulkanTexture.h"
 
@@ -25,6 +26,28 @@ namespace maple
 {
 	static constexpr uint32_t MAX_DESCRIPTOR_SET_COUNT = 1500;
 
+	namespace
+	{
+		inline auto toImageLayout(ResourceState state, bool depth)
+		{
+			switch (state)
+			{
+				case ResourceState::ShaderRead:
+					return depth ? VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL : VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+				case ResourceState::Storage:
+					return VK_IMAGE_LAYOUT_GENERAL;
+				case ResourceState::ColorAttachment:
+					return VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+				case ResourceState::DepthAttachment:
+					return VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+				case ResourceState::DepthRead:
+					return VK_IMAGE_LAYOUT_DEPTH_STENCIL_READ_ONLY_OPTIMAL;
+				default:
+					return VK_IMAGE_LAYOUT_UNDEFINED;
+			}
+		}
+	}        // namespace
+
 	VulkanRenderDevice::VulkanRenderDevice()
 	{
 	}
@@ -43,7 +66,7 @@ namespace maple
 		                                             {DescriptorType::Buffer, 500},
 		                                             {DescriptorType::BufferDynamic, 500},
 		                                             {DescriptorType::UniformBuffer, 500},
-		                                             {DescriptorType::UniformBufferDynamic, 500}};
+		                                             {DescriptorType::UniformBufferDynamic, 1000}};
 		
 		if (VulkanDevice::get()->getPhysicalDevice()->isRaytracingSupport())
 		{
@@ -107,19 +130,35 @@ namespace maple
 		vkCmdDrawIndexed(static_cast<const VulkanCommandBuffer *>(commandBuffer)->getCommandBuffer(), count, 1, start, 0, 0);
 	}
 
+	auto VulkanRenderDevice::drawIndexedInstancedInternal(const CommandBuffer *commandBuffer, const DrawType type, uint32_t count, uint32_t instanceCount, uint32_t start) const -> void
+	{
+		PROFILE_FUNCTION();
+		vkCmdDrawIndexed(static_cast<const VulkanCommandBuffer *>(commandBuffer)->getCommandBuffer(), count, instanceCount, start, 0, 0);
+	}
+
+	auto VulkanRenderDevice::drawIndexedIndirectInternal(const CommandBuffer *commandBuffer, StorageBuffer *args, uint32_t offset, uint32_t drawCount, uint32_t stride) const -> void
+	{
+		PROFILE_FUNCTION();
+		vkCmdDrawIndexedIndirect(static_cast<const VulkanCommandBuffer *>(commandBuffer)->getCommandBuffer(), static_cast<VulkanStorageBuffer *>(args)->getHandle(), offset, drawCount, stride);
+	}
+
 	auto VulkanRenderDevice::bindDescriptorSetsInternal(Pipeline *pipeline, const CommandBuffer *commandBuffer, uint32_t dynamicOffset, const std::vector<std::shared_ptr<DescriptorSet>> &descriptorSets) -> void
 	{
 		PROFILE_FUNCTION();
-		uint32_t numDynamicDescriptorSets = 0;
-		uint32_t numDesciptorSets         = 0;
+		//dynamicOffset is unused here, every uniform block carries its own offset into the frame allocator
+		uint32_t        numDynamicOffsets     = 0;
+		uint32_t        numDesciptorSets      = 0;
+		VkDescriptorSet descriptorSetPool[16] = {};        //local, draws are recorded on several threads
+		uint32_t        dynamicOffsets[32]    = {};
 
 		for (auto &descriptorSet : descriptorSets)
 		{
 			if (descriptorSet)
 			{
 				auto vkDesSet = std::static_pointer_cast<VulkanDescriptorSet>(descriptorSet);
-				if (vkDesSet->isDynamic())
-					numDynamicDescriptorSets++;
+				//may refresh the frame of the set, so it comes before getDescriptorSet
+				numDynamicOffsets += vkDesSet->getDynamicOffsets(dynamicOffsets + numDynamicOffsets);
+				MAPLE_ASSERT(numDynamicOffsets <= 32, "Too many uniform blocks bound at once");
 
 				descriptorSetPool[numDesciptorSets] = vkDesSet->getDescriptorSet();
 				numDesciptorSets++;
@@ -129,7 +168,7 @@ namespace maple
 		vkCmdBindDescriptorSets(
 		    static_cast<const VulkanCommandBuffer *>(commandBuffer)->getCommandBuffer(),
 		    static_cast<const VulkanPipeline *>(pipeline)->getPipelineBindPoint(),
-		    static_cast<const VulkanPipeline *>(pipeline)->getPipelineLayout(), 0, numDesciptorSets, descriptorSetPool, numDynamicDescriptorSets, &dynamicOffset);
+		    static_cast<const VulkanPipeline *>(pipeline)->getPipelineLayout(), 0, numDesciptorSets, descriptorSetPool, numDynamicOffsets, dynamicOffsets);
 	}
 
 	auto VulkanRenderDevice::clearRenderTarget(const std::shared_ptr<Texture> &texture, const CommandBuffer *commandBuffer, const glm::vec4 &clearColor) -> void
@@ -163,6 +202,28 @@ namespace maple
 		}
 	}
 
+	auto VulkanRenderDevice::transitionTextures(const CommandBuffer *commandBuffer, const std::vector<TextureTransition> &transitions) -> void
+	{
+		PROFILE_FUNCTION();
+		const auto vkCmd = static_cast<const VulkanCommandBuffer *>(commandBuffer);
+
+		VulkanHelper::BarrierBatch batch(vkCmd);
+		for (auto &transition : transitions)
+		{
+			if (transition.texture == nullptr || transition.state == ResourceState::Undefined)
+				continue;
+
+			if (transition.texture->getType() == TextureType::Color)
+			{
+				((VulkanTexture2D *) transition.texture)->transitionImage(toImageLayout(transition.state, false), vkCmd);
+			}
+			else if (transition.texture->getType() == TextureType::Depth)
+			{
+				((VulkanTextureDepth *) transition.texture)->transitionImage(toImageLayout(transition.state, true), vkCmd);
+			}
+		}
+	}
+
 	auto VulkanRenderDevice::dispatch(const CommandBuffer *commandBuffer, uint32_t x, uint32_t y, uint32_t z) -> void
 	{
 		PROFILE_FUNCTION();
@@ -172,6 +233,29 @@ namespace maple
 	auto VulkanRenderDevice::memoryBarrier(const CommandBuffer *commandBuffer, uint32_t flag) -> void
 	{
 		PROFILE_FUNCTION();
+		//images are synchronized by their layout transitions, only buffer writes need a barrier here
+		if ((flag & (MemoryBarrierFlags::Shader_Storage_Barrier | MemoryBarrierFlags::Indirect_Command_Barrier)) == 0)
+			return;
+
+		VkMemoryBarrier memoryBarrier{};
+		memoryBarrier.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER;
+		memoryBarrier.srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT;
+		memoryBarrier.dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
+
+		VkPipelineStageFlags dstStage = VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
+
+		if (flag & MemoryBarrierFlags::Indirect_Command_Barrier)
+		{
+			memoryBarrier.dstAccessMask |= VK_ACCESS_INDIRECT_COMMAND_READ_BIT | VK_ACCESS_HOST_READ_BIT;
+			dstStage |= VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_HOST_BIT;
+		}
+
+		//a compute queue has no graphics stages
+		if (static_cast<const VulkanCommandBuffer *>(commandBuffer)->getCommandBuffeType() == CommandBufferType::Compute)
+			dstStage &= ~(VK_PIPELINE_STAGE_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT);
+
+		vkCmdPipelineBarrier(static_cast<const VulkanCommandBuffer *>(commandBuffer)->getCommandBuffer(),
+		                     VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT, dstStage, 0, 1, &memoryBarrier, 0, nullptr, 0, nullptr);
 	}
 
 }        // namespace maple
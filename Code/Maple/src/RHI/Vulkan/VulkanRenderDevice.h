@@ -27,11 +27,14 @@ namespace maple
 		auto presentInternal() -> void override;
 		auto presentInternal(const CommandBuffer *commandBuffer) -> void override;
 		auto drawIndexedInternal(const CommandBuffer *commandBuffer, DrawType type, uint32_t count, uint32_t start) const -> void override;
+		auto drawIndexedInstancedInternal(const CommandBuffer *commandBuffer, DrawType type, uint32_t count, uint32_t instanceCount, uint32_t start) const -> void override;
+		auto drawIndexedIndirectInternal(const CommandBuffer *commandBuffer, StorageBuffer *args, uint32_t offset, uint32_t drawCount, uint32_t stride) const -> void override;
 		auto drawInternal(const CommandBuffer *commandBuffer, DrawType type, uint32_t count, DataType datayType, const void *indices) const -> void override;
 		auto drawArraysInternal(const CommandBuffer *commandBuffer, DrawType type, uint32_t count, uint32_t start = 0) const -> void override;
 
 		auto bindDescriptorSetsInternal(Pipeline *pipeline, const CommandBuffer *commandBuffer, uint32_t dynamicOffset, const std::vector<std::shared_ptr<DescriptorSet>> &sets) -> void override;
 		auto clearRenderTarget(const std::shared_ptr<Texture> &texture, const CommandBuffer *commandBuffer, const glm::vec4 &clearColor) -> void override;
+		auto transitionTextures(const CommandBuffer *commandBuffer, const std::vector<TextureTransition> &transitions) -> void override;
 		auto dispatch(const CommandBuffer *commandBuffer, uint32_t x, uint32_t y, uint32_t z) -> void override;
 
 		inline auto getDescriptorPool() const
@@ -46,7 +49,6 @@ namespace maple
 
 		uint32_t         currentSemaphoreIndex = 0;
 		//VkDescriptorPool descriptorPool;
-		VkDescriptorSet  descriptorSetPool[16] = {};
 
 		DescriptorPool::Ptr descriptorPool;
 	};
@@ -220,7 +220,10 @@ namespace maple
 		MAPLE_ASSERT(vkCmd->isRecording(), "must recording");
 
 		vkCmdBeginRenderPass(vkCmd->getCommandBuffer(), &info, subPassContentsToVK(contents));
-		commandBuffer->updateViewport(width, height);
+
+		//secondary command buffers set their own viewport
+		if (contents == SubPassContents::Inline)
+			commandBuffer->updateViewport(width, height);
 	}
 
 	auto VulkanRenderPass::endRenderPass(const CommandBuffer *commandBuffer) -> void
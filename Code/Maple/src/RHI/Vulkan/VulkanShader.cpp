@@ -2,6 +2,7 @@
 // This file is part of the Maple Engine                              		//
 //////////////////////////////////////////////////////////////////////////////
 #include "VulkanShader.h"
+#include "Application.h"
 #include "FileSystem/File.h"
 #include "Others/Console.h"
 #include "Others/StringUtils.h"
@@ -9,7 +10,14 @@
 #include "VulkanCommandBuffer.h"
 #include "VulkanDevice.h"
 #include "VulkanPipeline.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
 #include <spirv_cross.hpp>
+#include <type_traits>
 
 namespace maple
 {
@@ -224,6 +232,118 @@ namespace maple
 			}
 		}
 
+		//bump when the reflected data or its layout changes, old files are ignored
+		constexpr uint32_t ReflectionCacheVersion = 1;
+		constexpr uint32_t ReflectionCacheMagic   = 0x5246524d;        //MRFR
+		constexpr char     ReflectionCacheFolder[] = "cache/shaders/";
+
+		std::atomic<uint32_t> reflectionHits   = 0;
+		std::atomic<uint32_t> reflectionMisses = 0;
+
+		inline auto hashBytes(uint64_t hash, const void *data, size_t size) -> uint64_t
+		{
+			//FNV-1a
+			auto bytes = static_cast<const uint8_t *>(data);
+			for (size_t i = 0; i < size; i++)
+			{
+				hash ^= bytes[i];
+				hash *= 1099511628211ull;
+			}
+			return hash;
+		}
+
+		class BinaryWriter
+		{
+		  public:
+			template <typename T>
+			inline auto write(const T &value) -> void
+			{
+				static_assert(std::is_trivially_copyable_v<T>);
+				auto bytes = reinterpret_cast<const uint8_t *>(&value);
+				buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+			}
+
+			inline auto write(const std::string &value) -> void
+			{
+				write(static_cast<uint32_t>(value.size()));
+				buffer.insert(buffer.end(), value.begin(), value.end());
+			}
+
+			inline auto &getBuffer() const
+			{
+				return buffer;
+			}
+
+		  private:
+			std::vector<uint8_t> buffer;
+		};
+
+		//every read fails once the end of the data is passed, so a truncated file is rejected as a whole
+		class BinaryReader
+		{
+		  public:
+			BinaryReader(const std::vector<uint8_t> &buffer) :
+			    buffer(buffer)
+			{}
+
+			template <typename T>
+			inline auto read(T &value) -> bool
+			{
+				static_assert(std::is_trivially_copyable_v<T>);
+				if (!valid || pos + sizeof(T) > buffer.size())
+					return valid = false;
+				memcpy(&value, buffer.data() + pos, sizeof(T));
+				pos += sizeof(T);
+				return true;
+			}
+
+			inline auto read(std::string &value) -> bool
+			{
+				uint32_t size = 0;
+				if (!read(size) || pos + size > buffer.size())
+					return valid = false;
+				value.assign(reinterpret_cast<const char *>(buffer.data() + pos), size);
+				pos += size;
+				return true;
+			}
+
+			inline auto isValid() const
+			{
+				return valid && pos == buffer.size();
+			}
+
+		  private:
+			const std::vector<uint8_t> &buffer;
+			size_t                      pos   = 0;
+			bool                        valid = true;
+		};
+
+		inline auto writeMembers(BinaryWriter &writer, const std::vector<BufferMemberInfo> &members)
+		{
+			writer.write(static_cast<uint32_t>(members.size()));
+			for (auto &member : members)
+			{
+				writer.write(member.size);
+				writer.write(member.offset);
+				writer.write(member.type);
+				writer.write(member.name);
+				writer.write(member.fullName);
+			}
+		}
+
+		inline auto readMembers(BinaryReader &reader, std::vector<BufferMemberInfo> &members)
+		{
+			uint32_t count = 0;
+			reader.read(count);
+			for (uint32_t i = 0; i < count && reader.read(members.emplace_back().size); i++)
+			{
+				auto &member = members.back();
+				reader.read(member.offset);
+				reader.read(member.type);
+				reader.read(member.name);
+				reader.read(member.fullName);
+			}
+		}
 	}        // namespace
 
 	VulkanShader::VulkanShader(const std::string &path, const VariableArraySize &size) :
@@ -249,9 +369,14 @@ namespace maple
 	}
 
 	auto VulkanShader::bindPushConstants(const CommandBuffer *cmdBuffer, Pipeline *pipeline) -> void
+	{
+		bindPushConstants(cmdBuffer, pipeline, pushConstants);
+	}
+
+	auto VulkanShader::bindPushConstants(const CommandBuffer *cmdBuffer, Pipeline *pipeline, const std::vector<PushConstant> &constants) -> void
 	{
 		uint32_t index = 0;
-		for (auto &pc : pushConstants)
+		for (auto &pc : constants)
 		{
 			uint32_t bits = 0;
 
@@ -297,8 +422,37 @@ namespace maple
 
 		LOGI("Loading Shader : {0}", name);
 
+		const auto begin = Application::getTimer().current();
+
+		//the reflection only depends on the SPIR-V of the stages and on the variable array sizes
+		std::vector<std::vector<uint32_t>> spirv;
+		uint64_t                           key = hashBytes(14695981039346656037ull, &ReflectionCacheVersion, sizeof(uint32_t));
 		for (auto &source : sources)
 		{
+			auto &code = spirv.emplace_back();
+			if (source.second != "null")
+			{
+				auto buffer = File::read(source.second);
+				auto size   = buffer->size() / sizeof(uint32_t);
+				code.assign(reinterpret_cast<uint32_t *>(buffer->data()), reinterpret_cast<uint32_t *>(buffer->data()) + size);
+			}
+			key = hashBytes(key, &source.first, sizeof(ShaderType));
+			key = hashBytes(key, code.data(), code.size() * sizeof(uint32_t));
+		}
+
+		std::vector<std::pair<std::string, size_t>> arraySizes(arraySize.begin(), arraySize.end());
+		std::sort(arraySizes.begin(), arraySizes.end());
+		for (auto &[variable, count] : arraySizes)
+		{
+			key = hashBytes(key, variable.data(), variable.size());
+			key = hashBytes(key, &count, sizeof(size_t));
+		}
+
+		const bool cached = loadReflection(key);
+
+		for (auto &source : sources)
+		{
+			auto &code = spirv[currentShaderStage];
 			if (source.second == "null")
 			{
 				shaderStages[currentShaderStage]        = {};
@@ -310,16 +464,173 @@ namespace maple
 			}
 			else
 			{
-				auto buffer = File::read(source.second);
-				auto size   = buffer->size() / sizeof(uint32_t);
-				loadShader({reinterpret_cast<uint32_t *>(buffer->data()), reinterpret_cast<uint32_t *>(buffer->data()) + size}, source.first, currentShaderStage);
+				if (!cached)
+					reflectShader(code, source.first);
+				loadShader(code, source.first, currentShaderStage);
 			}
 			auto out = StringUtils::split(source.second, ".");
 			shaderGroups.emplace(out[0], shaderStages[currentShaderStage]);
 			currentShaderStage++;
 		}
 
+		if (!cached)
+			saveReflection(key);
+
 		createPipelineLayout();
+
+		cached ? reflectionHits++ : reflectionMisses++;
+		LOGI("Shader {0} loaded in {1} ms, reflection {2}. Reflection cache : {3} hits, {4} misses",
+		     name, Application::getTimer().elapsed(begin, Application::getTimer().current()) / 1000.f, cached ? "cached" : "rebuilt", reflectionHits.load(), reflectionMisses.load());
+	}
+
+	auto VulkanShader::loadReflection(uint64_t key) -> bool
+	{
+		const auto file   = fmt::format("{0}{1:016x}.reflection", ReflectionCacheFolder, key);
+		auto       buffer = File::read(file);
+		if (buffer == nullptr)
+			return false;
+
+		BinaryReader reader(*buffer);
+
+		uint32_t magic   = 0;
+		uint32_t version = 0;
+		uint64_t fileKey = 0;
+		if (!reader.read(magic) || !reader.read(version) || !reader.read(fileKey) ||
+		    magic != ReflectionCacheMagic || version != ReflectionCacheVersion || fileKey != key)
+			return false;
+
+		uint32_t count = 0;
+
+		reader.read(computeShader);
+		reader.read(localSizeX);
+		reader.read(localSizeY);
+		reader.read(localSizeZ);
+		reader.read(vertexInputStride);
+
+		reader.read(count);
+		for (uint32_t i = 0; i < count; i++)
+			reader.read(vertexInputAttributeDescriptions.emplace_back());
+
+		reader.read(count);
+		for (uint32_t i = 0; i < count; i++)
+			reader.read(descriptorLayoutInfo.emplace_back());
+
+		reader.read(count);
+		for (uint32_t i = 0; i < count; i++)
+		{
+			uint32_t set         = 0;
+			uint32_t descriptors = 0;
+			reader.read(set);
+			reader.read(descriptors);
+			auto &descriptorInfo = descriptorInfos[set];
+			for (uint32_t j = 0; j < descriptors && reader.read(descriptorInfo.emplace_back().offset); j++)
+			{
+				auto &descriptor = descriptorInfo.back();
+				reader.read(descriptor.size);
+				reader.read(descriptor.binding);
+				reader.read(descriptor.name);
+				reader.read(descriptor.type);
+				reader.read(descriptor.shaderType);
+				reader.read(descriptor.format);
+				reader.read(descriptor.accessFlag);
+				readMembers(reader, descriptor.members);
+			}
+		}
+
+		reader.read(count);
+		for (uint32_t i = 0; i < count && reader.read(pushConstants.emplace_back().size); i++)
+		{
+			auto    &push   = pushConstants.back();
+			uint32_t stages = 0;
+			reader.read(stages);
+			for (uint32_t j = 0; j < stages; j++)
+			{
+				ShaderType stage = ShaderType::Unknown;
+				reader.read(stage);
+				push.shaderStages.emplace(stage);
+			}
+			reader.read(push.offset);
+			reader.read(push.name);
+			readMembers(reader, push.members);
+			push.data.resize(push.size);
+		}
+
+		if (!reader.isValid())
+		{
+			LOGW("Reflection cache {0} of {1} is corrupted, reflecting again", file, name);
+			computeShader     = false;
+			localSizeX        = 1;
+			localSizeY        = 1;
+			localSizeZ        = 1;
+			vertexInputStride = 0;
+			vertexInputAttributeDescriptions.clear();
+			descriptorLayoutInfo.clear();
+			descriptorInfos.clear();
+			pushConstants.clear();
+			return false;
+		}
+		return true;
+	}
+
+	auto VulkanShader::saveReflection(uint64_t key) const -> void
+	{
+		BinaryWriter writer;
+		writer.write(ReflectionCacheMagic);
+		writer.write(ReflectionCacheVersion);
+		writer.write(key);
+
+		writer.write(computeShader);
+		writer.write(localSizeX);
+		writer.write(localSizeY);
+		writer.write(localSizeZ);
+		writer.write(vertexInputStride);
+
+		writer.write(static_cast<uint32_t>(vertexInputAttributeDescriptions.size()));
+		for (auto &description : vertexInputAttributeDescriptions)
+			writer.write(description);
+
+		writer.write(static_cast<uint32_t>(descriptorLayoutInfo.size()));
+		for (auto &layout : descriptorLayoutInfo)
+			writer.write(layout);
+
+		writer.write(static_cast<uint32_t>(descriptorInfos.size()));
+		for (auto &[set, descriptors] : descriptorInfos)
+		{
+			writer.write(set);
+			writer.write(static_cast<uint32_t>(descriptors.size()));
+			for (auto &descriptor : descriptors)
+			{
+				writer.write(descriptor.offset);
+				writer.write(descriptor.size);
+				writer.write(descriptor.binding);
+				writer.write(descriptor.name);
+				writer.write(descriptor.type);
+				writer.write(descriptor.shaderType);
+				writer.write(descriptor.format);
+				writer.write(descriptor.accessFlag);
+				writeMembers(writer, descriptor.members);
+			}
+		}
+
+		writer.write(static_cast<uint32_t>(pushConstants.size()));
+		for (auto &push : pushConstants)
+		{
+			writer.write(push.size);
+			writer.write(static_cast<uint32_t>(push.shaderStages.size()));
+			for (auto stage : push.shaderStages)
+				writer.write(stage);
+			writer.write(push.offset);
+			writer.write(push.name);
+			writeMembers(writer, push.members);
+		}
+
+		std::error_code error;
+		std::filesystem::create_directories(ReflectionCacheFolder, error);
+
+		const auto    file = fmt::format("{0}{1:016x}.reflection", ReflectionCacheFolder, key);
+		std::ofstream stream(file, std::ios::binary | std::ios::trunc);
+		if (!stream.write(reinterpret_cast<const char *>(writer.getBuffer().data()), writer.getBuffer().size()))
+			LOGW("Failed to write the reflection cache {0}", file);
 	}
 
 	auto VulkanShader::createPipelineLayout() -> void
@@ -374,8 +685,11 @@ namespace maple
 			{
 				auto &info = l[i];
 
+				//uniform blocks live in the frame allocator and are bound with dynamic offsets
+				const auto type = info.type == DescriptorType::UniformBuffer ? DescriptorType::UniformBufferDynamic : info.type;
+
 				VkDescriptorSetLayoutBinding setLayoutBinding{};
-				setLayoutBinding.descriptorType = VkConverter::descriptorTypeToVK(info.type);
+				setLayoutBinding.descriptorType = VkConverter::descriptorTypeToVK(type);
 				setLayoutBinding.stageFlags     = VkConverter::shaderTypeToVK(info.stage);
 
 				if (raytracingShader)
@@ -467,6 +781,16 @@ namespace maple
 		shaderCreateInfo.pCode    = spvCode.data();
 		shaderCreateInfo.pNext    = VK_NULL_HANDLE;
 
+		shaderStages[currentShaderStage].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
+		shaderStages[currentShaderStage].stage = VkConverter::shaderTypeToVK(shaderType);
+		shaderStages[currentShaderStage].pName = "main";
+		shaderStages[currentShaderStage].pNext = VK_NULL_HANDLE;
+
+		VK_CHECK_RESULT(vkCreateShaderModule(*VulkanDevice::get(), &shaderCreateInfo, nullptr, &shaderStages[currentShaderStage].module));
+	}
+
+	auto VulkanShader::reflectShader(const std::vector<uint32_t> &spvCode, ShaderType shaderType) -> void
+	{
 		spirv_cross::Compiler        comp(spvCode.data(), spvCode.size());
 		spirv_cross::ShaderResources resources = comp.get_shader_resources();
 
@@ -750,13 +1074,6 @@ namespace maple
 				descriptor.size       = VK_WHOLE_SIZE;
 			}
 		}
-
-		shaderStages[currentShaderStage].sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
-		shaderStages[currentShaderStage].stage = VkConverter::shaderTypeToVK(shaderType);
-		shaderStages[currentShaderStage].pName = "main";
-		shaderStages[currentShaderStage].pNext = VK_NULL_HANDLE;
-
-		VK_CHECK_RESULT(vkCreateShaderModule(*VulkanDevice::get(), &shaderCreateInfo, nullptr, &shaderStages[currentShaderStage].module));
 	}
 
 };        // namespace maple
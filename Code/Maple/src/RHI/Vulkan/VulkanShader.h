@@ -25,6 +25,7 @@ namespace maple
 		~VulkanShader();
 		NO_COPYABLE(VulkanShader);
 		auto bindPushConstants(const CommandBuffer *commandBuffer, Pipeline *pipeline) -> void override;
+		auto bindPushConstants(const CommandBuffer *commandBuffer, Pipeline *pipeline, const std::vector<PushConstant> &constants) -> void override;
 
 		auto bind() const -> void override{};
 		auto unbind() const -> void override{};
@@ -104,9 +105,19 @@ namespace maple
 		{
 			return shaderGroups;
 		}
+
+		inline auto &getArraySize() const
+		{
+			return arraySize;
+		}
 		
 	  private:
 		auto loadShader(const std::vector<uint32_t> &spvCode, ShaderType type, int32_t currentShaderStage) -> void;
+		auto reflectShader(const std::vector<uint32_t> &spvCode, ShaderType type) -> void;
+
+		//reflected layouts, push constants and vertex inputs stored under cache/shaders, keyed by the hash of the SPIR-V
+		auto loadReflection(uint64_t key) -> bool;
+		auto saveReflection(uint64_t key) const -> void;
 		auto init() -> void;
 		auto createPipelineLayout() -> void;
 		auto unload() const -> void;
@@ -78,4 +78,14 @@ namespace maple
 		return vulkanBuffer->getDeviceAddress();
 	}
 
+	auto VulkanStorageBuffer::invalidate() -> void
+	{
+		vulkanBuffer->invalidate();
+	}
+
+	auto VulkanStorageBuffer::flush() -> void
+	{
+		vulkanBuffer->flush();
+	}
+
 }        // namespace maple
\ No newline at end of file
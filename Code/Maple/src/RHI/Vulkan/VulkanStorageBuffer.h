@@ -22,6 +22,8 @@ namespace maple
 		auto unmap() -> void override;
 		auto map() -> void * override;
 		auto getDeviceAddress() const -> uint64_t override;
+		auto invalidate() -> void override;
+		auto flush() -> void override;
 	  private:
 		std::shared_ptr<VulkanBuffer> vulkanBuffer;
 		BufferOptions                 options;
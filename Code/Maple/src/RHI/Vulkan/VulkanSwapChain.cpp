@@ -8,6 +8,8 @@
 #include "VulkanCommandPool.h"
 #include "VulkanContext.h"
 #include "VulkanDevice.h"
+#include "VulkanFrameAllocator.h"
+#include "VulkanUploadManager.h"
 #include "VulkanHelper.h"
 #include "VulkanTexture.h"
 
@@ -28,6 +30,81 @@ namespace maple
 			glfwCreateWindowSurface(VulkanContext::get()->getVkInstance(), static_cast<GLFWwindow *>(window->getNativeInterface()), nullptr, (VkSurfaceKHR *) &surface);
 			return surface;
 		}
+
+		//stages of the graphics queue which wait for the async compute queue, the vertex work of the next frame runs beside it
+		constexpr VkPipelineStageFlags ComputeResultStages = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT |
+		                                                     VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT |
+		                                                     VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT | VK_PIPELINE_STAGE_TRANSFER_BIT;
+
+		inline auto getAspectMask(const Texture *texture) -> VkImageAspectFlags
+		{
+			if (texture->getType() == TextureType::Depth || texture->getType() == TextureType::DepthArray)
+				return texture->getFormat() == TextureFormat::DEPTH_STENCIL ? VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT : VK_IMAGE_ASPECT_DEPTH_BIT;
+			return VK_IMAGE_ASPECT_COLOR_BIT;
+		}
+
+		inline auto getLayouts(const VkTexture *texture, OwnershipTransfer &transfer)
+		{
+			transfer.layouts.resize(texture->getLayoutCount());
+			for (uint32_t i = 0; i < transfer.layouts.size(); i++)
+			{
+				transfer.layouts[i] = texture->getMipLayout(i);
+			}
+		}
+
+		/**
+		 * The release and the acquire of a transfer have to match, so both sides are recorded from the same OwnershipTransfer.
+		 * The layouts are not changed, mips in the same layout share one barrier.
+		 */
+		inline auto recordTransfers(const VulkanCommandBuffer *commandBuffer, const std::vector<OwnershipTransfer> &transfers,
+		                            uint32_t srcFamily, uint32_t dstFamily, bool release, VkPipelineStageFlags stages)
+		{
+			std::vector<VkImageMemoryBarrier> barriers;
+			for (auto &transfer : transfers)
+			{
+				const bool perMip = transfer.layouts.size() > 1;
+				for (uint32_t mip = 0; mip < transfer.layouts.size(); mip++)
+				{
+					const auto layout = transfer.layouts[mip];
+					//nothing is kept from undefined contents, the other queue can use them without a transfer
+					if (layout == VK_IMAGE_LAYOUT_UNDEFINED)
+						continue;
+
+					if (perMip && !barriers.empty())
+					{
+						auto &last = barriers.back();
+						if (last.image == transfer.image && last.oldLayout == layout && last.subresourceRange.baseMipLevel + last.subresourceRange.levelCount == mip)
+						{
+							last.subresourceRange.levelCount++;
+							continue;
+						}
+					}
+
+					auto barrier                            = VulkanHelper::imageMemoryBarrier();
+					barrier.srcQueueFamilyIndex             = srcFamily;
+					barrier.dstQueueFamilyIndex             = dstFamily;
+					barrier.oldLayout                       = layout;
+					barrier.newLayout                       = layout;
+					barrier.srcAccessMask                   = release ? VK_ACCESS_MEMORY_WRITE_BIT : 0;
+					barrier.dstAccessMask                   = release ? 0 : VK_ACCESS_MEMORY_READ_BIT | VK_ACCESS_MEMORY_WRITE_BIT;
+					barrier.image                           = transfer.image;
+					barrier.subresourceRange.aspectMask     = transfer.aspectMask;
+					barrier.subresourceRange.baseMipLevel   = mip;
+					barrier.subresourceRange.levelCount     = perMip ? 1 : VK_REMAINING_MIP_LEVELS;
+					barrier.subresourceRange.baseArrayLayer = 0;
+					barrier.subresourceRange.layerCount     = VK_REMAINING_ARRAY_LAYERS;
+					barriers.emplace_back(barrier);
+				}
+			}
+
+			if (barriers.empty())
+				return;
+
+			vkCmdPipelineBarrier(commandBuffer->getCommandBuffer(),
+			                     stages, release ? VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT : stages,
+			                     0, 0, nullptr, 0, nullptr,
+			                     static_cast<uint32_t>(barriers.size()), barriers.data());
+		}
 	}        // namespace
 
 	VulkanSwapChain::VulkanSwapChain(uint32_t width, uint32_t height) :
@@ -38,8 +115,17 @@ namespace maple
 
 	VulkanSwapChain::~VulkanSwapChain()
 	{
+		waitCompute(timelineValue);
+		for (auto &compute : computeData)
+		{
+			compute.commandBuffer = nullptr;
+			compute.commandPool   = nullptr;
+		}
+
 		vkDestroySemaphore(*VulkanDevice::get(), presentSemaphore, nullptr);
 		vkDestroySemaphore(*VulkanDevice::get(), rendererSemaphore, nullptr);
+		vkDestroySemaphore(*VulkanDevice::get(), graphicsTimeline, nullptr);
+		vkDestroySemaphore(*VulkanDevice::get(), computeTimeline, nullptr);
 
 		for (uint32_t i = 0; i < swapChainBufferCount; i++)
 		{
@@ -208,22 +294,7 @@ namespace maple
 
 		delete[] pSwapChainImages;
 		createFrameData();
-		//createComputeData();
-
-		if (graphicsSemaphore == nullptr)
-		{
-			VkSemaphoreCreateInfo semaphoreCreateInfo{};
-			semaphoreCreateInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
-			VK_CHECK_RESULT(vkCreateSemaphore(*VulkanDevice::get(), &semaphoreCreateInfo, nullptr, &graphicsSemaphore));
-		}
-
-		// Signal the semaphore
-		/*	VkSubmitInfo submitInfo{};
-		submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-		submitInfo.signalSemaphoreCount = 1;
-		submitInfo.pSignalSemaphores = &computeData.semaphore;
-		VK_CHECK_RESULT(vkQueueSubmit(VulkanDevice::get()->getGraphicsQueue(), 1, &submitInfo, VK_NULL_HANDLE));
-		VK_CHECK_RESULT(vkQueueWaitIdle(VulkanDevice::get()->getGraphicsQueue()));*/
+		createComputeData();
 
 		return true;
 	}
@@ -249,6 +320,10 @@ namespace maple
 
 					frames[i].commandBuffer = std::make_shared<VulkanCommandBuffer>();
 					frames[i].commandBuffer->init(true, *frames[i].commandPool);
+
+					//the pools are created by their own thread on first use
+					auto &jobSystem = Application::getJobSystem();
+					frames[i].secondaries.resize(jobSystem != nullptr ? jobSystem->getWorkerCount() + 1 : 1);
 					LOGI("Create the {0} VulkanCommandBuffer", i);
 				}
 			}
@@ -257,25 +332,47 @@ namespace maple
 
 	auto VulkanSwapChain::createComputeData() -> void
 	{
-		if (computeData.commandBuffer == nullptr)
+		asyncCompute = VulkanDevice::get()->isAsyncComputeSupported();
+		if (!asyncCompute || computeTimeline != VK_NULL_HANDLE)
+			return;
+
+		VkSemaphoreTypeCreateInfo typeInfo = {};
+		typeInfo.sType                     = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+		typeInfo.semaphoreType             = VK_SEMAPHORE_TYPE_TIMELINE;
+		typeInfo.initialValue              = 0;
+
+		VkSemaphoreCreateInfo semaphoreInfo = {};
+		semaphoreInfo.sType                 = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+		semaphoreInfo.pNext                 = &typeInfo;
+		semaphoreInfo.flags                 = 0;
+
+		VK_CHECK_RESULT(vkCreateSemaphore(*VulkanDevice::get(), &semaphoreInfo, nullptr, &graphicsTimeline));
+		VK_CHECK_RESULT(vkCreateSemaphore(*VulkanDevice::get(), &semaphoreInfo, nullptr, &computeTimeline));
+
+		for (auto &compute : computeData)
 		{
-			computeData.commandPool = std::make_shared<VulkanCommandPool>(
+			compute.commandPool = std::make_shared<VulkanCommandPool>(
 			    VulkanDevice::get()->getPhysicalDevice()->getQueueFamilyIndices().computeFamily.value(),
 			    VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT);
 
-			VkSemaphoreCreateInfo semaphoreInfo = {};
-			semaphoreInfo.sType                 = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
-			semaphoreInfo.pNext                 = nullptr;
-			semaphoreInfo.flags                 = 0;
-
-			if (computeData.semaphore == VK_NULL_HANDLE)
-				VK_CHECK_RESULT(vkCreateSemaphore(*VulkanDevice::get(), &semaphoreInfo, nullptr, &computeData.semaphore));
+			compute.commandBuffer = std::make_shared<VulkanCommandBuffer>(CommandBufferType::Compute);
+			compute.commandBuffer->init(true, *compute.commandPool);
+		}
+		LOGI("Create Vulkan Compute CommandBuffer");
+	}
 
-			computeData.commandBuffer = std::make_shared<VulkanCommandBuffer>(CommandBufferType::Compute);
-			computeData.commandBuffer->init(true, *computeData.commandPool);
+	auto VulkanSwapChain::waitCompute(uint64_t value) -> void
+	{
+		PROFILE_FUNCTION();
+		if (!asyncCompute || value == 0)
+			return;
 
-			LOGI("Create Vulkan Compute CommandBuffer");
-		}
+		VkSemaphoreWaitInfo waitInfo = {};
+		waitInfo.sType               = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+		waitInfo.semaphoreCount      = 1;
+		waitInfo.pSemaphores         = &computeTimeline;
+		waitInfo.pValues             = &value;
+		VK_CHECK_RESULT(vkWaitSemaphores(*VulkanDevice::get(), &waitInfo, UINT64_MAX));
 	}
 
 	auto VulkanSwapChain::findImageFormatAndColorSpace() -> void
@@ -352,12 +449,40 @@ namespace maple
 	auto VulkanSwapChain::queueSubmit() -> void
 	{
 		PROFILE_FUNCTION();
+		//the uploads recorded during the frame run before it in submission order
+		if (auto uploads = VulkanContext::getUploadManager())
+			uploads->flush();
+
 		auto &frameData = getFrameData();
+		if (!asyncCompute)
+		{
+			frameData.commandBuffer->executeInternal(
+			    {VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT},
+			    {presentSemaphore},
+			    {rendererSemaphore},
+			    true);
+			return;
+		}
+
+		//graphics waits for the compute work of the last frame, the compute work of this frame waits for graphics
+		const auto lastCompute = timelineValue++;
 		frameData.commandBuffer->executeInternal(
-		    {VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT},
-		    {presentSemaphore /*, computeData.semaphore*/},
-		    {/*graphicsSemaphore, */ rendererSemaphore},
-		    true);
+		    {VK_PIPELINE_STAGE_VERTEX_INPUT_BIT, ComputeResultStages},
+		    {presentSemaphore, computeTimeline},
+		    {rendererSemaphore, graphicsTimeline},
+		    true,
+		    {0, lastCompute},
+		    {0, timelineValue});
+
+		auto &compute = computeData[currentBuffer];
+		compute.commandBuffer->executeInternal(
+		    {VK_PIPELINE_STAGE_ALL_COMMANDS_BIT},
+		    {graphicsTimeline},
+		    {computeTimeline},
+		    true,
+		    {timelineValue},
+		    {timelineValue});
+		compute.timelineValue = timelineValue;
 	}
 
 	auto VulkanSwapChain::begin() -> void
@@ -369,26 +494,102 @@ namespace maple
 			commandBuffer->wait();
 		}
 		commandBuffer->reset();
+
+		for (auto &secondary : getFrameData().secondaries)
+		{
+			if (secondary.commandPool)
+				secondary.commandPool->reset();
+			secondary.used = 0;
+		}
+
 		VulkanContext::getDeletionQueue(currentBuffer).flush();
+		if (auto allocator = VulkanContext::getFrameAllocator())
+			allocator->beginFrame(currentBuffer);
+		if (auto uploads = VulkanContext::getUploadManager())
+			uploads->beginFrame();
 		commandBuffer->beginRecording();
 
-		/*
-
-		vkQueueWaitIdle(VulkanDevice::get()->getComputeQueue());
-		auto cmd = computeData.commandBuffer;
-		if (cmd->getState() == CommandBufferState::Submitted)
+		if (asyncCompute)
 		{
-			cmd->wait();
+			auto &indices = VulkanDevice::get()->getPhysicalDevice()->getQueueFamilyIndices();
+
+			//the images used by the compute queue in the last frame are handed back before graphics touches them
+			recordTransfers(commandBuffer.get(), returned, indices.computeFamily.value(), indices.graphicsFamily.value(), false, ComputeResultStages);
+			returned.clear();
+
+			//the buffer of this slot was submitted swapChainBufferCount frames ago
+			auto &compute = computeData[currentBuffer];
+			waitCompute(compute.timelineValue);
+			if (compute.commandBuffer->getState() == CommandBufferState::Submitted)
+				compute.commandBuffer->wait();
+			compute.commandBuffer->reset();
+			compute.commandBuffer->beginRecording();
 		}
-		cmd->reset();
-		cmd->beginRecording();*/
 	}
 
 	auto VulkanSwapChain::end() -> void
 	{
 		PROFILE_FUNCTION();
-		getCurrentCommandBuffer()->endRecording();
-		//computeData.commandBuffer->endRecording();
+		auto commandBuffer = getFrameData().commandBuffer;
+		if (asyncCompute)
+		{
+			std::lock_guard<std::mutex> lock(ownershipMutex);
+			auto &                      indices = VulkanDevice::get()->getPhysicalDevice()->getQueueFamilyIndices();
+			auto                        compute = computeData[currentBuffer].commandBuffer;
+
+			//barriers are not allowed inside a render pass
+			commandBuffer->unbindPipeline();
+			compute->unbindPipeline();
+
+			std::vector<OwnershipTransfer> released;
+			for (auto &[texture, transfer] : borrowed)
+			{
+				OwnershipTransfer back;
+				back.image      = transfer.image;
+				back.aspectMask = transfer.aspectMask;
+				getLayouts(dynamic_cast<VkTexture *>(texture), back);
+				released.emplace_back(std::move(transfer));
+				returned.emplace_back(std::move(back));
+			}
+			borrowed.clear();
+			misused.clear();
+
+			recordTransfers(commandBuffer.get(), released, indices.graphicsFamily.value(), indices.computeFamily.value(), true, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+			recordTransfers(compute.get(), returned, indices.computeFamily.value(), indices.graphicsFamily.value(), true, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+			compute->endRecording();
+		}
+		commandBuffer->endRecording();
+	}
+
+	auto VulkanSwapChain::trackOwnership(Texture *texture, const VulkanCommandBuffer *commandBuffer) -> void
+	{
+		if (!asyncCompute || texture == nullptr || commandBuffer == nullptr)
+			return;
+
+		std::lock_guard<std::mutex> lock(ownershipMutex);
+		if (commandBuffer->getCommandBuffeType() != CommandBufferType::Compute)
+		{
+			//graphics runs before compute on the gpu, it would see the image as it was before the compute work
+			if (!borrowed.empty() && borrowed.find(texture) != borrowed.end() && misused.emplace(texture).second)
+				LOGW("{0} is used by the graphics queue after the async compute queue in the same frame", texture->getName());
+			return;
+		}
+
+		if (borrowed.find(texture) != borrowed.end())
+			return;
+
+		auto vkTexture = dynamic_cast<VkTexture *>(texture);
+		if (vkTexture == nullptr)
+			return;
+
+		OwnershipTransfer transfer;
+		transfer.image      = vkTexture->getImage();
+		transfer.aspectMask = getAspectMask(texture);
+		getLayouts(vkTexture, transfer);
+
+		auto &indices = VulkanDevice::get()->getPhysicalDevice()->getQueueFamilyIndices();
+		recordTransfers(commandBuffer, {transfer}, indices.graphicsFamily.value(), indices.computeFamily.value(), false, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+		borrowed.emplace(texture, std::move(transfer));
 	}
 
 	auto VulkanSwapChain::getCurrentCommandBuffer() -> CommandBuffer *
@@ -396,6 +597,28 @@ namespace maple
 		return getFrameData().commandBuffer.get();
 	}
 
+	auto VulkanSwapChain::getSecondaryCommandBuffer() -> CommandBuffer *
+	{
+		auto &     secondaries = getFrameData().secondaries;
+		const auto slot        = static_cast<size_t>(Application::getJobSystem()->getCurrentWorkerIndex() + 1);
+		MAPLE_ASSERT(slot < secondaries.size(), "secondary command buffer requested from an unknown thread");
+
+		auto &commands = secondaries[slot];
+		if (commands.commandPool == nullptr)
+		{
+			commands.commandPool = std::make_shared<VulkanCommandPool>(VulkanDevice::get()->getPhysicalDevice()->getQueueFamilyIndices().graphicsFamily.value(),
+			                                                           VK_COMMAND_POOL_CREATE_TRANSIENT_BIT);
+		}
+
+		if (commands.used == commands.commandBuffers.size())
+		{
+			auto commandBuffer = std::make_shared<VulkanCommandBuffer>();
+			commandBuffer->init(false, *commands.commandPool);
+			commands.commandBuffers.emplace_back(commandBuffer);
+		}
+		return commands.commandBuffers[commands.used++].get();
+	}
+
 	//swap buffer
 	auto VulkanSwapChain::present() -> void
 	{
@@ -428,21 +651,12 @@ namespace maple
 
 		VK_CHECK_RESULT(vkQueueWaitIdle(VulkanDevice::get()->getGraphicsQueue()));
 
-		/*
-		VulkanContext::get()->waitIdle();
-
-		computeData.commandBuffer->executeInternal(
-			{ VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT },
-			{ graphicsSemaphore },
-			{ computeData.semaphore },
-			true);*/
-
 		VulkanContext::getDeletionQueue(currentBuffer).flush();
 	}
 
 	auto VulkanSwapChain::getComputeCmdBuffer() -> CommandBuffer *
 	{
-		return computeData.commandBuffer.get();
+		return asyncCompute ? computeData[currentBuffer].commandBuffer.get() : nullptr;
 	}
 
 	auto VulkanSwapChain::getFrameData() -> FrameData &
@@ -468,6 +682,7 @@ namespace maple
 
 			swapChainBuffers[i].reset();
 		}
+		waitCompute(timelineValue);
 
 		swapChainBuffers.clear();
 		oldSwapChain = swapChain;
@@ -8,23 +8,44 @@
 #include "RHI/Texture.h"
 #include "VulkanHelper.h"
 #include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
 
 namespace maple
 {
 	constexpr uint32_t MAX_SWAPCHAIN_BUFFERS = 3;
 
+	//secondary command buffers of one recording thread, a command pool must not be used by two threads at once
+	struct SecondaryCommands
+	{
+		std::shared_ptr<VulkanCommandPool>                commandPool;
+		std::vector<std::shared_ptr<VulkanCommandBuffer>> commandBuffers;
+		uint32_t                                          used = 0;
+	};
+
 	struct FrameData
 	{
 		std::shared_ptr<VulkanCommandPool>   commandPool;
 		std::shared_ptr<VulkanCommandBuffer> commandBuffer;
+		//slot i + 1 belongs to the worker i of the job system (the main thread is worker 0, so slot 1),
+		//slot 0 to a thread outside the job system
+		std::vector<SecondaryCommands> secondaries;
 	};
 
 	struct ComputeData
 	{
-		//VkQueue queue;										// Separate queue for compute commands (queue family may differ from the one used for graphics)
-		std::shared_ptr<VulkanCommandPool>   commandPool;                       // Use a separate command pool (queue family may differ from the one used for graphics)
-		std::shared_ptr<VulkanCommandBuffer> commandBuffer;                     // Command buffer storing the dispatch commands and barriers
-		VkSemaphore                          semaphore = VK_NULL_HANDLE;        // Execution dependency between compute & graphic submission
+		std::shared_ptr<VulkanCommandPool>   commandPool;              // Use a separate command pool (queue family may differ from the one used for graphics)
+		std::shared_ptr<VulkanCommandBuffer> commandBuffer;            // Command buffer storing the dispatch commands and barriers
+		uint64_t                             timelineValue = 0;        // Value of the compute timeline signaled by the last submission of this buffer
+	};
+
+	//an image handed between the graphics and the compute queue family, the layouts are kept by the transfer
+	struct OwnershipTransfer
+	{
+		VkImage                    image      = VK_NULL_HANDLE;
+		VkImageAspectFlags         aspectMask = VK_IMAGE_ASPECT_COLOR_BIT;
+		std::vector<VkImageLayout> layouts;        //one per mip, or one for the whole image
 	};
 
 	class VulkanSwapChain final : public SwapChain
@@ -90,11 +111,27 @@ namespace maple
 
 		auto getComputeCmdBuffer() -> CommandBuffer * override;
 
+		auto getSecondaryCommandBuffer() -> CommandBuffer * override;
+
+		inline auto isAsyncCompute() const
+		{
+			return asyncCompute;
+		}
+
+		/**
+		 * Called for every texture a command buffer is about to use. The first use on the async compute queue in a frame
+		 * acquires the image from the graphics queue family, it is released to compute at the end of the graphics commands
+		 * and handed back to graphics at the beginning of the next frame.
+		 */
+		auto trackOwnership(Texture *texture, const VulkanCommandBuffer *commandBuffer) -> void;
+
 	  private:
 		auto createFrameData() -> void;
 		auto createComputeData() -> void;
+		auto waitCompute(uint64_t value) -> void;
 
-		FrameData frames[MAX_SWAPCHAIN_BUFFERS];
+		FrameData   frames[MAX_SWAPCHAIN_BUFFERS];
+		ComputeData computeData[MAX_SWAPCHAIN_BUFFERS];
 
 		auto findImageFormatAndColorSpace() -> void;
 
@@ -113,10 +150,17 @@ namespace maple
 		VkSurfaceKHR    surface      = nullptr;
 		VkFormat        colorFormat;
 		VkColorSpaceKHR colorSpace;
-		ComputeData     computeData;
 
-		// Execution dependency between compute & graphic submission
-		VkSemaphore graphicsSemaphore = nullptr;
+		// Frame N of the compute queue waits for frame N of the graphics queue, frame N + 1 of the graphics queue waits for it
+		VkSemaphore graphicsTimeline = VK_NULL_HANDLE;
+		VkSemaphore computeTimeline  = VK_NULL_HANDLE;
+		uint64_t    timelineValue    = 0;
+		bool        asyncCompute     = false;
+
+		std::mutex                                        ownershipMutex;
+		std::unordered_map<Texture *, OwnershipTransfer> borrowed;        //taken by the compute queue in this frame, with the layouts graphics left them in
+		std::vector<OwnershipTransfer>                    returned;        //released by the compute queue, acquired by the next graphics frame
+		std::unordered_set<Texture *>                     misused;         //reported once per frame
 
 		VkSemaphore presentSemaphore  = VK_NULL_HANDLE;
 		VkSemaphore rendererSemaphore = VK_NULL_HANDLE;
@@ -13,9 +13,11 @@
 #include "VulkanDevice.h"
 #include "VulkanFrameBuffer.h"
 #include "VulkanSwapChain.h"
+#include "VulkanUploadManager.h"
 
 #include "Application.h"
 #include <cassert>
+#include <cstring>
 
 namespace maple
 {
@@ -23,6 +25,9 @@ namespace maple
 
 	static std::atomic<uint32_t> IdGenerator = 0;
 
+	//streamed textures start with the mips up to this size, the TextureStreamer requests the others
+	static constexpr uint32_t StreamingTailSize = 64;
+
 	namespace tools
 	{
 		inline auto generateMipmaps(VkImage image, VkFormat imageFormat, uint32_t texWidth, uint32_t texHeight, uint32_t depth, uint32_t mipLevels, uint32_t faces = 1, VkCommandBuffer commandBuffer = nullptr, VkImageLayout initLayout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL) -> void
@@ -39,6 +44,14 @@ namespace maple
 
 			if (commandBuffer == nullptr)
 			{
+				//generated in the upload batch, which runs before the next frame
+				if (auto uploads = VulkanContext::getUploadManager())
+				{
+					uploads->record([&](VkCommandBuffer uploadCmd) {
+						generateMipmaps(image, imageFormat, texWidth, texHeight, depth, mipLevels, faces, uploadCmd, initLayout);
+					});
+					return;
+				}
 				commandBuffer = VulkanHelper::beginSingleTimeCommands();
 				singleTime    = true;
 			}
@@ -160,9 +173,22 @@ namespace maple
 					return 0;
 				case TextureFormat::SCREEN:
 					return 0;
+				case TextureFormat::BC1:
+				case TextureFormat::BC3:
+				case TextureFormat::BC4:
+				case TextureFormat::BC5:
+				case TextureFormat::BC7:
+				case TextureFormat::ASTC_4x4:
+					return 0;        //Texture::getBlockSize
 			}
 			MAPLE_ASSERT(false, "Unknown TextureFormat");
 		}
+
+		//8 bit formats whose mip chain is built on the cpu and the ones whose chain came prebuilt, see VulkanTexture2D::loadStreamed
+		inline auto isStreamable(const TextureFormat format, uint32_t levels)
+		{
+			return levels > 1 || format == TextureFormat::R8 || format == TextureFormat::RG8 || format == TextureFormat::RGBA8 || format == TextureFormat::RGBA;
+		}
 	}        // namespace tools
 
 	VulkanTexture2D::VulkanTexture2D(uint32_t width, uint32_t height, const void *data, TextureParameters parameters, TextureLoadOptions loadOptions) :
@@ -173,10 +199,18 @@ namespace maple
 	    height(height)
 	{
 		vkFormat = VkConverter::textureFormatToVK(parameters.format, false);
+		id       = IdGenerator++;
+
+		if (data != nullptr && loadOptions.streamed && loadOptions.generateMipMaps && tools::isStreamable(parameters.format, 1))
+		{
+			deleteImage = true;
+			loadStreamed(this->data, 1);
+			createSampler();
+			return;
+		}
 
 		buildTexture(parameters.format, width, height, false, false, false, loadOptions.generateMipMaps, false, 0);
 		update(0, 0, width, height, data);
-		id = IdGenerator++;
 	}
 
 	VulkanTexture2D::VulkanTexture2D(const std::string &name, const std::string &fileName, TextureParameters parameters, TextureLoadOptions loadOptions) :
@@ -223,34 +257,42 @@ namespace maple
 	VulkanTexture2D::~VulkanTexture2D()
 	{
 		PROFILE_FUNCTION();
-		auto &deletionQueue = VulkanContext::getDeletionQueue();
-		for (auto &view : mipImageViews)
-		{
-			if (view.second)
-			{
-				auto imageView = view.second;
-				deletionQueue.emplace([imageView] { vkDestroyImageView(*VulkanDevice::get(), imageView, nullptr); });
-			}
-		}
-
-		mipImageViews.clear();
-
 		deleteSampler();
 	}
 
 	auto VulkanTexture2D::update(uint32_t x, uint32_t y, uint32_t w, uint32_t h, const void *buffer) -> void
 	{
-		auto stagingBuffer = std::make_unique<VulkanBuffer>(VK_BUFFER_USAGE_TRANSFER_SRC_BIT, w * h * tools::getFormatSize(parameters.format), buffer);
-		auto oldLayout     = imageLayout;
-		transitionImage(VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
-		VulkanHelper::copyBufferToImage(stagingBuffer->getVkBuffer(), textureImage, static_cast<uint32_t>(w), static_cast<uint32_t>(h), 1, x, y, 0);
+		PROFILE_FUNCTION();
+		if (isStreamed())
+		{
+			LOGW("{0} is streamed, the mip chain it is streamed from can not be updated", name);
+			return;
+		}
 
-		if (loadOptions.generateMipMaps)
+		if (Texture::isCompressedFormat(parameters.format))
 		{
-			tools::generateMipmaps(textureImage, VkConverter::textureFormatToVK(parameters.format, false), width, height, 1, mipLevels);
+			LOGW("{0} is block compressed, it can not be updated", name);
+			return;
 		}
 
-		transitionImage(oldLayout);
+		VulkanUploadManager::ImageUpload upload;
+		upload.image     = textureImage;
+		upload.format    = VkConverter::textureFormatToVK(parameters.format, false);
+		upload.oldLayout = imageLayout;
+		upload.newLayout = imageLayout == VK_IMAGE_LAYOUT_UNDEFINED ? VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL : imageLayout;
+		upload.mipLevels = mipLevels;
+		upload.width     = w;
+		upload.height    = h;
+		upload.offsetX   = x;
+		upload.offsetY   = y;
+
+		VulkanContext::getUploadManager()->uploadImage(upload, buffer, uint64_t(w) * h * tools::getFormatSize(parameters.format), [&](VkCommandBuffer cmd) {
+			if (loadOptions.generateMipMaps && mipLevels > 1)
+				tools::generateMipmaps(textureImage, upload.format, width, height, 1, mipLevels, 1, cmd);
+		});
+
+		imageLayout = upload.newLayout;
+		updateDescriptor();
 	}
 
 	auto VulkanTexture2D::load() -> bool
@@ -258,7 +300,8 @@ namespace maple
 		PROFILE_FUNCTION();
 		auto imageSize = tools::getFormatSize(parameters.format) * width * height;
 
-		const uint8_t *pixel = nullptr;
+		const uint8_t *pixel  = nullptr;
+		uint32_t       levels = 1;
 
 		std::unique_ptr<maple::Image> image;
 
@@ -270,20 +313,33 @@ namespace maple
 		}
 		else if (fileName != "")
 		{
-			image             = maple::ImageLoader::loadAsset(fileName, true, true);
+			image = maple::ImageLoader::loadAsset(fileName, loadOptions.generateMipMaps, true, true);
+			if (image == nullptr)
+			{
+				LOGE("{0} could not be loaded", fileName);
+				return false;
+			}
 			width             = image->getWidth();
 			height            = image->getHeight();
 			imageSize         = image->getImageSize();
 			pixel             = reinterpret_cast<const uint8_t *>(image->getData());
 			parameters.format = image->getPixelFormat();
 			vkFormat          = VkConverter::textureFormatToVK(parameters.format, false);
+			levels            = image->getLevels();
+		}
+
+		if (pixel != nullptr && loadOptions.streamed && loadOptions.generateMipMaps && tools::isStreamable(parameters.format, levels))
+		{
+			loadStreamed(pixel, levels);
+			return true;
 		}
 
 		mipLevels = static_cast<uint32_t>(std::floor(std::log2(std::max(width, height)))) + 1;
 
-		if (!loadOptions.generateMipMaps)
+		//a prebuilt chain is taken as it is, the compressed formats can not be blitted into their mips
+		if (!loadOptions.generateMipMaps || levels > 1 || Texture::isCompressedFormat(parameters.format))
 		{
-			mipLevels = 1;
+			mipLevels = levels;
 		}
 
 #ifdef USE_VMA_ALLOCATOR
@@ -291,20 +347,148 @@ namespace maple
 #else
 		VulkanHelper::createImage(width, height, mipLevels, VkConverter::textureFormatToVK(parameters.format, false), VK_IMAGE_TYPE_2D, VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, textureImage, textureImageMemory, 1, 0);
 #endif
-		VulkanHelper::transitionImageLayout(textureImage, VkConverter::textureFormatToVK(parameters.format, false),
-		                                    VK_IMAGE_LAYOUT_UNDEFINED,
-		                                    VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
-		                                    mipLevels, 1, nullptr, false);
+		//staged and copied on the transfer queue with the next frame instead of waiting for the queue here
+		VulkanUploadManager::ImageUpload upload;
+		upload.image     = textureImage;
+		upload.format    = VkConverter::textureFormatToVK(parameters.format, false);
+		upload.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+		upload.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+		upload.mipLevels = mipLevels;
+		upload.levels    = levels;
+		upload.texelSize = tools::getFormatSize(parameters.format);
+		upload.blockSize = Texture::getBlockSize(parameters.format);
+		upload.width     = width;
+		upload.height    = height;
+
+		VulkanContext::getUploadManager()->uploadImage(upload, pixel, imageSize, [&](VkCommandBuffer cmd) {
+			if (loadOptions.generateMipMaps && mipLevels > levels)
+				tools::generateMipmaps(textureImage, upload.format, width, height, 1, mipLevels, 1, cmd);
+		});
 
-		auto stagingBuffer = std::make_unique<VulkanBuffer>(VK_BUFFER_USAGE_TRANSFER_SRC_BIT, imageSize, pixel);
-		VulkanHelper::copyBufferToImage(stagingBuffer->getVkBuffer(), textureImage, static_cast<uint32_t>(width), static_cast<uint32_t>(height));
+		imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+		updateDescriptor();
 
-		if (loadOptions.generateMipMaps && mipLevels > 1)
-			tools::generateMipmaps(textureImage, VkConverter::textureFormatToVK(parameters.format, false), width, height, 1, mipLevels);
+		DEBUG_IMAGE_ADDRESS(textureImage);
+		return true;
+	}
+
+	auto VulkanTexture2D::loadStreamed(const uint8_t *pixels, uint32_t levels) -> void
+	{
+		PROFILE_FUNCTION();
+		if (levels > 1)
+		{
+			//the chain of a ktx2 file, laid out the way buildMipChain does it
+			mipLevels = levels;
+			streamLevels.resize(levels);
+			uint64_t size = 0;
+			for (uint32_t level = 0; level < levels; level++)
+			{
+				streamLevels[level] = size;
+				size += (Texture::getLevelSize(parameters.format, std::max(width >> level, 1u), std::max(height >> level, 1u)) + 3) & ~uint64_t(3);
+			}
+			streamData.assign(pixels, pixels + size);
+		}
+		else
+		{
+			mipLevels = Texture::calculateMipMapCount(width, height);
+			Texture::buildMipChain(pixels, width, height, tools::getFormatSize(parameters.format), mipLevels, streamData, streamLevels);
+		}
 
-		transitionImage(VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+		tailMip = 0;
+		while (tailMip + 1 < mipLevels && std::max(width >> tailMip, height >> tailMip) > StreamingTailSize)
+			tailMip++;
 
+		residentMip = tailMip;
+		createResidentImage();
+	}
+
+	//the image holds the mips from residentMip on, the copies run with the next frame
+	auto VulkanTexture2D::createResidentImage() -> void
+	{
+		PROFILE_FUNCTION();
+		const auto imageWidth  = std::max(width >> residentMip, 1u);
+		const auto imageHeight = std::max(height >> residentMip, 1u);
+		const auto levels      = getImageLevels();
+
+#ifdef USE_VMA_ALLOCATOR
+		VulkanHelper::createImage(imageWidth, imageHeight, levels, vkFormat, VK_IMAGE_TYPE_2D, VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, textureImage, textureImageMemory, 1, 0, allocation);
+#else
+		VulkanHelper::createImage(imageWidth, imageHeight, levels, vkFormat, VK_IMAGE_TYPE_2D, VK_IMAGE_TILING_OPTIMAL, VK_IMAGE_USAGE_TRANSFER_SRC_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_SAMPLED_BIT, VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT, textureImage, textureImageMemory, 1, 0);
+#endif
+		VulkanUploadManager::ImageUpload upload;
+		upload.image     = textureImage;
+		upload.format    = vkFormat;
+		upload.oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+		upload.newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+		upload.mipLevels = levels;
+		upload.levels    = levels;
+		upload.texelSize = tools::getFormatSize(parameters.format);
+		upload.blockSize = Texture::getBlockSize(parameters.format);
+		upload.width     = imageWidth;
+		upload.height    = imageHeight;
+
+		const auto offset = streamLevels[residentMip];
+		VulkanContext::getUploadManager()->uploadImage(upload, streamData.data() + offset, streamData.size() - offset);
+
+		imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
 		DEBUG_IMAGE_ADDRESS(textureImage);
+	}
+
+	auto VulkanTexture2D::setResidentMip(uint32_t mip) -> void
+	{
+		PROFILE_FUNCTION();
+		if (streamLevels.empty())
+			return;
+
+		mip = std::min(mip, tailMip);
+		if (mip == residentMip)
+			return;
+
+		//the old image stays alive in the deletion queue until the frames which sample it completed
+		releaseImage();
+		residentMip = mip;
+		createResidentImage();
+
+		textureImageView = VulkanHelper::createImageView(textureImage, vkFormat, getImageLevels(), VK_IMAGE_VIEW_TYPE_2D, VK_IMAGE_ASPECT_COLOR_BIT, 1);
+		updateDescriptor();
+		setName(name);
+		generation++;
+	}
+
+	auto VulkanTexture2D::reload() -> bool
+	{
+		PROFILE_FUNCTION();
+		if (fileName.empty())
+			return false;
+
+		//the current image is kept when the file can not be read, while it is still being written for instance
+		VulkanTexture2D loaded(name, fileName, parameters, loadOptions);
+		if (!loaded.deleteImage)
+			return false;
+
+		std::swap(width, loaded.width);
+		std::swap(height, loaded.height);
+		std::swap(mipLevels, loaded.mipLevels);
+		std::swap(vkFormat, loaded.vkFormat);
+		std::swap(parameters, loaded.parameters);
+		std::swap(textureImage, loaded.textureImage);
+		std::swap(textureImageView, loaded.textureImageView);
+		std::swap(textureImageMemory, loaded.textureImageMemory);
+		std::swap(textureSampler, loaded.textureSampler);
+		std::swap(imageLayout, loaded.imageLayout);
+		std::swap(mipImageViews, loaded.mipImageViews);
+		std::swap(streamData, loaded.streamData);
+		std::swap(streamLevels, loaded.streamLevels);
+		std::swap(residentMip, loaded.residentMip);
+		std::swap(tailMip, loaded.tailMip);
+#ifdef USE_VMA_ALLOCATOR
+		std::swap(allocation, loaded.allocation);
+#endif
+		//the old image goes to the deletion queue with loaded
+		updateDescriptor();
+		setName(name);
+		updated = true;
+		generation++;
 		return true;
 	}
 
@@ -371,7 +555,7 @@ namespace maple
 
 		if (newLayout != imageLayout)
 		{
-			VulkanHelper::transitionImageLayout(textureImage, VkConverter::textureFormatToVK(parameters.format, false), imageLayout, newLayout, mipLevels, 1, commandBuffer, false);
+			VulkanHelper::transitionImageLayout(textureImage, VkConverter::textureFormatToVK(parameters.format, false), imageLayout, newLayout, getImageLevels(), 1, commandBuffer, false);
 		}
 		imageLayout = newLayout;
 		updateDescriptor();
@@ -383,7 +567,7 @@ namespace maple
 		if (auto iter = mipImageViews.find(mip); iter == mipImageViews.end())
 		{
 			mipImageViews[mip] = VulkanHelper::createImageView(textureImage, VkConverter::textureFormatToVK(parameters.format, false),
-			                                                   mipLevels, VK_IMAGE_VIEW_TYPE_2D, VK_IMAGE_ASPECT_COLOR_BIT, 1, 0, mip);
+			                                                   getImageLevels(), VK_IMAGE_VIEW_TYPE_2D, VK_IMAGE_ASPECT_COLOR_BIT, 1, 0, mip);
 		}
 		return mipImageViews.at(mip);
 	}
@@ -440,7 +624,7 @@ namespace maple
 		PROFILE_FUNCTION();
 		textureImageView = VulkanHelper::createImageView(textureImage,
 		                                                 VkConverter::textureFormatToVK(parameters.format, false),
-		                                                 mipLevels, VK_IMAGE_VIEW_TYPE_2D, VK_IMAGE_ASPECT_COLOR_BIT, 1);
+		                                                 getImageLevels(), VK_IMAGE_VIEW_TYPE_2D, VK_IMAGE_ASPECT_COLOR_BIT, 1);
 
 		auto phyDevice = VulkanDevice::get()->getPhysicalDevice();
 
@@ -461,13 +645,29 @@ namespace maple
 
 		updated = true;
 
-		auto &deletionQueue = VulkanContext::getDeletionQueue();
-
 		if (textureSampler)
 		{
 			auto sampler = textureSampler;
-			deletionQueue.emplace([sampler] { vkDestroySampler(*VulkanDevice::get(), sampler, nullptr); });
+			VulkanContext::getDeletionQueue().emplace([sampler] { vkDestroySampler(*VulkanDevice::get(), sampler, nullptr); });
+		}
+
+		releaseImage();
+	}
+
+	auto VulkanTexture2D::releaseImage() -> void
+	{
+		PROFILE_FUNCTION();
+		auto &deletionQueue = VulkanContext::getDeletionQueue();
+
+		for (auto &view : mipImageViews)
+		{
+			if (view.second)
+			{
+				auto imageView = view.second;
+				deletionQueue.emplace([imageView] { vkDestroyImageView(*VulkanDevice::get(), imageView, nullptr); });
+			}
 		}
+		mipImageViews.clear();
 
 		if (textureImageView)
 		{
@@ -1115,6 +1315,7 @@ namespace maple
 	auto VulkanTexture3D::clear(const CommandBuffer *commandBuffer) -> void
 	{
 		PROFILE_FUNCTION();
+		std::static_pointer_cast<VulkanSwapChain>(Application::getGraphicsContext()->getSwapChain())->trackOwnership(this, static_cast<const VulkanCommandBuffer *>(commandBuffer));
 		VkImageSubresourceRange subresourceRange = {};
 		subresourceRange.baseMipLevel            = 0;
 		subresourceRange.layerCount              = 1;
@@ -15,6 +15,17 @@ namespace maple
 		virtual auto transitionImage(VkImageLayout newLayout, const VulkanCommandBuffer *commandBuffer = nullptr) -> void = 0;
 		virtual auto getImageLayout() const -> VkImageLayout                                                              = 0;
 		virtual auto getImage() const -> VkImage                                                                          = 0;
+
+		//textures which track the layout of every mip report them one by one, the others are in getImageLayout() as a whole
+		virtual auto getLayoutCount() const -> uint32_t
+		{
+			return 1;
+		}
+
+		virtual auto getMipLayout(uint32_t mipLevel) const -> VkImageLayout
+		{
+			return getImageLayout();
+		}
 	};
 
 	class VulkanTexture2D : public Texture2D, public VkTexture
@@ -56,6 +67,16 @@ namespace maple
 			return fileName;
 		}
 
+		inline auto getParameters() const -> TextureParameters override
+		{
+			return parameters;
+		}
+
+		inline auto getLoadOptions() const -> TextureLoadOptions override
+		{
+			return loadOptions;
+		}
+
 		inline auto getType() const -> TextureType override
 		{
 			return TextureType::Color;
@@ -121,9 +142,32 @@ namespace maple
 
 		auto setName(const std::string &name) -> void override;
 
+		inline auto isStreamed() const -> bool override
+		{
+			return !streamLevels.empty();
+		}
+
+		inline auto getResidentMip() const -> uint32_t override
+		{
+			return residentMip;
+		}
+
+		auto setResidentMip(uint32_t mip) -> void override;
+
+		auto reload() -> bool override;
+
 	  private:
 		auto createSampler() -> void;
 		auto deleteSampler() -> void;
+		auto releaseImage() -> void;
+		auto loadStreamed(const uint8_t *pixels, uint32_t levels) -> void;
+		auto createResidentImage() -> void;
+
+		//levels of the vulkan image, the mips above residentMip are not part of it
+		inline auto getImageLevels() const
+		{
+			return mipLevels - residentMip;
+		}
 
 		std::string fileName;
 
@@ -151,6 +195,12 @@ namespace maple
 
 		std::unordered_map<uint32_t, VkImageView> mipImageViews;
 
+		//whole mip chain of a streamed texture, the image is recreated from it when the resident mip changes
+		std::vector<uint8_t>  streamData;
+		std::vector<uint64_t> streamLevels;        //offset of every mip in streamData, empty when not streamed
+		uint32_t              residentMip = 0;
+		uint32_t              tailMip     = 0;        //the mips from here on are always resident
+
 #ifdef USE_VMA_ALLOCATOR
 		VmaAllocation allocation{};
 #endif
@@ -547,6 +597,15 @@ namespace maple
 		{
 			return imageLayouts[0];
 		};
+		//same rule as transitionImage2, a single mip is tracked in imageLayout
+		inline auto getLayoutCount() const -> uint32_t override
+		{
+			return mipLevels > 1 ? mipLevels : 1;
+		}
+		inline auto getMipLayout(uint32_t mipLevel) const -> VkImageLayout override
+		{
+			return mipLevels > 1 ? imageLayouts[mipLevel] : imageLayout;
+		}
 		inline auto getImage() const -> VkImage override
 		{
 			return textureImage;
@@ -0,0 +1,459 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+#include "VulkanUploadManager.h"
+#include "Engine/Profiler.h"
+#include "Others/Console.h"
+#include "VulkanBuffer.h"
+#include "VulkanCommandPool.h"
+#include "VulkanDevice.h"
+#include "VulkanHelper.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace maple
+{
+	namespace
+	{
+		inline auto alignUp(uint64_t value, uint64_t alignment) -> uint64_t
+		{
+			return (value + alignment - 1) / alignment * alignment;
+		}
+
+		inline auto imageBarrier(VkCommandBuffer cmd, VkImage image, uint32_t mipLevels,
+		                         VkImageLayout oldLayout, VkImageLayout newLayout,
+		                         VkAccessFlags srcAccess, VkAccessFlags dstAccess,
+		                         VkPipelineStageFlags srcStage, VkPipelineStageFlags dstStage,
+		                         uint32_t srcQueue = VK_QUEUE_FAMILY_IGNORED, uint32_t dstQueue = VK_QUEUE_FAMILY_IGNORED)
+		{
+			VkImageMemoryBarrier barrier            = VulkanHelper::imageMemoryBarrier();
+			barrier.image                           = image;
+			barrier.oldLayout                       = oldLayout;
+			barrier.newLayout                       = newLayout;
+			barrier.srcAccessMask                   = srcAccess;
+			barrier.dstAccessMask                   = dstAccess;
+			barrier.srcQueueFamilyIndex             = srcQueue;
+			barrier.dstQueueFamilyIndex             = dstQueue;
+			barrier.subresourceRange.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+			barrier.subresourceRange.baseMipLevel   = 0;
+			barrier.subresourceRange.levelCount     = mipLevels;
+			barrier.subresourceRange.baseArrayLayer = 0;
+			barrier.subresourceRange.layerCount     = 1;
+			vkCmdPipelineBarrier(cmd, srcStage, dstStage, 0, 0, nullptr, 0, nullptr, 1, &barrier);
+		}
+
+		inline auto beginCommands(VkCommandBuffer cmd)
+		{
+			VkCommandBufferBeginInfo beginInfo{};
+			beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+			beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+			VK_CHECK_RESULT(vkBeginCommandBuffer(cmd, &beginInfo));
+		}
+	}        // namespace
+
+	VulkanUploadManager::VulkanUploadManager(uint64_t capacity) :
+	    capacity(capacity)
+	{
+		auto  device  = VulkanDevice::get();
+		auto &indices = device->getPhysicalDevice()->getQueueFamilyIndices();
+		auto &limits  = device->getPhysicalDevice()->getProperties().limits;
+
+		dedicated    = device->isDedicatedTransfer();
+		alignment    = std::max<uint64_t>(alignment, limits.optimalBufferCopyOffsetAlignment);
+		transferPool = std::make_shared<VulkanCommandPool>(indices.transferFamily.value(), VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT);
+		if (dedicated)
+			graphicsPool = std::make_shared<VulkanCommandPool>(indices.graphicsFamily.value(), VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT);
+
+		VkBufferCreateInfo bufferInfo = {};
+		bufferInfo.sType              = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO;
+		bufferInfo.size               = capacity;
+		bufferInfo.usage              = VK_BUFFER_USAGE_TRANSFER_SRC_BIT;
+		bufferInfo.sharingMode        = VK_SHARING_MODE_EXCLUSIVE;
+
+#ifdef USE_VMA_ALLOCATOR
+		VmaAllocationCreateInfo vmaCreateInfo = {};
+		vmaCreateInfo.flags                   = VMA_ALLOCATION_CREATE_MAPPED_BIT;
+		vmaCreateInfo.usage                   = VMA_MEMORY_USAGE_CPU_ONLY;
+		vmaCreateInfo.requiredFlags           = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT;
+
+		VmaAllocationInfo allocationInfo{};
+		VK_CHECK_RESULT(vmaCreateBuffer(device->getAllocator(), &bufferInfo, &vmaCreateInfo, &buffer, &allocation, &allocationInfo));
+		mapped = static_cast<uint8_t *>(allocationInfo.pMappedData);
+#else
+		VK_CHECK_RESULT(vkCreateBuffer(*device, &bufferInfo, nullptr, &buffer));
+
+		VkMemoryRequirements memRequirements;
+		vkGetBufferMemoryRequirements(*device, buffer, &memRequirements);
+
+		VkMemoryAllocateInfo allocInfo = {};
+		allocInfo.sType                = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO;
+		allocInfo.allocationSize       = memRequirements.size;
+		allocInfo.memoryTypeIndex      = VulkanHelper::findMemoryType(memRequirements.memoryTypeBits, VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT);
+
+		VK_CHECK_RESULT(vkAllocateMemory(*device, &allocInfo, nullptr, &memory));
+		VK_CHECK_RESULT(vkBindBufferMemory(*device, buffer, memory, 0));
+
+		void *data = nullptr;
+		VK_CHECK_RESULT(vkMapMemory(*device, memory, 0, VK_WHOLE_SIZE, 0, &data));
+		mapped = static_cast<uint8_t *>(data);
+#endif
+		VulkanHelper::setObjectName("UploadRing", (uint64_t) buffer, VK_OBJECT_TYPE_BUFFER);
+		windowStart = Clock::now();
+	}
+
+	VulkanUploadManager::~VulkanUploadManager()
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		submit();
+		while (reclaim(true))
+			;
+
+		auto device = VulkanDevice::get();
+		if (open)
+			freeBatches.emplace_back(std::move(open));
+
+		for (auto &batch : freeBatches)
+		{
+			vkDestroyFence(*device, batch->fence, nullptr);
+			vkDestroySemaphore(*device, batch->semaphore, nullptr);
+		}
+		freeBatches.clear();
+		transferPool.reset();
+		graphicsPool.reset();
+
+#ifdef USE_VMA_ALLOCATOR
+		vmaDestroyBuffer(device->getAllocator(), buffer, allocation);
+#else
+		vkUnmapMemory(*device, memory);
+		vkDestroyBuffer(*device, buffer, nullptr);
+		vkFreeMemory(*device, memory, nullptr);
+#endif
+	}
+
+	auto VulkanUploadManager::uploadImage(const ImageUpload &upload, const void *data, uint64_t size, const std::function<void(VkCommandBuffer)> &finish) -> void
+	{
+		PROFILE_FUNCTION();
+		std::lock_guard<std::mutex> lock(mutex);
+
+		VkBuffer source = buffer;
+		uint64_t offset = 0;
+
+		//larger than the whole ring, staged on its own. the deletion queue keeps it until the frame completed
+		std::unique_ptr<VulkanBuffer> oversized;
+		if (size > capacity)
+		{
+			LOGW("Upload of {0} KB does not fit into the staging ring of {1} KB", size / 1024, capacity / 1024);
+			oversized = std::make_unique<VulkanBuffer>(VK_BUFFER_USAGE_TRANSFER_SRC_BIT, static_cast<uint32_t>(size), data);
+			source    = oversized->getVkBuffer();
+		}
+		else
+		{
+			offset = allocate(size);
+			std::memcpy(mapped + offset, data, size);
+		}
+
+		auto &indices = VulkanDevice::get()->getPhysicalDevice()->getQueueFamilyIndices();
+
+		//the content of an image the graphics queue already owns would need a release there first, those are updated on the graphics queue
+		const bool onTransfer = dedicated && upload.oldLayout == VK_IMAGE_LAYOUT_UNDEFINED;
+		auto       cmd        = onTransfer ? getTransferCmd() : getGraphicsCmd();
+
+		imageBarrier(cmd, upload.image, upload.mipLevels, upload.oldLayout, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+		             onTransfer ? 0 : VK_ACCESS_MEMORY_WRITE_BIT, VK_ACCESS_TRANSFER_WRITE_BIT,
+		             onTransfer ? VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT : VK_PIPELINE_STAGE_ALL_COMMANDS_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT);
+
+		std::vector<VkBufferImageCopy> regions(upload.levels);
+		for (uint32_t level = 0; level < upload.levels; level++)
+		{
+			const auto width  = std::max(upload.width >> level, 1u);
+			const auto height = std::max(upload.height >> level, 1u);
+			const auto depth  = std::max(upload.depth >> level, 1u);
+			const auto bytes  = upload.blockSize != 0 ? uint64_t((width + 3) / 4) * ((height + 3) / 4) * depth * upload.blockSize :
+			                                            uint64_t(width) * height * depth * upload.texelSize;
+
+			auto &region                           = regions[level];
+			region.bufferOffset                    = offset;
+			region.imageSubresource.aspectMask     = VK_IMAGE_ASPECT_COLOR_BIT;
+			region.imageSubresource.mipLevel       = level;
+			region.imageSubresource.baseArrayLayer = 0;
+			region.imageSubresource.layerCount     = 1;
+			region.imageOffset                     = {upload.offsetX, upload.offsetY, upload.offsetZ};
+			region.imageExtent                     = {width, height, depth};
+			offset                                 = alignUp(offset + bytes, 4);
+		}
+		vkCmdCopyBufferToImage(cmd, source, upload.image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, upload.levels, regions.data());
+
+		auto graphicsCmd = getGraphicsCmd();
+		if (onTransfer)
+		{
+			//release on the transfer queue, acquire on the graphics queue once the semaphore of the batch signaled
+			imageBarrier(cmd, upload.image, upload.mipLevels, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+			             VK_ACCESS_TRANSFER_WRITE_BIT, 0,
+			             VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT,
+			             indices.transferFamily.value(), indices.graphicsFamily.value());
+			imageBarrier(graphicsCmd, upload.image, upload.mipLevels, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+			             0, VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT,
+			             VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT,
+			             indices.transferFamily.value(), indices.graphicsFamily.value());
+		}
+
+		if (finish)
+			finish(graphicsCmd);
+
+		if (upload.newLayout != VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL)
+		{
+			imageBarrier(graphicsCmd, upload.image, upload.mipLevels, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, upload.newLayout,
+			             VK_ACCESS_TRANSFER_WRITE_BIT, VK_ACCESS_MEMORY_READ_BIT,
+			             VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_ALL_COMMANDS_BIT);
+		}
+
+		getOpen()->bytes += size;
+		frameBytes += size;
+		stats.totalBytes += size;
+	}
+
+	auto VulkanUploadManager::record(const std::function<void(VkCommandBuffer)> &task) -> void
+	{
+		std::lock_guard<std::mutex> lock(mutex);
+		task(getGraphicsCmd());
+	}
+
+	auto VulkanUploadManager::flush() -> void
+	{
+		PROFILE_FUNCTION();
+		std::lock_guard<std::mutex> lock(mutex);
+		submit();
+	}
+
+	auto VulkanUploadManager::beginFrame() -> void
+	{
+		PROFILE_FUNCTION();
+		std::lock_guard<std::mutex> lock(mutex);
+		reclaim(false);
+
+		stats.frameBytes   = frameBytes;
+		stats.frameBatches = frameBatches;
+		stats.ringUsage    = used;
+		frameBytes         = 0;
+		frameBatches       = 0;
+
+		const auto now     = Clock::now();
+		const auto elapsed = std::chrono::duration<float>(now - windowStart).count();
+		if (elapsed >= 1.f)
+		{
+			stats.bandwidth  = windowBytes / (1024.f * 1024.f) / elapsed;
+			stats.maxLatency = windowMax;
+			windowBytes      = 0;
+			windowMax        = 0;
+			windowStart      = now;
+		}
+	}
+
+	auto VulkanUploadManager::allocate(uint64_t size) -> uint64_t
+	{
+		reclaim(false);
+		for (;;)
+		{
+			if (used == 0)
+				head = tail = 0;
+
+			auto offset = alignUp(head, alignment);
+			auto end    = uint64_t(0);
+			auto fits   = false;
+
+			if (used == 0 || head > tail)
+			{
+				//free are [head, capacity) and [0, tail), the end of the ring is skipped when wrapping
+				if (offset + size <= capacity)
+				{
+					end  = offset + size;
+					fits = true;
+				}
+				else if (size <= tail)
+				{
+					offset = 0;
+					end    = size;
+					fits   = true;
+				}
+			}
+			else if (head < tail && offset + size <= tail)
+			{
+				end  = offset + size;
+				fits = true;
+			}
+
+			if (fits)
+			{
+				const auto consumed = end > head ? end - head : capacity - head + end;
+				head                = end;
+				used += consumed;
+				stats.peakRingUsage = std::max(stats.peakRingUsage, used);
+
+				auto batch = getOpen();
+				batch->ringBytes += consumed;
+				batch->ringEnd = head;
+				return offset;
+			}
+
+			//the ring is full of data the gpu did not read yet, submit what is pending and wait for the oldest batch
+			if (open && open->ringBytes > 0)
+				submit();
+			reclaim(true);
+		}
+	}
+
+	auto VulkanUploadManager::getOpen() -> Batch *
+	{
+		if (open == nullptr)
+			open = acquireBatch();
+		return open.get();
+	}
+
+	auto VulkanUploadManager::getTransferCmd() -> VkCommandBuffer
+	{
+		auto batch = getOpen();
+		if (!batch->transferRecorded)
+		{
+			beginCommands(batch->transferCmd);
+			batch->transferRecorded = true;
+		}
+		return batch->transferCmd;
+	}
+
+	auto VulkanUploadManager::getGraphicsCmd() -> VkCommandBuffer
+	{
+		//without a transfer only family both sides are recorded into one command buffer on the graphics queue
+		if (!dedicated)
+			return getTransferCmd();
+
+		auto batch = getOpen();
+		if (!batch->graphicsRecorded)
+		{
+			beginCommands(batch->graphicsCmd);
+			batch->graphicsRecorded = true;
+		}
+		return batch->graphicsCmd;
+	}
+
+	auto VulkanUploadManager::acquireBatch() -> std::unique_ptr<Batch>
+	{
+		if (!freeBatches.empty())
+		{
+			auto batch = std::move(freeBatches.back());
+			freeBatches.pop_back();
+			return batch;
+		}
+
+		auto device = VulkanDevice::get();
+		auto batch  = std::make_unique<Batch>();
+
+		VkCommandBufferAllocateInfo allocInfo{};
+		allocInfo.sType              = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
+		allocInfo.level              = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
+		allocInfo.commandPool        = *transferPool;
+		allocInfo.commandBufferCount = 1;
+		VK_CHECK_RESULT(vkAllocateCommandBuffers(*device, &allocInfo, &batch->transferCmd));
+
+		if (dedicated)
+		{
+			allocInfo.commandPool = *graphicsPool;
+			VK_CHECK_RESULT(vkAllocateCommandBuffers(*device, &allocInfo, &batch->graphicsCmd));
+		}
+
+		VkFenceCreateInfo fenceInfo{};
+		fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
+		VK_CHECK_RESULT(vkCreateFence(*device, &fenceInfo, nullptr, &batch->fence));
+
+		VkSemaphoreCreateInfo semaphoreInfo{};
+		semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+		VK_CHECK_RESULT(vkCreateSemaphore(*device, &semaphoreInfo, nullptr, &batch->semaphore));
+		return batch;
+	}
+
+	auto VulkanUploadManager::submit() -> void
+	{
+		if (open == nullptr || (!open->transferRecorded && !open->graphicsRecorded))
+			return;
+
+		PROFILE_FUNCTION();
+		//every copy on the transfer queue has its acquire on the graphics side
+		if (dedicated)
+			getGraphicsCmd();
+
+		auto device = VulkanDevice::get();
+		auto batch  = std::move(open);
+
+		VkSubmitInfo submitInfo{};
+		submitInfo.sType              = VK_STRUCTURE_TYPE_SUBMIT_INFO;
+		submitInfo.commandBufferCount = 1;
+
+		if (!dedicated)
+		{
+			VK_CHECK_RESULT(vkEndCommandBuffer(batch->transferCmd));
+			submitInfo.pCommandBuffers = &batch->transferCmd;
+			VK_CHECK_RESULT(vkQueueSubmit(device->getGraphicsQueue(), 1, &submitInfo, batch->fence));
+		}
+		else
+		{
+			if (batch->transferRecorded)
+			{
+				VK_CHECK_RESULT(vkEndCommandBuffer(batch->transferCmd));
+				submitInfo.pCommandBuffers      = &batch->transferCmd;
+				submitInfo.signalSemaphoreCount = 1;
+				submitInfo.pSignalSemaphores    = &batch->semaphore;
+				VK_CHECK_RESULT(vkQueueSubmit(device->getTransferQueue(), 1, &submitInfo, VK_NULL_HANDLE));
+			}
+
+			const VkPipelineStageFlags waitStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
+			VK_CHECK_RESULT(vkEndCommandBuffer(batch->graphicsCmd));
+			submitInfo.pCommandBuffers      = &batch->graphicsCmd;
+			submitInfo.signalSemaphoreCount = 0;
+			submitInfo.pSignalSemaphores    = nullptr;
+			submitInfo.waitSemaphoreCount   = batch->transferRecorded ? 1 : 0;
+			submitInfo.pWaitSemaphores      = &batch->semaphore;
+			submitInfo.pWaitDstStageMask    = &waitStage;
+			VK_CHECK_RESULT(vkQueueSubmit(device->getGraphicsQueue(), 1, &submitInfo, batch->fence));
+		}
+
+		batch->submitTime = Clock::now();
+		frameBatches++;
+		inFlight.emplace_back(std::move(batch));
+	}
+
+	auto VulkanUploadManager::reclaim(bool wait) -> bool
+	{
+		auto device    = VulkanDevice::get();
+		auto reclaimed = false;
+		while (!inFlight.empty())
+		{
+			auto &batch = inFlight.front();
+			if (wait && !reclaimed)
+				VK_CHECK_RESULT(vkWaitForFences(*device, 1, &batch->fence, VK_TRUE, UINT64_MAX));
+			else if (vkGetFenceStatus(*device, batch->fence) != VK_SUCCESS)
+				break;
+
+			//only seen at the next poll, so this is an upper bound of the gpu time
+			const auto latency = std::chrono::duration<float, std::milli>(Clock::now() - batch->submitTime).count();
+			stats.latency      = stats.latency == 0 ? latency : stats.latency * 0.9f + latency * 0.1f;
+			windowMax          = std::max(windowMax, latency);
+			windowBytes += batch->bytes;
+
+			if (batch->ringBytes > 0)
+			{
+				tail = batch->ringEnd;
+				used -= batch->ringBytes;
+			}
+
+			VK_CHECK_RESULT(vkResetFences(*device, 1, &batch->fence));
+			batch->transferRecorded = false;
+			batch->graphicsRecorded = false;
+			batch->ringBytes        = 0;
+			batch->bytes            = 0;
+			freeBatches.emplace_back(std::move(batch));
+			inFlight.erase(inFlight.begin());
+			reclaimed = true;
+		}
+		return reclaimed;
+	}
+}        // namespace maple
@@ -0,0 +1,143 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "Engine/Core.h"
+#include "Vk.h"
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace maple
+{
+	class VulkanCommandPool;
+
+	/**
+	 * Streams resource data to the gpu without stalling the graphics queue.
+	 * Data is copied into a persistently mapped staging ring and the copies of a frame are recorded into one batch,
+	 * which the swap chain submits right before the frame. The copies run on the transfer queue, the work which needs
+	 * the graphics queue (ownership acquire, mip generation, final layouts) runs in a second command buffer waiting
+	 * on the semaphore of the batch. A fence per batch tells when its range of the ring can be reused.
+	 */
+	class VulkanUploadManager
+	{
+	  public:
+		struct ImageUpload
+		{
+			VkImage       image     = VK_NULL_HANDLE;
+			VkFormat      format    = VK_FORMAT_UNDEFINED;
+			VkImageLayout oldLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+			VkImageLayout newLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+			uint32_t      mipLevels = 1;        //of the image, the data is copied into the first levels
+			uint32_t      levels    = 1;        //mips in the data, one after another with each level starting 4 byte aligned
+			uint32_t      texelSize = 4;        //bytes per pixel, only needed for more than one level
+			uint32_t      blockSize = 0;        //bytes per 4x4 block of a compressed format, used instead of texelSize
+			uint32_t      width     = 0;
+			uint32_t      height    = 0;
+			uint32_t      depth     = 1;
+			int32_t       offsetX   = 0;
+			int32_t       offsetY   = 0;
+			int32_t       offsetZ   = 0;
+		};
+
+		struct Stats
+		{
+			uint64_t frameBytes    = 0;        //staged during the last frame
+			uint32_t frameBatches  = 0;
+			uint64_t totalBytes    = 0;
+			uint64_t ringUsage     = 0;
+			uint64_t peakRingUsage = 0;
+			float    bandwidth     = 0;        //MB/s of the uploads completed during the last second
+			float    latency       = 0;        //ms from the submit until the fence was seen signaled, averaged
+			float    maxLatency    = 0;
+		};
+
+		VulkanUploadManager(uint64_t capacity);
+		~VulkanUploadManager();
+		NO_COPYABLE(VulkanUploadManager);
+
+		/**
+		 * thread safe. the image is in TRANSFER_DST_OPTIMAL when finish runs on the graphics queue, afterwards it is moved to newLayout.
+		 * the commands run before the next frame in submission order, so the image can be used by it right away.
+		 */
+		auto uploadImage(const ImageUpload &upload, const void *data, uint64_t size, const std::function<void(VkCommandBuffer)> &finish = {}) -> void;
+
+		//thread safe. records work into the graphics command buffer of the open batch
+		auto record(const std::function<void(VkCommandBuffer)> &task) -> void;
+
+		//submits the open batch, called by the swap chain before the frame and before any other submit which may read the uploads
+		auto flush() -> void;
+
+		//recycles the batches which completed and rolls the stats over
+		auto beginFrame() -> void;
+
+		inline auto getStats() const
+		{
+			return stats;
+		}
+
+		inline auto getCapacity() const
+		{
+			return capacity;
+		}
+
+	  private:
+		using Clock = std::chrono::steady_clock;
+
+		struct Batch
+		{
+			VkCommandBuffer   transferCmd      = VK_NULL_HANDLE;
+			VkCommandBuffer   graphicsCmd      = VK_NULL_HANDLE;
+			VkFence           fence            = VK_NULL_HANDLE;
+			VkSemaphore       semaphore        = VK_NULL_HANDLE;
+			bool              transferRecorded = false;
+			bool              graphicsRecorded = false;
+			uint64_t          ringEnd          = 0;
+			uint64_t          ringBytes        = 0;
+			uint64_t          bytes            = 0;
+			Clock::time_point submitTime;
+		};
+
+		auto allocate(uint64_t size) -> uint64_t;
+		auto getOpen() -> Batch *;
+		auto getTransferCmd() -> VkCommandBuffer;
+		auto getGraphicsCmd() -> VkCommandBuffer;
+		auto acquireBatch() -> std::unique_ptr<Batch>;
+		auto submit() -> void;
+		auto reclaim(bool wait) -> bool;
+
+		std::mutex mutex;
+
+		std::shared_ptr<VulkanCommandPool>  transferPool;
+		std::shared_ptr<VulkanCommandPool>  graphicsPool;
+		std::unique_ptr<Batch>              open;
+		std::vector<std::unique_ptr<Batch>> inFlight;        //in submission order
+		std::vector<std::unique_ptr<Batch>> freeBatches;
+
+		VkBuffer buffer = VK_NULL_HANDLE;
+		uint8_t *mapped = nullptr;
+#ifdef USE_VMA_ALLOCATOR
+		VmaAllocation allocation = nullptr;
+#else
+		VkDeviceMemory memory = VK_NULL_HANDLE;
+#endif
+
+		uint64_t capacity  = 0;
+		uint64_t head      = 0;
+		uint64_t tail      = 0;
+		uint64_t used      = 0;
+		uint64_t alignment = 16;
+		bool     dedicated = false;
+
+		Stats             stats;
+		uint64_t          frameBytes   = 0;
+		uint32_t          frameBatches = 0;
+		uint64_t          windowBytes  = 0;
+		float             windowMax    = 0;
+		Clock::time_point windowStart;
+	};
+}        // namespace maple
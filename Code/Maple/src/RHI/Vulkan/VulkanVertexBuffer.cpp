@@ -8,9 +8,12 @@
 #include "VulkanDevice.h"
 #include "VulkanPipeline.h"
 
+#include <cstring>
+
 namespace maple
 {
-	VulkanVertexBuffer::VulkanVertexBuffer(const BufferUsage &usage)
+	VulkanVertexBuffer::VulkanVertexBuffer(const BufferUsage &usage) :
+	    bufferUsage(usage)
 	{
 		auto flags = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_SHADER_DEVICE_ADDRESS_BIT;
 
@@ -36,7 +39,12 @@ namespace maple
 	auto VulkanVertexBuffer::resize(uint32_t size) -> void
 	{
 		PROFILE_FUNCTION();
-		if (this->size != size)
+		if (bufferUsage == BufferUsage::Stream)
+		{
+			//only the size reserved by the next getPointer
+			this->size = size;
+		}
+		else if (this->size != size)
 		{
 			VulkanBuffer::resize(size, nullptr);
 		}
@@ -45,7 +53,14 @@ namespace maple
 	auto VulkanVertexBuffer::setData(uint32_t size, const void *data) -> void
 	{
 		PROFILE_FUNCTION();
-		if (size != this->size)
+		if (bufferUsage == BufferUsage::Stream)
+		{
+			this->size = size;
+			allocateTransient();
+			if (data != nullptr)
+				std::memcpy(transient.mapped, data, size);
+		}
+		else if (size != this->size)
 		{
 			VulkanBuffer::resize(size, data);
 		}
@@ -58,7 +73,11 @@ namespace maple
 	auto VulkanVertexBuffer::setDataSub(uint32_t size, const void *data, uint32_t offset) -> void
 	{
 		PROFILE_FUNCTION();
-		if (size != this->size)
+		if (bufferUsage == BufferUsage::Stream)
+		{
+			setData(size, data);
+		}
+		else if (size != this->size)
 		{
 			VulkanBuffer::resize(size, data);
 		}
@@ -79,12 +98,24 @@ namespace maple
 		}
 	}
 
-	auto VulkanVertexBuffer::bind(const CommandBuffer *commandBuffer, Pipeline *pipeline) -> void
+	auto VulkanVertexBuffer::bind(const CommandBuffer *commandBuffer, Pipeline *pipeline, uint32_t binding) -> void
 	{
 		PROFILE_FUNCTION();
+		if (bufferUsage == BufferUsage::Stream)
+		{
+			//nothing was written in this frame yet
+			if (transient.buffer == VK_NULL_HANDLE || transientFrame != VulkanContext::getFrameAllocator()->getFrameCounter())
+				return;
+
+			VkDeviceSize offsets[1] = {transient.offset};
+			if (commandBuffer)
+				vkCmdBindVertexBuffers(static_cast<const VulkanCommandBuffer *>(commandBuffer)->getCommandBuffer(), binding, 1, &transient.buffer, offsets);
+			return;
+		}
+
 		VkDeviceSize offsets[1] = {0};
 		if (commandBuffer)
-			vkCmdBindVertexBuffers(static_cast<const VulkanCommandBuffer *>(commandBuffer)->getCommandBuffer(), 0, 1, &buffer, offsets);
+			vkCmdBindVertexBuffers(static_cast<const VulkanCommandBuffer *>(commandBuffer)->getCommandBuffer(), binding, 1, &buffer, offsets);
 	}
 
 	auto VulkanVertexBuffer::unbind() -> void
@@ -94,6 +125,13 @@ namespace maple
 	auto VulkanVertexBuffer::getPointerInternal() -> void *
 	{
 		PROFILE_FUNCTION();
+		if (bufferUsage == BufferUsage::Stream)
+		{
+			//a new slice every time, batches recorded before keep reading their own vertices
+			allocateTransient();
+			return transient.mapped;
+		}
+
 		if (!mappedBuffer)
 		{
 			VulkanBuffer::map();
@@ -102,4 +140,11 @@ namespace maple
 		return mapped;
 	}
 
+	auto VulkanVertexBuffer::allocateTransient() -> void
+	{
+		auto allocator = VulkanContext::getFrameAllocator();
+		transient      = allocator->allocate(static_cast<uint32_t>(size));
+		transientFrame = allocator->getFrameCounter();
+	}
+
 };        // namespace maple
@@ -6,6 +6,7 @@
 #pragma once
 #include "RHI/VertexBuffer.h"
 #include "VulkanBuffer.h"
+#include "VulkanFrameAllocator.h"
 #include <memory>
 
 namespace maple
@@ -17,7 +18,7 @@ namespace maple
 		VulkanVertexBuffer(const void *data, uint32_t size);
 		~VulkanVertexBuffer();
 
-		auto bind(const CommandBuffer *commandBuffer, Pipeline *pipeline) -> void override;
+		auto bind(const CommandBuffer *commandBuffer, Pipeline *pipeline, uint32_t binding = 0) -> void override;
 		auto resize(uint32_t size) -> void override;
 		auto setData(uint32_t size, const void *data) -> void override;
 		auto setDataSub(uint32_t size, const void *data, uint32_t offset) -> void override;
@@ -34,7 +35,13 @@ namespace maple
 			return getDeviceAddress();
 		};
 	  protected:
+		//BufferUsage::Stream, the vertices are written into the frame allocator and only live for the current frame
+		auto allocateTransient() -> void;
+
 		bool        mappedBuffer = false;
 		BufferUsage bufferUsage  = BufferUsage::Static;
+
+		VulkanFrameAllocator::Allocation transient;
+		uint64_t                         transientFrame = 0;
 	};
 };        // namespace maple
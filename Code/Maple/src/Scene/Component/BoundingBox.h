@@ -3,7 +3,10 @@
 //////////////////////////////////////////////////////////////////////////////
 #pragma once
 #include "Math/BoundingBox.h"
+#include "Math/DynamicBVH.h"
+#include <entt/entt.hpp>
 #include <glm/glm.hpp>
+#include <vector>
 
 namespace maple
 {
@@ -14,4 +17,19 @@ namespace maple
 			BoundingBox *box;
 		};
 	}        // namespace component
+
+	namespace global::component
+	{
+		/**
+		 * World space bounds of every MeshRenderer, kept in the registry context.
+		 * userData of every leaf is the entity.
+		 */
+		struct SceneBVH
+		{
+			DynamicBVH                tree;
+			std::vector<int32_t>      proxies;        //entity id -> proxy
+			std::vector<BoundingBox>  bounds;         //entity id -> exact world box
+			std::vector<entt::entity> pending;        //new entities or entities waiting for their mesh
+		};
+	}        // namespace global::component
 };           // namespace maple
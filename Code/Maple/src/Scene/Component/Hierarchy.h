@@ -4,11 +4,15 @@
 
 #pragma once
 #include <entt/entt.hpp>
+#include <utility>
+#include <vector>
 
 namespace maple
 {
 	namespace component
 	{
+		class Transform;
+
 		struct Hierarchy
 		{
 			entt::entity parent = entt::null;
@@ -17,4 +21,28 @@ namespace maple
 			entt::entity prev   = entt::null;
 		};
 	}        // namespace component
+
+	namespace global::component
+	{
+		/**
+		 * Flattened hierarchy kept in the registry context.
+		 * Every parent is stored before its children and every root owns a contiguous range,
+		 * so world matrices are computed with one linear pass and roots can be processed in parallel.
+		 */
+		struct HierarchyCache
+		{
+			std::vector<entt::entity>                  entities;
+			std::vector<int32_t>                       parents;        //index of the parent, -1 for roots
+			std::vector<uint32_t>                      depths;
+			std::vector<std::pair<uint32_t, uint32_t>> ranges;         //[begin, end) of every root
+			std::vector<int32_t>                       indices;        //entity id -> index in entities
+
+			//per frame scratch
+			std::vector<maple::component::Transform *> transforms;
+			std::vector<uint8_t>                       updated;
+
+			uint32_t removed = 0;
+			bool     dirty   = true;
+		};
+	}        // namespace global::component
 };           // namespace maple
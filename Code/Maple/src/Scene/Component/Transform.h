@@ -4,6 +4,7 @@
 #pragma once
 
 #include "Engine/Core.h"
+#include <cereal/cereal.hpp>
 #include <entt/entt.hpp>
 #include <glm/glm.hpp>
 #include <glm/gtc/quaternion.hpp>
@@ -109,13 +110,13 @@ namespace maple
 			template <typename Archive>
 			inline auto save(Archive &archive) const -> void
 			{
-				archive(cereal::make_nvp("Position", localPosition), cereal::make_nvp("Rotation", localOrientation), cereal::make_nvp("Scale", localScale), cereal::make_nvp("Id", entity));
+				archive(cereal::make_nvp("Position", localPosition), cereal::make_nvp("Rotation", localOrientation), cereal::make_nvp("Scale", localScale));
 			}
 
 			template <typename Archive>
 			inline auto load(Archive &archive) -> void
 			{
-				archive(cereal::make_nvp("Position", localPosition), cereal::make_nvp("Rotation", localOrientation), cereal::make_nvp("Scale", localScale), cereal::make_nvp("Id", entity));
+				archive(cereal::make_nvp("Position", localPosition), cereal::make_nvp("Rotation", localOrientation), cereal::make_nvp("Scale", localScale));
 				dirty                = true;
 				initLocalPosition    = localPosition;
 				initLocalScale       = localScale;
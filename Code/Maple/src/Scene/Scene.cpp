@@ -219,11 +219,28 @@ namespace maple
 	auto Scene::addMesh(const std::string &file) -> Entity
 	{
 		PROFILE_FUNCTION();
-		auto name        = StringUtils::getFileNameWithoutExtension(file);
-		auto modelEntity = createEntity(name);
-
 		std::vector<std::shared_ptr<IResource>> resources;
 		Loader::load(file, resources);
+		return addModel(file, resources);
+	}
+
+	auto Scene::addMeshAsync(const std::string &file, const std::function<void(Entity)> &loaded, const std::function<void(float)> &progress) -> std::shared_ptr<LoadHandle>
+	{
+		PROFILE_FUNCTION();
+		return Application::getAssetsLoaderFactory()->loadAsync(
+		    file, [this, file, loaded](const LoadHandle &handle) {
+			    auto modelEntity = addModel(file, handle.getResources());
+			    if (loaded)
+				    loaded(modelEntity);
+		    },
+		    progress);
+	}
+
+	auto Scene::addModel(const std::string &file, const std::vector<std::shared_ptr<IResource>> &resources) -> Entity
+	{
+		PROFILE_FUNCTION();
+		auto name        = StringUtils::getFileNameWithoutExtension(file);
+		auto modelEntity = createEntity(name);
 
 		bool hasSkeleton = std::find_if(resources.begin(), resources.end(), [](auto &res) {
 			                   return res->getResourceType() == FileType::Skeleton;
@@ -9,12 +9,15 @@
 #include <functional>
 #include <memory>
 #include <string>
+#include <vector>
 
 namespace maple
 {
 	class Entity;
 	class Camera;
 	class ExecutePoint;
+	class IResource;
+	class LoadHandle;
 
 	namespace component
 	{
@@ -108,10 +111,13 @@ namespace maple
 		auto onMeshRenderCreated() -> void;
 
 		auto addMesh(const std::string &file) -> Entity;
+		//the model entity is created on the main thread once the import on the job system is done
+		auto addMeshAsync(const std::string &file, const std::function<void(Entity)> &loaded = nullptr, const std::function<void(float)> &progress = nullptr) -> std::shared_ptr<LoadHandle>;
 		auto create() -> Entity;
 		auto create(const std::string &name) -> Entity;
 
 	  protected:
+		auto addModel(const std::string &file, const std::vector<std::shared_ptr<IResource>> &resources) -> Entity;
 		auto updateCameraController(float dt) -> void;
 		auto copyComponents(const Entity &from, const Entity &to) -> void;
 
@@ -5,9 +5,210 @@
 #include "ExecutePoint.h"
 #include "Scene/Component/Component.h"
 #include "Scene/Entity/Entity.h"
+#include "Thread/JobSystem.h"
+
+#include <atomic>
+#include <mutex>
 
 namespace maple
 {
+	namespace system_scheduler
+	{
+		namespace
+		{
+			inline auto isExclusive(const ExecuteQueue &queue, uint32_t index)
+			{
+				return index >= queue.access.size() || queue.access[index].exclusive;
+			}
+		}        // namespace
+
+		auto compile(ExecuteQueue &queue) -> void
+		{
+			PROFILE_FUNCTION();
+			auto &     schedule = queue.schedule;
+			const auto count    = static_cast<uint32_t>(queue.jobs.size());
+
+			schedule.successors.assign(count, {});
+			schedule.dependencies.assign(count, 0);
+			schedule.levels.assign(count, 0);
+			schedule.roots.clear();
+
+			auto conflict = [&](uint32_t i, uint32_t j) {
+				if (i >= queue.access.size() || j >= queue.access.size())
+					return true;
+				return queue.access[i].conflictWith(queue.access[j]);
+			};
+
+			for (uint32_t j = 0; j < count; j++)
+			{
+				for (uint32_t i = 0; i < j; i++)
+				{
+					if (conflict(i, j))
+					{
+						schedule.successors[i].emplace_back(j);
+						schedule.dependencies[j]++;
+						schedule.levels[j] = std::max(schedule.levels[j], schedule.levels[i] + 1);
+					}
+				}
+				if (schedule.dependencies[j] == 0)
+				{
+					schedule.roots.emplace_back(j);
+				}
+			}
+			schedule.compiledJobs = count;
+			schedule.warmedUp     = false;
+		}
+
+		auto execute(ExecuteQueue &queue, entt::registry &registry, JobSystem *jobSystem) -> void
+		{
+			auto &schedule = queue.schedule;
+			if (schedule.compiledJobs != queue.jobs.size())
+			{
+				compile(queue);
+			}
+
+			//the first run of a queue is always serial, entt creates pools and groups lazily and that is not thread-safe.
+			if (!queue.parallel || jobSystem == nullptr || !schedule.warmedUp || queue.jobs.size() < 2)
+			{
+				for (auto &func : queue.jobs)
+				{
+					func(registry);
+				}
+				schedule.warmedUp = true;
+				return;
+			}
+
+			PROFILE_SCOPE(queue.name.c_str());
+			const auto                               count = queue.jobs.size();
+			std::unique_ptr<std::atomic<uint32_t>[]> remaining(new std::atomic<uint32_t>[count]);
+			for (size_t i = 0; i < count; i++)
+			{
+				remaining[i].store(schedule.dependencies[i], std::memory_order_relaxed);
+			}
+
+			//exclusive systems (scripts, world access) stay on this thread, the others go to the workers
+			auto                          counter = std::make_shared<JobCounter>();
+			std::mutex                    inlineMutex;
+			std::vector<uint32_t>         inlineJobs;
+			std::function<void(uint32_t)> run;
+
+			auto release = [&](uint32_t index) {
+				if (isExclusive(queue, index))
+				{
+					std::lock_guard<std::mutex> lock(inlineMutex);
+					inlineJobs.emplace_back(index);
+				}
+				else
+				{
+					jobSystem->execute([&run, index]() { run(index); }, counter);
+				}
+			};
+
+			run = [&](uint32_t index) {
+				queue.jobs[index](registry);
+				for (auto next : schedule.successors[index])
+				{
+					if (remaining[next].fetch_sub(1, std::memory_order_acq_rel) == 1)
+					{
+						release(next);
+					}
+				}
+			};
+
+			for (auto root : schedule.roots)
+			{
+				release(root);
+			}
+
+			//a system is released before the job releasing it finishes, so nothing is left once both are empty
+			while (true)
+			{
+				jobSystem->wait(counter);
+				uint32_t index;
+				{
+					std::lock_guard<std::mutex> lock(inlineMutex);
+					if (inlineJobs.empty())
+						break;
+					index = inlineJobs.back();
+					inlineJobs.pop_back();
+				}
+				run(index);
+			}
+		}
+
+		auto dump(ExecuteQueue &queue) -> std::string
+		{
+			auto &schedule = queue.schedule;
+			if (schedule.compiledJobs != queue.jobs.size())
+			{
+				compile(queue);
+			}
+
+			auto join = [](const std::vector<SystemAccess::Component> &list) {
+				std::string str;
+				for (auto &comp : list)
+				{
+					if (!str.empty())
+						str += ", ";
+					str += comp.name;
+				}
+				return str;
+			};
+
+			uint32_t maxLevel = 0;
+			for (auto level : schedule.levels)
+				maxLevel = std::max(maxLevel, level);
+
+			std::string str = "[" + queue.name + "] " + (queue.parallel ? "parallel" : "serial") + ", " +
+			                  std::to_string(queue.jobs.size()) + " systems, " + std::to_string(queue.jobs.empty() ? 0 : maxLevel + 1) + " levels\n";
+
+			for (uint32_t level = 0; level <= maxLevel && !queue.jobs.empty(); level++)
+			{
+				for (uint32_t i = 0; i < queue.jobs.size(); i++)
+				{
+					if (schedule.levels[i] != level)
+						continue;
+
+					const auto &name = i < queue.systemNames.size() && !queue.systemNames[i].empty() ? queue.systemNames[i] : std::string("<anonymous job>");
+					str += "  L" + std::to_string(level) + " #" + std::to_string(i) + " " + name;
+
+					if (isExclusive(queue, i))
+					{
+						str += " exclusive";
+					}
+					else
+					{
+						str += " W{" + join(queue.access[i].writes) + "} R{" + join(queue.access[i].reads) + "}";
+					}
+
+					if (!schedule.successors[i].empty())
+					{
+						str += " ->";
+						for (auto next : schedule.successors[i])
+							str += " #" + std::to_string(next);
+					}
+					str += "\n";
+				}
+			}
+			return str;
+		}
+	}        // namespace system_scheduler
+
+	auto ExecutePoint::dumpSchedule() -> std::string
+	{
+		std::string str;
+		for (auto queue : {&gameStartQueue, &gameEndedQueue, &factoryQueue, &updateQueue, &imGuiQueue})
+		{
+			str += system_scheduler::dump(*queue);
+		}
+		for (auto queue : graph)
+		{
+			str += system_scheduler::dump(*queue);
+		}
+		str += system_scheduler::dump(frameEndQueue);
+		return str;
+	}
+
 	auto ExecutePoint::clear() -> void
 	{
 		registry.each([&](auto entity) {
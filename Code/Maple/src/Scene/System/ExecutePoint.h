@@ -7,32 +7,70 @@
 #include "Engine/Profiler.h"
 
 #include <Scene/Entity/Entity.h>
+#include <Scene/System/SystemAccess.h>
 #include <ecs/SystemAssembler.h>
 #include <ecs/TypeList.h>
 #include <ecs/World.h>
 
 namespace maple
 {
+	class JobSystem;
+
 	struct ExecuteQueue
 	{
-		ExecuteQueue(const std::string &name) :
-		    name(name){};
+		ExecuteQueue(const std::string &name, bool parallel = false) :
+		    name(name), parallel(parallel){};
 		std::string                                        name;
 		std::vector<std::function<void(entt::registry &)>> jobs;
 		std::function<void(ecs::World)>                    preCall  = [](ecs::World) {};
 		std::function<void(ecs::World)>                    postCall = [](ecs::World) {};
+
+		//systems without access (jobs pushed directly) are scheduled exclusively
+		std::vector<SystemAccess> access;
+		std::vector<std::string>  systemNames;
+
+		//run non-conflicting systems concurrently on the job system.
+		bool parallel = false;
+
+		struct Schedule
+		{
+			std::vector<std::vector<uint32_t>> successors;
+			std::vector<uint32_t>              dependencies;
+			std::vector<uint32_t>              levels;
+			std::vector<uint32_t>              roots;
+			size_t                             compiledJobs = 0;
+			bool                               warmedUp     = false;
+		} schedule;
+
+		inline auto clear()
+		{
+			jobs.clear();
+			access.clear();
+			systemNames.clear();
+			schedule = {};
+		}
 	};
 
+	namespace system_scheduler
+	{
+		//build the dependency DAG from the access of every system, a system depends on every earlier system it conflicts with.
+		auto MAPLE_EXPORT compile(ExecuteQueue &queue) -> void;
+
+		auto MAPLE_EXPORT execute(ExecuteQueue &queue, entt::registry &registry, JobSystem *jobSystem) -> void;
+
+		auto MAPLE_EXPORT dump(ExecuteQueue &queue) -> std::string;
+	}        // namespace system_scheduler
+
 	class MAPLE_EXPORT ExecutePoint
 	{
 	  public:
 		inline ExecutePoint() :
 		    gameStartQueue("GameStart"),
 		    gameEndedQueue("GameEnded"),
-		    updateQueue("Update"),
+		    updateQueue("Update", true),
 		    imGuiQueue("ImGui"),
 		    factoryQueue("Factory"),
-		    frameEndQueue("FrmeEnd")
+		    frameEndQueue("FrmeEnd", true)
 		{
 			globalEntity = create("global");
 		};
@@ -53,46 +91,46 @@ namespace maple
 			});
 		}
 
-		template <auto System>
+		template <auto System, typename... Access>
 		inline auto registerFactorySystem() -> void
 		{
-			expand(ecs::SystemFunction<System>{}, factoryQueue);
+			expand<System, Access...>(ecs::SystemFunction<System>{}, factoryQueue);
 		}
 
-		template <auto System>
+		template <auto System, typename... Access>
 		inline auto registerSystem() -> void
 		{
-			expand(ecs::SystemFunction<System>{}, updateQueue);
+			expand<System, Access...>(ecs::SystemFunction<System>{}, updateQueue);
 		}
 
-		template <auto System>
+		template <auto System, typename... Access>
 		inline auto registerSystemInFrameEnd() -> void
 		{
-			expand(ecs::SystemFunction<System>{}, frameEndQueue);
+			expand<System, Access...>(ecs::SystemFunction<System>{}, frameEndQueue);
 		}
 
-		template <auto System>
+		template <auto System, typename... Access>
 		inline auto registerGameStart() -> void
 		{
-			expand(ecs::SystemFunction<System>{}, gameStartQueue);
+			expand<System, Access...>(ecs::SystemFunction<System>{}, gameStartQueue);
 		}
 
-		template <auto System>
+		template <auto System, typename... Access>
 		inline auto registerGameEnded() -> void
 		{
-			expand(ecs::SystemFunction<System>{}, gameEndedQueue);
+			expand<System, Access...>(ecs::SystemFunction<System>{}, gameEndedQueue);
 		}
 
-		template <auto System>
+		template <auto System, typename... Access>
 		inline auto registerOnImGui() -> void
 		{
-			expand(ecs::SystemFunction<System>{}, imGuiQueue);
+			expand<System, Access...>(ecs::SystemFunction<System>{}, imGuiQueue);
 		}
 
-		template <auto System>
+		template <auto System, typename... Access>
 		inline auto registerWithinQueue(ExecuteQueue &queue)
 		{
-			expand(ecs::SystemFunction<System>{}, queue);
+			expand<System, Access...>(ecs::SystemFunction<System>{}, queue);
 		}
 
 		template <typename R, typename... T>
@@ -119,6 +157,14 @@ namespace maple
 			return registry;
 		}
 
+		inline auto setJobSystem(JobSystem *jobSystem)
+		{
+			this->jobSystem = jobSystem;
+		}
+
+		//print the computed schedule of every queue
+		auto dumpSchedule() -> std::string;
+
 		template <typename... Components>
 		inline auto addGlobalComponent()
 		{
@@ -181,10 +227,7 @@ namespace maple
 		inline auto flushJobs(ExecuteQueue &queue)
 		{
 			queue.preCall(ecs::World{registry, globalEntity});
-			for (auto &func : queue.jobs)
-			{
-				func(registry);
-			}
+			system_scheduler::execute(queue, registry, jobSystem);
 			queue.postCall(ecs::World{registry, globalEntity});
 		}
 
@@ -210,7 +253,7 @@ namespace maple
 			if (!factoryQueue.jobs.empty())
 			{
 				flushJobs(factoryQueue);
-				factoryQueue.jobs.clear();
+				factoryQueue.clear();
 			}
 
 			for (auto g : graph)
@@ -220,15 +263,21 @@ namespace maple
 			flushJobs(frameEndQueue);
 		}
 
-		template <auto System>
+		template <auto System, typename... Access>
 		inline auto expand(ecs::SystemFunction<System> system, ExecuteQueue &queue) -> void
 		{
-			build(system, queue);
+			build(system, queue, system_access::reflect<System, Access...>());
 		}
 
 		template <typename TSystem>
-		inline auto build(TSystem, ExecuteQueue &queue) -> void
+		inline auto build(TSystem, ExecuteQueue &queue, SystemAccess &&access) -> void
 		{
+			constexpr auto systemName = ecs::SystemAssembler::template getSystemFullName(TSystem{});
+			queue.access.resize(queue.jobs.size(), SystemAccess{{}, {}, true});
+			queue.systemNames.resize(queue.jobs.size());
+			queue.access.emplace_back(std::move(access));
+			queue.systemNames.emplace_back(systemName.c_str());
+
 			queue.jobs.emplace_back([&](entt::registry &reg) {
 				auto           call       = ecs::SystemAssembler::template assembleSystem(TSystem{});
 				constexpr auto reflectStr = ecs::SystemAssembler::template getSystemFullName(TSystem{});
@@ -254,5 +303,7 @@ namespace maple
 		entt::entity globalEntity = entt::null;
 
 		entt::registry registry;
+
+		JobSystem *jobSystem = nullptr;
 	};
 };        // namespace maple
@@ -7,6 +7,9 @@
 #include "Scene/Component/Transform.h"
 #include "Scene/Entity/Entity.h"
 #include "Scene/System/ExecutePoint.h"
+#include "Application.h"
+
+#include <algorithm>
 
 namespace maple
 {
@@ -14,62 +17,16 @@ namespace maple
 	{
 		auto updateTransform(entt::entity entity, ecs::World world, global::component::SceneTransformChanged *changed) -> void
 		{
-			PROFILE_FUNCTION();
-			auto hierarchyComponent = world.tryGetComponent<component::Hierarchy>(entity);
-			if (hierarchyComponent)
-			{
-				auto transform = world.tryGetComponent<component::Transform>(entity);
-				if (transform)
-				{
-					if (hierarchyComponent->parent != entt::null)
-					{
-						auto parentTransform = world.tryGetComponent<component::Transform>(hierarchyComponent->parent);
-						if (parentTransform && (parentTransform->hasUpdated() || transform->isDirty()))
-						{
-							transform->setWorldMatrix(parentTransform->getWorldMatrix());
-							if (changed)
-							{
-								changed->dirty = true;
-								changed->entities.emplace_back(entity);
-							}
-						}
-					}
-					else        //no parent....root
-					{
-						if (transform->isDirty())
-						{
-							transform->setWorldMatrix(glm::mat4{1.f});
-							if (changed)
-							{
-								changed->dirty = true;
-								changed->entities.emplace_back(entity);
-							}
-						}
-					}
-				}
-
-				entt::entity child = hierarchyComponent->first;
-				while (child != entt::null)
-				{
-					auto hierarchyComponent = world.tryGetComponent<component::Hierarchy>(child);
-					auto next               = hierarchyComponent ? hierarchyComponent->next : entt::null;
-					updateTransform(child, world);
-					child = next;
-				}
-			}
+			updateTransform(entity, world.getRegistry(), changed);
 		}
 
 		namespace update_hierarchy
 		{
-			using Entity = ecs::Registry ::Modify<maple::component::Hierarchy>::Modify<maple::component::Transform>::To<ecs::Entity>;
-			inline auto system(Entity entity, global::component::SceneTransformChanged *sceneChanged, ecs::World world)
+			using Entity = ecs::Registry ::Modify<global::component::SceneTransformChanged>::To<ecs::Entity>;
+			inline auto system(Entity entity, ecs::World world)
 			{
-				auto [hierarchy, transform] = entity;
-				if (hierarchy.parent == entt::null)
-				{
-					//Recursively update children
-					updateTransform(entity, world);
-				}
+				auto [sceneChanged] = entity;
+				updateHierarchy(world.getRegistry(), &sceneChanged, Application::getJobSystem().get());
 			}
 		}        // namespace update_hierarchy
 
@@ -103,6 +60,22 @@ namespace maple
 			}
 		}        // namespace reset_update
 
+		//keep the flattened cache in sync, append when possible or rebuild lazily
+		inline auto onCacheConstruct(component::Hierarchy &hierarchy, Entity entity, ecs::World world) -> void
+		{
+			addToCache(world.getRegistry(), entity, hierarchy);
+		}
+
+		inline auto onCacheUpdate(component::Hierarchy &hierarchy, Entity entity, ecs::World world) -> void
+		{
+			getCache(world.getRegistry()).dirty = true;
+		}
+
+		inline auto onCacheDestroy(component::Hierarchy &hierarchy, Entity entity, ecs::World world) -> void
+		{
+			removeFromCache(world.getRegistry(), entity, hierarchy);
+		}
+
 		//delegate method
 		//update hierarchy components when hierarchy component is added
 		inline auto onConstruct(component::Hierarchy &hierarchy, Entity entity, ecs::World world) -> void
@@ -242,6 +215,7 @@ namespace maple
 		//adjust the parent
 		auto reparent(entt::entity entity, entt::entity parent, component::Hierarchy &hierarchy, ecs::World world) -> void
 		{
+			getCache(world.getRegistry()).dirty = true;
 			onDestroy(world.getComponent<component::Hierarchy>(entity), {entity, world.getRegistry()}, world);
 
 			hierarchy.parent = entt::null;
@@ -266,8 +240,12 @@ namespace maple
 			executePoint->onDestory<component::Hierarchy, hierarchy::onDestroy>();
 			executePoint->onUpdate<component::Hierarchy, hierarchy::onUpdate>();
 
+			executePoint->onConstruct<component::Hierarchy, hierarchy::onCacheConstruct>();
+			executePoint->onDestory<component::Hierarchy, hierarchy::onCacheDestroy>();
+			executePoint->onUpdate<component::Hierarchy, hierarchy::onCacheUpdate>();
+
 			executePoint->registerSystem<update_none_hierarchy::system>();
-			executePoint->registerSystem<update_hierarchy::system>();
+			executePoint->registerSystem<update_hierarchy::system, access::Write<component::Transform, global::component::HierarchyCache>, access::Read<component::Hierarchy>>();
 			executePoint->registerSystemInFrameEnd<reset_update::system>();
 		}
 	}        // namespace hierarchy
@@ -4,24 +4,16 @@
 
 #pragma once
 #include "Engine/Core.h"
+#include "Scene/System/HierarchyUpdate.h"
 #include "ecs/World.h"
 
 namespace maple
 {
 	class ExecutePoint;
 
-	namespace component
-	{
-		struct Hierarchy;
-	}
-
-	namespace global::component
-	{
-		struct SceneTransformChanged;
-	}
-
 	namespace hierarchy
 	{
+		//update the sub-tree of one entity immediately
 		auto MAPLE_EXPORT updateTransform(entt::entity entity, ecs::World world, global::component::SceneTransformChanged *transform = nullptr) -> void;
 
 		auto MAPLE_EXPORT reset(component::Hierarchy &hy) -> void;
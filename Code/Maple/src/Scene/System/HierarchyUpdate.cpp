@@ -0,0 +1,293 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "Scene/System/HierarchyUpdate.h"
+#include "Engine/Profiler.h"
+#include "Scene/Component/Hierarchy.h"
+#include "Scene/Component/Transform.h"
+#include "Thread/ParallelForEach.h"
+
+#include <algorithm>
+
+namespace maple
+{
+	namespace hierarchy
+	{
+		namespace
+		{
+			inline auto entityId(entt::entity entity)
+			{
+				return static_cast<size_t>(entt::to_integral(entity) & entt::entt_traits<entt::entity>::entity_mask);
+			}
+
+			inline auto indexOf(const global::component::HierarchyCache &cache, entt::entity entity) -> int32_t
+			{
+				const auto id = entityId(entity);
+				return id < cache.indices.size() ? cache.indices[id] : -1;
+			}
+
+			inline auto append(global::component::HierarchyCache &cache, entt::entity entity, int32_t parent) -> void
+			{
+				const auto id = entityId(entity);
+				if (id >= cache.indices.size())
+					cache.indices.resize(id + 1, -1);
+				cache.indices[id] = static_cast<int32_t>(cache.entities.size());
+				cache.entities.emplace_back(entity);
+				cache.parents.emplace_back(parent);
+				cache.depths.emplace_back(parent < 0 ? 0 : cache.depths[parent] + 1);
+			}
+
+			inline auto isRoot(const component::Hierarchy &hierarchy, entt::registry &registry)
+			{
+				return hierarchy.parent == entt::null || !registry.valid(hierarchy.parent) || !registry.has<component::Hierarchy>(hierarchy.parent);
+			}
+
+			//depth first flatten from every root, O(n)
+			inline auto rebuild(global::component::HierarchyCache &cache, entt::registry &registry) -> void
+			{
+				PROFILE_FUNCTION();
+				cache.entities.clear();
+				cache.parents.clear();
+				cache.depths.clear();
+				cache.ranges.clear();
+				std::fill(cache.indices.begin(), cache.indices.end(), -1);
+
+				std::vector<std::pair<entt::entity, int32_t>> stack;
+
+				auto view = registry.view<component::Hierarchy>();
+				cache.entities.reserve(view.size());
+				cache.parents.reserve(view.size());
+				cache.depths.reserve(view.size());
+
+				for (auto root : view)
+				{
+					if (!isRoot(view.get<component::Hierarchy>(root), registry))
+						continue;
+
+					const auto begin = static_cast<uint32_t>(cache.entities.size());
+					stack.emplace_back(root, -1);
+					while (!stack.empty())
+					{
+						auto [entity, parent] = stack.back();
+						stack.pop_back();
+
+						if (indexOf(cache, entity) >= 0)        //broken links, never visit twice
+							continue;
+
+						const auto index = static_cast<int32_t>(cache.entities.size());
+						append(cache, entity, parent);
+
+						//push in reverse order to keep the sibling order
+						const auto first = stack.size();
+						for (auto child = view.get<component::Hierarchy>(entity).first; child != entt::null;)
+						{
+							auto childHierarchy = registry.try_get<component::Hierarchy>(child);
+							if (childHierarchy == nullptr)
+								break;
+							stack.emplace_back(child, index);
+							child = childHierarchy->next;
+						}
+						std::reverse(stack.begin() + first, stack.end());
+					}
+					cache.ranges.emplace_back(begin, static_cast<uint32_t>(cache.entities.size()));
+				}
+				cache.removed = 0;
+				cache.dirty   = false;
+			}
+
+			inline auto updateRange(global::component::HierarchyCache &cache, entt::registry &registry, uint32_t begin, uint32_t end, std::vector<entt::entity> *changed) -> void
+			{
+				static const glm::mat4 identity{1.f};
+
+				for (uint32_t i = begin; i < end; i++)
+				{
+					const auto entity = cache.entities[i];
+					const auto parent = cache.parents[i];
+
+					if (entity == entt::null)
+					{
+						cache.transforms[i] = nullptr;
+						cache.updated[i]    = parent >= 0 ? cache.updated[parent] : 0;
+						continue;
+					}
+
+					auto transform      = registry.try_get<component::Transform>(entity);
+					cache.transforms[i] = transform;
+
+					const bool parentUpdated = parent >= 0 && cache.updated[parent];
+
+					if (transform == nullptr)
+					{
+						cache.updated[i] = parentUpdated;
+						continue;
+					}
+
+					if (transform->isDirty() || parentUpdated)
+					{
+						auto parentTransform = parent >= 0 ? cache.transforms[parent] : nullptr;
+						transform->setWorldMatrix(parentTransform != nullptr ? parentTransform->getWorldMatrix() : identity);
+						cache.updated[i] = 1;
+						if (changed)
+							changed->emplace_back(entity);
+					}
+					else
+					{
+						//could be updated by someone else in this frame (physics for example)
+						cache.updated[i] = transform->hasUpdated();
+					}
+				}
+			}
+		}        // namespace
+
+		auto getCache(entt::registry &registry) -> global::component::HierarchyCache &
+		{
+			return registry.ctx_or_set<global::component::HierarchyCache>();
+		}
+
+		auto updateHierarchy(entt::registry &registry, global::component::SceneTransformChanged *changed, JobSystem *jobSystem) -> void
+		{
+			PROFILE_FUNCTION();
+			auto &cache = getCache(registry);
+
+			if (cache.dirty || cache.removed * 4 > cache.entities.size())
+			{
+				rebuild(cache, registry);
+			}
+
+			const auto count = static_cast<uint32_t>(cache.entities.size());
+			cache.transforms.resize(count);
+			cache.updated.resize(count);
+
+			std::vector<entt::entity> *out = changed ? &changed->entities : nullptr;
+			const auto                 before = out ? out->size() : 0;
+
+			if (jobSystem == nullptr || count < ParallelThreshold || cache.ranges.size() < 2)
+			{
+				for (auto [begin, end] : cache.ranges)
+				{
+					updateRange(cache, registry, begin, end, out);
+				}
+			}
+			else
+			{
+				const auto rangeCount = static_cast<uint32_t>(cache.ranges.size());
+				const auto batchSize  = std::max<uint32_t>(1, rangeCount / (jobSystem->getWorkerCount() * 4));
+
+				std::vector<std::vector<entt::entity>> outputs((rangeCount + batchSize - 1) / batchSize);
+
+				parallelForRange(*jobSystem, rangeCount, batchSize, [&](uint32_t begin, uint32_t end) {
+					auto batchOut = out ? &outputs[begin / batchSize] : nullptr;
+					for (auto i = begin; i < end; i++)
+					{
+						updateRange(cache, registry, cache.ranges[i].first, cache.ranges[i].second, batchOut);
+					}
+				});
+
+				if (out)
+				{
+					for (auto &output : outputs)
+						out->insert(out->end(), output.begin(), output.end());
+				}
+			}
+
+			if (changed && changed->entities.size() != before)
+			{
+				changed->dirty = true;
+			}
+		}
+
+		auto updateTransform(entt::entity entity, entt::registry &registry, global::component::SceneTransformChanged *changed) -> void
+		{
+			PROFILE_FUNCTION();
+			static const glm::mat4 identity{1.f};
+
+			//non-recursive, parent first
+			std::vector<std::pair<entt::entity, bool>> stack;
+			stack.emplace_back(entity, false);
+
+			while (!stack.empty())
+			{
+				auto [current, parentUpdated] = stack.back();
+				stack.pop_back();
+
+				auto hierarchyComponent = registry.try_get<component::Hierarchy>(current);
+				if (hierarchyComponent == nullptr)
+					continue;
+
+				bool updated   = parentUpdated;
+				auto transform = registry.try_get<component::Transform>(current);
+				if (transform)
+				{
+					auto parentTransform = hierarchyComponent->parent != entt::null ? registry.try_get<component::Transform>(hierarchyComponent->parent) : nullptr;
+					if (transform->isDirty() || parentUpdated || (parentTransform && parentTransform->hasUpdated()))
+					{
+						transform->setWorldMatrix(parentTransform ? parentTransform->getWorldMatrix() : identity);
+						updated = true;
+						if (changed)
+						{
+							changed->dirty = true;
+							changed->entities.emplace_back(current);
+						}
+					}
+				}
+
+				for (auto child = hierarchyComponent->first; child != entt::null;)
+				{
+					auto childHierarchy = registry.try_get<component::Hierarchy>(child);
+					stack.emplace_back(child, updated);
+					child = childHierarchy ? childHierarchy->next : entt::null;
+				}
+			}
+		}
+
+		auto addToCache(entt::registry &registry, entt::entity entity, const component::Hierarchy &hierarchy) -> void
+		{
+			auto &cache = getCache(registry);
+			if (cache.dirty)
+				return;
+
+			if (indexOf(cache, entity) >= 0)
+			{
+				cache.dirty = true;
+			}
+			else if (hierarchy.parent == entt::null)
+			{
+				const auto begin = static_cast<uint32_t>(cache.entities.size());
+				append(cache, entity, -1);
+				cache.ranges.emplace_back(begin, begin + 1);
+			}
+			else
+			{
+				//appending to the last root keeps every root range contiguous
+				const auto parent = indexOf(cache, hierarchy.parent);
+				if (parent >= 0 && !cache.ranges.empty() && static_cast<uint32_t>(parent) >= cache.ranges.back().first && hierarchy.first == entt::null)
+				{
+					append(cache, entity, parent);
+					cache.ranges.back().second++;
+				}
+				else
+				{
+					cache.dirty = true;
+				}
+			}
+		}
+
+		auto removeFromCache(entt::registry &registry, entt::entity entity, const component::Hierarchy &hierarchy) -> void
+		{
+			auto &cache = getCache(registry);
+			if (cache.dirty)
+				return;
+
+			const auto index = indexOf(cache, entity);
+			if (index < 0 || hierarchy.first != entt::null)
+			{
+				cache.dirty = true;
+				return;
+			}
+			cache.entities[index]            = entt::null;
+			cache.indices[entityId(entity)] = -1;
+			cache.removed++;
+		}
+	}        // namespace hierarchy
+};           // namespace maple
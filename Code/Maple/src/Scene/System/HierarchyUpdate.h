@@ -0,0 +1,45 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include "Engine/Core.h"
+#include <entt/entt.hpp>
+
+namespace maple
+{
+	class JobSystem;
+
+	namespace component
+	{
+		struct Hierarchy;
+	}
+
+	namespace global::component
+	{
+		struct SceneTransformChanged;
+		struct HierarchyCache;
+	}        // namespace global::component
+
+	/**
+	 * The flattened hierarchy and the world matrices computed over it. Only the registry is needed,
+	 * the systems and the hooks of HierarchyModule drive it.
+	 */
+	namespace hierarchy
+	{
+		//below this amount of entities the roots are updated on the calling thread
+		constexpr uint32_t ParallelThreshold = 8192;
+
+		auto MAPLE_EXPORT getCache(entt::registry &registry) -> global::component::HierarchyCache &;
+
+		//update every world matrix with one linear pass over the flattened hierarchy, jobSystem could be nullptr
+		auto MAPLE_EXPORT updateHierarchy(entt::registry &registry, global::component::SceneTransformChanged *changed = nullptr, JobSystem *jobSystem = nullptr) -> void;
+
+		//update the sub-tree of one entity immediately
+		auto MAPLE_EXPORT updateTransform(entt::entity entity, entt::registry &registry, global::component::SceneTransformChanged *changed = nullptr) -> void;
+
+		//a hierarchy component was added or is about to be removed, the cache is rebuilt on the next update when it can not follow
+		auto MAPLE_EXPORT addToCache(entt::registry &registry, entt::entity entity, const component::Hierarchy &hierarchy) -> void;
+		auto MAPLE_EXPORT removeFromCache(entt::registry &registry, entt::entity entity, const component::Hierarchy &hierarchy) -> void;
+	}        // namespace hierarchy
+};           // namespace maple
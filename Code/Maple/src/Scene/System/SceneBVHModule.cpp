@@ -0,0 +1,141 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "Scene/System/SceneBVHModule.h"
+#include "Scene/Component/BoundingBox.h"
+#include "Scene/Component/MeshRenderer.h"
+#include "Scene/Component/Transform.h"
+#include "Scene/Entity/Entity.h"
+#include "Scene/System/ExecutePoint.h"
+
+#include "Engine/Mesh.h"
+#include "Engine/Profiler.h"
+
+namespace maple
+{
+	namespace scene_bvh
+	{
+		namespace
+		{
+			inline auto entityId(entt::entity entity)
+			{
+				return static_cast<size_t>(entt::to_integral(entity) & entt::entt_traits<entt::entity>::entity_mask);
+			}
+
+			inline auto &proxyOf(global::component::SceneBVH &bvh, entt::entity entity) -> int32_t &
+			{
+				const auto id = entityId(entity);
+				if (id >= bvh.proxies.size())
+				{
+					bvh.proxies.resize(id + 1, DynamicBVH::NullNode);
+					bvh.bounds.resize(id + 1);
+				}
+				return bvh.proxies[id];
+			}
+
+			//return false if the entity has no bounds or no transform yet and should stay pending
+			inline auto refit(global::component::SceneBVH &bvh, entt::registry &registry, entt::entity entity) -> bool
+			{
+				if (!registry.valid(entity))
+					return true;
+
+				auto mesh = registry.try_get<component::MeshRenderer>(entity);
+				if (mesh == nullptr)
+					return true;
+
+				//the mesh renderer could be added before the transform
+				auto trans = registry.try_get<component::Transform>(entity);
+				if (trans == nullptr || mesh->mesh == nullptr || mesh->mesh->getBoundingBox() == nullptr || !mesh->mesh->getBoundingBox()->isDefined())
+					return false;
+
+				const auto box   = mesh->mesh->getBoundingBox()->transform(trans->getWorldMatrix());
+				auto &     proxy = proxyOf(bvh, entity);
+
+				bvh.bounds[entityId(entity)] = box;
+				if (proxy == DynamicBVH::NullNode)
+					proxy = bvh.tree.createProxy(box, entt::to_integral(entity));
+				else
+					bvh.tree.moveProxy(proxy, box);
+				return true;
+			}
+		}        // namespace
+
+		auto getBVH(entt::registry &registry) -> global::component::SceneBVH &
+		{
+			return registry.ctx_or_set<global::component::SceneBVH>();
+		}
+
+		auto getBounds(const global::component::SceneBVH &bvh, entt::entity entity) -> const BoundingBox &
+		{
+			return bvh.bounds[entityId(entity)];
+		}
+
+		auto updateBVH(entt::registry &registry, const global::component::SceneTransformChanged &changed) -> void
+		{
+			PROFILE_FUNCTION();
+			auto &bvh = getBVH(registry);
+
+			if (!bvh.pending.empty())
+			{
+				std::vector<entt::entity> pending;
+				std::swap(pending, bvh.pending);
+				for (auto entity : pending)
+				{
+					if (!refit(bvh, registry, entity))
+						bvh.pending.emplace_back(entity);
+				}
+			}
+
+			for (auto entity : changed.entities)
+			{
+				const auto id = entityId(entity);
+				if (id < bvh.proxies.size() && bvh.proxies[id] != DynamicBVH::NullNode)
+					refit(bvh, registry, entity);
+			}
+		}
+
+		auto markDirty(entt::registry &registry, entt::entity entity) -> void
+		{
+			getBVH(registry).pending.emplace_back(entity);
+		}
+
+		namespace update_bvh
+		{
+			inline auto system(const global::component::SceneTransformChanged &changed, ecs::World world)
+			{
+				updateBVH(world.getRegistry(), changed);
+			}
+		}        // namespace update_bvh
+
+		inline auto onMeshConstruct(component::MeshRenderer &mesh, Entity entity, ecs::World world) -> void
+		{
+			markDirty(world.getRegistry(), entity);
+		}
+
+		inline auto onMeshUpdate(component::MeshRenderer &mesh, Entity entity, ecs::World world) -> void
+		{
+			markDirty(world.getRegistry(), entity);
+		}
+
+		inline auto onMeshDestroy(component::MeshRenderer &mesh, Entity entity, ecs::World world) -> void
+		{
+			auto &     bvh = getBVH(world.getRegistry());
+			const auto id  = entityId(entity);
+			if (id < bvh.proxies.size() && bvh.proxies[id] != DynamicBVH::NullNode)
+			{
+				bvh.tree.destroyProxy(bvh.proxies[id]);
+				bvh.proxies[id] = DynamicBVH::NullNode;
+			}
+		}
+
+		auto registerSceneBVHModule(std::shared_ptr<ExecutePoint> executePoint) -> void
+		{
+			executePoint->onConstruct<component::MeshRenderer, &onMeshConstruct>();
+			executePoint->onUpdate<component::MeshRenderer, &onMeshUpdate>();
+			executePoint->onDestory<component::MeshRenderer, &onMeshDestroy>();
+
+			executePoint->registerSystem<update_bvh::system, access::Write<global::component::SceneBVH>, access::Read<component::MeshRenderer, component::Transform>>();
+		}
+	}        // namespace scene_bvh
+};           // namespace maple
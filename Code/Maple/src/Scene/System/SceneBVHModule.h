@@ -0,0 +1,35 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include "Engine/Core.h"
+#include "ecs/World.h"
+
+namespace maple
+{
+	class ExecutePoint;
+	class BoundingBox;
+
+	namespace global::component
+	{
+		struct SceneTransformChanged;
+		struct SceneBVH;
+	}        // namespace global::component
+
+	namespace scene_bvh
+	{
+		auto MAPLE_EXPORT getBVH(entt::registry &registry) -> global::component::SceneBVH &;
+
+		//exact world box of an entity inside the tree
+		auto MAPLE_EXPORT getBounds(const global::component::SceneBVH &bvh, entt::entity entity) -> const BoundingBox &;
+
+		//refit the leaves of the changed entities and insert the pending ones
+		auto MAPLE_EXPORT updateBVH(entt::registry &registry, const global::component::SceneTransformChanged &changed) -> void;
+
+		//the bounds of the entity are refreshed during the next update, e.g. after its mesh is replaced
+		auto MAPLE_EXPORT markDirty(entt::registry &registry, entt::entity entity) -> void;
+
+		auto registerSceneBVHModule(std::shared_ptr<ExecutePoint> executePoint) -> void;
+	}        // namespace scene_bvh
+};           // namespace maple
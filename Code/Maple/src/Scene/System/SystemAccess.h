@@ -0,0 +1,239 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+#pragma once
+
+#include <ecs/World.h>
+#include <entt/entt.hpp>
+
+#include <algorithm>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+#include <vector>
+
+namespace maple
+{
+	/**
+	 * Read/Write sets of one system.
+	 * They are derived from the system's arguments when it is registered:
+	 *  - Modify<T> in a query is a write, Fetch<T>/OptinalFetch<T> is a read.
+	 *  - global components passed as T* / T& are writes, const T* / const T& are reads.
+	 *  - a system taking ecs::World declares what it reaches through the world with access::Read/access::Write,
+	 *    one declaring nothing at all is scheduled exclusively.
+	 * Exclusive systems run on the thread executing the queue and never alongside another system of it.
+	 */
+	struct SystemAccess
+	{
+		struct Component
+		{
+			size_t           hash;
+			std::string_view name;
+
+			inline auto operator==(const Component &rhs) const
+			{
+				return hash == rhs.hash;
+			}
+		};
+
+		std::vector<Component> reads;
+		std::vector<Component> writes;
+		bool                   exclusive = false;
+
+		inline auto addRead(std::string_view name)
+		{
+			add(reads, name);
+		}
+
+		inline auto addWrite(std::string_view name)
+		{
+			add(writes, name);
+		}
+
+		inline auto conflictWith(const SystemAccess &rhs) const -> bool
+		{
+			if (exclusive || rhs.exclusive)
+				return true;
+
+			auto intersect = [](const std::vector<Component> &a, const std::vector<Component> &b) {
+				for (auto &comp : a)
+				{
+					if (std::find(b.begin(), b.end(), comp) != b.end())
+						return true;
+				}
+				return false;
+			};
+			return intersect(writes, rhs.writes) || intersect(writes, rhs.reads) || intersect(reads, rhs.writes);
+		}
+
+		static inline auto normalize(std::string_view name) -> std::string_view
+		{
+			auto trim = [](std::string_view str) {
+				while (!str.empty() && str.front() == ' ')
+					str.remove_prefix(1);
+				while (!str.empty() && str.back() == ' ')
+					str.remove_suffix(1);
+				return str;
+			};
+
+			name = trim(name);
+			for (auto prefix : {std::string_view{"struct "}, std::string_view{"class "}, std::string_view{"const "}})
+			{
+				if (name.substr(0, prefix.size()) == prefix)
+					name = trim(name.substr(prefix.size()));
+			}
+			return name;
+		}
+
+	  private:
+		static inline auto add(std::vector<Component> &list, std::string_view name) -> void
+		{
+			name = normalize(name);
+			Component comp{std::hash<std::string_view>{}(name), name};
+			if (std::find(list.begin(), list.end(), comp) == list.end())
+				list.emplace_back(comp);
+		}
+	};
+
+	namespace access
+	{
+		template <typename... T>
+		struct Read
+		{
+			static inline auto apply(SystemAccess &access)
+			{
+				(access.addRead(entt::type_info<T>::name()), ...);
+			}
+		};
+
+		template <typename... T>
+		struct Write
+		{
+			static inline auto apply(SystemAccess &access)
+			{
+				(access.addWrite(entt::type_info<T>::name()), ...);
+			}
+		};
+
+		struct Exclusive
+		{
+			static inline auto apply(SystemAccess &access)
+			{
+				access.exclusive = true;
+			}
+		};
+	}        // namespace access
+
+	namespace system_access
+	{
+		template <typename T>
+		struct FunctionTraits;
+
+		template <typename R, typename... Args>
+		struct FunctionTraits<R (*)(Args...)>
+		{
+			using Arguments = std::tuple<Args...>;
+		};
+
+		/**
+		 * Scan the reflected name of a query for Modify<...>/Fetch<...> and collect the components inside.
+		 * Return false if nothing could be recognized, the system is then scheduled exclusively.
+		 */
+		inline auto parseQuery(std::string_view name, SystemAccess &access) -> bool
+		{
+			bool found = false;
+
+			auto parseArguments = [&](size_t begin, bool write) {
+				int32_t depth = 0;
+				size_t  start = begin;
+				for (size_t i = begin; i < name.size(); i++)
+				{
+					const char c = name[i];
+					if (c == '<')
+					{
+						depth++;
+					}
+					else if ((c == ',' && depth == 0) || (c == '>' && depth == 0))
+					{
+						auto comp = name.substr(start, i - start);
+						write ? access.addWrite(comp) : access.addRead(comp);
+						start = i + 1;
+						if (c == '>')
+							break;
+					}
+					else if (c == '>')
+					{
+						depth--;
+					}
+				}
+			};
+
+			for (auto [token, write] : {std::pair<std::string_view, bool>{"Modify<", true}, {"Fetch<", false}})
+			{
+				for (auto pos = name.find(token); pos != std::string_view::npos; pos = name.find(token, pos + token.size()))
+				{
+					parseArguments(pos + token.size(), write);
+					found = true;
+				}
+			}
+			return found;
+		}
+
+		template <typename Arg>
+		inline auto collect(SystemAccess &access) -> void
+		{
+			using Raw = std::remove_cv_t<std::remove_reference_t<Arg>>;
+
+			if constexpr (std::is_same_v<Raw, ecs::World>)
+			{
+				//see reflect
+			}
+			else if constexpr (std::is_pointer_v<Raw>)
+			{
+				using Global = std::remove_pointer_t<Raw>;
+				if constexpr (std::is_const_v<Global>)
+					access.addRead(entt::type_info<std::remove_cv_t<Global>>::name());
+				else
+					access.addWrite(entt::type_info<Global>::name());
+			}
+			else if constexpr (std::is_reference_v<Arg>)
+			{
+				if constexpr (std::is_const_v<std::remove_reference_t<Arg>>)
+					access.addRead(entt::type_info<Raw>::name());
+				else
+					access.addWrite(entt::type_info<Raw>::name());
+			}
+			else
+			{
+				if (!parseQuery(entt::type_info<Raw>::name(), access))
+					access.exclusive = true;
+			}
+		}
+
+		template <typename... Args>
+		inline auto collectArguments(SystemAccess &access, std::tuple<Args...> *) -> void
+		{
+			(collect<Args>(access), ...);
+		}
+
+		template <typename... Args>
+		constexpr auto takesWorld(std::tuple<Args...> *) -> bool
+		{
+			return (std::is_same_v<std::remove_cv_t<std::remove_reference_t<Args>>, ecs::World> || ...);
+		}
+
+		template <auto System, typename... Access>
+		inline auto reflect() -> SystemAccess
+		{
+			using Arguments = typename FunctionTraits<decltype(System)>::Arguments;
+			SystemAccess access;
+			collectArguments(access, static_cast<Arguments *>(nullptr));
+			(Access::apply(access), ...);
+			//the world reaches any component, without anything declared nothing can be assumed
+			if (takesWorld(static_cast<Arguments *>(nullptr)) && access.reads.empty() && access.writes.empty())
+				access.exclusive = true;
+			return access;
+		}
+	}        // namespace system_access
+};           // namespace maple
@@ -7,6 +7,7 @@
 #include "Physics/PhysicsSystem.h"
 #include "Scene/Scene.h"
 #include "Scene/System/HierarchyModule.h"
+#include "Scene/System/SceneBVHModule.h"
 #include "Scripts/Mono/MonoSystem.h"
 #include "Scene/System/BindlessModule.h"
 #include "Engine/Raytrace/AccelerationStructure.h"
@@ -21,6 +22,7 @@ namespace maple
 		mono::registerMonoModule(executePoint);
 		physics::registerPhysicsModule(executePoint);
 		mesh::registerMeshModule(executePoint);
+		scene_bvh::registerSceneBVHModule(executePoint);
 		bindless::registerBindless(executePoint);
 	}
 }        // namespace maple
@@ -14,6 +14,7 @@ extern "C"
 #include "Engine/Core.h"
 #include "MetaFile.h"
 #include <LuaBridge/LuaBridge.h>
+#include <cereal/cereal.hpp>
 #include <entt/entt.hpp>
 #include <string>
 
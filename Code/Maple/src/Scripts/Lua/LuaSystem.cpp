@@ -36,7 +36,7 @@ namespace maple
 	{
 		auto registerLuaSystem(std::shared_ptr<ExecutePoint> executePoint) -> void
 		{
-			executePoint->registerSystem<update::system>();
+			executePoint->registerSystem<update::system, access::Exclusive>();
 		}
 	}        // namespace lua
 };           // namespace maple
\ No newline at end of file
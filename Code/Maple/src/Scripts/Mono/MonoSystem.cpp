@@ -79,7 +79,8 @@ namespace maple
 				MonoVirtualMachine::get()->loadAssembly("./", "MapleLibrary.dll");
 				//MonoVirtualMachine::get()->loadAssembly("./", "MapleAssembly.dll");
 			});
-			executePoint->registerSystem<update::system>();
+			//scripts could touch anything
+			executePoint->registerSystem<update::system, access::Exclusive>();
 		}
 	}        // namespace mono
 };           // namespace maple
\ No newline at end of file
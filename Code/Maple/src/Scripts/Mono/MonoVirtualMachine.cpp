@@ -269,7 +269,7 @@ namespace maple
 		LOGV("compileAssembly...");
 		unloadScriptDomain();
 
-		Application::get()->getThreadPool()->addTask([=]() -> void * {
+		Application::getJobSystem()->executeAsync([=]() -> void * {
 			std::vector<std::string> out;
 			File::list(out, [](const std::string &str) -> bool {
 				return StringUtils::endWith(str, ".cs");
@@ -278,6 +278,6 @@ namespace maple
 
 			return nullptr;
 		},
-		                                             callback);
+		                                          callback);
 	}
 };        // namespace maple
\ No newline at end of file
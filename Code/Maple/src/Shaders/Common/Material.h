@@ -14,7 +14,7 @@ struct Material
 	float usingAOMap;
 	float usingEmissiveMap;
 	float workflow;
-	float padding;
+	float feedbackSlot;
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,19 @@
+#ifndef VERTEX_COMPRESSION_H
+#define VERTEX_COMPRESSION_H
+
+//the inverse of VertexCompression::encodeOctahedral, the input is the snorm attribute in [-1, 1]
+vec3 octDecode(vec2 e)
+{
+	vec3 v = vec3(e.xy, 1.0 - abs(e.x) - abs(e.y));
+	if (v.z < 0.0)
+		v.xy = (1.0 - abs(v.yx)) * vec2(v.x >= 0.0 ? 1.0 : -1.0, v.y >= 0.0 ? 1.0 : -1.0);
+	return normalize(v);
+}
+
+//positions are stored as unorm16 relative to the bounds of the mesh
+vec3 dequantize(vec4 position, vec4 offset, vec4 scale)
+{
+	return offset.xyz + position.xyz * scale.xyz;
+}
+
+#endif
@@ -39,7 +39,7 @@ layout(set = 1, binding = 6) uniform UniformMaterialData
 	float usingAOMap;
 	float usingEmissiveMap;
 	float workflow;
-	float padding;
+	float feedbackSlot;
 } materialProperties;
 
 
@@ -52,6 +52,12 @@ layout(set = 2,binding = 0) uniform UBO
 	float padding2;
 }ubo;
 
+//finest mip each material is sampled with, read back by the TextureStreamer
+layout(set = 2, binding = 1, std430) buffer StreamingFeedback
+{
+	uint lods[];
+}feedback;
+
 //bind to framebuffer
 layout(location = 0) out vec4 outColor;
 layout(location = 1) out vec4 outPosition;
@@ -102,7 +108,9 @@ vec3 getNormalFromMap()
 	if (materialProperties.usingNormalMap < 0.1)
 		return normalize(fragNormal);
 	
-	vec3 tangentNormal = texture(uNormalMap, fragTexCoord).xyz * 2.0 - 1.0;
+	//z is rebuilt from xy, BC5 normal maps only store those two
+	vec3 tangentNormal = vec3(texture(uNormalMap, fragTexCoord).xy * 2.0 - 1.0, 0.0);
+	tangentNormal.z    = sqrt(max(1.0 - dot(tangentNormal.xy, tangentNormal.xy), 0.0));
 	
 	/*vec3 Q1 = dFdx(fragPosition.xyz);
 	vec3 Q2 = dFdy(fragPosition.xyz);
@@ -127,8 +135,24 @@ float linearDepth(float depth)
 }
 
 
+//the lod of a single texel texture, the streamer adds log2 of the size of every texture of the material.
+//stored as lod * 16 + 512 so atomicMin works on unsigned values, one pixel out of 16 writes to keep the contention low
+void writeStreamingFeedback()
+{
+	vec2 dx = dFdx(fragTexCoord);
+	vec2 dy = dFdy(fragTexCoord);
+	uint slot = uint(materialProperties.feedbackSlot);
+	if (slot == 0 || ((uint(gl_FragCoord.x) | uint(gl_FragCoord.y)) & 3) != 0)
+		return;
+
+	float lod = 0.5 * log2(max(max(dot(dx, dx), dot(dy, dy)), 1e-20));
+	atomicMin(feedback.lods[slot], uint(clamp(lod + 32.0, 0.0, 63.0) * 16.0));
+}
+
 void main()
 {
+	writeStreamingFeedback();
+
 	vec4 texColor = getAlbedo() * fragColor;
 	if(texColor.w < 0.01)
 		discard;
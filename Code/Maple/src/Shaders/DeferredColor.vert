@@ -9,9 +9,20 @@ layout(set = 0,binding = 0) uniform UniformBufferObject
 	mat4 projViewOld;
 } ubo;
 
-layout(push_constant) uniform PushConsts
+struct InstanceData
 {
 	mat4 transform;
+	mat4 prevTransform;
+};
+
+layout(set = 0, binding = 1, std430) readonly buffer InstanceBuffer
+{
+	InstanceData instances[];
+};
+
+layout(push_constant) uniform PushConsts
+{
+	uint instanceOffset;
 } pushConsts;
 
 layout(location = 0) in vec3 inPosition;
@@ -39,16 +50,19 @@ out gl_PerVertex
 
 void main() 
 {
-	fragPosition = pushConsts.transform * vec4(inPosition, 1.0);
+	InstanceData instance = instances[pushConsts.instanceOffset + gl_InstanceIndex];
+	mat3 normalMatrix = transpose(inverse(mat3(instance.transform)));
+
+	fragPosition = instance.transform * vec4(inPosition, 1.0);
     vec4 pos =  ubo.projView * fragPosition;
 	fragTexCoord = inTexCoord;
     fragColor = inColor;
-    fragNormal =  transpose(inverse(mat3(pushConsts.transform))) * normalize(inNormal);
+    fragNormal =  normalMatrix * normalize(inNormal);
     
-    fragTangent =  transpose(inverse(mat3(pushConsts.transform))) *normalize(inTangent);
+    fragTangent =  normalMatrix * normalize(inTangent);
 
     fragProjPosition = pos;
-    fragOldProjPosition = ubo.projViewOld * pushConsts.transform * vec4(inPosition, 1.0);;
+    fragOldProjPosition = ubo.projViewOld * instance.prevTransform * vec4(inPosition, 1.0);
     fragViewPosition = ubo.view * fragPosition;
     gl_Position = pos;
 }
\ No newline at end of file
@@ -0,0 +1,76 @@
+#version 450
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_ARB_shading_language_420pack : enable
+#extension GL_GOOGLE_include_directive : require
+
+#include "Common/VertexCompression.h"
+
+const int MAX_BONES = 100;
+
+layout(set = 0,binding = 0) uniform UniformBufferObject 
+{    
+	mat4 projView;
+    mat4 view;
+	mat4 projViewOld;
+    mat4 boneTransforms[MAX_BONES];
+} ubo;
+
+
+layout(push_constant) uniform PushConsts
+{
+	mat4 transform;
+	vec4 positionOffset;
+	vec4 positionScale;
+} pushConsts;
+
+layout(location = 0) in vec4 inPosition;
+layout(location = 1) in vec4 inColor;
+layout(location = 2) in vec2 inTexCoord;
+layout(location = 3) in vec2 inNormal;
+layout(location = 4) in vec2 inTangent;
+layout(location = 5) in uvec4 inBoneIndices;
+layout(location = 6) in vec4 inBoneWeights;
+
+
+layout(location = 0) out vec4 fragPosition;
+layout(location = 1) out vec2 fragTexCoord;
+layout(location = 2) out vec4 fragColor;
+layout(location = 3) out vec3 fragNormal;
+layout(location = 4) out vec3 fragTangent;
+layout(location = 5) out vec4 fragProjPosition;
+layout(location = 6) out vec4 fragOldProjPosition;
+layout(location = 7) out vec4 fragViewPosition;
+
+
+
+out gl_PerVertex
+{
+    vec4 gl_Position;
+};
+
+mat4 getSkinMat()
+{
+    mat4 boneTransform = ubo.boneTransforms[inBoneIndices[0]] * inBoneWeights[0];
+    boneTransform += ubo.boneTransforms[inBoneIndices[1]] * inBoneWeights[1];
+    boneTransform += ubo.boneTransforms[inBoneIndices[2]] * inBoneWeights[2];
+    boneTransform += ubo.boneTransforms[inBoneIndices[3]] * inBoneWeights[3];
+    return boneTransform;
+}
+
+void main() 
+{
+	vec3 position = dequantize(inPosition, pushConsts.positionOffset, pushConsts.positionScale);
+	fragPosition = pushConsts.transform * ( getSkinMat() * vec4(position, 1.0) );
+    vec4 pos =  ubo.projView * fragPosition;
+	fragTexCoord = inTexCoord;
+    fragColor = inColor;
+    fragNormal =  transpose(inverse(mat3(pushConsts.transform))) * octDecode(inNormal);
+    
+    fragTangent = octDecode(inTangent);
+
+    fragProjPosition = pos;
+    fragOldProjPosition = ubo.projViewOld * fragPosition;
+    fragViewPosition = ubo.view * fragPosition;
+
+    gl_Position = pos;
+}
\ No newline at end of file
@@ -0,0 +1,74 @@
+#version 450
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_ARB_shading_language_420pack : enable
+#extension GL_GOOGLE_include_directive : require
+
+#include "Common/VertexCompression.h"
+
+layout(set = 0,binding = 0) uniform UniformBufferObject 
+{    
+	mat4 projView;
+    mat4 view;
+	mat4 projViewOld;
+} ubo;
+
+struct InstanceData
+{
+	mat4 transform;
+	mat4 prevTransform;
+};
+
+layout(set = 0, binding = 1, std430) readonly buffer InstanceBuffer
+{
+	InstanceData instances[];
+};
+
+layout(push_constant) uniform PushConsts
+{
+	uint instanceOffset;
+	vec4 positionOffset;
+	vec4 positionScale;
+} pushConsts;
+
+layout(location = 0) in vec4 inPosition;
+layout(location = 1) in vec4 inColor;
+layout(location = 2) in vec2 inTexCoord;
+layout(location = 3) in vec2 inNormal;
+layout(location = 4) in vec2 inTangent;
+
+
+layout(location = 0) out vec4 fragPosition;
+layout(location = 1) out vec2 fragTexCoord;
+layout(location = 2) out vec4 fragColor;
+layout(location = 3) out vec3 fragNormal;
+layout(location = 4) out vec3 fragTangent;
+layout(location = 5) out vec4 fragProjPosition;
+layout(location = 6) out vec4 fragOldProjPosition;
+layout(location = 7) out vec4 fragViewPosition;
+
+
+
+out gl_PerVertex
+{
+    vec4 gl_Position;
+};
+
+void main() 
+{
+	InstanceData instance = instances[pushConsts.instanceOffset + gl_InstanceIndex];
+	mat3 normalMatrix = transpose(inverse(mat3(instance.transform)));
+	vec3 position = dequantize(inPosition, pushConsts.positionOffset, pushConsts.positionScale);
+
+	fragPosition = instance.transform * vec4(position, 1.0);
+    vec4 pos =  ubo.projView * fragPosition;
+	fragTexCoord = inTexCoord;
+    fragColor = inColor;
+    fragNormal =  normalMatrix * octDecode(inNormal);
+    
+    fragTangent =  normalMatrix * octDecode(inTangent);
+
+    fragProjPosition = pos;
+    fragOldProjPosition = ubo.projViewOld * instance.prevTransform * vec4(position, 1.0);
+    fragViewPosition = ubo.view * fragPosition;
+    gl_Position = pos;
+}
\ No newline at end of file
@@ -145,7 +145,9 @@ vec3 getNormalFromMap()
 	if (materialProperties.usingNormalMap < 0.1)
 		return normalize(fragNormal);
 	
-	vec3 tangentNormal = texture(uNormalMap, fragTexCoord).xyz * 2.0 - 1.0;
+	//z is rebuilt from xy, BC5 normal maps only store those two
+	vec3 tangentNormal = vec3(texture(uNormalMap, fragTexCoord).xy * 2.0 - 1.0, 0.0);
+	tangentNormal.z    = sqrt(max(1.0 - dot(tangentNormal.xy, tangentNormal.xy), 0.0));
 	
 	vec3 Q1 = dFdx(fragPosition.xyz);
 	vec3 Q2 = dFdy(fragPosition.xyz);
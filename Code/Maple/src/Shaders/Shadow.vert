@@ -4,10 +4,15 @@
 
 layout(push_constant) uniform PushConsts
 {
-	mat4 transform;
+	uint instanceOffset;
 	uint cascadeIndex;
 } pushConsts;
 
+layout(set = 0, binding = 1, std430) readonly buffer InstanceBuffer
+{
+	mat4 transforms[];
+};
+
 layout(set = 0,binding = 0) uniform UniformBufferObject
 {
     mat4 projView[4];
@@ -26,5 +31,5 @@ layout(location = 4) in vec3 inTangent;
 
 void main()
 {
-    gl_Position = ubo.projView[pushConsts.cascadeIndex] * pushConsts.transform *  vec4(inPosition, 1.0); 
+    gl_Position = ubo.projView[pushConsts.cascadeIndex] * transforms[pushConsts.instanceOffset + gl_InstanceIndex] * vec4(inPosition, 1.0); 
 }
\ No newline at end of file
@@ -0,0 +1,45 @@
+#version 450
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_ARB_shading_language_420pack : enable
+#extension GL_GOOGLE_include_directive : require
+
+#include "Common/VertexCompression.h"
+
+const int MAX_BONES = 100;
+
+layout(push_constant) uniform PushConsts
+{
+	mat4 transform;
+	vec4 positionOffset;
+	vec4 positionScale;
+} pushConsts;
+
+layout(set = 0,binding = 0) uniform UniformBufferObject
+{
+    mat4 projView;
+	mat4 boneTransforms[MAX_BONES];
+} ubo;
+
+out gl_PerVertex
+{
+    vec4 gl_Position;
+};
+
+layout(location = 0) in vec4 inPosition;
+layout(location = 5) in uvec4 inBoneIndices;
+layout(location = 6) in vec4 inBoneWeights;
+
+mat4 getSkinMat()
+{
+    mat4 boneTransform = ubo.boneTransforms[inBoneIndices[0]] * inBoneWeights[0];
+    boneTransform += ubo.boneTransforms[inBoneIndices[1]] * inBoneWeights[1];
+    boneTransform += ubo.boneTransforms[inBoneIndices[2]] * inBoneWeights[2];
+    boneTransform += ubo.boneTransforms[inBoneIndices[3]] * inBoneWeights[3];
+    return boneTransform;
+}
+
+void main()
+{
+    vec3 position = dequantize(inPosition, pushConsts.positionOffset, pushConsts.positionScale);
+    gl_Position = ubo.projView * pushConsts.transform *  (getSkinMat() * vec4(position, 1.0)); 
+}
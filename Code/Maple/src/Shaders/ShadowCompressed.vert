@@ -0,0 +1,38 @@
+#version 450
+#extension GL_ARB_separate_shader_objects : enable
+#extension GL_ARB_shading_language_420pack : enable
+#extension GL_GOOGLE_include_directive : require
+
+#include "Common/VertexCompression.h"
+
+layout(push_constant) uniform PushConsts
+{
+	uint instanceOffset;
+	uint cascadeIndex;
+	vec4 positionOffset;
+	vec4 positionScale;
+} pushConsts;
+
+layout(set = 0, binding = 1, std430) readonly buffer InstanceBuffer
+{
+	mat4 transforms[];
+};
+
+layout(set = 0,binding = 0) uniform UniformBufferObject
+{
+    mat4 projView[4];
+} ubo;
+
+out gl_PerVertex
+{
+    vec4 gl_Position;
+};
+
+//the position stream alone, 8 bytes per vertex
+layout(location = 0) in vec4 inPosition;
+
+void main()
+{
+    vec3 position = dequantize(inPosition, pushConsts.positionOffset, pushConsts.positionScale);
+    gl_Position = ubo.projView[pushConsts.cascadeIndex] * transforms[pushConsts.instanceOffset + gl_InstanceIndex] * vec4(position, 1.0); 
+}
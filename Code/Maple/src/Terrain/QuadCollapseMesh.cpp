@@ -258,7 +258,7 @@ namespace maple
 		{
 			float quadSize           = (float) ((maxLevelVerticesLength - 1) >> i);
 			float quadHalfSize       = quadSize * 0.5f;
-			float quadNodeCullRadius = std::sqrtf(quadHalfSize * quadSize * 2.0f);
+			float quadNodeCullRadius = std::sqrt(quadHalfSize * quadSize * 2.0f);
 
 			quadNodesCullRadius[i]     = quadNodeCullRadius;
 			vertNodesActiveDistance[i] = quadNodeCullRadius * ACTIVE_SCALE;
@@ -807,7 +807,7 @@ namespace maple
 				float sqrLength = glm::dot(o_minus_c.pos, o_minus_c.pos);
 				float temp      = (l_dot_o_minus_c * l_dot_o_minus_c) - sqrLength + r * r;
 
-				float d = -l_dot_o_minus_c + std::sqrtf(temp);
+				float d = -l_dot_o_minus_c + std::sqrt(temp);
 				float t = (d - dist) / (d - vertNodesActiveDistance[vertNode->level]);
 
 				auto pOrigin = p->originalVertex;
@@ -0,0 +1,371 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "JobSystem.h"
+#include "Engine/Profiler.h"
+#include "Others/Console.h"
+
+#include <chrono>
+#include <string>
+
+namespace maple
+{
+	namespace
+	{
+		thread_local const JobSystem *currentSystem = nullptr;
+		thread_local int32_t          currentIndex  = -1;
+		thread_local uint32_t         randomSeed    = 0x9E3779B9u;
+
+		constexpr int32_t SpinCount = 64;
+
+		inline auto nextRandom() -> uint32_t
+		{
+			randomSeed ^= randomSeed << 13;
+			randomSeed ^= randomSeed >> 17;
+			randomSeed ^= randomSeed << 5;
+			return randomSeed;
+		}
+	}        // namespace
+
+	JobSystem::JobSystem(uint32_t workerCount)
+	{
+		if (workerCount == 0)
+		{
+			const uint32_t hardware = std::thread::hardware_concurrency();
+			workerCount             = hardware > 1 ? hardware - 1 : 1;
+		}
+
+		mainThreadId  = std::this_thread::get_id();
+		currentSystem = this;
+		currentIndex  = 0;
+
+		for (uint32_t i = 0; i <= workerCount; i++)
+		{
+			queues.emplace_back(std::make_unique<WorkStealingQueue<Job>>());
+		}
+
+		for (uint32_t i = 1; i <= workerCount; i++)
+		{
+			threads.emplace_back(&JobSystem::run, this, i);
+		}
+		LOGI("JobSystem : {0} workers, the main thread included", getWorkerCount());
+	}
+
+	JobSystem::~JobSystem()
+	{
+		waitAll();
+		{
+			std::lock_guard<std::mutex> lock(sleepMutex);
+			close = true;
+		}
+		sleepCondition.notify_all();
+		for (auto &thread : threads)
+		{
+			if (thread.joinable())
+				thread.join();
+		}
+
+		if (currentSystem == this)
+		{
+			currentSystem = nullptr;
+			currentIndex  = -1;
+		}
+	}
+
+	auto JobSystem::execute(const std::function<void()> &job, const std::shared_ptr<JobCounter> &counter) -> void
+	{
+		if (counter)
+		{
+			counter->value.fetch_add(1, std::memory_order_acq_rel);
+		}
+		push(new Job{job, counter});
+	}
+
+	auto JobSystem::executeAfter(const std::shared_ptr<JobCounter> &dependency, const std::function<void()> &job, const std::shared_ptr<JobCounter> &counter) -> void
+	{
+		if (counter)
+		{
+			counter->value.fetch_add(1, std::memory_order_acq_rel);
+		}
+
+		if (dependency)
+		{
+			std::lock_guard<std::mutex> lock(dependency->mutex);
+			if (!dependency->isDone())
+			{
+				dependency->continuations.emplace_back([this, job, counter]() {
+					push(new Job{job, counter});
+				});
+				return;
+			}
+		}
+		push(new Job{job, counter});
+	}
+
+	auto JobSystem::executeAsync(const std::function<void *()> &job, const std::function<void(void *)> &complete) -> void
+	{
+		execute([this, job, complete]() {
+			void *result = job();
+			if (complete)
+			{
+				executeOnMainThread([complete, result]() {
+					complete(result);
+				});
+			}
+		});
+	}
+
+	auto JobSystem::executeBackground(const std::function<void()> &job, const std::shared_ptr<JobCounter> &counter) -> void
+	{
+		if (counter)
+		{
+			counter->value.fetch_add(1, std::memory_order_acq_rel);
+		}
+		{
+			std::lock_guard<std::mutex> lock(backgroundMutex);
+			backgroundQueue.emplace_back(new Job{job, counter});
+		}
+
+		pending.fetch_add(1, std::memory_order_seq_cst);
+		if (sleeping.load(std::memory_order_seq_cst) > 0)
+		{
+			std::lock_guard<std::mutex> lock(sleepMutex);
+			sleepCondition.notify_one();
+		}
+	}
+
+	auto JobSystem::executeOnMainThread(const std::function<void()> &func) -> void
+	{
+		std::lock_guard<std::mutex> lock(mainThreadMutex);
+		mainThreadJobs.emplace_back(func);
+	}
+
+	auto JobSystem::flushMainThread() -> void
+	{
+		PROFILE_FUNCTION();
+		{
+			std::lock_guard<std::mutex> lock(mainThreadMutex);
+			std::swap(mainThreadJobs, mainThreadJobsBack);
+		}
+		for (auto &func : mainThreadJobsBack)
+		{
+			func();
+		}
+		mainThreadJobsBack.clear();
+	}
+
+	auto JobSystem::wait(const std::shared_ptr<JobCounter> &counter) -> void
+	{
+		PROFILE_FUNCTION();
+		if (counter == nullptr)
+			return;
+
+		const int32_t index = getCurrentWorkerIndex();
+		while (!counter->isDone())
+		{
+			if (auto job = pop(index))
+			{
+				runJob(job);
+			}
+			else
+			{
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	auto JobSystem::wait(const std::shared_ptr<JobCounter> &counter, float timeout) -> bool
+	{
+		PROFILE_FUNCTION();
+		if (counter == nullptr)
+			return true;
+
+		const auto    end   = std::chrono::steady_clock::now() + std::chrono::microseconds(static_cast<int64_t>(timeout * 1000.f));
+		const int32_t index = getCurrentWorkerIndex();
+		while (!counter->isDone() && std::chrono::steady_clock::now() < end)
+		{
+			if (auto job = pop(index))
+			{
+				runJob(job);
+			}
+			else
+			{
+				std::this_thread::yield();
+			}
+		}
+		return counter->isDone();
+	}
+
+	auto JobSystem::waitAll() -> void
+	{
+		PROFILE_FUNCTION();
+		const int32_t index = getCurrentWorkerIndex();
+		while (pending.load(std::memory_order_acquire) > 0 || running.load(std::memory_order_acquire) > 0)
+		{
+			if (auto job = pop(index))
+			{
+				runJob(job);
+			}
+			else
+			{
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	auto JobSystem::getCurrentWorkerIndex() const -> int32_t
+	{
+		return currentSystem == this ? currentIndex : -1;
+	}
+
+	auto JobSystem::run(uint32_t workerIndex) -> void
+	{
+		currentSystem = this;
+		currentIndex  = workerIndex;
+		randomSeed ^= workerIndex * 0x85EBCA6Bu;
+
+		const std::string name = "Worker:" + std::to_string(workerIndex);
+		PROFILE_SETTHREADNAME(name.c_str());
+
+		int32_t spin = 0;
+		while (!close.load(std::memory_order_acquire))
+		{
+			if (auto job = pop(workerIndex))
+			{
+				runJob(job);
+				spin = 0;
+				continue;
+			}
+
+			if (auto job = popBackground())
+			{
+				runJob(job);
+				spin = 0;
+				continue;
+			}
+
+			if (++spin < SpinCount)
+			{
+				std::this_thread::yield();
+				continue;
+			}
+
+			std::unique_lock<std::mutex> lock(sleepMutex);
+			sleeping.fetch_add(1, std::memory_order_seq_cst);
+			sleepCondition.wait(lock, [this]() {
+				return pending.load(std::memory_order_seq_cst) > 0 || close.load(std::memory_order_acquire);
+			});
+			sleeping.fetch_sub(1, std::memory_order_seq_cst);
+			spin = 0;
+		}
+	}
+
+	auto JobSystem::push(Job *job) -> void
+	{
+		const int32_t index = getCurrentWorkerIndex();
+		if (index < 0 || !queues[index]->push(job))
+		{
+			std::lock_guard<std::mutex> lock(globalMutex);
+			globalQueue.emplace_back(job);
+		}
+
+		pending.fetch_add(1, std::memory_order_seq_cst);
+		if (sleeping.load(std::memory_order_seq_cst) > 0)
+		{
+			std::lock_guard<std::mutex> lock(sleepMutex);
+			sleepCondition.notify_one();
+		}
+	}
+
+	auto JobSystem::pop(int32_t workerIndex) -> Job *
+	{
+		if (pending.load(std::memory_order_acquire) <= 0)
+			return nullptr;
+
+		Job *job = nullptr;
+
+		if (workerIndex >= 0)
+		{
+			job = queues[workerIndex]->pop();
+		}
+
+		if (job == nullptr)
+		{
+			std::lock_guard<std::mutex> lock(globalMutex);
+			if (!globalQueue.empty())
+			{
+				job = globalQueue.front();
+				globalQueue.pop_front();
+			}
+		}
+
+		if (job == nullptr)
+		{
+			const uint32_t count = static_cast<uint32_t>(queues.size());
+			const uint32_t start = nextRandom() % count;
+			for (uint32_t i = 0; i < count && job == nullptr; i++)
+			{
+				const uint32_t victim = (start + i) % count;
+				if (static_cast<int32_t>(victim) != workerIndex)
+				{
+					job = queues[victim]->steal();
+				}
+			}
+			if (job != nullptr)
+			{
+				stolenJobs.fetch_add(1, std::memory_order_relaxed);
+			}
+		}
+
+		if (job != nullptr)
+		{
+			running.fetch_add(1, std::memory_order_acq_rel);
+			pending.fetch_sub(1, std::memory_order_acq_rel);
+		}
+		return job;
+	}
+
+	auto JobSystem::popBackground() -> Job *
+	{
+		Job *job = nullptr;
+		{
+			std::lock_guard<std::mutex> lock(backgroundMutex);
+			if (backgroundQueue.empty())
+				return nullptr;
+			job = backgroundQueue.front();
+			backgroundQueue.pop_front();
+		}
+		running.fetch_add(1, std::memory_order_acq_rel);
+		pending.fetch_sub(1, std::memory_order_acq_rel);
+		return job;
+	}
+
+	auto JobSystem::runJob(Job *job) -> void
+	{
+		if (job->func)
+		{
+			job->func();
+		}
+		finish(job->counter);
+		delete job;
+		executedJobs.fetch_add(1, std::memory_order_relaxed);
+		running.fetch_sub(1, std::memory_order_acq_rel);
+	}
+
+	auto JobSystem::finish(const std::shared_ptr<JobCounter> &counter) -> void
+	{
+		if (counter && counter->value.fetch_sub(1, std::memory_order_acq_rel) == 1)
+		{
+			std::vector<std::function<void()>> continuations;
+			{
+				std::lock_guard<std::mutex> lock(counter->mutex);
+				std::swap(continuations, counter->continuations);
+			}
+			for (auto &func : continuations)
+			{
+				func();
+			}
+		}
+	}
+};        // namespace maple
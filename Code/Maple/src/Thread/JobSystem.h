@@ -0,0 +1,157 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include "Engine/Core.h"
+#include "Thread/WorkStealingQueue.h"
+
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace maple
+{
+	class JobSystem;
+
+	/**
+	 * Counts the unfinished jobs attached to it.
+	 * Jobs scheduled with JobSystem::executeAfter are kept here and released once it reaches zero.
+	 */
+	class MAPLE_EXPORT JobCounter
+	{
+	  public:
+		inline auto isDone() const
+		{
+			return value.load(std::memory_order_acquire) == 0;
+		}
+
+		inline auto getValue() const
+		{
+			return value.load(std::memory_order_acquire);
+		}
+
+	  private:
+		friend class JobSystem;
+		std::atomic<int32_t>               value{0};
+		std::mutex                         mutex;
+		std::vector<std::function<void()>> continuations;
+	};
+
+	class MAPLE_EXPORT JobSystem
+	{
+	  public:
+		struct Job
+		{
+			std::function<void()>       func;
+			std::shared_ptr<JobCounter> counter;
+		};
+
+		/**
+		 * workerCount == 0 means hardware_concurrency - 1, the calling thread is treated as worker 0
+		 * and executes jobs while it waits.
+		 */
+		JobSystem(uint32_t workerCount = 0);
+		~JobSystem();
+		NO_COPYABLE(JobSystem);
+
+		auto execute(const std::function<void()> &job, const std::shared_ptr<JobCounter> &counter = nullptr) -> void;
+
+		/**
+		 * schedule the job after dependency is finished. the counter is increased immediately.
+		 */
+		auto executeAfter(const std::shared_ptr<JobCounter> &dependency, const std::function<void()> &job, const std::shared_ptr<JobCounter> &counter = nullptr) -> void;
+
+		/**
+		 * run the job on a worker and then call complete on the main thread during flushMainThread.
+		 */
+		auto executeAsync(const std::function<void *()> &job, const std::function<void(void *)> &complete) -> void;
+
+		/**
+		 * long running work, e.g. the parse of an import. only the worker threads take it once their own queues are empty,
+		 * a thread helping in wait() never does, so it can not stall a frame.
+		 */
+		auto executeBackground(const std::function<void()> &job, const std::shared_ptr<JobCounter> &counter = nullptr) -> void;
+
+		auto executeOnMainThread(const std::function<void()> &func) -> void;
+
+		//called by the main loop every frame.
+		auto flushMainThread() -> void;
+
+		//help executing jobs until the counter reaches zero.
+		auto wait(const std::shared_ptr<JobCounter> &counter) -> void;
+
+		/**
+		 * help executing jobs until the counter reaches zero or timeout (ms) passed, returns counter->isDone().
+		 * no job is started after the timeout, one started before it still runs to its end.
+		 */
+		auto wait(const std::shared_ptr<JobCounter> &counter, float timeout) -> bool;
+
+		//help executing jobs until every queue is empty and nothing is running.
+		auto waitAll() -> void;
+
+		//the threads executing jobs, the thread which created the system included
+		inline auto getWorkerCount() const
+		{
+			return static_cast<uint32_t>(queues.size());
+		}
+
+		//index of the current thread inside this system or -1 if it is not a worker
+		auto getCurrentWorkerIndex() const -> int32_t;
+
+		inline auto isMainThread() const
+		{
+			return std::this_thread::get_id() == mainThreadId;
+		}
+
+		inline auto getExecutedJobs() const
+		{
+			return executedJobs.load(std::memory_order_relaxed);
+		}
+
+		inline auto getStolenJobs() const
+		{
+			return stolenJobs.load(std::memory_order_relaxed);
+		}
+
+	  private:
+		auto run(uint32_t workerIndex) -> void;
+		auto push(Job *job) -> void;
+		auto pop(int32_t workerIndex) -> Job *;
+		auto popBackground() -> Job *;
+		auto runJob(Job *job) -> void;
+		auto finish(const std::shared_ptr<JobCounter> &counter) -> void;
+
+		std::vector<std::unique_ptr<WorkStealingQueue<Job>>> queues;
+		std::vector<std::thread>                             threads;
+
+		//jobs coming from threads that are not workers of this system
+		std::mutex        globalMutex;
+		std::deque<Job *> globalQueue;
+
+		std::mutex        backgroundMutex;
+		std::deque<Job *> backgroundQueue;
+
+		std::mutex              sleepMutex;
+		std::condition_variable sleepCondition;
+		std::atomic<int32_t>    sleeping{0};
+		std::atomic<int32_t>    pending{0};
+		std::atomic<int32_t>    running{0};
+		std::atomic<bool>       close{false};
+
+		std::atomic<uint64_t> executedJobs{0};
+		std::atomic<uint64_t> stolenJobs{0};
+
+		std::mutex                         mainThreadMutex;
+		std::vector<std::function<void()>> mainThreadJobs;
+		std::vector<std::function<void()>> mainThreadJobsBack;
+
+		std::thread::id mainThreadId;
+	};
+};        // namespace maple
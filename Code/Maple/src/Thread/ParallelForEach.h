@@ -4,11 +4,67 @@
 
 #pragma once
 
-#include <condition_variable>
-#include <functional>
-#include <mutex>
-#include <thread>
+#include "Thread/JobSystem.h"
+#include <algorithm>
+#include <iterator>
 
 namespace maple
 {
-};
\ No newline at end of file
+	/**
+	 * split [0, count) into batches and run func(begin, end) for each batch on the job system.
+	 * the calling thread helps until every batch is done.
+	 */
+	template <typename Func>
+	inline auto parallelForRange(JobSystem &jobSystem, uint32_t count, uint32_t batchSize, const Func &func) -> void
+	{
+		if (count == 0)
+			return;
+
+		if (batchSize == 0)
+		{
+			const uint32_t workers = jobSystem.getWorkerCount();
+			batchSize              = std::max<uint32_t>(1, (count + workers * 4 - 1) / (workers * 4));
+		}
+
+		if (count <= batchSize)
+		{
+			func(0u, count);
+			return;
+		}
+
+		auto counter = std::make_shared<JobCounter>();
+		for (uint32_t begin = batchSize; begin < count; begin += batchSize)
+		{
+			const uint32_t end = std::min(begin + batchSize, count);
+			jobSystem.execute([&func, begin, end]() { func(begin, end); }, counter);
+		}
+		//the first batch is executed by the calling thread
+		func(0u, batchSize);
+		jobSystem.wait(counter);
+	}
+
+	template <typename Func>
+	inline auto parallelFor(JobSystem &jobSystem, uint32_t count, const Func &func, uint32_t batchSize = 0) -> void
+	{
+		parallelForRange(jobSystem, count, batchSize, [&func](uint32_t begin, uint32_t end) {
+			for (uint32_t i = begin; i < end; i++)
+			{
+				func(i);
+			}
+		});
+	}
+
+	template <typename Container, typename Func>
+	inline auto parallelForEach(JobSystem &jobSystem, Container &container, const Func &func, uint32_t batchSize = 0) -> void
+	{
+		//one iterator per batch, so containers without random access are walked once per batch and not per element
+		auto first = std::begin(container);
+		parallelForRange(jobSystem, static_cast<uint32_t>(std::distance(first, std::end(container))), batchSize, [&](uint32_t begin, uint32_t end) {
+			auto iter = std::next(first, begin);
+			for (uint32_t i = begin; i < end; i++, ++iter)
+			{
+				func(*iter);
+			}
+		});
+	}
+};        // namespace maple
@@ -0,0 +1,110 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+namespace maple
+{
+	/**
+	 * Chase-Lev work stealing deque with a fixed capacity.
+	 * The owner thread pushes and pops at the bottom, any other thread steals from the top.
+	 * Capacity must be a power of two.
+	 */
+	template <typename T, int64_t Capacity = 4096>
+	class WorkStealingQueue
+	{
+		static_assert((Capacity & (Capacity - 1)) == 0, "Capacity must be a power of two");
+
+	  public:
+		WorkStealingQueue() = default;
+
+		WorkStealingQueue(const WorkStealingQueue &) = delete;
+		WorkStealingQueue &operator=(const WorkStealingQueue &) = delete;
+
+		//owner only, return false if the queue is full
+		inline auto push(T *item) -> bool
+		{
+			const int64_t b = bottom.load(std::memory_order_relaxed);
+			const int64_t t = top.load(std::memory_order_acquire);
+			if (b - t >= Capacity)
+			{
+				return false;
+			}
+			buffer[b & Mask].store(item, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_release);
+			bottom.store(b + 1, std::memory_order_relaxed);
+			return true;
+		}
+
+		//owner only
+		inline auto pop() -> T *
+		{
+			const int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+			bottom.store(b, std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			int64_t t = top.load(std::memory_order_relaxed);
+
+			if (t > b)
+			{
+				//empty
+				bottom.store(b + 1, std::memory_order_relaxed);
+				return nullptr;
+			}
+
+			T *item = buffer[b & Mask].load(std::memory_order_relaxed);
+			if (t == b)
+			{
+				//last item, race against the thieves
+				if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+				{
+					item = nullptr;
+				}
+				bottom.store(b + 1, std::memory_order_relaxed);
+			}
+			return item;
+		}
+
+		//any thread
+		inline auto steal() -> T *
+		{
+			int64_t t = top.load(std::memory_order_acquire);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			const int64_t b = bottom.load(std::memory_order_acquire);
+
+			if (t < b)
+			{
+				T *item = buffer[t & Mask].load(std::memory_order_relaxed);
+				if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+				{
+					return nullptr;
+				}
+				return item;
+			}
+			return nullptr;
+		}
+
+		inline auto size() const -> int64_t
+		{
+			const int64_t b = bottom.load(std::memory_order_relaxed);
+			const int64_t t = top.load(std::memory_order_relaxed);
+			return b >= t ? b - t : 0;
+		}
+
+		inline auto empty() const -> bool
+		{
+			return size() == 0;
+		}
+
+	  private:
+		static constexpr int64_t Mask = Capacity - 1;
+
+		alignas(64) std::atomic<int64_t> top{0};
+		alignas(64) std::atomic<int64_t> bottom{0};
+		alignas(64) std::atomic<T *> buffer[Capacity] = {};
+	};
+};        // namespace maple
@@ -0,0 +1,13 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+
+#include "HeadlessWindow.h"
+
+namespace maple
+{
+	HeadlessWindow::HeadlessWindow(const WindowInitData &data) :
+	    data(data)
+	{
+	}
+}        // namespace maple
@@ -0,0 +1,58 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+
+#pragma once
+#include "NativeWindow.h"
+
+namespace maple
+{
+	//a window of a fixed size without a window system, used by the offscreen application mode
+	class HeadlessWindow : public NativeWindow
+	{
+	  public:
+		HeadlessWindow(const WindowInitData &data);
+
+		auto onUpdate() -> void override{};
+		auto init() -> void override{};
+
+		inline auto setVSync(bool sync) -> void override
+		{
+			data.vsync = sync;
+		}
+
+		inline auto isVSync() const -> bool override
+		{
+			return data.vsync;
+		}
+
+		inline auto getWidth() const -> uint32_t override
+		{
+			return data.width;
+		}
+
+		inline auto getHeight() const -> uint32_t override
+		{
+			return data.height;
+		}
+
+		inline auto getNativeInterface() -> void * override
+		{
+			return nullptr;
+		}
+
+		inline auto isClose() const -> bool override
+		{
+			return closed;
+		}
+
+		inline auto close()
+		{
+			closed = true;
+		}
+
+	  private:
+		WindowInitData data;
+		bool           closed = false;
+	};
+}        // namespace maple
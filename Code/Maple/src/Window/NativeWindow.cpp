@@ -2,7 +2,11 @@
 // This file is part of the Maple Engine                              		//
 //////////////////////////////////////////////////////////////////////////////
 #include "NativeWindow.h"
-#include "WindowWin.h"
+#include "HeadlessWindow.h"
+
+#ifndef MAPLE_NULL
+#	include "WindowWin.h"
+#endif        // MAPLE_NULL
 
 namespace maple
 {
@@ -17,6 +21,13 @@ namespace maple
 
 	auto NativeWindow::create(const WindowInitData &data) -> std::unique_ptr<NativeWindow>
 	{
+#ifdef MAPLE_NULL
+		//the null build has no window system linked
+		return std::make_unique<HeadlessWindow>(data);
+#else
+		if (data.headless)
+			return std::make_unique<HeadlessWindow>(data);
 		return std::make_unique<WindowWin>(data);
+#endif        // MAPLE_NULL
 	}
 };        // namespace maple
@@ -17,6 +17,7 @@ namespace maple
 		uint32_t    height;
 		bool        vsync;
 		std::string title;
+		bool        headless = false;
 	};
 
 	class NativeWindow
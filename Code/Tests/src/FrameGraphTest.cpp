@@ -0,0 +1,171 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+#include "Engine/Renderer/FrameGraph.h"
+#include "Test.h"
+
+#include <algorithm>
+
+namespace maple
+{
+	namespace
+	{
+		using namespace frame_graph;
+
+		constexpr TextureDesc Color = {64, 64, TextureFormat::RGBA8};
+		constexpr TextureDesc Mask  = {64, 64, TextureFormat::R8};
+
+		struct Graph
+		{
+			FrameGraph graph;
+			ResourceId history;
+			ResourceId depth;
+			ResourceId lighting;
+			ResourceId post;
+			ResourceId mask;
+			ResourceId unused;
+		};
+
+		//Depth -> Light -> Post -> Present, Debug writes a texture nobody reads and is culled.
+		//post can take the memory of depth, mask has another format and history is imported.
+		inline auto declare() -> Graph
+		{
+			Graph graph;
+			graph.history  = graph.graph.importTexture("History", Color);
+			graph.depth    = graph.graph.createTexture("Depth", Color);
+			graph.lighting = graph.graph.createTexture("Lighting", Color);
+			graph.post     = graph.graph.createTexture("Post", Color);
+			graph.mask     = graph.graph.createTexture("Mask", Mask);
+			graph.unused   = graph.graph.createTexture("Unused", Color);
+
+			graph.graph.addPass("Depth").write(graph.depth);
+			graph.graph.addPass("Light").read(graph.depth).write(graph.lighting);
+			graph.graph.addPass("Post").read(graph.lighting).write(graph.post).write(graph.mask);
+			graph.graph.addPass("Debug").read(graph.lighting).write(graph.unused);
+			graph.graph.addPass("Present").read(graph.post).read(graph.mask).read(graph.history).sideEffect();
+			return graph;
+		}
+
+		inline auto hasBarrier(const CompiledGraph &compiled, PassId pass, ResourceId resource, ResourceState before, ResourceState after)
+		{
+			auto &barriers = compiled.barriers[pass];
+			return std::any_of(barriers.begin(), barriers.end(), [&](const Barrier &barrier) {
+				return barrier.resource == resource && barrier.before == before && barrier.after == after;
+			});
+		}
+	}        // namespace
+}        // namespace maple
+
+using namespace maple;
+using namespace maple::frame_graph;
+
+MAPLE_TEST(FrameGraphCompile)
+{
+	const auto graph    = declare();
+	const auto compiled = graph.graph.compile();
+
+	MAPLE_CHECK(compiled.culled == std::vector<bool>({false, false, false, true, false}));
+
+	MAPLE_CHECK(compiled.firstUse[graph.depth] == 0 && compiled.lastUse[graph.depth] == 1);
+	MAPLE_CHECK(compiled.firstUse[graph.lighting] == 1 && compiled.lastUse[graph.lighting] == 2);
+	MAPLE_CHECK(compiled.firstUse[graph.post] == 2 && compiled.lastUse[graph.post] == 4);
+	MAPLE_CHECK(compiled.firstUse[graph.mask] == 2 && compiled.lastUse[graph.mask] == 4);
+	MAPLE_CHECK(compiled.firstUse[graph.history] == 0 && compiled.lastUse[graph.history] == 4);
+
+	//the only pair is post taking the memory of depth
+	MAPLE_CHECK(compiled.physical[graph.post] == compiled.physical[graph.depth]);
+	MAPLE_CHECK(compiled.physical[graph.lighting] != compiled.physical[graph.depth]);
+	MAPLE_CHECK(compiled.physical[graph.mask] != compiled.physical[graph.depth]);
+	MAPLE_CHECK(compiled.physical[graph.history] != compiled.physical[graph.post]);
+	MAPLE_CHECK(compiled.physical[graph.unused] == NoPhysical);
+	MAPLE_CHECK(compiled.physicalDescs.size() == 4);
+
+	MAPLE_CHECK(compiled.transientBytes == 3 * getTextureSize(Color) + getTextureSize(Mask));
+	MAPLE_CHECK(compiled.allocatedBytes == 2 * getTextureSize(Color) + getTextureSize(Mask));
+
+	MAPLE_CHECK(compiled.barriers[0].size() == 1);
+	MAPLE_CHECK(hasBarrier(compiled, 0, graph.depth, ResourceState::Undefined, ResourceState::ColorAttachment));
+
+	MAPLE_CHECK(compiled.barriers[1].size() == 2);
+	MAPLE_CHECK(hasBarrier(compiled, 1, graph.depth, ResourceState::ColorAttachment, ResourceState::ShaderRead));
+	MAPLE_CHECK(hasBarrier(compiled, 1, graph.lighting, ResourceState::Undefined, ResourceState::ColorAttachment));
+
+	//post discards what depth left in the shared memory
+	MAPLE_CHECK(compiled.barriers[2].size() == 3);
+	MAPLE_CHECK(hasBarrier(compiled, 2, graph.lighting, ResourceState::ColorAttachment, ResourceState::ShaderRead));
+	MAPLE_CHECK(hasBarrier(compiled, 2, graph.post, ResourceState::Undefined, ResourceState::ColorAttachment));
+	MAPLE_CHECK(hasBarrier(compiled, 2, graph.mask, ResourceState::Undefined, ResourceState::ColorAttachment));
+
+	MAPLE_CHECK(compiled.barriers[3].empty());
+
+	//history is already in the state it is read in
+	MAPLE_CHECK(compiled.barriers[4].size() == 2);
+	MAPLE_CHECK(hasBarrier(compiled, 4, graph.post, ResourceState::ColorAttachment, ResourceState::ShaderRead));
+	MAPLE_CHECK(hasBarrier(compiled, 4, graph.mask, ResourceState::ColorAttachment, ResourceState::ShaderRead));
+
+	MAPLE_CHECK(compiled.barrierCount == 8);
+	MAPLE_CHECK(compiled.uninitialized.empty());
+}
+
+MAPLE_TEST(FrameGraphNoAliasing)
+{
+	const auto graph    = declare();
+	const auto aliased  = graph.graph.compile();
+	const auto compiled = graph.graph.compile(false);
+
+	MAPLE_CHECK(compiled.culled == aliased.culled);
+	MAPLE_CHECK(compiled.firstUse == aliased.firstUse);
+	MAPLE_CHECK(compiled.lastUse == aliased.lastUse);
+
+	std::vector<int32_t> physical;
+	for (ResourceId resource = 0; resource < graph.graph.getResources().size(); resource++)
+	{
+		if (compiled.physical[resource] != NoPhysical)
+			physical.emplace_back(compiled.physical[resource]);
+	}
+	std::sort(physical.begin(), physical.end());
+	MAPLE_CHECK(std::adjacent_find(physical.begin(), physical.end()) == physical.end());
+	MAPLE_CHECK(compiled.allocatedBytes == compiled.transientBytes);
+
+	//the first write of post transitions from undefined with or without the memory of depth
+	MAPLE_CHECK(compiled.barrierCount == aliased.barrierCount);
+	MAPLE_CHECK(hasBarrier(compiled, 2, graph.post, ResourceState::Undefined, ResourceState::ColorAttachment));
+}
+
+MAPLE_TEST(FrameGraphUninitialized)
+{
+	FrameGraph graph;
+	const auto source = graph.createTexture("Source", Color);
+	const auto target = graph.createTexture("Target", Color);
+	graph.addPass("Blur").read(source).write(target);
+	graph.addPass("Present").read(target).sideEffect();
+
+	const auto compiled = graph.compile();
+	MAPLE_CHECK(compiled.uninitialized == std::vector<ResourceId>({source}));
+	MAPLE_CHECK(compiled.physical[source] != compiled.physical[target]);
+}
+
+MAPLE_TEST(FrameGraphFeatures)
+{
+	constexpr uint32_t Reflection = 1;
+
+	FrameGraph graph;
+	const auto screen  = graph.createTexture("Screen", Color);
+	const auto reflect = graph.createTexture("Reflection", Color);
+	graph.addPass("Scene").write(screen);
+	graph.addPass("Reflect").read(screen).write(reflect).require(Reflection);
+	graph.addPass("Present").read(screen).read(reflect, ResourceState::ShaderRead, Reflection).sideEffect();
+
+	const auto on = graph.compile();
+	MAPLE_CHECK(on.culled == std::vector<bool>({false, false, false}));
+	MAPLE_CHECK(on.physical[reflect] != NoPhysical);
+	MAPLE_CHECK(hasBarrier(on, 2, reflect, ResourceState::ColorAttachment, ResourceState::ShaderRead));
+
+	//without the feature the pass is culled and present does not read what it would have written
+	const auto off = graph.compile(true, 0);
+	MAPLE_CHECK(off.culled == std::vector<bool>({false, true, false}));
+	MAPLE_CHECK(off.physical[reflect] == NoPhysical);
+	MAPLE_CHECK(off.barriers[1].empty());
+	MAPLE_CHECK(off.barriers[2].size() == 1);
+	MAPLE_CHECK(off.uninitialized.empty());
+}
@@ -0,0 +1,39 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+#include "Test.h"
+
+#include <cstring>
+
+//MapleTests [name], runs the tests whose name is name or every test, fails if one check failed
+auto main(int32_t argc, char **argv) -> int32_t
+{
+	maple::Console::init();
+
+	uint32_t failed = 0;
+	uint32_t run    = 0;
+	for (auto &test : maple::test::getRegistry())
+	{
+		if (argc > 1 && std::strcmp(test.first.c_str(), argv[1]) != 0)
+			continue;
+		maple::test::getFailures() = 0;
+		test.second();
+		run++;
+		if (maple::test::getFailures() > 0)
+		{
+			LOGE("{0} : {1} checks failed", test.first, maple::test::getFailures());
+			failed++;
+		}
+		else
+		{
+			LOGI("{0} : passed", test.first);
+		}
+	}
+
+	if (run == 0)
+	{
+		LOGE("MapleTests : no test named {0}", argc > 1 ? argv[1] : "");
+		return 1;
+	}
+	return failed == 0 ? 0 : 1;
+}
@@ -0,0 +1,50 @@
+//////////////////////////////////////////////////////////////////////////////
+// This file is part of the Maple Engine                              		//
+//////////////////////////////////////////////////////////////////////////////
+#pragma once
+#include "Others/Console.h"
+
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace maple::test
+{
+	using Func = std::function<void()>;
+
+	//every test of the executable in the order they were registered
+	inline auto getRegistry() -> std::vector<std::pair<std::string, Func>> &
+	{
+		static std::vector<std::pair<std::string, Func>> registry;
+		return registry;
+	}
+
+	//failed checks of the test running now
+	inline auto getFailures() -> uint32_t &
+	{
+		static uint32_t failures = 0;
+		return failures;
+	}
+
+	struct Register
+	{
+		Register(const char *name, const Func &func)
+		{
+			getRegistry().emplace_back(name, func);
+		}
+	};
+}        // namespace maple::test
+
+#define MAPLE_TEST(Name)                                            \
+	static auto Name() -> void;                                     \
+	static maple::test::Register Name##Register(#Name, &Name);      \
+	static auto Name() -> void
+
+#define MAPLE_CHECK(Condition)                                                      \
+	if (!(Condition))                                                               \
+	{                                                                               \
+		LOGE("{0}:{1} : {2} failed", __FILE__, __LINE__, #Condition);               \
+		maple::test::getFailures()++;                                               \
+	}